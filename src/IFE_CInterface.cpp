@@ -0,0 +1,433 @@
+/**
+ * @file IFE_CInterface.cpp
+ * @brief Implementation of the Iris File Extension C interface. See IrisFileExtension.h.
+ *
+ * The handle abstracts the file once with abstract_file_structure and flattens
+ * the abstraction into the C arrays returned by the accessors. Associative
+ * containers are sorted (attributes by key, images by title, annotations by
+ * identifier) so every array has a stable, documented order.
+ *
+ * @copyright Copyright (c) 2026 Ryan Landvater. MIT licensed.
+ */
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "IrisTypes.hpp"
+#include "IrisCodecTypes.hpp"
+#include "IrisCodecExtension.hpp"
+#include "IrisFileExtension.h"
+
+#ifndef __EMSCRIPTEN__
+using namespace IrisCodec;
+
+static_assert(sizeof(IFE_Tile)  == 16, "IFE_Tile layout is part of the C ABI");
+static_assert(sizeof(IFE_Layer) == 32, "IFE_Layer layout is part of the C ABI");
+static_assert(IFE_NULL_OFFSET   == NULL_OFFSET, "IFE_NULL_OFFSET shall match NULL_OFFSET");
+
+struct IFE_File_T {
+    struct Pyramid {
+        std::vector<IFE_Layer>      layers;
+        std::vector<IFE_Tile>       tiles;
+    };
+    struct Columns {
+        std::vector<uint32_t>       identifier;
+        std::vector<uint8_t>        type;
+        std::vector<uint8_t>        compression;
+        std::vector<float>          xLocation;
+        std::vector<float>          yLocation;
+        std::vector<float>          xSize;
+        std::vector<float>          ySize;
+        std::vector<uint32_t>       width;
+        std::vector<uint32_t>       height;
+        std::vector<uint32_t>       parent;
+        std::vector<uint64_t>       offset;
+        std::vector<uint64_t>       byteSize;
+    };
+    BYTE*                           base        = nullptr;
+    Size                            size        = 0;
+    Abstraction::File               file;
+    std::vector<IFE_Layer>          layers;
+    std::vector<IFE_Tile>           tiles;
+    std::vector<IFE_Attribute>      attributes;
+    std::vector<IFE_AssociatedImage> images;
+    std::vector<Pyramid>            pyramids;   // One per image (empty if not tiled)
+    Columns                         annotations;
+    std::vector<IFE_AnnotationGroup> groups;
+};
+
+namespace {
+thread_local std::string LAST_ERROR;
+
+inline IFE_Status FAIL (IFE_Status status, const std::string& message)
+{
+    LAST_ERROR = message;
+    return status;
+}
+template <class Function>
+inline IFE_Status GUARD (Function&& function) noexcept
+{
+    try {
+        return function();
+    } catch (std::exception& e) {
+        return FAIL(IFE_STATUS_FAILURE, e.what());
+    } catch (...) {
+        return FAIL(IFE_STATUS_FAILURE, "Unknown exception thrown by the Iris File Extension.");
+    }
+}
+inline IFE_String STRING (const std::string& string) noexcept
+{
+    return IFE_String {.data = string.c_str(), .size = string.size()};
+}
+inline IFE_String STRING (const std::u8string& string) noexcept
+{
+    return IFE_String {.data = reinterpret_cast<const char*>(string.c_str()), .size = string.size()};
+}
+inline IFE_Bytes BYTES (const BYTE* const __base, Offset offset, Size size) noexcept
+{
+    if (offset == NULL_OFFSET || size == 0) return IFE_Bytes {.data = nullptr, .size = 0};
+    return IFE_Bytes {.data = __base + offset, .size = size};
+}
+// Flatten a tile table's layers into the layer and tile index arrays
+void FLATTEN_TILES (const Abstraction::TileTable::Layers& layers,
+                    const LayerExtents& extents,
+                    const Abstraction::TileExtents& tile_extents,
+                    std::vector<IFE_Layer>& __layers,
+                    std::vector<IFE_Tile>& __tiles)
+{
+    Size total = 0;
+    for (auto&& layer : layers) total += layer.size();
+    __layers.reserve(layers.size());
+    __tiles.reserve(total);
+    for (size_t LI = 0; LI < layers.size(); ++LI) {
+        const auto& extent  = extents[LI];
+        const auto  tile    = LI < tile_extents.size() ? tile_extents[LI] : Abstraction::TileExtent();
+        __layers.push_back(IFE_Layer {
+            .x_tiles        = extent.xTiles,
+            .y_tiles        = extent.yTiles,
+            .scale          = extent.scale,
+            .downsample     = extent.downsample,
+            .tile_width     = tile.width,
+            .tile_height    = tile.height,
+            .reserved       = 0,
+            .first_tile     = __tiles.size(),
+        });
+        for (auto&& entry : layers[LI])
+            __tiles.push_back(IFE_Tile {.offset = entry.offset, .size = entry.size, .reserved = 0});
+    }
+}
+// View uncompressed attributes at their key / value runs within the mapped file.
+// Returns false if the attributes are compressed (viewed in their decoded copy).
+bool MAP_ATTRIBUTES (IFE_File_T& handle)
+{
+    using namespace Serialization;
+    const auto METADATA     = FILE_HEADER(handle.size).get_metadata(handle.base);
+    if (METADATA.attributes(handle.base) == false) return true;
+    const auto ATTRIBUTES   = METADATA.get_attributes(handle.base);
+    if (ATTRIBUTES.compression(handle.base) != TEXT_UNCOMPRESSED) return false;
+    // The runs were bounds checked when the file was abstracted
+    const auto sizes        = ATTRIBUTES.get_sizes(handle.base).read_sizes(handle.base);
+    if (sizes.size() != handle.file.metadata.attributes.size()) return false;
+    const auto BYTES        = ATTRIBUTES.get_bytes(handle.base);
+    auto run = reinterpret_cast<const char*>(handle.base + BYTES.__offset + ATTRIBUTES_BYTES::HEADER_SIZE);
+    handle.attributes.reserve(sizes.size());
+    for (auto&& size : sizes) {
+        handle.attributes.push_back({
+            .key    = IFE_String {.data = run, .size = size.first},
+            .value  = IFE_String {.data = run + size.first, .size = size.second},
+        });
+        run += Size(size.first) + size.second;
+    }
+    return true;
+}
+void FLATTEN (IFE_File_T& handle)
+{
+    const auto& file    = handle.file;
+    const auto& table   = file.tileTable;
+    FLATTEN_TILES(table.layers, table.extent.layers, table.tileExtents, handle.layers, handle.tiles);
+
+    // Attributes sorted by key
+    const auto& attributes = file.metadata.attributes;
+    if (MAP_ATTRIBUTES(handle) == false) {
+        handle.attributes.clear();
+        handle.attributes.reserve(attributes.size());
+        for (auto&& attribute : attributes)
+            handle.attributes.push_back({.key = STRING(attribute.first), .value = STRING(attribute.second)});
+    }
+    std::sort(handle.attributes.begin(), handle.attributes.end(),
+              [](const IFE_Attribute& a, const IFE_Attribute& b) {
+        return std::string_view(a.key.data, a.key.size) < std::string_view(b.key.data, b.key.size);
+    });
+
+    // Associated images sorted by title
+    std::vector<const std::pair<const std::string, Abstraction::AssociatedImage>*> images;
+    for (auto&& image : file.images) images.push_back(&image);
+    std::sort(images.begin(), images.end(), [](auto a, auto b) {return a->first < b->first;});
+    handle.images.reserve(images.size());
+    handle.pyramids.resize(images.size());
+    for (size_t II = 0; II < images.size(); ++II) {
+        const auto& title   = images[II]->first;
+        const auto& image   = images[II]->second;
+        handle.images.push_back(IFE_AssociatedImage {
+            .title          = STRING(title),
+            .bytes          = BYTES(handle.base, image.offset, image.byteSize),
+            .width          = image.info.width,
+            .height         = image.info.height,
+            .encoding       = static_cast<uint8_t>(image.info.encoding),
+            .format         = static_cast<uint8_t>(image.info.sourceFormat),
+            .orientation    = static_cast<uint16_t>(image.info.orientation),
+            .layers         = static_cast<uint32_t>(image.pyramid.layers.size()),
+        });
+        if (image.tiled()) FLATTEN_TILES
+            (image.pyramid.layers, image.pyramid.extent.layers, image.pyramid.tileExtents,
+             handle.pyramids[II].layers, handle.pyramids[II].tiles);
+    }
+
+    // Annotation columns sorted by identifier
+    std::vector<const std::pair<const Abstraction::Annotation::Identifier, Abstraction::Annotation>*> notes;
+    for (auto&& note : file.annotations) notes.push_back(&note);
+    std::sort(notes.begin(), notes.end(), [](auto a, auto b) {return a->first < b->first;});
+    auto& columns       = handle.annotations;
+    for (auto&& note : notes) {
+        const auto& annotation = note->second;
+        columns.identifier.push_back(note->first);
+        columns.type.push_back      (static_cast<uint8_t>(annotation.type));
+        columns.compression.push_back(static_cast<uint8_t>(annotation.compression));
+        columns.xLocation.push_back (annotation.xLocation);
+        columns.yLocation.push_back (annotation.yLocation);
+        columns.xSize.push_back     (annotation.xSize);
+        columns.ySize.push_back     (annotation.ySize);
+        columns.width.push_back     (annotation.width);
+        columns.height.push_back    (annotation.height);
+        columns.parent.push_back    (annotation.parent);
+        columns.offset.push_back    (annotation.offset);
+        columns.byteSize.push_back  (annotation.byteSize);
+    }
+    for (auto&& group : file.annotations.groups) {
+        // Group entries are the group name followed by the 24-bit member identifiers
+        const Size members = Size(group.second.number) * 3;
+        handle.groups.push_back(IFE_AnnotationGroup {
+            .name           = STRING(group.first),
+            .members        = BYTES(handle.base, group.second.offset + group.first.size(), members),
+            .number         = group.second.number,
+            .reserved       = 0,
+        });
+    }
+    std::sort(handle.groups.begin(), handle.groups.end(),
+              [](const IFE_AnnotationGroup& a, const IFE_AnnotationGroup& b) {
+        return std::string_view(a.name.data, a.name.size) < std::string_view(b.name.data, b.name.size);
+    });
+}
+} // namespace
+
+extern "C" {
+const char* ife_last_error (void)
+{
+    return LAST_ERROR.c_str();
+}
+uint32_t ife_abi_version (void)
+{
+    return IFE_C_ABI_VERSION;
+}
+IFE_Status ife_validate (uint8_t* mapped_file, uint64_t file_size)
+{
+    if (!mapped_file) return FAIL(IFE_STATUS_INVALID_ARGUMENT, "ife_validate -- NULL mapped file.");
+    return GUARD([&]() {
+        auto result = validate_file_structure(mapped_file, file_size);
+        if (result & IRIS_FAILURE) return FAIL(IFE_STATUS_FAILURE, result.message);
+        return IFE_STATUS_SUCCESS;
+    });
+}
+IFE_Status ife_file_open (uint8_t* mapped_file, uint64_t file_size, IFE_File* file)
+{
+    if (!mapped_file || !file) return FAIL(IFE_STATUS_INVALID_ARGUMENT, "ife_file_open -- NULL argument.");
+    *file = nullptr;
+    return GUARD([&]() {
+        if (!is_Iris_Codec_file(mapped_file, file_size)) return FAIL
+            (IFE_STATUS_FAILURE, "ife_file_open -- the mapped file is not an Iris File Extension file.");
+        auto handle     = std::make_unique<IFE_File_T>();
+        handle->base    = mapped_file;
+        handle->size    = file_size;
+        handle->file    = abstract_file_structure(mapped_file, file_size);
+        FLATTEN(*handle);
+        *file           = handle.release();
+        return IFE_STATUS_SUCCESS;
+    });
+}
+void ife_file_close (IFE_File file)
+{
+    delete file;
+}
+IFE_Status ife_file_header (IFE_File file, IFE_Header* header)
+{
+    if (!file || !header) return FAIL(IFE_STATUS_INVALID_ARGUMENT, "ife_file_header -- NULL argument.");
+    const auto& __header = file->file.header;
+    *header = IFE_Header {
+        .file_size          = __header.fileSize,
+        .extension_version  = __header.extVersion,
+        .revision           = __header.revision,
+        .fingerprint_low    = __header.fingerprint.low,
+        .fingerprint_high   = __header.fingerprint.high,
+    };
+    return IFE_STATUS_SUCCESS;
+}
+IFE_Status ife_file_tile_table (IFE_File file, IFE_TileTable* table)
+{
+    if (!file || !table) return FAIL(IFE_STATUS_INVALID_ARGUMENT, "ife_file_tile_table -- NULL argument.");
+    const auto& __table = file->file.tileTable;
+    *table = IFE_TileTable {
+        .encoding           = static_cast<uint8_t>(__table.encoding),
+        .format             = static_cast<uint8_t>(__table.format),
+        .plane_type         = static_cast<uint8_t>(__table.planeType),
+        .encrypted          = static_cast<uint8_t>(static_cast<bool>(__table.cipher)),
+        .layers             = static_cast<uint32_t>(__table.layers.size()),
+        .width              = __table.extent.width,
+        .height             = __table.extent.height,
+        .tiles              = file->tiles.size(),
+        .mip_tail_offset    = __table.mipTail.offset,
+        .mip_tail_size      = __table.mipTail.size,
+        .mip_tail_layers    = __table.mipTail.layers,
+        .planes             = static_cast<uint32_t>(__table.planes.size()),
+    };
+    return IFE_STATUS_SUCCESS;
+}
+IFE_Status ife_file_layers (IFE_File file, const IFE_Layer** layers, uint64_t* count)
+{
+    if (!file || !layers || !count) return FAIL(IFE_STATUS_INVALID_ARGUMENT, "ife_file_layers -- NULL argument.");
+    *layers = file->layers.data();
+    *count  = file->layers.size();
+    return IFE_STATUS_SUCCESS;
+}
+IFE_Status ife_file_tiles (IFE_File file, const IFE_Tile** tiles, uint64_t* count)
+{
+    if (!file || !tiles || !count) return FAIL(IFE_STATUS_INVALID_ARGUMENT, "ife_file_tiles -- NULL argument.");
+    *tiles  = file->tiles.data();
+    *count  = file->tiles.size();
+    return IFE_STATUS_SUCCESS;
+}
+IFE_Status ife_file_tile_bytes (IFE_File file, uint32_t layer, uint32_t tile, IFE_Bytes* bytes)
+{
+    if (!file || !bytes) return FAIL(IFE_STATUS_INVALID_ARGUMENT, "ife_file_tile_bytes -- NULL argument.");
+    if (layer >= file->layers.size()) return FAIL
+        (IFE_STATUS_OUT_OF_RANGE, "ife_file_tile_bytes -- layer (" + std::to_string(layer) + ") out of range.");
+    const auto& __layer = file->layers[layer];
+    if (tile >= Size(__layer.x_tiles) * __layer.y_tiles) return FAIL
+        (IFE_STATUS_OUT_OF_RANGE, "ife_file_tile_bytes -- tile (" + std::to_string(tile) + ") out of range.");
+    const auto& entry   = file->tiles[__layer.first_tile + tile];
+    if (entry.offset == IFE_NULL_OFFSET) {
+        *bytes = IFE_Bytes {.data = nullptr, .size = 0};
+        return IFE_STATUS_NOT_FOUND;
+    }
+    *bytes = BYTES(file->base, entry.offset, entry.size);
+    return IFE_STATUS_SUCCESS;
+}
+IFE_Status ife_file_planes (IFE_File file, const float** values, uint64_t* count)
+{
+    if (!file || !values || !count) return FAIL(IFE_STATUS_INVALID_ARGUMENT, "ife_file_planes -- NULL argument.");
+    *values = file->file.tileTable.planes.data();
+    *count  = file->file.tileTable.planes.size();
+    return IFE_STATUS_SUCCESS;
+}
+IFE_Status ife_file_metadata (IFE_File file, IFE_Metadata* metadata)
+{
+    if (!file || !metadata) return FAIL(IFE_STATUS_INVALID_ARGUMENT, "ife_file_metadata -- NULL argument.");
+    const auto& __metadata = file->file.metadata;
+    const auto& profile = __metadata.ICC_profile;
+    *metadata = IFE_Metadata {
+        .codec_major        = __metadata.codec.major,
+        .codec_minor        = __metadata.codec.minor,
+        .codec_build        = __metadata.codec.build,
+        .attributes_type    = static_cast<uint8_t>(__metadata.attributes.type),
+        .reserved           = 0,
+        .attributes_version = __metadata.attributes.version,
+        .microns_per_pixel  = __metadata.micronsPerPixel,
+        .magnification      = __metadata.magnification,
+        .icc_profile        = IFE_Bytes {
+            .data           = profile.size() ? reinterpret_cast<const uint8_t*>(profile.data()) : nullptr,
+            .size           = profile.size(),
+        },
+    };
+    return IFE_STATUS_SUCCESS;
+}
+IFE_Status ife_file_attributes (IFE_File file, const IFE_Attribute** attributes, uint64_t* count)
+{
+    if (!file || !attributes || !count) return FAIL(IFE_STATUS_INVALID_ARGUMENT, "ife_file_attributes -- NULL argument.");
+    *attributes = file->attributes.data();
+    *count      = file->attributes.size();
+    return IFE_STATUS_SUCCESS;
+}
+IFE_Status ife_file_attribute (IFE_File file, const char* key, uint64_t key_size, IFE_String* value)
+{
+    if (!file || (!key && key_size) || !value) return FAIL(IFE_STATUS_INVALID_ARGUMENT, "ife_file_attribute -- NULL argument.");
+    const auto __key    = std::string_view(key ? key : "", key_size);
+    const auto it       = std::lower_bound
+    (file->attributes.begin(), file->attributes.end(), __key,
+     [](const IFE_Attribute& a, std::string_view k) {return std::string_view(a.key.data, a.key.size) < k;});
+    if (it == file->attributes.end() || std::string_view(it->key.data, it->key.size) != __key) {
+        *value = IFE_String {.data = nullptr, .size = 0};
+        return IFE_STATUS_NOT_FOUND;
+    }
+    *value = it->value;
+    return IFE_STATUS_SUCCESS;
+}
+IFE_Status ife_file_associated_images (IFE_File file, const IFE_AssociatedImage** images, uint64_t* count)
+{
+    if (!file || !images || !count) return FAIL(IFE_STATUS_INVALID_ARGUMENT, "ife_file_associated_images -- NULL argument.");
+    *images = file->images.data();
+    *count  = file->images.size();
+    return IFE_STATUS_SUCCESS;
+}
+IFE_Status ife_file_associated_tiles (IFE_File file, uint64_t image,
+                                      const IFE_Layer** layers, uint64_t* layer_count,
+                                      const IFE_Tile** tiles, uint64_t* tile_count)
+{
+    if (!file || !layers || !layer_count || !tiles || !tile_count) return FAIL
+        (IFE_STATUS_INVALID_ARGUMENT, "ife_file_associated_tiles -- NULL argument.");
+    if (image >= file->pyramids.size()) return FAIL
+        (IFE_STATUS_OUT_OF_RANGE, "ife_file_associated_tiles -- image (" + std::to_string(image) + ") out of range.");
+    const auto& pyramid = file->pyramids[image];
+    *layers         = pyramid.layers.data();
+    *layer_count    = pyramid.layers.size();
+    *tiles          = pyramid.tiles.data();
+    *tile_count     = pyramid.tiles.size();
+    return pyramid.layers.empty() ? IFE_STATUS_NOT_FOUND : IFE_STATUS_SUCCESS;
+}
+IFE_Status ife_file_annotations (IFE_File file, IFE_Annotations* annotations)
+{
+    if (!file || !annotations) return FAIL(IFE_STATUS_INVALID_ARGUMENT, "ife_file_annotations -- NULL argument.");
+    const auto& columns = file->annotations;
+    *annotations = IFE_Annotations {
+        .count              = columns.identifier.size(),
+        .identifier         = columns.identifier.data(),
+        .type               = columns.type.data(),
+        .compression        = columns.compression.data(),
+        .x_location         = columns.xLocation.data(),
+        .y_location         = columns.yLocation.data(),
+        .x_size             = columns.xSize.data(),
+        .y_size             = columns.ySize.data(),
+        .width              = columns.width.data(),
+        .height             = columns.height.data(),
+        .parent             = columns.parent.data(),
+        .offset             = columns.offset.data(),
+        .byte_size          = columns.byteSize.data(),
+    };
+    return IFE_STATUS_SUCCESS;
+}
+IFE_Status ife_file_annotation_bytes (IFE_File file, uint64_t row, IFE_Bytes* bytes)
+{
+    if (!file || !bytes) return FAIL(IFE_STATUS_INVALID_ARGUMENT, "ife_file_annotation_bytes -- NULL argument.");
+    const auto& columns = file->annotations;
+    if (row >= columns.identifier.size()) return FAIL
+        (IFE_STATUS_OUT_OF_RANGE, "ife_file_annotation_bytes -- row (" + std::to_string(row) + ") out of range.");
+    *bytes = BYTES(file->base, columns.offset[row], columns.byteSize[row]);
+    return IFE_STATUS_SUCCESS;
+}
+IFE_Status ife_file_annotation_groups (IFE_File file, const IFE_AnnotationGroup** groups, uint64_t* count)
+{
+    if (!file || !groups || !count) return FAIL(IFE_STATUS_INVALID_ARGUMENT, "ife_file_annotation_groups -- NULL argument.");
+    *groups = file->groups.data();
+    *count  = file->groups.size();
+    return IFE_STATUS_SUCCESS;
+}
+} // extern "C"
+#endif /* __EMSCRIPTEN__ */
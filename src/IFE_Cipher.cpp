@@ -0,0 +1,453 @@
+/**
+ * @file IFE_Cipher.cpp
+ * @brief Implementation of the AES-GCM tile cipher primitives. See IFE_Cipher.hpp.
+ */
+#include "IFE_Cipher.hpp"
+
+#include <cstring>
+#include <random>
+#include <stdexcept>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define IFE_CIPHER_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define IFE_TARGET_AESNI
+#else
+#define IFE_TARGET_AESNI __attribute__((target("aes,pclmul,sse4.1")))
+#endif
+#else
+#define IFE_CIPHER_X86 0
+#endif
+
+namespace IFE {
+
+namespace {
+
+// MARK: - BYTE ORDER
+inline std::uint32_t load_be32(const std::uint8_t* p) noexcept {
+    return (std::uint32_t(p[0]) << 24) | (std::uint32_t(p[1]) << 16) |
+           (std::uint32_t(p[2]) << 8)  |  std::uint32_t(p[3]);
+}
+inline void store_be32(std::uint8_t* p, std::uint32_t v) noexcept {
+    p[0] = std::uint8_t(v >> 24); p[1] = std::uint8_t(v >> 16);
+    p[2] = std::uint8_t(v >> 8);  p[3] = std::uint8_t(v);
+}
+inline std::uint64_t load_be64(const std::uint8_t* p) noexcept {
+    return (std::uint64_t(load_be32(p)) << 32) | load_be32(p + 4);
+}
+inline void store_be64(std::uint8_t* p, std::uint64_t v) noexcept {
+    store_be32(p, std::uint32_t(v >> 32));
+    store_be32(p + 4, std::uint32_t(v));
+}
+
+// MARK: - PORTABLE AES (FIPS-197)
+constexpr std::uint8_t SBOX[256] = {
+    0x63,0x7c,0x77,0x7b,0xf2,0x6b,0x6f,0xc5,0x30,0x01,0x67,0x2b,0xfe,0xd7,0xab,0x76,
+    0xca,0x82,0xc9,0x7d,0xfa,0x59,0x47,0xf0,0xad,0xd4,0xa2,0xaf,0x9c,0xa4,0x72,0xc0,
+    0xb7,0xfd,0x93,0x26,0x36,0x3f,0xf7,0xcc,0x34,0xa5,0xe5,0xf1,0x71,0xd8,0x31,0x15,
+    0x04,0xc7,0x23,0xc3,0x18,0x96,0x05,0x9a,0x07,0x12,0x80,0xe2,0xeb,0x27,0xb2,0x75,
+    0x09,0x83,0x2c,0x1a,0x1b,0x6e,0x5a,0xa0,0x52,0x3b,0xd6,0xb3,0x29,0xe3,0x2f,0x84,
+    0x53,0xd1,0x00,0xed,0x20,0xfc,0xb1,0x5b,0x6a,0xcb,0xbe,0x39,0x4a,0x4c,0x58,0xcf,
+    0xd0,0xef,0xaa,0xfb,0x43,0x4d,0x33,0x85,0x45,0xf9,0x02,0x7f,0x50,0x3c,0x9f,0xa8,
+    0x51,0xa3,0x40,0x8f,0x92,0x9d,0x38,0xf5,0xbc,0xb6,0xda,0x21,0x10,0xff,0xf3,0xd2,
+    0xcd,0x0c,0x13,0xec,0x5f,0x97,0x44,0x17,0xc4,0xa7,0x7e,0x3d,0x64,0x5d,0x19,0x73,
+    0x60,0x81,0x4f,0xdc,0x22,0x2a,0x90,0x88,0x46,0xee,0xb8,0x14,0xde,0x5e,0x0b,0xdb,
+    0xe0,0x32,0x3a,0x0a,0x49,0x06,0x24,0x5c,0xc2,0xd3,0xac,0x62,0x91,0x95,0xe4,0x79,
+    0xe7,0xc8,0x37,0x6d,0x8d,0xd5,0x4e,0xa9,0x6c,0x56,0xf4,0xea,0x65,0x7a,0xae,0x08,
+    0xba,0x78,0x25,0x2e,0x1c,0xa6,0xb4,0xc6,0xe8,0xdd,0x74,0x1f,0x4b,0xbd,0x8b,0x8a,
+    0x70,0x3e,0xb5,0x66,0x48,0x03,0xf6,0x0e,0x61,0x35,0x57,0xb9,0x86,0xc1,0x1d,0x9e,
+    0xe1,0xf8,0x98,0x11,0x69,0xd9,0x8e,0x94,0x9b,0x1e,0x87,0xe9,0xce,0x55,0x28,0xdf,
+    0x8c,0xa1,0x89,0x0d,0xbf,0xe6,0x42,0x68,0x41,0x99,0x2d,0x0f,0xb0,0x54,0xbb,0x16,
+};
+
+struct EncryptionTables {
+    std::uint32_t Te0[256], Te1[256], Te2[256], Te3[256];
+};
+constexpr EncryptionTables make_encryption_tables() {
+    EncryptionTables T{};
+    for (int x = 0; x < 256; ++x) {
+        const std::uint32_t s  = SBOX[x];
+        const std::uint32_t s2 = ((s << 1) ^ ((s >> 7) * 0x1b)) & 0xff;
+        const std::uint32_t s3 = s2 ^ s;
+        T.Te0[x] = (s2 << 24) | (s  << 16) | (s  << 8) | s3;
+        T.Te1[x] = (s3 << 24) | (s2 << 16) | (s  << 8) | s;
+        T.Te2[x] = (s  << 24) | (s3 << 16) | (s2 << 8) | s;
+        T.Te3[x] = (s  << 24) | (s  << 16) | (s3 << 8) | s2;
+    }
+    return T;
+}
+constexpr EncryptionTables TE = make_encryption_tables();
+
+inline std::uint32_t sub_word(std::uint32_t w) noexcept {
+    return (std::uint32_t(SBOX[w >> 24]) << 24) | (std::uint32_t(SBOX[(w >> 16) & 0xff]) << 16) |
+           (std::uint32_t(SBOX[(w >> 8) & 0xff]) << 8) | SBOX[w & 0xff];
+}
+
+void encrypt_block_portable(const std::uint8_t* round_keys, int rounds,
+                            const std::uint8_t* in, std::uint8_t* out) noexcept {
+    const std::uint8_t* rk = round_keys;
+    std::uint32_t s0 = load_be32(in)      ^ load_be32(rk);
+    std::uint32_t s1 = load_be32(in + 4)  ^ load_be32(rk + 4);
+    std::uint32_t s2 = load_be32(in + 8)  ^ load_be32(rk + 8);
+    std::uint32_t s3 = load_be32(in + 12) ^ load_be32(rk + 12);
+    for (int r = 1; r < rounds; ++r) {
+        rk += AES_BLOCK_BYTES;
+        const std::uint32_t t0 = TE.Te0[s0 >> 24] ^ TE.Te1[(s1 >> 16) & 0xff] ^
+                                 TE.Te2[(s2 >> 8) & 0xff] ^ TE.Te3[s3 & 0xff] ^ load_be32(rk);
+        const std::uint32_t t1 = TE.Te0[s1 >> 24] ^ TE.Te1[(s2 >> 16) & 0xff] ^
+                                 TE.Te2[(s3 >> 8) & 0xff] ^ TE.Te3[s0 & 0xff] ^ load_be32(rk + 4);
+        const std::uint32_t t2 = TE.Te0[s2 >> 24] ^ TE.Te1[(s3 >> 16) & 0xff] ^
+                                 TE.Te2[(s0 >> 8) & 0xff] ^ TE.Te3[s1 & 0xff] ^ load_be32(rk + 8);
+        const std::uint32_t t3 = TE.Te0[s3 >> 24] ^ TE.Te1[(s0 >> 16) & 0xff] ^
+                                 TE.Te2[(s1 >> 8) & 0xff] ^ TE.Te3[s2 & 0xff] ^ load_be32(rk + 12);
+        s0 = t0; s1 = t1; s2 = t2; s3 = t3;
+    }
+    rk += AES_BLOCK_BYTES;
+    auto last = [](std::uint32_t a, std::uint32_t b, std::uint32_t c, std::uint32_t d) {
+        return (std::uint32_t(SBOX[a >> 24]) << 24) | (std::uint32_t(SBOX[(b >> 16) & 0xff]) << 16) |
+               (std::uint32_t(SBOX[(c >> 8) & 0xff]) << 8) | SBOX[d & 0xff];
+    };
+    store_be32(out,      last(s0, s1, s2, s3) ^ load_be32(rk));
+    store_be32(out + 4,  last(s1, s2, s3, s0) ^ load_be32(rk + 4));
+    store_be32(out + 8,  last(s2, s3, s0, s1) ^ load_be32(rk + 8));
+    store_be32(out + 12, last(s3, s0, s1, s2) ^ load_be32(rk + 12));
+}
+
+// MARK: - PORTABLE GHASH (4-bit tables)
+constexpr std::uint64_t LAST4[16] = {
+    0x0000, 0x1c20, 0x3840, 0x2460, 0x7080, 0x6ca0, 0x48c0, 0x54e0,
+    0xe100, 0xfd20, 0xd940, 0xc560, 0x9180, 0x8da0, 0xa9c0, 0xb5e0,
+};
+
+void gf_multiply_portable(const std::uint64_t* HL, const std::uint64_t* HH, std::uint8_t* X) noexcept {
+    std::uint8_t lo  = X[15] & 0x0f;
+    std::uint64_t zh = HH[lo];
+    std::uint64_t zl = HL[lo];
+    for (int i = 15; i >= 0; --i) {
+        lo = X[i] & 0x0f;
+        const std::uint8_t hi = (X[i] >> 4) & 0x0f;
+        if (i != 15) {
+            const std::uint8_t rem = std::uint8_t(zl & 0x0f);
+            zl  = (zh << 60) | (zl >> 4);
+            zh  = (zh >> 4) ^ (LAST4[rem] << 48);
+            zh ^= HH[lo];
+            zl ^= HL[lo];
+        }
+        const std::uint8_t rem = std::uint8_t(zl & 0x0f);
+        zl  = (zh << 60) | (zl >> 4);
+        zh  = (zh >> 4) ^ (LAST4[rem] << 48);
+        zh ^= HH[hi];
+        zl ^= HL[hi];
+    }
+    store_be64(X, zh);
+    store_be64(X + 8, zl);
+}
+
+#if IFE_CIPHER_X86
+// MARK: - AES-NI / PCLMULQDQ
+inline std::uint32_t byte_swap32(std::uint32_t v) noexcept {
+#if defined(_MSC_VER)
+    return _byteswap_ulong(v);
+#else
+    return __builtin_bswap32(v);
+#endif
+}
+
+IFE_TARGET_AESNI inline __m128i byte_reflect(__m128i x) noexcept {
+    const __m128i BSWAP = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    return _mm_shuffle_epi8(x, BSWAP);
+}
+
+IFE_TARGET_AESNI inline __m128i aesni_encrypt(__m128i block, const std::uint8_t* rk, int rounds) noexcept {
+    block = _mm_xor_si128(block, _mm_load_si128(reinterpret_cast<const __m128i*>(rk)));
+    for (int r = 1; r < rounds; ++r)
+        block = _mm_aesenc_si128(block, _mm_load_si128(reinterpret_cast<const __m128i*>(rk + r * AES_BLOCK_BYTES)));
+    return _mm_aesenclast_si128(block, _mm_load_si128(reinterpret_cast<const __m128i*>(rk + rounds * AES_BLOCK_BYTES)));
+}
+
+// Carry-less multiplication of byte-reflected operands with reduction modulo
+// x^128 + x^7 + x^2 + x + 1 (Intel AES-NI / PCLMULQDQ white paper, algorithm 5).
+IFE_TARGET_AESNI inline __m128i gf_multiply_clmul(__m128i a, __m128i b) noexcept {
+    __m128i lo  = _mm_clmulepi64_si128(a, b, 0x00);
+    __m128i mid = _mm_xor_si128(_mm_clmulepi64_si128(a, b, 0x10), _mm_clmulepi64_si128(a, b, 0x01));
+    __m128i hi  = _mm_clmulepi64_si128(a, b, 0x11);
+    lo  = _mm_xor_si128(lo, _mm_slli_si128(mid, 8));
+    hi  = _mm_xor_si128(hi, _mm_srli_si128(mid, 8));
+
+    // Shift the 256-bit product left by one bit (reflected operands)
+    __m128i lo_carry = _mm_srli_epi32(lo, 31);
+    __m128i hi_carry = _mm_srli_epi32(hi, 31);
+    lo  = _mm_slli_epi32(lo, 1);
+    hi  = _mm_slli_epi32(hi, 1);
+    const __m128i cross = _mm_srli_si128(lo_carry, 12);
+    hi_carry = _mm_slli_si128(hi_carry, 4);
+    lo_carry = _mm_slli_si128(lo_carry, 4);
+    lo  = _mm_or_si128(lo, lo_carry);
+    hi  = _mm_or_si128(_mm_or_si128(hi, hi_carry), cross);
+
+    // Reduce
+    __m128i t = _mm_xor_si128(_mm_xor_si128(_mm_slli_epi32(lo, 31), _mm_slli_epi32(lo, 30)),
+                              _mm_slli_epi32(lo, 25));
+    const __m128i carry = _mm_srli_si128(t, 4);
+    lo  = _mm_xor_si128(lo, _mm_slli_si128(t, 12));
+    t   = _mm_xor_si128(_mm_xor_si128(_mm_srli_epi32(lo, 1), _mm_srli_epi32(lo, 2)),
+                        _mm_xor_si128(_mm_srli_epi32(lo, 7), carry));
+    lo  = _mm_xor_si128(lo, t);
+    return _mm_xor_si128(hi, lo);
+}
+
+IFE_TARGET_AESNI void ghash_clmul(const std::uint8_t* H_powers, std::uint8_t* X,
+                                  const std::uint8_t* data, std::size_t bytes) noexcept {
+    const __m128i H1 = _mm_load_si128(reinterpret_cast<const __m128i*>(H_powers));
+    const __m128i H2 = _mm_load_si128(reinterpret_cast<const __m128i*>(H_powers + 16));
+    const __m128i H3 = _mm_load_si128(reinterpret_cast<const __m128i*>(H_powers + 32));
+    const __m128i H4 = _mm_load_si128(reinterpret_cast<const __m128i*>(H_powers + 48));
+    __m128i x = byte_reflect(_mm_loadu_si128(reinterpret_cast<const __m128i*>(X)));
+    std::size_t i = 0;
+    // Four independent multiplies per iteration: X' = (X^C0)H^4 + C1 H^3 + C2 H^2 + C3 H
+    for (; i + 64 <= bytes; i += 64) {
+        const __m128i c0 = _mm_xor_si128(x, byte_reflect(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i))));
+        const __m128i c1 = byte_reflect(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 16)));
+        const __m128i c2 = byte_reflect(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 32)));
+        const __m128i c3 = byte_reflect(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 48)));
+        x = _mm_xor_si128(_mm_xor_si128(gf_multiply_clmul(c0, H4), gf_multiply_clmul(c1, H3)),
+                          _mm_xor_si128(gf_multiply_clmul(c2, H2), gf_multiply_clmul(c3, H1)));
+    }
+    for (; i < bytes; i += AES_BLOCK_BYTES) {
+        alignas(16) std::uint8_t block[AES_BLOCK_BYTES] = {};
+        std::memcpy(block, data + i, bytes - i < AES_BLOCK_BYTES ? bytes - i : AES_BLOCK_BYTES);
+        x = gf_multiply_clmul(_mm_xor_si128(x, byte_reflect(_mm_load_si128(reinterpret_cast<const __m128i*>(block)))), H1);
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(X), byte_reflect(x));
+}
+
+IFE_TARGET_AESNI inline __m128i counter_block(__m128i base, std::uint32_t counter) noexcept {
+    return _mm_insert_epi32(base, int(byte_swap32(counter)), 3);
+}
+
+IFE_TARGET_AESNI inline void xor_store(std::uint8_t* dst, const std::uint8_t* src, __m128i keystream) noexcept {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst),
+                     _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src)), keystream));
+}
+
+IFE_TARGET_AESNI void ctr_aesni(const std::uint8_t* rk, int rounds, const std::uint8_t* J0,
+                                const std::uint8_t* src, std::size_t bytes, std::uint8_t* dst) noexcept {
+    const __m128i base = _mm_loadu_si128(reinterpret_cast<const __m128i*>(J0));
+    std::uint32_t counter = load_be32(J0 + 12);
+    std::size_t i = 0;
+    for (; i + 64 <= bytes; i += 64) {
+        __m128i b0 = counter_block(base, counter + 1), b1 = counter_block(base, counter + 2);
+        __m128i b2 = counter_block(base, counter + 3), b3 = counter_block(base, counter + 4);
+        counter += 4;
+        __m128i k = _mm_load_si128(reinterpret_cast<const __m128i*>(rk));
+        b0 = _mm_xor_si128(b0, k); b1 = _mm_xor_si128(b1, k);
+        b2 = _mm_xor_si128(b2, k); b3 = _mm_xor_si128(b3, k);
+        for (int r = 1; r < rounds; ++r) {
+            k  = _mm_load_si128(reinterpret_cast<const __m128i*>(rk + r * AES_BLOCK_BYTES));
+            b0 = _mm_aesenc_si128(b0, k); b1 = _mm_aesenc_si128(b1, k);
+            b2 = _mm_aesenc_si128(b2, k); b3 = _mm_aesenc_si128(b3, k);
+        }
+        k  = _mm_load_si128(reinterpret_cast<const __m128i*>(rk + rounds * AES_BLOCK_BYTES));
+        b0 = _mm_aesenclast_si128(b0, k); b1 = _mm_aesenclast_si128(b1, k);
+        b2 = _mm_aesenclast_si128(b2, k); b3 = _mm_aesenclast_si128(b3, k);
+        xor_store(dst + i,      src + i,      b0);
+        xor_store(dst + i + 16, src + i + 16, b1);
+        xor_store(dst + i + 32, src + i + 32, b2);
+        xor_store(dst + i + 48, src + i + 48, b3);
+    }
+    for (; i < bytes; i += AES_BLOCK_BYTES) {
+        alignas(16) std::uint8_t keystream[AES_BLOCK_BYTES];
+        _mm_store_si128(reinterpret_cast<__m128i*>(keystream), aesni_encrypt(counter_block(base, ++counter), rk, rounds));
+        const std::size_t n = bytes - i < AES_BLOCK_BYTES ? bytes - i : AES_BLOCK_BYTES;
+        for (std::size_t j = 0; j < n; ++j) dst[i + j] = src[i + j] ^ keystream[j];
+    }
+}
+
+IFE_TARGET_AESNI void h_powers_clmul(const std::uint8_t* H, std::uint8_t* H_powers) noexcept {
+    const __m128i H1 = byte_reflect(_mm_loadu_si128(reinterpret_cast<const __m128i*>(H)));
+    const __m128i H2 = gf_multiply_clmul(H1, H1);
+    const __m128i H3 = gf_multiply_clmul(H2, H1);
+    const __m128i H4 = gf_multiply_clmul(H3, H1);
+    _mm_store_si128(reinterpret_cast<__m128i*>(H_powers),      H1);
+    _mm_store_si128(reinterpret_cast<__m128i*>(H_powers + 16), H2);
+    _mm_store_si128(reinterpret_cast<__m128i*>(H_powers + 32), H3);
+    _mm_store_si128(reinterpret_cast<__m128i*>(H_powers + 48), H4);
+}
+
+IFE_TARGET_AESNI void encrypt_block_aesni(const std::uint8_t* rk, int rounds,
+                                          const std::uint8_t* in, std::uint8_t* out) noexcept {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out),
+                     aesni_encrypt(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in)), rk, rounds));
+}
+
+bool detect_hardware() noexcept {
+#if defined(_MSC_VER)
+    int info[4] = {};
+    __cpuid(info, 1);
+    const bool aes = info[2] & (1 << 25), pclmul = info[2] & (1 << 1), sse41 = info[2] & (1 << 19);
+    return aes && pclmul && sse41;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("aes") && __builtin_cpu_supports("pclmul") &&
+           __builtin_cpu_supports("sse4.1");
+#endif
+}
+#else
+bool detect_hardware() noexcept { return false; }
+#endif
+
+} // namespace
+
+// MARK: - AES_GCM
+bool AES_GCM::hardware_supported() noexcept {
+    static const bool supported = detect_hardware();
+    return supported;
+}
+
+AES_GCM::AES_GCM(const std::uint8_t* key, std::size_t key_bytes, bool allow_hardware) {
+    if (key == nullptr || (key_bytes != 16 && key_bytes != 32))
+        throw std::invalid_argument("IFE::AES_GCM: key shall be 16 (AES-128) or 32 (AES-256) bytes");
+
+    // FIPS-197 key expansion
+    const int Nk    = int(key_bytes / 4);
+    m_rounds        = Nk + 6;
+    const int words = 4 * (m_rounds + 1);
+    std::uint32_t w[60];
+    for (int i = 0; i < Nk; ++i) w[i] = load_be32(key + 4 * i);
+    std::uint32_t rcon = 0x01;
+    for (int i = Nk; i < words; ++i) {
+        std::uint32_t temp = w[i - 1];
+        if (i % Nk == 0) {
+            temp = sub_word((temp << 8) | (temp >> 24)) ^ (rcon << 24);
+            rcon = ((rcon << 1) ^ ((rcon >> 7) * 0x1b)) & 0xff;
+        } else if (Nk > 6 && i % Nk == 4) {
+            temp = sub_word(temp);
+        }
+        w[i] = w[i - Nk] ^ temp;
+    }
+    for (int i = 0; i < words; ++i) store_be32(m_round_keys + 4 * i, w[i]);
+
+    m_hardware = allow_hardware && hardware_supported();
+
+    // GHASH key H = E(K, 0^128)
+    std::uint8_t H[AES_BLOCK_BYTES] = {};
+    encrypt_block(H, H);
+#if IFE_CIPHER_X86
+    if (m_hardware) h_powers_clmul(H, m_H_powers);
+#endif
+    std::uint64_t vh = load_be64(H), vl = load_be64(H + 8);
+    m_HL[8] = vl;
+    m_HH[8] = vh;
+    for (int i = 4; i > 0; i >>= 1) {
+        const std::uint64_t T = (vl & 1) * 0xe1000000ULL;
+        vl = (vh << 63) | (vl >> 1);
+        vh = (vh >> 1) ^ (T << 32);
+        m_HL[i] = vl;
+        m_HH[i] = vh;
+    }
+    for (int i = 2; i <= 8; i *= 2)
+        for (int j = 1; j < i; ++j) {
+            m_HH[i + j] = m_HH[i] ^ m_HH[j];
+            m_HL[i + j] = m_HL[i] ^ m_HL[j];
+        }
+    std::memset(H, 0, sizeof(H));
+}
+
+void AES_GCM::encrypt_block(const std::uint8_t* in, std::uint8_t* out) const noexcept {
+#if IFE_CIPHER_X86
+    if (m_hardware) return encrypt_block_aesni(m_round_keys, m_rounds, in, out);
+#endif
+    encrypt_block_portable(m_round_keys, m_rounds, in, out);
+}
+
+void AES_GCM::ghash(std::uint8_t* X, const std::uint8_t* data, std::size_t bytes) const noexcept {
+#if IFE_CIPHER_X86
+    if (m_hardware) return ghash_clmul(m_H_powers, X, data, bytes);
+#endif
+    for (std::size_t i = 0; i < bytes; i += AES_BLOCK_BYTES) {
+        const std::size_t n = bytes - i < AES_BLOCK_BYTES ? bytes - i : AES_BLOCK_BYTES;
+        for (std::size_t j = 0; j < n; ++j) X[j] ^= data[i + j];
+        gf_multiply_portable(m_HL, m_HH, X);
+    }
+}
+
+void AES_GCM::ctr(const std::uint8_t* J0, const std::uint8_t* src, std::size_t bytes,
+                  std::uint8_t* dst) const noexcept {
+#if IFE_CIPHER_X86
+    if (m_hardware) return ctr_aesni(m_round_keys, m_rounds, J0, src, bytes, dst);
+#endif
+    std::uint8_t counter[AES_BLOCK_BYTES], keystream[AES_BLOCK_BYTES];
+    std::memcpy(counter, J0, AES_BLOCK_BYTES);
+    std::uint32_t c = load_be32(J0 + 12);
+    for (std::size_t i = 0; i < bytes; i += AES_BLOCK_BYTES) {
+        store_be32(counter + 12, ++c);
+        encrypt_block_portable(m_round_keys, m_rounds, counter, keystream);
+        const std::size_t n = bytes - i < AES_BLOCK_BYTES ? bytes - i : AES_BLOCK_BYTES;
+        for (std::size_t j = 0; j < n; ++j) dst[i + j] = src[i + j] ^ keystream[j];
+    }
+}
+
+void AES_GCM::tag(const std::uint8_t* nonce, const std::uint8_t* aad, std::size_t aad_bytes,
+                  const std::uint8_t* cipher, std::size_t bytes, std::uint8_t* tag) const noexcept {
+    std::uint8_t X[AES_BLOCK_BYTES] = {};
+    ghash(X, aad, aad_bytes);
+    ghash(X, cipher, bytes);
+    std::uint8_t lengths[AES_BLOCK_BYTES];
+    store_be64(lengths,     std::uint64_t(aad_bytes) * 8);
+    store_be64(lengths + 8, std::uint64_t(bytes) * 8);
+    ghash(X, lengths, AES_BLOCK_BYTES);
+
+    std::uint8_t J0[AES_BLOCK_BYTES];
+    std::memcpy(J0, nonce, GCM_NONCE_BYTES);
+    store_be32(J0 + 12, 1);
+    encrypt_block(J0, J0);
+    for (std::size_t i = 0; i < GCM_TAG_BYTES; ++i) tag[i] = X[i] ^ J0[i];
+}
+
+void AES_GCM::encrypt(const std::uint8_t* nonce,
+                      const std::uint8_t* aad, std::size_t aad_bytes,
+                      const std::uint8_t* src, std::size_t bytes,
+                      std::uint8_t* dst, std::uint8_t* tag) const noexcept {
+    std::uint8_t J0[AES_BLOCK_BYTES];
+    std::memcpy(J0, nonce, GCM_NONCE_BYTES);
+    store_be32(J0 + 12, 1);
+    ctr(J0, src, bytes, dst);
+    this->tag(nonce, aad, aad_bytes, dst, bytes, tag);
+}
+
+bool AES_GCM::decrypt(const std::uint8_t* nonce,
+                      const std::uint8_t* aad, std::size_t aad_bytes,
+                      const std::uint8_t* src, std::size_t bytes,
+                      std::uint8_t* dst, const std::uint8_t* tag) const noexcept {
+    std::uint8_t expected[GCM_TAG_BYTES];
+    this->tag(nonce, aad, aad_bytes, src, bytes, expected);
+    if (!constant_time_equal(expected, tag, GCM_TAG_BYTES)) {
+        if (bytes) std::memset(dst, 0, bytes);
+        return false;
+    }
+    std::uint8_t J0[AES_BLOCK_BYTES];
+    std::memcpy(J0, nonce, GCM_NONCE_BYTES);
+    store_be32(J0 + 12, 1);
+    ctr(J0, src, bytes, dst);
+    return true;
+}
+
+// MARK: - UTILITIES
+void random_bytes(std::uint8_t* dst, std::size_t bytes) {
+    std::random_device device;
+    for (std::size_t i = 0; i < bytes; i += 4) {
+        const std::uint32_t value = device();
+        for (std::size_t j = 0; j < 4 && i + j < bytes; ++j)
+            dst[i + j] = std::uint8_t(value >> (8 * j));
+    }
+}
+
+bool constant_time_equal(const std::uint8_t* a, const std::uint8_t* b, std::size_t bytes) noexcept {
+    std::uint8_t diff = 0;
+    for (std::size_t i = 0; i < bytes; ++i) diff |= std::uint8_t(a[i] ^ b[i]);
+    return diff == 0;
+}
+
+} // namespace IFE
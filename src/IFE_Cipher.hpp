@@ -0,0 +1,103 @@
+/**
+ * @file IFE_Cipher.hpp
+ * @brief AES-GCM authenticated encryption primitives backing the Iris File
+ *        Extension per-tile cipher (`Serialization::CIPHER`).
+ *
+ * This header is private to the extension library; applications use the
+ * tile cipher entry methods declared in IrisCodecExtension.hpp.
+ *
+ * Design:
+ *   - `AES_GCM` holds the expanded AES-128 / AES-256 key schedule and the
+ *     GHASH key (H) of a single cipher key. It is immutable after
+ *     construction and may be shared across threads without locking.
+ *   - On x86 / x86-64 processors reporting AES-NI and PCLMULQDQ, the counter
+ *     mode keystream is generated four blocks at a time with AES-NI and
+ *     GHASH uses carry-less multiplication (four independent multiplies by
+ *     H^4..H^1 per iteration). Support is detected once at run time.
+ *   - Elsewhere (ARM, WebAssembly, older x86), a portable T-table AES and a
+ *     4-bit table GHASH (Shoup's method) are used. Both paths produce
+ *     identical output (NIST SP 800-38D). The portable path is table
+ *     driven and therefore not constant time.
+ *   - Only 96-bit nonces are supported; tile nonces are drawn at random.
+ *
+ * @copyright Copyright (c) 2026 Ryan Landvater. MIT licensed.
+ */
+#ifndef IFE_Cipher_hpp
+#define IFE_Cipher_hpp
+
+#include <cstddef>
+#include <cstdint>
+
+namespace IFE {
+
+/// GCM nonce (IV) length in bytes. Only 96-bit nonces are supported.
+constexpr std::size_t GCM_NONCE_BYTES = 12;
+
+/// GCM authentication tag length in bytes (full 128-bit tags).
+constexpr std::size_t GCM_TAG_BYTES   = 16;
+
+/// AES block length in bytes.
+constexpr std::size_t AES_BLOCK_BYTES = 16;
+
+/**
+ * @brief AES-GCM key context (NIST SP 800-38D) for 128 or 256-bit keys.
+ *
+ * Thread-safe for concurrent encrypt / decrypt calls once constructed.
+ */
+class AES_GCM {
+public:
+    /// Expand a 16 (AES-128) or 32 (AES-256) byte key. The hardware path is
+    /// used when supported unless `allow_hardware` is false.
+    /// @throws std::invalid_argument for any other key length.
+    AES_GCM(const std::uint8_t* key, std::size_t key_bytes, bool allow_hardware = true);
+
+    /// Encrypt `bytes` of `src` into `dst` (may alias `src`) and write the tag.
+    void encrypt(const std::uint8_t* nonce,
+                 const std::uint8_t* aad, std::size_t aad_bytes,
+                 const std::uint8_t* src, std::size_t bytes,
+                 std::uint8_t* dst, std::uint8_t* tag) const noexcept;
+
+    /// Authenticate and decrypt `bytes` of `src` into `dst` (may alias `src`).
+    /// The tag is verified in constant time before any plaintext is released;
+    /// on failure `dst` is zeroed and false is returned.
+    bool decrypt(const std::uint8_t* nonce,
+                 const std::uint8_t* aad, std::size_t aad_bytes,
+                 const std::uint8_t* src, std::size_t bytes,
+                 std::uint8_t* dst, const std::uint8_t* tag) const noexcept;
+
+    /// Single-block AES encryption (checked against FIPS-197 in ife_cipher_tests).
+    void encrypt_block(const std::uint8_t* in, std::uint8_t* out) const noexcept;
+
+    /// Number of AES rounds (10 for AES-128, 14 for AES-256).
+    int rounds() const noexcept { return m_rounds; }
+
+    /// True if this context uses the AES-NI / PCLMULQDQ path.
+    bool hardware_accelerated() const noexcept { return m_hardware; }
+
+    /// True if the executing processor supports the AES-NI / PCLMULQDQ path.
+    static bool hardware_supported() noexcept;
+
+private:
+    void ghash(std::uint8_t* X, const std::uint8_t* data, std::size_t bytes) const noexcept;
+    void ctr  (const std::uint8_t* J0, const std::uint8_t* src, std::size_t bytes,
+               std::uint8_t* dst) const noexcept;
+    void tag  (const std::uint8_t* nonce, const std::uint8_t* aad, std::size_t aad_bytes,
+               const std::uint8_t* cipher, std::size_t bytes, std::uint8_t* tag) const noexcept;
+
+    alignas(16) std::uint8_t m_round_keys[15 * AES_BLOCK_BYTES] = {};
+    alignas(16) std::uint8_t m_H_powers[4 * AES_BLOCK_BYTES]    = {}; // Byte-reflected H^1..H^4 (hardware)
+    std::uint64_t            m_HL[16]    = {};                         // 4-bit GHASH tables (software)
+    std::uint64_t            m_HH[16]    = {};
+    int                      m_rounds    = 0;
+    bool                     m_hardware  = false;
+};
+
+/// Fill `bytes` of `dst` from the operating system random device.
+void random_bytes(std::uint8_t* dst, std::size_t bytes);
+
+/// Constant time comparison of two byte arrays.
+bool constant_time_equal(const std::uint8_t* a, const std::uint8_t* b, std::size_t bytes) noexcept;
+
+} // namespace IFE
+
+#endif /* IFE_Cipher_hpp */
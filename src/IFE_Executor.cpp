@@ -0,0 +1,250 @@
+/**
+ * @file IFE_Executor.cpp
+ * @brief Executors of the Iris File Extension parallel paths. See the
+ *        executor entry methods declared in IrisCodecExtension.hpp.
+ *
+ * Design:
+ *   - `Executor::bulk` shares an index counter between the calling thread
+ *     and up to concurrency() - 1 helper tasks. The counter, the function and
+ *     the completion count are held in shared state such that helper tasks
+ *     scheduled after the batch completes find no work and return. The
+ *     caller only waits upon indices already claimed by running helpers and
+ *     therefore never deadlocks when called from within a task.
+ *   - `ThreadPool` gives each worker a deque per priority. Tasks submitted
+ *     from a worker are pushed onto that worker's deques (and popped LIFO
+ *     for locality); other submissions are distributed round-robin. Idle
+ *     workers steal FIFO from the other workers, always taking the highest
+ *     priority task available. Workers sleep on a single condition variable
+ *     while no task is pending.
+ *   - The queues are shared by the pool and its workers. A task may hold the
+ *     last reference to the pool (ex: through an I/O scheduler); destroyed on
+ *     a worker, the pool detaches that worker rather than joining it and the
+ *     worker drains the queues from the shared state.
+ *
+ * @copyright Copyright (c) 2026 Ryan Landvater. MIT licensed.
+ */
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <thread>
+#include <vector>
+#include "IrisTypes.hpp"
+#include "IrisCodecTypes.hpp"
+#include "IrisCodecExtension.hpp"
+
+namespace IrisCodec {
+namespace {
+constexpr size_t PRIORITIES = PRIORITY_HIGH + 1;
+
+struct BulkState {
+    explicit BulkState          (size_t __count, const Executor::Function& __function) :
+    count                       (__count),
+    function                    (__function) {}
+    const size_t                count;
+    const Executor::Function    function;
+    std::atomic<size_t>         next        = 0;
+    std::atomic<size_t>         done        = 0;
+    std::mutex                  mutex;
+    std::condition_variable     complete;
+    std::exception_ptr          exception;
+};
+void RUN_BULK (BulkState& state) noexcept
+{
+    for (size_t index = state.next++; index < state.count; index = state.next++) {
+        try {
+            state.function(index);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock (state.mutex);
+            if (!state.exception) state.exception = std::current_exception();
+        }
+        if (++state.done == state.count) {
+            std::lock_guard<std::mutex> lock (state.mutex);
+            state.complete.notify_all();
+        }
+    }
+}
+
+class InlineExecutor final : public Executor {
+public:
+    void submit (Task&& task, ExecutorPriority) override
+    {
+        try { task(); } catch (...) {}
+    }
+    uint32_t concurrency () const noexcept override {return 1;}
+    void bulk (size_t count, const Function& function, ExecutorPriority) override
+    {
+        std::exception_ptr exception;
+        for (size_t index = 0; index < count; ++index) {
+            try { function(index); }
+            catch (...) { if (!exception) exception = std::current_exception(); }
+        }
+        if (exception) std::rethrow_exception(exception);
+    }
+};
+
+struct PoolState {
+    struct Queue {
+        std::mutex              mutex;
+        std::deque<Executor::Task> tasks [PRIORITIES];
+    };
+    bool pop                    (size_t worker, Executor::Task&);
+    static void run             (std::shared_ptr<PoolState>, size_t worker);
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::mutex                  mutex;
+    std::condition_variable     wake;
+    std::atomic<size_t>         pending     = 0;
+    std::atomic<size_t>         cursor      = 0;
+    bool                        stop        = false;
+};
+class ThreadPool final : public Executor {
+public:
+    explicit ThreadPool         (uint32_t threads);
+    ~ThreadPool                 () override;
+    void submit                 (Task&&, ExecutorPriority) override;
+    uint32_t concurrency        () const noexcept override
+    {return static_cast<uint32_t>(__state->queues.size());}
+private:
+    const std::shared_ptr<PoolState> __state;
+    std::vector<std::thread>    __workers;
+};
+thread_local const PoolState*   CURRENT_POOL    = nullptr;
+thread_local size_t             CURRENT_WORKER  = 0;
+
+ThreadPool::ThreadPool (uint32_t threads) :
+__state (std::make_shared<PoolState>())
+{
+    if (threads == 0) threads = std::max(std::thread::hardware_concurrency(), 1U);
+    __state->queues.reserve(threads);
+    for (uint32_t WI = 0; WI < threads; ++WI)
+        __state->queues.push_back(std::make_unique<PoolState::Queue>());
+    try {
+        __workers.reserve(threads);
+        for (uint32_t WI = 0; WI < threads; ++WI)
+            __workers.emplace_back(&PoolState::run, __state, WI);
+    } catch (...) {
+        if (__workers.empty()) throw;
+        // Fewer workers service the queues (see pop)
+    }
+}
+ThreadPool::~ThreadPool ()
+{
+    {
+        std::lock_guard<std::mutex> lock (__state->mutex);
+        __state->stop = true;
+    }
+    __state->wake.notify_all();
+    for (auto&& worker : __workers) {
+        if (worker.get_id() == std::this_thread::get_id()) worker.detach();
+        else worker.join();
+    }
+}
+void ThreadPool::submit (Task&& task, ExecutorPriority priority)
+{
+    auto& state = *__state;
+    const size_t worker = CURRENT_POOL == &state ? CURRENT_WORKER :
+                          state.cursor.fetch_add(1, std::memory_order_relaxed) % state.queues.size();
+    auto& queue = *state.queues[worker];
+    {
+        std::lock_guard<std::mutex> lock (queue.mutex);
+        queue.tasks[std::min<size_t>(priority, PRIORITIES - 1)].push_back(std::move(task));
+    }
+    ++state.pending;
+    {
+        std::lock_guard<std::mutex> lock (state.mutex);
+    }
+    state.wake.notify_one();
+}
+bool PoolState::pop (size_t worker, Executor::Task& task)
+{
+    for (size_t PI = PRIORITIES; PI-- > 0;) {
+        // Own queue (most recently submitted first)
+        {
+            auto& queue = *queues[worker];
+            std::lock_guard<std::mutex> lock (queue.mutex);
+            if (queue.tasks[PI].size()) {
+                task = std::move(queue.tasks[PI].back());
+                queue.tasks[PI].pop_back();
+                --pending;
+                return true;
+            }
+        }
+        // Steal the oldest task of another queue
+        for (size_t QI = 1; QI < queues.size(); ++QI) {
+            auto& queue = *queues[(worker + QI) % queues.size()];
+            std::lock_guard<std::mutex> lock (queue.mutex);
+            if (queue.tasks[PI].size()) {
+                task = std::move(queue.tasks[PI].front());
+                queue.tasks[PI].pop_front();
+                --pending;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+void PoolState::run (std::shared_ptr<PoolState> state, size_t worker)
+{
+    CURRENT_POOL    = state.get();
+    CURRENT_WORKER  = worker;
+    Executor::Task task;
+    while (true) {
+        if (state->pop(worker, task)) {
+            try { task(); } catch (...) {}
+            task = nullptr;
+            continue;
+        }
+        std::unique_lock<std::mutex> lock (state->mutex);
+        state->wake.wait(lock, [&state] {return state->stop || state->pending.load() > 0;});
+        if (state->stop && state->pending.load() == 0) return;
+    }
+}
+
+std::mutex      DEFAULT_MUTEX;
+SharedExecutor  DEFAULT_EXECUTOR;
+} // namespace
+
+void Executor::bulk (size_t count, const Function& function, ExecutorPriority priority)
+{
+    if (count == 0) return;
+    auto state = std::make_shared<BulkState>(count, function);
+    const size_t helpers = std::min<size_t>(concurrency() > 1 ? concurrency() - 1 : 0, count - 1);
+    for (size_t HI = 0; HI < helpers; ++HI) {
+        try {
+            submit([state]() {RUN_BULK(*state);}, priority);
+        } catch (...) {
+            break; // The calling thread completes the batch
+        }
+    }
+    RUN_BULK(*state);
+    std::unique_lock<std::mutex> lock (state->mutex);
+    state->complete.wait(lock, [&state] {return state->done.load() == state->count;});
+    if (state->exception) std::rethrow_exception(state->exception);
+}
+SharedExecutor create_thread_pool (uint32_t threads)
+{
+    return std::make_shared<ThreadPool>(threads);
+}
+SharedExecutor inline_executor ()
+{
+    static const SharedExecutor executor = std::make_shared<InlineExecutor>();
+    return executor;
+}
+SharedExecutor default_executor ()
+{
+    std::lock_guard<std::mutex> lock (DEFAULT_MUTEX);
+    if (!DEFAULT_EXECUTOR) {
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+        DEFAULT_EXECUTOR = inline_executor();
+#else
+        DEFAULT_EXECUTOR = create_thread_pool();
+#endif
+    }
+    return DEFAULT_EXECUTOR;
+}
+void set_default_executor (SharedExecutor executor)
+{
+    std::lock_guard<std::mutex> lock (DEFAULT_MUTEX);
+    DEFAULT_EXECUTOR = std::move(executor);
+}
+} // namespace IrisCodec
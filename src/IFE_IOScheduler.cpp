@@ -0,0 +1,299 @@
+/**
+ * @file IFE_IOScheduler.cpp
+ * @brief Weighted fair scheduling of tenant and class tagged I/O requests. See
+ *        the IOScheduler declarations in IrisCodecExtension.hpp.
+ *
+ * Design:
+ *   - Requests are queued per flow, a flow being a (class, tenant) pair. Each
+ *     request is stamped on arrival with a virtual start time, the later of the
+ *     scheduler's virtual time and the finish time of the flow's previous
+ *     request; the flow's finish time then advances by bytes / weight. As a
+ *     slot frees, the queued request of least start time is dispatched and the
+ *     virtual time advances to it (start-time fair queuing). A flow that falls
+ *     idle restarts at the current virtual time and so accrues no credit.
+ *   - At most `slots` requests are dispatched to the executor at once; the
+ *     batch and background classes may take all but the reserved slots.
+ *   - Dispatch submits outside the scheduler mutex. One thread dispatches at
+ *     a time and its loop picks up the slots freed meanwhile, such that the
+ *     inline executor (which completes each task within submit) does not
+ *     recurse.
+ *   - Queue waits are counted within a histogram of power-of-two microsecond
+ *     buckets per class; the percentiles report the bucket upper bounds.
+ *
+ * @copyright Copyright (c) 2026 Ryan Landvater. MIT licensed.
+ */
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <limits>
+#include <map>
+#include <unordered_map>
+#include "IrisTypes.hpp"
+#include "IrisCodecTypes.hpp"
+#include "IrisCodecExtension.hpp"
+
+namespace IrisCodec {
+namespace {
+using Clock                     = std::chrono::steady_clock;
+constexpr size_t    WAIT_BUCKETS    = 40;       // The last bucket holds waits of 2^38 us (3 days) or more
+constexpr Size      MIN_COST        = 4096;     // Bytes charged to requests of unknown or small size
+constexpr const char* CLASS_NAMES[IO_CLASSES] = {"interactive", "batch", "background"};
+
+struct GrantState {
+    bool                        granted     = false;
+};
+struct Request {
+    Executor::Task              task;           // NULL for a grant
+    std::shared_ptr<GrantState> grant;
+    Size                        bytes       = 0;
+    double                      start       = 0;
+    Clock::time_point           queued;
+};
+inline size_t CLASS_INDEX (IOClass ioClass)
+{
+    return std::min<size_t>(ioClass, IO_CLASSES - 1);
+}
+inline ExecutorPriority CLASS_PRIORITY (size_t ioClass)
+{
+    switch (ioClass) {
+        case IO_CLASS_INTERACTIVE:  return PRIORITY_HIGH;
+        case IO_CLASS_BATCH:        return PRIORITY_NORMAL;
+        default:                    return PRIORITY_LOW;
+    }
+}
+inline IOClass PRIORITY_CLASS (ExecutorPriority priority)
+{
+    switch (priority) {
+        case PRIORITY_HIGH:         return IO_CLASS_INTERACTIVE;
+        case PRIORITY_NORMAL:       return IO_CLASS_BATCH;
+        default:                    return IO_CLASS_BACKGROUND;
+    }
+}
+inline size_t WAIT_BUCKET (Clock::duration wait)
+{
+    const auto micro = std::chrono::duration_cast<std::chrono::microseconds>(wait).count();
+    size_t bucket = 0;
+    while (bucket + 1 < WAIT_BUCKETS && (1LL << bucket) <= micro) ++bucket;
+    return bucket;
+}
+
+class FairScheduler final : public IOScheduler,
+public std::enable_shared_from_this<FairScheduler> {
+public:
+    explicit FairScheduler      (const IOSchedulerCreateInfo&);
+    void submit                 (Task&&, ExecutorPriority) override;
+    uint32_t concurrency        () const noexcept override {return __slots;}
+    void submit                 (const IOTag&, Size, Task&&) override;
+    Grant acquire               (const IOTag&, Size) override;
+    void set_tenant_weight      (const std::string&, uint32_t) override;
+    IOClassMetrics metrics      (IOClass) const override;
+private:
+    struct Flow {
+        std::deque<Request>     requests;
+        double                  finish      = 0;
+    };
+    struct Class {
+        IOClassPolicy           policy;
+        std::map<std::string, Flow> flows;
+        uint32_t                queued      = 0;
+        uint32_t                inflight    = 0;
+        uint64_t                submitted   = 0;
+        uint64_t                completed   = 0;
+        uint64_t                rejected    = 0;
+        uint64_t                bytes       = 0;
+        std::array<uint64_t, WAIT_BUCKETS> waits {};
+    };
+    void enqueue                (size_t ioClass, const std::string& tenant, Request&&, bool limited);
+    void run                    (size_t ioClass, Request&&) noexcept;
+    void complete               (size_t ioClass, Size bytes) noexcept;
+    void dispatch               () noexcept;
+    const SharedExecutor        __executor;
+    const uint32_t              __slots;
+    const uint32_t              __reserved;
+    mutable std::mutex          __mutex;
+    std::condition_variable     __granted;
+    std::array<Class, IO_CLASSES> __classes;
+    std::unordered_map<std::string, uint32_t> __tenants;
+    double                      __vtime         = 0;
+    uint32_t                    __inflight      = 0;
+    bool                        __dispatching   = false;
+};
+
+FairScheduler::FairScheduler (const IOSchedulerCreateInfo& info) :
+__executor  (info.executor ? info.executor : default_executor()),
+__slots     (std::max(info.slots ? info.slots : __executor->concurrency(), 1U)),
+__reserved  (std::min(info.reserved, __slots - 1))
+{
+    for (size_t CI = 0; CI < IO_CLASSES; ++CI)
+        __classes[CI].policy = info.classes[CI];
+}
+void FairScheduler::submit (Task&& task, ExecutorPriority priority)
+{
+    Request request;
+    request.task = std::move(task);
+    enqueue(PRIORITY_CLASS(priority), std::string(), std::move(request), false);
+}
+void FairScheduler::submit (const IOTag& tag, Size bytes, Task&& task)
+{
+    Request request;
+    request.task  = std::move(task);
+    request.bytes = bytes;
+    enqueue(CLASS_INDEX(tag.ioClass), tag.tenant, std::move(request), true);
+}
+IOScheduler::Grant FairScheduler::acquire (const IOTag& tag, Size bytes)
+{
+    const auto ioClass = CLASS_INDEX(tag.ioClass);
+    auto grant      = std::make_shared<GrantState>();
+    Request request;
+    request.grant   = grant;
+    request.bytes   = bytes;
+    enqueue(ioClass, tag.tenant, std::move(request), true);
+    {
+        std::unique_lock<std::mutex> lock (__mutex);
+        __granted.wait(lock, [&grant] {return grant->granted;});
+    }
+    auto self = shared_from_this();
+    return Grant(grant.get(), [self, grant, ioClass, bytes](void*) {
+        self->complete(ioClass, bytes);
+    });
+}
+void FairScheduler::set_tenant_weight (const std::string& tenant, uint32_t weight)
+{
+    std::lock_guard<std::mutex> lock (__mutex);
+    if (weight) __tenants[tenant] = weight;
+    else __tenants.erase(tenant);
+}
+IOClassMetrics FairScheduler::metrics (IOClass ioClass) const
+{
+    std::lock_guard<std::mutex> lock (__mutex);
+    const auto& data    = __classes[CLASS_INDEX(ioClass)];
+    IOClassMetrics metrics;
+    metrics.submitted   = data.submitted;
+    metrics.completed   = data.completed;
+    metrics.rejected    = data.rejected;
+    metrics.queued      = data.queued;
+    metrics.inflight    = data.inflight;
+    metrics.bytes       = data.bytes;
+    uint64_t total      = 0;
+    for (auto count : data.waits) total += count;
+    const auto percentile = [&data, total](double fraction) {
+        uint64_t count  = 0;
+        for (size_t BI = 0; BI < WAIT_BUCKETS; ++BI)
+            if ((count += data.waits[BI]) >= fraction * total)
+                return double(1ULL << BI) * 1e-6;
+        return 0.;
+    };
+    if (total) {
+        metrics.wait_p50 = percentile(0.50);
+        metrics.wait_p99 = percentile(0.99);
+    }
+    return metrics;
+}
+void FairScheduler::enqueue (size_t ioClass, const std::string& tenant, Request&& request, bool limited)
+{
+    {
+        std::lock_guard<std::mutex> lock (__mutex);
+        auto& data          = __classes[ioClass];
+        if (limited && data.policy.max_queued && data.queued >= data.policy.max_queued) {
+            ++data.rejected;
+            throw std::runtime_error
+            ("Failed to schedule I/O request -- the " + std::string(CLASS_NAMES[ioClass]) +
+             " queue is full (" + std::to_string(data.policy.max_queued) + " requests)");
+        }
+        const auto tenant_weight = __tenants.find(tenant);
+        const double weight = double(std::max(data.policy.weight, 1U)) *
+                              (tenant_weight == __tenants.end() ? 1. : double(tenant_weight->second));
+        auto& flow          = data.flows[tenant];
+        request.start       = std::max(__vtime, flow.finish);
+        request.queued      = Clock::now();
+        flow.finish         = request.start + double(std::max(request.bytes, MIN_COST)) / weight;
+        flow.requests.push_back(std::move(request));
+        ++data.queued;
+        ++data.submitted;
+    }
+    dispatch();
+}
+void FairScheduler::run (size_t ioClass, Request&& request) noexcept
+{
+    auto task = std::make_shared<Task>(std::move(request.task));
+    const Size bytes = request.bytes;
+    try {
+        __executor->submit([self = shared_from_this(), task, ioClass, bytes]() {
+            try { (*task)(); } catch (...) {}
+            self->complete(ioClass, bytes);
+        }, CLASS_PRIORITY(ioClass));
+    } catch (...) {
+        // The executor declined the task; run it on the dispatching thread
+        try { if (*task) (*task)(); } catch (...) {}
+        complete(ioClass, bytes);
+    }
+}
+void FairScheduler::complete (size_t ioClass, Size bytes) noexcept
+{
+    {
+        std::lock_guard<std::mutex> lock (__mutex);
+        auto& data      = __classes[ioClass];
+        --data.inflight;
+        ++data.completed;
+        data.bytes     += bytes;
+        --__inflight;
+    }
+    dispatch();
+}
+void FairScheduler::dispatch () noexcept
+{
+    std::unique_lock<std::mutex> lock (__mutex);
+    if (__dispatching) return;
+    __dispatching = true;
+    while (__inflight < __slots) {
+        // Least virtual start time among the flows' first requests (ties favor the higher class)
+        Class*  next_class  = nullptr;
+        size_t  next_index  = 0;
+        std::map<std::string, Flow>::iterator next_flow;
+        double  start       = std::numeric_limits<double>::infinity();
+        for (size_t CI = 0; CI < IO_CLASSES; ++CI) {
+            if (CI != IO_CLASS_INTERACTIVE && __inflight >= __slots - __reserved) continue;
+            auto& data = __classes[CI];
+            for (auto flow = data.flows.begin(); flow != data.flows.end();) {
+                if (flow->second.requests.empty()) {
+                    // An idle flow restarts at the virtual time once it has caught up
+                    if (flow->second.finish <= __vtime) flow = data.flows.erase(flow);
+                    else ++flow;
+                    continue;
+                }
+                if (flow->second.requests.front().start < start) {
+                    start       = flow->second.requests.front().start;
+                    next_class  = &data;
+                    next_index  = CI;
+                    next_flow   = flow;
+                }
+                ++flow;
+            }
+        }
+        if (!next_class) break;
+
+        auto request    = std::move(next_flow->second.requests.front());
+        next_flow->second.requests.pop_front();
+        __vtime         = std::max(__vtime, request.start);
+        --next_class->queued;
+        ++next_class->inflight;
+        ++next_class->waits[WAIT_BUCKET(Clock::now() - request.queued)];
+        ++__inflight;
+        if (request.grant) {
+            request.grant->granted = true;
+            __granted.notify_all();
+            continue;
+        }
+        lock.unlock();
+        run(next_index, std::move(request));
+        lock.lock();
+    }
+    __dispatching = false;
+}
+} // namespace
+
+SharedIOScheduler create_io_scheduler (const IOSchedulerCreateInfo& info)
+{
+    return std::make_shared<FairScheduler>(info);
+}
+} // namespace IrisCodec
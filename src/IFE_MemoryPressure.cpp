@@ -0,0 +1,374 @@
+/**
+ * @file IFE_MemoryPressure.cpp
+ * @brief Cache reclaim protocol and memory pressure monitor. See the memory
+ *        pressure declarations in IrisCodecExtension.hpp.
+ *
+ * Design:
+ *   - Registered caches live in a process-wide list. Each entry carries a
+ *     mutex held while the cache is measured or shrunk; releasing the
+ *     registration takes that mutex, such that once the registration is
+ *     released the cache is never called again. A reclaim copies the list
+ *     and calls the caches without the list mutex held.
+ *   - The monitor thread polls a wake descriptor (closing the monitor), the
+ *     PSI trigger and memory.events. memory.events is a kernfs file: it
+ *     signals POLLPRI once modified and is re-read (from offset 0) to clear
+ *     the signal. A breach of memory.high or memory.max is counted as
+ *     pressure as the counts increase.
+ *   - The usage compared with the limits is the working set (memory.current
+ *     less the inactive file pages of memory.stat): the page cache of the
+ *     mapped slide files is reclaimed by the kernel and is not pressure.
+ *   - With a PSI trigger or memory.events the caches shrink only when
+ *     signaled; the cgroup usage sizes the reclaim. The whole-system measure
+ *     (/proc/meminfo) reflects every process of the host and is only used
+ *     by the polling fallback, which has no other signal.
+ *   - After the caches are shrunk glibc is asked to return free heap pages to
+ *     the system (malloc_trim), as freed cache entries otherwise remain
+ *     charged to the cgroup.
+ *
+ * @copyright Copyright (c) 2026 Ryan Landvater. MIT licensed.
+ */
+#include <algorithm>
+#include <list>
+#include <thread>
+#include <vector>
+#include "IrisTypes.hpp"
+#include "IrisCodecTypes.hpp"
+#include "IrisCodecExtension.hpp"
+#if defined(__linux__) && !defined(__EMSCRIPTEN__)
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+#define IFE_MEMORY_PRESSURE_LINUX 1
+#endif
+
+namespace IrisCodec {
+namespace {
+struct CacheEntry {
+    explicit CacheEntry         (ReclaimableCache&& __cache) :
+    cache                       (std::move(__cache)) {}
+    const ReclaimableCache      cache;
+    std::mutex                  mutex;      // Held while the cache is called
+    bool                        registered  = true;
+};
+using Entry = std::shared_ptr<CacheEntry>;
+std::mutex          REGISTRY_MUTEX;
+std::list<Entry>    REGISTRY;
+
+std::vector<Entry> REGISTERED_CACHES ()
+{
+    std::lock_guard<std::mutex> lock (REGISTRY_MUTEX);
+    return std::vector<Entry>(REGISTRY.begin(), REGISTRY.end());
+}
+Size CACHED_BYTES (CacheEntry& entry) noexcept
+{
+    std::lock_guard<std::mutex> lock (entry.mutex);
+    if (!entry.registered) return 0;
+    try { return entry.cache.cached_bytes(); }
+    catch (...) { return 0; }
+}
+} // namespace
+
+CacheRegistration register_cache (ReclaimableCache&& cache)
+{
+    if (!cache.shrink) throw std::runtime_error
+        ("Failed to register cache -- no shrink function was provided");
+    // A cache reporting no bytes is never asked to shrink
+    if (!cache.cached_bytes) throw std::runtime_error
+        ("Failed to register cache -- no cached bytes function was provided");
+    auto entry = std::make_shared<CacheEntry>(std::move(cache));
+    {
+        std::lock_guard<std::mutex> lock (REGISTRY_MUTEX);
+        REGISTRY.push_back(entry);
+    }
+    return CacheRegistration(entry.get(), [entry](void*) {
+        {
+            std::lock_guard<std::mutex> lock (entry->mutex);
+            entry->registered = false;
+        }
+        std::lock_guard<std::mutex> lock (REGISTRY_MUTEX);
+        REGISTRY.remove(entry);
+    });
+}
+Size reclaim_memory (Size bytes)
+{
+    if (bytes == 0) return 0;
+    struct Candidate {
+        Entry   entry;
+        Size    cached;
+    };
+    std::vector<Candidate> candidates;
+    for (auto&& entry : REGISTERED_CACHES())
+        if (auto cached = CACHED_BYTES(*entry))
+            candidates.push_back({entry, cached});
+    std::stable_sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) {
+        if (a.entry->cache.priority != b.entry->cache.priority)
+            return a.entry->cache.priority < b.entry->cache.priority;
+        return a.cached > b.cached;
+    });
+
+    Size released = 0;
+    for (auto&& candidate : candidates) {
+        if (released >= bytes) break;
+        auto& entry = *candidate.entry;
+        std::lock_guard<std::mutex> lock (entry.mutex);
+        if (!entry.registered) continue;
+        try { released += entry.cache.shrink(bytes - released); }
+        catch (...) {}
+    }
+#if defined(IFE_MEMORY_PRESSURE_LINUX) && defined(__GLIBC__)
+    if (released) malloc_trim(0);
+#endif
+    return released;
+}
+Size reclaimable_memory ()
+{
+    Size bytes = 0;
+    for (auto&& entry : REGISTERED_CACHES())
+        bytes += CACHED_BYTES(*entry);
+    return bytes;
+}
+
+#ifndef __EMSCRIPTEN__
+struct __MemoryPressureMonitor {
+    explicit __MemoryPressureMonitor (const MemoryPressureCreateInfo& __info) :
+    info                        (__info) {}
+    ~__MemoryPressureMonitor    ();
+    const MemoryPressureCreateInfo info;
+    std::string                 cgroup;
+    int                         wake        = -1;
+    int                         psi         = -1;
+    int                         events      = -1;
+    uint64_t                    breaches    = 0;    // memory.events high + max + oom counts
+    std::thread                 thread;
+    mutable std::mutex          mutex;
+    MemoryPressureStats         stats;
+};
+__MemoryPressureMonitor::~__MemoryPressureMonitor ()
+{
+#ifdef IFE_MEMORY_PRESSURE_LINUX
+    for (int descriptor : {wake, psi, events})
+        if (descriptor >= 0) close(descriptor);
+#endif
+}
+
+#ifdef IFE_MEMORY_PRESSURE_LINUX
+namespace {
+using Monitor = __MemoryPressureMonitor;
+using Clock = std::chrono::steady_clock;
+
+std::string READ_DESCRIPTOR (int descriptor)
+{
+    std::string text;
+    char buffer [4096];
+    for (off_t offset = 0;;) {
+        const auto bytes = pread(descriptor, buffer, sizeof(buffer), offset);
+        if (bytes <= 0) break;
+        text.append(buffer, size_t(bytes));
+        offset += bytes;
+    }
+    return text;
+}
+bool READ_FILE (const std::string& path, std::string& text)
+{
+    const int descriptor = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (descriptor < 0) return false;
+    text = READ_DESCRIPTOR(descriptor);
+    close(descriptor);
+    return true;
+}
+// Value of a "key value" line of a flat keyed file (memory.events, memory.stat, /proc/meminfo).
+bool KEYED_VALUE (const std::string& text, const char* key, Size& value)
+{
+    const size_t length = strlen(key);
+    for (size_t line = 0; line < text.size();) {
+        const auto end = text.find('\n', line);
+        if (text.compare(line, length, key) == 0 && line + length < text.size() &&
+            (text[line + length] == ' ' || text[line + length] == ':')) {
+            value = strtoull(text.c_str() + line + length + 1, nullptr, 10);
+            return true;
+        }
+        if (end == std::string::npos) break;
+        line = end + 1;
+    }
+    return false;
+}
+// A single value file ("max" is unlimited).
+bool LIMIT_VALUE (const std::string& path, Size& value)
+{
+    std::string text;
+    if (!READ_FILE(path, text) || text.empty() || text.compare(0, 3, "max") == 0) return false;
+    value = strtoull(text.c_str(), nullptr, 10);
+    return value > 0;
+}
+std::string PROCESS_CGROUP ()
+{
+    std::string text;
+    if (!READ_FILE("/proc/self/cgroup", text)) return std::string();
+    // The cgroup v2 hierarchy is listed as "0::/path"
+    for (size_t line = 0; line < text.size();) {
+        auto end = text.find('\n', line);
+        if (end == std::string::npos) end = text.size();
+        if (text.compare(line, 3, "0::") == 0) {
+            const auto path = "/sys/fs/cgroup" + text.substr(line + 3, end - line - 3);
+            return access((path + "/memory.current").c_str(), R_OK) == 0 ? path : std::string();
+        }
+        line = end + 1;
+    }
+    return std::string();
+}
+int OPEN_PSI_TRIGGER (const std::string& path, const MemoryPressureCreateInfo& info)
+{
+    const int descriptor = open(path.c_str(), O_RDWR | O_NONBLOCK | O_CLOEXEC);
+    if (descriptor < 0) return -1;
+    const auto trigger = "some " + std::to_string(info.stall_us) + " " + std::to_string(info.window_us);
+    if (write(descriptor, trigger.c_str(), trigger.size() + 1) < 0) {
+        close(descriptor);
+        return -1;
+    }
+    return descriptor;
+}
+uint64_t BREACHES (int events)
+{
+    const auto text = READ_DESCRIPTOR(events);
+    Size high = 0, max = 0, oom = 0;
+    KEYED_VALUE(text, "high", high);
+    KEYED_VALUE(text, "max", max);
+    KEYED_VALUE(text, "oom", oom);
+    return high + max + oom;
+}
+// Working set and the limit it is held to, falling back to the system memory
+// without a cgroup limit if system is set. @return False if neither is known.
+bool USAGE (const Monitor& monitor, bool system, Size& usage, Size& limit)
+{
+    std::string text;
+    if (monitor.cgroup.size() && READ_FILE(monitor.cgroup + "/memory.current", text)) {
+        usage = strtoull(text.c_str(), nullptr, 10);
+        Size inactive = 0;
+        if (READ_FILE(monitor.cgroup + "/memory.stat", text) && KEYED_VALUE(text, "inactive_file", inactive))
+            usage -= std::min(usage, inactive);
+        if (LIMIT_VALUE(monitor.cgroup + "/memory.high", limit) ||
+            LIMIT_VALUE(monitor.cgroup + "/memory.max", limit)) return true;
+    }
+    // No cgroup limit: the system memory
+    Size total = 0, available = 0;
+    if (!system || !READ_FILE("/proc/meminfo", text) ||
+        !KEYED_VALUE(text, "MemTotal", total) ||
+        !KEYED_VALUE(text, "MemAvailable", available)) return false;
+    usage = (total - std::min(total, available)) << 10;
+    limit = total << 10;
+    return true;
+}
+// @return True if the caches were asked to shrink.
+bool RECLAIM (Monitor& monitor, bool signaled)
+{
+    const auto& info = monitor.info;
+    const bool polling = monitor.stats.source == PRESSURE_SOURCE_POLLING;
+    if (!polling && !signaled) return false;
+    Size usage = 0, limit = 0, target = 0;
+    const bool measured = USAGE(monitor, polling, usage, limit);
+    const Size goal = measured ? Size(double(limit) * info.target_usage) : 0;
+    if (measured && usage > goal) target = usage - goal;
+    else if (signaled) target = Size(double(reclaimable_memory()) * info.reclaim_share);
+    if (target == 0) return false;
+
+    const Size released = reclaim_memory(target);
+    std::lock_guard<std::mutex> lock (monitor.mutex);
+    ++monitor.stats.events;
+    monitor.stats.reclaimed += released;
+    return true;
+}
+void MONITOR (Monitor& monitor) noexcept
+{
+    const auto cooldown = std::chrono::microseconds(monitor.info.window_us);
+    // Only the polling fallback checks the usage without a signal
+    const int timeout   = monitor.stats.source == PRESSURE_SOURCE_POLLING ? int(monitor.info.poll_ms) : -1;
+    auto resume = Clock::now();
+    while (true) {
+        pollfd descriptors [3];
+        nfds_t count = 0;
+        descriptors[count++] = {monitor.wake, POLLIN, 0};
+        if (monitor.psi >= 0)       descriptors[count++] = {monitor.psi,    POLLPRI, 0};
+        if (monitor.events >= 0)    descriptors[count++] = {monitor.events, POLLPRI, 0};
+        const int ready = poll(descriptors, count, timeout);
+        if (ready < 0 && errno != EINTR) return;
+        if (descriptors[0].revents) return;
+
+        bool signaled = false;
+        for (nfds_t DI = 1; DI < count; ++DI) {
+            const auto revents = descriptors[DI].revents;
+            if (descriptors[DI].fd == monitor.psi && revents) {
+                if (revents & POLLPRI) signaled = true;
+                if (revents & (POLLERR | POLLNVAL) && !(revents & POLLPRI)) {
+                    // The monitored cgroup was removed
+                    close(monitor.psi);
+                    monitor.psi = -1;
+                }
+            } else if (descriptors[DI].fd == monitor.events && revents) {
+                const auto breaches = BREACHES(monitor.events);
+                signaled |= breaches > monitor.breaches;
+                monitor.breaches = breaches;
+            }
+        }
+        // The caches shrink at most once per window
+        if (Clock::now() < resume) continue;
+        try {
+            if (RECLAIM(monitor, signaled)) resume = Clock::now() + cooldown;
+        } catch (...) {}
+    }
+}
+} // namespace
+#endif
+
+MemoryPressureMonitor::MemoryPressureMonitor (const MemoryPressureCreateInfo& info) :
+__monitor (std::make_shared<__MemoryPressureMonitor>(info))
+{
+#ifdef IFE_MEMORY_PRESSURE_LINUX
+    auto& monitor       = *__monitor;
+    monitor.cgroup      = info.cgroup.size() ? info.cgroup : PROCESS_CGROUP();
+    if (monitor.cgroup.size())
+        monitor.psi     = OPEN_PSI_TRIGGER(monitor.cgroup + "/memory.pressure", info);
+    if (monitor.psi < 0)
+        monitor.psi     = OPEN_PSI_TRIGGER("/proc/pressure/memory", info);
+    if (monitor.cgroup.size())
+        monitor.events  = open((monitor.cgroup + "/memory.events").c_str(), O_RDONLY | O_CLOEXEC);
+    if (monitor.events >= 0)
+        monitor.breaches = BREACHES(monitor.events);
+
+    Size usage = 0, limit = 0;
+    auto& source        = monitor.stats.source;
+    source              = monitor.psi >= 0      ? PRESSURE_SOURCE_PSI :
+                          monitor.events >= 0   ? PRESSURE_SOURCE_EVENTS :
+                          USAGE(monitor, true, usage, limit) ? PRESSURE_SOURCE_POLLING :
+                          PRESSURE_SOURCE_NONE;
+    if (source == PRESSURE_SOURCE_NONE) return;
+
+    monitor.wake        = eventfd(0, EFD_CLOEXEC);
+    if (monitor.wake < 0) throw std::runtime_error
+        ("Failed to create memory pressure monitor -- " + std::string(strerror(errno)));
+    monitor.thread      = std::thread(MONITOR, std::ref(monitor));
+#endif
+}
+MemoryPressureMonitor::~MemoryPressureMonitor ()
+{
+#ifdef IFE_MEMORY_PRESSURE_LINUX
+    if (__monitor->thread.joinable()) {
+        const uint64_t stop = 1;
+        [[maybe_unused]] auto written = write(__monitor->wake, &stop, sizeof(stop));
+        __monitor->thread.join();
+    }
+#endif
+}
+MemoryPressureStats MemoryPressureMonitor::stats () const
+{
+    std::lock_guard<std::mutex> lock (__monitor->mutex);
+    return __monitor->stats;
+}
+#endif
+} // namespace IrisCodec
@@ -0,0 +1,229 @@
+/**
+ * @file IFE_Multipart.cpp
+ * @brief Implementation of the multi-range request planning and the
+ *        multipart/byteranges parser. See IFE_Multipart.hpp.
+ */
+#include "IFE_Multipart.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace IFE {
+
+namespace {
+
+inline char lower(char c) noexcept {
+    return c >= 'A' && c <= 'Z' ? char(c - 'A' + 'a') : c;
+}
+bool iequals(std::string_view a, std::string_view b) noexcept {
+    if (a.size() != b.size()) return false;
+    for (std::size_t index = 0; index < a.size(); ++index)
+        if (lower(a[index]) != lower(b[index])) return false;
+    return true;
+}
+std::string_view trim(std::string_view value) noexcept {
+    while (value.size() && (value.front() == ' ' || value.front() == '\t')) value.remove_prefix(1);
+    while (value.size() && (value.back()  == ' ' || value.back()  == '\t')) value.remove_suffix(1);
+    return value;
+}
+bool parse_u64(std::string_view digits, std::uint64_t& value) noexcept {
+    if (digits.empty() || digits.size() > 19) return false;
+    value = 0;
+    for (char c : digits) {
+        if (c < '0' || c > '9') return false;
+        value = value * 10 + std::uint64_t(c - '0');
+    }
+    return true;
+}
+inline std::string range_spec(const ByteRange& range) {
+    return std::to_string(range.offset) + "-" + std::to_string(range.offset + range.size - 1);
+}
+
+} // namespace
+
+// MARK: - REQUEST PLANNING
+std::vector<ByteRange> coalesce_ranges(std::vector<ByteRange> ranges, std::uint64_t max_gap) {
+    ranges.erase(std::remove_if(ranges.begin(), ranges.end(),
+                                [](const ByteRange& range) { return range.size == 0; }), ranges.end());
+    std::sort(ranges.begin(), ranges.end(),
+              [](const ByteRange& a, const ByteRange& b) { return a.offset < b.offset; });
+    std::vector<ByteRange> merged;
+    for (auto&& range : ranges) {
+        if (merged.size() && range.offset - std::min(range.offset, max_gap) <=
+            merged.back().offset + merged.back().size) {
+            auto& last = merged.back();
+            last.size  = std::max(last.offset + last.size, range.offset + range.size) - last.offset;
+        } else merged.push_back(range);
+    }
+    return merged;
+}
+std::vector<std::vector<ByteRange>> batch_ranges(const std::vector<ByteRange>& ranges, std::size_t max_bytes,
+                                                 std::uint64_t max_request) {
+    std::vector<std::vector<ByteRange>> batches;
+    std::size_t header = 0;
+    std::uint64_t body = 0;
+    for (auto&& range : ranges) {
+        const std::size_t bytes = range_spec(range).size() + 1;   // With the separator
+        // A range larger than max_request is requested alone rather than split
+        if (batches.empty() || header + bytes > max_bytes || body + range.size > max_request) {
+            batches.emplace_back();
+            header = std::strlen("bytes=");
+            body   = 0;
+        }
+        batches.back().push_back(range);
+        header += bytes;
+        body   += range.size;
+    }
+    return batches;
+}
+std::string range_header(const std::vector<ByteRange>& ranges) {
+    std::string header = "bytes=";
+    for (std::size_t index = 0; index < ranges.size(); ++index) {
+        if (index) header += ',';
+        header += range_spec(ranges[index]);
+    }
+    return header;
+}
+
+// MARK: - RESPONSE HEADERS
+std::string multipart_boundary(std::string_view content_type) {
+    constexpr std::string_view TYPE = "multipart/byteranges";
+    content_type = trim(content_type);
+    if (content_type.size() < TYPE.size() || !iequals(content_type.substr(0, TYPE.size()), TYPE))
+        return std::string();
+    for (auto parameters = content_type.substr(TYPE.size()); parameters.size();) {
+        const auto separator = parameters.find(';');
+        auto parameter = trim(parameters.substr(0, separator));
+        parameters = separator == std::string_view::npos ? std::string_view() : parameters.substr(separator + 1);
+        const auto equals = parameter.find('=');
+        if (equals == std::string_view::npos || !iequals(trim(parameter.substr(0, equals)), "boundary")) continue;
+        auto value = trim(parameter.substr(equals + 1));
+        if (value.size() >= 2 && value.front() == '"' && value.back() == '"')
+            value = value.substr(1, value.size() - 2);
+        if (value.empty() || value.size() > 70) return std::string();   // RFC 2046 Section 5.1.1
+        return std::string(value);
+    }
+    return std::string();
+}
+bool parse_content_range(std::string_view content_range, ByteRange& range) noexcept {
+    content_range = trim(content_range);
+    if (content_range.size() < 6 || !iequals(content_range.substr(0, 5), "bytes")) return false;
+    content_range = trim(content_range.substr(5));
+    const auto dash  = content_range.find('-');
+    const auto slash = content_range.find('/');
+    if (dash == std::string_view::npos || slash == std::string_view::npos || slash < dash) return false;
+    std::uint64_t first = 0, last = 0, length = 0;
+    if (!parse_u64(trim(content_range.substr(0, dash)), first)) return false;
+    if (!parse_u64(trim(content_range.substr(dash + 1, slash - dash - 1)), last)) return false;
+    const auto complete = trim(content_range.substr(slash + 1));
+    if (last < first) return false;
+    if (complete != "*" && (!parse_u64(complete, length) || last >= length)) return false;
+    range.offset = first;
+    range.size   = last - first + 1;
+    return true;
+}
+
+// MARK: - SCATTER
+RangeScatter::RangeScatter(std::vector<ScatterTarget> targets) :
+__targets(std::move(targets)) {
+    std::stable_sort(__targets.begin(), __targets.end(),
+                     [](const ScatterTarget& a, const ScatterTarget& b) { return a.offset < b.offset; });
+    __written.assign(__targets.size(), 0);
+    for (auto&& target : __targets) __max_size = std::max(__max_size, target.size);
+}
+void RangeScatter::write(std::uint64_t offset, const std::uint8_t* data, std::size_t bytes) noexcept {
+    const std::uint64_t end = offset + bytes;
+    // Targets beginning more than the largest target size before the offset cannot overlap it
+    const std::uint64_t from = offset > __max_size ? offset - __max_size : 0;
+    auto target = std::lower_bound(__targets.begin(), __targets.end(), from,
+                                   [](const ScatterTarget& t, std::uint64_t value) { return t.offset < value; });
+    for (; target != __targets.end() && target->offset < end; ++target) {
+        const auto first = std::max(offset, target->offset);
+        const auto last  = std::min(end, target->offset + target->size);
+        if (first >= last) continue;
+        auto* dst = target->destination + (first - target->offset);
+        const auto* src = data + (first - offset);
+        if (dst != src) std::memcpy(dst, src, std::size_t(last - first));
+        __written[std::size_t(target - __targets.begin())] += last - first;
+    }
+}
+bool RangeScatter::complete() const noexcept {
+    for (std::size_t index = 0; index < __targets.size(); ++index)
+        if (__written[index] < __targets[index].size) return false;
+    return true;
+}
+
+// MARK: - MULTIPART PARSER
+MultipartParser::MultipartParser(std::string boundary, RangeScatter& scatter) :
+__delimiter("--" + boundary), __scatter(scatter) {}
+
+bool MultipartParser::feed(const std::uint8_t* data, std::size_t bytes) noexcept {
+    std::size_t index = 0;
+    while (index < bytes) {
+        switch (__state) {
+            case FAILED: return false;
+            case DONE:   return true;   // Epilogue
+            case BODY: {
+                const auto take = std::size_t(std::min<std::uint64_t>(__part.size - __consumed, bytes - index));
+                __scatter.write(__part.offset + __consumed, data + index, take);
+                __consumed += take;
+                index      += take;
+                if (__consumed == __part.size) __state = BOUNDARY;
+            } break;
+            default: {
+                const auto* begin = data + index;
+                const auto* end   = static_cast<const std::uint8_t*>(std::memchr(begin, '\n', bytes - index));
+                const auto* stop  = end ? end : data + bytes;
+                if (__line.size() + std::size_t(stop - begin) > MULTIPART_LINE_BYTES) {
+                    __state = FAILED;
+                    return false;
+                }
+                __line.append(reinterpret_cast<const char*>(begin), std::size_t(stop - begin));
+                index = std::size_t(stop - data);
+                if (!end) break;
+                ++index;
+                std::string_view text = __line;
+                if (text.size() && text.back() == '\r') text.remove_suffix(1);
+                const bool valid = line(text);
+                __line.clear();
+                if (!valid) {
+                    __state = FAILED;
+                    return false;
+                }
+            }
+        }
+    }
+    return __state != FAILED;
+}
+bool MultipartParser::line(std::string_view text) noexcept {
+    if (__state == BOUNDARY) {
+        // Transport padding may follow a delimiter (RFC 2046 Section 5.1.1)
+        text = trim(text);
+        if (text.size() < __delimiter.size() || text.substr(0, __delimiter.size()) != __delimiter)
+            return true;    // Preamble, or the line break closing a part body
+        // A line extending the delimiter is not a delimiter of this body
+        const auto rest = text.substr(__delimiter.size());
+        if (rest == "--") __state = DONE;
+        else if (rest.empty()) {
+            __state     = HEADERS;
+            __has_range = false;
+        }
+        return true;
+    }
+    // HEADERS
+    if (text.empty()) {
+        if (!__has_range) return false;
+        __consumed  = 0;
+        __state     = __part.size ? BODY : BOUNDARY;
+        return true;
+    }
+    const auto colon = text.find(':');
+    if (colon == std::string_view::npos) return false;
+    if (iequals(trim(text.substr(0, colon)), "content-range")) {
+        if (!parse_content_range(text.substr(colon + 1), __part)) return false;
+        __has_range = true;
+    }
+    return true;
+}
+
+} // namespace IFE
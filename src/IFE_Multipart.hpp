@@ -0,0 +1,112 @@
+/**
+ * @file IFE_Multipart.hpp
+ * @brief HTTP multi-range requests and a streaming multipart/byteranges
+ *        parser backing the Iris File Extension remote tile batches.
+ *
+ * This header is private to the extension library; applications use the
+ * remote fetch entry methods declared in IrisCodecExtension.hpp.
+ *
+ * Design:
+ *   - Requested byte ranges are sorted and merged where they overlap or are
+ *     separated by no more than a caller chosen gap (see IFE_RangePlanner,
+ *     which sizes the gap to the link). Batches are split such that each
+ *     Range header stays within common server limits and each response
+ *     within a caller chosen size.
+ *   - A `RangeScatter` maps file offsets onto the destination buffers of
+ *     the requested ranges. Response bytes are copied once, from the
+ *     transport buffer into their destinations, whatever the part layout
+ *     the server chose (servers may reorder or merge ranges).
+ *   - `MultipartParser` is a push parser: the body may be fed in chunks of
+ *     any size. Boundary and header lines are buffered (bounded); part
+ *     bodies are sized by their Content-Range and scattered as they arrive
+ *     without searching them for the boundary.
+ *
+ * @copyright Copyright (c) 2026 Ryan Landvater. MIT licensed.
+ */
+#ifndef IFE_Multipart_hpp
+#define IFE_Multipart_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace IFE {
+
+/// Maximum Range header value length of a single request.
+constexpr std::size_t RANGE_HEADER_BYTES = 4096;
+
+/// Maximum length of a multipart boundary or header line.
+constexpr std::size_t MULTIPART_LINE_BYTES = 1024;
+
+struct ByteRange {
+    std::uint64_t   offset  = 0;
+    std::uint64_t   size    = 0;
+};
+struct ScatterTarget {
+    std::uint64_t   offset      = 0;
+    std::uint64_t   size        = 0;
+    std::uint8_t*   destination = nullptr;
+};
+
+/// Sort the ranges and merge those that overlap or lie at most max_gap bytes apart. Empty ranges are dropped.
+std::vector<ByteRange> coalesce_ranges(std::vector<ByteRange> ranges, std::uint64_t max_gap = 0);
+
+/// Split ranges into batches whose Range header is at most max_bytes long
+/// and whose ranges total at most max_request bytes.
+std::vector<std::vector<ByteRange>> batch_ranges(const std::vector<ByteRange>& ranges,
+                                                 std::size_t max_bytes = RANGE_HEADER_BYTES,
+                                                 std::uint64_t max_request = UINT64_MAX);
+
+/// Range header value of the ranges ("bytes=0-99,200-299").
+std::string range_header(const std::vector<ByteRange>& ranges);
+
+/// Boundary of a multipart/byteranges Content-Type; empty if the type is not multipart/byteranges.
+std::string multipart_boundary(std::string_view content_type);
+
+/// Parse a Content-Range value ("bytes 0-99/1000"). @return False if malformed.
+bool parse_content_range(std::string_view content_range, ByteRange& range) noexcept;
+
+/**
+ * @brief Copies response bytes into the destinations of the requested ranges.
+ */
+class RangeScatter {
+public:
+    explicit RangeScatter(std::vector<ScatterTarget> targets);
+    /// Copy the bytes found at the given file offset into every target they overlap.
+    void write(std::uint64_t offset, const std::uint8_t* data, std::size_t bytes) noexcept;
+    /// True once every target has been written in full.
+    bool complete() const noexcept;
+    const std::vector<ScatterTarget>& targets() const noexcept { return __targets; }
+private:
+    std::vector<ScatterTarget>  __targets;  // Sorted by offset
+    std::vector<std::uint64_t>  __written;
+    std::uint64_t               __max_size = 0;
+};
+
+/**
+ * @brief Streaming multipart/byteranges parser (RFC 9110 Section 14.6).
+ */
+class MultipartParser {
+public:
+    MultipartParser(std::string boundary, RangeScatter& scatter);
+    /// Feed the next chunk of the response body. @return False once the body is malformed.
+    bool feed(const std::uint8_t* data, std::size_t bytes) noexcept;
+    /// True if the closing boundary was read and no part was truncated.
+    bool finished() const noexcept { return __state == DONE; }
+private:
+    enum State : std::uint8_t { BOUNDARY, HEADERS, BODY, DONE, FAILED };
+    bool line(std::string_view) noexcept;
+    std::string     __delimiter;
+    RangeScatter&   __scatter;
+    std::string     __line;
+    State           __state      = BOUNDARY;
+    bool            __has_range  = false;
+    ByteRange       __part;
+    std::uint64_t   __consumed   = 0;
+};
+
+} // namespace IFE
+
+#endif /* IFE_Multipart_hpp */
@@ -0,0 +1,212 @@
+/**
+ * @file IFE_Patches.cpp
+ * @brief Multi-scale patch location and batched patch reads. See the
+ *        locate_patches and read_patches declarations in IrisCodecExtension.hpp.
+ *
+ * Design:
+ *   - A center is scaled into each patch layer by the layer's downsample
+ *     relative to the highest resolution layer and the patch origin is the
+ *     rounded center less half the patch, such that all scales of a center
+ *     share the same center point. The covering tile grid is computed with
+ *     floor division so that patches overhanging the layer edge keep their
+ *     alignment; cells beyond the layer are padding.
+ *   - Tiles are keyed by layer and index and listed once per batch, however
+ *     many centers and scales cover them.
+ *   - Native reads coalesce the tile byte ranges of the batch across layers
+ *     (joining gaps up to a readahead window) and advise the merged ranges
+ *     before the tiles are copied in parallel, such that a mapped file is read
+ *     in a few large requests rather than a page fault per tile.
+ *   - Reads of a deferred file check every tile of the batch with its
+ *     validation before any byte is read.
+ *
+ * @copyright Copyright (c) 2026 Ryan Landvater. MIT licensed.
+ */
+#include <cmath>
+#include <unordered_map>
+#include <vector>
+#include "IrisTypes.hpp"
+#include "IrisCodecTypes.hpp"
+#include "IrisCodecExtension.hpp"
+#include "IFE_Multipart.hpp"
+#if !defined(__EMSCRIPTEN__) && (defined(__unix__) || defined(__APPLE__))
+#include <sys/mman.h>
+#include <unistd.h>
+#define IFE_PATCH_ADVISE 1
+#endif
+
+namespace IrisCodec {
+namespace {
+using namespace Abstraction;
+
+// Gaps between tile byte ranges read ahead rather than requested apart (a readahead window)
+constexpr Size PATCH_MERGE_GAP = 128ULL << 10;
+
+// Pixels of the highest resolution layer per pixel of the layer
+double LAYER_DOWNSAMPLE (const TileTable& table, uint32_t layer)
+{
+    const auto& layers  = table.extent.layers;
+    const auto& top     = layers.back();
+    const auto& extent  = layers[layer];
+    double factor       = 0.;
+    if (extent.downsample > 0.f && top.downsample > 0.f)
+        factor          = double(extent.downsample) / top.downsample;
+    else if (extent.scale > 0.f && top.scale > 0.f)
+        factor          = double(top.scale) / extent.scale;
+    if (!std::isfinite(factor) || factor <= 0.) throw std::runtime_error
+        ("Failed to locate patches -- the layer extents encode neither a downsample nor a scale factor");
+    return factor;
+}
+inline int64_t FLOOR_DIV (int64_t value, int64_t divisor)
+{
+    return value >= 0 ? value / divisor : -((-value + divisor - 1) / divisor);
+}
+inline bool SPARSE_TILE (const TileEntry& entry)
+{
+    return entry.offset == NULL_OFFSET || entry.size == 0;
+}
+} // namespace
+
+PatchBatch locate_patches (const TileTable& table, const std::vector<PatchCenter>& centers,
+                           const std::vector<PatchScale>& scales)
+{
+    struct Grid {
+        double          downsample;
+        TileExtent      tile;
+        LayerExtent     extent;
+    };
+    const auto& layers  = table.extent.layers;
+    std::vector<Grid> grids;
+    grids.reserve(scales.size());
+    for (auto&& scale : scales) {
+        if (scale.layer >= layers.size() || scale.layer >= table.layers.size()) throw std::runtime_error
+            ("Failed to locate patches -- layer " + std::to_string(scale.layer) + " is not within the tile table");
+        const auto tile = scale.layer < table.tileExtents.size() ? table.tileExtents[scale.layer] : TileExtent();
+        if (tile.width == 0 || tile.height == 0) throw std::runtime_error
+            ("Failed to locate patches -- layer " + std::to_string(scale.layer) + " has an empty tile extent");
+        grids.push_back({LAYER_DOWNSAMPLE(table, scale.layer), tile, layers[scale.layer]});
+    }
+
+    PatchBatch batch;
+    batch.patches.resize(centers.size());
+    std::unordered_map<uint64_t, uint32_t> slots;
+    for (size_t CI = 0; CI < centers.size(); ++CI) {
+        auto& patches = batch.patches[CI];
+        patches.reserve(scales.size());
+        for (size_t SI = 0; SI < scales.size(); ++SI) {
+            const auto& scale   = scales[SI];
+            const auto& grid    = grids[SI];
+            const int64_t TW    = grid.tile.width;
+            const int64_t TH    = grid.tile.height;
+            ScalePatch patch;
+            patch.layer         = scale.layer;
+            patch.width         = scale.width;
+            patch.height        = scale.height;
+            patch.x             = std::llround(centers[CI].x / grid.downsample - scale.width  / 2.0);
+            patch.y             = std::llround(centers[CI].y / grid.downsample - scale.height / 2.0);
+            if (scale.width && scale.height) {
+                patch.column    = FLOOR_DIV(patch.x, TW);
+                patch.row       = FLOOR_DIV(patch.y, TH);
+                patch.columns   = uint32_t(FLOOR_DIV(patch.x + scale.width  - 1, TW) - patch.column + 1);
+                patch.rows      = uint32_t(FLOOR_DIV(patch.y + scale.height - 1, TH) - patch.row    + 1);
+                patch.xOffset   = uint32_t(patch.x - patch.column * TW);
+                patch.yOffset   = uint32_t(patch.y - patch.row    * TH);
+            }
+            const auto& entries = table.layers[scale.layer];
+            patch.tiles.reserve(Size(patch.columns) * patch.rows);
+            for (int64_t ty = patch.row; ty < patch.row + patch.rows; ++ty)
+                for (int64_t tx = patch.column; tx < patch.column + patch.columns; ++tx) {
+                    if (tx < 0 || ty < 0 || tx >= grid.extent.xTiles || ty >= grid.extent.yTiles) {
+                        patch.tiles.push_back(ScalePatch::NULL_TILE);
+                        continue;
+                    }
+                    const auto index = uint32_t(ty * grid.extent.xTiles + tx);
+                    if (index >= entries.size()) throw std::runtime_error
+                        ("Failed to locate patches -- tile " + std::to_string(index) +
+                         " exceeds the tiles of layer " + std::to_string(scale.layer));
+                    const auto& entry = entries[index];
+                    const auto key  = static_cast<uint64_t>(scale.layer) << 32 | index;
+                    const auto slot = slots.emplace(key, uint32_t(batch.tiles.size()));
+                    if (slot.second) {
+                        batch.tiles.push_back({scale.layer, index, entry, nullptr});
+                        if (!SPARSE_TILE(entry)) batch.tileBytes += entry.size;
+                    }
+                    if (!SPARSE_TILE(entry)) batch.patchBytes += entry.size;
+                    patch.tiles.push_back(slot.first->second);
+                }
+            patches.push_back(std::move(patch));
+        }
+    }
+    return batch;
+}
+#ifndef __EMSCRIPTEN__
+namespace {
+PatchBatch READ_PATCHES (const BYTE* const __base, Size __size, const TileTable& table,
+                         const std::vector<PatchCenter>& centers, const std::vector<PatchScale>& scales,
+                         const SharedExecutor& executor, const Validation* validation)
+{
+    auto batch = locate_patches(table, centers, scales);
+    std::vector<IFE::ByteRange> ranges;
+    ranges.reserve(batch.tiles.size());
+    for (auto&& tile : batch.tiles) {
+        const auto& entry = tile.entry;
+        if (validation) {
+            const auto result = validation->check_tile(entry);
+            if (result & IRIS_FAILURE) throw std::runtime_error
+                ("Failed to read patches -- tile " + std::to_string(tile.index) + " of layer " +
+                 std::to_string(tile.layer) + ": " + result.message);
+        }
+        if (SPARSE_TILE(entry)) continue;
+        if (entry.offset > __size || entry.size > __size - entry.offset) throw std::runtime_error
+            ("Failed to read patches -- tile " + std::to_string(tile.index) + " of layer " +
+             std::to_string(tile.layer) + " exceeds the file size");
+        ranges.push_back({entry.offset, entry.size});
+    }
+#ifdef IFE_PATCH_ADVISE
+    // Advice only: memory that is not a file mapping ignores it
+    const auto page = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+    for (auto&& range : IFE::coalesce_ranges(std::move(ranges), PATCH_MERGE_GAP)) {
+        const auto first = reinterpret_cast<uintptr_t>(__base + range.offset) & ~(page - 1);
+        const auto last  = reinterpret_cast<uintptr_t>(__base + range.offset + range.size);
+        posix_madvise(reinterpret_cast<void*>(first), size_t(last - first), POSIX_MADV_WILLNEED);
+    }
+#endif
+    static const TileRead::Bytes SPARSE = std::make_shared<const std::vector<BYTE>>();
+    const auto& tasks = executor ? executor : default_executor();
+    tasks->bulk(batch.tiles.size(), [&batch, __base](size_t TI) {
+        auto& tile = batch.tiles[TI];
+        const auto& entry = tile.entry;
+        tile.bytes = SPARSE_TILE(entry) ? SPARSE : std::make_shared<const std::vector<BYTE>>
+        (__base + entry.offset, __base + entry.offset + entry.size);
+    }, PRIORITY_HIGH);
+    return batch;
+}
+} // namespace
+
+PatchBatch read_patches (const BYTE* const __base, Size __size, const TileTable& table,
+                         const std::vector<PatchCenter>& centers, const std::vector<PatchScale>& scales,
+                         const SharedExecutor& executor)
+{
+    return READ_PATCHES(__base, __size, table, centers, scales, executor, nullptr);
+}
+PatchBatch read_patches (const BYTE* const __base, Size __size, const DeferredFile& file,
+                         const std::vector<PatchCenter>& centers, const std::vector<PatchScale>& scales,
+                         const SharedExecutor& executor)
+{
+    return READ_PATCHES(__base, __size, file.tileTable, centers, scales, executor, file.validation.get());
+}
+#else
+PatchBatch fetch_patches (const std::string url, const TileTable& table,
+                          const std::vector<PatchCenter>& centers, const std::vector<PatchScale>& scales,
+                          const SharedIOScheduler& scheduler, const IOTag& tag)
+{
+    auto batch = locate_patches(table, centers, scales);
+    std::vector<TileEntry> entries;
+    entries.reserve(batch.tiles.size());
+    for (auto&& tile : batch.tiles) entries.push_back(tile.entry);
+    auto bytes = fetch_tiles(url, entries, scheduler, tag);
+    for (size_t TI = 0; TI < batch.tiles.size(); ++TI)
+        batch.tiles[TI].bytes = std::make_shared<const std::vector<BYTE>>(std::move(bytes[TI]));
+    return batch;
+}
+#endif
+} // namespace IrisCodec
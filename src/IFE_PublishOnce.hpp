@@ -0,0 +1,68 @@
+/**
+ * @file IFE_PublishOnce.hpp
+ * @brief Write-once slot publishing a value to concurrent readers, backing
+ *        the remote data block responses of the Iris File Extension.
+ *
+ * This header is private to the extension library; applications use the
+ * remote fetch entry methods declared in IrisCodecExtension.hpp.
+ *
+ * Design:
+ *   - The value is produced under the slot mutex by the first caller to find
+ *     the slot empty and published with a release store of the ready flag.
+ *     Readers that observe the flag (acquire) read the value without taking
+ *     the mutex; it is never written again.
+ *   - A producer that throws publishes nothing, such that a later caller
+ *     produces the value anew (ex: a failed fetch is retried).
+ *   - Depends only upon the standard library so that the publication can be
+ *     stress tested natively (tests/ife_publish_once_tests under TSan) while
+ *     the remote blocks themselves are WebAssembly only.
+ *
+ * @copyright Copyright (c) 2026 Ryan Landvater. MIT licensed.
+ */
+#ifndef IFE_PublishOnce_hpp
+#define IFE_PublishOnce_hpp
+
+#include <atomic>
+#include <mutex>
+#include <utility>
+
+namespace IFE {
+
+template <class T>
+class PublishOnce {
+public:
+    /// Whether a value is published.
+    bool        ready       () const noexcept {return __ready.load(std::memory_order_acquire);}
+    /// The published value, or a value initialized T if none is published yet.
+    T           published   () const {return ready() ? __value : T();}
+    /// Publish value unless a value is already published.
+    void        publish     (T value)
+    {
+        std::lock_guard<std::mutex> lock (__mutex);
+        if (__ready.load(std::memory_order_relaxed)) return;
+        __value = std::move(value);
+        __ready.store(true, std::memory_order_release);
+    }
+    /// Return the published value, publishing produce() first if none is published.
+    template <class PRODUCE>
+    const T&    get         (PRODUCE&& produce)
+    {
+        if (ready() == false) {
+            std::lock_guard<std::mutex> lock (__mutex);
+            if (__ready.load(std::memory_order_relaxed) == false) {
+                __value = produce();
+                __ready.store(true, std::memory_order_release);
+            }
+        }
+        return __value;
+    }
+
+private:
+    std::mutex          __mutex;
+    std::atomic<bool>   __ready     {false};
+    T                   __value     {};
+};
+
+} // namespace IFE
+
+#endif /* IFE_PublishOnce_hpp */
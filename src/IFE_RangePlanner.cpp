@@ -0,0 +1,101 @@
+/**
+ * @file IFE_RangePlanner.cpp
+ * @brief Implementation of the link estimates and the adaptive range
+ *        policy. See IFE_RangePlanner.hpp.
+ */
+#include "IFE_RangePlanner.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+
+namespace IFE {
+
+namespace {
+
+constexpr double MIN_RTT        = 1e-4;
+constexpr double MAX_RTT        = 10.0;
+constexpr double MIN_THROUGHPUT = 1e4;
+constexpr double MAX_THROUGHPUT = 1e11;
+
+// Requests of (nearly) one size cannot separate the RTT from the transfer time
+constexpr double MIN_SIZE_SPREAD = 0.1;
+
+} // namespace
+
+// MARK: - POLICY
+RangePolicy range_policy(const LinkEstimate& link, bool multirange) noexcept {
+    const double bdp     = link.bandwidth_delay();
+    const double request = std::max(link.request, 1.0);
+    RangePolicy policy;
+    policy.multirange    = multirange;
+    policy.concurrency   = std::uint32_t(std::clamp(std::ceil(bdp / request), 1.0, double(MAX_CONCURRENCY)));
+    // A gap costs gap / throughput to read and saves an RTT shared by the requests in flight
+    policy.merge_gap     = multirange ? MULTIPART_PART_BYTES : std::uint64_t(bdp / policy.concurrency);
+    policy.max_request   = std::uint64_t(std::clamp(16.0 * bdp, double(MIN_REQUEST_BYTES), double(MAX_REQUEST_BYTES)));
+    return policy;
+}
+
+// MARK: - LINK ESTIMATOR
+void LinkEstimator::record(std::uint64_t bytes, double seconds) noexcept {
+    if (!(seconds > 0) || !std::isfinite(seconds)) return;
+    const double x = double(bytes);
+    std::lock_guard<std::mutex> lock(__mutex);
+    __weight = __weight * SAMPLE_DECAY + 1;
+    __x      = __x  * SAMPLE_DECAY + x;
+    __y      = __y  * SAMPLE_DECAY + seconds;
+    __xx     = __xx * SAMPLE_DECAY + x * x;
+    __xy     = __xy * SAMPLE_DECAY + x * seconds;
+    ++__samples;
+}
+void LinkEstimator::record_multirange(bool supported) noexcept {
+    __multirange.store(supported ? SUPPORTED : UNSUPPORTED, std::memory_order_relaxed);
+}
+LinkEstimate LinkEstimator::estimate() const noexcept {
+    LinkEstimate link;
+    std::lock_guard<std::mutex> lock(__mutex);
+    link.samples = __samples;
+    if (__samples == 0) return link;
+
+    const double bytes    = __x / __weight;
+    const double seconds  = __y / __weight;
+    const double variance = __xx / __weight - bytes * bytes;
+    const double cov      = __xy / __weight - bytes * seconds;
+    link.request = bytes;
+    if (variance > MIN_SIZE_SPREAD * bytes * bytes && cov > 0) {
+        // Weighted least squares: seconds = rtt + bytes / throughput
+        const double slope = cov / variance;
+        link.throughput    = 1.0 / slope;
+        link.rtt           = seconds - slope * bytes;
+    } else {
+        // Attribute the time beyond the default transfer time to the RTT
+        link.rtt           = seconds - bytes / DEFAULT_THROUGHPUT;
+        if (link.rtt <= 0) link.rtt = seconds / 2;
+        link.throughput    = bytes > 0 ? bytes / (seconds - link.rtt) : DEFAULT_THROUGHPUT;
+    }
+    link.rtt        = std::clamp(std::isfinite(link.rtt) ? link.rtt : DEFAULT_RTT, MIN_RTT, MAX_RTT);
+    link.throughput = std::clamp(std::isfinite(link.throughput) ? link.throughput : DEFAULT_THROUGHPUT,
+                                 MIN_THROUGHPUT, MAX_THROUGHPUT);
+    return link;
+}
+RangePolicy LinkEstimator::policy() const noexcept {
+    return range_policy(estimate(), __multirange.load(std::memory_order_relaxed) != UNSUPPORTED);
+}
+
+// MARK: - ENDPOINTS
+std::string url_origin(std::string_view url) {
+    const auto scheme = url.find("://");
+    if (scheme == std::string_view::npos) return std::string(url);
+    const auto end = url.find_first_of("/?#", scheme + 3);
+    return std::string(url.substr(0, end));
+}
+std::shared_ptr<LinkEstimator> link_estimator(std::string_view url) {
+    static std::mutex mutex;
+    static std::unordered_map<std::string, std::shared_ptr<LinkEstimator>> endpoints;
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& estimator = endpoints[url_origin(url)];
+    if (!estimator) estimator = std::make_shared<LinkEstimator>();
+    return estimator;
+}
+
+} // namespace IFE
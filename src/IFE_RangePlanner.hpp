@@ -0,0 +1,105 @@
+/**
+ * @file IFE_RangePlanner.hpp
+ * @brief Link estimates and adaptive byte range planning of the Iris File
+ *        Extension remote reads.
+ *
+ * This header is private to the extension library; applications use the
+ * remote fetch entry methods declared in IrisCodecExtension.hpp.
+ *
+ * Design:
+ *   - Every remote request is timed and recorded against its endpoint (the
+ *     URL origin). Request time is modeled as RTT + bytes / throughput and
+ *     fit by exponentially weighted least squares, such that small metadata
+ *     requests inform the RTT and large tile batches the throughput. Older
+ *     samples decay, so the estimates follow a link that changes.
+ *   - The range policy follows from the bandwidth-delay product (BDP):
+ *     gaps are merged into a range when reading them costs less than the
+ *     share of a round trip saved, requests are sized to 16 BDPs (such that
+ *     the round trip costs about 6% of each) and as many requests are kept in
+ *     flight as are needed to fill the link.
+ *     Within a multi-range request a gap only saves a part header, so the
+ *     merge gap then falls to the part header size.
+ *   - Whether an endpoint answers multi-range requests is remembered; once
+ *     it declines, batches go directly to parallel single range requests.
+ *
+ * @copyright Copyright (c) 2026 Ryan Landvater. MIT licensed.
+ */
+#ifndef IFE_RangePlanner_hpp
+#define IFE_RangePlanner_hpp
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+namespace IFE {
+
+/// Estimates used before an endpoint has been measured.
+constexpr double        DEFAULT_RTT         = 0.05;         // Seconds
+constexpr double        DEFAULT_THROUGHPUT  = 10e6;         // Bytes per second
+
+/// Weight retained by the previous samples as each sample is recorded.
+constexpr double        SAMPLE_DECAY        = 0.9;
+
+/// Approximate bytes of a multipart/byteranges part header and delimiter.
+constexpr std::uint64_t MULTIPART_PART_BYTES = 96;
+
+/// Requests in flight per endpoint (the browser HTTP/1.1 per-origin limit).
+constexpr std::uint32_t MAX_CONCURRENCY     = 6;
+
+/// Bounds of the bytes of a single request.
+constexpr std::uint64_t MIN_REQUEST_BYTES   = 256ULL << 10;
+constexpr std::uint64_t MAX_REQUEST_BYTES   = 64ULL << 20;
+
+struct LinkEstimate {
+    double          rtt         = DEFAULT_RTT;
+    double          throughput  = DEFAULT_THROUGHPUT;
+    double          request     = 0;    // Mean bytes per request (0 if unmeasured)
+    std::uint32_t   samples     = 0;
+    double bandwidth_delay() const noexcept { return rtt * throughput; }
+};
+struct RangePolicy {
+    std::uint64_t   merge_gap   = 0;    // Largest unrequested gap read to join two ranges
+    std::uint64_t   max_request = MAX_REQUEST_BYTES;
+    std::uint32_t   concurrency = 1;    // Single range requests in flight
+    bool            multirange  = true; // Request several ranges at once
+};
+
+/// Range policy of a link given its estimate.
+RangePolicy range_policy(const LinkEstimate& link, bool multirange) noexcept;
+
+/**
+ * @brief Online RTT and throughput estimates of one endpoint. Thread safe.
+ */
+class LinkEstimator {
+public:
+    /// Record a completed request of the given bytes (response body) and duration.
+    void record(std::uint64_t bytes, double seconds) noexcept;
+    /// Record whether the endpoint answered a multi-range request with the ranges.
+    void record_multirange(bool supported) noexcept;
+    LinkEstimate estimate() const noexcept;
+    RangePolicy policy() const noexcept;
+private:
+    enum Support : std::uint8_t { SUPPORT_UNKNOWN, SUPPORTED, UNSUPPORTED };
+    mutable std::mutex          __mutex;
+    double                      __weight    = 0;
+    double                      __x         = 0;    // Weighted sums of bytes (x) and seconds (y)
+    double                      __y         = 0;
+    double                      __xx        = 0;
+    double                      __xy        = 0;
+    std::uint32_t               __samples   = 0;
+    std::atomic<Support>        __multirange {SUPPORT_UNKNOWN};
+};
+
+/// Origin of a URL ("https://host:port"); the URL itself if it has no scheme.
+std::string url_origin(std::string_view url);
+
+/// Process-wide estimator of the URL's origin.
+std::shared_ptr<LinkEstimator> link_estimator(std::string_view url);
+
+} // namespace IFE
+
+#endif /* IFE_RangePlanner_hpp */
@@ -0,0 +1,273 @@
+/**
+ * @file IFE_TextCodec.cpp
+ * @brief Implementation of the dictionary LZ77 text codec. See IFE_TextCodec.hpp.
+ */
+#include "IFE_TextCodec.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace IFE {
+
+namespace {
+
+constexpr int           HASH_BITS     = 15;
+constexpr int           CHAIN_DEPTH   = 32;
+constexpr std::size_t   RUN_MASK      = 15;
+constexpr std::size_t   KMER_BYTES    = 8;
+constexpr std::size_t   SEGMENT_BYTES = 64;
+
+inline std::uint32_t load32(const std::uint8_t* p) noexcept {
+    std::uint32_t v; std::memcpy(&v, p, sizeof(v)); return v;
+}
+inline std::uint64_t load64(const std::uint8_t* p) noexcept {
+    std::uint64_t v; std::memcpy(&v, p, sizeof(v)); return v;
+}
+inline std::uint32_t hash4(const std::uint8_t* p) noexcept {
+    return (load32(p) * 2654435761u) >> (32 - HASH_BITS);
+}
+
+// MARK: - SEQUENCE ENCODING
+inline std::uint8_t* write_length(std::uint8_t* op, std::size_t length) noexcept {
+    for (; length >= 255; length -= 255) *op++ = 255;
+    *op++ = std::uint8_t(length);
+    return op;
+}
+std::uint8_t* write_sequence(std::uint8_t* op, const std::uint8_t* literals, std::size_t literal_bytes,
+                             std::size_t distance, std::size_t match_bytes) noexcept {
+    std::uint8_t* token = op++;
+    *token = std::uint8_t(std::min(literal_bytes, RUN_MASK) << 4);
+    if (literal_bytes >= RUN_MASK) op = write_length(op, literal_bytes - RUN_MASK);
+    std::memcpy(op, literals, literal_bytes);
+    op += literal_bytes;
+    if (!match_bytes) return op;
+
+    *op++ = std::uint8_t(distance);
+    *op++ = std::uint8_t(distance >> 8);
+    const std::size_t extra = match_bytes - LZ_MIN_MATCH;
+    *token |= std::uint8_t(std::min(extra, RUN_MASK));
+    if (extra >= RUN_MASK) op = write_length(op, extra - RUN_MASK);
+    return op;
+}
+inline bool read_length(const std::uint8_t*& ip, const std::uint8_t* iend,
+                        std::size_t& length, std::size_t limit) noexcept {
+    std::uint8_t byte;
+    do {
+        if (ip >= iend) return false;
+        byte    = *ip++;
+        length += byte;
+        if (length > limit) return false;
+    } while (byte == 255);
+    return true;
+}
+
+// MARK: - MATCH FINDER
+struct MatchFinder {
+    const std::uint8_t*         buffer;
+    std::size_t                 end;
+    std::vector<std::int32_t>   head;
+    std::vector<std::int32_t>   prev;
+
+    MatchFinder(const std::uint8_t* __buffer, std::size_t __end) :
+    buffer(__buffer), end(__end), head(std::size_t(1) << HASH_BITS, -1), prev(__end, -1) {}
+
+    void insert(std::size_t position) noexcept {
+        if (position + LZ_MIN_MATCH > end) return;
+        const auto hash = hash4(buffer + position);
+        prev[position]  = head[hash];
+        head[hash]      = std::int32_t(position);
+    }
+    std::size_t longest(std::size_t position, std::size_t& distance) const noexcept {
+        std::size_t best = 0;
+        if (position + LZ_MIN_MATCH > end) return best;
+        const std::size_t limit = end - position;
+        std::int32_t candidate  = head[hash4(buffer + position)];
+        for (int depth = 0; candidate >= 0 && depth < CHAIN_DEPTH; ++depth) {
+            const std::size_t back = position - std::size_t(candidate);
+            if (back > LZ_WINDOW) break;
+            const std::uint8_t* a = buffer + candidate;
+            const std::uint8_t* b = buffer + position;
+            if (a[best] == b[best] || best == 0) {
+                std::size_t length = 0;
+                while (length < limit && a[length] == b[length]) ++length;
+                if (length > best) {
+                    best        = length;
+                    distance    = back;
+                    if (length == limit) break;
+                }
+            }
+            candidate = prev[std::size_t(candidate)];
+        }
+        return best >= LZ_MIN_MATCH ? best : 0;
+    }
+};
+
+} // namespace
+
+// MARK: - COMPRESSION
+std::size_t lz_compress(const std::uint8_t* dict, std::size_t dict_bytes,
+                        const std::uint8_t* src, std::size_t bytes,
+                        std::uint8_t* dst) noexcept {
+    if (!bytes) return 0;
+
+    // The dictionary tail is a virtual prefix of the input
+    const std::size_t prefix = std::min(dict_bytes, LZ_WINDOW);
+    std::vector<std::uint8_t> buffer(prefix + bytes);
+    if (prefix) std::memcpy(buffer.data(), dict + dict_bytes - prefix, prefix);
+    std::memcpy(buffer.data() + prefix, src, bytes);
+
+    MatchFinder finder(buffer.data(), buffer.size());
+    for (std::size_t position = 0; position < prefix; ++position)
+        finder.insert(position);
+
+    std::uint8_t* op     = dst;
+    std::size_t   anchor = prefix;
+    std::size_t   ip     = prefix;
+    const std::size_t end = buffer.size();
+    while (ip < end) {
+        std::size_t distance = 0;
+        std::size_t length   = finder.longest(ip, distance);
+        if (!length) {
+            finder.insert(ip++);
+            continue;
+        }
+        // One step lazy evaluation: prefer a longer match starting at the next byte
+        finder.insert(ip);
+        std::size_t next_distance = 0;
+        const std::size_t next = finder.longest(ip + 1, next_distance);
+        if (next > length + 1) {
+            finder.insert(++ip);
+            length   = next;
+            distance = next_distance;
+        }
+        op = write_sequence(op, buffer.data() + anchor, ip - anchor, distance, length);
+        for (std::size_t position = ip + 1; position < ip + length; ++position)
+            finder.insert(position);
+        ip    += length;
+        anchor = ip;
+    }
+    if (anchor < end)
+        op = write_sequence(op, buffer.data() + anchor, end - anchor, 0, 0);
+    return std::size_t(op - dst);
+}
+
+// MARK: - DECOMPRESSION
+bool lz_decompress(const std::uint8_t* dict, std::size_t dict_bytes,
+                   const std::uint8_t* src, std::size_t src_bytes,
+                   std::uint8_t* dst, std::size_t dst_bytes) noexcept {
+    const std::size_t     prefix   = std::min(dict_bytes, LZ_WINDOW);
+    const std::uint8_t*   dict_end = dict + dict_bytes;
+    const std::uint8_t*   ip       = src;
+    const std::uint8_t*   iend     = src + src_bytes;
+    std::size_t           op       = 0;
+
+    // A block ending in a match carries no final token; anything past the last byte is trailing
+    while (ip < iend && op < dst_bytes) {
+        const std::uint8_t token = *ip++;
+
+        std::size_t literals = token >> 4;
+        if (literals == RUN_MASK && !read_length(ip, iend, literals, dst_bytes)) return false;
+        if (literals > std::size_t(iend - ip) || literals > dst_bytes - op) return false;
+        std::memcpy(dst + op, ip, literals);
+        ip += literals;
+        op += literals;
+        if (op == dst_bytes) break;
+
+        if (iend - ip < 2) return false;
+        const std::size_t distance = std::size_t(ip[0]) | (std::size_t(ip[1]) << 8);
+        ip += 2;
+        std::size_t length = token & RUN_MASK;
+        if (length == RUN_MASK && !read_length(ip, iend, length, dst_bytes)) return false;
+        length += LZ_MIN_MATCH;
+        if (distance == 0 || distance > op + prefix || length > dst_bytes - op) return false;
+
+        if (distance > op) {
+            // The match begins within the dictionary and may continue into the output
+            const std::size_t from_dict = std::min(length, distance - op);
+            std::memcpy(dst + op, dict_end - (distance - op), from_dict);
+            op     += from_dict;
+            length -= from_dict;
+        }
+        if (!length) continue;
+        const std::uint8_t* match = dst + op - distance;
+        if (distance >= length) std::memcpy(dst + op, match, length);
+        else for (std::size_t index = 0; index < length; ++index) dst[op + index] = match[index];
+        op += length;
+    }
+    return ip == iend && op == dst_bytes;
+}
+
+// MARK: - DICTIONARY TRAINING
+std::string train_dictionary(const std::vector<std::string_view>& samples, std::size_t max_bytes) {
+    max_bytes = std::min(max_bytes, LZ_WINDOW);
+    std::string data;
+    for (auto&& sample : samples) data.append(sample);
+    if (data.size() <= max_bytes || data.size() < SEGMENT_BYTES) {
+        return data.substr(data.size() - std::min(data.size(), max_bytes));
+    }
+
+    // Sample (document) frequency of every k-mer that does not cross a sample boundary
+    const auto* bytes = reinterpret_cast<const std::uint8_t*>(data.data());
+    std::unordered_map<std::uint64_t, std::uint32_t> frequency;
+    std::vector<bool> kmer_valid (data.size(), false);
+    {
+        std::size_t start = 0;
+        std::unordered_set<std::uint64_t> seen;
+        for (auto&& sample : samples) {
+            seen.clear();
+            for (std::size_t index = 0; index + KMER_BYTES <= sample.size(); ++index) {
+                kmer_valid[start + index] = true;
+                const auto kmer = load64(bytes + start + index);
+                if (seen.insert(kmer).second) ++frequency[kmer];
+            }
+            start += sample.size();
+        }
+    }
+    // K-mers of a single sample cannot be reused across slides
+    for (auto&& entry : frequency) if (entry.second < 2) entry.second = 0;
+
+    // One segment per epoch; selected k-mers no longer contribute to later segments
+    const std::size_t segments = std::max<std::size_t>(1, max_bytes / SEGMENT_BYTES);
+    const std::size_t epoch    = std::max(SEGMENT_BYTES, data.size() / segments);
+    const std::size_t window   = SEGMENT_BYTES - KMER_BYTES + 1;
+    std::vector<std::string_view> selected;
+    std::size_t total = 0;
+    std::vector<std::uint64_t> score;
+    for (std::size_t begin = 0; begin + SEGMENT_BYTES <= data.size() && total < max_bytes; begin += epoch) {
+        const std::size_t end = std::min(data.size(), begin + epoch);
+        if (end - begin < SEGMENT_BYTES) break;
+
+        score.assign(end - begin, 0);
+        for (std::size_t index = begin; index + KMER_BYTES <= end; ++index)
+            if (kmer_valid[index]) score[index - begin] = frequency[load64(bytes + index)];
+
+        std::uint64_t sum = 0, best_sum = 0;
+        std::size_t best = 0;
+        for (std::size_t index = 0; index < window; ++index) sum += score[index];
+        best_sum = sum;
+        for (std::size_t index = 1; index + SEGMENT_BYTES <= end - begin; ++index) {
+            sum += score[index + window - 1];
+            sum -= score[index - 1];
+            if (sum > best_sum) { best_sum = sum; best = index; }
+        }
+        if (best_sum == 0) continue;
+
+        const std::size_t segment = begin + best;
+        for (std::size_t index = segment; index < segment + window; ++index)
+            if (kmer_valid[index]) frequency[load64(bytes + index)] = 0;
+        selected.emplace_back(data.data() + segment, SEGMENT_BYTES);
+        total += SEGMENT_BYTES;
+    }
+
+    // The most valuable (first selected) segments are placed last
+    std::string dictionary;
+    dictionary.reserve(total);
+    for (auto segment = selected.rbegin(); segment != selected.rend(); ++segment)
+        dictionary.append(*segment);
+    if (dictionary.size() > max_bytes) dictionary.erase(0, dictionary.size() - max_bytes);
+    return dictionary;
+}
+
+} // namespace IFE
@@ -0,0 +1,68 @@
+/**
+ * @file IFE_TextCodec.hpp
+ * @brief Dictionary LZ77 codec backing the Iris File Extension compressed
+ *        (v2) attribute and annotation text blocks.
+ *
+ * This header is private to the extension library; applications use the
+ * text compression entry methods declared in IrisCodecExtension.hpp.
+ *
+ * Design:
+ *   - Byte oriented LZ77 sequences (LZ4 block style): a token carrying the
+ *     literal and match lengths, the literals, a 16-bit match distance and
+ *     length extension bytes. Decoding is a bounds checked copy loop.
+ *   - The dictionary is a virtual prefix of the input; matches may reach
+ *     back into it (up to `LZ_WINDOW` bytes). Small blocks such as single
+ *     annotations or DICOM attribute sets compress well once the recurring
+ *     keys and values are primed from a trained dictionary.
+ *   - The compressor uses hash chains of limited depth; text blocks are
+ *     written once and read on every open, so ratio is favored over speed.
+ *   - Dictionaries are trained with a segment cover: the samples are split
+ *     into epochs and the segment of each epoch whose 8-byte k-mers occur
+ *     in the most samples is selected. The most valuable segments are placed
+ *     at the end of the dictionary (closest to the compressed data).
+ *
+ * @copyright Copyright (c) 2026 Ryan Landvater. MIT licensed.
+ */
+#ifndef IFE_TextCodec_hpp
+#define IFE_TextCodec_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace IFE {
+
+/// Maximum match distance; dictionary content beyond it is unreachable.
+constexpr std::size_t LZ_WINDOW    = 65535;
+
+/// Minimum match length encoded by a sequence.
+constexpr std::size_t LZ_MIN_MATCH = 4;
+
+/// Upper bound of the compressed size of `bytes` input bytes.
+constexpr std::size_t lz_compress_bound(std::size_t bytes) noexcept {
+    return bytes + bytes / 255 + 16;
+}
+
+/// Compress `bytes` of `src` into `dst` (at least lz_compress_bound(bytes)),
+/// priming the window with the last LZ_WINDOW bytes of the dictionary.
+/// @return Number of bytes written.
+std::size_t lz_compress(const std::uint8_t* dict, std::size_t dict_bytes,
+                        const std::uint8_t* src, std::size_t bytes,
+                        std::uint8_t* dst) noexcept;
+
+/// Decompress exactly `dst_bytes` into `dst` using the same dictionary.
+/// @return False if the stream is malformed, truncated or does not
+///         decode to exactly `dst_bytes`.
+bool lz_decompress(const std::uint8_t* dict, std::size_t dict_bytes,
+                   const std::uint8_t* src, std::size_t src_bytes,
+                   std::uint8_t* dst, std::size_t dst_bytes) noexcept;
+
+/// Train a dictionary of at most `max_bytes` (capped at LZ_WINDOW) from samples.
+std::string train_dictionary(const std::vector<std::string_view>& samples,
+                             std::size_t max_bytes);
+
+} // namespace IFE
+
+#endif /* IFE_TextCodec_hpp */
@@ -0,0 +1,389 @@
+/**
+ * @file IFE_TileReader.cpp
+ * @brief Deadline-aware tile reads with coarser-layer fallback. See the
+ *        TileReader and ancestor_tile declarations in IrisCodecExtension.hpp.
+ *
+ * Design:
+ *   - Reads are keyed by layer and tile. A tile is read at most once at a
+ *     time; readers of a tile in flight wait upon that read rather than
+ *     issuing another. Readers that give up at their deadline leave their
+ *     refinement callback with the read in flight.
+ *   - Readers wait upon a single condition variable that is notified as each
+ *     read completes, until their tile is no longer in flight or their
+ *     deadline passes.
+ *   - The cache is a least recently used list bounded by bytes. A tile just
+ *     read is never evicted by its own insertion, such that a tile larger
+ *     than the budget is still served to the readers waiting upon it.
+ *   - Under memory pressure (see register_cache) the least recently used
+ *     tiles are evicted until the requested bytes are released.
+ *   - Fallback searches the cache from the next coarser layer down to
+ *     layer 0 and serves the finest ancestor tile found. The ancestor tile
+ *     is located in the ancestor layer's own tile extent and the served
+ *     region is clamped to it (layers may differ in tile extent).
+ *   - Given a deferred file, each read is checked against its validation
+ *     before the cache is consulted, such that a file quarantined after its
+ *     tiles were cached serves none of them.
+ *   - Given an I/O scheduler, a read in flight remembers the class it was
+ *     submitted at. A reader of a higher class that joins it before it starts
+ *     submits the read again at its own class; the first submission to run
+ *     claims the read and the others return at once.
+ *   - Read tasks hold the shared reader state, so the destructor does not
+ *     wait upon queued reads (it may run from a refinement callback or from
+ *     the executor's only worker). It releases the state: queued reads return
+ *     without touching the tile table and no further refinement is delivered.
+ *     Only reads copying tile bytes, which still use the tile table and the
+ *     mapped file, are waited upon.
+ *
+ * @copyright Copyright (c) 2026 Ryan Landvater. MIT licensed.
+ */
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
+#include <list>
+#include <unordered_map>
+#include <vector>
+#include "IrisTypes.hpp"
+#include "IrisCodecTypes.hpp"
+#include "IrisCodecExtension.hpp"
+
+namespace IrisCodec {
+namespace Abstraction {
+struct __TileReader {
+    using Source                = std::function<std::vector<BYTE>(const TileEntry&)>;
+    using Key                   = uint64_t;
+    using Callbacks             = std::vector<TileReader::Callback>;
+    struct Flight {
+        Callbacks                   callbacks;
+        IOClass                     ioClass     = IO_CLASS_INTERACTIVE;
+        bool                        started     = false;
+    };
+    struct Entry {
+        TileRead::Bytes             bytes;
+        std::list<Key>::iterator    order;
+    };
+    explicit __TileReader       (const TileTable& __table, Source&& __source,
+                                 const SharedExecutor& __executor, Size __budget) :
+    table                       (__table),
+    source                      (std::move(__source)),
+    executor                    (__executor ? __executor : default_executor()),
+    scheduler                   (std::dynamic_pointer_cast<IOScheduler>(executor)),
+    budget                      (__budget) {}
+    const TileTable&            table;
+    const Source                source;
+#ifndef __EMSCRIPTEN__
+    std::shared_ptr<const Validation> validation;   // Of a deferred file (may be NULL)
+#endif
+    const SharedExecutor        executor;
+    const SharedIOScheduler     scheduler;
+    const Size                  budget;
+    std::mutex                  mutex;
+    std::condition_variable     complete;
+    std::list<Key>              order;          // Most recently used first
+    std::unordered_map<Key, Entry>      cache;
+    std::unordered_map<Key, Flight>     inflight;
+    Size                        cached      = 0;
+    size_t                      reading     = 0;    // Reads within the source
+    bool                        released    = false;// The TileReader was destroyed
+};
+} // namespace Abstraction
+
+namespace {
+using namespace Abstraction;
+using Reader = std::shared_ptr<__TileReader>;
+
+inline __TileReader::Key TILE_KEY (uint32_t layer, uint32_t tile)
+{
+    return static_cast<uint64_t>(layer) << 32 | tile;
+}
+inline TileExtent TILE_EXTENT (const TileTable& table, uint32_t layer)
+{
+    return layer < table.tileExtents.size() ? table.tileExtents[layer] : TileExtent();
+}
+inline TileRegion WHOLE_TILE (const TileTable& table, uint32_t layer)
+{
+    const auto extent = TILE_EXTENT(table, layer);
+    return TileRegion {0.f, 0.f, float(extent.width), float(extent.height)};
+}
+inline const TileEntry& TILE_ENTRY (const TileTable& table, uint32_t layer, uint32_t tile)
+{
+    if (layer >= table.layers.size() || tile >= table.layers[layer].size()) throw std::runtime_error
+        ("Failed to read tile -- tile " + std::to_string(tile) + " of layer " +
+         std::to_string(layer) + " is not within the tile table");
+    return table.layers[layer][tile];
+}
+// The reader mutex shall be held.
+TileRead::Bytes CACHED_TILE (__TileReader& reader, __TileReader::Key key)
+{
+    auto entry = reader.cache.find(key);
+    if (entry == reader.cache.end()) return nullptr;
+    reader.order.splice(reader.order.begin(), reader.order, entry->second.order);
+    return entry->second.bytes;
+}
+// The reader mutex shall be held.
+void CACHE_TILE (__TileReader& reader, __TileReader::Key key, const TileRead::Bytes& bytes)
+{
+    reader.order.push_front(key);
+    reader.cache[key]   = {bytes, reader.order.begin()};
+    reader.cached      += bytes->size();
+    while (reader.cached > reader.budget && reader.order.size() > 1) {
+        auto evicted    = reader.cache.find(reader.order.back());
+        reader.cached  -= evicted->second.bytes->size();
+        reader.cache.erase(evicted);
+        reader.order.pop_back();
+    }
+}
+// The reader mutex shall be held. @return The bytes released.
+Size EVICT_TILES (__TileReader& reader, Size bytes)
+{
+    Size released       = 0;
+    while (released < bytes && reader.order.size()) {
+        auto evicted    = reader.cache.find(reader.order.back());
+        released       += evicted->second.bytes->size();
+        reader.cache.erase(evicted);
+        reader.order.pop_back();
+    }
+    reader.cached      -= released;
+    return released;
+}
+CacheRegistration REGISTER_CACHE (__TileReader* reader)
+{
+    ReclaimableCache cache;
+    cache.priority      = RECLAIM_FIRST;
+    cache.cached_bytes  = [reader]() {
+        std::lock_guard<std::mutex> lock (reader->mutex);
+        return reader->cached;
+    };
+    cache.shrink        = [reader](Size bytes) {
+        std::lock_guard<std::mutex> lock (reader->mutex);
+        return EVICT_TILES(*reader, bytes);
+    };
+    return register_cache(std::move(cache));
+}
+void READ_TILE (const Reader& reader, uint32_t layer, uint32_t tile) noexcept
+{
+    const auto key      = TILE_KEY(layer, tile);
+    {
+        std::lock_guard<std::mutex> lock (reader->mutex);
+        auto flight     = reader->inflight.find(key);
+        // The reader was destroyed or another submission of this read claimed it
+        if (reader->released || flight == reader->inflight.end() || flight->second.started)
+            return;
+        flight->second.started = true;
+        ++reader->reading;
+    }
+    TileRead read;
+    read.layer          = layer;
+    read.tile           = tile;
+    read.region         = WHOLE_TILE(reader->table, layer);
+    read.target         = read.region;
+    read.exact          = true;
+    try {
+        read.bytes      = std::make_shared<const std::vector<BYTE>>
+        (reader->source(reader->table.layers[layer][tile]));
+    } catch (...) {
+        read.bytes      = nullptr;
+    }
+
+    __TileReader::Callbacks callbacks;
+    {
+        std::lock_guard<std::mutex> lock (reader->mutex);
+        --reader->reading;
+        auto flight     = reader->inflight.find(key);
+        if (read.bytes) {
+            if (!reader->released) callbacks = std::move(flight->second.callbacks);
+            try { CACHE_TILE(*reader, key, read.bytes); } catch (...) {}
+        }
+        reader->inflight.erase(flight);
+    }
+    reader->complete.notify_all();
+
+    // Progressive refinement of the readers that fell back
+    for (auto&& callback : callbacks)
+        try { callback(read); } catch (...) {}
+}
+void SUBMIT_READ (const Reader& reader, uint32_t layer, uint32_t tile, const IOTag& tag, Size bytes)
+{
+    auto task = [reader, layer, tile]() {
+        READ_TILE(reader, layer, tile);
+    };
+    if (reader->scheduler) reader->scheduler->submit(tag, bytes, std::move(task));
+    else reader->executor->submit(std::move(task), PRIORITY_HIGH);
+}
+TileRead READ (const Reader& reader, uint32_t layer, uint32_t tile, const IOTag& tag,
+               const TileReader::Deadline* deadline, TileReader::Callback&& refined)
+{
+    const auto& entry   = TILE_ENTRY(reader->table, layer, tile);
+#ifndef __EMSCRIPTEN__
+    if (reader->validation) {
+        const auto result = reader->validation->check_tile(entry);
+        if (result & IRIS_FAILURE) throw std::runtime_error
+            ("Failed to read tile " + std::to_string(tile) + " of layer " +
+             std::to_string(layer) + " -- " + result.message);
+    }
+#endif
+    TileRead read;
+    read.layer          = layer;
+    read.tile           = tile;
+    read.region         = WHOLE_TILE(reader->table, layer);
+    read.target         = read.region;
+    read.exact          = true;
+    if (entry.offset == NULL_OFFSET || entry.size == 0) {
+        static const TileRead::Bytes SPARSE = std::make_shared<const std::vector<BYTE>>();
+        read.bytes      = SPARSE;
+        return read;
+    }
+
+    const auto key      = TILE_KEY(layer, tile);
+    std::unique_lock<std::mutex> lock (reader->mutex);
+    if ((read.bytes = CACHED_TILE(*reader, key))) return read;
+    auto flight         = reader->inflight.find(key);
+    if (flight == reader->inflight.end()) {
+        reader->inflight[key].ioClass = tag.ioClass;
+        lock.unlock();
+        try {
+            SUBMIT_READ(reader, layer, tile, tag, entry.size);
+        } catch (...) {
+            lock.lock();
+            reader->inflight.erase(key);
+            throw;
+        }
+        lock.lock();
+    } else if (reader->scheduler && !flight->second.started && tag.ioClass < flight->second.ioClass) {
+        // Promote the queued read to the class of this reader
+        flight->second.ioClass = tag.ioClass;
+        lock.unlock();
+        try {
+            SUBMIT_READ(reader, layer, tile, tag, entry.size);
+        } catch (...) {
+            // The read remains queued at its former class
+        }
+        lock.lock();
+    }
+    const auto read_complete = [&reader, key]() {return reader->inflight.count(key) == 0;};
+    if (deadline) reader->complete.wait_until(lock, *deadline, read_complete);
+    else reader->complete.wait(lock, read_complete);
+    if ((read.bytes = CACHED_TILE(*reader, key))) return read;
+
+    // The exact read is still in flight (or failed). Serve the finest cached ancestor.
+    flight              = reader->inflight.find(key);
+    if (flight != reader->inflight.end() && refined)
+        flight->second.callbacks.push_back(std::move(refined));
+    for (uint32_t ancestor = layer; ancestor-- > 0;) {
+        auto fallback   = ancestor_tile(reader->table, layer, tile, ancestor);
+        if ((fallback.bytes = CACHED_TILE(*reader, TILE_KEY(ancestor, fallback.tile))))
+            return fallback;
+    }
+    read.exact          = false;
+    return read;
+}
+} // namespace
+
+namespace Abstraction {
+#ifndef __EMSCRIPTEN__
+TileReader::TileReader (const BYTE* const __base, Size __size, const TileTable& table,
+                        const SharedExecutor& executor, Size cache_bytes) :
+__reader (std::make_shared<__TileReader>(table, [__base, __size](const TileEntry& entry) {
+    if (entry.offset > __size || entry.size > __size - entry.offset) throw std::runtime_error
+        ("Failed to read tile -- the tile byte range exceeds the file size");
+    return std::vector<BYTE>(__base + entry.offset, __base + entry.offset + entry.size);
+}, executor, cache_bytes)),
+__registration (REGISTER_CACHE(__reader.get()))
+{
+
+}
+TileReader::TileReader (const BYTE* const __base, Size __size, const DeferredFile& file,
+                        const SharedExecutor& executor, Size cache_bytes) :
+TileReader (__base, __size, file.tileTable, executor, cache_bytes)
+{
+    __reader->validation = file.validation;
+}
+#else
+TileReader::TileReader (const std::string url, const TileTable& table,
+                        const SharedExecutor& executor, Size cache_bytes) :
+__reader (std::make_shared<__TileReader>(table, [url](const TileEntry& entry) {
+    return fetch_tile(url, entry);
+}, executor, cache_bytes)),
+__registration (REGISTER_CACHE(__reader.get()))
+{
+
+}
+#endif
+TileReader::~TileReader ()
+{
+    std::unique_lock<std::mutex> lock (__reader->mutex);
+    __reader->released = true;
+    __reader->complete.wait(lock, [this]() {return __reader->reading == 0;});
+}
+TileRead TileReader::read_tile (uint32_t layer, uint32_t tile, Deadline deadline, Callback refined,
+                                const IOTag& tag)
+{
+    return READ(__reader, layer, tile, tag, &deadline, std::move(refined));
+}
+TileRead TileReader::read_tile (uint32_t layer, uint32_t tile, const IOTag& tag)
+{
+    auto read = READ(__reader, layer, tile, tag, nullptr, nullptr);
+    if (!read.exact) throw std::runtime_error
+        ("Failed to read tile " + std::to_string(tile) + " of layer " + std::to_string(layer));
+    return read;
+}
+Size TileReader::cached_bytes () const
+{
+    std::lock_guard<std::mutex> lock (__reader->mutex);
+    return __reader->cached;
+}
+} // namespace Abstraction
+
+TileRead ancestor_tile (const TileTable& table, uint32_t layer, uint32_t tile, uint32_t ancestor_layer)
+{
+    const auto& layers  = table.extent.layers;
+    if (layer >= layers.size() || ancestor_layer > layer) throw std::runtime_error
+        ("Failed to locate ancestor tile -- layer " + std::to_string(ancestor_layer) +
+         " is not a coarser layer of layer " + std::to_string(layer));
+    const auto& extent  = layers[layer];
+    const auto& parent  = layers[ancestor_layer];
+    if (extent.xTiles == 0 || tile >= extent.xTiles * extent.yTiles) throw std::runtime_error
+        ("Failed to locate ancestor tile -- tile " + std::to_string(tile) +
+         " is not within layer " + std::to_string(layer));
+
+    // Pixels of the layer to pixels of the ancestor layer
+    float factor        = 0.f;
+    if (extent.downsample > 0.f && parent.downsample > 0.f)
+        factor          = extent.downsample / parent.downsample;
+    else if (extent.scale > 0.f && parent.scale > 0.f)
+        factor          = parent.scale / extent.scale;
+    if (!std::isfinite(factor) || factor <= 0.f) throw std::runtime_error
+        ("Failed to locate ancestor tile -- the layer extents encode neither a downsample nor a scale factor");
+
+    const auto size     = TILE_EXTENT(table, layer);
+    const auto ancestor = TILE_EXTENT(table, ancestor_layer);
+    const float width   = size.width  * factor;
+    const float height  = size.height * factor;
+    const float x       = float(tile % extent.xTiles) * width;
+    const float y       = float(tile / extent.xTiles) * height;
+    const auto column   = std::min(uint32_t((x + width  / 2.f) / ancestor.width),
+                                   std::max(parent.xTiles, 1U) - 1);
+    const auto row      = std::min(uint32_t((y + height / 2.f) / ancestor.height),
+                                   std::max(parent.yTiles, 1U) - 1);
+
+    // The tile's area within the ancestor tile, clamped to the ancestor tile
+    const float left    = x - float(column) * ancestor.width;
+    const float top     = y - float(row)    * ancestor.height;
+    const float x0      = std::clamp(left,          0.f, float(ancestor.width));
+    const float y0      = std::clamp(top,           0.f, float(ancestor.height));
+    const float x1      = std::clamp(left + width,  0.f, float(ancestor.width));
+    const float y1      = std::clamp(top  + height, 0.f, float(ancestor.height));
+
+    TileRead read;
+    read.layer          = ancestor_layer;
+    read.tile           = row * parent.xTiles + column;
+    read.region         = TileRegion {x0, y0, x1 - x0, y1 - y0};
+    read.target         = TileRegion {
+        (x0 - left) / factor,
+        (y0 - top)  / factor,
+        (x1 - x0)   / factor,
+        (y1 - y0)   / factor
+    };
+    read.exact          = ancestor_layer == layer;
+    return read;
+}
+} // namespace IrisCodec
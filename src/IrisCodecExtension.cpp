@@ -33,8 +33,20 @@
 // As a result, we will NOT use the singular
 // #include "IrisCodecPriv.hpp"
 // But instead include all required elements manually
+//
+// **DEPENDENCIES:** The version 2 features below additionally rely upon
+// private IFE modules, which an independent implementation shall carry
+// alongside this file. Each depends only upon the C++ standard library:
+//   - IFE_Cipher       (AES-GCM tile encryption; CIPHER blocks)
+//   - IFE_TextCodec    (dictionary text compression; TEXT_DICTIONARY blocks)
+//   - IFE_Multipart    (multi-range requests and multipart/byteranges parsing)
+//   - IFE_RangePlanner (link-adaptive remote range planning)
+//   - IFE_PublishOnce  (header only; remote data block publication)
+// The latter three are used by remote (__EMSCRIPTEN__) reads only.
 #include <bit> // NOTE: Bit requires compiling against C++20
 #include <memory>
+#include <mutex>
+#include <algorithm>
 #include <math.h>
 #include <float.h>
 #include <iostream>
@@ -43,7 +55,12 @@
 #include "IrisBuffer.hpp"
 #include "IrisCodecTypes.hpp"
 #include "IrisCodecExtension.hpp"
+#include "IFE_Cipher.hpp"
+#include "IFE_TextCodec.hpp"
+#include "IFE_Multipart.hpp"
+#include "IFE_RangePlanner.hpp"
 #ifdef __EMSCRIPTEN__
+#include "IFE_PublishOnce.hpp"
 #include <emscripten/emscripten.h>
 #include <emscripten/bind.h>
 #endif
@@ -268,9 +285,191 @@ inline std::string to_hex_string(uint32_t _i)
         hex_array[_i    &0x0F],
     };
 }
+// Z-order (Morton) curve encoding of 16-bit cell coordinates. This is used
+// to spatially order annotation entries for the annotation spatial index.
+inline uint32_t MORTON_SPREAD (uint32_t _v)
+{
+    _v = (_v | _v << 8) & 0x00FF00FF;
+    _v = (_v | _v << 4) & 0x0F0F0F0F;
+    _v = (_v | _v << 2) & 0x33333333;
+    _v = (_v | _v << 1) & 0x55555555;
+    return _v;
+}
+inline uint16_t MORTON_COMPACT (uint32_t _v)
+{
+    _v &= 0x55555555;
+    _v = (_v | _v >> 1) & 0x33333333;
+    _v = (_v | _v >> 2) & 0x0F0F0F0F;
+    _v = (_v | _v >> 4) & 0x00FF00FF;
+    _v = (_v | _v >> 8) & 0x0000FFFF;
+    return U16_CAST(_v);
+}
+inline uint32_t MORTON_ENCODE   (uint16_t _x, uint16_t _y) {return MORTON_SPREAD(_x) | MORTON_SPREAD(_y) << 1;}
+inline uint16_t MORTON_DECODE_X (uint32_t _cell) {return MORTON_COMPACT(_cell);}
+inline uint16_t MORTON_DECODE_Y (uint32_t _cell) {return MORTON_COMPACT(_cell >> 1);}
+// Cell coordinate of a location along one axis of the spatial index grid.
+// Locations outside of the grid (or not a number) are clamped to the edge cells.
+inline uint16_t SPATIAL_CELL    (float location, float cell_size, uint16_t cells)
+{
+    if (!(location > 0.f) || !(cell_size > 0.f) || cells == 0) return 0;
+    const float cell = floorf(location / cell_size);
+    return cell < static_cast<float>(cells - 1) ? static_cast<uint16_t>(cell) : cells - 1;
+}
+// Normalize a region along one axis such that a negative extent spans [location + extent, location).
+inline void NORMALIZE_REGION    (float& location, float& extent)
+{
+    if (extent < 0.f) {
+        location   += extent;
+        extent      = -extent;
+    }
+}
 namespace IrisCodec {
 constexpr uint32_t IFE_VERSION = IRIS_EXTENSION_MAJOR<<16|IRIS_EXTENSION_MINOR;
 
+// MARK: - MEMORY FOOTPRINT
+// Allocation sizes of the standard container nodes. Hash nodes hold the next
+// pointer, the value and (libc++ always; libstdc++ for non-integral keys) the
+// cached hash. Tree nodes hold the color and the parent / left / right pointers.
+// These model the library layouts (see tests/ife_footprint_tests for the check).
+template <class Value, bool cached> struct __HASH_NODE {
+    void*   next; alignas(Value) unsigned char value[sizeof(Value)]; size_t hash;
+};
+template <class Value> struct __HASH_NODE<Value, false> {
+    void*   next; alignas(Value) unsigned char value[sizeof(Value)];
+};
+template <class Value> struct __TREE_NODE {
+    int     color; void* parent; void* left; void* right;
+    alignas(Value) unsigned char value[sizeof(Value)];
+};
+template <class T, class = void> struct __IS_HASHED : std::false_type {};
+template <class T> struct __IS_HASHED<T, std::void_t<decltype(std::declval<T>().bucket_count())>> : std::true_type {};
+template <class T, class = void> struct __IS_ORDERED : std::false_type {};
+template <class T> struct __IS_ORDERED<T, std::void_t<decltype(std::declval<T>().key_comp())>> : std::true_type {};
+template <class T> struct __IS_VECTOR : std::false_type {};
+template <class T, class A> struct __IS_VECTOR<std::vector<T, A>> : std::true_type {};
+template <class T> struct __IS_STRING : std::false_type {};
+template <class C, class T, class A> struct __IS_STRING<std::basic_string<C, T, A>> : std::true_type {};
+
+static Size HEAP_BYTES (const Abstraction::AssociatedImage&) noexcept;
+static Size HEAP_BYTES (const Abstraction::AnnotationLOD::Layer&) noexcept;
+static Size HEAP_BYTES (const Abstraction::AnnotationLOD::Cluster&) noexcept;
+// Heap bytes held by a value (excluding the value object itself)
+template <class T>
+static Size HEAP_BYTES (const T& value) noexcept
+{
+    if constexpr (__IS_STRING<T>::value) {
+        // Small strings are stored within the string object
+        const auto data  = reinterpret_cast<const char*>(value.data());
+        const auto begin = reinterpret_cast<const char*>(&value);
+        if (data >= begin && data < begin + sizeof(T)) return 0;
+        return (value.capacity() + 1) * sizeof(typename T::value_type);
+    } else if constexpr (__IS_VECTOR<T>::value) {
+        Size bytes = value.capacity() * sizeof(typename T::value_type);
+        if constexpr (!std::is_trivially_copyable_v<typename T::value_type>)
+            for (auto&& element : value) bytes += HEAP_BYTES(element);
+        return bytes;
+    } else if constexpr (__IS_HASHED<T>::value) {
+        using Value = typename T::value_type;
+#if defined(_LIBCPP_VERSION)
+        constexpr bool cached = true;
+        Size bytes = value.bucket_count() * sizeof(void*);
+#else
+        constexpr bool cached = !std::is_integral_v<typename T::key_type>;
+        Size bytes = value.bucket_count() > 1 ? value.bucket_count() * sizeof(void*) : 0;
+#endif
+        bytes += value.size() * sizeof(__HASH_NODE<Value, cached>);
+        if constexpr (!std::is_trivially_copyable_v<Value>)
+            for (auto&& element : value) bytes += HEAP_BYTES(element);
+        return bytes;
+    } else if constexpr (__IS_ORDERED<T>::value) {
+        using Value = typename T::value_type;
+        Size bytes = value.size() * sizeof(__TREE_NODE<Value>);
+        if constexpr (!std::is_trivially_copyable_v<Value>)
+            for (auto&& element : value) bytes += HEAP_BYTES(element);
+        return bytes;
+    } else if constexpr (requires {value.first; value.second;}) {
+        return HEAP_BYTES(value.first) + HEAP_BYTES(value.second);
+    } else {
+        return 0;
+    }
+}
+static Size HEAP_BYTES (const Abstraction::AssociatedImage& image) noexcept
+{
+    const auto& pyramid = image.pyramid;
+    return  HEAP_BYTES(image.info.title) +
+            HEAP_BYTES(pyramid.layers) +
+            HEAP_BYTES(pyramid.extent.layers) +
+            HEAP_BYTES(pyramid.tileExtents);
+}
+static Size HEAP_BYTES (const Abstraction::AnnotationLOD::Cluster& cluster) noexcept
+{
+    return HEAP_BYTES(cluster.group);
+}
+static Size HEAP_BYTES (const Abstraction::AnnotationLOD::Layer& layer) noexcept
+{
+    return HEAP_BYTES(layer.cells) + HEAP_BYTES(layer.clusters);
+}
+static Size FOOTPRINT_TILE_TABLE (const Abstraction::TileTable& table) noexcept
+{
+    return  HEAP_BYTES(table.layers) +
+            HEAP_BYTES(table.extent.layers) +
+            HEAP_BYTES(table.tileExtents) +
+            HEAP_BYTES(table.planes);
+}
+static Size FOOTPRINT_ANNOTATIONS (const Abstraction::Annotations& annotations) noexcept
+{
+    using Map   = std::unordered_map<Abstraction::Annotation::Identifier, Abstraction::Annotation>;
+    Size bytes  = HEAP_BYTES(static_cast<const Map&>(annotations)) + HEAP_BYTES(annotations.groups);
+    // Embedded dictionaries are owned by the annotations (make_shared control block and value);
+    // registered dictionaries are shared with the registry and are not attributed.
+    if (annotations.dictionary && annotations.dictionary.use_count() == 1)
+        bytes  += 2 * sizeof(void*) + sizeof(Abstraction::TextDictionary) +
+                  HEAP_BYTES(annotations.dictionary->bytes);
+    return bytes;
+}
+static Size FOOTPRINT_METADATA (const Metadata& metadata) noexcept
+{
+    return HEAP_BYTES(metadata.associatedImages) + HEAP_BYTES(metadata.annotations);
+}
+Abstraction::MemoryFootprint memory_footprint (const Abstraction::File& file) noexcept
+{
+    Abstraction::MemoryFootprint footprint;
+    footprint.object        = sizeof(Abstraction::File);
+    footprint.tileTable     = FOOTPRINT_TILE_TABLE  (file.tileTable);
+    footprint.images        = HEAP_BYTES            (file.images);
+    footprint.attributes    = HEAP_BYTES            (file.metadata.attributes);
+    footprint.ICC_profile   = HEAP_BYTES            (file.metadata.ICC_profile);
+    footprint.annotations   = FOOTPRINT_ANNOTATIONS (file.annotations);
+    footprint.metadata      = FOOTPRINT_METADATA    (file.metadata);
+    return footprint;
+}
+Abstraction::MemoryFootprint memory_footprint (const Abstraction::LazyFile& file) noexcept
+{
+    auto footprint          = file.footprint;
+    footprint.object        = sizeof(Abstraction::LazyFile) +
+    file.attributes.state_size() + file.images.state_size() + file.ICC_profile.state_size() +
+    file.annotations.state_size() + file.annotationLOD.state_size();
+    footprint.tileTable     = FOOTPRINT_TILE_TABLE  (file.tileTable);
+    footprint.metadata      = FOOTPRINT_METADATA    (file.metadata);
+    if (file.attributes.loaded())
+        footprint.attributes    = HEAP_BYTES        (*file.attributes);
+    if (file.images.loaded())
+        footprint.images        = HEAP_BYTES        (*file.images);
+    if (file.ICC_profile.loaded())
+        footprint.ICC_profile   = HEAP_BYTES        (*file.ICC_profile);
+    if (file.annotations.loaded())
+        footprint.annotations   = FOOTPRINT_ANNOTATIONS (*file.annotations);
+    if (file.annotationLOD.loaded()) {
+        const auto& lod         = *file.annotationLOD;
+        footprint.annotationLOD = HEAP_BYTES(lod.entries) + HEAP_BYTES(lod.layers);
+    }
+    // The remote responses are released once every metadata sub-block is read
+    if (file.attributes.loaded() && file.images.loaded() &&
+        file.ICC_profile.loaded() && file.annotations.loaded())
+        footprint.remote        = 0;
+    return footprint;
+}
+
 #ifndef __EMSCRIPTEN__
 bool is_Iris_Codec_file (BYTE* const __base, size_t __size)
 {
@@ -281,6 +480,10 @@ bool is_Iris_Codec_file (BYTE* const __base, size_t __size)
     return true;
 }
 Result validate_file_structure(BYTE *const __base, size_t __size) noexcept
+{
+    return validate_file_structure(__base, __size, inline_executor());
+}
+Result validate_file_structure(BYTE *const __base, size_t __size, const SharedExecutor& __executor) noexcept
 {
 //    using namespace Serialization;
     Result result;
@@ -288,17 +491,36 @@ Result validate_file_structure(BYTE *const __base, size_t __size) noexcept
     result = __FILE_HEADER.validate_full                (__base);
     if (result != IRIS_SUCCESS) return result;
     
-    auto TILE_TABLE = __FILE_HEADER.get_tile_table      (__base);
-    result = TILE_TABLE.validate_full                   (__base);
-    if (result != IRIS_SUCCESS) return result;
-    
-    auto METADATA   = __FILE_HEADER.get_metadata        (__base);
-    result = METADATA.validate_full                     (__base);
-    if (result != IRIS_SUCCESS) return result;
+    // The tile table and metadata trees are independent; the
+    // first failure (in file order) is reported.
+    Result results [2];
+    try {
+        const auto executor = __executor ? __executor : default_executor();
+        executor->bulk(2, [&](size_t index) {
+            switch (index) {
+                case 0: {
+                    auto TILE_TABLE = __FILE_HEADER.get_tile_table  (__base);
+                    results[0]      = TILE_TABLE.validate_full      (__base);
+                } break;
+                case 1: {
+                    auto METADATA   = __FILE_HEADER.get_metadata    (__base);
+                    results[1]      = METADATA.validate_full        (__base);
+                } break;
+            }
+        });
+    } catch (std::exception& error) {
+        return Result (IRIS_FAILURE, error.what());
+    }
+    for (auto&& __result : results)
+        if (__result != IRIS_SUCCESS) return __result;
 
     return IRIS_SUCCESS;
 }
 Abstraction::File  abstract_file_structure (BYTE* const __base, size_t __size) {
+    return abstract_file_structure(__base, __size, inline_executor());
+}
+Abstraction::File  abstract_file_structure (BYTE* const __base, size_t __size,
+                                            const SharedExecutor& __executor) {
     using namespace Abstraction;
 
     Abstraction::File abstraction;
@@ -307,36 +529,53 @@ Abstraction::File  abstract_file_structure (BYTE* const __base, size_t __size) {
     
     abstraction.header      = FILE_HEADER.read_header   (__base);
     auto TILE_TABLE         = FILE_HEADER.get_tile_table(__base);
-    abstraction.tileTable   = TILE_TABLE.read_tile_table(__base);
     auto METADATA           = FILE_HEADER.get_metadata  (__base);
     abstraction.metadata    = METADATA.read_metadata    (__base);
     
+    // The tile table and metadata sub-blocks are read concurrently;
+    // each task writes a separate component of the abstraction.
     auto& metadata          = abstraction.metadata;
-    if (METADATA.attributes                             (__base))
-    {
-        auto ATTRIBUES      = METADATA.get_attributes   (__base);
-        metadata.attributes = ATTRIBUES.read_attributes (__base);
-    }
-    if (METADATA.image_array                            (__base))
-    {
-        auto IMAGES         = METADATA.get_image_array  (__base);
-        abstraction.images  = IMAGES.read_assoc_images  (__base);
-        for (auto&& image : abstraction.images)
-            metadata.associatedImages.insert(image.first);
-    }
-    if (METADATA.color_profile                          (__base))
-    {
-        auto ICC_PROFILE    = METADATA.get_color_profile(__base);
-        metadata.ICC_profile= ICC_PROFILE.read_profile  (__base);
-    }
-    if (METADATA.annotations                            (__base))
-    {
-        auto ANNOTATIONS    = METADATA.get_annotations  (__base);
-        abstraction.annotations =
-        ANNOTATIONS.read_annotations                    (__base);
-        for (auto&& note : abstraction.annotations)
-            metadata.annotations.insert (note.first);
-    }
+    auto& footprint         = abstraction.footprint;
+    footprint.object        = sizeof(Abstraction::File);
+    const auto executor     = __executor ? __executor : default_executor();
+    executor->bulk(5, [&](size_t index) {
+        switch (index) {
+            case 0:
+                abstraction.tileTable   = TILE_TABLE.read_tile_table(__base);
+                footprint.tileTable     = FOOTPRINT_TILE_TABLE      (abstraction.tileTable);
+                break;
+            case 1: if (METADATA.attributes                         (__base))
+            {
+                auto ATTRIBUES      = METADATA.get_attributes       (__base);
+                metadata.attributes = ATTRIBUES.read_attributes     (__base);
+                footprint.attributes= HEAP_BYTES                    (metadata.attributes);
+            } break;
+            case 2: if (METADATA.image_array                        (__base))
+            {
+                auto IMAGES         = METADATA.get_image_array      (__base);
+                abstraction.images  = IMAGES.read_assoc_images      (__base);
+                footprint.images    = HEAP_BYTES                    (abstraction.images);
+            } break;
+            case 3: if (METADATA.color_profile                      (__base))
+            {
+                auto ICC_PROFILE    = METADATA.get_color_profile    (__base);
+                metadata.ICC_profile= ICC_PROFILE.read_profile      (__base);
+                footprint.ICC_profile = HEAP_BYTES                  (metadata.ICC_profile);
+            } break;
+            case 4: if (METADATA.annotations                        (__base))
+            {
+                auto ANNOTATIONS    = METADATA.get_annotations      (__base);
+                abstraction.annotations =
+                ANNOTATIONS.read_annotations                        (__base);
+                footprint.annotations = FOOTPRINT_ANNOTATIONS       (abstraction.annotations);
+            } break;
+        }
+    });
+    for (auto&& image : abstraction.images)
+        metadata.associatedImages.insert(image.first);
+    for (auto&& note : abstraction.annotations)
+        metadata.annotations.insert (note.first);
+    footprint.metadata      = FOOTPRINT_METADATA        (metadata);
     
     return abstraction;
 }
@@ -371,6 +610,21 @@ Abstraction::FileMap  generate_file_map (BYTE* const __base, size_t __size) {
         .datablock      = __TILES,
         .size           = __TILES.size                  (__base)
     };
+    if (auto __BASE     = __TILES.get_base_offsets      (__base))
+        map [__BASE.__offset] = {
+            .type       = MAP_ENTRY_TILE_OFFSETS,
+            .datablock  = __BASE,
+            .size       = __BASE.size                   (__base)
+        };
+    
+    if (__TILE_TABLE.cipher                             (__base)) {
+        auto __CIPHER   = __TILE_TABLE.get_cipher       (__base);
+        map [__CIPHER.__offset] = {
+            .type       = MAP_ENTRY_CIPHER,
+            .datablock  = __CIPHER,
+            .size       = __CIPHER.size                 ()
+        };
+    }
     
     // This is the part that hurts: blocking in all the tiles
     auto table          = __TILE_TABLE.read_tile_table(__base);
@@ -385,6 +639,41 @@ Abstraction::FileMap  generate_file_map (BYTE* const __base, size_t __size) {
                 .size       = offset.size
             };
     
+    // And the tiles of every additional focal plane / channel
+    if (__TILE_TABLE.tile_planes                        (__base)) {
+        auto __PLANES   = __TILE_TABLE.get_tile_planes  (__base);
+        map [__PLANES.__offset] = {
+            .type       = MAP_ENTRY_TILE_PLANES,
+            .datablock  = __PLANES,
+            .size       = __PLANES.size                 (__base)
+        };
+        for (uint32_t PI = 1; PI < table.planes.size(); ++PI) {
+            auto __PLANE    = __PLANES.get_plane_offsets(__base, PI);
+            map [__PLANE.__offset] = {
+                .type       = MAP_ENTRY_TILE_OFFSETS,
+                .datablock  = __PLANE,
+                .size       = __PLANE.size              (__base)
+            };
+            if (auto __BASE = __PLANE.get_base_offsets  (__base))
+                map [__BASE.__offset] = {
+                    .type       = MAP_ENTRY_TILE_OFFSETS,
+                    .datablock  = __BASE,
+                    .size       = __BASE.size           (__base)
+                };
+            auto plane      = __TILE_TABLE.read_tile_plane(__base, PI);
+            for (auto&& layer : plane.layers)
+                for (auto&& offset : layer)
+                    map[offset.offset] = {
+                        .type       = MAP_ENTRY_TILE_DATA,
+                        .datablock  = DATA_BLOCK
+                        (offset.offset,
+                         file_header.fileSize,
+                         file_header.extVersion),
+                        .size       = offset.size
+                    };
+        }
+    }
+    
     auto __METADATA     = __FILE_HEADER.get_metadata    (__base);
     map [__METADATA.__offset] = {
         .type           = MAP_ENTRY_METADATA,
@@ -399,6 +688,24 @@ Abstraction::FileMap  generate_file_map (BYTE* const __base, size_t __size) {
             .datablock  = __ATTR,
             .size       = __ATTR.size()
         };
+        if (__ATTR.dictionary                           (__base))
+        {
+            auto __DICT = __ATTR.get_dictionary         (__base);
+            map[__DICT.__offset] = {
+                .type       = MAP_ENTRY_TEXT_DICTIONARY,
+                .datablock  = __DICT,
+                .size       = __DICT.size               (__base)
+            };
+        }
+        if (__ATTR.directory                            (__base))
+        {
+            auto __DIR  = __ATTR.get_directory          (__base);
+            map[__DIR.__offset] = {
+                .type       = MAP_ENTRY_ATTRIBUTES_DIRECTORY,
+                .datablock  = __DIR,
+                .size       = __DIR.size                (__base)
+            };
+        }
     }
     if (__METADATA.image_array                          (__base))
     {
@@ -409,7 +716,7 @@ Abstraction::FileMap  generate_file_map (BYTE* const __base, size_t __size) {
             .size       = __ARRAY.size                  (__base)
         };
         std::vector<IMAGE_BYTES> __IMAGE_BYTES;
-        __ARRAY.read_assoc_images                       (__base, &__IMAGE_BYTES);
+        auto images     = __ARRAY.read_assoc_images     (__base, &__IMAGE_BYTES);
         for (auto&& BYTES:__IMAGE_BYTES) {
             map[BYTES.__offset] = {
                 .type   = MAP_ENTRY_ASSOCIATED_IMAGE_BYTES,
@@ -417,6 +724,42 @@ Abstraction::FileMap  generate_file_map (BYTE* const __base, size_t __size) {
                 .size   = BYTES.size                    (__base)
             };
         }
+        // Tiled (v2) associated image pyramids and their tiles
+        const auto entries = LOAD_U32(__base + __ARRAY.__offset + IMAGE_ARRAY::ENTRY_NUMBER);
+        for (uint32_t II = 0; II < entries; ++II) {
+            if (__ARRAY.image_pyramid(__base, II) == false) continue;
+            auto __EXTENTS  = __ARRAY.get_image_extents (__base, II);
+            map [__EXTENTS.__offset] = {
+                .type       = MAP_ENTRY_LAYER_EXTENTS,
+                .datablock  = __EXTENTS,
+                .size       = __EXTENTS.size            (__base)
+            };
+            auto __OFFSETS  = __ARRAY.get_image_offsets (__base, II);
+            map [__OFFSETS.__offset] = {
+                .type       = MAP_ENTRY_TILE_OFFSETS,
+                .datablock  = __OFFSETS,
+                .size       = __OFFSETS.size            (__base)
+            };
+            if (auto __BASE = __OFFSETS.get_base_offsets(__base))
+                map [__BASE.__offset] = {
+                    .type       = MAP_ENTRY_TILE_OFFSETS,
+                    .datablock  = __BASE,
+                    .size       = __BASE.size           (__base)
+                };
+        }
+        for (auto&& image : images)
+            for (auto&& layer : image.second.pyramid.layers)
+                for (auto&& tile : layer) {
+                    if (tile.offset == Serialization::NULL_OFFSET) continue;
+                    map[tile.offset] = {
+                        .type       = MAP_ENTRY_ASSOCIATED_IMAGE_TILE,
+                        .datablock  = DATA_BLOCK
+                        (tile.offset,
+                         file_header.fileSize,
+                         file_header.extVersion),
+                        .size       = tile.size
+                    };
+                }
     }
     if (__METADATA.color_profile(__base))
     {
@@ -459,8 +802,27 @@ Abstraction::FileMap  generate_file_map (BYTE* const __base, size_t __size) {
                 .size       = __GRPB.size               (__base)
             };
         }
+        if (__ANNOT.spatial_index                       (__base))
+        {
+            auto __INDX = __ANNOT.get_spatial_index     (__base);
+            map[__INDX.__offset] = {
+                .type       = MAP_ENTRY_ANNOTATION_INDEX,
+                .datablock  = __INDX,
+                .size       = __INDX.size               (__base)
+            };
+        }
+        if (__ANNOT.dictionary                          (__base))
+        {
+            auto __DICT = __ANNOT.get_dictionary        (__base);
+            map[__DICT.__offset] = {
+                .type       = MAP_ENTRY_TEXT_DICTIONARY,
+                .datablock  = __DICT,
+                .size       = __DICT.size               (__base)
+            };
+        }
     }
     
+    map.file_size       = __size;
     return map;
 }
 #elif /* WEB ASSEMBLY */ defined __EMSCRIPTEN__
@@ -552,6 +914,10 @@ EM_ASYNC_JS (int, fetch_data_async,
     return 0;
   }
 });
+inline double SECONDS_SINCE (std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
 inline Response FETCH_DATABLOCK (const char* __url, size_t start, size_t len)
 {
     std::string range_header = "bytes="
@@ -565,12 +931,14 @@ inline Response FETCH_DATABLOCK (const char* __url, size_t start, size_t len)
     // until the fetch operation completes.
     int data_size = 0;
     int status_code = 0;
+    const auto requested = std::chrono::steady_clock::now();
     char* payload = reinterpret_cast<char*>
     (fetch_data_async(__url, range_header.c_str(), &data_size, &status_code));
     // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
     
     Response response = nullptr;
     if (payload && status_code == 206) {
+        IFE::link_estimator(__url)->record(data_size, SECONDS_SINCE(requested));
         response = std::make_shared<__Response>
         (__url, payload, data_size);
     } else {
@@ -580,6 +948,234 @@ inline Response FETCH_DATABLOCK (const char* __url, size_t start, size_t len)
     if (payload) free (payload);
     return response;
 }
+/**
+ * @brief Fetch several byte ranges of a URL in a single multi-range request.
+ *
+ * The request carries a Range header with several ranges (e.g. "bytes=0-99,200-299").
+ * A partial content (206) response body is copied to the WebAssembly heap as per
+ * fetch_data_async and its Content-Type and Content-Range headers are written to
+ * the given buffers (Content-Range is only readable cross-origin if the server
+ * exposes it). Any other response is cancelled before its body is read such that
+ * a server ignoring the ranges does not send the whole file.
+ */
+EM_ASYNC_JS (int, fetch_ranges_async,
+(const char* url_ptr, const char* range_header_ptr, char* content_type_ptr, char* content_range_ptr,
+ int header_bytes, int* data_size_ptr, int* status_ptr), {
+  const request = new Request(UTF8ToString(url_ptr), {
+    headers: {'Range': UTF8ToString(range_header_ptr)}
+  });
+
+  try {
+    const response = await fetch(request);
+    HEAP32[status_ptr >> 2] = response.status;
+    HEAP32[data_size_ptr >> 2] = 0;
+
+    if (response.status !== 206) {
+        if (response.body) await response.body.cancel();
+        return 0;
+    }
+    stringToUTF8(response.headers.get('Content-Type') || '', content_type_ptr, header_bytes);
+    stringToUTF8(response.headers.get('Content-Range') || '', content_range_ptr, header_bytes);
+
+    const buffer = await response.arrayBuffer();
+    const dataSize = buffer.byteLength;
+    const dataPtr = _malloc(dataSize);
+
+    HEAPU8.set(new Uint8Array(buffer), dataPtr);
+    HEAP32[data_size_ptr >> 2] = dataSize;
+    return dataPtr;
+  } catch (error) {
+    console.error("Fetch failed:", error);
+    HEAP32[data_size_ptr >> 2] = 0;
+    HEAP32[status_ptr >> 2] = 0;
+    return 0;
+  }
+});
+/**
+ * @brief Fetch byte ranges of a URL in parallel single range requests.
+ *
+ * At most concurrency requests are in flight at once; each request that
+ * completes issues the next range. The body of each range is copied directly
+ * into its destination (which shall hold sizes[i] bytes) and the seconds its
+ * request took, from issue to the last byte, are written to seconds[i] (left
+ * unwritten for ranges that fail).
+ * @return The number of ranges fetched in full.
+ */
+EM_ASYNC_JS (int, fetch_ranges_parallel_async,
+(const char* url_ptr, int count, int concurrency, const double* offsets_ptr, const double* sizes_ptr,
+ BYTE* const* destinations_ptr, double* seconds_ptr), {
+  const url_js = UTF8ToString(url_ptr);
+  let next = 0;
+  const worker = async () => {
+    let fetched = 0;
+    while (next < count) {
+      const index = next++;
+      const offset = HEAPF64[(offsets_ptr >> 3) + index];
+      const size = HEAPF64[(sizes_ptr >> 3) + index];
+      const started = performance.now();
+      try {
+        const response = await fetch(new Request(url_js, {
+          headers: {'Range': 'bytes=' + offset + '-' + (offset + size - 1)}
+        }));
+        if (response.status !== 206) {
+          if (response.body) await response.body.cancel();
+          continue;
+        }
+        const buffer = new Uint8Array(await response.arrayBuffer());
+        if (buffer.byteLength !== size) continue;
+        HEAPU8.set(buffer, HEAPU32[(destinations_ptr >> 2) + index]);
+        HEAPF64[(seconds_ptr >> 3) + index] = (performance.now() - started) / 1000;
+        ++fetched;
+      } catch (error) {
+        console.error("Fetch failed:", error);
+      }
+    }
+    return fetched;
+  };
+  const workers = Math.max(1, Math.min(concurrency, count));
+  const fetched = await Promise.all(Array.from({length: workers}, worker));
+  return fetched.reduce((total, value) => total + value, 0);
+});
+/**
+ * @brief Fetch a batch of byte ranges into their scatter targets.
+ *
+ * The ranges are first requested together; the parts of a multipart/byteranges
+ * response (or the single part of a server that merged the ranges) are scattered
+ * into the targets. If the server answers otherwise (or incompletely), the
+ * ranges are requested in parallel single range requests, at most the policy
+ * concurrency at a time. Ranges covering exactly one target are fetched
+ * directly into that target. Each completed request is recorded to the link
+ * estimator with its own bytes and time, as is whether the endpoint answered
+ * the multi-range request.
+ */
+inline void FETCH_RANGES (const char* __url, const std::vector<IFE::ByteRange>& ranges, IFE::RangeScatter& scatter,
+                          IFE::LinkEstimator& link, const IFE::RangePolicy& policy)
+{
+    if (ranges.size() > 1 && policy.multirange) {
+        const auto header   = IFE::range_header(ranges);
+        char content_type   [256] = {};
+        char content_range  [256] = {};
+        int data_size       = 0;
+        int status_code     = 0;
+        const auto requested = std::chrono::steady_clock::now();
+        BYTE* payload       = reinterpret_cast<BYTE*>
+        (fetch_ranges_async(__url, header.c_str(), content_type, content_range,
+                            sizeof(content_type), &data_size, &status_code));
+        if (payload) {
+            link.record     (data_size, SECONDS_SINCE(requested));
+            const auto boundary = IFE::multipart_boundary(content_type);
+            IFE::ByteRange part;
+            if (boundary.size()) {
+                IFE::MultipartParser parser (boundary, scatter);
+                link.record_multirange(parser.feed(payload, data_size) && parser.finished());
+            } else if (IFE::parse_content_range(content_range, part) && part.size == Size(data_size)) {
+                scatter.write(part.offset, payload, data_size);
+                link.record_multirange(true);
+            } else link.record_multirange(false);
+            free(payload);
+        } else if (status_code == 200) {
+            // The server ignores Range headers with several ranges
+            link.record_multirange(false);
+        }
+        if (scatter.complete()) return;
+    }
+    
+    std::vector<double> offsets, sizes, seconds (ranges.size(), 0.0);
+    std::vector<BYTE*>  destinations;
+    std::vector<std::vector<BYTE>> buffers (ranges.size());
+    for (size_t RI = 0; RI < ranges.size(); ++RI) {
+        const auto& range   = ranges[RI];
+        BYTE* destination   = nullptr;
+        for (auto&& target : scatter.targets())
+            if (target.offset == range.offset && target.size == range.size)
+                destination = target.destination;
+        if (!destination) {
+            buffers[RI].resize(range.size);
+            destination = buffers[RI].data();
+        }
+        offsets.push_back       (double(range.offset));
+        sizes.push_back         (double(range.size));
+        destinations.push_back  (destination);
+    }
+    // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+    // EXTERNAL JAVASCRIPT CODE (SEE EM_ASYNC_JS ABOVE)
+    const int fetched = fetch_ranges_parallel_async
+    (__url, int(ranges.size()), int(policy.concurrency), offsets.data(), sizes.data(), destinations.data(),
+     seconds.data());
+    // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+    for (size_t RI = 0; RI < ranges.size(); ++RI)
+        if (seconds[RI] > 0) link.record(ranges[RI].size, seconds[RI]);
+    if (fetched != int(ranges.size())) return;
+    
+    for (size_t RI = 0; RI < ranges.size(); ++RI)
+        scatter.write(ranges[RI].offset, destinations[RI], ranges[RI].size);
+}
+/**
+ * @brief Remote data block shared by every copy of a DATA_BLOCK.
+ *
+ * A data block is immutable after it is opened: the remote offset, the
+ * local offset and the remote block are set on construction. Responses are
+ * fetched once and published (release) to concurrent readers, which then
+ * read them without synchronization. The header slot holds the block header
+ * (or the full block if the block is fetched in full); the entries slot
+ * holds the full extent of blocks that fetch their header first (annotations).
+ */
+struct __RemoteBlock {
+    using Slot = IFE::PublishOnce<Response>;
+    Slot    header, entries;
+};
+inline Response PUBLISHED_RESPONSE (const __RemoteBlock::Slot& slot)
+{
+    return slot.published();
+}
+template <class FETCH>
+inline const BYTE* FETCH_REMOTE_SLOT (__RemoteBlock::Slot& slot, const BYTE* base, FETCH&& fetch)
+{
+    return slot.get([&]() {
+        auto response = fetch(REINTERPRET_ARRAY_START(base));
+        if (!response) throw std::runtime_error
+            ("Failed to fetch the remote data block");
+        return response;
+    })->data;
+}
+inline __RemoteBlock& REMOTE_BLOCK (const Serialization::DATA_BLOCK& block)
+{
+    if (!block.__response) throw std::runtime_error
+        ("Failed to fetch the remote data block -- the data block was not created with a remote offset");
+    return *block.__response;
+}
+/// Fetch (once) the header of a remote data block and return the block's base
+template <class BLOCK>
+inline const BYTE* FETCH_REMOTE_HEADER (const BLOCK& block, const BYTE* base)
+{
+    return FETCH_REMOTE_SLOT(REMOTE_BLOCK(block).header, base, [&block](const char* url) {
+        return FETCH_DATABLOCK(url, block.__remote, BLOCK::HEADER_SIZE);
+    });
+}
+/// Fetch the header and then the full extent of a remote data block. The header is
+/// sized through a copy of the block holding only the header such that the block
+/// itself is never re-entered while it is being fetched.
+template <class BLOCK>
+inline Response FETCH_REMOTE_EXTENT (const BLOCK& block, const char* url)
+{
+    auto header = FETCH_DATABLOCK(url, block.__remote, BLOCK::HEADER_SIZE);
+    if (!header) return header;
+    BLOCK sizing            = block;
+    sizing.__response       = std::make_shared<__RemoteBlock>();
+    sizing.__response->header.publish  (header);
+    sizing.__response->entries.publish (header);
+    const auto bytes        = sizing.size(header->data);
+    if (header->len >= __ptr_size + bytes) return header;
+    return FETCH_DATABLOCK(url, block.__remote, bytes);
+}
+/// Fetch (once) the full extent of a remote data block and return the block's base
+template <class BLOCK>
+inline const BYTE* FETCH_REMOTE_BLOCK (const BLOCK& block, const BYTE* base)
+{
+    return FETCH_REMOTE_SLOT(REMOTE_BLOCK(block).header, base, [&block](const char* url) {
+        return FETCH_REMOTE_EXTENT(block, url);
+    });
+}
 bool is_Iris_Codec_file (const std::string url, size_t __size)
 {
     using namespace Serialization;
@@ -638,10 +1234,14 @@ Abstraction::File  abstract_file_structure (const std::string url, size_t __size
     abstraction.metadata    = METADATA.read_metadata    (__base);
 
     auto& metadata          = abstraction.metadata;
+    auto& footprint         = abstraction.footprint;
+    footprint.object        = sizeof(Abstraction::File);
+    footprint.tileTable     = FOOTPRINT_TILE_TABLE      (abstraction.tileTable);
     if (METADATA.attributes                             (__base))
     {
         auto ATTRIBUES      = METADATA.get_attributes   (__base);
         metadata.attributes = ATTRIBUES.read_attributes (__base);
+        footprint.attributes= HEAP_BYTES                (metadata.attributes);
     }
     if (METADATA.image_array                            (__base))
     {
@@ -649,11 +1249,13 @@ Abstraction::File  abstract_file_structure (const std::string url, size_t __size
         abstraction.images  = IMAGES.read_assoc_images  (__base);
         for (auto&& image : abstraction.images)
             metadata.associatedImages.insert(image.first);
+        footprint.images    = HEAP_BYTES                (abstraction.images);
     }
     if (METADATA.color_profile                          (__base))
     {
         auto ICC_PROFILE    = METADATA.get_color_profile(__base);
         metadata.ICC_profile= ICC_PROFILE.read_profile  (__base);
+        footprint.ICC_profile = HEAP_BYTES              (metadata.ICC_profile);
     }
     if (METADATA.annotations                            (__base))
     {
@@ -662,118 +1264,1142 @@ Abstraction::File  abstract_file_structure (const std::string url, size_t __size
         ANNOTATIONS.read_annotations                    (__base);
         for (auto&& note : abstraction.annotations)
             metadata.annotations.insert (note.first);
+        footprint.annotations = FOOTPRINT_ANNOTATIONS   (abstraction.annotations);
     }
+    footprint.metadata      = FOOTPRINT_METADATA        (metadata);
     return abstraction;
 }
 #endif
-namespace Serialization {
-inline bool VALIDATE_ENCODING_TYPE (Encoding encoding, uint32_t __version) {
-    switch (encoding) {
-        case TILE_ENCODING_IRIS:
-        case TILE_ENCODING_JPEG:
-        case TILE_ENCODING_AVIF:    return true;
-        default:                    break;
+// MARK: - ANNOTATION LEVEL OF DETAIL
+// Edge length (in highest resolution pixels) of the tiles bucketing annotations
+constexpr float ANNOTATION_LOD_TILE_LENGTH = 256.f;
+static Abstraction::AnnotationLOD GENERATE_ANNOTATION_LOD (const Abstraction::Annotations& notes,
+                                                           const Extent& extent,
+                                                           const Abstraction::TileExtents& tiles,
+                                                           Size __size,
+                                                           const BYTE* const __base,
+                                                           uint32_t cluster_size)
+{
+    using namespace Abstraction;
+    using Serialization::TYPE_SIZE_UINT24;
+    using Identifier    = AnnotationLOD::Identifier;
+    const auto& layers  = extent.layers;
+    
+    AnnotationLOD lod;
+    lod.clusterSize     = cluster_size;
+    lod.cellLength      = ANNOTATION_LOD_TILE_LENGTH;
+    if (layers.size()) {
+        // Cells remain standard tile sized when the layer uses larger tiles
+        const TileExtent tile = tiles.size() ? tiles.back() : TileExtent();
+        const uint64_t x_cells = (uint64_t(layers.back().xTiles) * tile.width  +
+                                  TileExtent::STANDARD - 1) / TileExtent::STANDARD;
+        const uint64_t y_cells = (uint64_t(layers.back().yTiles) * tile.height +
+                                  TileExtent::STANDARD - 1) / TileExtent::STANDARD;
+        lod.xCells      = U16_CAST(std::min<uint64_t>(x_cells, UINT16_MAX));
+        lod.yCells      = U16_CAST(std::min<uint64_t>(y_cells, UINT16_MAX));
+    } else {
+        float x_extent = 0.f, y_extent = 0.f;
+        for (auto&& note : notes) {
+            x_extent    = std::max(x_extent, note.second.xLocation);
+            y_extent    = std::max(y_extent, note.second.yLocation);
+        }
+        lod.xCells      = SPATIAL_CELL(x_extent, lod.cellLength, UINT16_MAX) + 1;
+        lod.yCells      = SPATIAL_CELL(y_extent, lod.cellLength, UINT16_MAX) + 1;
     }
     
-    if (__version > IRIS_EXTENSION_1_0); else return false;
-    
-    // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
-    // VERSION CONTROL: VERSION 2 PARAMETERS ARE ADDED HERE
-    // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
-    
-    return false;
-}
-inline bool VALIDATE_PIXEL_FORMAT (Format format, uint32_t __version) {
-    switch (format) {
-        case Iris::FORMAT_B8G8R8:
-        case Iris::FORMAT_R8G8B8:
-        case Iris::FORMAT_B8G8R8A8:
-        case Iris::FORMAT_R8G8B8A8: return true;
-        default:                    break;
+    // Resolve annotation group membership from the group identifier arrays.
+    // The group byte array is the label followed by the 24-bit identifiers.
+    std::vector<const std::string*> group_names;
+    std::unordered_map<Identifier, std::vector<uint32_t>> members;
+    if (__base) for (auto&& group : notes.groups) {
+        const auto& name    = group.first;
+        const auto  offset  = group.second.offset + name.size();
+        if (group.second.offset == NULL_OFFSET ||
+            offset + Size(group.second.number) * TYPE_SIZE_UINT24 > __size)
+            throw std::runtime_error
+            ("Failed to generate annotation level of detail -- annotation group ("+
+             name + ") identifier array extends beyond the end of the file.");
+        const BYTE* __ids   = __base + offset;
+        for (uint32_t GI = 0; GI < group.second.number; ++GI, __ids += TYPE_SIZE_UINT24)
+            members[LOAD_U24(__ids)].push_back(U32_CAST(group_names.size()));
+        group_names.push_back(&name);
     }
     
-    if (__version > IRIS_EXTENSION_1_0); else return false;
-    
-    // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
-    // VERSION CONTROL: VERSION 2 PARAMETERS ARE ADDED HERE
-    // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
-    
-    return false;
-    
-}
-inline bool VALIDATE_METADATA_TYPE (MetadataType type, uint32_t __version)
-{
-    switch (type) {
-        case METADATA_I2S:
-        case METADATA_DICOM:    return true;
-        default:                break;
+    lod.entries.reserve(notes.size());
+    for (auto&& note : notes) {
+        const auto& annotation = note.second;
+        lod.entries.push_back({MORTON_ENCODE
+            (SPATIAL_CELL(annotation.xLocation, lod.cellLength, lod.xCells),
+             SPATIAL_CELL(annotation.yLocation, lod.cellLength, lod.yCells)),
+            note.first});
+        lod.maxXSize = std::max(lod.maxXSize, fabsf(annotation.xSize));
+        lod.maxYSize = std::max(lod.maxYSize, fabsf(annotation.ySize));
     }
-    
-    if (__version > IRIS_EXTENSION_1_0); else return false;
-    
-    // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
-    // VERSION CONTROL: VERSION 2 PARAMETERS ARE ADDED HERE
-    // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
-    
-    return false;
+    std::sort(lod.entries.begin(), lod.entries.end());
+    
+    // Resolve the annotations once in Morton order rather than per layer
+    std::vector<const Annotation*> sorted (lod.entries.size());
+    for (size_t EI = 0; EI < lod.entries.size(); ++EI)
+        sorted[EI] = &notes.at(lod.entries[EI].second);
+    
+    lod.layers.resize(layers.size());
+    for (size_t LI = 0; LI < layers.size(); ++LI) {
+        auto& layer         = lod.layers[LI];
+        const auto scale    = std::max(layers[LI].downsample, 1.f);
+        layer.shift         = std::min(U32_CAST(lroundf(log2f(scale))), 15U);
+        const auto SHIFT    = 2 * layer.shift;
+        
+        // Entries are Morton sorted; the tiles of a layer cell are contiguous.
+        for (size_t first = 0, last = 0; first < lod.entries.size(); first = last) {
+            const auto cell = lod.entries[first].first >> SHIFT;
+            while (last < lod.entries.size() && lod.entries[last].first >> SHIFT == cell) ++last;
+            if (last - first <= cluster_size) continue;
+            
+            AnnotationLOD::Cluster cluster;
+            cluster.number  = U32_CAST(last - first);
+            float x0 = FLT_MAX, y0 = FLT_MAX, x1 = -FLT_MAX, y1 = -FLT_MAX;
+            uint32_t types [UINT8_MAX+1] = {};
+            std::unordered_map<uint32_t, uint32_t> groups;
+            for (size_t EI = first; EI < last; ++EI) {
+                const auto& annotation = *sorted[EI];
+                x0 = std::min(x0, std::min(annotation.xLocation, annotation.xLocation + annotation.xSize));
+                y0 = std::min(y0, std::min(annotation.yLocation, annotation.yLocation + annotation.ySize));
+                x1 = std::max(x1, std::max(annotation.xLocation, annotation.xLocation + annotation.xSize));
+                y1 = std::max(y1, std::max(annotation.yLocation, annotation.yLocation + annotation.ySize));
+                types[annotation.type]++;
+                auto member = members.find(lod.entries[EI].second);
+                if (member != members.end())
+                    for (auto&& group : member->second) groups[group]++;
+            }
+            cluster.xLocation   = x0;
+            cluster.yLocation   = y0;
+            cluster.xSize       = x1 - x0;
+            cluster.ySize       = y1 - y0;
+            cluster.type        = static_cast<Annotation::Type>
+            (std::max_element(std::begin(types), std::end(types)) - std::begin(types));
+            if (groups.size()) cluster.group = *group_names[std::max_element
+                (groups.begin(), groups.end(), [](const auto& a, const auto& b)
+                 {return a.second < b.second;})->first];
+            
+            layer.cells.push_back(cell);
+            layer.clusters.push_back(std::move(cluster));
+        }
+    }
+    return lod;
 }
-inline bool VALIDATE_IMAGE_ENCODING_TYPE (ImageEncoding encoding, uint32_t __version)
+Abstraction::AnnotationLOD generate_annotation_lod (const Abstraction::File& file, const BYTE* const __base, uint32_t cluster_size)
 {
-    switch (encoding) {
-        case IMAGE_ENCODING_PNG:
-        case IMAGE_ENCODING_JPEG:
-        case IMAGE_ENCODING_AVIF:   return true;
-        default:                    break;
-    }
-     
-    if (__version > IRIS_EXTENSION_1_0); else return false;
-    
-    // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
-    // VERSION CONTROL: VERSION 2 PARAMETERS ARE ADDED HERE
-    // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
-    
-    return false;
+    return GENERATE_ANNOTATION_LOD(file.annotations, file.tileTable.extent,
+                                   file.tileTable.tileExtents,
+                                   file.header.fileSize, __base, cluster_size);
 }
-inline bool VALIDATE_ANNOTATION_TYPE (AnnotationTypes type, uint32_t __version)
+// MARK: - LAZY FILE ABSTRACTION
+// The metadata sub-block loaders each capture their own copy of the
+// METADATA block such that concurrent first accesses of different
+// handles never share a serialization object.
+static void BIND_LAZY_METADATA (Abstraction::LazyFile& abstraction,
+                                const BYTE* const __base,
+                                const Serialization::METADATA& METADATA,
+                                const std::shared_ptr<const void>& __keep_alive = nullptr)
 {
-    switch (type) {
-        case Iris::ANNOTATION_PNG:
-        case Iris::ANNOTATION_JPEG:
-        case Iris::ANNOTATION_SVG:
-        case Iris::ANNOTATION_TEXT: return true;
-        default:                    break;
-    }
-    
-    if (__version > IRIS_EXTENSION_1_0); else return false;
-    
-    // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
-    // VERSION CONTROL: VERSION 2 PARAMETERS ARE ADDED HERE
-    // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
-    
-    return false;
-    
+    using namespace Abstraction;
+    const auto extent   = abstraction.tileTable.extent;
+    const auto tiles    = abstraction.tileTable.tileExtents;
+    const auto size     = abstraction.header.fileSize;
+    
+    abstraction.attributes  = LazyBlock<Attributes>([__base, METADATA, __keep_alive]() {
+        if (!METADATA.attributes                        (__base)) return Attributes();
+        auto ATTRIBUTES     = METADATA.get_attributes   (__base);
+        return ATTRIBUTES.read_attributes               (__base);
+    });
+    abstraction.images      = LazyBlock<AssociatedImages>([__base, METADATA, __keep_alive]() {
+        if (!METADATA.image_array                       (__base)) return AssociatedImages();
+        auto IMAGES         = METADATA.get_image_array  (__base);
+        return IMAGES.read_assoc_images                 (__base);
+    });
+    abstraction.ICC_profile = LazyBlock<std::string>([__base, METADATA, __keep_alive]() {
+        if (!METADATA.color_profile                     (__base)) return std::string();
+        auto ICC_PROFILE    = METADATA.get_color_profile(__base);
+        return ICC_PROFILE.read_profile                 (__base);
+    });
+    auto annotations        = LazyBlock<Annotations>([__base, METADATA, __keep_alive]() {
+        if (!METADATA.annotations                       (__base)) return Annotations();
+        auto ANNOTATIONS    = METADATA.get_annotations  (__base);
+        return ANNOTATIONS.read_annotations             (__base);
+    });
+    abstraction.annotations = annotations;
+    // Group membership is resolved from the mapped bytes; remote
+    // files report the most frequent annotation type only.
+#ifndef __EMSCRIPTEN__
+    const BYTE* __groups    = __base;
+#else
+    const BYTE* __groups    = nullptr;
+#endif
+    abstraction.annotationLOD = LazyBlock<AnnotationLOD>([annotations, extent, tiles, size, __groups]() {
+        return GENERATE_ANNOTATION_LOD(*annotations, extent, tiles, size, __groups,
+                                       AnnotationLOD::CLUSTER_SIZE);
+    });
 }
-// MARK: - DATA_BLOCK
 #ifndef __EMSCRIPTEN__
- DATA_BLOCK::DATA_BLOCK (Offset offset, Size file_size, uint32_t IFE_version) :
-__offset    (offset),
-__size      (file_size),
-__version   (IFE_version)
+Abstraction::LazyFile abstract_file_structure_lazy (BYTE* const __base, size_t __size)
 {
+    Abstraction::LazyFile abstraction;
+    auto FILE_HEADER        = Serialization::FILE_HEADER(__size);
+    
+    abstraction.header      = FILE_HEADER.read_header   (__base);
+    auto TILE_TABLE         = FILE_HEADER.get_tile_table(__base);
+    abstraction.tileTable   = TILE_TABLE.read_tile_table(__base);
+    auto METADATA           = FILE_HEADER.get_metadata  (__base);
+    abstraction.metadata    = METADATA.read_metadata    (__base);
     
+    BIND_LAZY_METADATA      (abstraction, __base, METADATA);
+    abstraction.footprint   = memory_footprint          (abstraction);
+    return abstraction;
 }
-#elif defined __EMSCRIPTEN__
-DATA_BLOCK::DATA_BLOCK (Offset offset, Size file_size, uint32_t IFE_version) :
-__remote    (offset),
-__size      (file_size),
-__version   (IFE_version)
+Abstraction::DeferredFile abstract_file_structure_deferred (BYTE* const __base, size_t __size,
+                                                            std::function<void(const Result&)> callback,
+                                                            const SharedExecutor& executor)
 {
+    using namespace Abstraction;
+    
+    // Synchronously check the file header and the tile table and
+    // metadata block offsets and recovery tags. These are cheap.
+    auto FILE_HEADER        = Serialization::FILE_HEADER(__size);
+    auto result             = FILE_HEADER.validate_full (__base);
+    if (result & IRIS_FAILURE) throw std::runtime_error
+        ("Failed to open Iris file -- " + result.message);
     
+    DeferredFile abstraction;
+    static_cast<LazyFile&>(abstraction) = abstract_file_structure_lazy(__base, __size);
+    abstraction.validation  = std::make_shared<Validation>(__base, __size, std::move(callback), executor);
+    return abstraction;
 }
-#endif
- DATA_BLOCK::operator bool() const
+Abstraction::TileTable abstract_tile_plane (BYTE* const __base, size_t __size, uint32_t plane)
 {
-    return __offset != NULL_OFFSET && __offset < __size;
+    auto FILE_HEADER        = Serialization::FILE_HEADER(__size);
+    auto TILE_TABLE         = FILE_HEADER.get_tile_table(__base);
+    return TILE_TABLE.read_tile_plane                   (__base, plane);
+}
+#else
+Abstraction::LazyFile abstract_file_structure_lazy (const std::string url, size_t __size)
+{
+    using namespace Serialization;
+    
+    Abstraction::LazyFile abstraction;
+    // The remote responses reference the URL string by pointer; it and the
+    // file header response must outlive the deferred metadata fetches.
+    auto __url      = std::make_shared<const std::string>(url);
+    auto response   = FETCH_DATABLOCK(__url->c_str(), 0, FILE_HEADER::HEADER_SIZE);
+    if (!response) throw std::runtime_error
+        ("Failed to fetch Iris file header from remote endpoint ("+url+")");
+    const BYTE* __base = response->data;
+    
+    auto FILE_HEADER        = Serialization::FILE_HEADER(__size);
+    abstraction.header      = FILE_HEADER.read_header   (__base);
+    auto TILE_TABLE         = FILE_HEADER.get_tile_table(__base);
+    abstraction.tileTable   = TILE_TABLE.read_tile_table(__base);
+    auto METADATA           = FILE_HEADER.get_metadata  (__base);
+    abstraction.metadata    = METADATA.read_metadata    (__base);
+    
+    BIND_LAZY_METADATA      (abstraction, __base, METADATA, std::make_shared
+                             <std::pair<std::shared_ptr<const std::string>, Response>>
+                             (__url, response));
+    abstraction.footprint   = memory_footprint          (abstraction);
+    const auto METADATA_RESPONSE = PUBLISHED_RESPONSE(REMOTE_BLOCK(METADATA).header);
+    abstraction.footprint.remote = response->len + HEAP_BYTES(*__url) +
+    (METADATA_RESPONSE && METADATA_RESPONSE != response ? METADATA_RESPONSE->len : 0);
+    return abstraction;
+}
+Abstraction::TileTable abstract_tile_plane (const std::string url, size_t __size, uint32_t plane)
+{
+    using namespace Serialization;
+    
+    auto response = FETCH_DATABLOCK(url.c_str(), 0, FILE_HEADER::HEADER_SIZE);
+    if (!response) throw std::runtime_error
+        ("Failed to fetch Iris file header from remote endpoint ("+url+")");
+    const BYTE* __base = response->data;
+    
+    auto FILE_HEADER        = Serialization::FILE_HEADER(__size);
+    auto TILE_TABLE         = FILE_HEADER.get_tile_table(__base);
+    return TILE_TABLE.read_tile_plane                   (__base, plane);
+}
+std::vector<BYTE> fetch_mip_tail (const std::string url, const Abstraction::TileTable& tile_table)
+{
+    const auto& tail = tile_table.mipTail;
+    if (tail.offset == NULL_OFFSET || tail.size == 0) return std::vector<BYTE>();
+    
+    auto response = FETCH_DATABLOCK(url.c_str(), tail.offset, tail.size);
+    if (!response || response->len < __ptr_size + tail.size) throw std::runtime_error
+        ("Failed to fetch the mip tail from remote endpoint ("+url+")");
+    const BYTE* __tail = response->data + __ptr_size;
+    return std::vector<BYTE>(__tail, __tail + tail.size);
+}
+std::vector<BYTE> fetch_associated_tile (const std::string url, const Abstraction::TileEntry& tile)
+{
+    if (tile.offset == NULL_OFFSET || tile.size == 0) return std::vector<BYTE>();
+    
+    auto response = FETCH_DATABLOCK(url.c_str(), tile.offset, tile.size);
+    if (!response || response->len < __ptr_size + tile.size) throw std::runtime_error
+        ("Failed to fetch the associated image tile from remote endpoint ("+url+")");
+    const BYTE* __tile = response->data + __ptr_size;
+    return std::vector<BYTE>(__tile, __tile + tile.size);
+}
+std::vector<BYTE> fetch_tile (const std::string url, const Abstraction::TileEntry& tile)
+{
+    if (tile.offset == NULL_OFFSET || tile.size == 0) return std::vector<BYTE>();
+    
+    auto response = FETCH_DATABLOCK(url.c_str(), tile.offset, tile.size);
+    if (!response || response->len < __ptr_size + tile.size) throw std::runtime_error
+        ("Failed to fetch the slide tile from remote endpoint ("+url+")");
+    const BYTE* __tile = response->data + __ptr_size;
+    return std::vector<BYTE>(__tile, __tile + tile.size);
+}
+std::vector<std::vector<BYTE>> fetch_tiles (const std::string url, const std::vector<Abstraction::TileEntry>& tiles,
+                                            const SharedIOScheduler& scheduler, const IOTag& tag)
+{
+    std::vector<std::vector<BYTE>> result (tiles.size());
+    std::vector<IFE::ByteRange> requested;
+    for (auto&& tile : tiles)
+        if (tile.offset != NULL_OFFSET && tile.size)
+            requested.push_back({tile.offset, tile.size});
+    
+    // Each batch is a single request (unless the server declines multiple ranges).
+    // Gaps and batch sizes follow the measured bandwidth-delay product of the endpoint.
+    const auto link     = IFE::link_estimator(url);
+    const auto policy   = link->policy();
+    const auto ranges   = IFE::coalesce_ranges(std::move(requested), policy.merge_gap);
+    for (auto&& batch : IFE::batch_ranges(ranges, IFE::RANGE_HEADER_BYTES, policy.max_request)) {
+        const Offset start  = batch.front().offset;
+        const Offset end    = batch.back().offset + batch.back().size;
+        std::vector<IFE::ScatterTarget> targets;
+        for (size_t TI = 0; TI < tiles.size(); ++TI) {
+            const auto& tile = tiles[TI];
+            if (tile.offset == NULL_OFFSET || tile.size == 0) continue;
+            if (tile.offset < start || tile.offset >= end) continue;
+            result[TI].resize(tile.size);
+            targets.push_back({tile.offset, tile.size, result[TI].data()});
+        }
+        Size bytes = 0;
+        for (auto&& range : batch) bytes += range.size;
+        IOScheduler::Grant grant = scheduler ? scheduler->acquire(tag, bytes) : nullptr;
+        IFE::RangeScatter scatter (std::move(targets));
+        FETCH_RANGES (url.c_str(), batch, scatter, *link, policy);
+        if (!scatter.complete()) throw std::runtime_error
+            ("Failed to fetch the slide tiles from remote endpoint ("+url+")");
+    }
+    return result;
+}
+#endif
+// MARK: - CONTENT FINGERPRINT
+// Streaming XXH64 (xxHash, Yann Collet; BSD 2-Clause). The 128-bit
+// fingerprint is formed from two XXH64 lanes of different seeds.
+constexpr uint64_t XXH_PRIME64_1    = 0x9E3779B185EBCA87ULL;
+constexpr uint64_t XXH_PRIME64_2    = 0xC2B2AE3D27D4EB4FULL;
+constexpr uint64_t XXH_PRIME64_3    = 0x165667B19E3779F9ULL;
+constexpr uint64_t XXH_PRIME64_4    = 0x85EBCA77C2B2AE63ULL;
+constexpr uint64_t XXH_PRIME64_5    = 0x27D4EB2F165667C5ULL;
+constexpr uint64_t FINGERPRINT_SEED = MAGIC_BYTES;
+inline uint64_t XXH_READ64 (const BYTE* __ptr)
+{
+    if constexpr (std::endian::native == std::endian::little) return __LE_LOAD_U64(__ptr);
+    else return __BE_LOAD_U64(__ptr);
+}
+inline uint32_t XXH_READ32 (const BYTE* __ptr)
+{
+    if constexpr (std::endian::native == std::endian::little) return __LE_LOAD_U32(__ptr);
+    else return __BE_LOAD_U32(__ptr);
+}
+inline uint64_t XXH_ROUND (uint64_t acc, uint64_t input)
+{
+    return std::rotl(acc + input * XXH_PRIME64_2, 31) * XXH_PRIME64_1;
+}
+inline uint64_t XXH_MERGE (uint64_t acc, uint64_t value)
+{
+    return (acc ^ XXH_ROUND(0, value)) * XXH_PRIME64_1 + XXH_PRIME64_4;
+}
+struct XXH64_STATE {
+    uint64_t    seed;
+    uint64_t    lanes [4];
+    BYTE        buffer [32];
+    uint32_t    buffered    = 0;
+    uint64_t    length      = 0;
+    explicit XXH64_STATE (uint64_t __seed) : seed (__seed),
+    lanes {__seed + XXH_PRIME64_1 + XXH_PRIME64_2, __seed + XXH_PRIME64_2, __seed, __seed - XXH_PRIME64_1} {}
+    void stripe (const BYTE* __ptr)
+    {
+        for (int LI = 0; LI < 4; ++LI, __ptr += 8)
+            lanes[LI] = XXH_ROUND(lanes[LI], XXH_READ64(__ptr));
+    }
+    void update (const BYTE* __ptr, size_t bytes)
+    {
+        length += bytes;
+        if (buffered) {
+            const auto N = std::min<size_t>(bytes, sizeof(buffer) - buffered);
+            memcpy(buffer + buffered, __ptr, N);
+            buffered += N; __ptr += N; bytes -= N;
+            if (buffered < sizeof(buffer)) return;
+            stripe(buffer);
+            buffered = 0;
+        }
+        for (; bytes >= sizeof(buffer); __ptr += sizeof(buffer), bytes -= sizeof(buffer))
+            stripe(__ptr);
+        memcpy(buffer, __ptr, bytes);
+        buffered = U32_CAST(bytes);
+    }
+    uint64_t digest () const
+    {
+        uint64_t hash = length >= sizeof(buffer) ?
+        XXH_MERGE(XXH_MERGE(XXH_MERGE(XXH_MERGE(std::rotl(lanes[0], 1) + std::rotl(lanes[1], 7) +
+                                                std::rotl(lanes[2],12) + std::rotl(lanes[3],18),
+                                                lanes[0]), lanes[1]), lanes[2]), lanes[3]) :
+        seed + XXH_PRIME64_5;
+        hash += length;
+        const BYTE* __ptr = buffer;
+        uint32_t remaining = buffered;
+        for (; remaining >= 8; __ptr += 8, remaining -= 8)
+            hash = std::rotl(hash ^ XXH_ROUND(0, XXH_READ64(__ptr)), 27) * XXH_PRIME64_1 + XXH_PRIME64_4;
+        if (remaining >= 4) {
+            hash = std::rotl(hash ^ (XXH_READ32(__ptr) * XXH_PRIME64_1), 23) * XXH_PRIME64_2 + XXH_PRIME64_3;
+            __ptr += 4; remaining -= 4;
+        }
+        for (; remaining; ++__ptr, --remaining)
+            hash = std::rotl(hash ^ (*__ptr * XXH_PRIME64_5), 11) * XXH_PRIME64_1;
+        hash ^= hash >> 33; hash *= XXH_PRIME64_2;
+        hash ^= hash >> 29; hash *= XXH_PRIME64_3;
+        hash ^= hash >> 32;
+        return hash;
+    }
+};
+struct FINGERPRINT_HASH {
+    XXH64_STATE low     {0};
+    XXH64_STATE high    {FINGERPRINT_SEED};
+    void update (const BYTE* __ptr, size_t bytes)
+    {
+        low.update  (__ptr, bytes);
+        high.update (__ptr, bytes);
+    }
+    Abstraction::Fingerprint digest () const
+    {
+        return Abstraction::Fingerprint {
+            .low    = low.digest(),
+            .high   = high.digest(),
+        };
+    }
+};
+static Abstraction::Fingerprint GENERATE_FINGERPRINT (const BYTE* const __base, Size __size,
+                                                      const Serialization::TILE_TABLE& TILE_TABLE,
+                                                      uint32_t samples)
+{
+    using namespace Serialization;
+    FINGERPRINT_HASH hash;
+    const auto table        = TILE_TABLE.read_tile_table(__base);
+    
+    // Tile table encoding, format and extent (not the volatile offsets)
+    hash.update (__base + TILE_TABLE.__offset + TILE_TABLE::ENCODING,
+                 TILE_TABLE::ENCODING_S + TILE_TABLE::FORMAT_S);
+    hash.update (__base + TILE_TABLE.__offset + TILE_TABLE::X_EXTENT,
+                 TILE_TABLE::X_EXTENT_S + TILE_TABLE::Y_EXTENT_S);
+    
+    // Layer extents and tile offsets arrays. Entries close both arrays.
+    auto LAYER_EXTENTS      = TILE_TABLE.get_layer_extents(__base);
+    auto __ptr              = __base + LAYER_EXTENTS.__offset;
+    Size bytes              = Size(LOAD_U16(__ptr + LAYER_EXTENTS::ENTRY_SIZE)) *
+                              LOAD_U32(__ptr + LAYER_EXTENTS::ENTRY_NUMBER);
+    hash.update (__ptr + LAYER_EXTENTS.size(__base) - bytes, bytes);
+    
+    // Tile offsets are hashed as resolved, complete entries so that
+    // delta-encoded tables fingerprint identically to complete tables.
+    std::vector<BYTE> entries;
+    for (auto&& layer : table.layers) {
+        const auto start    = entries.size();
+        entries.resize(start + layer.size() * TILE_OFFSET::SIZE);
+        BYTE* __array       = entries.data() + start;
+        for (auto&& tile : layer) {
+            const bool sparse = tile.offset == Serialization::NULL_OFFSET;
+            STORE_U40 (__array + TILE_OFFSET::OFFSET,      sparse ? NULL_TILE : tile.offset);
+            STORE_U24 (__array + TILE_OFFSET::TILE_SIZE,   sparse ? 0 : tile.size);
+            __array        += TILE_OFFSET::SIZE;
+        }
+    }
+    hash.update (entries.data(), entries.size());
+    
+    // Evenly spaced tile payloads of each layer, including the first and last
+    for (auto&& layer : table.layers) {
+        const size_t tiles  = layer.size();
+        const size_t count  = std::min<size_t>(tiles, samples);
+        for (size_t SI = 0; SI < count; ++SI) {
+            const auto& tile = layer[count > 1 ? SI * (tiles - 1) / (count - 1) : 0];
+            if (tile.offset == Serialization::NULL_OFFSET || tile.offset == NULL_TILE || !tile.size) continue;
+            if (tile.offset + tile.size > __size) throw std::runtime_error
+                ("Failed to generate content fingerprint -- tile data block (" +
+                 std::to_string(tile.offset) + "-" + std::to_string(tile.offset + tile.size) +
+                 " bytes) extends beyond the end of the file.");
+            hash.update (__base + tile.offset, tile.size);
+        }
+    }
+    return hash.digest();
+}
+#ifndef __EMSCRIPTEN__
+Abstraction::Fingerprint generate_fingerprint (const BYTE* const __base, size_t __size, uint32_t samples)
+{
+    auto FILE_HEADER        = Serialization::FILE_HEADER(__size);
+    auto TILE_TABLE         = FILE_HEADER.get_tile_table(__base);
+    return GENERATE_FINGERPRINT(__base, __size, TILE_TABLE, samples);
+}
+#endif
+// MARK: - TILE CIPHER
+struct Abstraction::__CipherKey {
+    const CipherAlgorithm   algorithm;
+    const IFE::AES_GCM      context;
+    explicit __CipherKey (CipherAlgorithm __algorithm, const BYTE* const key, size_t key_bytes) :
+    algorithm   (__algorithm),
+    context     (key, key_bytes)
+    {
+        
+    }
+};
+constexpr size_t CIPHER_AAD_SIZE    = 3 * sizeof(uint32_t);
+inline bool VALIDATE_CIPHER_ALGORITHM (Abstraction::CipherAlgorithm algorithm)
+{
+    switch (algorithm) {
+        case Abstraction::CIPHER_AES_128_GCM:
+        case Abstraction::CIPHER_AES_256_GCM:   return true;
+        case Abstraction::CIPHER_UNDEFINED:
+        default:                                return false;
+    }
+}
+inline size_t CIPHER_KEY_SIZE (Abstraction::CipherAlgorithm algorithm)
+{
+    switch (algorithm) {
+        case Abstraction::CIPHER_AES_128_GCM:   return 16;
+        case Abstraction::CIPHER_AES_256_GCM:   return 32;
+        default:                                return 0;
+    }
+}
+// The tile location is authenticated with every tile such that
+// encrypted tiles cannot be swapped or moved within the file.
+inline void CIPHER_TILE_AAD (const Abstraction::CipherTile& tile, BYTE* const __aad)
+{
+    STORE_U32 (__aad,                           tile.plane);
+    STORE_U32 (__aad + sizeof(uint32_t),        tile.layer);
+    STORE_U32 (__aad + 2 * sizeof(uint32_t),    tile.tile);
+}
+// The key check tag authenticates an empty message (the algorithm as additional data)
+inline void CIPHER_CHECK_TAG (const Abstraction::__CipherKey& key, const BYTE* const __nonce, BYTE* const __tag)
+{
+    const BYTE algorithm = key.algorithm;
+    key.context.encrypt(__nonce, &algorithm, sizeof(algorithm), nullptr, 0, nullptr, __tag);
+}
+Abstraction::CipherKey create_cipher_key (Abstraction::CipherAlgorithm algorithm, const BYTE* const key, size_t key_bytes)
+{
+    if (VALIDATE_CIPHER_ALGORITHM(algorithm) == false) throw std::runtime_error
+        ("Failed to create cipher key -- undefined cipher algorithm (" +
+         to_hex_string(static_cast<uint8_t>(algorithm)) + ").");
+    if (key == nullptr || key_bytes != CIPHER_KEY_SIZE(algorithm)) throw std::runtime_error
+        ("Failed to create cipher key -- the key (" + std::to_string(key ? key_bytes : 0) +
+         " bytes) does not match the cipher algorithm key size (" +
+         std::to_string(CIPHER_KEY_SIZE(algorithm)) + " bytes).");
+    return std::make_shared<const Abstraction::__CipherKey>(algorithm, key, key_bytes);
+}
+Result verify_cipher_key (const Abstraction::Cipher& cipher, const Abstraction::CipherKey& key) noexcept
+{
+    if (!cipher) return Result
+        (IRIS_FAILURE, "Failed to verify cipher key -- the slide tiles are not encrypted.");
+    if (!key) return Result
+        (IRIS_FAILURE, "Failed to verify cipher key -- no cipher key was provided.");
+    if (key->algorithm != cipher.algorithm) return Result
+        (IRIS_FAILURE, "Failed to verify cipher key -- the key algorithm (" +
+         to_hex_string(static_cast<uint8_t>(key->algorithm)) +
+         ") does not match the slide cipher algorithm (" +
+         to_hex_string(static_cast<uint8_t>(cipher.algorithm)) + ").");
+    BYTE tag [Abstraction::Cipher::TAG_SIZE];
+    CIPHER_CHECK_TAG(*key, cipher.checkNonce.data(), tag);
+    if (IFE::constant_time_equal(tag, cipher.checkTag.data(), Abstraction::Cipher::TAG_SIZE) == false) return Result
+        (IRIS_FAILURE, "Failed to verify cipher key -- the key is not the slide cipher key.");
+    return IRIS_SUCCESS;
+}
+void encrypt_tile (const Abstraction::CipherKey& key, const Abstraction::CipherTile& tile)
+{
+    if (!key) throw std::runtime_error
+        ("Failed to encrypt tile -- no cipher key was provided.");
+    if ((tile.size && tile.source == nullptr) || tile.destination == nullptr) throw std::runtime_error
+        ("Failed to encrypt tile -- invalid source or destination buffer.");
+    
+    BYTE aad [CIPHER_AAD_SIZE];
+    CIPHER_TILE_AAD (tile, aad);
+    BYTE* const __nonce = tile.destination;
+    BYTE* const __data  = __nonce + Abstraction::Cipher::NONCE_SIZE;
+    IFE::random_bytes   (__nonce, Abstraction::Cipher::NONCE_SIZE);
+    key->context.encrypt(__nonce, aad, CIPHER_AAD_SIZE, tile.source, tile.size, __data, __data + tile.size);
+}
+Result decrypt_tile (const Abstraction::CipherKey& key, const Abstraction::CipherTile& tile) noexcept
+{
+    if (!key) return Result
+        (IRIS_FAILURE, "Failed to decrypt tile -- no cipher key was provided.");
+    if (tile.size < Abstraction::Cipher::OVERHEAD || tile.source == nullptr ||
+        (tile.size > Abstraction::Cipher::OVERHEAD && tile.destination == nullptr)) return Result
+        (IRIS_FAILURE, "Failed to decrypt tile -- invalid encrypted tile (" +
+         std::to_string(tile.size) + " bytes) or destination buffer.");
+    
+    BYTE aad [CIPHER_AAD_SIZE];
+    CIPHER_TILE_AAD (tile, aad);
+    const BYTE* __nonce = tile.source;
+    const BYTE* __data  = __nonce + Abstraction::Cipher::NONCE_SIZE;
+    const Size  bytes   = tile.size - Abstraction::Cipher::OVERHEAD;
+    if (key->context.decrypt(__nonce, aad, CIPHER_AAD_SIZE, __data, bytes, tile.destination, __data + bytes))
+        return IRIS_SUCCESS;
+    return Result
+        (IRIS_FAILURE, "Failed to decrypt tile (plane " + std::to_string(tile.plane) +
+         ", layer " + std::to_string(tile.layer) + ", tile " + std::to_string(tile.tile) +
+         ") -- the tile failed authentication. The key is incorrect or the tile data was altered.");
+}
+// The failing tile of the lowest index is reported such
+// that the result does not depend upon scheduling.
+static Result DECRYPT_TILES_RESULT (const std::vector<Abstraction::CipherTile>& tiles, size_t failed, size_t first)
+{
+    if (failed == 0) return IRIS_SUCCESS;
+    const auto& tile = tiles[first];
+    return Result
+        (IRIS_FAILURE, "Failed to decrypt tiles -- " + std::to_string(failed) + " of " +
+         std::to_string(tiles.size()) + " tiles failed authentication (first: plane " +
+         std::to_string(tile.plane) + ", layer " + std::to_string(tile.layer) + ", tile " +
+         std::to_string(tile.tile) + "). The key is incorrect or the tile data was altered.");
+}
+Result decrypt_tiles (const Abstraction::CipherKey& key, const std::vector<Abstraction::CipherTile>& tiles,
+                      const SharedExecutor& __executor) noexcept
+{
+    if (!key) return Result
+        (IRIS_FAILURE, "Failed to decrypt tiles -- no cipher key was provided.");
+    
+    std::atomic<size_t> failed  = 0;
+    std::atomic<size_t> first   = SIZE_MAX;
+    try {
+        const auto executor = __executor ? __executor : default_executor();
+        executor->bulk(tiles.size(), [&](size_t TI) {
+            if (decrypt_tile(key, tiles[TI]) & IRIS_FAILURE) {
+                ++failed;
+                size_t prior = first.load();
+                while (TI < prior && !first.compare_exchange_weak(prior, TI));
+            }
+        });
+    } catch (std::exception& error) {
+        return Result (IRIS_FAILURE, std::string("Failed to decrypt tiles -- ") + error.what());
+    }
+    return DECRYPT_TILES_RESULT(tiles, failed, first);
+}
+// MARK: - ATTRIBUTE ORDER
+// Attribute sizes, bytes and directory arrays are written in key order such that
+// the encoding does not depend upon the hash map iteration order.
+using AttributePtr = const Attributes::value_type*;
+inline std::vector<AttributePtr> SORTED_ATTRIBUTES (const Attributes& attributes)
+{
+    std::vector<AttributePtr> sorted;
+    sorted.reserve(attributes.size());
+    for (auto&& attribute : attributes)
+        sorted.push_back(&attribute);
+    std::sort(sorted.begin(), sorted.end(), [](AttributePtr a, AttributePtr b)
+              {return a->first < b->first;});
+    return sorted;
+}
+inline uint64_t ATTRIBUTE_KEY_HASH (const BYTE* const __key, size_t bytes)
+{
+    XXH64_STATE hash (0);
+    hash.update (__key, bytes);
+    return hash.digest();
+}
+// MARK: - TEXT COMPRESSION
+// Compressed text blocks are framed by their decoded byte size
+constexpr size_t TEXT_FRAME_HEADER_SIZE = sizeof(uint32_t);
+inline bool VALIDATE_TEXT_COMPRESSION (Abstraction::TextCompression compression)
+{
+    switch (compression) {
+        case Abstraction::TEXT_UNCOMPRESSED:
+        case Abstraction::TEXT_LZ_DICTIONARY:   return true;
+        default:                                return false;
+    }
+}
+using TextDictionaryPtr = std::shared_ptr<const Abstraction::TextDictionary>;
+static std::mutex                                       TEXT_DICTIONARIES_MUTEX;
+static std::unordered_map<uint32_t, TextDictionaryPtr>  TEXT_DICTIONARIES;
+inline uint64_t TEXT_DICTIONARY_CHECKSUM (const BYTE* const __bytes, size_t bytes)
+{
+    XXH64_STATE hash (0);
+    hash.update (__bytes, bytes);
+    return hash.digest();
+}
+inline TextDictionaryPtr FIND_TEXT_DICTIONARY (uint32_t identifier)
+{
+    std::lock_guard<std::mutex> lock (TEXT_DICTIONARIES_MUTEX);
+    auto entry = TEXT_DICTIONARIES.find(identifier);
+    return entry == TEXT_DICTIONARIES.end() ? nullptr : entry->second;
+}
+// Attributes are serialized as key / value byte runs in key order (see STORE_ATTRIBUTES_BYTES)
+inline std::string SERIALIZE_ATTRIBUTES (const Attributes& attributes)
+{
+    std::string text;
+    for (auto&& attribute : SORTED_ATTRIBUTES(attributes)) {
+        text.append(attribute->first);
+        text.append(reinterpret_cast<const char*>(attribute->second.data()), attribute->second.size());
+    } return text;
+}
+// Decode a compressed text frame into exactly bytes of __dst
+inline bool DECOMPRESS_TEXT (const BYTE* const __src, size_t src_bytes, const Abstraction::TextDictionary* dictionary,
+                             BYTE* const __dst, size_t bytes)
+{
+    if (src_bytes < TEXT_FRAME_HEADER_SIZE || LOAD_U32(__src) != bytes) return false;
+    const auto* dict = dictionary ? reinterpret_cast<const uint8_t*>(dictionary->bytes.data()) : nullptr;
+    return IFE::lz_decompress(dict, dictionary ? dictionary->bytes.size() : 0,
+                              __src + TEXT_FRAME_HEADER_SIZE, src_bytes - TEXT_FRAME_HEADER_SIZE,
+                              __dst, bytes);
+}
+Abstraction::TextDictionary train_text_dictionary (const std::vector<std::string>& samples, uint32_t identifier, size_t max_bytes)
+{
+    std::vector<std::string_view> views (samples.begin(), samples.end());
+    return Abstraction::TextDictionary {
+        .identifier = identifier,
+        .bytes      = IFE::train_dictionary(views, std::min(max_bytes, Abstraction::TextDictionary::MAX_SIZE)),
+    };
+}
+Abstraction::TextDictionary train_text_dictionary (const std::vector<Attributes>& samples, uint32_t identifier, size_t max_bytes)
+{
+    std::vector<std::string> serialized;
+    serialized.reserve(samples.size());
+    for (auto&& attributes : samples)
+        serialized.push_back(SERIALIZE_ATTRIBUTES(attributes));
+    return train_text_dictionary(serialized, identifier, max_bytes);
+}
+void register_text_dictionary (const Abstraction::TextDictionary& dictionary)
+{
+    if (dictionary.identifier == 0) throw std::runtime_error
+        ("Failed to register text dictionary -- identifier 0 is reserved for unregistered (embedded) dictionaries.");
+    if (dictionary.bytes.empty() || dictionary.bytes.size() > Abstraction::TextDictionary::MAX_SIZE) throw std::runtime_error
+        ("Failed to register text dictionary -- dictionary size (" +
+         std::to_string(dictionary.bytes.size()) + " bytes) shall be between 1 and " +
+         std::to_string(Abstraction::TextDictionary::MAX_SIZE) + " bytes.");
+    auto entry = std::make_shared<const Abstraction::TextDictionary>(dictionary);
+    std::lock_guard<std::mutex> lock (TEXT_DICTIONARIES_MUTEX);
+    TEXT_DICTIONARIES[dictionary.identifier] = std::move(entry);
+}
+std::vector<BYTE> compress_text (const BYTE* const text, size_t bytes, const Abstraction::TextDictionary* dictionary)
+{
+    if (bytes && text == nullptr) throw std::runtime_error
+        ("Failed to compress text -- no text was provided.");
+    if (bytes > UINT32_MAX) throw std::runtime_error
+        ("Failed to compress text -- text block (" + std::to_string(bytes) +
+         " bytes) exceeds the 32-bit size limit.");
+    if (dictionary && dictionary->bytes.size() > Abstraction::TextDictionary::MAX_SIZE) throw std::runtime_error
+        ("Failed to compress text -- dictionary (" + std::to_string(dictionary->bytes.size()) +
+         " bytes) exceeds the maximum dictionary size.");
+    
+    std::vector<BYTE> compressed (TEXT_FRAME_HEADER_SIZE + IFE::lz_compress_bound(bytes));
+    const auto* dict = dictionary ? reinterpret_cast<const uint8_t*>(dictionary->bytes.data()) : nullptr;
+    STORE_U32(compressed.data(), U32_CAST(bytes));
+    const auto stored = IFE::lz_compress(dict, dictionary ? dictionary->bytes.size() : 0, text, bytes,
+                                         compressed.data() + TEXT_FRAME_HEADER_SIZE);
+    compressed.resize(TEXT_FRAME_HEADER_SIZE + stored);
+    return compressed;
+}
+std::string decompress_text (const BYTE* const compressed, size_t bytes, const Abstraction::TextDictionary* dictionary)
+{
+    if (compressed == nullptr || bytes < TEXT_FRAME_HEADER_SIZE) throw std::runtime_error
+        ("Failed to decompress text -- the compressed block (" + std::to_string(bytes) +
+         " bytes) is smaller than the text frame header.");
+    // No sequence expands beyond 255 bytes per encoded byte; reject implausible sizes before allocating
+    const Size decoded = LOAD_U32(compressed);
+    if (decoded > Size(bytes) * 255) throw std::runtime_error
+        ("Failed to decompress text -- the decoded size (" + std::to_string(decoded) +
+         " bytes) is not possible for a compressed block of " + std::to_string(bytes) + " bytes.");
+    
+    std::string text (decoded, '\0');
+    if (DECOMPRESS_TEXT(compressed, bytes, dictionary, reinterpret_cast<BYTE*>(text.data()), decoded) == false)
+        throw std::runtime_error
+        ("Failed to decompress text -- the compressed block is malformed or was compressed with a different dictionary.");
+    return text;
+}
+// MARK: - ABSTRACTION
+namespace Abstraction {
+std::string Fingerprint::to_string () const
+{
+    std::string string (32, '0');
+    for (int HI = 0; HI < 16; ++HI) {
+        string[15 - HI] = hex_array[high >> (4 * HI) & 0x0F];
+        string[31 - HI] = hex_array[low  >> (4 * HI) & 0x0F];
+    }
+    return string;
+}
+#ifndef __EMSCRIPTEN__
+// State shared by a validation and its background pass
+struct __ValidationPass {
+    std::atomic<ValidationState>state       = VALIDATION_PENDING;
+    std::atomic<bool>           released    = false;    // Cancels a pass not yet started
+    std::promise<Result>        promise;
+    std::shared_future<Result>  result      = promise.get_future().share();
+};
+Validation::Validation (const BYTE* const __base, Size file_size, Callback&& callback,
+                        const SharedExecutor& __executor) :
+__size      (file_size),
+__pass      (std::make_shared<__ValidationPass>())
+{
+    // Completes the pass if the executor discards it unrun. Copies of
+    // the task share the guard; the last copy destroyed completes it.
+    struct Discarded {
+        std::shared_ptr<__ValidationPass> pass;
+        bool            ran     = false;
+        ~Discarded () {
+            if (pass && !ran) pass->promise.set_value(Result
+                (IRIS_FAILURE, "Background file structure validation was discarded by the executor."));
+        }
+    };
+    auto guard      = std::make_shared<Discarded>();
+    guard->pass     = __pass;
+    auto validate   = [guard, __base, size = __size, callback = std::move(callback)]() {
+        auto& pass  = *guard->pass;
+        guard->ran  = true;
+        Result result;
+        if (pass.released.load(std::memory_order_acquire)) result = Result
+            (IRIS_FAILURE, "Background file structure validation was cancelled -- the validation was released before the pass started.");
+        else {
+            result  = validate_file_structure(const_cast<BYTE*>(__base), size);
+            pass.state.store(result & IRIS_FAILURE ? VALIDATION_FAILED : VALIDATION_PASSED,
+                             std::memory_order_release);
+        }
+        // Publish before the callback, which may release the validation
+        pass.promise.set_value(result);
+        if (callback) try {callback(result);} catch (...) {}
+    };
+    const auto executor = __executor ? __executor : default_executor();
+    executor->submit(std::move(validate), PRIORITY_LOW);
+}
+Validation::~Validation ()
+{
+    // The pass holds its own reference to the shared state
+    __pass->released.store(true, std::memory_order_release);
+}
+ValidationState Validation::state () const noexcept
+{
+    return __pass->state.load(std::memory_order_acquire);
+}
+Result Validation::wait () const
+{
+    return __pass->result.get();
+}
+Result Validation::check_tile (const TileEntry &tile) const noexcept
+{
+    switch (state()) {
+        case VALIDATION_PASSED: return IRIS_SUCCESS;
+        case VALIDATION_FAILED: return Result
+            (IRIS_FAILURE, "The file is quarantined -- background file structure validation failed.");
+        default: break;
+    }
+    // Validation pending: the tile bytes must lie within the file.
+    if (tile.offset == NULL_OFFSET || tile.size == 0) return IRIS_SUCCESS;
+    if (tile.offset < Serialization::FILE_HEADER::HEADER_V1_0_SIZE ||
+        tile.size > __size || tile.offset > __size - tile.size) return Result
+        (IRIS_FAILURE, "Tile byte range (offset " + std::to_string(tile.offset) +
+         ", " + std::to_string(tile.size) + " bytes) extends beyond the end of the file (" +
+         std::to_string(__size) + " bytes).");
+    return IRIS_SUCCESS;
+}
+#endif
+uint64_t AttributeDirectory::hash (const std::string_view& key) noexcept
+{
+    return ATTRIBUTE_KEY_HASH(reinterpret_cast<const BYTE*>(key.data()), key.size());
+}
+std::pair<AttributeDirectory::Entries::const_iterator, AttributeDirectory::Entries::const_iterator>
+AttributeDirectory::find (const std::string_view& key) const
+{
+    return std::equal_range
+    (entries.begin(), entries.end(), Entry {.hash = hash(key)},
+     [](const Entry& a, const Entry& b) {return a.hash < b.hash;});
+}
+uint32_t AssociatedImage::layer_width (uint32_t layer) const
+{
+    const auto& layers  = pyramid.extent.layers;
+    if (layer >= layers.size()) throw std::runtime_error
+        ("AssociatedImage::layer_width failed -- layer (" + std::to_string(layer) +
+         ") exceeds the number of pyramid layers (" + std::to_string(layers.size()) + ").");
+    const auto width    = std::ceil(double(info.width) / layers[layer].downsample);
+    const auto tiles    = double(layers[layer].xTiles) * pyramid.tileExtents[layer].width;
+    return U32_CAST(std::clamp(width, 1.0, tiles));
+}
+uint32_t AssociatedImage::layer_height (uint32_t layer) const
+{
+    const auto& layers  = pyramid.extent.layers;
+    if (layer >= layers.size()) throw std::runtime_error
+        ("AssociatedImage::layer_height failed -- layer (" + std::to_string(layer) +
+         ") exceeds the number of pyramid layers (" + std::to_string(layers.size()) + ").");
+    const auto height   = std::ceil(double(info.height) / layers[layer].downsample);
+    const auto tiles    = double(layers[layer].yTiles) * pyramid.tileExtents[layer].height;
+    return U32_CAST(std::clamp(height, 1.0, tiles));
+}
+AssociatedImage::Tiles AssociatedImage::thumbnail (uint32_t width, uint32_t height) const
+{
+    if (!tiled()) return Tiles();
+    
+    // The lowest resolution layer that need not be upsampled
+    uint32_t layer      = 0;
+    const auto last     = U32_CAST(pyramid.layers.size() - 1);
+    while (layer < last && (layer_width(layer) < width || layer_height(layer) < height)) ++layer;
+    return region(layer, 0, 0, layer_width(layer), layer_height(layer));
+}
+AssociatedImage::Tiles AssociatedImage::region (uint32_t layer, uint32_t x, uint32_t y,
+                                                uint32_t width, uint32_t height) const
+{
+    Tiles tiles;
+    if (!tiled()) return tiles;
+    
+    const auto LW       = layer_width(layer);
+    const auto LH       = layer_height(layer);
+    if (width == 0 || height == 0 || x >= LW || y >= LH) return tiles;
+    
+    const auto& extent  = pyramid.extent.layers[layer];
+    const auto& tile    = pyramid.tileExtents[layer];
+    const auto& entries = pyramid.layers[layer];
+    const uint32_t x0   = x / tile.width;
+    const uint32_t y0   = y / tile.height;
+    const uint32_t x1   = std::min<uint32_t>((std::min<uint64_t>(Size(x) + width, LW) - 1) / tile.width,
+                                             extent.xTiles - 1);
+    const uint32_t y1   = std::min<uint32_t>((std::min<uint64_t>(Size(y) + height, LH) - 1) / tile.height,
+                                             extent.yTiles - 1);
+    tiles.reserve(Size(x1 - x0 + 1) * (y1 - y0 + 1));
+    for (uint32_t ty = y0; ty <= y1; ++ty)
+        for (uint32_t tx = x0; tx <= x1; ++tx) {
+            const uint32_t index = ty * extent.xTiles + tx;
+            if (index >= entries.size()) throw std::runtime_error
+                ("AssociatedImage::region failed -- tile (" + std::to_string(index) +
+                 ") exceeds the tiles of layer (" + std::to_string(layer) + ").");
+            tiles.push_back({
+                .layer  = layer,
+                .index  = index,
+                .x      = tx,
+                .y      = ty,
+                .entry  = entries[index],
+            });
+        }
+    return tiles;
+}
+AnnotationIndex::EntryRanges AnnotationIndex::query(float x, float y, float width, float height) const
+{
+    EntryRanges ranges;
+    if (buckets.empty() || xCells == 0 || yCells == 0) return ranges;
+    
+    // Buckets are keyed by the annotation location (origin corner); any annotation
+    // intersecting the viewport has its location within the viewport expanded
+    // by the largest annotation size in the array. Sizes are signed, such that
+    // an annotation may extend toward the viewport from either side.
+    NORMALIZE_REGION(x, width);
+    NORMALIZE_REGION(y, height);
+    const uint16_t x0 = SPATIAL_CELL(x - maxXSize, cellWidth, xCells);
+    const uint16_t y0 = SPATIAL_CELL(y - maxYSize, cellHeight, yCells);
+    const uint16_t x1 = SPATIAL_CELL(x + width + maxXSize, cellWidth, xCells);
+    const uint16_t y1 = SPATIAL_CELL(y + height + maxYSize, cellHeight, yCells);
+    
+    std::vector<const Bucket*> hits;
+    const Size cells = Size(x1 - x0 + 1) * Size(y1 - y0 + 1);
+    if (cells < buckets.size()) {
+        // Few cells in view: binary search each cell in the sorted bucket array
+        for (uint32_t cy = y0; cy <= y1; ++cy)
+            for (uint32_t cx = x0; cx <= x1; ++cx) {
+                const auto cell = MORTON_ENCODE(U16_CAST(cx), U16_CAST(cy));
+                const auto it   = std::lower_bound
+                (buckets.begin(), buckets.end(), cell,
+                 [](const Bucket& b, uint32_t c) {return b.cell < c;});
+                if (it != buckets.end() && it->cell == cell) hits.push_back(&*it);
+            }
+    } else {
+        // Large viewports: a single pass over the occupied cells is cheaper
+        for (auto&& bucket : buckets) {
+            const auto cx = MORTON_DECODE_X(bucket.cell);
+            const auto cy = MORTON_DECODE_Y(bucket.cell);
+            if (cx >= x0 && cx <= x1 && cy >= y0 && cy <= y1) hits.push_back(&bucket);
+        }
+    }
+    std::sort(hits.begin(), hits.end(), [](const Bucket* a, const Bucket* b)
+              {return a->first < b->first;});
+    
+    // Merge contiguous entry runs so each range requires a single read / fetch
+    for (auto&& bucket : hits) {
+        if (bucket->number == 0) continue;
+        if (ranges.size() && ranges.back().first + ranges.back().number == bucket->first)
+            ranges.back().number += bucket->number;
+        else ranges.push_back({.first = bucket->first, .number = bucket->number});
+    }
+    for (auto&& range : ranges) {
+        range.offset    = entries == NULL_OFFSET ? NULL_OFFSET :
+                          entries + Offset(range.first) * entrySize;
+        range.byteSize  = Size(range.number) * entrySize;
+    }
+    return ranges;
+}
+AnnotationLOD::View AnnotationLOD::query(uint32_t layer_index, float x, float y, float width, float height) const
+{
+    View view;
+    if (layer_index >= layers.size() || entries.empty()) return view;
+    const auto& layer   = layers[layer_index];
+    const auto  SHIFT   = 2 * layer.shift;
+    
+    // Entries are keyed by their location; expand the viewport on every side
+    // by the largest annotation (sizes are signed) so intersecting
+    // annotations are not missed.
+    NORMALIZE_REGION(x, width);
+    NORMALIZE_REGION(y, height);
+    const uint32_t x0 = SPATIAL_CELL(x - maxXSize, cellLength, xCells) >> layer.shift;
+    const uint32_t y0 = SPATIAL_CELL(y - maxYSize, cellLength, yCells) >> layer.shift;
+    const uint32_t x1 = SPATIAL_CELL(x + width + maxXSize, cellLength, xCells) >> layer.shift;
+    const uint32_t y1 = SPATIAL_CELL(y + height + maxYSize, cellLength, yCells) >> layer.shift;
+    
+    auto clustered = [&layer](uint64_t cell)->const Cluster* {
+        const auto it = std::lower_bound(layer.cells.begin(), layer.cells.end(), cell);
+        if (it == layer.cells.end() || *it != cell) return nullptr;
+        return &layer.clusters[it - layer.cells.begin()];
+    };
+    const Size cells = Size(x1 - x0 + 1) * Size(y1 - y0 + 1);
+    if (cells < entries.size()) {
+        // Viewport sized queries: visit each layer cell in view
+        for (uint32_t cy = y0; cy <= y1; ++cy)
+            for (uint32_t cx = x0; cx <= x1; ++cx) {
+                const uint64_t cell = MORTON_ENCODE(U16_CAST(cx), U16_CAST(cy));
+                if (auto cluster = clustered(cell)) {
+                    view.clusters.push_back(*cluster);
+                    continue;
+                }
+                auto it = std::lower_bound(entries.begin(), entries.end(),
+                                           Entry(U32_CAST(cell << SHIFT), 0));
+                for (; it != entries.end() && (it->first >> SHIFT) == cell; ++it)
+                    view.annotations.push_back(it->second);
+            }
+    } else {
+        // Whole slide queries: a single pass over the sorted entries
+        for (size_t first = 0, last = 0; first < entries.size(); first = last) {
+            const uint32_t cell = entries[first].first >> SHIFT;
+            while (last < entries.size() && entries[last].first >> SHIFT == cell) ++last;
+            const auto cx = MORTON_DECODE_X(cell), cy = MORTON_DECODE_Y(cell);
+            if (cx < x0 || cx > x1 || cy < y0 || cy > y1) continue;
+            if (auto cluster = clustered(cell)) {
+                view.clusters.push_back(*cluster);
+                continue;
+            }
+            for (size_t EI = first; EI < last; ++EI)
+                view.annotations.push_back(entries[EI].second);
+        }
+    }
+    return view;
+}
+} // END ABSTRACTION
+namespace Serialization {
+inline bool VALIDATE_ENCODING_TYPE (Encoding encoding, uint32_t __version) {
+    switch (encoding) {
+        case TILE_ENCODING_IRIS:
+        case TILE_ENCODING_JPEG:
+        case TILE_ENCODING_AVIF:    return true;
+        default:                    break;
+    }
+    
+    if (__version > IRIS_EXTENSION_1_0); else return false;
+    
+    // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
+    // VERSION CONTROL: VERSION 2 PARAMETERS ARE ADDED HERE
+    // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
+    
+    return false;
+}
+inline bool VALIDATE_PIXEL_FORMAT (Format format, uint32_t __version) {
+    switch (format) {
+        case Iris::FORMAT_B8G8R8:
+        case Iris::FORMAT_R8G8B8:
+        case Iris::FORMAT_B8G8R8A8:
+        case Iris::FORMAT_R8G8B8A8: return true;
+        default:                    break;
+    }
+    
+    if (__version > IRIS_EXTENSION_1_0); else return false;
+    
+    // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
+    // VERSION CONTROL: VERSION 2 PARAMETERS ARE ADDED HERE
+    // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
+    
+    return false;
+    
+}
+inline bool VALIDATE_METADATA_TYPE (MetadataType type, uint32_t __version)
+{
+    switch (type) {
+        case METADATA_I2S:
+        case METADATA_DICOM:    return true;
+        default:                break;
+    }
+    
+    if (__version > IRIS_EXTENSION_1_0); else return false;
+    
+    // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
+    // VERSION CONTROL: VERSION 2 PARAMETERS ARE ADDED HERE
+    // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
+    
+    return false;
+}
+inline bool VALIDATE_IMAGE_ENCODING_TYPE (ImageEncoding encoding, uint32_t __version)
+{
+    switch (encoding) {
+        case IMAGE_ENCODING_PNG:
+        case IMAGE_ENCODING_JPEG:
+        case IMAGE_ENCODING_AVIF:   return true;
+        default:                    break;
+    }
+     
+    if (__version > IRIS_EXTENSION_1_0); else return false;
+    
+    // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
+    // VERSION CONTROL: VERSION 2 PARAMETERS ARE ADDED HERE
+    // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
+    
+    return false;
+}
+inline bool VALIDATE_ANNOTATION_TYPE (AnnotationTypes type, uint32_t __version)
+{
+    switch (type) {
+        case Iris::ANNOTATION_PNG:
+        case Iris::ANNOTATION_JPEG:
+        case Iris::ANNOTATION_SVG:
+        case Iris::ANNOTATION_TEXT: return true;
+        default:                    break;
+    }
+    
+    if (__version > IRIS_EXTENSION_1_0); else return false;
+    
+    // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
+    // VERSION CONTROL: VERSION 2 PARAMETERS ARE ADDED HERE
+    // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
+    
+    return false;
+    
+}
+// MARK: - DATA_BLOCK
+#ifndef __EMSCRIPTEN__
+ DATA_BLOCK::DATA_BLOCK (Offset offset, Size file_size, uint32_t IFE_version) :
+__offset    (offset),
+__size      (file_size),
+__version   (IFE_version)
+{
+    
+}
+#elif defined __EMSCRIPTEN__
+DATA_BLOCK::DATA_BLOCK (Offset offset, Size file_size, uint32_t IFE_version) :
+__remote    (offset),
+__response  (std::make_shared<__RemoteBlock>()),
+__offset    (offset == NULL_OFFSET ? NULL_OFFSET : __ptr_size),
+__size      (file_size),
+__version   (IFE_version)
+{
+    
+}
+#endif
+ DATA_BLOCK::operator bool() const
+{
+#ifndef __EMSCRIPTEN__
+    return __offset != NULL_OFFSET && __offset < __size;
+#elif defined __EMSCRIPTEN__
+    return __remote != NULL_OFFSET && __remote < __size;
+#endif
 }
 Result  DATA_BLOCK::validate_offset (const BYTE *const __base, const char* __type, enum RECOVERY __recovery) const noexcept
 {
@@ -807,10 +2433,10 @@ DATA_BLOCK (HEADER_OFFSET, __file_size, UINT32_MAX)
 {
     
 }
-Size FILE_HEADER::size(const BYTE *const __base) const
+Size FILE_HEADER::size(const BYTE* __base) const
 {
 #ifdef __EMSCRIPTEN__
-    const_cast<FILE_HEADER&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
     validate_header(__base);
     uint32_t version =  LOAD_U16(__base + __offset + EXTENSION_MAJOR) << 16 |
@@ -821,13 +2447,14 @@ Size FILE_HEADER::size(const BYTE *const __base) const
     // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
     // VERSION CONTROL: VERSION 2 VALIDATIONS ARE ADDED HERE
     // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
+    size = HEADER_V2_0_SIZE;
     
     return size;
 }
 Result FILE_HEADER::validate_header(const BYTE* __base) const
 {
 #ifdef __EMSCRIPTEN__
-    const_cast<FILE_HEADER&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
     if (!*this) return Result
         (IRIS_VALIDATION_FAILURE,"Invalid file header size. The header must be created with the OS returned file size.");
@@ -866,10 +2493,10 @@ Result FILE_HEADER::validate_header(const BYTE* __base) const
     
     return IRIS_SUCCESS;
 }
-Result FILE_HEADER::validate_full (const BYTE *const __base) const noexcept
+Result FILE_HEADER::validate_full (const BYTE* __base) const noexcept
 {
 #ifdef __EMSCRIPTEN__
-    const_cast<FILE_HEADER&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
     auto result = validate_header (__base);
     if (result & IRIS_FAILURE) return result;
@@ -898,10 +2525,10 @@ Result FILE_HEADER::validate_full (const BYTE *const __base) const noexcept
     
     return result;
 }
-Header FILE_HEADER::read_header(const BYTE *const __base) const
+Header FILE_HEADER::read_header(const BYTE* __base) const
 {
 #ifdef __EMSCRIPTEN__
-    const_cast<FILE_HEADER&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
     Header header;
     Result result = validate_header(__base);
@@ -917,13 +2544,15 @@ Header FILE_HEADER::read_header(const BYTE *const __base) const
     // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
     // VERSION CONTROL: VERSION 2 PARAMETERS ARE ADDED HERE
     // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
+    header.fingerprint.low  = LOAD_U64(__base + __offset + FINGERPRINT_LOW);
+    header.fingerprint.high = LOAD_U64(__base + __offset + FINGERPRINT_HIGH);
     
     return header;
 }
-TILE_TABLE FILE_HEADER::get_tile_table (const BYTE* const __base) const
+TILE_TABLE FILE_HEADER::get_tile_table (const BYTE* __base) const
 {
 #ifdef __EMSCRIPTEN__
-    const_cast<FILE_HEADER&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
     const auto header       = read_header(__base);
     if (header.extVersion == 0) throw std::runtime_error
@@ -939,10 +2568,10 @@ TILE_TABLE FILE_HEADER::get_tile_table (const BYTE* const __base) const
     
     return __TILE_TABLE;
 }
-METADATA FILE_HEADER::get_metadata (const BYTE *const __base) const
+METADATA FILE_HEADER::get_metadata (const BYTE* __base) const
 {
 #ifdef __EMSCRIPTEN__
-    const_cast<FILE_HEADER&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
     const auto header       = read_header(__base);
     if (header.extVersion == 0) throw std::runtime_error
@@ -959,13 +2588,9 @@ METADATA FILE_HEADER::get_metadata (const BYTE *const __base) const
     return __METADATA;
 }
 #ifdef __EMSCRIPTEN__
-void FILE_HEADER::check_and_fetch_remote(const BYTE *const &base)
+const BYTE* FILE_HEADER::check_and_fetch_remote (const BYTE* base) const
 {
-    if (!__response) {
-        const char* url = REINTERPRET_ARRAY_START(base);
-        __response      = FETCH_DATABLOCK(url,__remote,HEADER_SIZE);
-        __offset        = __ptr_size;
-    } const_cast<const BYTE*&>(base) = __response->data;
+    return FETCH_REMOTE_HEADER(*this, base);
 }
 #else
 void STORE_FILE_HEADER (BYTE *const __base, const HeaderCreateInfo &__CI)
@@ -1003,6 +2628,15 @@ void STORE_FILE_HEADER (BYTE *const __base, const HeaderCreateInfo &__CI)
     STORE_U32   (__base + FILE_HEADER::FILE_REVISION,       __CI.revision);
     STORE_U64   (__base + FILE_HEADER::TILE_TABLE_OFFSET,   __CI.tileTableOffset);
     STORE_U64   (__base + FILE_HEADER::METADATA_OFFSET,     __CI.metadataOffset);
+    
+    // The fingerprint covers the tile table and tile data only
+    // and may therefore be generated prior to the header.
+    Fingerprint fingerprint;
+    blk_validation.__offset = __CI.tileTableOffset;
+    if (__CI.fingerprint) fingerprint = GENERATE_FINGERPRINT
+        (__base, __CI.fileSize, static_cast<TILE_TABLE&>(blk_validation), Fingerprint::SAMPLES);
+    STORE_U64   (__base + FILE_HEADER::FINGERPRINT_LOW,     fingerprint.low);
+    STORE_U64   (__base + FILE_HEADER::FINGERPRINT_HIGH,    fingerprint.high);
 }
 #endif
 
@@ -1020,19 +2654,20 @@ Size TILE_TABLE::size() const
     // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
     // VERSION CONTROL: VERSION 2 VALIDATIONS ARE ADDED HERE
     // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
+    size = HEADER_V2_0_SIZE;
     
     return size;
 }
-Result TILE_TABLE::validate_offset(const BYTE *const __base) const noexcept {
+Result TILE_TABLE::validate_offset(const BYTE* __base) const noexcept {
 #ifdef __EMSCRIPTEN__
-    const_cast<TILE_TABLE&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
     return DATA_BLOCK::validate_offset(__base, type, recovery);
 }
-Result TILE_TABLE::validate_full(const BYTE *const __base) const noexcept
+Result TILE_TABLE::validate_full(const BYTE* __base) const noexcept
 {
 #ifdef __EMSCRIPTEN__
-    const_cast<TILE_TABLE&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
     Result result = validate_offset(__base);
     if (result & IRIS_FAILURE) return result;
@@ -1060,12 +2695,63 @@ Result TILE_TABLE::validate_full(const BYTE *const __base) const noexcept
     result = __TILE_OFFSETS.validate_full (__base);
     if (result & IRIS_VALIDATION_FAILURE) return result;
     
+    if (__version > IRIS_EXTENSION_1_0); else return IRIS_SUCCESS;
+    
+    // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
+    // VERSION CONTROL: VERSION 2 VALIDATIONS ARE ADDED HERE
+    // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
+    offset = LOAD_U64(__ptr + PLANES_OFFSET);
+    if (offset != NULL_OFFSET) {
+        const auto __TILE_PLANES = TILE_PLANES(offset, __size, __version);
+        result = __TILE_PLANES.validate_full (__base);
+        if (result & IRIS_VALIDATION_FAILURE) return result;
+    }
+    
+    offset = LOAD_U64(__ptr + CIPHER_OFFSET);
+    if (offset != NULL_OFFSET) {
+        const auto __CIPHER = CIPHER(offset, __size, __version);
+        result = __CIPHER.validate_full (__base);
+        if (result & IRIS_VALIDATION_FAILURE) return result;
+    }
+    
+    offset = LOAD_U64(__ptr + MIP_TAIL_OFFSET);
+    if (offset != NULL_OFFSET) {
+        const Size tail_size    = LOAD_U64(__ptr + MIP_TAIL_SIZE);
+        const auto tail_layers  = LOAD_U32(__ptr + MIP_TAIL_LAYERS);
+        if (offset > __size || tail_size > __size - offset) return Result
+            (IRIS_FAILURE, "Tile table failed validation -- mip tail ("+
+             std::to_string(offset) + "-" + std::to_string(offset + tail_size) +
+             " bytes) extends beyond the end of the file.");
+        try {
+            const auto table    = read_tile_plane(__base, 0);
+            if (tail_layers < 1 || tail_layers > table.layers.size()) return Result
+                (IRIS_FAILURE, "Tile table failed validation -- mip tail layers ("+
+                 std::to_string(tail_layers) + ") shall be between 1 and the number of slide layers (" +
+                 std::to_string(table.layers.size()) + ").");
+            for (uint32_t LI = 0; LI < tail_layers; ++LI)
+                for (auto&& tile : table.layers[LI]) {
+                    if (tile.offset == NULL_OFFSET) continue;
+                    if (tile.offset < offset || tile.offset + tile.size > offset + tail_size) return Result
+                        (IRIS_FAILURE, "Tile table failed validation -- a tile of mip tail layer " +
+                         std::to_string(LI) + " (" + std::to_string(tile.offset) + "-" +
+                         std::to_string(tile.offset + tile.size) + " bytes) lies outside of the mip tail (" +
+                         std::to_string(offset) + "-" + std::to_string(offset + tail_size) + " bytes).");
+                }
+        } catch (std::runtime_error& error) {
+            return Result (IRIS_FAILURE, error.what());
+        }
+    }
+    
     return IRIS_SUCCESS;
 }
 TileTable TILE_TABLE::read_tile_table(const BYTE *const __base) const
+{
+    return read_tile_plane(__base, 0);
+}
+TileTable TILE_TABLE::read_tile_plane(const BYTE* __base, uint32_t plane) const
 {
 #ifdef __EMSCRIPTEN__
-    const_cast<TILE_TABLE&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
     TileTable tile_table;
     
@@ -1090,24 +2776,40 @@ TileTable TILE_TABLE::read_tile_table(const BYTE *const __base) const
     // Pull the layer extents from the file
     LAYER_EXTENTS EXTENTS       = get_layer_extents(__base);
     tile_table.extent.layers    = EXTENTS.read_layer_extents(__base);
+    tile_table.tileExtents      = EXTENTS.read_tile_extents(__base);
     
     // Then populate the offset array with the tile byte offset info
-    TILE_OFFSETS  OFFSETS       = get_tile_offsets(__base);
+    // of the requested plane only (plane 0 is the primary plane)
+    TILE_OFFSETS  OFFSETS       = get_plane_offsets(__base, plane);
     OFFSETS.read_tile_offsets(__base, tile_table);
-    
+    tile_table.plane            = plane;
     
     if (__version > IRIS_EXTENSION_1_0); else return tile_table;
     
     // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
     // VERSION CONTROL: VERSION 2 PARAMETERS ARE ADDED HERE
     // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
+    if (tile_planes(__base)) {
+        TILE_PLANES PLANES      = get_tile_planes(__base);
+        PLANES.read_planes(__base, tile_table);
+    }
+    if (LOAD_U64(__ptr + MIP_TAIL_OFFSET) != NULL_OFFSET) {
+        auto& tail              = tile_table.mipTail;
+        tail.offset             = LOAD_U64(__ptr + MIP_TAIL_OFFSET);
+        tail.size               = LOAD_U64(__ptr + MIP_TAIL_SIZE);
+        tail.layers             = LOAD_U32(__ptr + MIP_TAIL_LAYERS);
+    }
+    if (cipher(__base)) {
+        CIPHER __CIPHER         = get_cipher(__base);
+        tile_table.cipher       = __CIPHER.read_cipher(__base);
+    }
     
     return tile_table;
 }
-TILE_OFFSETS TILE_TABLE::get_tile_offsets(const BYTE *const __base) const
+TILE_OFFSETS TILE_TABLE::get_tile_offsets(const BYTE* __base) const
 {
 #ifdef __EMSCRIPTEN__
-    const_cast<TILE_TABLE&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
     const auto __TILE_OFFSETS = TILE_OFFSETS
     (LOAD_U64(__base + __offset + TILE_OFFSETS_OFFSET), __size, __version);
@@ -1120,14 +2822,76 @@ TILE_OFFSETS TILE_TABLE::get_tile_offsets(const BYTE *const __base) const
     
     return __TILE_OFFSETS;
 }
-LAYER_EXTENTS TILE_TABLE::get_layer_extents(const BYTE *const __base) const
+bool TILE_TABLE::tile_planes(const BYTE* __base) const
 {
 #ifdef __EMSCRIPTEN__
-    const_cast<TILE_TABLE&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
-    const auto __LAYER_EXTENTS = LAYER_EXTENTS
-    (LOAD_U64(__base + __offset + LAYER_EXTENTS_OFFSET), __size, __version);
-    
+    if (__version > IRIS_EXTENSION_1_0); else return false;
+    auto offset = LOAD_U64(__base + __offset + PLANES_OFFSET);
+    return offset != NULL_OFFSET && offset < __size;
+}
+TILE_PLANES TILE_TABLE::get_tile_planes(const BYTE* __base) const
+{
+#ifdef __EMSCRIPTEN__
+    __base = check_and_fetch_remote(__base);
+#endif
+    if (__version > IRIS_EXTENSION_1_0); else throw std::runtime_error
+        ("Failed to retrieve tile planes array -- tile planes require IFE version 2.0 or later.");
+    const auto __TILE_PLANES = TILE_PLANES
+    (LOAD_U64(__base + __offset + PLANES_OFFSET), __size, __version);
+    
+    const auto result = __TILE_PLANES.validate_offset(__base);
+    if (result & IRIS_VALIDATION_FAILURE) throw std::runtime_error
+        ("Failed to retrieve tile planes array:" + result.message);
+    else if (result & IRIS_WARNING) printf
+        ("Retrieve tile planes array WARNING: %s", result.message.c_str());
+    
+    return __TILE_PLANES;
+}
+bool TILE_TABLE::cipher(const BYTE* __base) const
+{
+#ifdef __EMSCRIPTEN__
+    __base = check_and_fetch_remote(__base);
+#endif
+    if (__version > IRIS_EXTENSION_1_0); else return false;
+    auto offset = LOAD_U64(__base + __offset + CIPHER_OFFSET);
+    return offset != NULL_OFFSET && offset < __size;
+}
+CIPHER TILE_TABLE::get_cipher(const BYTE* __base) const
+{
+#ifdef __EMSCRIPTEN__
+    __base = check_and_fetch_remote(__base);
+#endif
+    if (__version > IRIS_EXTENSION_1_0); else throw std::runtime_error
+        ("Failed to retrieve tile cipher -- tile encryption requires IFE version 2.0 or later.");
+    const auto __CIPHER = CIPHER
+    (LOAD_U64(__base + __offset + CIPHER_OFFSET), __size, __version);
+    
+    const auto result = __CIPHER.validate_offset(__base);
+    if (result & IRIS_VALIDATION_FAILURE) throw std::runtime_error
+        ("Failed to retrieve tile cipher:" + result.message);
+    else if (result & IRIS_WARNING) printf
+        ("Retrieve tile cipher WARNING: %s", result.message.c_str());
+    
+    return __CIPHER;
+}
+TILE_OFFSETS TILE_TABLE::get_plane_offsets(const BYTE *const __base, uint32_t plane) const
+{
+    if (plane == 0) return get_tile_offsets(__base);
+    if (tile_planes(__base) == false) throw std::runtime_error
+        ("Failed to retrieve tile offsets of plane (" + std::to_string(plane) +
+         ") -- the tile table contains a single plane.");
+    return get_tile_planes(__base).get_plane_offsets(__base, plane);
+}
+LAYER_EXTENTS TILE_TABLE::get_layer_extents(const BYTE* __base) const
+{
+#ifdef __EMSCRIPTEN__
+    __base = check_and_fetch_remote(__base);
+#endif
+    const auto __LAYER_EXTENTS = LAYER_EXTENTS
+    (LOAD_U64(__base + __offset + LAYER_EXTENTS_OFFSET), __size, __version);
+    
     const auto result = __LAYER_EXTENTS.validate_offset(__base);
     if (result & IRIS_VALIDATION_FAILURE) throw std::runtime_error
         ("Failed to retrieve layer extents array:" + result.message);
@@ -1137,13 +2901,9 @@ LAYER_EXTENTS TILE_TABLE::get_layer_extents(const BYTE *const __base) const
     return __LAYER_EXTENTS;
 }
 #ifdef __EMSCRIPTEN__
-void TILE_TABLE::check_and_fetch_remote(const BYTE *const &base)
+const BYTE* TILE_TABLE::check_and_fetch_remote (const BYTE* base) const
 {
-    if (!__response) {
-        const char* url = REINTERPRET_ARRAY_START(base);
-        __response      = FETCH_DATABLOCK(url,__remote, HEADER_SIZE);
-        __offset        = __ptr_size;
-    } const_cast<const BYTE*&>(base) = __response->data;
+    return FETCH_REMOTE_HEADER(*this, base);
 }
 #else
 void STORE_TILE_TABLE (BYTE *const __base, const TileTableCreateInfo &__CI)
@@ -1179,6 +2939,31 @@ void STORE_TILE_TABLE (BYTE *const __base, const TileTableCreateInfo &__CI)
         ("Failed STORE_TILE_TABLE header -- Invalid TileTableCreateInfo layerExtentsOffset ("+
          result.message +
          ").\nPer the IFE specification  Section 2.3.2, layer extents shall contain a valid offset to the layer extents array (Section 2.4.2) containing the number of tiles and scale of each layer");
+    
+    if (__CI.planesOffset != NULL_OFFSET) {
+        blk_validation.__offset = __CI.planesOffset;
+        result = static_cast<TILE_PLANES&>(blk_validation).validate_offset(__base);
+        if (result & IRIS_FAILURE) throw std::runtime_error
+            ("Failed STORE_TILE_TABLE header -- Invalid TileTableCreateInfo planesOffset ("+
+             result.message +
+             "). The planes offset shall be NULL_OFFSET or contain a valid offset to the tile planes array.");
+    }
+    
+    if (__CI.cipherOffset != NULL_OFFSET) {
+        blk_validation.__offset = __CI.cipherOffset;
+        result = static_cast<CIPHER&>(blk_validation).validate_full(__base);
+        if (result & IRIS_FAILURE) throw std::runtime_error
+            ("Failed STORE_TILE_TABLE header -- Invalid TileTableCreateInfo cipherOffset ("+
+             result.message +
+             "). The cipher offset shall be NULL_OFFSET or contain a valid offset to the tile cipher parameters.");
+    }
+    
+    if (__CI.mipTailOffset != NULL_OFFSET && (__CI.mipTailLayers < 1 || __CI.mipTailLayers > __CI.layers))
+        throw std::runtime_error
+        ("Failed STORE_TILE_TABLE header -- Invalid TileTableCreateInfo mipTailLayers ("+
+         std::to_string(__CI.mipTailLayers) +
+         "). A mip tail shall contain between 1 and the number of slide layers (" +
+         std::to_string(__CI.layers) + ").");
     #endif
     
     const auto __ptr = __base + __CI.tileTableOffset;
@@ -1186,12 +2971,121 @@ void STORE_TILE_TABLE (BYTE *const __base, const TileTableCreateInfo &__CI)
     STORE_U16   (__ptr + TILE_TABLE::RECOVERY,              RECOVER_TILE_TABLE);
     STORE_U8    (__ptr + TILE_TABLE::ENCODING,              __CI.encoding);
     STORE_U8    (__ptr + TILE_TABLE::FORMAT,                __CI.format);
-    STORE_U64   (__ptr + TILE_TABLE::CIPHER_OFFSET,         NULL_OFFSET);
+    STORE_U64   (__ptr + TILE_TABLE::CIPHER_OFFSET,         __CI.cipherOffset);
     STORE_U64   (__ptr + TILE_TABLE::TILE_OFFSETS_OFFSET,   __CI.tilesOffset);
     STORE_U64   (__ptr + TILE_TABLE::LAYER_EXTENTS_OFFSET,  __CI.layerExtentsOffset);
     STORE_U32   (__ptr + TILE_TABLE::X_EXTENT,              __CI.widthPixels);
     STORE_U32   (__ptr + TILE_TABLE::Y_EXTENT,              __CI.heightPixels);
+    STORE_U64   (__ptr + TILE_TABLE::PLANES_OFFSET,         __CI.planesOffset);
+    STORE_U64   (__ptr + TILE_TABLE::MIP_TAIL_OFFSET,       __CI.mipTailOffset);
+    STORE_U64   (__ptr + TILE_TABLE::MIP_TAIL_SIZE,         __CI.mipTailOffset == NULL_OFFSET ? 0 : __CI.mipTailSize);
+    STORE_U32   (__ptr + TILE_TABLE::MIP_TAIL_LAYERS,       __CI.mipTailOffset == NULL_OFFSET ? 0 : __CI.mipTailLayers);
+}
+#endif
+// MARK: - CIPHER
+CIPHER::CIPHER (Offset offset, Size file_size, uint32_t version) noexcept :
+DATA_BLOCK (offset, file_size, version)
+{
+    
+}
+Size CIPHER::size() const
+{
+    Size size = HEADER_V2_0_SIZE;
+    if (__version > IRIS_EXTENSION_2_0); else return size;
+    
+    // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
+    // VERSION CONTROL: VERSION 3
+    // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
     
+    return size;
+}
+Result CIPHER::validate_offset(const BYTE* __base) const noexcept
+{
+#ifdef __EMSCRIPTEN__
+    __base = check_and_fetch_remote(__base);
+#endif
+    return DATA_BLOCK::validate_offset(__base, type, recovery);
+}
+Result CIPHER::validate_full(const BYTE* __base) const noexcept
+{
+#ifdef __EMSCRIPTEN__
+    __base = check_and_fetch_remote(__base);
+#endif
+    auto result         = validate_offset(__base);
+    if (result & IRIS_FAILURE) return result;
+    
+    const auto __ptr    = __base + __offset;
+    if (__offset + HEADER_V2_0_SIZE > __size) return Result
+        (IRIS_FAILURE, "CIPHER failed validation -- the cipher block extends beyond the end of the file.");
+    
+    const auto algorithm = static_cast<CipherAlgorithm>(LOAD_U8(__ptr + ALGORITHM));
+    if (VALIDATE_CIPHER_ALGORITHM(algorithm) == false) return Result
+        (IRIS_FAILURE, "CIPHER failed validation -- undefined cipher algorithm (" +
+         to_hex_string(static_cast<uint8_t>(algorithm)) + ").");
+    
+    if (__version > IRIS_EXTENSION_2_0); else return result;
+    
+    // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
+    // VERSION CONTROL: VERSION 3+ PARAMETERS ARE ADDED HERE
+    // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
+    
+    return result;
+}
+Cipher CIPHER::read_cipher(const BYTE* __base) const
+{
+#ifdef __EMSCRIPTEN__
+    __base = check_and_fetch_remote(__base);
+#endif
+    if (__offset + HEADER_V2_0_SIZE > __size) throw std::runtime_error
+        ("CIPHER::read_cipher failed -- the cipher block extends beyond the end of the file. Did you validate?");
+    
+    Cipher cipher;
+    const auto __ptr    = __base + __offset;
+    cipher.offset       = __offset;
+    cipher.algorithm    = static_cast<CipherAlgorithm>(LOAD_U8(__ptr + ALGORITHM));
+    if (VALIDATE_CIPHER_ALGORITHM(cipher.algorithm) == false) throw std::runtime_error
+        ("Undefined cipher algorithm (" +
+         to_hex_string(static_cast<uint8_t>(cipher.algorithm)) +
+         ") decoded from tile cipher.");
+    memcpy(cipher.checkNonce.data(), __ptr + CHECK_NONCE, CHECK_NONCE_S);
+    memcpy(cipher.checkTag.data(),   __ptr + CHECK_TAG,   CHECK_TAG_S);
+    
+    if (__version > IRIS_EXTENSION_2_0); else return cipher;
+    
+    // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
+    // VERSION CONTROL: VERSION 3+ PARAMETERS ARE ADDED HERE
+    // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
+    
+    return cipher;
+}
+#ifdef __EMSCRIPTEN__
+const BYTE* CIPHER::check_and_fetch_remote (const BYTE* base) const
+{
+    return FETCH_REMOTE_HEADER(*this, base);
+}
+#else
+Size SIZE_CIPHER ()
+{
+    return CIPHER::HEADER_SIZE;
+}
+void STORE_CIPHER (BYTE *const __base, const CipherCreateInfo& __CI)
+{
+    if (__CI.cipherOffset == NULL_OFFSET) throw std::runtime_error
+        ("Failed STORE_CIPHER -- invalid cipherOffset in CipherCreateInfo.");
+    if (!__CI.key) throw std::runtime_error
+        ("Failed STORE_CIPHER -- no cipher key in CipherCreateInfo.");
+    
+    // Only the key check tag is stored; the key itself never is
+    BYTE nonce [Cipher::NONCE_SIZE], tag [Cipher::TAG_SIZE];
+    IFE::random_bytes   (nonce, Cipher::NONCE_SIZE);
+    CIPHER_CHECK_TAG    (*__CI.key, nonce, tag);
+    
+    auto __ptr  = __base + __CI.cipherOffset;
+    STORE_U64(__ptr + CIPHER::VALIDATION,           __CI.cipherOffset);
+    STORE_U16(__ptr + CIPHER::RECOVERY,             RECOVER_CIPHER);
+    STORE_U8 (__ptr + CIPHER::ALGORITHM,            __CI.key->algorithm);
+    memcpy   (__ptr + CIPHER::CHECK_NONCE,          nonce, CIPHER::CHECK_NONCE_S);
+    memcpy   (__ptr + CIPHER::CHECK_TAG,            tag,   CIPHER::CHECK_TAG_S);
 }
 #endif
 // MARK: - METADATA
@@ -1211,16 +3105,16 @@ Size METADATA::size() const
     
     return size;
 }
-Result METADATA::validate_offset(const BYTE *const __base) const noexcept {
+Result METADATA::validate_offset(const BYTE* __base) const noexcept {
 #ifdef __EMSCRIPTEN__
-    const_cast<METADATA&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
     return DATA_BLOCK::validate_offset(__base, type, recovery);
 }
-Result METADATA::validate_full(const BYTE *const __base) const noexcept
+Result METADATA::validate_full(const BYTE* __base) const noexcept
 {
 #ifdef __EMSCRIPTEN__
-    const_cast<METADATA&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
     auto result = validate_offset(__base);
     if (result & IRIS_FAILURE) return result;
@@ -1249,7 +3143,7 @@ Result METADATA::validate_full(const BYTE *const __base) const noexcept
     
     if (annotations(__base)) {
         auto __ANNOTATIONS = ANNOTATIONS
-        (LOAD_U64(__ptr + IMAGES_OFFSET), __size, __version);
+        (LOAD_U64(__ptr + ANNOTATIONS_OFFSET), __size, __version);
         result = __ANNOTATIONS.validate_full(__base);
         if (result & IRIS_FAILURE) return result;
     }
@@ -1262,10 +3156,10 @@ Result METADATA::validate_full(const BYTE *const __base) const noexcept
     
     return result;
 }
-Metadata METADATA::read_metadata (const BYTE *const __base) const
+Metadata METADATA::read_metadata (const BYTE* __base) const
 {
 #ifdef __EMSCRIPTEN__
-    const_cast<METADATA&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
     Metadata metadata;
     // Validate the offset of this metadata object
@@ -1288,17 +3182,17 @@ Metadata METADATA::read_metadata (const BYTE *const __base) const
     
     return metadata;
 }
-bool METADATA::attributes(const BYTE *const __base) const {
+bool METADATA::attributes(const BYTE* __base) const {
 #ifdef __EMSCRIPTEN__
-    const_cast<METADATA&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
     auto offset = LOAD_U64(__base + __offset + ATTRIBUTES_OFFSET);
     return offset != NULL_OFFSET && offset < __size;
 }
-ATTRIBUTES METADATA::get_attributes(const BYTE *const __base) const
+ATTRIBUTES METADATA::get_attributes(const BYTE* __base) const
 {
 #ifdef __EMSCRIPTEN__
-    const_cast<METADATA&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
     auto __ATTRIBUTES = ATTRIBUTES
     (LOAD_U64(__base + __offset + ATTRIBUTES_OFFSET), __size, __version);
@@ -1311,17 +3205,17 @@ ATTRIBUTES METADATA::get_attributes(const BYTE *const __base) const
     
     return __ATTRIBUTES;
 }
-bool METADATA::image_array(const BYTE *const __base) const {
+bool METADATA::image_array(const BYTE* __base) const {
 #ifdef __EMSCRIPTEN__
-    const_cast<METADATA&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
     auto offset = LOAD_U64(__base + __offset + IMAGES_OFFSET);
     return offset != NULL_OFFSET && offset < __size;
 }
-IMAGE_ARRAY METADATA::get_image_array(const BYTE *const __base) const
+IMAGE_ARRAY METADATA::get_image_array(const BYTE* __base) const
 {
 #ifdef __EMSCRIPTEN__
-    const_cast<METADATA&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
     auto __IMAGES = IMAGE_ARRAY
     (LOAD_U64(__base + __offset + IMAGES_OFFSET), __size, __version);
@@ -1334,17 +3228,17 @@ IMAGE_ARRAY METADATA::get_image_array(const BYTE *const __base) const
     
     return __IMAGES;
 }
-bool METADATA::color_profile(const BYTE *const __base) const {
+bool METADATA::color_profile(const BYTE* __base) const {
 #ifdef __EMSCRIPTEN__
-    const_cast<METADATA&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
     auto offset = LOAD_U64(__base + __offset + ICC_COLOR_OFFSET);
     return offset != NULL_OFFSET && offset < __size;
 }
-ICC_PROFILE METADATA::get_color_profile(const BYTE *const __base) const
+ICC_PROFILE METADATA::get_color_profile(const BYTE* __base) const
 {
 #ifdef __EMSCRIPTEN__
-    const_cast<METADATA&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
     auto __ICC = ICC_PROFILE
     (LOAD_U64(__base + __offset + ICC_COLOR_OFFSET), __size, __version);
@@ -1357,18 +3251,18 @@ ICC_PROFILE METADATA::get_color_profile(const BYTE *const __base) const
     
     return __ICC;
 }
-bool METADATA::annotations(const BYTE *const __base) const
+bool METADATA::annotations(const BYTE* __base) const
 {
 #ifdef __EMSCRIPTEN__
-    const_cast<METADATA&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
     auto offset = LOAD_U64(__base + __offset + ANNOTATIONS_OFFSET);
     return offset != NULL_OFFSET && offset < __size;
 }
-ANNOTATIONS METADATA::get_annotations(const BYTE *const __base) const
+ANNOTATIONS METADATA::get_annotations(const BYTE* __base) const
 {
 #ifdef __EMSCRIPTEN__
-    const_cast<METADATA&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
     auto __ANNOTATIONS = ANNOTATIONS
     (LOAD_U64(__base + __offset + ANNOTATIONS_OFFSET), __size, __version);
@@ -1382,13 +3276,9 @@ ANNOTATIONS METADATA::get_annotations(const BYTE *const __base) const
     return __ANNOTATIONS;
 }
 #ifdef __EMSCRIPTEN__
-void METADATA::check_and_fetch_remote(const BYTE *const &base)
+const BYTE* METADATA::check_and_fetch_remote (const BYTE* base) const
 {
-    if (!__response) {
-        const char* url = REINTERPRET_ARRAY_START(base);
-        __response      = FETCH_DATABLOCK(url,__remote, HEADER_SIZE);
-        __offset        = __ptr_size;
-    } const_cast<const BYTE*&>(base) = __response->data;
+    return FETCH_REMOTE_HEADER(*this, base);
 }
 #else
 void STORE_METADATA (BYTE *const __base, const MetadataCreateInfo &__CI)
@@ -1468,19 +3358,20 @@ Size ATTRIBUTES::size() const
     // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
     // VERSION CONTROL: VERSION 2 VALIDATIONS ARE ADDED HERE
     // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
+    size = HEADER_V2_0_SIZE;
     
     return size;
 }
-Result ATTRIBUTES::validate_offset(const BYTE *const __base) const noexcept {
+Result ATTRIBUTES::validate_offset(const BYTE* __base) const noexcept {
 #ifdef __EMSCRIPTEN__
-    const_cast<ATTRIBUTES&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
     return DATA_BLOCK::validate_offset(__base, type, recovery);
 }
-Result ATTRIBUTES::validate_full(const BYTE *const __base) const noexcept
+Result ATTRIBUTES::validate_full(const BYTE* __base) const noexcept
 {
 #ifdef __EMSCRIPTEN__
-    const_cast<ATTRIBUTES&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
     auto result         = validate_offset(__base);
     if (result & IRIS_FAILURE) return result;
@@ -1498,17 +3389,64 @@ Result ATTRIBUTES::validate_full(const BYTE *const __base) const noexcept
     result = __LENGTHS.validate_full(__base, expected_bytes);
     if (result & IRIS_FAILURE) return result;
     
+    auto compression = TEXT_UNCOMPRESSED;
+    if (__version > IRIS_EXTENSION_1_0) {
+        compression = (TextCompression)LOAD_U8(__ptr + COMPRESSION);
+        if (VALIDATE_TEXT_COMPRESSION(compression) == false) return Result
+            (IRIS_FAILURE, "Undefined attributes compression ("+
+             std::to_string(compression) +
+             ") decoded from attributes header.");
+    }
+    
     const auto __BYTES = ATTRIBUTES_BYTES
     (LOAD_U64(__base + __offset + BYTE_ARRAY_OFFSET),__size, __version);
-    result = __BYTES.validate_full(__base, expected_bytes);
+    result = __BYTES.validate_full(__base, expected_bytes, compression);
     if (result & IRIS_FAILURE) return result;
     
+    if (__version > IRIS_EXTENSION_1_0); else return result;
+    
+    // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
+    // VERSION CONTROL: VERSION 2 VALIDATIONS ARE ADDED HERE
+    // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
+    if (dictionary(__base)) {
+        const auto __DICTIONARY = TEXT_DICTIONARY
+        (LOAD_U64(__ptr + DICTIONARY_OFFSET), __size, __version);
+        result = __DICTIONARY.validate_full(__base);
+        if (result & IRIS_FAILURE) return result;
+    }
+    if (directory(__base)) try {
+        if (compression != TEXT_UNCOMPRESSED) return Result
+            (IRIS_FAILURE, "ATTRIBUTES failed validation -- an attributes directory locates bytes within an uncompressed attributes byte array and shall not accompany compressed attributes.");
+        const auto __DIRECTORY = ATTRIBUTES_DIRECTORY
+        (LOAD_U64(__ptr + DIRECTORY_OFFSET), __size, __version);
+        result = __DIRECTORY.validate_full
+        (__base, __LENGTHS.read_sizes(__base), LOAD_U64(__ptr + BYTE_ARRAY_OFFSET) + ATTRIBUTES_BYTES::HEADER_SIZE);
+        if (result & IRIS_FAILURE) return result;
+    } catch (std::runtime_error& error) {
+        return Result (IRIS_FAILURE, error.what());
+    }
+    // Compressed attributes are decoded in full unless the referenced
+    // dictionary is not registered with this process (warned above).
+    if (compression != TEXT_UNCOMPRESSED) try {
+        TEXT_DICTIONARY::Dictionary __dictionary;
+        if (dictionary(__base)) try {
+            __dictionary = get_dictionary(__base).read_dictionary(__base);
+        } catch (std::runtime_error&) {
+            return result;
+        }
+        Attributes attributes;
+        __BYTES.read_bytes(__base, __LENGTHS.read_sizes(__base), attributes,
+                           compression, __dictionary.get());
+    } catch (std::runtime_error& error) {
+        return Result (IRIS_FAILURE, error.what());
+    }
+    
     return result;
 }
-Attributes ATTRIBUTES::read_attributes(const BYTE *const __base) const
+Attributes ATTRIBUTES::read_attributes(const BYTE* __base) const
 {
 #ifdef __EMSCRIPTEN__
-    const_cast<ATTRIBUTES&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
     Attributes attributes;
     
@@ -1521,24 +3459,33 @@ Attributes ATTRIBUTES::read_attributes(const BYTE *const __base) const
     
     attributes.version      = LOAD_U16(__ptr + ATTRIBUTES::VERSION);
     
+    auto compression        = TEXT_UNCOMPRESSED;
+    TEXT_DICTIONARY::Dictionary __dictionary;
     const auto SIZES        = get_sizes(__base);
     const auto size_array   = SIZES.read_sizes(__base);
-    
     const auto BYTES        = get_bytes(__base);
-    BYTES.read_bytes        (__base, size_array, attributes);
-    
-    if (__version > IRIS_EXTENSION_1_0); else return attributes;
+    if (__version > IRIS_EXTENSION_1_0); else goto READ_BYTES;
     
     // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
     // VERSION CONTROL: VERSION 2+ PARAMETERS ARE ADDED HERE
     // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
+    compression             = (TextCompression)LOAD_U8(__ptr + ATTRIBUTES::COMPRESSION);
+    if (VALIDATE_TEXT_COMPRESSION(compression) == false)
+        throw std::runtime_error ("Undefined attributes compression ("+
+                                  std::to_string(compression) +
+                                  ") decoded from attributes header.");
+    if (compression != TEXT_UNCOMPRESSED && dictionary(__base))
+        __dictionary        = get_dictionary(__base).read_dictionary(__base);
+    
+    READ_BYTES:
+    BYTES.read_bytes        (__base, size_array, attributes, compression, __dictionary.get());
     
     return attributes;
 }
-ATTRIBUTES_SIZES ATTRIBUTES::get_sizes(const BYTE *const __base) const
+ATTRIBUTES_SIZES ATTRIBUTES::get_sizes(const BYTE* __base) const
 {
 #ifdef __EMSCRIPTEN__
-    const_cast<ATTRIBUTES&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
     auto __ATTRIBUTES_SIZES = ATTRIBUTES_SIZES
     (LOAD_U64(__base + __offset + LENGTHS_OFFSET), __size, __version);
@@ -1547,10 +3494,10 @@ ATTRIBUTES_SIZES ATTRIBUTES::get_sizes(const BYTE *const __base) const
     if (result & IRIS_FAILURE) throw std::runtime_error(result.message);
     return __ATTRIBUTES_SIZES;
 }
-ATTRIBUTES_BYTES ATTRIBUTES::get_bytes(const BYTE *const __base) const
+ATTRIBUTES_BYTES ATTRIBUTES::get_bytes(const BYTE* __base) const
 {
 #ifdef __EMSCRIPTEN__
-    const_cast<ATTRIBUTES&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
     auto __ATTRIBUTES_BYTES = ATTRIBUTES_BYTES
     (LOAD_U64(__base + __offset + BYTE_ARRAY_OFFSET), __size, __version);
@@ -1559,14 +3506,123 @@ ATTRIBUTES_BYTES ATTRIBUTES::get_bytes(const BYTE *const __base) const
     if (result & IRIS_FAILURE) throw std::runtime_error(result.message);
     return __ATTRIBUTES_BYTES;
 }
+TextCompression ATTRIBUTES::compression(const BYTE* __base) const
+{
+#ifdef __EMSCRIPTEN__
+    __base = check_and_fetch_remote(__base);
+#endif
+    if (__version > IRIS_EXTENSION_1_0); else return TEXT_UNCOMPRESSED;
+    return (TextCompression)LOAD_U8(__base + __offset + COMPRESSION);
+}
+bool ATTRIBUTES::dictionary(const BYTE* __base) const
+{
+#ifdef __EMSCRIPTEN__
+    __base = check_and_fetch_remote(__base);
+#endif
+    if (__version > IRIS_EXTENSION_1_0); else return false;
+    auto offset = LOAD_U64(__base + __offset + DICTIONARY_OFFSET);
+    return offset != NULL_OFFSET && offset < __size;
+}
+bool ATTRIBUTES::directory(const BYTE* __base) const
+{
+#ifdef __EMSCRIPTEN__
+    __base = check_and_fetch_remote(__base);
+#endif
+    if (__version > IRIS_EXTENSION_1_0); else return false;
+    auto offset = LOAD_U64(__base + __offset + DIRECTORY_OFFSET);
+    return offset != NULL_OFFSET && offset < __size;
+}
+ATTRIBUTES_DIRECTORY ATTRIBUTES::get_directory(const BYTE* __base) const
+{
+#ifdef __EMSCRIPTEN__
+    __base = check_and_fetch_remote(__base);
+#endif
+    if (directory(__base) == false) throw std::runtime_error
+        ("Invalid offset value for ATTRIBUTES_DIRECTORY. The attributes do not contain a directory.");
+    auto __DIRECTORY = ATTRIBUTES_DIRECTORY
+    (LOAD_U64(__base + __offset + DIRECTORY_OFFSET), __size, __version);
+    
+    auto result = __DIRECTORY.validate_offset(__base);
+    if (result & IRIS_FAILURE) throw std::runtime_error(result.message);
+    return __DIRECTORY;
+}
+AttributeDirectory ATTRIBUTES::read_directory(const BYTE* __base) const
+{
+#ifdef __EMSCRIPTEN__
+    __base = check_and_fetch_remote(__base);
+#endif
+    if (LOAD_U8(__base + __offset + COMPRESSION) != TEXT_UNCOMPRESSED) throw std::runtime_error
+        ("Failed ATTRIBUTES::read_directory -- the attributes byte array is compressed and cannot be directly addressed.");
+    const Offset bytes = LOAD_U64(__base + __offset + BYTE_ARRAY_OFFSET);
+    return get_directory(__base).read_directory(__base, bytes + ATTRIBUTES_BYTES::HEADER_SIZE);
+}
+Attributes ATTRIBUTES::read_attributes(const BYTE* __base, const std::vector<std::string> &keys) const
+{
+#ifdef __EMSCRIPTEN__
+    __base = check_and_fetch_remote(__base);
+#endif
+    if (directory(__base) == false) throw std::runtime_error
+        ("Failed ATTRIBUTES::read_attributes -- the attributes do not contain a directory; read the full attributes instead.");
+    
+    Attributes attributes;
+    const auto  __ptr       = __base + __offset;
+    attributes.type         = (MetadataType)LOAD_U8(__ptr + ATTRIBUTES::FORMAT);
+    if (VALIDATE_METADATA_TYPE(attributes.type, __version) == false)
+        throw std::runtime_error ("Undefined attributes encoding format ("+
+                                  std::to_string(attributes.type) +
+                                  ") decoded from attributes table.");
+    attributes.version      = LOAD_U16(__ptr + ATTRIBUTES::VERSION);
+    
+    const auto directory    = read_directory(__base);
+    for (auto&& key : keys) {
+        const auto [first, last] = directory.find(key);
+        for (auto entry = first; entry != last; ++entry) {
+            if (entry->keySize != key.size()) continue;
+            // Keys and values are adjacent when written by STORE_ATTRIBUTES_BYTES;
+            // the smallest range spanning both is read (or fetched) at once.
+            const Size  start   = std::min<Size>(entry->keyOffset, entry->valueOffset);
+            const Size  end     = std::max<Size>(Size(entry->keyOffset) + entry->keySize,
+                                                 Size(entry->valueOffset) + entry->valueSize);
+#ifndef __EMSCRIPTEN__
+            if (directory.bytes + end > __size) throw std::runtime_error
+                ("Failed ATTRIBUTES::read_attributes -- attribute bytes (" +
+                 std::to_string(directory.bytes + start) + "-" +
+                 std::to_string(directory.bytes + end) +
+                 ") extend beyond the end of the file.");
+            const BYTE* __range = __base + directory.bytes + start;
+#else
+            const auto response = FETCH_DATABLOCK
+            (REINTERPRET_ARRAY_START(__base), directory.bytes + start, end - start);
+            if (!response) throw std::runtime_error
+                ("Failed ATTRIBUTES::read_attributes -- could not fetch attribute \"" + key + "\"");
+            const BYTE* __range = response->data + __ptr_size;
+#endif
+            if (memcmp(__range + (entry->keyOffset - start), key.data(), key.size())) continue;
+            attributes[key] = std::u8string
+            ((const char8_t*)__range + (entry->valueOffset - start), entry->valueSize);
+            break;
+        }
+    }
+    return attributes;
+}
+TEXT_DICTIONARY ATTRIBUTES::get_dictionary(const BYTE* __base) const
+{
+#ifdef __EMSCRIPTEN__
+    __base = check_and_fetch_remote(__base);
+#endif
+    if (dictionary(__base) == false) throw std::runtime_error
+        ("Invalid offset value for TEXT_DICTIONARY. The attributes do not reference a text dictionary.");
+    auto __DICTIONARY = TEXT_DICTIONARY
+    (LOAD_U64(__base + __offset + DICTIONARY_OFFSET), __size, __version);
+    
+    auto result = __DICTIONARY.validate_offset(__base);
+    if (result & IRIS_FAILURE) throw std::runtime_error(result.message);
+    return __DICTIONARY;
+}
 #ifdef __EMSCRIPTEN__
-void ATTRIBUTES::check_and_fetch_remote(const BYTE *const &base)
+const BYTE* ATTRIBUTES::check_and_fetch_remote (const BYTE* base) const
 {
-    if (!__response) {
-        const char* url = REINTERPRET_ARRAY_START(base);
-        __response      = FETCH_DATABLOCK(url,__remote, HEADER_SIZE);
-        __offset        = __ptr_size;
-    } const_cast<const BYTE*&>(base) = __response->data;
+    return FETCH_REMOTE_HEADER(*this, base);
 }
 #else
 void STORE_ATTRIBUTES (BYTE *const __base, const AttributesCreateInfo &info)
@@ -1596,6 +3652,25 @@ void STORE_ATTRIBUTES (BYTE *const __base, const AttributesCreateInfo &info)
         ("Failed STORE_ATTRIBUTES -- " +
          result.message +
          ". Per the IFE specification section 2.3.5, the attributes bytes offset shall encode a valid offset to the attributes byte array (Section 2.4.5)");
+    
+    if (VALIDATE_TEXT_COMPRESSION(info.compression) == false) throw std::runtime_error
+        ("failed to store metadata attributes -- undefined text compression");
+    if (info.directory != NULL_OFFSET) {
+        if (info.compression != TEXT_UNCOMPRESSED) throw std::runtime_error
+            ("Failed STORE_ATTRIBUTES -- an attributes directory shall not accompany compressed attributes.");
+        blk_validation.__offset = info.directory;
+        result = static_cast<ATTRIBUTES_DIRECTORY&>(blk_validation).validate_offset(__base);
+        if (result & IRIS_FAILURE) throw std::runtime_error
+            ("Failed STORE_ATTRIBUTES -- Invalid attributes directory offset (" +
+             result.message + ")");
+    }
+    if (info.dictionary != NULL_OFFSET) {
+        blk_validation.__offset = info.dictionary;
+        result = static_cast<TEXT_DICTIONARY&>(blk_validation).validate_offset(__base);
+        if (result & IRIS_FAILURE) throw std::runtime_error
+            ("Failed STORE_ATTRIBUTES -- Invalid text dictionary offset (" +
+             result.message + ")");
+    }
     #endif
     
     const auto __ptr = __base + info.attributesOffset;
@@ -1605,19 +3680,136 @@ void STORE_ATTRIBUTES (BYTE *const __base, const AttributesCreateInfo &info)
     STORE_U16(__ptr + ATTRIBUTES::VERSION,              info.version);
     STORE_U64(__ptr + ATTRIBUTES::LENGTHS_OFFSET,       info.sizes);
     STORE_U64(__ptr + ATTRIBUTES::BYTE_ARRAY_OFFSET,    info.bytes);
+    STORE_U8 (__ptr + ATTRIBUTES::COMPRESSION,          info.compression);
+    STORE_U64(__ptr + ATTRIBUTES::DICTIONARY_OFFSET,    info.dictionary);
+    STORE_U64(__ptr + ATTRIBUTES::DIRECTORY_OFFSET,     info.directory);
 }
 #endif
 
+// MARK: - TEXT DICTIONARY
+TEXT_DICTIONARY::TEXT_DICTIONARY  (Offset offset, Size file_size, uint32_t version) noexcept :
+DATA_BLOCK(offset, file_size, version)
+{
+    
+}
+Size TEXT_DICTIONARY::size(const BYTE* __base) const
+{
+#ifdef __EMSCRIPTEN__
+    __base = check_and_fetch_remote(__base);
+#endif
+    return HEADER_V2_0_SIZE + LOAD_U32(__base + __offset + ENTRY_NUMBER);
+}
+Result TEXT_DICTIONARY::validate_offset(const BYTE* __base) const noexcept {
+#ifdef __EMSCRIPTEN__
+    __base = check_and_fetch_remote(__base);
+#endif
+    return DATA_BLOCK::validate_offset(__base, type, recovery);
+}
+Result TEXT_DICTIONARY::validate_full(const BYTE* __base) const noexcept
+{
+#ifdef __EMSCRIPTEN__
+    __base = check_and_fetch_remote(__base);
+#endif
+    auto result         = validate_offset(__base);
+    if (result & IRIS_FAILURE) return result;
+    
+    const auto __ptr    = __base + __offset;
+    const auto BYTES    = LOAD_U32(__ptr + ENTRY_NUMBER);
+    const auto ID       = LOAD_U32(__ptr + IDENTIFIER);
+    if (BYTES == 0 && ID == 0) return Result
+        (IRIS_FAILURE, "TEXT_DICTIONARY failed validation -- the dictionary neither embeds its bytes nor references a registered dictionary identifier. A referenced dictionary shall have a non-zero identifier.");
+    if (BYTES > TextDictionary::MAX_SIZE) return Result
+        (IRIS_FAILURE, "TEXT_DICTIONARY failed validation -- dictionary size (" +
+         std::to_string(BYTES) + " bytes) exceeds the maximum dictionary size (" +
+         std::to_string(TextDictionary::MAX_SIZE) + " bytes).");
+    if (__offset + HEADER_V2_0_SIZE + BYTES > __size) return Result
+        (IRIS_FAILURE, "TEXT_DICTIONARY failed validation -- dictionary bytes (location " +
+         std::to_string(__offset) + " - " +
+         std::to_string(__offset + HEADER_V2_0_SIZE + BYTES) +
+         ") extend beyond the end of the file.");
+    if (BYTES && TEXT_DICTIONARY_CHECKSUM(__ptr + HEADER_V2_0_SIZE, BYTES) != LOAD_U64(__ptr + CHECKSUM)) return Result
+        (IRIS_FAILURE, "TEXT_DICTIONARY failed validation -- the embedded dictionary bytes do not match the dictionary checksum.");
+    if (BYTES == 0) {
+        const auto dictionary = FIND_TEXT_DICTIONARY(ID);
+        if (!dictionary) printf
+            ("TEXT_DICTIONARY WARNING: referenced text dictionary (identifier %u) is not registered; compressed text blocks cannot be decoded until it is registered (see register_text_dictionary).\n", ID);
+        else if (TEXT_DICTIONARY_CHECKSUM(reinterpret_cast<const BYTE*>(dictionary->bytes.data()), dictionary->bytes.size()) !=
+                 LOAD_U64(__ptr + CHECKSUM)) return Result
+            (IRIS_FAILURE, "TEXT_DICTIONARY failed validation -- the registered text dictionary (identifier " +
+             std::to_string(ID) + ") is not the dictionary used to write the file (checksum mismatch).");
+    }
+    
+    return result;
+}
+TEXT_DICTIONARY::Dictionary TEXT_DICTIONARY::read_dictionary(const BYTE* __base) const
+{
+#ifdef __EMSCRIPTEN__
+    __base = check_and_fetch_remote(__base);
+#endif
+    const auto __ptr    = __base + __offset;
+    const auto BYTES    = LOAD_U32(__ptr + ENTRY_NUMBER);
+    const auto ID       = LOAD_U32(__ptr + IDENTIFIER);
+    if (BYTES == 0) {
+        auto dictionary = FIND_TEXT_DICTIONARY(ID);
+        if (!dictionary) throw std::runtime_error
+            ("Failed TEXT_DICTIONARY::read_dictionary -- the file references text dictionary (identifier " +
+             std::to_string(ID) + ") which has not been registered (see register_text_dictionary).");
+        if (TEXT_DICTIONARY_CHECKSUM(reinterpret_cast<const BYTE*>(dictionary->bytes.data()), dictionary->bytes.size()) !=
+            LOAD_U64(__ptr + CHECKSUM)) throw std::runtime_error
+            ("Failed TEXT_DICTIONARY::read_dictionary -- the registered text dictionary (identifier " +
+             std::to_string(ID) + ") is not the dictionary used to write the file (checksum mismatch).");
+        return dictionary;
+    }
+    if (BYTES > TextDictionary::MAX_SIZE || __offset + HEADER_V2_0_SIZE + BYTES > __size) throw std::runtime_error
+        ("Failed TEXT_DICTIONARY::read_dictionary -- dictionary bytes (" +
+         std::to_string(BYTES) + " bytes) are out of bounds. Did you validate?");
+    auto dictionary         = std::make_shared<TextDictionary>();
+    dictionary->identifier  = ID;
+    dictionary->bytes.assign(reinterpret_cast<const char*>(__ptr + HEADER_V2_0_SIZE), BYTES);
+    return dictionary;
+}
+#ifdef __EMSCRIPTEN__
+const BYTE* TEXT_DICTIONARY::check_and_fetch_remote (const BYTE* base) const
+{
+    return FETCH_REMOTE_BLOCK(*this, base);
+}
+#else
+Size SIZE_TEXT_DICTIONARY (const TextDictionary& dictionary, bool embed)
+{
+    return TEXT_DICTIONARY::HEADER_SIZE + (embed ? dictionary.bytes.size() : 0);
+}
+void STORE_TEXT_DICTIONARY (BYTE *const __base, Offset offset, const TextDictionary& dictionary, bool embed)
+{
+    if (offset == NULL_OFFSET) throw std::runtime_error
+        ("Failed to store text dictionary -- NULL_OFFSET provided as location");
+    if (dictionary.bytes.size() > TextDictionary::MAX_SIZE) throw std::runtime_error
+        ("Failed to store text dictionary -- dictionary size (" +
+         std::to_string(dictionary.bytes.size()) + " bytes) exceeds the maximum dictionary size (" +
+         std::to_string(TextDictionary::MAX_SIZE) + " bytes).");
+    if ((embed == false || dictionary.bytes.empty()) && dictionary.identifier == 0) throw std::runtime_error
+        ("Failed to store text dictionary -- a dictionary that is not embedded shall be referenced by a non-zero registered identifier.");
+    
+    const Size bytes = embed ? dictionary.bytes.size() : 0;
+    auto __ptr = __base + offset;
+    STORE_U64(__ptr + TEXT_DICTIONARY::VALIDATION,      offset);
+    STORE_U16(__ptr + TEXT_DICTIONARY::RECOVERY,        RECOVER_TEXT_DICTIONARY);
+    STORE_U32(__ptr + TEXT_DICTIONARY::ENTRY_NUMBER,    U32_CAST(bytes));
+    STORE_U32(__ptr + TEXT_DICTIONARY::IDENTIFIER,      dictionary.identifier);
+    STORE_U64(__ptr + TEXT_DICTIONARY::CHECKSUM,        TEXT_DICTIONARY_CHECKSUM
+              (reinterpret_cast<const BYTE*>(dictionary.bytes.data()), dictionary.bytes.size()));
+    if (bytes) memcpy(__ptr + TEXT_DICTIONARY::HEADER_SIZE, dictionary.bytes.data(), bytes);
+}
+#endif
 // MARK: - LAYER EXTENT
 LAYER_EXTENTS::LAYER_EXTENTS (Offset __TileTable_Offset, Size file_size, uint32_t version) noexcept :
 DATA_BLOCK(__TileTable_Offset, file_size, version)
 {
     
 }
-Size LAYER_EXTENTS::size (const BYTE *const __base) const
+Size LAYER_EXTENTS::size (const BYTE* __base) const
 {
 #ifdef __EMSCRIPTEN__
-    const_cast<LAYER_EXTENTS&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
     const auto __ptr    = __base + __offset;
     auto STEP           = LOAD_U16(__ptr + ENTRY_SIZE);
@@ -1632,16 +3824,42 @@ Size LAYER_EXTENTS::size (const BYTE *const __base) const
     
     return size;
 }
-Result LAYER_EXTENTS::validate_offset(const BYTE *const __base) const noexcept {
+Result LAYER_EXTENTS::validate_offset(const BYTE* __base) const noexcept {
 #ifdef __EMSCRIPTEN__
-    const_cast<LAYER_EXTENTS&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
     return DATA_BLOCK::validate_offset(__base, type, recovery);
 }
-Result LAYER_EXTENTS::validate_full(const BYTE *const __base) const noexcept
+// Per-entry rules of a layer extents array; shared with the streaming validator
+inline Result VALIDATE_LAYER_EXTENT_ENTRIES (const BYTE* __array, uint16_t STEP, uint32_t ENTRIES, uint32_t __version) noexcept
+{
+    float prior_scale   = 0.f;
+    for (uint32_t LI = 0; LI < ENTRIES; ++LI, __array+=STEP) {
+        if (LOAD_U32(__array + LAYER_EXTENT::X_TILES) < 1) return Result
+            (IRIS_FAILURE,"LAYER_EXTENTS ["+std::to_string(LI)+"] failed validation. Per the IFE specifciation Section 2.4.1, the X-tiles shall encode the number of tiles in the horizontal direction and shall be greater than zero");
+        if (LOAD_U32(__array + LAYER_EXTENT::Y_TILES) < 1) return Result
+            (IRIS_FAILURE,"LAYER_EXTENTS ["+std::to_string(LI)+"] failed validation. Per the IFE specifciation Section 2.4.1, the Y-tiles shall encode the number of tiles in the vertical direction and shall be greater than zero");
+        if (!(LOAD_F32(__array + LAYER_EXTENT::SCALE) > prior_scale)) return Result
+            (IRIS_FAILURE,"LAYER_EXTENTS ["+std::to_string(LI)+"] failed validation. Per the IFE specifciation Section 2.4.1, the scale of a layer shall have a value greater than zero (0.f) and any subsequent layer shall have a scale that is greater than the previous scale");
+        prior_scale = LOAD_F32(__array + LAYER_EXTENT::SCALE);
+        
+        if (__version > IRIS_EXTENSION_1_0); else continue;
+        
+        // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
+        // VERSION CONTROL: VERSION 2 LAYER_extent (no S) PARAMETERS
+        // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
+        // Entries written prior to the tile extents use standard tiles
+        if (STEP < LAYER_EXTENT::V2_0_SIZE) continue;
+        if (LOAD_U16(__array + LAYER_EXTENT::TILE_WIDTH) < 1 ||
+            LOAD_U16(__array + LAYER_EXTENT::TILE_HEIGHT) < 1) return Result
+            (IRIS_FAILURE,"LAYER_EXTENTS ["+std::to_string(LI)+"] failed validation. The tile width and tile height of a layer shall be greater than zero");
+    }
+    return IRIS_SUCCESS;
+}
+Result LAYER_EXTENTS::validate_full(const BYTE* __base) const noexcept
 {
 #ifdef __EMSCRIPTEN__
-    const_cast<LAYER_EXTENTS&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
     auto result         = validate_offset(__base);
     if (result != IRIS_SUCCESS) return result;
@@ -1665,29 +3883,12 @@ Result LAYER_EXTENTS::validate_full(const BYTE *const __base) const noexcept
          std::to_string(start + ENTRIES*STEP)+
          "bytes) extends beyond the end of the file.");
     
-    const BYTE* __array       = __base + start;
-    float prior_scale   = 0.f;
-    for (int LI = 0; LI < ENTRIES; ++LI, __array+=STEP) {
-        if (LOAD_U32(__array + LAYER_EXTENT::X_TILES) < 1) return Result
-            (IRIS_FAILURE,"LAYER_EXTENTS ["+std::to_string(LI)+"] failed validation. Per the IFE specifciation Section 2.4.1, the X-tiles shall encode the number of 256 pixel tiles in the horizontal direction and shall be greater than zero");
-        if (LOAD_U32(__array + LAYER_EXTENT::Y_TILES) < 1) return Result
-            (IRIS_FAILURE,"LAYER_EXTENTS ["+std::to_string(LI)+"] failed validation. Per the IFE specifciation Section 2.4.1, the Y-tiles shall encode the number of 256 pixel tiles in the vertical direction and shall be greater than zero");
-        if (!(LOAD_F32(__array + LAYER_EXTENT::SCALE) > prior_scale)) return Result
-            (IRIS_FAILURE,"LAYER_EXTENTS ["+std::to_string(LI)+"] failed validation. Per the IFE specifciation Section 2.4.1, the scale of a layer shall have a value greater than zero (0.f) and any subsequent layer shall have a scale that is greater than the previous scale");
-        prior_scale = LOAD_F32(__array + LAYER_EXTENT::SCALE);
-        
-        if (__version > IRIS_EXTENSION_1_0); else continue;
-        
-        // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
-        // VERSION CONTROL: VERSION 2 LAYER_extent (no S) PARAMETERS
-        // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
-    }
-    return IRIS_SUCCESS;
+    return VALIDATE_LAYER_EXTENT_ENTRIES (__base + start, STEP, ENTRIES, __version);
 }
-LayerExtents LAYER_EXTENTS::read_layer_extents(const BYTE *const __base) const
+LayerExtents LAYER_EXTENTS::read_layer_extents(const BYTE* __base) const
 {
 #ifdef __EMSCRIPTEN__
-    const_cast<LAYER_EXTENTS&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
     const auto __ptr    = __base + __offset;
     const auto STEP     = LOAD_U16(__ptr + ENTRY_SIZE);
@@ -1730,43 +3931,87 @@ LayerExtents LAYER_EXTENTS::read_layer_extents(const BYTE *const __base) const
     
     return extents;
 }
+TileExtents LAYER_EXTENTS::read_tile_extents(const BYTE* __base) const
+{
+#ifdef __EMSCRIPTEN__
+    __base = check_and_fetch_remote(__base);
+#endif
+    const auto __ptr    = __base + __offset;
+    const auto STEP     = LOAD_U16(__ptr + ENTRY_SIZE);
+    const auto ENTRIES  = LOAD_U32(__ptr + ENTRY_NUMBER);
+    
+    // Version 1 layers are composed of standard 256 pixel tiles
+    TileExtents extents (ENTRIES);
+    if (__version > IRIS_EXTENSION_1_0); else return extents;
+    
+    // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
+    // VERSION CONTROL: VERSION 2 LAYER_extent (no S) PARAMETERS
+    // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
+    if (STEP < LAYER_EXTENT::V2_0_SIZE) return extents;
+    
+    Offset start        = __offset + HEADER_V1_0_SIZE;
+    if (start + ENTRIES*STEP > __size)
+        throw std::runtime_error
+        ("LAYER_EXTENTS::read_tile_extents failed -- bytes block ("+
+         std::to_string(start) + "-" +
+         std::to_string(start + ENTRIES*STEP)+
+         "bytes) extends beyond the end of the file.");
+    
+    const BYTE* __array = __base + start;
+    for (uint32_t LI = 0; LI < ENTRIES; ++LI, __array+=STEP) {
+        auto& extent    = extents[LI];
+        extent.width    = LOAD_U16(__array + LAYER_EXTENT::TILE_WIDTH);
+        extent.height   = LOAD_U16(__array + LAYER_EXTENT::TILE_HEIGHT);
+        if (extent.width < 1 || extent.height < 1)
+            throw std::runtime_error
+            ("LAYER_EXTENTS::read_tile_extents failed -- layer (" +
+             std::to_string(LI) + ") encodes a zero tile dimension.");
+    }
+    return extents;
+}
 #ifdef __EMSCRIPTEN__
-void LAYER_EXTENTS::check_and_fetch_remote(const BYTE *const &base)
+const BYTE* LAYER_EXTENTS::check_and_fetch_remote (const BYTE* base) const
 {
-    if (!__response) {
-        const char* url = REINTERPRET_ARRAY_START(base);
-        __response      = FETCH_DATABLOCK(url,__remote, HEADER_SIZE);
-        __offset        = __ptr_size;
-        __response      = FETCH_DATABLOCK(url, __remote, size(base));
-    } const_cast<const BYTE*&>(base) = __response->data;
+    return FETCH_REMOTE_BLOCK(*this, base);
 }
 #else
-inline Size STORE_EXTENT (BYTE* const __base, Offset offset, const LayerExtent &extent)
+inline Size STORE_EXTENT (BYTE* const __base, Offset offset, const LayerExtent &extent, const TileExtent& tile)
 {
     using __LE = LAYER_EXTENT;
     STORE_U32(__base + offset + __LE::X_TILES, extent.xTiles);
     STORE_U32(__base + offset + __LE::Y_TILES, extent.yTiles);
     STORE_F32(__base + offset + __LE::SCALE,   extent.scale);
+    STORE_U16(__base + offset + __LE::TILE_WIDTH,  tile.width);
+    STORE_U16(__base + offset + __LE::TILE_HEIGHT, tile.height);
     return LAYER_EXTENT::SIZE;
 }
 Size SIZE_EXTENTS (const LayerExtents &__extents)
 {
     return LAYER_EXTENTS::HEADER_SIZE + __extents.size() * LAYER_EXTENT::SIZE;
 }
-void STORE_EXTENTS(BYTE *const __base, Offset offset, const LayerExtents &extents)
+void STORE_EXTENTS(BYTE *const __base, Offset offset, const LayerExtents &extents, const TileExtents& tiles)
 {
     if (extents.size() > UINT32_MAX) throw std::runtime_error
         ("Failed to store layer extent sizes -- extents array length ("+
          std::to_string(extents.size())+
          ") exceeds 32-bit size limit. Per the IFE specification Section 2.4.1, the number of layers shall be less than the 32-bit max value.");
+    if (tiles.size() && tiles.size() != extents.size()) throw std::runtime_error
+        ("Failed to store layer extent sizes -- tile extents array length ("+
+         std::to_string(tiles.size())+
+         ") does not match the number of layers ("+
+         std::to_string(extents.size())+
+         "). Provide the tile dimensions of every layer or of none.");
+    for (auto&& tile : tiles)
+        if (tile.width < 1 || tile.height < 1) throw std::runtime_error
+            ("Failed to store layer extent sizes -- tile extents shall have a width and height greater than zero.");
     
     STORE_U64 (__base + offset + LAYER_EXTENTS::VALIDATION, offset);
     STORE_U16 (__base + offset + LAYER_EXTENTS::RECOVERY,   RECOVER_LAYER_EXTENTS);
     STORE_U16 (__base + offset + LAYER_EXTENTS::ENTRY_SIZE, LAYER_EXTENT::SIZE);
     STORE_U32 (__base + offset + LAYER_EXTENTS::ENTRY_NUMBER, U32_CAST(extents.size()));
     offset      += LAYER_EXTENTS::HEADER_SIZE;
-    for (auto&& layer : extents) {
-        STORE_EXTENT(__base, offset, layer);
+    for (size_t LI = 0; LI < extents.size(); ++LI) {
+        STORE_EXTENT(__base, offset, extents[LI], tiles.size() ? tiles[LI] : TileExtent());
         offset += LAYER_EXTENT::SIZE;
     }
 }
@@ -1777,10 +4022,10 @@ DATA_BLOCK(offset, file_size, version)
 {
     
 }
-Size TILE_OFFSETS::size(const BYTE *const __base) const
+Size TILE_OFFSETS::size(const BYTE* __base) const
 {
 #ifdef __EMSCRIPTEN__
-    const_cast<TILE_OFFSETS&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
     const auto __ptr    = __base + __offset;
     const auto STEP     = LOAD_U16(__ptr + ENTRY_SIZE);
@@ -1792,19 +4037,20 @@ Size TILE_OFFSETS::size(const BYTE *const __base) const
     // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
     // VERSION CONTROL: VERSION 2 VALIDATIONS ARE ADDED HERE
     // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
+    size               += BASE_OFFSETS_OFFSET_S;
     
     return size;
 }
-Result TILE_OFFSETS::validate_offset(const BYTE *const __base) const noexcept {
+Result TILE_OFFSETS::validate_offset(const BYTE* __base) const noexcept {
 #ifdef __EMSCRIPTEN__
-    const_cast<TILE_OFFSETS&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
     return DATA_BLOCK::validate_offset(__base, type, recovery);
 }
-Result TILE_OFFSETS::validate_full (const BYTE *const __base) const noexcept
+Result TILE_OFFSETS::validate_full (const BYTE* __base) const noexcept
 {
 #ifdef __EMSCRIPTEN__
-    const_cast<TILE_OFFSETS&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
     auto result         = validate_offset(__base);
     if(result & IRIS_FAILURE) return result;
@@ -1819,6 +4065,28 @@ Result TILE_OFFSETS::validate_full (const BYTE *const __base) const noexcept
     // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
     // VERSION CONTROL: VERSION 2+ PARAMETERS ARE ADDED HERE
     // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
+    start               = __offset + HEADER_V2_0_SIZE;
+    if (auto base = LOAD_U64(__ptr + BASE_OFFSETS_OFFSET); base != NULL_OFFSET) {
+        if (base >= __offset) return Result
+            (IRIS_FAILURE,
+             "TILE_OFFSETS validation failed -- the base tile offsets table (" +
+             std::to_string(base) + ") of a delta table shall precede the delta table (" +
+             std::to_string(__offset) + ").");
+        if (ENTRIES && STEP < TILE_OFFSET_DELTA::SIZE) return Result
+            (IRIS_FAILURE,
+             "TILE_OFFSETS validation failed -- delta entry size (" +
+             std::to_string(STEP) + ") is less than the delta entry size.");
+        const auto __BASE = TILE_OFFSETS(base, __size, __version);
+        try {
+            if (__BASE.get_base_offsets(__base)) return Result
+                (IRIS_FAILURE,
+                 "TILE_OFFSETS validation failed -- the base table of a delta table shall be a complete tile offsets table.");
+        } catch (std::exception& e) {
+            return Result (IRIS_FAILURE, e.what());
+        }
+        result = __BASE.validate_full(__base);
+        if (result & IRIS_FAILURE) return result;
+    }
     
     VALIDATE_TILE_OFFSETS:
     if (start + ENTRIES*STEP > __size) return Result
@@ -1828,9 +4096,11 @@ Result TILE_OFFSETS::validate_full (const BYTE *const __base) const noexcept
          std::to_string(start + ENTRIES*STEP)+
          "bytes) extends beyond the end of the file.");
     
+    // Delta entries share the tile entry layout; sparse (NULL_TILE) entries reference no bytes
     const BYTE* __array = __base + start;
-    for (auto TI = 0; TI < ENTRIES; ++TI, __array+=STEP)
-        if (LOAD_U40(__array + TILE_OFFSET::OFFSET) +
+    for (uint32_t TI = 0; TI < ENTRIES; ++TI, __array+=STEP)
+        if (LOAD_U40(__array + TILE_OFFSET::OFFSET) != NULL_TILE &&
+            LOAD_U40(__array + TILE_OFFSET::OFFSET) +
             LOAD_U24(__array + TILE_OFFSET::TILE_SIZE) > __size) return Result
             (IRIS_FAILURE,
              "TILE_OFFSETS validation failed -- global tile entry (" +
@@ -1841,32 +4111,66 @@ Result TILE_OFFSETS::validate_full (const BYTE *const __base) const noexcept
     
     return IRIS_SUCCESS;
 }
-void TILE_OFFSETS::read_tile_offsets(const BYTE *const __base, TileTable& table) const
+void TILE_OFFSETS::read_tile_offsets(const BYTE* __base, TileTable& table) const
 {
 #ifdef __EMSCRIPTEN__
-    const_cast<TILE_OFFSETS&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
     const auto __ptr    = __base + __offset;
     const auto STEP     = LOAD_U16(__ptr + ENTRY_SIZE);
     const auto ENTRIES  = LOAD_U32(__ptr + ENTRY_NUMBER);
 
-    auto total_tiles = 0;
+    uint32_t total_tiles = 0;
     for (auto&& layer : table.extent.layers)
         total_tiles += layer.xTiles * layer.yTiles;
-    if (total_tiles != ENTRIES) throw std::runtime_error
-        (std::string ("Failed TILE_OFFSETS::read_tile_offsets -- Tile numbers in tile table extents ")+
-         std::to_string(total_tiles)+
-         " does not match total entries in the tile offset array "+
-         std::to_string(ENTRIES));
     
     Offset start        = __offset + HEADER_V1_0_SIZE;
+    const BYTE* __array = nullptr;
     if (__version > IRIS_EXTENSION_1_0); else goto READ_OFFSETS;
 
     // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
     // VERSION CONTROL: VERSION 2+ PARAMETERS ARE ADDED HERE
     // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
+    start               = __offset + HEADER_V2_0_SIZE;
+    if (auto __BASE = get_base_offsets(__base)) {
+        // Delta table: read the complete base table and apply the replaced entries
+        if (__BASE.get_base_offsets(__base)) throw std::runtime_error
+            ("TILE_OFFSETS::read_tile_offsets failed -- the base table of a delta table is itself a delta table.");
+        __BASE.read_tile_offsets(__base, table);
+        if (start + ENTRIES*STEP > __size) throw std::runtime_error
+            ("TILE_OFFSETS::read_tile_offsets failed -- delta bytes block ("+
+             std::to_string(start) + "-" +
+             std::to_string(start + ENTRIES*STEP)+
+             "bytes) extends beyond the end of the file.");
+        if (ENTRIES && STEP < TILE_OFFSET_DELTA::SIZE) throw std::runtime_error
+            ("TILE_OFFSETS::read_tile_offsets failed -- delta entry size ("+
+             std::to_string(STEP) + ") is less than the delta entry size.");
+        __array         = __base + start;
+        for (uint32_t TI = 0; TI < ENTRIES; ++TI, __array+=STEP) {
+            Size  index = LOAD_U32(__array + TILE_OFFSET_DELTA::TILE_INDEX);
+            if (index >= total_tiles) throw std::runtime_error
+                ("TILE_OFFSETS::read_tile_offsets failed -- delta entry replaces tile (" +
+                 std::to_string(index) + ") beyond the tile table extents.");
+            uint32_t LI = 0;
+            while (index >= table.layers[LI].size()) index -= table.layers[LI++].size();
+            auto& tile  = table.layers[LI][index];
+            tile.offset = LOAD_U40(__array + TILE_OFFSET_DELTA::OFFSET);
+            tile.size   = LOAD_U24(__array + TILE_OFFSET_DELTA::TILE_SIZE);
+            if (tile.offset == NULL_TILE) {
+                tile.offset = NULL_OFFSET;
+                tile.size   = 0;
+            } else if (tile.offset + tile.size > __size) throw std::runtime_error
+                ("read_tile_offsets returned tile data offset value out of file bounds.");
+        }
+        return;
+    }
     
     READ_OFFSETS:
+    if (total_tiles != ENTRIES) throw std::runtime_error
+        (std::string ("Failed TILE_OFFSETS::read_tile_offsets -- Tile numbers in tile table extents ")+
+         std::to_string(total_tiles)+
+         " does not match total entries in the tile offset array "+
+         std::to_string(ENTRIES));
     if (start + ENTRIES*STEP > __size)
         throw std::runtime_error
         ("TILE_OFFSETS::read_tile_offsets failed -- bytes block ("+
@@ -1874,7 +4178,7 @@ void TILE_OFFSETS::read_tile_offsets(const BYTE *const __base, TileTable& table)
          std::to_string(start + ENTRIES*STEP)+
          "bytes) extends beyond the end of the file.");
     
-    const BYTE* __array   = __base + start;
+    __array             = __base + start;
     table.layers = TileTable::Layers (table.extent.layers.size());
     for (int LI = 0; LI < table.layers.size(); ++LI) {
         auto& LE        = table.extent.layers[LI];
@@ -1905,42 +4209,531 @@ void TILE_OFFSETS::read_tile_offsets(const BYTE *const __base, TileTable& table)
     }
     return;
 }
+TILE_OFFSETS TILE_OFFSETS::get_base_offsets(const BYTE* __base) const
+{
+#ifdef __EMSCRIPTEN__
+    __base = check_and_fetch_remote(__base);
+#endif
+    if (__version > IRIS_EXTENSION_1_0); else
+        return TILE_OFFSETS(NULL_OFFSET, __size, __version);
+    
+    const auto base     = LOAD_U64(__base + __offset + BASE_OFFSETS_OFFSET);
+    if (base == NULL_OFFSET) return TILE_OFFSETS(NULL_OFFSET, __size, __version);
+    if (base >= __offset) throw std::runtime_error
+        ("Failed to retrieve base tile offset array -- the base table (" +
+         std::to_string(base) + ") does not precede the delta table (" +
+         std::to_string(__offset) + ").");
+    
+    const auto __BASE   = TILE_OFFSETS (base, __size, __version);
+    const auto result   = __BASE.validate_offset(__base);
+    if (result & IRIS_VALIDATION_FAILURE) throw std::runtime_error
+        ("Failed to retrieve base tile offset array:" + result.message);
+    
+    return __BASE;
+}
+#ifdef __EMSCRIPTEN__
+const BYTE* TILE_OFFSETS::check_and_fetch_remote (const BYTE* base) const
+{
+    return FETCH_REMOTE_BLOCK(*this, base);
+}
+#else
+inline void STORE_TILE_OFFSET_ENTRY (BYTE* const __ptr, const TileEntry& tile)
+{
+    if (tile.offset == NULL_OFFSET) {
+        STORE_U40   (__ptr + TILE_OFFSET::OFFSET,     NULL_TILE);
+        STORE_U24   (__ptr + TILE_OFFSET::TILE_SIZE,  0);
+        return;
+    }
+    if (tile.offset > UINT40_MAX) throw std::runtime_error("tile offset above 40-bit numerical limit");
+    if (tile.size   > UINT24_MAX) throw std::runtime_error("tile size above 24-bit numerical limit");
+    STORE_U40   (__ptr + TILE_OFFSET::OFFSET,     tile.offset);
+    STORE_U24   (__ptr + TILE_OFFSET::TILE_SIZE,  tile.size);
+}
+Size SIZE_TILE_OFFSETS (const TileTable::Layers &__offsets)
+{
+    Size size = TILE_OFFSETS::HEADER_SIZE;
+    for (auto&& layer : __offsets)
+        size += layer.size() * TILE_OFFSET::SIZE;
+    return size;
+}
+void STORE_TILE_OFFSETS (BYTE* const __base, Offset offset, const TileTable::Layers &__offsets)
+{
+    uint32_t total_tiles = 0;
+    for (auto&& layer : __offsets) total_tiles += U32_CAST(layer.size());
+    
+    STORE_U64(__base + offset + TILE_OFFSETS::VALIDATION,   offset);
+    STORE_U16(__base + offset + TILE_OFFSETS::RECOVERY,     RECOVER_TILE_OFFSETS);
+    STORE_U16(__base + offset + TILE_OFFSETS::ENTRY_SIZE,   TILE_OFFSET::SIZE);
+    STORE_U32(__base + offset + TILE_OFFSETS::ENTRY_NUMBER, total_tiles);
+    STORE_U64(__base + offset + TILE_OFFSETS::BASE_OFFSETS_OFFSET, NULL_OFFSET);
+    offset += TILE_OFFSETS::HEADER_SIZE;
+    for (auto&& layer : __offsets)
+        for (auto&& tile : layer) {
+            STORE_TILE_OFFSET_ENTRY (__base + offset, tile);
+            offset += TILE_OFFSET::SIZE;
+        }
+}
+// MARK: TILE AMENDMENT
+struct TILE_AMENDMENT {
+    uint32_t            version     = 0;
+    uint32_t            revision    = 0;
+    Offset              repoint     = NULL_OFFSET;  // Location of the amended plane's table offset
+    Offset              baseOffsets = NULL_OFFSET;  // Complete base table of a delta table
+    Offset              tileOffsets = NULL_OFFSET;  // Amended table, following the payloads
+    bool                delta       = false;
+    std::map<uint32_t, TileEntry> entries;          // Replaced entries by global tile index
+    TileTable::Layers   layers;                     // Complete amended table
+    std::vector<TileAmendmentCreateInfo::Tile> payloads; // Appended payloads in file order
+    uint32_t            tailLayers  = 0;            // Repacked mip tail layers; 0 if untouched
+    Size                tailSize    = 0;            // Repacked mip tail, starting at the payloads
+    Size                fileSize    = 0;
+};
+// A non-zero tail_layers repacks the coarsest layers into a new mip tail
+static TILE_AMENDMENT PLAN_TILE_AMENDMENT (const BYTE* const __base, Size __size, const TileAmendmentCreateInfo& __CI,
+                                           uint32_t tail_layers = 0)
+{
+    if (__CI.tiles.empty() && tail_layers == 0) throw std::runtime_error
+        ("Failed STORE_TILE_AMENDMENT -- no replacement tiles provided in TileAmendmentCreateInfo.");
+    
+    TILE_AMENDMENT plan;
+    const auto __FILE_HEADER    = FILE_HEADER(__size);
+    const auto header           = __FILE_HEADER.read_header(__base);
+    const auto __TILE_TABLE     = __FILE_HEADER.get_tile_table(__base);
+    const auto __OFFSETS        = __TILE_TABLE.get_plane_offsets(__base, __CI.plane);
+    const auto __BASE           = __OFFSETS.get_base_offsets(__base);
+    auto table                  = __TILE_TABLE.read_tile_plane(__base, __CI.plane);
+    plan.version                = header.extVersion;
+    plan.revision               = header.revision;
+    plan.repoint                = __TILE_TABLE.__offset + TILE_TABLE::TILE_OFFSETS_OFFSET;
+    if (__CI.plane) {
+        // Additional planes are repointed within the tile planes array
+        const auto __PLANES     = __TILE_TABLE.get_tile_planes(__base);
+        plan.repoint            = __PLANES.__offset + TILE_PLANES::HEADER_V2_0_SIZE +
+                                  Size(__CI.plane) * LOAD_U16(__base + __PLANES.__offset + TILE_PLANES::ENTRY_SIZE) +
+                                  TILE_PLANE::TILE_OFFSETS_OFFSET;
+    }
+    plan.baseOffsets            = __BASE ? __BASE.__offset : __OFFSETS.__offset;
+    
+    // Global (layer-major) index of the first tile of each layer
+    std::vector<uint32_t> first (table.layers.size());
+    uint32_t total_tiles        = 0;
+    for (size_t LI = 0; LI < table.layers.size(); ++LI) {
+        first[LI]               = total_tiles;
+        total_tiles            += U32_CAST(table.layers[LI].size());
+    }
+    
+    // Carry forward the entries already replaced by an existing delta table
+    if (__BASE) {
+        TileTable base;
+        base.extent             = table.extent;
+        __BASE.read_tile_offsets(__base, base);
+        for (size_t LI = 0; LI < table.layers.size(); ++LI)
+            for (size_t TI = 0; TI < table.layers[LI].size(); ++TI) {
+                const auto& tile = table.layers[LI][TI];
+                if (tile.offset != base.layers[LI][TI].offset ||
+                    tile.size   != base.layers[LI][TI].size)
+                    plan.entries[first[LI] + U32_CAST(TI)] = tile;
+            }
+    }
+    
+    for (auto&& tile : __CI.tiles) {
+        if (tile.layer >= table.layers.size()) throw std::runtime_error
+            ("Failed STORE_TILE_AMENDMENT -- replacement tile layer (" + std::to_string(tile.layer) +
+             ") exceeds the slide layers (" + std::to_string(table.layers.size()) + ").");
+        if (tile.tile >= table.layers[tile.layer].size()) throw std::runtime_error
+            ("Failed STORE_TILE_AMENDMENT -- replacement tile (" + std::to_string(tile.tile) +
+             ") exceeds the tiles of layer " + std::to_string(tile.layer) + " (" +
+             std::to_string(table.layers[tile.layer].size()) + ").");
+        if (!tile.data || !tile.size) throw std::runtime_error
+            ("Failed STORE_TILE_AMENDMENT -- replacement tile (layer " + std::to_string(tile.layer) +
+             ", tile " + std::to_string(tile.tile) + ") contains no tile data.");
+        if (tile.size > UINT24_MAX) throw std::runtime_error
+            ("Failed STORE_TILE_AMENDMENT -- tile size above 24-bit numerical limit");
+    }
+    
+    // Replacing a tile of a mip tail layer repacks the whole tail such that
+    // the tail layers remain contiguous. The tail describes the primary plane.
+    if (tail_layers == 0 && __CI.plane == 0 && table.mipTail.layers)
+        for (auto&& tile : __CI.tiles)
+            if (tile.layer < table.mipTail.layers) {
+                tail_layers     = table.mipTail.layers;
+                break;
+            }
+    if (tail_layers && __CI.plane) throw std::runtime_error
+        ("Failed STORE_TILE_AMENDMENT -- the mip tail describes the primary plane (0) only.");
+    if (tail_layers > table.layers.size()) throw std::runtime_error
+        ("Failed STORE_TILE_AMENDMENT -- mip tail layers (" + std::to_string(tail_layers) +
+         ") exceed the slide layers (" + std::to_string(table.layers.size()) + ").");
+    if (tail_layers) {
+        std::map<uint32_t, const TileAmendmentCreateInfo::Tile*> replaced;
+        for (auto&& tile : __CI.tiles)
+            if (tile.layer < tail_layers) replaced[first[tile.layer] + tile.tile] = &tile;
+        for (uint32_t LI = 0; LI < tail_layers; ++LI)
+            for (uint32_t TI = 0; TI < table.layers[LI].size(); ++TI) {
+                const auto  it  = replaced.find(first[LI] + TI);
+                const auto& tile = table.layers[LI][TI];
+                if (it != replaced.end()) plan.payloads.push_back(*it->second);
+                else if (tile.offset != NULL_OFFSET) plan.payloads.push_back
+                    ({LI, TI, __base + tile.offset, tile.size});
+            }
+        for (auto&& payload : plan.payloads) plan.tailSize += payload.size;
+        plan.tailLayers         = tail_layers;
+    }
+    for (auto&& tile : __CI.tiles)
+        if (tile.layer >= tail_layers) plan.payloads.push_back(tile);
+    
+    // Replacement payloads are appended in order; a repeated tile takes the last payload
+    Offset offset               = __size;
+    for (auto&& tile : plan.payloads) {
+        auto& entry             = table.layers[tile.layer][tile.tile];
+        entry.offset            = offset;
+        entry.size              = U32_CAST(tile.size);
+        plan.entries[first[tile.layer] + tile.tile] = entry;
+        offset                 += tile.size;
+    }
+    if (offset > UINT40_MAX) throw std::runtime_error
+        ("Failed STORE_TILE_AMENDMENT -- tile offset above 40-bit numerical limit");
+    
+    // Delta encode while the delta table remains smaller than a complete table
+    const Size header_size      = plan.version > IRIS_EXTENSION_1_0 ?
+                                  TILE_OFFSETS::HEADER_V2_0_SIZE :
+                                  TILE_OFFSETS::HEADER_V1_0_SIZE;
+    const Size complete_size    = header_size + Size(total_tiles) * TILE_OFFSET::SIZE;
+    const Size delta_size       = header_size + plan.entries.size() * TILE_OFFSET_DELTA::SIZE;
+    plan.delta                  = __CI.deltaEncode &&
+                                  plan.version > IRIS_EXTENSION_1_0 &&
+                                  delta_size < complete_size;
+    if (plan.delta == false) plan.layers = std::move(table.layers);
+    plan.tileOffsets            = offset;
+    plan.fileSize               = offset + (plan.delta ? delta_size : complete_size);
+    return plan;
+}
+Size SIZE_TILE_AMENDMENT (const BYTE* const __base, Size __size, const TileAmendmentCreateInfo& __CI)
+{
+    return PLAN_TILE_AMENDMENT(__base, __size, __CI).fileSize - __size;
+}
+static Size STORE_TILE_AMENDMENT (BYTE* const __base, Size __size, const TileAmendmentCreateInfo& __CI,
+                                  uint32_t tail_layers)
+{
+    const auto plan             = PLAN_TILE_AMENDMENT(__base, __size, __CI, tail_layers);
+    
+    // The extended file is immediately valid; the appended bytes remain unreferenced
+    STORE_U64   (__base + FILE_HEADER::FILE_SIZE,           plan.fileSize);
+    
+    Offset offset               = __size;
+    for (auto&& tile : plan.payloads) {
+        memcpy  (__base + offset, tile.data, tile.size);
+        offset += tile.size;
+    }
+    
+    const auto __ptr            = __base + plan.tileOffsets;
+    STORE_U64   (__ptr + TILE_OFFSETS::VALIDATION,          plan.tileOffsets);
+    STORE_U16   (__ptr + TILE_OFFSETS::RECOVERY,            RECOVER_TILE_OFFSETS);
+    if (plan.delta) {
+        STORE_U16   (__ptr + TILE_OFFSETS::ENTRY_SIZE,      TILE_OFFSET_DELTA::SIZE);
+        STORE_U32   (__ptr + TILE_OFFSETS::ENTRY_NUMBER,    U32_CAST(plan.entries.size()));
+        STORE_U64   (__ptr + TILE_OFFSETS::BASE_OFFSETS_OFFSET, plan.baseOffsets);
+        BYTE* __array           = __ptr + TILE_OFFSETS::HEADER_V2_0_SIZE;
+        for (auto&& entry : plan.entries) {
+            STORE_TILE_OFFSET_ENTRY (__array, entry.second);
+            STORE_U32   (__array + TILE_OFFSET_DELTA::TILE_INDEX, entry.first);
+            __array            += TILE_OFFSET_DELTA::SIZE;
+        }
+    } else {
+        uint32_t total_tiles    = 0;
+        for (auto&& layer : plan.layers) total_tiles += U32_CAST(layer.size());
+        STORE_U16   (__ptr + TILE_OFFSETS::ENTRY_SIZE,      TILE_OFFSET::SIZE);
+        STORE_U32   (__ptr + TILE_OFFSETS::ENTRY_NUMBER,    total_tiles);
+        BYTE* __array           = __ptr + TILE_OFFSETS::HEADER_V1_0_SIZE;
+        if (plan.version > IRIS_EXTENSION_1_0) {
+            STORE_U64   (__ptr + TILE_OFFSETS::BASE_OFFSETS_OFFSET, NULL_OFFSET);
+            __array             = __ptr + TILE_OFFSETS::HEADER_V2_0_SIZE;
+        }
+        for (auto&& layer : plan.layers)
+            for (auto&& tile : layer) {
+                STORE_TILE_OFFSET_ENTRY (__array, tile);
+                __array        += TILE_OFFSET::SIZE;
+            }
+    }
+    if (__CI.barrier) __CI.barrier();
+    
+    // A repacked tail is cleared ahead of the repoint and restored after it;
+    // the table is valid without a tail at every intermediate state.
+    const auto __TABLE          = __base + FILE_HEADER(plan.fileSize).get_tile_table(__base).__offset;
+    if (plan.tailLayers) {
+        STORE_U64   (__TABLE + TILE_TABLE::MIP_TAIL_OFFSET,     NULL_OFFSET);
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+    
+    // Commit the amendment by repointing the tile table (or plane)
+    std::atomic_thread_fence    (std::memory_order_release);
+    STORE_U64   (__base + plan.repoint,                     plan.tileOffsets);
+    std::atomic_thread_fence    (std::memory_order_release);
+    
+    if (plan.tailLayers) {
+        STORE_U64   (__TABLE + TILE_TABLE::MIP_TAIL_SIZE,       plan.tailSize);
+        STORE_U32   (__TABLE + TILE_TABLE::MIP_TAIL_LAYERS,     plan.tailLayers);
+        std::atomic_thread_fence(std::memory_order_release);
+        STORE_U64   (__TABLE + TILE_TABLE::MIP_TAIL_OFFSET,     __size);
+    }
+    
+    if (plan.version > IRIS_EXTENSION_1_0 &&
+        (LOAD_U64(__base + FILE_HEADER::FINGERPRINT_LOW) ||
+         LOAD_U64(__base + FILE_HEADER::FINGERPRINT_HIGH))) {
+        const auto fingerprint  = GENERATE_FINGERPRINT
+        (__base, plan.fileSize, FILE_HEADER(plan.fileSize).get_tile_table(__base), Fingerprint::SAMPLES);
+        STORE_U64   (__base + FILE_HEADER::FINGERPRINT_LOW,     fingerprint.low);
+        STORE_U64   (__base + FILE_HEADER::FINGERPRINT_HIGH,    fingerprint.high);
+    }
+    STORE_U32   (__base + FILE_HEADER::FILE_REVISION,       plan.revision + 1);
+    return plan.fileSize;
+}
+Size STORE_TILE_AMENDMENT (BYTE* const __base, Size __size, const TileAmendmentCreateInfo& __CI)
+{
+    return STORE_TILE_AMENDMENT(__base, __size, __CI, 0);
+}
+uint32_t MIP_TAIL_LAYERS (const LayerExtents& extents, uint32_t max_layer_tiles)
+{
+    // Layers are ordered from the coarsest; the tail is the leading run of small layers
+    uint32_t layers             = 0;
+    for (auto&& extent : extents) {
+        if (uint64_t(extent.xTiles) * extent.yTiles > max_layer_tiles) break;
+        ++layers;
+    }
+    return layers;
+}
+static uint32_t PLAN_MIP_TAIL_LAYERS (const BYTE* const __base, Size __size, const MipTailCreateInfo& __CI)
+{
+    const auto __FILE_HEADER    = FILE_HEADER(__size);
+    if (__FILE_HEADER.read_header(__base).extVersion > IRIS_EXTENSION_1_0); else throw std::runtime_error
+        ("Failed STORE_MIP_TAIL -- a mip tail requires a version 2 (or later) slide file.");
+    
+    const auto __TILE_TABLE     = __FILE_HEADER.get_tile_table(__base);
+    const auto __EXTENTS        = __TILE_TABLE.get_layer_extents(__base);
+    const auto tail_layers      = MIP_TAIL_LAYERS(__EXTENTS.read_layer_extents(__base), __CI.maxLayerTiles);
+    if (tail_layers == 0) throw std::runtime_error
+        ("Failed STORE_MIP_TAIL -- the coarsest slide layer exceeds " +
+         std::to_string(__CI.maxLayerTiles) + " tiles; no layers qualify for the mip tail.");
+    return tail_layers;
+}
+Size SIZE_MIP_TAIL (const BYTE* const __base, Size __size, const MipTailCreateInfo& __CI)
+{
+    TileAmendmentCreateInfo amendment;
+    amendment.deltaEncode       = __CI.deltaEncode;
+    return PLAN_TILE_AMENDMENT(__base, __size, amendment,
+                               PLAN_MIP_TAIL_LAYERS(__base, __size, __CI)).fileSize - __size;
+}
+Size STORE_MIP_TAIL (BYTE* const __base, Size __size, const MipTailCreateInfo& __CI)
+{
+    TileAmendmentCreateInfo amendment;
+    amendment.deltaEncode       = __CI.deltaEncode;
+    amendment.barrier           = __CI.barrier;
+    return STORE_TILE_AMENDMENT(__base, __size, amendment,
+                                PLAN_MIP_TAIL_LAYERS(__base, __size, __CI));
+}
+#endif
+
+// MARK: - TILE PLANES
+inline bool VALIDATE_PLANE_TYPE (PlaneType type)
+{
+    switch (type) {
+        case PLANE_FOCAL:
+        case PLANE_CHANNEL:     return true;
+        case PLANE_UNDEFINED:
+        default:                return false;
+    }
+}
+TILE_PLANES::TILE_PLANES (Offset offset, Size file_size, uint32_t version) noexcept :
+DATA_BLOCK (offset, file_size, version)
+{
+    
+}
+Size TILE_PLANES::size(const BYTE* __base) const
+{
+#ifdef __EMSCRIPTEN__
+    __base = check_and_fetch_remote(__base);
+#endif
+    const auto __ptr    = __base + __offset;
+    const auto STEP     = LOAD_U16(__ptr + ENTRY_SIZE);
+    const auto ENTRIES  = LOAD_U32(__ptr + ENTRY_NUMBER);
+    
+    Size size = HEADER_V2_0_SIZE + Size(STEP) * ENTRIES;
+    if (__version > IRIS_EXTENSION_2_0); else return size;
+    
+    // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
+    // VERSION CONTROL: VERSION 3
+    // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
+    
+    return size;
+}
+Result TILE_PLANES::validate_offset(const BYTE* __base) const noexcept
+{
+#ifdef __EMSCRIPTEN__
+    __base = check_and_fetch_remote(__base);
+#endif
+    return DATA_BLOCK::validate_offset(__base, type, recovery);
+}
+Result TILE_PLANES::validate_full(const BYTE* __base) const noexcept
+{
+#ifdef __EMSCRIPTEN__
+    __base = check_and_fetch_remote(__base);
+#endif
+    auto result         = validate_offset(__base);
+    if (result & IRIS_FAILURE) return result;
+    
+    const auto __ptr    = __base + __offset;
+    const auto STEP     = LOAD_U16(__ptr + ENTRY_SIZE);
+    const auto ENTRIES  = LOAD_U32(__ptr + ENTRY_NUMBER);
+    const auto TYPE     = static_cast<PlaneType>(LOAD_U8(__ptr + PLANE_TYPE));
+    Offset start        = __offset + HEADER_V2_0_SIZE;
+    
+    if (VALIDATE_PLANE_TYPE(TYPE) == false) return Result
+        (IRIS_FAILURE, "TILE_PLANES failed validation -- undefined plane type (" +
+         to_hex_string(static_cast<uint8_t>(TYPE)) + ").");
+    if (ENTRIES < 2) return Result
+        (IRIS_FAILURE, "TILE_PLANES failed validation -- a multi-plane tile table shall contain at least two planes.");
+    if (STEP < TILE_PLANE::SIZE) return Result
+        (IRIS_FAILURE, "TILE_PLANES failed validation -- entry size ("+
+         std::to_string(STEP) +
+         " bytes) is smaller than a plane entry ("+
+         std::to_string(TILE_PLANE::SIZE) +
+         " bytes).");
+    if (start + Size(ENTRIES)*STEP > __size) return Result
+        (IRIS_FAILURE, "TILE_PLANES failed validation -- plane array block ("+
+         std::to_string(start) + "-" +
+         std::to_string(start + Size(ENTRIES)*STEP)+
+         "bytes) extends beyond the end of the file.");
+    
+    if (__version > IRIS_EXTENSION_2_0); else goto VALIDATE_PLANES;
+    
+    // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
+    // VERSION CONTROL: VERSION 3+ PARAMETERS ARE ADDED HERE
+    // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
+    
+    VALIDATE_PLANES:
+    if (LOAD_U64(__base + start + TILE_PLANE::TILE_OFFSETS_OFFSET) != NULL_OFFSET) return Result
+        (IRIS_FAILURE, "TILE_PLANES failed validation -- the plane 0 entry shall be NULL_OFFSET; plane 0 is the tile table tile offsets array.");
+    const BYTE* __array = __base + start + STEP;
+    for (uint32_t PI = 1; PI < ENTRIES; ++PI, __array += STEP) {
+        const auto offset   = LOAD_U64(__array + TILE_PLANE::TILE_OFFSETS_OFFSET);
+        const auto __PLANE  = TILE_OFFSETS(offset, __size, __version);
+        auto plane_result   = __PLANE.validate_full(__base);
+        if (plane_result & IRIS_FAILURE) return Result
+            (IRIS_FAILURE, "TILE_PLANES failed validation -- plane ("+
+             std::to_string(PI) + ") tile offsets: " + plane_result.message);
+    }
+    
+    return result;
+}
+void TILE_PLANES::read_planes(const BYTE* __base, TileTable& table) const
+{
+#ifdef __EMSCRIPTEN__
+    __base = check_and_fetch_remote(__base);
+#endif
+    const auto __ptr    = __base + __offset;
+    const auto STEP     = LOAD_U16(__ptr + ENTRY_SIZE);
+    const auto ENTRIES  = LOAD_U32(__ptr + ENTRY_NUMBER);
+    table.planeType     = static_cast<PlaneType>(LOAD_U8(__ptr + PLANE_TYPE));
+    
+    Offset start        = __offset + HEADER_V2_0_SIZE;
+    if (__version > IRIS_EXTENSION_2_0); else goto READ_PLANES;
+    
+    // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
+    // VERSION CONTROL: VERSION 3+ PARAMETERS ARE ADDED HERE
+    // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
+    
+    READ_PLANES:
+    if (ENTRIES && STEP < TILE_PLANE::SIZE) throw std::runtime_error
+        ("TILE_PLANES::read_planes failed -- entry size ("+
+         std::to_string(STEP) +
+         " bytes) is smaller than a plane entry. Did you validate?");
+    if (start + Size(ENTRIES)*STEP > __size) throw std::runtime_error
+        ("TILE_PLANES::read_planes failed -- plane array block ("+
+         std::to_string(start) + "-" +
+         std::to_string(start + Size(ENTRIES)*STEP)+
+         "bytes) extends beyond the end of the file.");
+    
+    table.planes.resize (ENTRIES);
+    const BYTE* __array = __base + start;
+    for (auto&& plane : table.planes) {
+        plane           = LOAD_F32(__array + TILE_PLANE::VALUE);
+        __array        += STEP;
+    }
+}
+TILE_OFFSETS TILE_PLANES::get_plane_offsets(const BYTE* __base, uint32_t plane) const
+{
+#ifdef __EMSCRIPTEN__
+    __base = check_and_fetch_remote(__base);
+#endif
+    const auto __ptr    = __base + __offset;
+    const auto STEP     = LOAD_U16(__ptr + ENTRY_SIZE);
+    const auto ENTRIES  = LOAD_U32(__ptr + ENTRY_NUMBER);
+    if (plane == 0 || plane >= ENTRIES) throw std::runtime_error
+        ("Failed to retrieve plane tile offsets -- plane (" + std::to_string(plane) +
+         ") is not an additional plane of the (" + std::to_string(ENTRIES) + ") tile planes.");
+    if (STEP < TILE_PLANE::SIZE ||
+        __offset + HEADER_V2_0_SIZE + Size(plane + 1) * STEP > __size) throw std::runtime_error
+        ("Failed to retrieve plane tile offsets -- the plane entry is invalid. Did you validate?");
+    
+    const auto __TILE_OFFSETS = TILE_OFFSETS
+    (LOAD_U64(__ptr + HEADER_V2_0_SIZE + Size(plane) * STEP + TILE_PLANE::TILE_OFFSETS_OFFSET),
+     __size, __version);
+    
+    const auto result = __TILE_OFFSETS.validate_offset(__base);
+    if (result & IRIS_VALIDATION_FAILURE) throw std::runtime_error
+        ("Failed to retrieve plane (" + std::to_string(plane) + ") tile offset array:" + result.message);
+    else if (result & IRIS_WARNING) printf
+        ("Retrieve plane tile offset array WARNING: %s", result.message.c_str());
+    
+    return __TILE_OFFSETS;
+}
 #ifdef __EMSCRIPTEN__
-void TILE_OFFSETS::check_and_fetch_remote(const BYTE *const &base)
+const BYTE* TILE_PLANES::check_and_fetch_remote (const BYTE* base) const
 {
-    if (!__response) {
-        const char* url = REINTERPRET_ARRAY_START(base);
-        __response      = FETCH_DATABLOCK(url,__remote, HEADER_SIZE);
-        __offset        = __ptr_size;
-        __response      = FETCH_DATABLOCK(url, __remote, size(base));
-    } const_cast<const BYTE*&>(base) = __response->data;
+    return FETCH_REMOTE_BLOCK(*this, base);
 }
 #else
-Size SIZE_TILE_OFFSETS (const TileTable::Layers &__offsets)
+Size SIZE_TILE_PLANES (const TilePlanesCreateInfo& __CI)
 {
-    Size size = TILE_OFFSETS::HEADER_SIZE;
-    for (auto&& layer : __offsets)
-        size += layer.size() * TILE_OFFSET::SIZE;
-    return size;
+    return TILE_PLANES::HEADER_SIZE + TILE_PLANE::SIZE * __CI.planes.size();
 }
-void STORE_TILE_OFFSETS (BYTE* const __base, Offset offset, const TileTable::Layers &__offsets)
+void STORE_TILE_PLANES (BYTE *const __base, const TilePlanesCreateInfo& __CI)
 {
-    uint32_t total_tiles = 0;
-    for (auto&& layer : __offsets) total_tiles += U32_CAST(layer.size());
+    if (__CI.planesOffset == NULL_OFFSET) throw std::runtime_error
+        ("Failed STORE_TILE_PLANES -- invalid planesOffset in TilePlanesCreateInfo.");
+    if (VALIDATE_PLANE_TYPE(__CI.type) == false) throw std::runtime_error
+        ("Failed STORE_TILE_PLANES -- undefined plane type (" +
+         to_hex_string(static_cast<uint8_t>(__CI.type)) + ") in TilePlanesCreateInfo.");
+    if (__CI.planes.size() < 2) throw std::runtime_error
+        ("Failed STORE_TILE_PLANES -- a multi-plane tile table shall contain at least two planes.");
     
-    STORE_U64(__base + offset + TILE_OFFSETS::VALIDATION,   offset);
-    STORE_U16(__base + offset + TILE_OFFSETS::RECOVERY,     RECOVER_TILE_OFFSETS);
-    STORE_U16(__base + offset + TILE_OFFSETS::ENTRY_SIZE,   TILE_OFFSET::SIZE);
-    STORE_U32(__base + offset + TILE_OFFSETS::ENTRY_NUMBER, total_tiles);
-    offset += TILE_OFFSETS::HEADER_SIZE;
-    for (auto&& layer : __offsets)
-        for (auto&& tile : layer) {
-            if (tile.offset > UINT40_MAX) throw std::runtime_error("tile offset above 40-bit numerical limit");
-            if (tile.size   > UINT24_MAX) throw std::runtime_error("tile size above 24-bit numerical limit");
-            STORE_U40   (__base + offset + TILE_OFFSET::OFFSET,     tile.offset);
-            STORE_U24   (__base + offset + TILE_OFFSET::TILE_SIZE,  tile.size);
-            offset += TILE_OFFSET::SIZE;
-        }
+    #if IrisCodecExtensionValidateEncoding
+    Result result;
+    DATA_BLOCK blk_validation (NULL_OFFSET, UINT64_MAX, IFE_VERSION);
+    for (size_t PI = 1; PI < __CI.planes.size(); ++PI) {
+        blk_validation.__offset = __CI.planes[PI].tileOffsets;
+        result = static_cast<TILE_OFFSETS&>(blk_validation).validate_offset(__base);
+        if (result & IRIS_FAILURE) throw std::runtime_error
+            ("Failed STORE_TILE_PLANES -- Invalid plane (" + std::to_string(PI) +
+             ") tileOffsets (" + result.message +
+             "). Each additional plane shall reference a valid tile offsets array sharing the tile table layer extents.");
+    }
+    #endif
+    
+    auto __ptr  = __base + __CI.planesOffset;
+    STORE_U64(__ptr + TILE_PLANES::VALIDATION,      __CI.planesOffset);
+    STORE_U16(__ptr + TILE_PLANES::RECOVERY,        RECOVER_TILE_PLANES);
+    STORE_U16(__ptr + TILE_PLANES::ENTRY_SIZE,      TILE_PLANE::SIZE);
+    STORE_U32(__ptr + TILE_PLANES::ENTRY_NUMBER,    U32_CAST(__CI.planes.size()));
+    STORE_U8 (__ptr + TILE_PLANES::PLANE_TYPE,      __CI.type);
+    __ptr += TILE_PLANES::HEADER_SIZE;
+    
+    // Plane 0 is the tile table's own tile offsets array
+    for (size_t PI = 0; PI < __CI.planes.size(); ++PI) {
+        STORE_U64(__ptr + TILE_PLANE::TILE_OFFSETS_OFFSET, PI ? __CI.planes[PI].tileOffsets : NULL_OFFSET);
+        STORE_F32(__ptr + TILE_PLANE::VALUE,            __CI.planes[PI].value);
+        __ptr += TILE_PLANE::SIZE;
+    }
 }
 #endif
 
@@ -1950,10 +4743,10 @@ DATA_BLOCK(offset, file_size, version)
 {
     
 }
-Size ATTRIBUTES_SIZES::size(const BYTE *const __base) const
+Size ATTRIBUTES_SIZES::size(const BYTE* __base) const
 {
 #ifdef __EMSCRIPTEN__
-    const_cast<ATTRIBUTES_SIZES&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
     const auto __ptr    = __base + __offset;
     const auto STEP     = LOAD_U16(__ptr + ENTRY_SIZE);
@@ -1968,16 +4761,16 @@ Size ATTRIBUTES_SIZES::size(const BYTE *const __base) const
     
     return size;
 }
-Result ATTRIBUTES_SIZES::validate_offset(const BYTE *const __base) const noexcept {
+Result ATTRIBUTES_SIZES::validate_offset(const BYTE* __base) const noexcept {
 #ifdef __EMSCRIPTEN__
-    const_cast<ATTRIBUTES_SIZES&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
     return DATA_BLOCK::validate_offset(__base, type, recovery);
 }
-Result ATTRIBUTES_SIZES::validate_full(const BYTE *const __base, Size& expected_bytes) const noexcept
+Result ATTRIBUTES_SIZES::validate_full(const BYTE* __base, Size& expected_bytes) const noexcept
 {
 #ifdef __EMSCRIPTEN__
-    const_cast<ATTRIBUTES_SIZES&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
     auto result         = validate_offset(__base);
     if(result & IRIS_FAILURE) return result;
@@ -2015,10 +4808,10 @@ Result ATTRIBUTES_SIZES::validate_full(const BYTE *const __base, Size& expected_
     }
     return IRIS_SUCCESS;
 }
-ATTRIBUTES_SIZES::SizeArray ATTRIBUTES_SIZES::read_sizes(const BYTE *const __base) const
+ATTRIBUTES_SIZES::SizeArray ATTRIBUTES_SIZES::read_sizes(const BYTE* __base) const
 {
 #ifdef __EMSCRIPTEN__
-    const_cast<ATTRIBUTES_SIZES&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
     const auto __ptr    = __base + __offset;
     const auto STEP     = LOAD_U16(__ptr + ENTRY_SIZE);
@@ -2056,14 +4849,9 @@ ATTRIBUTES_SIZES::SizeArray ATTRIBUTES_SIZES::read_sizes(const BYTE *const __bas
     return sizes;
 }
 #ifdef __EMSCRIPTEN__
-void ATTRIBUTES_SIZES::check_and_fetch_remote(const BYTE *const &base)
+const BYTE* ATTRIBUTES_SIZES::check_and_fetch_remote (const BYTE* base) const
 {
-    if (!__response) {
-        const char* url = REINTERPRET_ARRAY_START(base);
-        __response      = FETCH_DATABLOCK(url,__remote, HEADER_SIZE);
-        __offset        = __ptr_size;
-        __response      = FETCH_DATABLOCK(url, __remote, size(base));
-    } const_cast<const BYTE*&>(base) = __response->data;
+    return FETCH_REMOTE_BLOCK(*this, base);
 }
 #else
 Size SIZE_ATTRIBUTES_SIZES (const Attributes& attributes)
@@ -2107,9 +4895,9 @@ void STORE_ATTRIBUTES_SIZES (BYTE* const __base, Offset offset, const Attributes
     STORE_U32(__ptr + ATTRIBUTES_SIZES::ENTRY_NUMBER, U32_CAST(attributes.size()));
     __ptr += ATTRIBUTES_SIZES::HEADER_SIZE;
     
-    for (auto&& attribute : attributes) {
-        STORE_U16(__ptr + ATTRIBUTE_SIZE::KEY_SIZE, U16_CAST(attribute.first.size()));
-        STORE_U32(__ptr + ATTRIBUTE_SIZE::VALUE_SIZE, U32_CAST(attribute.second.size()));
+    for (auto&& attribute : SORTED_ATTRIBUTES(attributes)) {
+        STORE_U16(__ptr + ATTRIBUTE_SIZE::KEY_SIZE, U16_CAST(attribute->first.size()));
+        STORE_U32(__ptr + ATTRIBUTE_SIZE::VALUE_SIZE, U32_CAST(attribute->second.size()));
         __ptr += ATTRIBUTE_SIZE::SIZE;
     }
 }
@@ -2120,10 +4908,10 @@ DATA_BLOCK(offset, file_size, version)
 {
     
 }
-Size ATTRIBUTES_BYTES::size(const BYTE *const __base) const
+Size ATTRIBUTES_BYTES::size(const BYTE* __base) const
 {
 #ifdef __EMSCRIPTEN__
-    const_cast<ATTRIBUTES_BYTES&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
     const auto __ptr    = __base + __offset;
     const auto BYTES    = LOAD_U32(__ptr + ENTRY_NUMBER);
@@ -2137,22 +4925,36 @@ Size ATTRIBUTES_BYTES::size(const BYTE *const __base) const
     
     return size;
 }
-Result ATTRIBUTES_BYTES::validate_offset(const BYTE *const __base) const noexcept {
+Result ATTRIBUTES_BYTES::validate_offset(const BYTE* __base) const noexcept {
 #ifdef __EMSCRIPTEN__
-    const_cast<ATTRIBUTES_BYTES&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
     return DATA_BLOCK::validate_offset(__base, type, recovery);
 }
-Result ATTRIBUTES_BYTES::validate_full(const BYTE *const __base, Size expected) const noexcept
+Result ATTRIBUTES_BYTES::validate_full(const BYTE* __base, Size expected, TextCompression compression) const noexcept
 {
 #ifdef __EMSCRIPTEN__
-    const_cast<ATTRIBUTES_BYTES&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
     auto result         = validate_offset(__base);
     if(result & IRIS_FAILURE) return result;
     
     const auto __ptr    = __base + __offset;
     const auto BYTES    = LOAD_U32(__ptr + ENTRY_NUMBER);
+    if (compression != TEXT_UNCOMPRESSED) {
+        // The byte array holds a compressed frame of the expected (decoded) bytes
+        if (BYTES < TEXT_FRAME_HEADER_SIZE || __offset + HEADER_V1_0_SIZE + BYTES > __size) return Result
+            (IRIS_FAILURE,"ATTRIBUTES_BYTES failed validation -- compressed attributes byte array ("+
+             std::to_string(BYTES)+
+             " bytes) is truncated or extends beyond end of file.");
+        if (LOAD_U32(__ptr + HEADER_V1_0_SIZE) != expected) return Result
+            (IRIS_FAILURE,"ATTRIBUTES_BYTES failed validation -- expected bytes ("+
+             std::to_string(expected)+
+             ") from ATTRIBUTES_SIZES array does not match the decoded size of the compressed ATTRIBUTES_BYTES block (" +
+             std::to_string(LOAD_U32(__ptr + HEADER_V1_0_SIZE)) +
+             ")");
+        return IRIS_SUCCESS;
+    }
     if (BYTES != expected) return Result
         (IRIS_FAILURE,"ATTRIBUTES_BYTES failed validation -- expected bytes ("+
          std::to_string(expected)+
@@ -2167,19 +4969,21 @@ Result ATTRIBUTES_BYTES::validate_full(const BYTE *const __base, Size expected)
     
     return IRIS_SUCCESS;
 }
-void ATTRIBUTES_BYTES::read_bytes(const BYTE *const __base, const SizeArray &sizes, Attributes &attributes) const
+void ATTRIBUTES_BYTES::read_bytes(const BYTE* __base, const SizeArray &sizes, Attributes &attributes,
+                                  TextCompression compression, const TextDictionary* dictionary) const
 {
 #ifdef __EMSCRIPTEN__
-    const_cast<ATTRIBUTES_BYTES&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
     const auto __ptr    = __base + __offset;
     const auto BYTES    = LOAD_U32(__ptr + ENTRY_NUMBER);
+    std::string decoded;
+    Size total_size = 0;
     
     {   // Validate sizes array for bounds check
-        Size total_size = 0;
         for (auto&& size : sizes)
             total_size+= size.first + size.second;
-        if (total_size != BYTES) throw std::runtime_error
+        if (compression == TEXT_UNCOMPRESSED && total_size != BYTES) throw std::runtime_error
             ("ATTRIBUTES_BYTES failed validation -- expected bytes ("+
              std::to_string(total_size)+
              ") from ATTRIBUTES_SIZES array does not match the byte size of the ATTRIBUTES_BYTES block (" +
@@ -2203,6 +5007,16 @@ void ATTRIBUTES_BYTES::read_bytes(const BYTE *const __base, const SizeArray &siz
     
     attributes.clear();
     const BYTE* __array = __base + start;
+    if (compression != TEXT_UNCOMPRESSED) {
+        // The frame is decoded once into a contiguous buffer that is sliced below
+        decoded.resize(total_size);
+        if (DECOMPRESS_TEXT(__array, BYTES, dictionary, reinterpret_cast<BYTE*>(decoded.data()), total_size) == false)
+            throw std::runtime_error
+            ("Failed ATTRIBUTES_BYTES::read_bytes -- compressed attributes failed to decode to the expected bytes ("+
+             std::to_string(total_size)+
+             ") from the ATTRIBUTES_SIZES array. The block is malformed or the text dictionary does not match.");
+        __array = reinterpret_cast<const BYTE*>(decoded.data());
+    }
     for (auto&& size : sizes) {
         Size total_bytes = size.first + size.second;
         attributes[std::string((char*)__array,size.first)] =
@@ -2211,8 +5025,13 @@ void ATTRIBUTES_BYTES::read_bytes(const BYTE *const __base, const SizeArray &siz
     }
     return;
 }
-Size SIZE_ATTRIBUTES_BYTES (const Attributes& attributes)
+Size SIZE_ATTRIBUTES_BYTES (const Attributes& attributes, TextCompression compression, const TextDictionary* dictionary)
 {
+    if (compression != TEXT_UNCOMPRESSED) {
+        const auto text = SERIALIZE_ATTRIBUTES(attributes);
+        return ATTRIBUTES_BYTES::HEADER_SIZE +
+        compress_text(reinterpret_cast<const BYTE*>(text.data()), text.size(), dictionary).size();
+    }
     Size size = ATTRIBUTES_BYTES::HEADER_SIZE;
     for (auto&& attribute : attributes) {
         size += attribute.first.size();
@@ -2220,17 +5039,13 @@ Size SIZE_ATTRIBUTES_BYTES (const Attributes& attributes)
     } return size;
 }
 #ifdef __EMSCRIPTEN__
-void ATTRIBUTES_BYTES::check_and_fetch_remote(const BYTE *const &base)
+const BYTE* ATTRIBUTES_BYTES::check_and_fetch_remote (const BYTE* base) const
 {
-    if (!__response) {
-        const char* url = REINTERPRET_ARRAY_START(base);
-        __response      = FETCH_DATABLOCK(url,__remote, HEADER_SIZE);
-        __offset        = __ptr_size;
-        __response      = FETCH_DATABLOCK(url, __remote, size(base));
-    } const_cast<const BYTE*&>(base) = __response->data;
+    return FETCH_REMOTE_BLOCK(*this, base);
 }
 #else
-void STORE_ATTRIBUTES_BYTES (BYTE* const __base, Offset offset, const Attributes& attributes)
+void STORE_ATTRIBUTES_BYTES (BYTE* const __base, Offset offset, const Attributes& attributes,
+                             TextCompression compression, const TextDictionary* dictionary)
 {
     #if IrisCodecExtensionValidateEncoding
     if (offset == NULL_OFFSET) throw std::runtime_error
@@ -2242,6 +5057,8 @@ void STORE_ATTRIBUTES_BYTES (BYTE* const __base, Offset offset, const Attributes
         case METADATA_UNDEFINED:
             throw std::runtime_error("Failed to store attributes sizes -- undefined metadata attribute type");
     }
+    if (VALIDATE_TEXT_COMPRESSION(compression) == false)
+        throw std::runtime_error("Failed to store attributes bytes -- undefined text compression");
     #endif
     
     auto __ptr = __base + offset;
@@ -2250,14 +5067,21 @@ void STORE_ATTRIBUTES_BYTES (BYTE* const __base, Offset offset, const Attributes
     STORE_U16(__ptr + ATTRIBUTES_BYTES::RECOVERY, RECOVER_ATTRIBUTES_BYTES);
     __ptr += ATTRIBUTES_BYTES::HEADER_SIZE;
     
-    for (auto&& attribute : attributes) {
-        uint16_t key_size = U16_CAST(attribute.first.size());
-        std::memcpy(__ptr, attribute.first.data(), key_size);
+    if (compression != TEXT_UNCOMPRESSED) {
+        const auto text         = SERIALIZE_ATTRIBUTES(attributes);
+        const auto compressed   = compress_text(reinterpret_cast<const BYTE*>(text.data()), text.size(), dictionary);
+        memcpy(__ptr, compressed.data(), compressed.size());
+        STORE_U32(__base + offset + ATTRIBUTES_BYTES::ENTRY_NUMBER, U32_CAST(compressed.size()));
+        return;
+    }
+    for (auto&& attribute : SORTED_ATTRIBUTES(attributes)) {
+        uint16_t key_size = U16_CAST(attribute->first.size());
+        std::memcpy(__ptr, attribute->first.data(), key_size);
         __ptr += key_size;
         size  += key_size;
         
-        uint32_t value_size = U32_CAST(attribute.second.size());
-        std::memcpy(__ptr, attribute.second.data(), value_size);
+        uint32_t value_size = U32_CAST(attribute->second.size());
+        std::memcpy(__ptr, attribute->second.data(), value_size);
         __ptr += value_size;
         size  += value_size;
     }
@@ -2269,16 +5093,186 @@ void STORE_ATTRIBUTES_BYTES (BYTE* const __base, Offset offset, const Attributes
     STORE_U32(__base + offset + ATTRIBUTES_BYTES::ENTRY_NUMBER, U32_CAST(size));
 }
 #endif
+// MARK: - ATTRIBUTES DIRECTORY
+ATTRIBUTES_DIRECTORY::ATTRIBUTES_DIRECTORY  (Offset offset, Size file_size, uint32_t version) noexcept :
+DATA_BLOCK(offset, file_size, version)
+{
+    
+}
+Size ATTRIBUTES_DIRECTORY::size(const BYTE* __base) const
+{
+#ifdef __EMSCRIPTEN__
+    __base = check_and_fetch_remote(__base);
+#endif
+    const auto __ptr    = __base + __offset;
+    const auto STEP     = LOAD_U16(__ptr + ENTRY_SIZE);
+    const auto ENTRIES  = LOAD_U32(__ptr + ENTRY_NUMBER);
+    return HEADER_V2_0_SIZE + Size(STEP) * ENTRIES;
+}
+Result ATTRIBUTES_DIRECTORY::validate_offset(const BYTE* __base) const noexcept {
+#ifdef __EMSCRIPTEN__
+    __base = check_and_fetch_remote(__base);
+#endif
+    return DATA_BLOCK::validate_offset(__base, type, recovery);
+}
+Result ATTRIBUTES_DIRECTORY::validate_full(const BYTE* __base, const SizeArray &sizes, Offset bytes) const noexcept
+{
+#ifdef __EMSCRIPTEN__
+    __base = check_and_fetch_remote(__base);
+#endif
+    auto result         = validate_offset(__base);
+    if (result & IRIS_FAILURE) return result;
+    
+    const auto __ptr    = __base + __offset;
+    const auto STEP     = LOAD_U16(__ptr + ENTRY_SIZE);
+    const auto ENTRIES  = LOAD_U32(__ptr + ENTRY_NUMBER);
+    const Offset start  = __offset + HEADER_V2_0_SIZE;
+    if (ENTRIES && STEP < ATTRIBUTE_DIRECTORY_ENTRY::SIZE) return Result
+        (IRIS_FAILURE, "ATTRIBUTES_DIRECTORY failed validation -- entry size ("+
+         std::to_string(STEP) +
+         " bytes) is smaller than an attribute directory entry ("+
+         std::to_string(ATTRIBUTE_DIRECTORY_ENTRY::SIZE) +
+         " bytes).");
+    if (ENTRIES != sizes.size()) return Result
+        (IRIS_FAILURE, "ATTRIBUTES_DIRECTORY failed validation -- the directory entries ("+
+         std::to_string(ENTRIES) +
+         ") do not match the number of attributes ("+
+         std::to_string(sizes.size()) + ").");
+    if (start + Size(ENTRIES) * STEP > __size) return Result
+        (IRIS_FAILURE, "ATTRIBUTES_DIRECTORY failed validation -- directory block (location "+
+         std::to_string(start) + " - " +
+         std::to_string(start + Size(ENTRIES) * STEP) +
+         " bytes) extends beyond the end of file.");
+    
+    Size total_bytes    = 0;
+    for (auto&& size : sizes)
+        total_bytes    += size.first + size.second;
+    if (bytes + total_bytes > __size) return Result
+        (IRIS_FAILURE, "ATTRIBUTES_DIRECTORY failed validation -- the attributes byte array extends beyond the end of file.");
+    
+    uint64_t prior      = 0;
+    const BYTE* __array = __base + start;
+    for (uint32_t EI = 0; EI < ENTRIES; ++EI, __array += STEP) {
+        const auto HASH         = LOAD_U64(__array + ATTRIBUTE_DIRECTORY_ENTRY::KEY_HASH);
+        const Size KEY_OFFSET   = LOAD_U32(__array + ATTRIBUTE_DIRECTORY_ENTRY::KEY_OFFSET);
+        const Size KEY_SIZE     = LOAD_U16(__array + ATTRIBUTE_DIRECTORY_ENTRY::KEY_SIZE);
+        const Size VALUE_OFFSET = LOAD_U32(__array + ATTRIBUTE_DIRECTORY_ENTRY::VALUE_OFFSET);
+        const Size VALUE_SIZE   = LOAD_U32(__array + ATTRIBUTE_DIRECTORY_ENTRY::VALUE_SIZE);
+        if (HASH < prior) return Result
+            (IRIS_FAILURE, "ATTRIBUTES_DIRECTORY failed validation -- entry ("+
+             std::to_string(EI) +
+             ") is not sorted by key hash. The directory cannot be binary searched.");
+        if (KEY_OFFSET + KEY_SIZE > total_bytes || VALUE_OFFSET + VALUE_SIZE > total_bytes) return Result
+            (IRIS_FAILURE, "ATTRIBUTES_DIRECTORY failed validation -- entry ("+
+             std::to_string(EI) +
+             ") locates bytes beyond the end of the attributes byte array (" +
+             std::to_string(total_bytes) + " bytes).");
+        if (ATTRIBUTE_KEY_HASH(__base + bytes + KEY_OFFSET, KEY_SIZE) != HASH) return Result
+            (IRIS_FAILURE, "ATTRIBUTES_DIRECTORY failed validation -- entry ("+
+             std::to_string(EI) +
+             ") key hash does not match the key bytes it locates.");
+        prior = HASH;
+    }
+    return IRIS_SUCCESS;
+}
+AttributeDirectory ATTRIBUTES_DIRECTORY::read_directory(const BYTE* __base, Offset bytes) const
+{
+#ifdef __EMSCRIPTEN__
+    __base = check_and_fetch_remote(__base);
+#endif
+    const auto __ptr    = __base + __offset;
+    const auto STEP     = LOAD_U16(__ptr + ENTRY_SIZE);
+    const auto ENTRIES  = LOAD_U32(__ptr + ENTRY_NUMBER);
+    const Offset start  = __offset + HEADER_V2_0_SIZE;
+    if (ENTRIES && STEP < ATTRIBUTE_DIRECTORY_ENTRY::SIZE) throw std::runtime_error
+        ("ATTRIBUTES_DIRECTORY::read_directory failed -- entry size ("+
+         std::to_string(STEP) +
+         " bytes) is smaller than an attribute directory entry. Did you validate?");
+    if (start + Size(ENTRIES) * STEP > __size) throw std::runtime_error
+        ("ATTRIBUTES_DIRECTORY::read_directory failed -- directory block ("+
+         std::to_string(start) + "-" +
+         std::to_string(start + Size(ENTRIES) * STEP) +
+         "bytes) extends beyond the end of the file.");
+    
+    AttributeDirectory directory;
+    directory.bytes     = bytes;
+    directory.entries.resize(ENTRIES);
+    const BYTE* __array = __base + start;
+    for (auto&& entry : directory.entries) {
+        entry.hash          = LOAD_U64(__array + ATTRIBUTE_DIRECTORY_ENTRY::KEY_HASH);
+        entry.keyOffset     = LOAD_U32(__array + ATTRIBUTE_DIRECTORY_ENTRY::KEY_OFFSET);
+        entry.keySize       = LOAD_U16(__array + ATTRIBUTE_DIRECTORY_ENTRY::KEY_SIZE);
+        entry.valueOffset   = LOAD_U32(__array + ATTRIBUTE_DIRECTORY_ENTRY::VALUE_OFFSET);
+        entry.valueSize     = LOAD_U32(__array + ATTRIBUTE_DIRECTORY_ENTRY::VALUE_SIZE);
+        __array            += STEP;
+    }
+    return directory;
+}
+#ifdef __EMSCRIPTEN__
+const BYTE* ATTRIBUTES_DIRECTORY::check_and_fetch_remote (const BYTE* base) const
+{
+    return FETCH_REMOTE_BLOCK(*this, base);
+}
+#else
+Size SIZE_ATTRIBUTES_DIRECTORY (const Attributes& attributes)
+{
+    return ATTRIBUTES_DIRECTORY::HEADER_SIZE +
+    ATTRIBUTE_DIRECTORY_ENTRY::SIZE * attributes.size();
+}
+void STORE_ATTRIBUTES_DIRECTORY (BYTE* const __base, Offset offset, const Attributes& attributes)
+{
+    if (offset == NULL_OFFSET) throw std::runtime_error
+        ("Failed to store attributes directory -- NULL_OFFSET provided as location");
+    
+    // Locate each attribute within the key ordered byte array (see STORE_ATTRIBUTES_BYTES)
+    AttributeDirectory::Entries entries;
+    entries.reserve(attributes.size());
+    Size position = 0;
+    for (auto&& attribute : SORTED_ATTRIBUTES(attributes)) {
+        AttributeDirectory::Entry entry;
+        entry.hash          = AttributeDirectory::hash(attribute->first);
+        entry.keyOffset     = U32_CAST(position);
+        entry.keySize       = U16_CAST(attribute->first.size());
+        position           += attribute->first.size();
+        entry.valueOffset   = U32_CAST(position);
+        entry.valueSize     = U32_CAST(attribute->second.size());
+        position           += attribute->second.size();
+        entries.push_back(entry);
+    }
+    if (position > UINT32_MAX) throw std::runtime_error
+        ("Failed to store attributes directory -- attribute bytes array length ("+
+         std::to_string(position)+
+         " bytes) exceeds the 32-bit directory offset limit.");
+    std::stable_sort(entries.begin(), entries.end(), []
+                     (const AttributeDirectory::Entry& a, const AttributeDirectory::Entry& b)
+                     {return a.hash < b.hash;});
+    
+    auto __ptr = __base + offset;
+    STORE_U64(__ptr + ATTRIBUTES_DIRECTORY::VALIDATION,     offset);
+    STORE_U16(__ptr + ATTRIBUTES_DIRECTORY::RECOVERY,       RECOVER_ATTRIBUTES_DIRECTORY);
+    STORE_U16(__ptr + ATTRIBUTES_DIRECTORY::ENTRY_SIZE,     ATTRIBUTE_DIRECTORY_ENTRY::SIZE);
+    STORE_U32(__ptr + ATTRIBUTES_DIRECTORY::ENTRY_NUMBER,   U32_CAST(entries.size()));
+    __ptr += ATTRIBUTES_DIRECTORY::HEADER_SIZE;
+    for (auto&& entry : entries) {
+        STORE_U64(__ptr + ATTRIBUTE_DIRECTORY_ENTRY::KEY_HASH,      entry.hash);
+        STORE_U32(__ptr + ATTRIBUTE_DIRECTORY_ENTRY::KEY_OFFSET,    entry.keyOffset);
+        STORE_U16(__ptr + ATTRIBUTE_DIRECTORY_ENTRY::KEY_SIZE,      entry.keySize);
+        STORE_U32(__ptr + ATTRIBUTE_DIRECTORY_ENTRY::VALUE_OFFSET,  entry.valueOffset);
+        STORE_U32(__ptr + ATTRIBUTE_DIRECTORY_ENTRY::VALUE_SIZE,    entry.valueSize);
+        __ptr += ATTRIBUTE_DIRECTORY_ENTRY::SIZE;
+    }
+}
+#endif
 // MARK: - IMAGES_ARRAY
 IMAGE_ARRAY::IMAGE_ARRAY  (Offset offset, Size file_size, uint32_t version) noexcept :
 DATA_BLOCK(offset, file_size, version)
 {
     
 }
-Size IMAGE_ARRAY::size(const BYTE *const __base) const
+Size IMAGE_ARRAY::size(const BYTE* __base) const
 {
 #ifdef __EMSCRIPTEN__
-    const_cast<IMAGE_ARRAY&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
     const auto __ptr    = __base + __offset;
     const auto STEP     = LOAD_U16(__ptr + ENTRY_SIZE);
@@ -2293,16 +5287,16 @@ Size IMAGE_ARRAY::size(const BYTE *const __base) const
     
     return size;
 }
-Result IMAGE_ARRAY::validate_offset(const BYTE *const __base) const noexcept {
+Result IMAGE_ARRAY::validate_offset(const BYTE* __base) const noexcept {
 #ifdef __EMSCRIPTEN__
-    const_cast<IMAGE_ARRAY&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
     return DATA_BLOCK::validate_offset(__base, type, recovery);
 }
-Result IMAGE_ARRAY::validate_full (const BYTE *const __base) const noexcept
+Result IMAGE_ARRAY::validate_full (const BYTE* __base) const noexcept
 {
 #ifdef __EMSCRIPTEN__
-    const_cast<IMAGE_ARRAY&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
     auto result         = validate_offset(__base);
     if (result & IRIS_FAILURE) return result;
@@ -2324,8 +5318,8 @@ Result IMAGE_ARRAY::validate_full (const BYTE *const __base) const noexcept
         
         auto __IMAGE_BYTES =
         IMAGE_BYTES(LOAD_U64(__array+IMAGE_ENTRY::BYTES_OFFSET),__size, __version);
-        __IMAGE_BYTES.validate_offset(__base);
-        __IMAGE_BYTES.validate_full(__base);
+        result = __IMAGE_BYTES.validate_full(__base);
+        if (result & IRIS_FAILURE) return result;
         
         if (!VALIDATE_IMAGE_ENCODING_TYPE
             ((ImageEncoding)LOAD_U8(__array + IMAGE_ENTRY::ENCODING),__version)) return Result
@@ -2344,13 +5338,51 @@ Result IMAGE_ARRAY::validate_full (const BYTE *const __base) const noexcept
         // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
         // VERSION CONTROL: VERSION 2+ PARAMETERS ARE ADDED HERE
         // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
+        const bool tiled    = STEP >= IMAGE_ENTRY::V2_0_SIZE &&
+                              LOAD_U64(__array + IMAGE_ENTRY::LAYER_EXTENTS_OFFSET) != NULL_OFFSET;
+        if (STEP >= IMAGE_ENTRY::V2_0_SIZE &&
+            tiled != (LOAD_U64(__array + IMAGE_ENTRY::TILE_OFFSETS_OFFSET) != NULL_OFFSET)) return Result
+            (IRIS_FAILURE,"Associated image entry ("+std::to_string(II)+
+             ") failed validation. A tiled associated image shall reference both a layer extents array and a tile offsets array.");
+        
+        Abstraction::AssociatedImage image;
+        try {
+            __IMAGE_BYTES.read_image_bytes(__base, image);
+            if (!tiled && image.byteSize == 0) return Result
+                (IRIS_FAILURE,"Associated image entry ("+std::to_string(II)+
+                 ") failed validation. An associated image that is not tiled shall contain an encoded image byte stream greater than zero bytes.");
+            if (!tiled) continue;
+            
+            auto __EXTENTS  = get_image_extents(__base, II);
+            auto __OFFSETS  = get_image_offsets(__base, II);
+            result          = __EXTENTS.validate_full(__base);
+            if (result & IRIS_FAILURE) return result;
+            result          = __OFFSETS.validate_full(__base);
+            if (result & IRIS_FAILURE) return result;
+            
+            // The tile offsets shall locate every tile of the layer extents
+            TileTable tiles;
+            tiles.extent.layers = __EXTENTS.read_layer_extents(__base);
+            __OFFSETS.read_tile_offsets(__base, tiles);
+            const auto& extent  = tiles.extent.layers.back();
+            const auto  tile    = __EXTENTS.read_tile_extents(__base).back();
+            const auto  WIDTH   = LOAD_U32(__array + IMAGE_ENTRY::WIDTH);
+            const auto  HEIGHT  = LOAD_U32(__array + IMAGE_ENTRY::HEIGHT);
+            if (Size(extent.xTiles) * tile.width < WIDTH || Size(extent.xTiles - 1) * tile.width >= WIDTH ||
+                Size(extent.yTiles) * tile.height < HEIGHT || Size(extent.yTiles - 1) * tile.height >= HEIGHT)
+                return Result
+                (IRIS_FAILURE,"Associated image entry ("+std::to_string(II)+
+                 ") failed validation. The tiles of the highest resolution pyramid layer shall cover the image width and height.");
+        } catch (std::exception& e) {
+            return Result (IRIS_FAILURE, e.what());
+        }
     }
     return result;
 }
-Abstraction::AssociatedImages IMAGE_ARRAY::read_assoc_images (const BYTE *const __base, BYTES_ARRAY* __image_bytes) const
+Abstraction::AssociatedImages IMAGE_ARRAY::read_assoc_images (const BYTE* __base, BYTES_ARRAY* __image_bytes) const
 {
 #ifdef __EMSCRIPTEN__
-    const_cast<IMAGE_ARRAY&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
     const auto __ptr    = __base + __offset;
     const auto STEP     = LOAD_U16(__ptr + ENTRY_SIZE);
@@ -2392,10 +5424,12 @@ Abstraction::AssociatedImages IMAGE_ARRAY::read_assoc_images (const BYTE *const
             ("WARNING: duplicate associated image title (%s) returned; skipping duplicate. Per the IFE Specification Sections 2.4.6-2.4.7, each image title within the associated images array shall be referenced by unique ASCII encoded labels.", title.c_str());
             continue;
         }
-        if (image.byteSize == 0 || image.byteSize > UINT32_MAX) throw std::runtime_error
+        // Tiled (v2) images store a title only
+        if ((image.byteSize == 0 && !image_pyramid(__base, II)) || image.byteSize > UINT32_MAX) throw std::runtime_error
             ("Failed IMAGES_ARRAY::read_assoc_images -- image byte size ("+
              std::to_string(image.byteSize) +
              ") invalid. Per the IFE specification Section 2.4.7, the image size shall encode a size, in bytes, greater than zero bytes but less than the 32-bit max (4.29 GB) of a valid encoded image byte stream.");
+        bytes_array.push_back(__IMAGE_BYTES);
         
         images[title]       = image;
         auto& info          = images[title].info;
@@ -2421,6 +5455,22 @@ Abstraction::AssociatedImages IMAGE_ARRAY::read_assoc_images (const BYTE *const
         // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
         // VERSION CONTROL: VERSION 2+ PARAMETERS ARE ADDED HERE
         // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
+        if (image_pyramid(__base, II) == false) continue;
+        
+        // Only the pyramid tile lookup is read; the tile bytes remain untouched
+        auto __EXTENTS      = get_image_extents(__base, II);
+        auto __OFFSETS      = get_image_offsets(__base, II);
+        TileTable tiles;
+        tiles.extent.layers = __EXTENTS.read_layer_extents(__base);
+        __OFFSETS.read_tile_offsets(__base, tiles);
+        
+        auto& assoc_image   = images[title];
+        auto& pyramid       = assoc_image.pyramid;
+        pyramid.tileExtents = __EXTENTS.read_tile_extents(__base);
+        pyramid.extent      = std::move(tiles.extent);
+        pyramid.layers      = std::move(tiles.layers);
+        pyramid.extent.width  = assoc_image.layer_width(0);
+        pyramid.extent.height = assoc_image.layer_height(0);
     }
     // If an array of the image bytes was requested
     if (__image_bytes) *__image_bytes = bytes_array;
@@ -2428,15 +5478,69 @@ Abstraction::AssociatedImages IMAGE_ARRAY::read_assoc_images (const BYTE *const
     // Return the images
     return images;
 }
+bool IMAGE_ARRAY::image_pyramid(const BYTE* __base, uint32_t entry) const
+{
+#ifdef __EMSCRIPTEN__
+    __base = check_and_fetch_remote(__base);
+#endif
+    if (__version > IRIS_EXTENSION_1_0); else return false;
+    const auto __ptr    = __base + __offset;
+    const auto STEP     = LOAD_U16(__ptr + ENTRY_SIZE);
+    const auto ENTRIES  = LOAD_U32(__ptr + ENTRY_NUMBER);
+    if (entry >= ENTRIES || STEP < IMAGE_ENTRY::V2_0_SIZE) return false;
+    
+    const auto __entry  = __ptr + HEADER_V1_0_SIZE + Size(entry) * STEP;
+    const auto offset   = LOAD_U64(__entry + IMAGE_ENTRY::LAYER_EXTENTS_OFFSET);
+    return offset != NULL_OFFSET && offset < __size;
+}
+LAYER_EXTENTS IMAGE_ARRAY::get_image_extents(const BYTE* __base, uint32_t entry) const
+{
+#ifdef __EMSCRIPTEN__
+    __base = check_and_fetch_remote(__base);
+#endif
+    if (image_pyramid(__base, entry) == false) throw std::runtime_error
+        ("Failed to retrieve associated image layer extents -- image entry (" +
+         std::to_string(entry) + ") is not a tiled image.");
+    
+    const auto __ptr    = __base + __offset;
+    const auto __entry  = __ptr + HEADER_V1_0_SIZE + Size(entry) * LOAD_U16(__ptr + ENTRY_SIZE);
+    const auto __LAYER_EXTENTS = LAYER_EXTENTS
+    (LOAD_U64(__entry + IMAGE_ENTRY::LAYER_EXTENTS_OFFSET), __size, __version);
+    
+    const auto result = __LAYER_EXTENTS.validate_offset(__base);
+    if (result & IRIS_VALIDATION_FAILURE) throw std::runtime_error
+        ("Failed to retrieve associated image layer extents:" + result.message);
+    else if (result & IRIS_WARNING) printf
+        ("Retrieve associated image layer extents WARNING: %s", result.message.c_str());
+    
+    return __LAYER_EXTENTS;
+}
+TILE_OFFSETS IMAGE_ARRAY::get_image_offsets(const BYTE* __base, uint32_t entry) const
+{
+#ifdef __EMSCRIPTEN__
+    __base = check_and_fetch_remote(__base);
+#endif
+    if (image_pyramid(__base, entry) == false) throw std::runtime_error
+        ("Failed to retrieve associated image tile offsets -- image entry (" +
+         std::to_string(entry) + ") is not a tiled image.");
+    
+    const auto __ptr    = __base + __offset;
+    const auto __entry  = __ptr + HEADER_V1_0_SIZE + Size(entry) * LOAD_U16(__ptr + ENTRY_SIZE);
+    const auto __TILE_OFFSETS = TILE_OFFSETS
+    (LOAD_U64(__entry + IMAGE_ENTRY::TILE_OFFSETS_OFFSET), __size, __version);
+    
+    const auto result = __TILE_OFFSETS.validate_offset(__base);
+    if (result & IRIS_VALIDATION_FAILURE) throw std::runtime_error
+        ("Failed to retrieve associated image tile offsets:" + result.message);
+    else if (result & IRIS_WARNING) printf
+        ("Retrieve associated image tile offsets WARNING: %s", result.message.c_str());
+    
+    return __TILE_OFFSETS;
+}
 #ifdef __EMSCRIPTEN__
-void IMAGE_ARRAY::check_and_fetch_remote(const BYTE *const &base)
+const BYTE* IMAGE_ARRAY::check_and_fetch_remote (const BYTE* base) const
 {
-    if (!__response) {
-        const char* url = REINTERPRET_ARRAY_START(base);
-        __response      = FETCH_DATABLOCK(url,__remote, HEADER_SIZE);
-        __offset        = __ptr_size;
-        __response      = FETCH_DATABLOCK(url, __remote, size(base));
-    } const_cast<const BYTE*&>(base) = __response->data;
+    return FETCH_REMOTE_BLOCK(*this, base);
 }
 #else
 Size SIZE_IMAGES_ARRAY (AssociatedImageCreateInfo& info)
@@ -2483,6 +5587,8 @@ void STORE_IMAGES_ARRAY (BYTE* const __base, const AssociatedImageCreateInfo& in
             ("Failed to store associated image -- undefined source pixel format (" +
              std::to_string(image.info.sourceFormat) +
              "). Per the IFE specification Section 2.4.6, The format parameter shall describe the pixel channel ordering and bits consumed per channel using one of the defined enumerated values (Enumeration 2.2.3), excluding the undefined value (0).");
+        if ((image.layerExtentsOffset == NULL_OFFSET) != (image.tileOffsetsOffset == NULL_OFFSET)) throw std::runtime_error
+            ("Failed to store associated image -- a tiled associated image shall reference both a layer extents array and a tile offsets array.");
         #endif
         STORE_U64(__ptr + IMAGE_ENTRY::BYTES_OFFSET,    image.offset);
         STORE_U32(__ptr + IMAGE_ENTRY::WIDTH,           image.info.width);
@@ -2490,9 +5596,36 @@ void STORE_IMAGES_ARRAY (BYTE* const __base, const AssociatedImageCreateInfo& in
         STORE_U8 (__ptr + IMAGE_ENTRY::ENCODING,        image.info.encoding);
         STORE_U8 (__ptr + IMAGE_ENTRY::FORMAT,          image.info.sourceFormat);
         STORE_U16(__ptr + IMAGE_ENTRY::ORIENTATION,     image.info.orientation);
+        STORE_U64(__ptr + IMAGE_ENTRY::LAYER_EXTENTS_OFFSET, image.layerExtentsOffset);
+        STORE_U64(__ptr + IMAGE_ENTRY::TILE_OFFSETS_OFFSET,  image.tileOffsetsOffset);
         __ptr += IMAGE_ENTRY::SIZE;
     }
 }
+LayerExtents ASSOCIATED_IMAGE_EXTENTS (uint32_t width, uint32_t height, const TileExtent& tile)
+{
+    if (width == 0 || height == 0) throw std::runtime_error
+        ("Failed to generate associated image extents -- the image width and height shall be greater than zero.");
+    if (tile.width < 1 || tile.height < 1) throw std::runtime_error
+        ("Failed to generate associated image extents -- tile extents shall have a width and height greater than zero.");
+    
+    // Halve the resolution until the lowest resolution layer fits within a single tile
+    uint32_t layers = 1;
+    for (Size w = width, h = height; w > tile.width || h > tile.height; w = (w+1)/2, h = (h+1)/2)
+        ++layers;
+    
+    LayerExtents extents (layers);
+    for (uint32_t LI = 0; LI < layers; ++LI) {
+        const auto shift    = layers - 1 - LI;
+        const Size w        = ((Size(width)  - 1) >> shift) + 1;
+        const Size h        = ((Size(height) - 1) >> shift) + 1;
+        auto& extent        = extents[LI];
+        extent.xTiles       = U32_CAST((w + tile.width  - 1) / tile.width);
+        extent.yTiles       = U32_CAST((h + tile.height - 1) / tile.height);
+        extent.scale        = std::ldexp(1.f, LI);
+        extent.downsample   = std::ldexp(1.f, shift);
+    }
+    return extents;
+}
 #endif
 // MARK: - IMAGE_BYTES
 IMAGE_BYTES::IMAGE_BYTES  (Offset offset, Size file_size, uint32_t version) noexcept :
@@ -2500,16 +5633,16 @@ DATA_BLOCK(offset, file_size, version)
 {
     
 }
-Size IMAGE_BYTES::size(const BYTE *const __base) const
+Size IMAGE_BYTES::size(const BYTE* __base) const
 {
 #ifdef __EMSCRIPTEN__
-    const_cast<IMAGE_BYTES&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
     const auto __ptr    = __base + __offset;
     const auto TITLE    = LOAD_U16(__ptr + TITLE_SIZE);
     const auto BYTES    = LOAD_U32(__ptr + IMAGE_SIZE);
     
-    Size size = HEADER_V1_0_SIZE + TITLE * BYTES;
+    Size size = HEADER_V1_0_SIZE + TITLE + BYTES;
     if (__version > IRIS_EXTENSION_1_0); else return size;
     
     // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
@@ -2518,16 +5651,16 @@ Size IMAGE_BYTES::size(const BYTE *const __base) const
     
     return size;
 }
-Result IMAGE_BYTES::validate_offset(const BYTE *const __base) const noexcept {
+Result IMAGE_BYTES::validate_offset(const BYTE* __base) const noexcept {
 #ifdef __EMSCRIPTEN__
-    const_cast<IMAGE_BYTES&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
     return DATA_BLOCK::validate_offset(__base, type, recovery);
 }
-Result IMAGE_BYTES::validate_full (const BYTE *const __base) const noexcept
+Result IMAGE_BYTES::validate_full (const BYTE* __base) const noexcept
 {
 #ifdef __EMSCRIPTEN__
-    const_cast<IMAGE_BYTES&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
     auto result         = validate_offset(__base);
     if (result & IRIS_FAILURE) return result;
@@ -2537,7 +5670,8 @@ Result IMAGE_BYTES::validate_full (const BYTE *const __base) const noexcept
     const auto BYTES    = LOAD_U32(__ptr + IMAGE_SIZE);
     if (TITLE == 0 || TITLE > UINT16_MAX) return Iris::Result
         (IRIS_VALIDATION_FAILURE,"Associated image title failed validation due to length. Per IFE Section 2.4.7, title size shall encode a size, in bytes, greater than zero but shorter in length than the 16-bit max of a valid and unique image title / label");
-    if (BYTES == 0 || BYTES > UINT32_MAX) return Iris::Result
+    // Version 2 tiled images store a title only (see IMAGE_ARRAY::validate_full)
+    if ((BYTES == 0 && __version <= IRIS_EXTENSION_1_0) || BYTES > UINT32_MAX) return Iris::Result
         (IRIS_VALIDATION_FAILURE,"Associated image bytes failed validation due to length. Per IFE Section 2.4.7, image size shall encode a size, in bytes, greater than zero bytes but less than the 32-bit max (4.29 GB) of a valid encoded image byte stream");
     if (__offset + TITLE + BYTES > __size) return Result
         (IRIS_FAILURE,"Associated image IMAGE_BYTES failed validation -- image bytes array block (location "+
@@ -2547,10 +5681,10 @@ Result IMAGE_BYTES::validate_full (const BYTE *const __base) const noexcept
     
     return result;
 }
-std::string IMAGE_BYTES::read_image_bytes(const BYTE *const __base, Abstraction::AssociatedImage &image) const
+std::string IMAGE_BYTES::read_image_bytes(const BYTE* __base, Abstraction::AssociatedImage &image) const
 {
 #ifdef __EMSCRIPTEN__
-    const_cast<IMAGE_BYTES&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
     const auto __ptr    = __base + __offset;
     const auto TITLE    = LOAD_U16(__ptr + TITLE_SIZE);
@@ -2569,7 +5703,7 @@ std::string IMAGE_BYTES::read_image_bytes(const BYTE *const __base, Abstraction:
     image.offset    = start + TITLE;
     if (TITLE == 0 || TITLE > UINT16_MAX) throw std::runtime_error
         ("Associated image title failed validation due to length. Per IFE Section 2.4.7, title size shall encode a size, in bytes, greater than zero but shorter in length than the 16-bit max of a valid and unique image title / label");
-    if (image.byteSize == 0 || image.byteSize > UINT32_MAX) throw std::runtime_error
+    if ((image.byteSize == 0 && __version <= IRIS_EXTENSION_1_0) || image.byteSize > UINT32_MAX) throw std::runtime_error
         ("Associated image bytes failed validation due to length. Per IFE Section 2.4.7, image size shall encode a size, in bytes, greater than zero bytes but less than the 32-bit max (4.29 GB) of a valid encoded image byte stream");
     if (image.offset + image.byteSize > __size) throw std::runtime_error
         ("Read_image_bytes failed validation -- image bytes block ("+
@@ -2586,14 +5720,9 @@ std::string IMAGE_BYTES::read_image_bytes(const BYTE *const __base, Abstraction:
     return title;
 }
 #ifdef __EMSCRIPTEN__
-void IMAGE_BYTES::check_and_fetch_remote(const BYTE *const &base)
+const BYTE* IMAGE_BYTES::check_and_fetch_remote (const BYTE* base) const
 {
-if (!__response) {
-        const char* url = REINTERPRET_ARRAY_START(base);
-        __response      = FETCH_DATABLOCK(url,__remote, HEADER_SIZE);
-        __offset        = __ptr_size;
-        __response      = FETCH_DATABLOCK(url,__remote, size(base));
-    } const_cast<const BYTE*&>(base) = __response->data;
+    return FETCH_REMOTE_BLOCK(*this, base);
 }
 #else
 Size SIZE_IMAGES_BYTES(const ImageBytesCreateInfo &image)
@@ -2610,8 +5739,10 @@ void STORE_IMAGES_BYTES(BYTE *const __base, const ImageBytesCreateInfo& info)
         ("Failed to store associated image bytes -- No title/label given to the associated image. Per the IFE specification Section 2.4.7, an associated image shall contain a valid and unique title/label.");
     if (info.title.size() > UINT16_MAX) throw std::runtime_error
         ("Failed to store associated image bytes -- Title/label too long. Per the IFE specification Section 2.4.7, an associated image title shall be encoded in ASCII and be shorter in length than the 16-bit max.");
-    if (!info.data || !info.dataBytes) throw std::runtime_error
+    if (!info.tiled && (!info.data || !info.dataBytes)) throw std::runtime_error
         ("Failed to store associated image bytes -- No image data was provided. Per the IFE specification Section 2.4.7, an associated image bytestream shall comprise a valid array of compressed image bytes.");
+    if (info.tiled && info.dataBytes) throw std::runtime_error
+        ("Failed to store associated image bytes -- the image bytes of a tiled associated image shall contain the title only; the tiles are located by the image pyramid.");
     if (info.dataBytes > UINT32_MAX) throw std::runtime_error
         ("Failed to store associated image bytes -- Image too large. Per the IFE specification Section 2.4.7, an associated image bytestream shall be less than the 32-bit max (4.29 GB)");
     #endif
@@ -2625,7 +5756,7 @@ void STORE_IMAGES_BYTES(BYTE *const __base, const ImageBytesCreateInfo& info)
     __ptr += IMAGE_BYTES::HEADER_SIZE;
     std::memcpy(__ptr, info.title.data(), info.title.size());
     __ptr += info.title.size();
-    std::memcpy(__ptr, info.data, info.dataBytes);
+    if (info.dataBytes) std::memcpy(__ptr, info.data, info.dataBytes);
     return;
 }
 #endif
@@ -2635,10 +5766,10 @@ DATA_BLOCK(offset, file_size, version)
 {
     
 }
-Size ICC_PROFILE::size(const BYTE *const __base) const
+Size ICC_PROFILE::size(const BYTE* __base) const
 {
 #ifdef __EMSCRIPTEN__
-    const_cast<ICC_PROFILE&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
     const auto __ptr    = __base + __offset;
     const auto BYTES    = LOAD_U32(__ptr + ENTRY_NUMBER);
@@ -2652,16 +5783,16 @@ Size ICC_PROFILE::size(const BYTE *const __base) const
     
     return size;
 }
-Result ICC_PROFILE::validate_offset(const BYTE *const __base) const noexcept {
+Result ICC_PROFILE::validate_offset(const BYTE* __base) const noexcept {
 #ifdef __EMSCRIPTEN__
-    const_cast<ICC_PROFILE&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
     return DATA_BLOCK::validate_offset(__base, type, recovery);
 }
-Result ICC_PROFILE::validate_full(const BYTE *const __base) const noexcept
+Result ICC_PROFILE::validate_full(const BYTE* __base) const noexcept
 {
 #ifdef __EMSCRIPTEN__
-    const_cast<ICC_PROFILE&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
     auto result         = validate_offset(__base);
     if (result & IRIS_FAILURE) return result;
@@ -2683,10 +5814,10 @@ Result ICC_PROFILE::validate_full(const BYTE *const __base) const noexcept
          "bytes) extends beyond the end of the file.");
     return result;
 }
-std::string ICC_PROFILE::read_profile (const BYTE *const __base) const
+std::string ICC_PROFILE::read_profile (const BYTE* __base) const
 {
 #ifdef __EMSCRIPTEN__
-    const_cast<ICC_PROFILE&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
     const auto __ptr    = __base + __offset;
     const auto BYTES    = LOAD_U32(__ptr + ENTRY_NUMBER);
@@ -2710,14 +5841,9 @@ std::string ICC_PROFILE::read_profile (const BYTE *const __base) const
     return std::string((char*)__bytes, BYTES);
 }
 #ifdef __EMSCRIPTEN__
-void ICC_PROFILE::check_and_fetch_remote(const BYTE *const &base)
+const BYTE* ICC_PROFILE::check_and_fetch_remote (const BYTE* base) const
 {
-if (!__response) {
-        const char* url = REINTERPRET_ARRAY_START(base);
-        __response      = FETCH_DATABLOCK(url,__remote, HEADER_SIZE);
-        __offset        = __ptr_size;
-        __response      = FETCH_DATABLOCK(url,__remote, size(base));
-    } const_cast<const BYTE*&>(base) = __response->data;
+    return FETCH_REMOTE_BLOCK(*this, base);
 }
 #else
 Size SIZE_ICC_COLOR_PROFILE(const std::string &color_profile)
@@ -2747,34 +5873,35 @@ DATA_BLOCK(offset, file_size, version)
 {
     
 }
-Size ANNOTATIONS::size(const BYTE *const __base) const
+Size ANNOTATIONS::size(const BYTE* __base) const
 {
 #ifdef __EMSCRIPTEN__
-    const_cast<ANNOTATIONS&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
     const auto __ptr    = __base + __offset;
     const auto STEP     = LOAD_U16(__ptr + ENTRY_SIZE);
     const auto ENTRIES  = LOAD_U32(__ptr + ENTRY_NUMBER);
     
-    Size size = HEADER_V1_0_SIZE + STEP * ENTRIES;
+    Size size = HEADER_V1_0_SIZE + Size(STEP) * ENTRIES;
     if (__version > IRIS_EXTENSION_1_0); else return size;
     
     // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
     // VERSION CONTROL: VERSION 2
     // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
+    size += HEADER_V2_0_SIZE - HEADER_V1_0_SIZE;
     
     return size;
 }
-Result ANNOTATIONS::validate_offset(const BYTE *const __base) const noexcept {
+Result ANNOTATIONS::validate_offset(const BYTE* __base) const noexcept {
 #ifdef __EMSCRIPTEN__
-    const_cast<ANNOTATIONS&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
     return DATA_BLOCK::validate_offset(__base, type, recovery);
 }
-Result ANNOTATIONS::validate_full (const BYTE *const __base) const noexcept
+Result ANNOTATIONS::validate_full (const BYTE* __base) const noexcept
 {
 #ifdef __EMSCRIPTEN__
-    const_cast<ANNOTATIONS&>(*this).check_and_fetch_remote(__base);
+    __base = fetch_remote_entries(__base);
 #endif
     auto result         = validate_offset(__base);
     if (result & IRIS_FAILURE) return result;
@@ -2783,18 +5910,25 @@ Result ANNOTATIONS::validate_full (const BYTE *const __base) const noexcept
     const auto STEP     = LOAD_U16(__ptr + ENTRY_SIZE);
     const auto ENTRIES  = LOAD_U32(__ptr + ENTRY_NUMBER);
     Offset start        = 0;
+    AnnotationIndex index;
     
+    if (ENTRIES && STEP < ANNOTATION_ENTRY::SIZE) return Result
+        (IRIS_FAILURE, "ANNOTATIONS failed validation -- entry size ("+
+         std::to_string(STEP) +
+         " bytes) is smaller than an annotation entry ("+
+         std::to_string(ANNOTATION_ENTRY::SIZE) +
+         " bytes).");
     
     if (groups(__base)) {
         Size expected_bytes;
         auto __GROUP_SIZES = GROUP_SIZES
-        (LOAD_U64(__base + GROUP_SIZES_OFFSET), __size, __version);
+        (LOAD_U64(__ptr + GROUP_SIZES_OFFSET), __size, __version);
         result = __GROUP_SIZES.validate_full(__base, expected_bytes);
         if (result & IRIS_FAILURE) return result;
         
         
         auto __GROUP_BYTES = GROUP_BYTES
-        (LOAD_U64(__base + GROUP_BYTES_OFFSET), __size, __version);
+        (LOAD_U64(__ptr + GROUP_BYTES_OFFSET), __size, __version);
         result = __GROUP_BYTES.validate_full(__base, expected_bytes);
         if (result & IRIS_FAILURE) return result;
     }
@@ -2805,18 +5939,38 @@ Result ANNOTATIONS::validate_full (const BYTE *const __base) const noexcept
     // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
     // VERSION CONTROL: VERSION 2+ PARAMETERS ARE ADDED HERE
     // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
+    start = __offset + HEADER_V2_0_SIZE;
+    if (VALIDATE_TEXT_COMPRESSION((TextCompression)LOAD_U8(__ptr + COMPRESSION)) == false) return Result
+        (IRIS_FAILURE, "Undefined annotation text compression ("+
+         std::to_string(LOAD_U8(__ptr + COMPRESSION)) +
+         ") decoded from annotations array header.");
+    if (dictionary(__base)) {
+        auto __DICTIONARY = TEXT_DICTIONARY
+        (LOAD_U64(__ptr + DICTIONARY_OFFSET), __size, __version);
+        result = __DICTIONARY.validate_full(__base);
+        if (result & IRIS_FAILURE) return result;
+    }
+    if (spatial_index(__base)) try {
+        auto __INDEX = SPATIAL_INDEX
+        (LOAD_U64(__ptr + SPATIAL_INDEX_OFFSET), __size, __version);
+        result = __INDEX.validate_full(__base, ENTRIES);
+        if (result & IRIS_FAILURE) return result;
+        index = __INDEX.read_index(__base);
+    } catch (std::runtime_error& error) {
+        return Result (IRIS_FAILURE, error.what());
+    }
     
     VALIDATE_ANNOTATIONS:
     std::unordered_set<uint32_t> __a;
-    if (start + ENTRIES*STEP > __size) return Result
+    if (start + Size(ENTRIES)*STEP > __size) return Result
         (IRIS_FAILURE,"ANNOTATIONS::read_annotations failed validation -- bytes block ("+
          std::to_string(start) + "-" +
-         std::to_string(start + ENTRIES*STEP)+
+         std::to_string(start + Size(ENTRIES)*STEP)+
          "bytes) extends beyond the end of the file.");
     
     const BYTE* __array   = __base + start;
-    for (int AI = 0; AI < ENTRIES; ++AI, __array+=STEP) {
-        auto bytes_offset   = LOAD_U64(__array+IMAGE_ENTRY::BYTES_OFFSET);
+    for (uint32_t AI = 0; AI < ENTRIES; ++AI, __array+=STEP) {
+        auto bytes_offset   = LOAD_U64(__array+ANNOTATION_ENTRY::BYTES_OFFSET);
         if (bytes_offset == NULL_OFFSET) return Result
             (IRIS_FAILURE, "Failed ANNOTATION_ARRAY::read_annotations -- annotation entry contains invalid offset. Per the IFE Specification, the bytes offset shall be a valid offset location that point to the corresponding attribute object's attributes bytes array (Section 2.4.5).");
         if (bytes_offset > __size) return Result
@@ -2825,20 +5979,21 @@ Result ANNOTATIONS::validate_full (const BYTE *const __base) const noexcept
              "). Per the IFE Specification, the bytes offset shall be a valid offset location that point to the corresponding attribute object's attributes bytes array (Section 2.4.5).");
         
         auto __BYTES  = ANNOTATION_BYTES(bytes_offset, __size, __version);
-        __BYTES.validate_offset(__base);
+        result = __BYTES.validate_offset(__base);
+        if (result & IRIS_FAILURE) return result;
         
-        auto identifier = LOAD_U24(__ptr + ANNOTATION_ENTRY::IDENTIFIER);
-        if (__a.contains(identifier)) { printf
+        auto identifier = LOAD_U24(__array + ANNOTATION_ENTRY::IDENTIFIER);
+        if (__a.insert(identifier).second == false) { printf
             ("WARNING: duplicate annotation identifier (%X) returned. Per the IFE Specification Section 2.4.9, each annotation within the annotations array shall be referenced by a unique 24-bit identifier.",
              identifier);
         }
         
         if (VALIDATE_ANNOTATION_TYPE
-            ((AnnotationTypes)LOAD_U8(__ptr + ANNOTATION_ENTRY::FORMAT),
+            ((AnnotationTypes)LOAD_U8(__array + ANNOTATION_ENTRY::FORMAT),
              __version) == false) return Result
-            (IRIS_FAILURE,"Undefined tile pixel format ("+
-             std::to_string(LOAD_U8(__ptr + ANNOTATION_ENTRY::FORMAT)) +
-             ") decoded from tile table.");
+            (IRIS_FAILURE,"Undefined annotation format ("+
+             std::to_string(LOAD_U8(__array + ANNOTATION_ENTRY::FORMAT)) +
+             ") decoded from annotations array.");
         
         if (__version > IRIS_EXTENSION_1_0); else continue;
         
@@ -2847,73 +6002,70 @@ Result ANNOTATIONS::validate_full (const BYTE *const __base) const noexcept
         // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
         
     }
+    
+    // Spatially indexed entries must reside within the cell of their
+    // bucket and within the maximum indexed size, or viewport queries
+    // will silently miss annotations.
+    for (auto&& bucket : index.buckets) {
+        __array = __base + start + Size(bucket.first) * STEP;
+        for (uint32_t AI = 0; AI < bucket.number; ++AI, __array+=STEP) {
+            const auto cell = MORTON_ENCODE
+            (SPATIAL_CELL(LOAD_F32(__array + ANNOTATION_ENTRY::X_LOCATION), index.cellWidth, index.xCells),
+             SPATIAL_CELL(LOAD_F32(__array + ANNOTATION_ENTRY::Y_LOCATION), index.cellHeight, index.yCells));
+            if (cell != bucket.cell) return Result
+                (IRIS_FAILURE, "ANNOTATIONS failed validation -- annotation entry ("+
+                 std::to_string(bucket.first + AI) +
+                 ") location is not within the cell of its ANNOTATION_INDEX bucket. The spatial index does not describe the annotations array.");
+            if (fabsf(LOAD_F32(__array + ANNOTATION_ENTRY::X_SIZE)) > index.maxXSize ||
+                fabsf(LOAD_F32(__array + ANNOTATION_ENTRY::Y_SIZE)) > index.maxYSize) return Result
+                (IRIS_FAILURE, "ANNOTATIONS failed validation -- annotation entry ("+
+                 std::to_string(bucket.first + AI) +
+                 ") size exceeds the maximum annotation size recorded in the ANNOTATION_INDEX.");
+        }
+    }
     return result;
 }
-Abstraction::Annotations ANNOTATIONS::read_annotations(const BYTE *const __base, BYTES_ARRAY* __bytes_array) const
+Abstraction::Annotations ANNOTATIONS::read_annotations(const BYTE* __base, BYTES_ARRAY* __bytes_array) const
 {
 #ifdef __EMSCRIPTEN__
-    const_cast<ANNOTATIONS&>(*this).check_and_fetch_remote(__base);
+    __base = fetch_remote_entries(__base);
 #endif
     const auto __ptr    = __base + __offset;
     const auto STEP     = LOAD_U16(__ptr + ENTRY_SIZE);
     const auto ENTRIES  = LOAD_U32(__ptr + ENTRY_NUMBER);
     
     Offset start        = __offset + HEADER_V1_0_SIZE;
+    TEXT_DICTIONARY::Dictionary __dictionary;
     if (__version > IRIS_EXTENSION_1_0); else goto READ_ANNOTATIONS;
 
     // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
     // VERSION CONTROL: VERSION 2+ PARAMETERS ARE ADDED HERE
     // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
+    start = __offset + HEADER_V2_0_SIZE;
+    if (compression(__base) != TEXT_UNCOMPRESSED && dictionary(__base)) try {
+        __dictionary = get_dictionary(__base).read_dictionary(__base);
+    } catch (std::runtime_error& error) { printf
+        ("WARNING: %s Compressed annotation bytes cannot be decoded.\n", error.what());
+    }
     
     READ_ANNOTATIONS:
     Abstraction::Annotations annotations;
+    annotations.dictionary = __dictionary;
     const BYTE* __array   = __base + start;
-    if (start + ENTRIES*STEP > __size)
+    if (ENTRIES && STEP < ANNOTATION_ENTRY::SIZE)
+        throw std::runtime_error
+        ("ANNOTATIONS::read_annotations failed -- entry size ("+
+         std::to_string(STEP) +
+         " bytes) is smaller than an annotation entry. Did you validate?");
+    if (start + Size(ENTRIES)*STEP > __size)
         throw std::runtime_error
         ("ANNOTATIONS::read_annotations failed -- bytes block ("+
          std::to_string(start) + "-" +
-         std::to_string(start + ENTRIES*STEP)+
+         std::to_string(start + Size(ENTRIES)*STEP)+
          "bytes) extends beyond the end of the file.");
     
-    for (int AI = 0; AI < ENTRIES; ++AI, __array+=STEP) {
-        
-        auto bytes_offset   = LOAD_U64(__array+IMAGE_ENTRY::BYTES_OFFSET);
-        if (bytes_offset == NULL_OFFSET) throw std::runtime_error
-            ("Failed ANNOTATION_ARRAY::read_annotations -- annotation entry contains invalid offset");
-        if (bytes_offset > __size) throw std::runtime_error
-            ("Failed ANNOTATION_ARRAY::read_annotations -- annotation entry out of file bounds read");
-        
-        auto __BYTES  = ANNOTATION_BYTES(bytes_offset, __size, __version);
-        __BYTES.validate_offset(__base);
-        
-        auto identifier = LOAD_U24(__ptr + ANNOTATION_ENTRY::IDENTIFIER);
-        if (annotations.contains(identifier)) { printf
-            ("WARNING: duplicate annotation identifier (%X) returned; skipping duplicate. Per the IFE Specification Section 2.4.9, each annotation within the annotations array shall be referenced by a unique 24-bit identifier.", identifier);
-        }
-        
-        Abstraction::Annotation annotation;
-        __BYTES.read_bytes(__base, annotation);
-        annotation.type      = (AnnotationTypes)LOAD_U8(__ptr + ANNOTATION_ENTRY::FORMAT);
-        if (VALIDATE_ANNOTATION_TYPE(annotation.type, __version) == false)
-            throw std::runtime_error ("Undefined tile pixel format ("+
-                                      std::to_string(annotation.type) +
-                                      ") decoded from tile table.");
-        annotation.xLocation = LOAD_F32(__ptr + ANNOTATION_ENTRY::X_LOCATION);
-        annotation.yLocation = LOAD_F32(__ptr + ANNOTATION_ENTRY::Y_LOCATION);
-        annotation.xSize     = LOAD_F32(__ptr + ANNOTATION_ENTRY::X_SIZE);
-        annotation.ySize     = LOAD_F32(__ptr + ANNOTATION_ENTRY::Y_SIZE);
-        annotation.width     = LOAD_U32(__ptr + ANNOTATION_ENTRY::WIDTH);
-        annotation.height    = LOAD_U32(__ptr + ANNOTATION_ENTRY::HEIGHT);
-        annotation.parent    = LOAD_U24(__ptr + ANNOTATION_ENTRY::PARENT);
-        
-        
-        if (__version > IRIS_EXTENSION_1_0); else continue;
-        
-        // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
-        // VERSION CONTROL: VERSION 2+ PARAMETERS ARE ADDED HERE
-        // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
-        
-    }
+    for (uint32_t AI = 0; AI < ENTRIES; ++AI, __array+=STEP)
+        read_entry(__base, __array, annotations, __bytes_array);
     
     if (groups(__base))
     {
@@ -2926,52 +6078,334 @@ Abstraction::Annotations ANNOTATIONS::read_annotations(const BYTE *const __base,
     
     return annotations;
 }
-bool ANNOTATIONS::groups(const BYTE *const __base) const
+Abstraction::Annotations ANNOTATIONS::read_annotations(const BYTE* __base, const EntryRanges &ranges, BYTES_ARRAY *__bytes_array) const
+{
+#ifdef __EMSCRIPTEN__
+    // Only the array header is fetched; the requested
+    // entry ranges are individually fetched below.
+    __base = check_and_fetch_remote(__base);
+#endif
+    const auto __ptr    = __base + __offset;
+    const auto STEP     = LOAD_U16(__ptr + ENTRY_SIZE);
+    const auto ENTRIES  = LOAD_U32(__ptr + ENTRY_NUMBER);
+    
+    Offset start        = __offset + HEADER_V1_0_SIZE;
+    TEXT_DICTIONARY::Dictionary __dictionary;
+    if (__version > IRIS_EXTENSION_1_0); else goto READ_ANNOTATIONS;
+    
+    // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
+    // VERSION CONTROL: VERSION 2+ PARAMETERS ARE ADDED HERE
+    // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
+    start = __offset + HEADER_V2_0_SIZE;
+    if (compression(__base) != TEXT_UNCOMPRESSED && dictionary(__base)) try {
+        __dictionary = get_dictionary(__base).read_dictionary(__base);
+    } catch (std::runtime_error& error) { printf
+        ("WARNING: %s Compressed annotation bytes cannot be decoded.\n", error.what());
+    }
+    
+    READ_ANNOTATIONS:
+    // Annotation groups reference the full array and are not read here.
+    // Use get_group_sizes and get_group_bytes should groups be required.
+    Abstraction::Annotations annotations;
+    annotations.dictionary = __dictionary;
+    if (ENTRIES && STEP < ANNOTATION_ENTRY::SIZE)
+        throw std::runtime_error
+        ("ANNOTATIONS::read_annotations failed -- entry size ("+
+         std::to_string(STEP) +
+         " bytes) is smaller than an annotation entry. Did you validate?");
+    for (auto&& range : ranges) {
+        if (range.number == 0) continue;
+        if (Size(range.first) + range.number > ENTRIES)
+            throw std::runtime_error
+            ("ANNOTATIONS::read_annotations failed -- entry range ("+
+             std::to_string(range.first) + "-" +
+             std::to_string(Size(range.first) + range.number) +
+             ") exceeds the number of annotation entries ("+
+             std::to_string(ENTRIES) + ").");
+#ifndef __EMSCRIPTEN__
+        const Offset range_start = start + Size(range.first) * STEP;
+        if (range_start + Size(range.number) * STEP > __size)
+            throw std::runtime_error
+            ("ANNOTATIONS::read_annotations failed -- entry range ("+
+             std::to_string(range_start) + "-" +
+             std::to_string(range_start + Size(range.number) * STEP)+
+             "bytes) extends beyond the end of the file.");
+        const BYTE* __array = __base + range_start;
+#else
+        const auto response = FETCH_DATABLOCK
+        (REINTERPRET_ARRAY_START(__base),
+         __remote + (start - __offset) + Size(range.first) * STEP,
+         Size(range.number) * STEP);
+        if (!response) throw std::runtime_error
+            ("ANNOTATIONS::read_annotations failed -- could not fetch annotation entry range ("+
+             std::to_string(range.first) + "-" +
+             std::to_string(Size(range.first) + range.number) + ")");
+        const BYTE* __array = response->data + __ptr_size;
+#endif
+        for (uint32_t AI = 0; AI < range.number; ++AI, __array+=STEP)
+            read_entry(__base, __array, annotations, __bytes_array);
+    }
+    return annotations;
+}
+void ANNOTATIONS::read_entry(const BYTE *const __base, const BYTE *const __entry, Annotations &annotations, BYTES_ARRAY *__bytes_array) const
+{
+    auto bytes_offset   = LOAD_U64(__entry + ANNOTATION_ENTRY::BYTES_OFFSET);
+    if (bytes_offset == NULL_OFFSET) throw std::runtime_error
+        ("Failed ANNOTATION_ARRAY::read_annotations -- annotation entry contains invalid offset");
+    if (bytes_offset > __size) throw std::runtime_error
+        ("Failed ANNOTATION_ARRAY::read_annotations -- annotation entry out of file bounds read");
+    
+    auto identifier = LOAD_U24(__entry + ANNOTATION_ENTRY::IDENTIFIER);
+    if (annotations.contains(identifier)) { printf
+        ("WARNING: duplicate annotation identifier (%X) returned; skipping duplicate. Per the IFE Specification Section 2.4.9, each annotation within the annotations array shall be referenced by a unique 24-bit identifier.", identifier);
+        return;
+    }
+    
+    auto __BYTES  = ANNOTATION_BYTES(bytes_offset, __size, __version);
+    auto result   = __BYTES.validate_offset(__base);
+    if (result & IRIS_FAILURE) throw std::runtime_error
+        ("Failed ANNOTATION_ARRAY::read_annotations -- " + result.message);
+    
+    Abstraction::Annotation annotation;
+    __BYTES.read_bytes(__base, annotation);
+    annotation.type      = (AnnotationTypes)LOAD_U8(__entry + ANNOTATION_ENTRY::FORMAT);
+    if (VALIDATE_ANNOTATION_TYPE(annotation.type, __version) == false)
+        throw std::runtime_error ("Undefined annotation format ("+
+                                  std::to_string(annotation.type) +
+                                  ") decoded from annotations array.");
+    annotation.xLocation = LOAD_F32(__entry + ANNOTATION_ENTRY::X_LOCATION);
+    annotation.yLocation = LOAD_F32(__entry + ANNOTATION_ENTRY::Y_LOCATION);
+    annotation.xSize     = LOAD_F32(__entry + ANNOTATION_ENTRY::X_SIZE);
+    annotation.ySize     = LOAD_F32(__entry + ANNOTATION_ENTRY::Y_SIZE);
+    annotation.width     = LOAD_U32(__entry + ANNOTATION_ENTRY::WIDTH);
+    annotation.height    = LOAD_U32(__entry + ANNOTATION_ENTRY::HEIGHT);
+    annotation.parent    = LOAD_U24(__entry + ANNOTATION_ENTRY::PARENT);
+    if (__version > IRIS_EXTENSION_1_0); else goto INSERT_ANNOTATION;
+    
+    // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
+    // VERSION CONTROL: VERSION 2+ PARAMETERS ARE ADDED HERE
+    // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
+    // Only text and SVG annotation bytes are compressed
+    switch (annotation.type) {
+        case Iris::ANNOTATION_SVG:
+        case Iris::ANNOTATION_TEXT: annotation.compression = compression(__base); break;
+        default: break;
+    }
+    
+    INSERT_ANNOTATION:
+    if (__bytes_array) __bytes_array->push_back(__BYTES);
+    annotations[identifier] = annotation;
+}
+bool ANNOTATIONS::groups(const BYTE* __base) const
+{
+#ifdef __EMSCRIPTEN__
+    __base = check_and_fetch_remote(__base);
+#endif
+    auto SIZES_OFFSET = LOAD_U64(__base + __offset + GROUP_SIZES_OFFSET);
+    auto BYTES_OFFSET = LOAD_U64(__base + __offset + GROUP_BYTES_OFFSET);
+    return  SIZES_OFFSET != NULL_OFFSET && SIZES_OFFSET < __size &&
+            BYTES_OFFSET != NULL_OFFSET && BYTES_OFFSET < __size;
+}
+ANNOTATION_GROUP_SIZES ANNOTATIONS::get_group_sizes(const BYTE* __base) const
+{
+#ifdef __EMSCRIPTEN__
+    __base = check_and_fetch_remote(__base);
+#endif
+    auto __GROUP_SIZES = ANNOTATION_GROUP_SIZES
+    (LOAD_U64(__base + __offset + GROUP_SIZES_OFFSET), __size, __version);
+    
+    auto result = __GROUP_SIZES.validate_offset(__base);
+    if (result & IRIS_FAILURE) throw std::runtime_error(result.message);
+    return __GROUP_SIZES;
+}
+ANNOTATION_GROUP_BYTES ANNOTATIONS::get_group_bytes(const BYTE* __base) const
+{
+#ifdef __EMSCRIPTEN__
+    __base = check_and_fetch_remote(__base);
+#endif
+    auto offset = LOAD_U64(__base + __offset + GROUP_BYTES_OFFSET);
+    if (offset == NULL_OFFSET || offset > __size) throw std::runtime_error
+        ("Invalid tile table offset value for ANNOTATION_GROUP_BYTES array.");
+    auto __BYTES = ANNOTATION_GROUP_BYTES(offset, __size, __version);
+    
+    __BYTES.validate_offset(__base);
+    return __BYTES;
+}
+bool ANNOTATIONS::spatial_index(const BYTE* __base) const
+{
+#ifdef __EMSCRIPTEN__
+    __base = check_and_fetch_remote(__base);
+#endif
+    if (__version > IRIS_EXTENSION_1_0); else return false;
+    
+    // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
+    // VERSION CONTROL: VERSION 2
+    // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
+    auto INDEX_OFFSET = LOAD_U64(__base + __offset + SPATIAL_INDEX_OFFSET);
+    return INDEX_OFFSET != NULL_OFFSET && INDEX_OFFSET < __size;
+}
+TextCompression ANNOTATIONS::compression(const BYTE* __base) const
+{
+#ifdef __EMSCRIPTEN__
+    __base = check_and_fetch_remote(__base);
+#endif
+    if (__version > IRIS_EXTENSION_1_0); else return TEXT_UNCOMPRESSED;
+    auto compression = (TextCompression)LOAD_U8(__base + __offset + COMPRESSION);
+    if (VALIDATE_TEXT_COMPRESSION(compression) == false) throw std::runtime_error
+        ("Undefined annotation text compression ("+
+         std::to_string(compression) +
+         ") decoded from annotations array header.");
+    return compression;
+}
+bool ANNOTATIONS::dictionary(const BYTE* __base) const
 {
 #ifdef __EMSCRIPTEN__
-    const_cast<ANNOTATIONS&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
-    auto SIZES_OFFSET = LOAD_U64(__base + __offset + GROUP_SIZES_OFFSET);
-    auto BYTES_OFFSET = LOAD_U64(__base + __offset + GROUP_BYTES_OFFSET);
-    return  SIZES_OFFSET != NULL_OFFSET && SIZES_OFFSET < __size &&
-            BYTES_OFFSET != NULL_OFFSET && BYTES_OFFSET < __size;
+    if (__version > IRIS_EXTENSION_1_0); else return false;
+    auto offset = LOAD_U64(__base + __offset + DICTIONARY_OFFSET);
+    return offset != NULL_OFFSET && offset < __size;
 }
-ANNOTATION_GROUP_SIZES ANNOTATIONS::get_group_sizes(const BYTE *const __base) const
+TEXT_DICTIONARY ANNOTATIONS::get_dictionary(const BYTE* __base) const
 {
 #ifdef __EMSCRIPTEN__
-    const_cast<ANNOTATIONS&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
-    auto __GROUP_SIZES = ANNOTATION_GROUP_SIZES
-    (LOAD_U64(__base + __offset + GROUP_SIZES_OFFSET), __size, __version);
+    if (dictionary(__base) == false) throw std::runtime_error
+        ("Invalid offset value for TEXT_DICTIONARY. The annotations array does not reference a text dictionary.");
+    auto __DICTIONARY = TEXT_DICTIONARY
+    (LOAD_U64(__base + __offset + DICTIONARY_OFFSET), __size, __version);
     
-    auto result = __GROUP_SIZES.validate_offset(__base);
+    auto result = __DICTIONARY.validate_offset(__base);
     if (result & IRIS_FAILURE) throw std::runtime_error(result.message);
-    return __GROUP_SIZES;
+    return __DICTIONARY;
 }
-ANNOTATION_GROUP_BYTES ANNOTATIONS::get_group_bytes(const BYTE *const __base) const
+ANNOTATION_INDEX ANNOTATIONS::get_spatial_index(const BYTE* __base) const
 {
 #ifdef __EMSCRIPTEN__
-    const_cast<ANNOTATIONS&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
-    auto offset = LOAD_U64(__base + __offset + GROUP_BYTES_OFFSET);
-    if (offset == NULL_OFFSET || offset > __size) throw std::runtime_error
-        ("Invalid tile table offset value for ANNOTATION_GROUP_BYTES array.");
-    auto __BYTES = ANNOTATION_GROUP_BYTES(offset, __size, __version);
+    if (spatial_index(__base) == false) throw std::runtime_error
+        ("Invalid offset value for ANNOTATION_INDEX. The annotations array does not contain a spatial index.");
+    auto __INDEX = ANNOTATION_INDEX
+    (LOAD_U64(__base + __offset + SPATIAL_INDEX_OFFSET), __size, __version);
     
-    __BYTES.validate_offset(__base);
-    return __BYTES;
+    auto result = __INDEX.validate_offset(__base);
+    if (result & IRIS_FAILURE) throw std::runtime_error(result.message);
+    return __INDEX;
+}
+Abstraction::AnnotationIndex ANNOTATIONS::read_spatial_index(const BYTE* __base) const
+{
+#ifdef __EMSCRIPTEN__
+    __base = check_and_fetch_remote(__base);
+#endif
+    const auto __ptr    = __base + __offset;
+    const auto STEP     = LOAD_U16(__ptr + ENTRY_SIZE);
+    const auto ENTRIES  = LOAD_U32(__ptr + ENTRY_NUMBER);
+    
+    auto __INDEX        = get_spatial_index(__base);
+    auto index          = __INDEX.read_index(__base);
+    if (index.buckets.size() &&
+        Size(index.buckets.back().first) + index.buckets.back().number > ENTRIES)
+        throw std::runtime_error
+        ("ANNOTATIONS::read_spatial_index failed -- ANNOTATION_INDEX buckets reference more entries than the annotations array contains ("+
+         std::to_string(ENTRIES) + "). Did you validate?");
+    
+    // Entry byte offsets are file offsets so that they may be fetched remotely
+#ifndef __EMSCRIPTEN__
+    index.entries       = __offset + HEADER_V2_0_SIZE;
+#else
+    index.entries       = __remote + HEADER_V2_0_SIZE;
+#endif
+    index.entrySize     = STEP;
+    return index;
 }
 #ifdef __EMSCRIPTEN__
-void ANNOTATIONS::check_and_fetch_remote(const BYTE *const &base)
+const BYTE* ANNOTATIONS::check_and_fetch_remote (const BYTE* base) const
+{
+    // The annotations entry array can be very large. Only the header
+    // is fetched here; full array readers use fetch_remote_entries.
+    return FETCH_REMOTE_HEADER(*this, base);
+}
+const BYTE* ANNOTATIONS::fetch_remote_entries (const BYTE* base) const
 {
-if (!__response) {
-        const char* url = REINTERPRET_ARRAY_START(base);
-        __response      = FETCH_DATABLOCK(url,__remote, HEADER_SIZE);
-        __offset        = __ptr_size;
-        __response      = FETCH_DATABLOCK(url,__remote, size(base));
-    } const_cast<const BYTE*&>(base) = __response->data;
+    return FETCH_REMOTE_SLOT(REMOTE_BLOCK(*this).entries, base, [this](const char* url) {
+        return FETCH_REMOTE_EXTENT(*this, url);
+    });
 }
 #else
+// Annotation entries that STORE_ANNOTATION_ARRAY skips (and warns about)
+// when encoding validation is enabled. Used to keep the spatial index
+// consistent with the stored annotation entries.
+inline bool ANNOTATION_ENTRY_STORED (const AnnotationArrayCreateInfo::AnnotationInfo& annotation)
+{
+    #if IrisCodecExtensionValidateEncoding
+    if (annotation.identifier >= Abstraction::Annotation::NULL_ID) return false;
+    if (annotation.bytesOffset == NULL_OFFSET) return false;
+    if (annotation.type == Iris::ANNOTATION_UNDEFINED) return false;
+    #endif
+    return true;
+}
+// Z-order of the stored annotation entries and the resulting spatial index
+// buckets. Entries within a cell remain in identifier order.
+struct AnnotationSpatialOrder {
+    using AnnotationInfo            = AnnotationArrayCreateInfo::AnnotationInfo;
+    using Entry                     = std::pair<uint32_t, const AnnotationInfo*>;
+    float                           cellWidth   = 1.f;
+    float                           cellHeight  = 1.f;
+    uint16_t                        xCells      = 1;
+    uint16_t                        yCells      = 1;
+    float                           maxXSize    = 0.f;
+    float                           maxYSize    = 0.f;
+    std::vector<Entry>              entries;
+    AnnotationIndex::Buckets        buckets;
+};
+// Target number of index cells along the longer axis when the
+// cell size is selected automatically.
+constexpr float ANNOTATION_INDEX_AUTO_CELLS = 64.f;
+static AnnotationSpatialOrder SPATIALLY_ORDER_ANNOTATIONS (const AnnotationArrayCreateInfo& info)
+{
+    AnnotationSpatialOrder order;
+    float x_extent = 0.f, y_extent = 0.f;
+    for (auto&& annotation : info.annotations) {
+        if (!ANNOTATION_ENTRY_STORED(annotation)) continue;
+        order.entries.push_back({0, &annotation});
+        if (annotation.xLocation > x_extent) x_extent = annotation.xLocation;
+        if (annotation.yLocation > y_extent) y_extent = annotation.yLocation;
+        if (fabsf(annotation.xSize) > order.maxXSize) order.maxXSize = fabsf(annotation.xSize);
+        if (fabsf(annotation.ySize) > order.maxYSize) order.maxYSize = fabsf(annotation.ySize);
+    }
+    if (!isfinite(x_extent)) x_extent = FLT_MAX;
+    if (!isfinite(y_extent)) y_extent = FLT_MAX;
+    
+    float cell = info.spatialCellSize;
+    if (!(cell > 0.f) || !isfinite(cell))
+        cell = std::max(x_extent, y_extent) / ANNOTATION_INDEX_AUTO_CELLS;
+    if (!(cell > 0.f)) cell = 1.f;
+    // The grid is limited to 16-bit cell coordinates per axis
+    order.cellWidth     = std::max(cell, x_extent / (UINT16_MAX - 1));
+    order.cellHeight    = std::max(cell, y_extent / (UINT16_MAX - 1));
+    order.xCells        = U16_CAST(std::min(floorf(x_extent / order.cellWidth) + 1.f, F32_CAST(UINT16_MAX)));
+    order.yCells        = U16_CAST(std::min(floorf(y_extent / order.cellHeight) + 1.f, F32_CAST(UINT16_MAX)));
+    
+    for (auto&& entry : order.entries)
+        entry.first = MORTON_ENCODE
+        (SPATIAL_CELL(entry.second->xLocation, order.cellWidth, order.xCells),
+         SPATIAL_CELL(entry.second->yLocation, order.cellHeight, order.yCells));
+    std::stable_sort(order.entries.begin(), order.entries.end(),
+                     [](const auto& a, const auto& b){return a.first < b.first;});
+    
+    for (uint32_t EI = 0; EI < order.entries.size(); ++EI) {
+        if (order.buckets.size() && order.buckets.back().cell == order.entries[EI].first)
+            order.buckets.back().number++;
+        else order.buckets.push_back({
+            .cell   = order.entries[EI].first,
+            .first  = EI,
+            .number = 1
+        });
+    }
+    return order;
+}
 Size SIZE_ANNOTATION_ARRAY(const AnnotationArrayCreateInfo &info)
 {
     #if IrisCodecExtensionValidateEncoding
@@ -2982,13 +6416,14 @@ Size SIZE_ANNOTATION_ARRAY(const AnnotationArrayCreateInfo &info)
         else size += ANNOTATION_ENTRY::SIZE;
     return size;
     #else
-    return ANNOTATION_ARRAY::HEADER_SIZE +
+    return ANNOTATIONS::HEADER_SIZE +
     ANNOTATION_ENTRY::SIZE * info.annotations.size();
     #endif
 }
 void STORE_ANNOTATION_ARRAY(BYTE *const __base, const AnnotationArrayCreateInfo &info)
 {
-    using Annotation = Abstraction::Annotation;
+    using Annotation        = Abstraction::Annotation;
+    using AnnotationInfo    = AnnotationArrayCreateInfo::AnnotationInfo;
     #if IrisCodecExtensionValidateEncoding
     if (info.offset == NULL_OFFSET) throw std::runtime_error
         ("Failed to store associated annotations array -- NULL_OFFSET provided as location");
@@ -2996,17 +6431,34 @@ void STORE_ANNOTATION_ARRAY(BYTE *const __base, const AnnotationArrayCreateInfo
         ("Failed to store annotations array -- array too large (" +
          std::to_string(info.annotations.size())+
          "). Per the IFE specification Section 2.4.9, the number of associated / ancillary images must be less than the 32-bit max value.");
+    if (VALIDATE_TEXT_COMPRESSION(info.compression) == false) throw std::runtime_error
+        ("Failed to store annotations array -- undefined text compression");
     #endif
     
+    // Spatially indexed arrays are stored in the Z-order of the index buckets
+    std::vector<const AnnotationInfo*> ordered;
+    ordered.reserve(info.annotations.size());
+    if (info.spatialIndex != NULL_OFFSET)
+        for (auto&& entry : SPATIALLY_ORDER_ANNOTATIONS(info).entries)
+            ordered.push_back(entry.second);
+    else for (auto&& annotation : info.annotations)
+        ordered.push_back(&annotation);
+    
     auto __ptr  = __base + info.offset;
-    STORE_U64(__ptr + ANNOTATIONS::VALIDATION,     info.offset);
-    STORE_U16(__ptr + ANNOTATIONS::RECOVERY,       RECOVER_ANNOTATIONS);
-    STORE_U16(__ptr + ANNOTATIONS::ENTRY_SIZE,     ANNOTATION_ENTRY::SIZE);
+    STORE_U64(__ptr + ANNOTATIONS::VALIDATION,          info.offset);
+    STORE_U16(__ptr + ANNOTATIONS::RECOVERY,            RECOVER_ANNOTATIONS);
+    STORE_U16(__ptr + ANNOTATIONS::ENTRY_SIZE,          ANNOTATION_ENTRY::SIZE);
+    STORE_U64(__ptr + ANNOTATIONS::GROUP_SIZES_OFFSET,  NULL_OFFSET);
+    STORE_U64(__ptr + ANNOTATIONS::GROUP_BYTES_OFFSET,  NULL_OFFSET);
+    STORE_U64(__ptr + ANNOTATIONS::SPATIAL_INDEX_OFFSET,info.spatialIndex);
+    STORE_U8 (__ptr + ANNOTATIONS::COMPRESSION,         info.compression);
+    STORE_U64(__ptr + ANNOTATIONS::DICTIONARY_OFFSET,   info.dictionary);
     __ptr += ANNOTATIONS::HEADER_SIZE;
     
     int entries = 0;
-    for (auto&& annotation : info.annotations) {
-        
+    for (auto&& __annotation : ordered) {
+        auto& annotation = *__annotation;
+    
         #if IrisCodecExtensionValidateEncoding
         if (annotation.identifier >= Annotation::NULL_ID) { printf
             ("WARNING: Annotation does not contain a valid identifier. Per the IFE Specification, Section 2.4.9, each annotation within the annotations array shall be referenced by a unique 24-bit identifier.");
@@ -3029,7 +6481,7 @@ void STORE_ANNOTATION_ARRAY(BYTE *const __base, const AnnotationArrayCreateInfo
             const_cast<uint32_t&>(annotation.parent) = Annotation::NULL_ID;
         }
         #endif
-        
+    
         STORE_U24(__ptr + ANNOTATION_ENTRY::IDENTIFIER,     annotation.identifier);
         STORE_U64(__ptr + ANNOTATION_ENTRY::BYTES_OFFSET,   annotation.bytesOffset);
         STORE_U8 (__ptr + ANNOTATION_ENTRY::FORMAT,         annotation.type);
@@ -3047,16 +6499,221 @@ void STORE_ANNOTATION_ARRAY(BYTE *const __base, const AnnotationArrayCreateInfo
     STORE_U32(__base + info.offset + ANNOTATIONS::ENTRY_NUMBER, U32_CAST(entries));
 }
 #endif
+// MARK: - ANNOTATION INDEX
+ANNOTATION_INDEX::ANNOTATION_INDEX (Offset offset, Size file_size, uint32_t version) noexcept :
+DATA_BLOCK (offset, file_size, version)
+{
+    
+}
+Size ANNOTATION_INDEX::size(const BYTE* __base) const
+{
+#ifdef __EMSCRIPTEN__
+    __base = check_and_fetch_remote(__base);
+#endif
+    const auto __ptr    = __base + __offset;
+    const auto STEP     = LOAD_U16(__ptr + ENTRY_SIZE);
+    const auto ENTRIES  = LOAD_U32(__ptr + ENTRY_NUMBER);
+    
+    Size size = HEADER_V2_0_SIZE + Size(STEP) * ENTRIES;
+    if (__version > IRIS_EXTENSION_2_0); else return size;
+    
+    // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
+    // VERSION CONTROL: VERSION 3
+    // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
+    
+    return size;
+}
+Result ANNOTATION_INDEX::validate_offset(const BYTE* __base) const noexcept
+{
+#ifdef __EMSCRIPTEN__
+    __base = check_and_fetch_remote(__base);
+#endif
+    return DATA_BLOCK::validate_offset(__base, type, recovery);
+}
+// Header and bucket rules of an annotation index (block bytes in hand); shared
+// with the streaming validator. The bucket array shall already be bounds checked.
+inline Result VALIDATE_INDEX_BUCKETS (const BYTE* const __ptr, uint32_t annotations) noexcept
+{
+    using INDEX         = ANNOTATION_INDEX;
+    const auto STEP     = LOAD_U16(__ptr + INDEX::ENTRY_SIZE);
+    const auto ENTRIES  = LOAD_U32(__ptr + INDEX::ENTRY_NUMBER);
+    const auto CELL_W   = LOAD_F32(__ptr + INDEX::CELL_WIDTH);
+    const auto CELL_H   = LOAD_F32(__ptr + INDEX::CELL_HEIGHT);
+    const auto CELLS_X  = LOAD_U16(__ptr + INDEX::X_CELLS);
+    const auto CELLS_Y  = LOAD_U16(__ptr + INDEX::Y_CELLS);
+    const auto MAX_X    = LOAD_F32(__ptr + INDEX::MAX_X_SIZE);
+    const auto MAX_Y    = LOAD_F32(__ptr + INDEX::MAX_Y_SIZE);
+    
+    if (ENTRIES && STEP < ANNOTATION_BUCKET::SIZE) return Result
+        (IRIS_FAILURE, "ANNOTATION_INDEX failed validation -- entry size ("+
+         std::to_string(STEP) +
+         " bytes) is smaller than an index bucket ("+
+         std::to_string(ANNOTATION_BUCKET::SIZE) +
+         " bytes).");
+    if (!(CELL_W > 0.f) || !(CELL_H > 0.f) || !isfinite(CELL_W) || !isfinite(CELL_H)) return Result
+        (IRIS_FAILURE, "ANNOTATION_INDEX failed validation -- cell dimensions ("+
+         std::to_string(CELL_W) + "x" + std::to_string(CELL_H) +
+         ") shall be finite positive values.");
+    if (CELLS_X == 0 || CELLS_Y == 0) return Result
+        (IRIS_FAILURE, "ANNOTATION_INDEX failed validation -- the index grid contains no cells.");
+    if (!(MAX_X >= 0.f) || !(MAX_Y >= 0.f)) return Result
+        (IRIS_FAILURE, "ANNOTATION_INDEX failed validation -- maximum annotation sizes shall be non-negative values.");
+    
+    // Buckets shall be sorted by cell and shall contiguously
+    // cover every entry within the annotations array.
+    Size next_entry     = 0;
+    const BYTE* __array = __ptr + INDEX::HEADER_V2_0_SIZE;
+    for (uint32_t BI = 0; BI < ENTRIES; ++BI, __array += STEP) {
+        const auto CELL     = LOAD_U32(__array + ANNOTATION_BUCKET::CELL);
+        const auto FIRST    = LOAD_U32(__array + ANNOTATION_BUCKET::FIRST_ENTRY);
+        const auto NUMBER   = LOAD_U32(__array + ANNOTATION_BUCKET::ENTRY_NUMBER);
+        if (BI && CELL <= LOAD_U32(__array - STEP + ANNOTATION_BUCKET::CELL)) return Result
+            (IRIS_FAILURE, "ANNOTATION_INDEX failed validation -- bucket ("+
+             std::to_string(BI) +
+             ") is out of Z-order. Index buckets shall be sorted by unique cell.");
+        if (MORTON_DECODE_X(CELL) >= CELLS_X || MORTON_DECODE_Y(CELL) >= CELLS_Y) return Result
+            (IRIS_FAILURE, "ANNOTATION_INDEX failed validation -- bucket ("+
+             std::to_string(BI) +
+             ") cell lies outside of the index grid.");
+        if (FIRST != next_entry || NUMBER == 0) return Result
+            (IRIS_FAILURE, "ANNOTATION_INDEX failed validation -- bucket ("+
+             std::to_string(BI) +
+             ") does not begin at the end of the previous bucket or is empty.");
+        next_entry += NUMBER;
+    }
+    if (next_entry != annotations) return Result
+        (IRIS_FAILURE, "ANNOTATION_INDEX failed validation -- index buckets cover "+
+         std::to_string(next_entry) +
+         " entries but the annotations array contains " +
+         std::to_string(annotations) + " entries.");
+    return IRIS_SUCCESS;
+}
+Result ANNOTATION_INDEX::validate_full(const BYTE* __base, uint32_t annotations) const noexcept
+{
+#ifdef __EMSCRIPTEN__
+    __base = check_and_fetch_remote(__base);
+#endif
+    auto result         = validate_offset(__base);
+    if (result & IRIS_FAILURE) return result;
+    
+    const auto __ptr    = __base + __offset;
+    const auto STEP     = LOAD_U16(__ptr + ENTRY_SIZE);
+    const auto ENTRIES  = LOAD_U32(__ptr + ENTRY_NUMBER);
+    Offset start        = __offset + HEADER_V2_0_SIZE;
+    
+    if (start + Size(ENTRIES)*STEP > __size) return Result
+        (IRIS_FAILURE, "ANNOTATION_INDEX failed validation -- bucket array block ("+
+         std::to_string(start) + "-" +
+         std::to_string(start + Size(ENTRIES)*STEP)+
+         "bytes) extends beyond the end of the file.");
+    
+    if (__version > IRIS_EXTENSION_2_0); else goto VALIDATE_BUCKETS;
+    
+    // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
+    // VERSION CONTROL: VERSION 3+ PARAMETERS ARE ADDED HERE
+    // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
+    
+    VALIDATE_BUCKETS:
+    if (auto buckets = VALIDATE_INDEX_BUCKETS(__ptr, annotations); buckets & IRIS_FAILURE)
+        return buckets;
+    return result;
+}
+Abstraction::AnnotationIndex ANNOTATION_INDEX::read_index(const BYTE* __base) const
+{
+#ifdef __EMSCRIPTEN__
+    __base = check_and_fetch_remote(__base);
+#endif
+    const auto __ptr    = __base + __offset;
+    const auto STEP     = LOAD_U16(__ptr + ENTRY_SIZE);
+    const auto ENTRIES  = LOAD_U32(__ptr + ENTRY_NUMBER);
+    
+    AnnotationIndex index;
+    index.cellWidth     = LOAD_F32(__ptr + CELL_WIDTH);
+    index.cellHeight    = LOAD_F32(__ptr + CELL_HEIGHT);
+    index.xCells        = LOAD_U16(__ptr + X_CELLS);
+    index.yCells        = LOAD_U16(__ptr + Y_CELLS);
+    index.maxXSize      = LOAD_F32(__ptr + MAX_X_SIZE);
+    index.maxYSize      = LOAD_F32(__ptr + MAX_Y_SIZE);
+    
+    Offset start        = __offset + HEADER_V2_0_SIZE;
+    if (__version > IRIS_EXTENSION_2_0); else goto READ_BUCKETS;
+    
+    // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
+    // VERSION CONTROL: VERSION 3+ PARAMETERS ARE ADDED HERE
+    // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ //
+    
+    READ_BUCKETS:
+    if (ENTRIES && STEP < ANNOTATION_BUCKET::SIZE) throw std::runtime_error
+        ("ANNOTATION_INDEX::read_index failed -- entry size ("+
+         std::to_string(STEP) +
+         " bytes) is smaller than an index bucket. Did you validate?");
+    if (start + Size(ENTRIES)*STEP > __size) throw std::runtime_error
+        ("ANNOTATION_INDEX::read_index failed -- bucket array block ("+
+         std::to_string(start) + "-" +
+         std::to_string(start + Size(ENTRIES)*STEP)+
+         "bytes) extends beyond the end of the file.");
+    
+    index.buckets.resize(ENTRIES);
+    const BYTE* __array = __base + start;
+    for (auto&& bucket : index.buckets) {
+        bucket.cell     = LOAD_U32(__array + ANNOTATION_BUCKET::CELL);
+        bucket.first    = LOAD_U32(__array + ANNOTATION_BUCKET::FIRST_ENTRY);
+        bucket.number   = LOAD_U32(__array + ANNOTATION_BUCKET::ENTRY_NUMBER);
+        __array        += STEP;
+    }
+    return index;
+}
+#ifdef __EMSCRIPTEN__
+const BYTE* ANNOTATION_INDEX::check_and_fetch_remote (const BYTE* base) const
+{
+    return FETCH_REMOTE_BLOCK(*this, base);
+}
+#else
+Size SIZE_ANNOTATION_INDEX(const AnnotationArrayCreateInfo &info)
+{
+    return ANNOTATION_INDEX::HEADER_SIZE + ANNOTATION_BUCKET::SIZE *
+    SPATIALLY_ORDER_ANNOTATIONS(info).buckets.size();
+}
+void STORE_ANNOTATION_INDEX(BYTE *const __base, const AnnotationArrayCreateInfo &info)
+{
+    #if IrisCodecExtensionValidateEncoding
+    if (info.spatialIndex == NULL_OFFSET) throw std::runtime_error
+        ("Failed to store annotation spatial index -- NULL_OFFSET provided as location");
+    #endif
+    
+    const auto order    = SPATIALLY_ORDER_ANNOTATIONS(info);
+    
+    auto __ptr  = __base + info.spatialIndex;
+    STORE_U64(__ptr + ANNOTATION_INDEX::VALIDATION,     info.spatialIndex);
+    STORE_U16(__ptr + ANNOTATION_INDEX::RECOVERY,       RECOVER_ANNOTATION_INDEX);
+    STORE_U16(__ptr + ANNOTATION_INDEX::ENTRY_SIZE,     ANNOTATION_BUCKET::SIZE);
+    STORE_U32(__ptr + ANNOTATION_INDEX::ENTRY_NUMBER,   U32_CAST(order.buckets.size()));
+    STORE_F32(__ptr + ANNOTATION_INDEX::CELL_WIDTH,     order.cellWidth);
+    STORE_F32(__ptr + ANNOTATION_INDEX::CELL_HEIGHT,    order.cellHeight);
+    STORE_U16(__ptr + ANNOTATION_INDEX::X_CELLS,        order.xCells);
+    STORE_U16(__ptr + ANNOTATION_INDEX::Y_CELLS,        order.yCells);
+    STORE_F32(__ptr + ANNOTATION_INDEX::MAX_X_SIZE,     order.maxXSize);
+    STORE_F32(__ptr + ANNOTATION_INDEX::MAX_Y_SIZE,     order.maxYSize);
+    __ptr += ANNOTATION_INDEX::HEADER_SIZE;
+    
+    for (auto&& bucket : order.buckets) {
+        STORE_U32(__ptr + ANNOTATION_BUCKET::CELL,          bucket.cell);
+        STORE_U32(__ptr + ANNOTATION_BUCKET::FIRST_ENTRY,   bucket.first);
+        STORE_U32(__ptr + ANNOTATION_BUCKET::ENTRY_NUMBER,  bucket.number);
+        __ptr += ANNOTATION_BUCKET::SIZE;
+    }
+}
+#endif
 // MARK: - ANNOTATION BYTES
 ANNOTATION_BYTES::ANNOTATION_BYTES  (Offset offset, Size file_size, uint32_t version) noexcept :
 DATA_BLOCK(offset, file_size, version)
 {
     
 }
-Size ANNOTATION_BYTES::size(const BYTE *const __base) const
+Size ANNOTATION_BYTES::size(const BYTE* __base) const
 {
 #ifdef __EMSCRIPTEN__
-    const_cast<ANNOTATION_BYTES&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
     const auto __ptr    = __base + __offset;
     const auto BYTES    = LOAD_U32(__ptr + ENTRY_NUMBER);
@@ -3070,16 +6727,16 @@ Size ANNOTATION_BYTES::size(const BYTE *const __base) const
     
     return size;
 }
-Result ANNOTATION_BYTES::validate_offset(const BYTE *const __base) const noexcept {
+Result ANNOTATION_BYTES::validate_offset(const BYTE* __base) const noexcept {
 #ifdef __EMSCRIPTEN__
-    const_cast<ANNOTATION_BYTES&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
     return DATA_BLOCK::validate_offset(__base, type, recovery);
 }
-void ANNOTATION_BYTES::read_bytes(const BYTE *const __base, Annotation &annotation) const
+void ANNOTATION_BYTES::read_bytes(const BYTE* __base, Annotation &annotation) const
 {
 #ifdef __EMSCRIPTEN__
-    const_cast<ANNOTATION_BYTES&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
     const auto __ptr        = __base + __offset;
     annotation.byteSize     = LOAD_U32(__ptr + ENTRY_NUMBER);
@@ -3103,21 +6760,30 @@ void ANNOTATION_BYTES::read_bytes(const BYTE *const __base, Annotation &annotati
     return;
 }
 #ifdef __EMSCRIPTEN__
-void ANNOTATION_BYTES::check_and_fetch_remote(const BYTE *const &base)
+const BYTE* ANNOTATION_BYTES::check_and_fetch_remote (const BYTE* base) const
 {
-if (!__response) {
-        const char* url = REINTERPRET_ARRAY_START(base);
-        __response      = FETCH_DATABLOCK(url,__remote, HEADER_SIZE);
-        __offset        = __ptr_size;
-        __response      = FETCH_DATABLOCK(url,__remote, size(base));
-    } const_cast<const BYTE*&>(base) = __response->data;
+    return FETCH_REMOTE_BLOCK(*this, base);
 }
 #else
-Size SIZE_ANNOTATION_BYTES(const IrisCodec::Annotation &annotation)
+// Only text and SVG annotation bytes are compressed
+inline bool COMPRESS_ANNOTATION (const IrisCodec::Annotation& annotation, TextCompression compression)
+{
+    if (compression == TEXT_UNCOMPRESSED) return false;
+    switch (annotation.type) {
+        case Iris::ANNOTATION_SVG:
+        case Iris::ANNOTATION_TEXT: return true;
+        default:                    return false;
+    }
+}
+Size SIZE_ANNOTATION_BYTES(const IrisCodec::Annotation &annotation, TextCompression compression, const TextDictionary* dictionary)
 {
+    if (COMPRESS_ANNOTATION(annotation, compression))
+        return ANNOTATION_BYTES::HEADER_SIZE +
+        compress_text(annotation.data->data(), annotation.data->size(), dictionary).size();
     return ANNOTATION_BYTES::HEADER_SIZE + annotation.data->size();
 }
-void STORE_ANNOTATION_BYTES(BYTE *const __base, Offset offset, const IrisCodec::Annotation &annotation)
+void STORE_ANNOTATION_BYTES(BYTE *const __base, Offset offset, const IrisCodec::Annotation &annotation,
+                            TextCompression compression, const TextDictionary* dictionary)
 {
     auto& bytes = annotation.data;
     #if IrisCodecExtensionValidateEncoding
@@ -3142,9 +6808,16 @@ void STORE_ANNOTATION_BYTES(BYTE *const __base, Offset offset, const IrisCodec::
     auto __ptr = __base + offset;
     STORE_U64(__ptr + ANNOTATION_BYTES::VALIDATION, offset);
     STORE_U16(__ptr + ANNOTATION_BYTES::RECOVERY, RECOVER_ANNOTATION_BYTES);
+    
+    if (COMPRESS_ANNOTATION(annotation, compression)) {
+        const auto compressed = compress_text(bytes->data(), bytes->size(), dictionary);
+        STORE_U32(__ptr + ANNOTATION_BYTES::ENTRY_NUMBER, U32_CAST(compressed.size()));
+        memcpy(__ptr + ANNOTATION_BYTES::HEADER_SIZE, compressed.data(), compressed.size());
+        return;
+    }
     STORE_U32(__ptr + ANNOTATION_BYTES::ENTRY_NUMBER, U32_CAST(bytes->size()));
     
-    __ptr += IMAGE_BYTES::HEADER_SIZE;
+    __ptr += ANNOTATION_BYTES::HEADER_SIZE;
     memcpy(__ptr, bytes->data(), bytes->size());
     return;
 }
@@ -3155,10 +6828,10 @@ DATA_BLOCK (offset, file_size, version)
 {
     
 }
-Size ANNOTATION_GROUP_SIZES::size (const BYTE* const __base) const
+Size ANNOTATION_GROUP_SIZES::size (const BYTE* __base) const
 {
 #ifdef __EMSCRIPTEN__
-    const_cast<ANNOTATION_GROUP_SIZES&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
     const auto __ptr    = __base + __offset;
     const auto STEP     = LOAD_U16(__ptr + ENTRY_SIZE);
@@ -3173,16 +6846,16 @@ Size ANNOTATION_GROUP_SIZES::size (const BYTE* const __base) const
     
     return size;
 }
-Result ANNOTATION_GROUP_SIZES::validate_offset(const BYTE *const __base) const noexcept {
+Result ANNOTATION_GROUP_SIZES::validate_offset(const BYTE* __base) const noexcept {
 #ifdef __EMSCRIPTEN__
-    const_cast<ANNOTATION_GROUP_SIZES&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
     return DATA_BLOCK::validate_offset(__base, type, recovery);
 }
-Result ANNOTATION_GROUP_SIZES::validate_full (const BYTE *const __base, Size& expected_bytes) const noexcept
+Result ANNOTATION_GROUP_SIZES::validate_full (const BYTE* __base, Size& expected_bytes) const noexcept
 {
 #ifdef __EMSCRIPTEN__
-    const_cast<ANNOTATION_GROUP_SIZES&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
     auto result         = validate_offset(__base);
     if (result & IRIS_FAILURE) return result;
@@ -3221,10 +6894,10 @@ Result ANNOTATION_GROUP_SIZES::validate_full (const BYTE *const __base, Size& ex
     }
     return result;
 }
-ANNOTATION_GROUP_SIZES::GroupSizes ANNOTATION_GROUP_SIZES::read_group_sizes(const BYTE *const __base) const
+ANNOTATION_GROUP_SIZES::GroupSizes ANNOTATION_GROUP_SIZES::read_group_sizes(const BYTE* __base) const
 {
 #ifdef __EMSCRIPTEN__
-    const_cast<ANNOTATION_GROUP_SIZES&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
     const auto __ptr    = __base + __offset;
     const auto STEP     = LOAD_U16(__ptr + ENTRY_SIZE);
@@ -3262,14 +6935,9 @@ ANNOTATION_GROUP_SIZES::GroupSizes ANNOTATION_GROUP_SIZES::read_group_sizes(cons
     return sizes;
 }
 #ifdef __EMSCRIPTEN__
-void ANNOTATION_GROUP_SIZES::check_and_fetch_remote(const BYTE *const &base)
+const BYTE* ANNOTATION_GROUP_SIZES::check_and_fetch_remote (const BYTE* base) const
 {
-if (!__response) {
-        const char* url = REINTERPRET_ARRAY_START(base);
-        __response      = FETCH_DATABLOCK(url,__remote, HEADER_SIZE);
-        __offset        = __ptr_size;
-        __response      = FETCH_DATABLOCK(url,__remote, size(base));
-    } const_cast<const BYTE*&>(base) = __response->data;
+    return FETCH_REMOTE_BLOCK(*this, base);
 }
 #endif
 // MARK: - ANNOTATION_GROUP_BYTES
@@ -3278,10 +6946,10 @@ DATA_BLOCK(offset, file_size, version)
 {
     
 }
-Size ANNOTATION_GROUP_BYTES::size(const BYTE *const __base) const
+Size ANNOTATION_GROUP_BYTES::size(const BYTE* __base) const
 {
 #ifdef __EMSCRIPTEN__
-    const_cast<ANNOTATION_GROUP_BYTES&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
     const auto __ptr    = __base + __offset;
     const auto BYTES    = LOAD_U32(__ptr + ENTRY_NUMBER);
@@ -3295,16 +6963,16 @@ Size ANNOTATION_GROUP_BYTES::size(const BYTE *const __base) const
     
     return size;
 }
-Result ANNOTATION_GROUP_BYTES::validate_offset(const BYTE *const __base) const noexcept {
+Result ANNOTATION_GROUP_BYTES::validate_offset(const BYTE* __base) const noexcept {
 #ifdef __EMSCRIPTEN__
-    const_cast<ANNOTATION_GROUP_BYTES&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
     return DATA_BLOCK::validate_offset(__base, type, recovery);
 }
-Result ANNOTATION_GROUP_BYTES::validate_full (const BYTE *const __base, Size expected_bytes) const noexcept
+Result ANNOTATION_GROUP_BYTES::validate_full (const BYTE* __base, Size expected_bytes) const noexcept
 {
 #ifdef __EMSCRIPTEN__
-    const_cast<ANNOTATION_GROUP_BYTES&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
     const auto __ptr    = __base + __offset;
     const auto BYTES    = LOAD_U32(__ptr + ENTRY_NUMBER);
@@ -3322,10 +6990,10 @@ Result ANNOTATION_GROUP_BYTES::validate_full (const BYTE *const __base, Size exp
     
     return IRIS_SUCCESS;
 }
-void ANNOTATION_GROUP_BYTES::read_bytes (const BYTE *const __base, const GroupSizes &sizes, Annotations &annotations) const
+void ANNOTATION_GROUP_BYTES::read_bytes (const BYTE* __base, const GroupSizes &sizes, Annotations &annotations) const
 {
 #ifdef __EMSCRIPTEN__
-    const_cast<ANNOTATION_GROUP_BYTES&>(*this).check_and_fetch_remote(__base);
+    __base = check_and_fetch_remote(__base);
 #endif
     const auto __ptr    = __base + __offset;
     const auto BYTES    = LOAD_U32(__ptr + ENTRY_NUMBER);
@@ -3378,15 +7046,836 @@ void ANNOTATION_GROUP_BYTES::read_bytes (const BYTE *const __base, const GroupSi
     }
 }
 #ifdef __EMSCRIPTEN__
-void ANNOTATION_GROUP_BYTES::check_and_fetch_remote(const BYTE *const &base)
+const BYTE* ANNOTATION_GROUP_BYTES::check_and_fetch_remote (const BYTE* base) const
 {
-    if (!__response) {
-        const char* url = REINTERPRET_ARRAY_START(base);
-        __response      = FETCH_DATABLOCK(url,__remote, HEADER_SIZE);
-        __offset        = __ptr_size;
-        __response      = FETCH_DATABLOCK(url,__remote, size(base));
-    } const_cast<const BYTE*&>(base) = __response->data;
+    return FETCH_REMOTE_BLOCK(*this, base);
 }
 #endif
 } // END SERIALIZATION
+#ifndef __EMSCRIPTEN__
+// MARK: - BLOCK REPLICATION
+// Magic numbers of the manifest and patch streams: ASCII 'IFEM' and 'IFEP'
+constexpr uint32_t MANIFEST_MAGIC   = 0x4946454D;
+constexpr uint32_t PATCH_MAGIC      = 0x49464550;
+// Version 2 patch streams carry the source and target fingerprints
+constexpr uint16_t REPLICATION_STREAM_VERSION = 2;
+namespace Abstraction {
+uint64_t BlockManifest::fingerprint () const
+{
+    using namespace Serialization;
+    constexpr Size ENTRY    = TYPE_SIZE_UINT64 * 3 + TYPE_SIZE_UINT8;
+    BYTE buffer [ENTRY];
+    XXH64_STATE hash (0);
+    STORE_U64   (buffer, fileSize);
+    STORE_U32   (buffer + TYPE_SIZE_UINT64, revision);
+    hash.update (buffer, TYPE_SIZE_UINT64 + TYPE_SIZE_UINT32);
+    for (auto&& entry : entries) {
+        STORE_U64   (buffer, entry.offset);
+        STORE_U64   (buffer + TYPE_SIZE_UINT64, entry.size);
+        STORE_U64   (buffer + TYPE_SIZE_UINT64 * 2, entry.hash);
+        STORE_U8    (buffer + TYPE_SIZE_UINT64 * 3, entry.type);
+        hash.update (buffer, ENTRY);
+    }
+    return hash.digest();
+}
+Size Patch::literal_bytes () const
+{
+    Size bytes = 0;
+    for (auto&& op : operations)
+        if (op.operation == PATCH_LITERAL) bytes += op.size;
+    return bytes;
+}
+}
+Abstraction::BlockManifest generate_block_manifest (BYTE* const __base, size_t __size)
+{
+    using namespace Abstraction;
+    const auto map          = generate_file_map(__base, __size);
+    const auto header       = Serialization::FILE_HEADER(__size).read_header(__base);
+    
+    BlockManifest manifest;
+    manifest.fileSize       = __size;
+    manifest.revision       = header.revision;
+    manifest.entries.reserve(map.size());
+    for (auto&& block : map) {
+        if (block.first + block.second.size > __size) throw std::runtime_error
+            ("Failed to generate block manifest -- datablock (" +
+             std::to_string(block.first) + "-" + std::to_string(block.first + block.second.size) +
+             " bytes) extends beyond the end of the file.");
+        XXH64_STATE hash (0);
+        hash.update (__base + block.first, block.second.size);
+        manifest.entries.push_back({
+            .offset = block.first,
+            .size   = block.second.size,
+            .hash   = hash.digest(),
+            .type   = block.second.type,
+        });
+    }
+    return manifest;
+}
+Abstraction::Patch generate_patch (const Abstraction::BlockManifest& source, BYTE* const __base, size_t __size)
+{
+    using namespace Abstraction;
+    using Op                = Patch::Op;
+    const auto target       = generate_block_manifest(__base, __size);
+    
+    // Source blocks by content (hash and size)
+    std::unordered_multimap<uint64_t, const BlockManifest::Entry*> blocks;
+    blocks.reserve(source.entries.size());
+    for (auto&& entry : source.entries) blocks.emplace(entry.hash, &entry);
+    const auto find_source  = [&](const BlockManifest::Entry& entry)->Offset {
+        const auto range    = blocks.equal_range(entry.hash);
+        const BlockManifest::Entry* found = nullptr;
+        for (auto it = range.first; it != range.second; ++it)
+            if (it->second->size == entry.size) {
+                // Prefer the block at the same offset (an in-place keep)
+                if (it->second->offset == entry.offset) return entry.offset;
+                if (!found) found = it->second;
+            }
+        return found ? found->offset : NULL_OFFSET;
+    };
+    
+    Patch patch;
+    patch.fileSize          = __size;
+    patch.revision          = target.revision;
+    patch.sourceSize        = source.fileSize;
+    patch.sourceRevision    = source.revision;
+    patch.sourceFingerprint = source.fingerprint();
+    patch.fingerprint       = target.fingerprint();
+    auto& ops               = patch.operations;
+    const auto keep         = [&](Offset from, Size size) {
+        if (ops.size() && ops.back().operation == Patch::PATCH_KEEP &&
+            ops.back().source + ops.back().size == from) ops.back().size += size;
+        else ops.push_back(Op {.operation = Patch::PATCH_KEEP, .source = from, .size = size, .bytes = {}});
+    };
+    const auto literal      = [&](Offset offset, Size size) {
+        if (!size) return;
+        if (ops.empty() || ops.back().operation != Patch::PATCH_LITERAL)
+            ops.push_back(Op {.operation = Patch::PATCH_LITERAL, .source = NULL_OFFSET, .size = 0, .bytes = {}});
+        auto& op = ops.back();
+        op.bytes.insert(op.bytes.end(), __base + offset, __base + offset + size);
+        op.size += size;
+    };
+    
+    Offset cursor           = 0;
+    for (auto&& entry : target.entries) {
+        if (entry.offset + entry.size <= cursor) continue;
+        if (entry.offset < cursor) {
+            // Overlapping blocks: carry the remainder
+            literal (cursor, entry.offset + entry.size - cursor);
+            cursor = entry.offset + entry.size;
+            continue;
+        }
+        literal (cursor, entry.offset - cursor);
+        const auto from     = find_source(entry);
+        if (from != NULL_OFFSET) keep (from, entry.size);
+        else literal (entry.offset, entry.size);
+        cursor              = entry.offset + entry.size;
+    }
+    literal (cursor, __size - cursor);
+    return patch;
+}
+void apply_patch (BYTE* const __base, size_t __mapped, const Abstraction::Patch& patch)
+{
+    using namespace Abstraction;
+    if (__mapped < std::max(patch.fileSize, patch.sourceSize)) throw std::runtime_error
+        ("Failed to apply patch -- the mapped file (" + std::to_string(__mapped) +
+         " bytes) is smaller than the patch source or target size (" +
+         std::to_string(std::max(patch.fileSize, patch.sourceSize)) + " bytes).");
+    
+    const auto header       = Serialization::FILE_HEADER(patch.sourceSize).read_header(__base);
+    if (header.fileSize != patch.sourceSize) throw std::runtime_error
+        ("Failed to apply patch -- the patch applies to a file of (" +
+         std::to_string(patch.sourceSize) + " bytes) but the file is (" +
+         std::to_string(header.fileSize) + " bytes).");
+    if (header.revision != patch.sourceRevision) throw std::runtime_error
+        ("Failed to apply patch -- the patch applies to revision (" +
+         std::to_string(patch.sourceRevision) + ") but the file is revision (" +
+         std::to_string(header.revision) + ").");
+    
+    // Validate the operations before any byte is written
+    Offset target           = 0;
+    Size staged             = 0;
+    for (auto&& op : patch.operations) {
+        switch (op.operation) {
+            case Patch::PATCH_KEEP:
+                if (op.source + op.size > patch.sourceSize) throw std::runtime_error
+                    ("Failed to apply patch -- kept range (" + std::to_string(op.source) + "-" +
+                     std::to_string(op.source + op.size) + " bytes) extends beyond the source file.");
+                if (op.source != target) staged += op.size;
+                break;
+            case Patch::PATCH_LITERAL:
+                if (op.bytes.size() != op.size) throw std::runtime_error
+                    ("Failed to apply patch -- literal operation size mismatch.");
+                break;
+            default: throw std::runtime_error
+                ("Failed to apply patch -- undefined patch operation (" +
+                 std::to_string(op.operation) + ").");
+        }
+        target += op.size;
+    }
+    if (target != patch.fileSize) throw std::runtime_error
+        ("Failed to apply patch -- the operations (" + std::to_string(target) +
+         " bytes) do not cover the target file size (" + std::to_string(patch.fileSize) + " bytes).");
+    
+    // A source of the same size and revision may still differ in content
+    if (generate_block_manifest(__base, patch.sourceSize).fingerprint() != patch.sourceFingerprint)
+        throw std::runtime_error
+        ("Failed to apply patch -- the file content does not match the patch source fingerprint. "
+         "The patch was generated against a different replica of revision (" +
+         std::to_string(patch.sourceRevision) + ").");
+    
+    // Stage moved source ranges before any of them may be overwritten
+    std::vector<BYTE> stage;
+    stage.reserve(staged);
+    target                  = 0;
+    for (auto&& op : patch.operations) {
+        if (op.operation == Patch::PATCH_KEEP && op.source != target)
+            stage.insert(stage.end(), __base + op.source, __base + op.source + op.size);
+        target += op.size;
+    }
+    
+    target                  = 0;
+    staged                  = 0;
+    for (auto&& op : patch.operations) {
+        if (op.operation == Patch::PATCH_LITERAL)
+            memcpy(__base + target, op.bytes.data(), op.size);
+        else if (op.source != target) {
+            memcpy(__base + target, stage.data() + staged, op.size);
+            staged += op.size;
+        }
+        target += op.size;
+    }
+    
+    if (generate_block_manifest(__base, patch.fileSize).fingerprint() != patch.fingerprint)
+        throw std::runtime_error
+        ("Failed to apply patch -- the reconstructed file does not match the patch target fingerprint. "
+         "The file is corrupt and shall be restored from a replica.");
+}
+std::vector<BYTE> serialize_block_manifest (const Abstraction::BlockManifest& manifest)
+{
+    using namespace Serialization;
+    constexpr Size ENTRY    = TYPE_SIZE_UINT64 * 3 + TYPE_SIZE_UINT8;
+    std::vector<BYTE> stream (TYPE_SIZE_UINT32 + TYPE_SIZE_UINT16 + TYPE_SIZE_UINT64 +
+                              TYPE_SIZE_UINT32 * 2 + ENTRY * manifest.entries.size());
+    BYTE* __ptr = stream.data();
+    STORE_U32 (__ptr, MANIFEST_MAGIC);              __ptr += TYPE_SIZE_UINT32;
+    STORE_U16 (__ptr, REPLICATION_STREAM_VERSION);  __ptr += TYPE_SIZE_UINT16;
+    STORE_U64 (__ptr, manifest.fileSize);           __ptr += TYPE_SIZE_UINT64;
+    STORE_U32 (__ptr, manifest.revision);           __ptr += TYPE_SIZE_UINT32;
+    STORE_U32 (__ptr, U32_CAST(manifest.entries.size())); __ptr += TYPE_SIZE_UINT32;
+    for (auto&& entry : manifest.entries) {
+        STORE_U64 (__ptr, entry.offset);            __ptr += TYPE_SIZE_UINT64;
+        STORE_U64 (__ptr, entry.size);              __ptr += TYPE_SIZE_UINT64;
+        STORE_U64 (__ptr, entry.hash);              __ptr += TYPE_SIZE_UINT64;
+        STORE_U8  (__ptr, entry.type);              __ptr += TYPE_SIZE_UINT8;
+    }
+    return stream;
+}
+Abstraction::BlockManifest deserialize_block_manifest (const BYTE* const __stream, size_t __size)
+{
+    using namespace Abstraction;
+    using namespace Serialization;
+    constexpr Size HEADER   = TYPE_SIZE_UINT32 + TYPE_SIZE_UINT16 + TYPE_SIZE_UINT64 + TYPE_SIZE_UINT32 * 2;
+    constexpr Size ENTRY    = TYPE_SIZE_UINT64 * 3 + TYPE_SIZE_UINT8;
+    const BYTE* __ptr       = __stream;
+    if (__size < HEADER || LOAD_U32(__ptr) != MANIFEST_MAGIC) throw std::runtime_error
+        ("Failed to read block manifest -- invalid manifest stream.");
+    if (LOAD_U16(__ptr + TYPE_SIZE_UINT32) > REPLICATION_STREAM_VERSION) throw std::runtime_error
+        ("Failed to read block manifest -- unsupported manifest stream version (" +
+         std::to_string(LOAD_U16(__ptr + TYPE_SIZE_UINT32)) + ").");
+    __ptr += TYPE_SIZE_UINT32 + TYPE_SIZE_UINT16;
+    
+    BlockManifest manifest;
+    manifest.fileSize       = LOAD_U64(__ptr);      __ptr += TYPE_SIZE_UINT64;
+    manifest.revision       = LOAD_U32(__ptr);      __ptr += TYPE_SIZE_UINT32;
+    const auto ENTRIES      = LOAD_U32(__ptr);      __ptr += TYPE_SIZE_UINT32;
+    if (HEADER + ENTRIES * ENTRY > __size) throw std::runtime_error
+        ("Failed to read block manifest -- manifest stream is truncated.");
+    manifest.entries.resize(ENTRIES);
+    for (auto&& entry : manifest.entries) {
+        entry.offset        = LOAD_U64(__ptr);      __ptr += TYPE_SIZE_UINT64;
+        entry.size          = LOAD_U64(__ptr);      __ptr += TYPE_SIZE_UINT64;
+        entry.hash          = LOAD_U64(__ptr);      __ptr += TYPE_SIZE_UINT64;
+        entry.type          = static_cast<MapEntryType>(LOAD_U8(__ptr)); __ptr += TYPE_SIZE_UINT8;
+    }
+    return manifest;
+}
+std::vector<BYTE> serialize_patch (const Abstraction::Patch& patch)
+{
+    using namespace Abstraction;
+    using namespace Serialization;
+    Size size = TYPE_SIZE_UINT32 + TYPE_SIZE_UINT16 + (TYPE_SIZE_UINT64 * 2 + TYPE_SIZE_UINT32) * 2 + TYPE_SIZE_UINT32;
+    for (auto&& op : patch.operations)
+        size += TYPE_SIZE_UINT8 + TYPE_SIZE_UINT64 +
+        (op.operation == Patch::PATCH_KEEP ? Size(TYPE_SIZE_UINT64) : op.size);
+    
+    std::vector<BYTE> stream (size);
+    BYTE* __ptr = stream.data();
+    STORE_U32 (__ptr, PATCH_MAGIC);                 __ptr += TYPE_SIZE_UINT32;
+    STORE_U16 (__ptr, REPLICATION_STREAM_VERSION);  __ptr += TYPE_SIZE_UINT16;
+    STORE_U64 (__ptr, patch.fileSize);              __ptr += TYPE_SIZE_UINT64;
+    STORE_U32 (__ptr, patch.revision);              __ptr += TYPE_SIZE_UINT32;
+    STORE_U64 (__ptr, patch.sourceSize);            __ptr += TYPE_SIZE_UINT64;
+    STORE_U32 (__ptr, patch.sourceRevision);        __ptr += TYPE_SIZE_UINT32;
+    STORE_U64 (__ptr, patch.sourceFingerprint);     __ptr += TYPE_SIZE_UINT64;
+    STORE_U64 (__ptr, patch.fingerprint);           __ptr += TYPE_SIZE_UINT64;
+    STORE_U32 (__ptr, U32_CAST(patch.operations.size())); __ptr += TYPE_SIZE_UINT32;
+    for (auto&& op : patch.operations) {
+        STORE_U8  (__ptr, op.operation);            __ptr += TYPE_SIZE_UINT8;
+        STORE_U64 (__ptr, op.size);                 __ptr += TYPE_SIZE_UINT64;
+        if (op.operation == Patch::PATCH_KEEP) {
+            STORE_U64 (__ptr, op.source);           __ptr += TYPE_SIZE_UINT64;
+        } else {
+            memcpy (__ptr, op.bytes.data(), op.size); __ptr += op.size;
+        }
+    }
+    return stream;
+}
+Abstraction::Patch deserialize_patch (const BYTE* const __stream, size_t __size)
+{
+    using namespace Abstraction;
+    using namespace Serialization;
+    constexpr Size HEADER   = TYPE_SIZE_UINT32 + TYPE_SIZE_UINT16 + (TYPE_SIZE_UINT64 * 2 + TYPE_SIZE_UINT32) * 2 + TYPE_SIZE_UINT32;
+    const BYTE* __ptr       = __stream;
+    const BYTE* const __end = __stream + __size;
+    if (__size < HEADER || LOAD_U32(__ptr) != PATCH_MAGIC) throw std::runtime_error
+        ("Failed to read patch -- invalid patch stream.");
+    if (LOAD_U16(__ptr + TYPE_SIZE_UINT32) > REPLICATION_STREAM_VERSION) throw std::runtime_error
+        ("Failed to read patch -- unsupported patch stream version (" +
+         std::to_string(LOAD_U16(__ptr + TYPE_SIZE_UINT32)) + ").");
+    if (LOAD_U16(__ptr + TYPE_SIZE_UINT32) < REPLICATION_STREAM_VERSION) throw std::runtime_error
+        ("Failed to read patch -- patch stream version (" +
+         std::to_string(LOAD_U16(__ptr + TYPE_SIZE_UINT32)) +
+         ") carries no source fingerprint; regenerate the patch from the source manifest.");
+    __ptr += TYPE_SIZE_UINT32 + TYPE_SIZE_UINT16;
+    
+    Patch patch;
+    patch.fileSize          = LOAD_U64(__ptr);      __ptr += TYPE_SIZE_UINT64;
+    patch.revision          = LOAD_U32(__ptr);      __ptr += TYPE_SIZE_UINT32;
+    patch.sourceSize        = LOAD_U64(__ptr);      __ptr += TYPE_SIZE_UINT64;
+    patch.sourceRevision    = LOAD_U32(__ptr);      __ptr += TYPE_SIZE_UINT32;
+    patch.sourceFingerprint = LOAD_U64(__ptr);      __ptr += TYPE_SIZE_UINT64;
+    patch.fingerprint       = LOAD_U64(__ptr);      __ptr += TYPE_SIZE_UINT64;
+    const auto OPERATIONS   = LOAD_U32(__ptr);      __ptr += TYPE_SIZE_UINT32;
+    patch.operations.resize(OPERATIONS);
+    for (auto&& op : patch.operations) {
+        if (__end - __ptr < TYPE_SIZE_UINT8 + TYPE_SIZE_UINT64) throw std::runtime_error
+            ("Failed to read patch -- patch stream is truncated.");
+        op.operation        = static_cast<Patch::Operation>(LOAD_U8(__ptr)); __ptr += TYPE_SIZE_UINT8;
+        op.size             = LOAD_U64(__ptr);      __ptr += TYPE_SIZE_UINT64;
+        const Size payload  = op.operation == Patch::PATCH_KEEP ? Size(TYPE_SIZE_UINT64) : op.size;
+        if (Size(__end - __ptr) < payload) throw std::runtime_error
+            ("Failed to read patch -- patch stream is truncated.");
+        if (op.operation == Patch::PATCH_KEEP) op.source = LOAD_U64(__ptr);
+        else op.bytes.assign(__ptr, __ptr + op.size);
+        __ptr += payload;
+    }
+    return patch;
+}
+#endif
+// MARK: - STREAMING VALIDATION
+// Retention charged per container entry of a detected block or recorded reference
+// in addition to its value: node links, cached hash and bucket slot (approximate).
+constexpr Size STREAM_NODE_LINKS        = 4 * sizeof(void*);
+// Bytes of a detected block required to determine its length
+inline Size STREAM_BLOCK_PREFIX (uint16_t recovery, uint32_t version)
+{
+    using namespace Serialization;
+    switch (recovery) {
+        case RECOVER_TILE_TABLE:                return version > IRIS_EXTENSION_1_0 ?
+                                                TILE_TABLE::HEADER_V2_0_SIZE :
+                                                TILE_TABLE::HEADER_V1_0_SIZE;
+        case RECOVER_METADATA:                  return METADATA::HEADER_SIZE;
+        case RECOVER_ATTRIBUTES:                return version > IRIS_EXTENSION_1_0 ?
+                                                ATTRIBUTES::HEADER_V2_0_SIZE :
+                                                ATTRIBUTES::HEADER_V1_0_SIZE;
+        case RECOVER_LAYER_EXTENTS:             return LAYER_EXTENTS::HEADER_SIZE;
+        case RECOVER_TILE_OFFSETS:              return version > IRIS_EXTENSION_1_0 ?
+                                                TILE_OFFSETS::HEADER_V2_0_SIZE :
+                                                TILE_OFFSETS::HEADER_V1_0_SIZE;
+        case RECOVER_ATTRIBUTES_SIZES:          return ATTRIBUTES_SIZES::HEADER_SIZE;
+        case RECOVER_ATTRIBUTES_BYTES:          return ATTRIBUTES_BYTES::HEADER_SIZE;
+        case RECOVER_ASSOCIATED_IMAGES:         return IMAGE_ARRAY::HEADER_SIZE;
+        case RECOVER_ASSOCIATED_IMAGE_BYTES:    return IMAGE_BYTES::HEADER_SIZE;
+        case RECOVER_ICC_PROFILE:               return ICC_PROFILE::HEADER_SIZE;
+        case RECOVER_ANNOTATIONS:               return version > IRIS_EXTENSION_1_0 ?
+                                                ANNOTATIONS::HEADER_V2_0_SIZE :
+                                                ANNOTATIONS::HEADER_V1_0_SIZE;
+        case RECOVER_ANNOTATION_BYTES:          return ANNOTATION_BYTES::HEADER_SIZE;
+        case RECOVER_ANNOTATION_GROUP_SIZES:    return ANNOTATION_GROUP_SIZES::HEADER_SIZE;
+        case RECOVER_ANNOTATION_GROUP_BYTES:    return ANNOTATION_GROUP_BYTES::HEADER_SIZE;
+        case RECOVER_ANNOTATION_INDEX:          return ANNOTATION_INDEX::HEADER_SIZE;
+        case RECOVER_TILE_PLANES:               return TILE_PLANES::HEADER_SIZE;
+        case RECOVER_CIPHER:                    return CIPHER::HEADER_SIZE;
+        case RECOVER_TEXT_DICTIONARY:           return TEXT_DICTIONARY::HEADER_SIZE;
+        case RECOVER_ATTRIBUTES_DIRECTORY:      return ATTRIBUTES_DIRECTORY::HEADER_SIZE;
+        default:                                return 0;
+    }
+}
+inline std::string STREAM_BLOCK_TYPE (uint16_t recovery)
+{
+    using namespace Serialization;
+    switch (recovery) {
+        case RECOVER_HEADER:                    return FILE_HEADER::type;
+        case RECOVER_TILE_TABLE:                return TILE_TABLE::type;
+        case RECOVER_METADATA:                  return METADATA::type;
+        case RECOVER_ATTRIBUTES:                return ATTRIBUTES::type;
+        case RECOVER_LAYER_EXTENTS:             return LAYER_EXTENTS::type;
+        case RECOVER_TILE_OFFSETS:              return TILE_OFFSETS::type;
+        case RECOVER_ATTRIBUTES_SIZES:          return ATTRIBUTES_SIZES::type;
+        case RECOVER_ATTRIBUTES_BYTES:          return ATTRIBUTES_BYTES::type;
+        case RECOVER_ASSOCIATED_IMAGES:         return IMAGE_ARRAY::type;
+        case RECOVER_ASSOCIATED_IMAGE_BYTES:    return IMAGE_BYTES::type;
+        case RECOVER_ICC_PROFILE:               return ICC_PROFILE::type;
+        case RECOVER_ANNOTATIONS:               return ANNOTATIONS::type;
+        case RECOVER_ANNOTATION_BYTES:          return ANNOTATION_BYTES::type;
+        case RECOVER_ANNOTATION_GROUP_SIZES:    return ANNOTATION_GROUP_SIZES::type;
+        case RECOVER_ANNOTATION_GROUP_BYTES:    return ANNOTATION_GROUP_BYTES::type;
+        case RECOVER_ANNOTATION_INDEX:          return ANNOTATION_INDEX::type;
+        case RECOVER_TILE_PLANES:               return TILE_PLANES::type;
+        case RECOVER_CIPHER:                    return CIPHER::type;
+        case RECOVER_TEXT_DICTIONARY:           return TEXT_DICTIONARY::type;
+        case RECOVER_ATTRIBUTES_DIRECTORY:      return ATTRIBUTES_DIRECTORY::type;
+        default:                                return "UNDEFINED ("+to_hex_string(recovery)+")";
+    }
+}
+StreamValidator::StreamValidator (Size retention_limit) :
+__limit (retention_limit)
+{
+    __header.reserve(Serialization::FILE_HEADER::HEADER_SIZE);
+}
+void StreamValidator::fail (const std::string& message)
+{
+    if (__state == STREAM_INVALID) return;
+    __state     = STREAM_INVALID;
+    __result    = Result(IRIS_FAILURE, "Stream validation failed -- " + message);
+    __blocks.clear();
+    __capturing.clear();
+    __pending.clear();
+    __resolved.clear();
+    __counts.clear();
+    __tilings.clear();
+    __annotations.clear();
+    __retained  = 0;
+}
+bool StreamValidator::retain (Size bytes)
+{
+    __retained += bytes;
+    if (__retained <= __limit) return true;
+    fail ("retained metadata ("+std::to_string(__retained)+
+          " bytes) exceeds the streaming retention limit ("+
+          std::to_string(__limit)+" bytes).");
+    return false;
+}
+Result StreamValidator::push (const BYTE* const data, size_t bytes)
+{
+    using namespace Serialization;
+    if (__state == STREAM_INVALID || !data || !bytes) return __result;
+    
+    // The file header is always the first block of the stream
+    if (__position < FILE_HEADER::HEADER_SIZE) {
+        const auto N = std::min<Size>(bytes, FILE_HEADER::HEADER_SIZE - __position);
+        __header.insert(__header.end(), data, data + N);
+        if (__header.size() == FILE_HEADER::HEADER_SIZE) read_header();
+    }
+    
+    // Once valid, the remaining (tile) bytes are only counted
+    if (__state == STREAM_PENDING) {
+        detect_blocks   (data, bytes);
+        capture_blocks  (data, bytes);
+    }
+    
+    __position += bytes;
+    if (bytes >= sizeof(__tail)) memcpy(__tail, data + bytes - sizeof(__tail), sizeof(__tail));
+    else {
+        memmove (__tail, __tail + bytes, sizeof(__tail) - bytes);
+        memcpy  (__tail + sizeof(__tail) - bytes, data, bytes);
+    }
+    
+    if (__size && __position > __size) fail
+        ("the stream ("+std::to_string(__position)+
+         " bytes) extends beyond the encoded file size ("+
+         std::to_string(__size)+" bytes).");
+    
+    // A referenced block signature that has passed without detection
+    // means the block is missing or its VALIDATION / RECOVERY is corrupt.
+    if (__state == STREAM_PENDING) for (auto&& reference : __pending) {
+        if (reference.first + DATA_BLOCK::HEADER_SIZE > __position) break;
+        if (__blocks.find(reference.first) != __blocks.end()) continue;
+        fail ("no valid " + STREAM_BLOCK_TYPE(reference.second) +
+              " block at referenced offset (" + std::to_string(reference.first) +
+              "). The block VALIDATION or RECOVERY tag failed validation.");
+        break;
+    }
+    
+    if (__state == STREAM_PENDING && __size && __pending.empty()) {
+        __state = STREAM_VALID;
+        __blocks.clear();
+        __capturing.clear();
+        __resolved.clear();
+        __counts.clear();
+        __tilings.clear();
+        __annotations.clear();
+        __retained = 0;
+    }
+    return __result;
+}
+Result StreamValidator::finish ()
+{
+    using namespace Serialization;
+    if (__state == STREAM_INVALID) return __result;
+    
+    if (__position < FILE_HEADER::HEADER_SIZE) fail
+        ("the stream ended ("+std::to_string(__position)+
+         " bytes) before the end of the file header.");
+    else if (__position != __size) fail
+        ("the stream length ("+std::to_string(__position)+
+         " bytes) differs from the encoded file size ("+
+         std::to_string(__size)+" bytes).");
+    else if (__pending.size()) fail
+        ("the stream ended with ("+std::to_string(__pending.size())+
+         ") unresolved block references.");
+    return __result;
+}
+void StreamValidator::read_header ()
+{
+    using namespace Serialization;
+    const BYTE* __ptr = __header.data();
+    if (LOAD_U32(__ptr + FILE_HEADER::MAGIC_BYTES_OFFSET) != MAGIC_BYTES)
+        return fail ("Iris File Magic Number failed validation");
+    if (LOAD_U16(__ptr + FILE_HEADER::RECOVERY) != RECOVER_HEADER)
+        return fail ("RECOVER_HEADER tag failed validation.");
+    
+    __size      = LOAD_U64(__ptr + FILE_HEADER::FILE_SIZE);
+    __version   = LOAD_U16(__ptr + FILE_HEADER::EXTENSION_MAJOR) << 16 |
+                  LOAD_U16(__ptr + FILE_HEADER::EXTENSION_MINOR);
+    if (__size < FILE_HEADER::HEADER_SIZE) return fail
+        ("the encoded file size (" + std::to_string(__size) +
+         " bytes) is smaller than the file header.");
+    
+    reference (LOAD_U64(__ptr + FILE_HEADER::TILE_TABLE_OFFSET), RECOVER_TILE_TABLE);
+    reference (LOAD_U64(__ptr + FILE_HEADER::METADATA_OFFSET), RECOVER_METADATA);
+    __header.clear();
+    __header.shrink_to_fit();
+}
+void StreamValidator::detect_blocks (const BYTE* const data, size_t bytes)
+{
+    using namespace Serialization;
+    constexpr Size SIGNATURE    = DATA_BLOCK::HEADER_SIZE;
+    static_assert (sizeof(__tail) == SIGNATURE - 1, "tail must hold a signature less one byte");
+    
+    // A block signature is its 64-bit self offset followed by its 16-bit
+    // recovery tag; the high byte of every tag (0x55) ends the signature.
+    const Offset start      = __position;
+    const BYTE* const __end = data + bytes;
+    for (const BYTE* __ptr  = data; (__ptr = static_cast<const BYTE*>
+         (memchr(__ptr, RECOVER_UNDEFINED >> 8, __end - __ptr))); ++__ptr) {
+        const Offset last   = start + (__ptr - data);
+        if (last < FILE_HEADER::HEADER_V1_0_SIZE + SIGNATURE - 1) continue;
+        const Offset offset = last - (SIGNATURE - 1);
+        
+        BYTE signature [SIGNATURE];
+        for (Size SI = 0; SI < SIGNATURE; ++SI) signature[SI] = offset + SI >= start ?
+            data[offset + SI - start] : __tail[sizeof(__tail) - (start - offset - SI)];
+        
+        const auto recovery = LOAD_U16(signature + DATA_BLOCK::RECOVERY);
+        const auto prefix   = STREAM_BLOCK_PREFIX(recovery, __version);
+        if (!prefix || LOAD_U64(signature + DATA_BLOCK::VALIDATION) != offset) continue;
+        if (__blocks.count(offset) || __resolved.count(offset)) continue;
+        
+        Block block;
+        block.recovery      = recovery;
+        block.prefix        = prefix;
+        block.capture       = prefix;
+        block.bytes.reserve (prefix);
+        block.bytes.assign  (signature, signature + SIGNATURE);
+        __blocks.emplace    (offset, std::move(block));
+        __capturing.push_back(offset);
+        if (!retain(SIGNATURE + sizeof(decltype(__blocks)::value_type) + STREAM_NODE_LINKS)) return;
+    }
+}
+void StreamValidator::capture_blocks (const BYTE* const data, size_t bytes)
+{
+    const Offset start  = __position;
+    const Offset end    = __position + bytes;
+    for (size_t CI = 0; CI < __capturing.size() && __state == STREAM_PENDING;) {
+        const auto offset   = __capturing[CI];
+        auto& block         = __blocks.at(offset);
+        while (!block.complete()) {
+            const Offset from = offset + block.bytes.size();
+            if (from < start || from >= end) break;
+            const auto N    = std::min<Size>(block.capture - block.bytes.size(), end - from);
+            block.bytes.insert(block.bytes.end(), data + (from - start), data + (from - start + N));
+            __retained     += N;
+            if (block.bytes.size() == block.prefix && !size_block(offset, block)) break;
+        }
+        if (!retain(0)) return;
+        if (!block.complete()) {++CI; continue;}
+        
+        __capturing[CI] = __capturing.back();
+        __capturing.pop_back();
+        if (__pending.count(offset)) resolve(offset);
+    }
+}
+bool StreamValidator::size_block (Offset offset, Block& block)
+{
+    using namespace Serialization;
+    const BYTE* __ptr   = block.bytes.data();
+    bool entries        = false;
+    Size length         = block.prefix;
+    switch (block.recovery) {
+        case RECOVER_TILE_OFFSETS:
+        case RECOVER_ASSOCIATED_IMAGES:
+        case RECOVER_ANNOTATIONS:
+        case RECOVER_TILE_PLANES:
+        case RECOVER_LAYER_EXTENTS:
+        case RECOVER_ANNOTATION_INDEX:
+            entries     = true;
+            [[fallthrough]];
+        case RECOVER_ATTRIBUTES_SIZES:
+        case RECOVER_ANNOTATION_GROUP_SIZES:
+        case RECOVER_ATTRIBUTES_DIRECTORY:
+            // Entry arrays share the ENTRY_SIZE / ENTRY_NUMBER header layout
+            length     += Size(LOAD_U16(__ptr + TILE_OFFSETS::ENTRY_SIZE)) *
+                          LOAD_U32(__ptr + TILE_OFFSETS::ENTRY_NUMBER);
+            break;
+        case RECOVER_ATTRIBUTES_BYTES:
+        case RECOVER_ICC_PROFILE:
+        case RECOVER_ANNOTATION_BYTES:
+        case RECOVER_ANNOTATION_GROUP_BYTES:
+        case RECOVER_TEXT_DICTIONARY:
+            // Byte arrays share the ENTRY_NUMBER header layout
+            length     += LOAD_U32(__ptr + ATTRIBUTES_BYTES::ENTRY_NUMBER);
+            break;
+        case RECOVER_ASSOCIATED_IMAGE_BYTES:
+            length     += LOAD_U16(__ptr + IMAGE_BYTES::TITLE_SIZE) +
+                          Size(LOAD_U32(__ptr + IMAGE_BYTES::IMAGE_SIZE));
+            break;
+        default: break;
+    }
+    block.length        = length;
+    if (__size && offset + length > __size) {
+        block.invalid   = STREAM_BLOCK_TYPE(block.recovery) + " block (" +
+        std::to_string(offset) + "-" + std::to_string(offset + length) +
+        " bytes) extends beyond the end of the file.";
+        block.capture   = block.bytes.size();
+        return false;
+    }
+    // Only arrays referencing or checked against other blocks are retained beyond their headers
+    if (entries) block.capture = length;
+    return true;
+}
+void StreamValidator::reference (Offset offset, uint16_t recovery, bool optional)
+{
+    using namespace Serialization;
+    if (__state != STREAM_PENDING) return;
+    if (offset == Serialization::NULL_OFFSET) {
+        if (!optional) fail ("required " + STREAM_BLOCK_TYPE(recovery) + " offset is NULL.");
+        return;
+    }
+    if (offset < FILE_HEADER::HEADER_V1_0_SIZE || offset + DATA_BLOCK::HEADER_SIZE > __size) return fail
+        (STREAM_BLOCK_TYPE(recovery) + " offset (" + std::to_string(offset) +
+         ") is outside of the file bounds (" + std::to_string(__size) + " bytes).");
+    
+    auto resolved = __resolved.find(offset);
+    if (resolved != __resolved.end()) {
+        if (resolved->second != recovery) fail
+            (STREAM_BLOCK_TYPE(recovery) + " offset (" + std::to_string(offset) +
+             ") references a " + STREAM_BLOCK_TYPE(resolved->second) + " block.");
+        return;
+    }
+    auto pending = __pending.find(offset);
+    if (pending != __pending.end()) {
+        if (pending->second != recovery) fail
+            (STREAM_BLOCK_TYPE(recovery) + " offset (" + std::to_string(offset) +
+             ") is also referenced as a " + STREAM_BLOCK_TYPE(pending->second) + " block.");
+        return;
+    }
+    __pending.emplace(offset, recovery);
+    if (!retain(sizeof(decltype(__pending)::value_type) + STREAM_NODE_LINKS)) return;
+    auto block = __blocks.find(offset);
+    if (block != __blocks.end() && block->second.complete()) resolve(offset);
+}
+void StreamValidator::resolve (Offset offset)
+{
+    using namespace Serialization;
+    auto __BLOCK        = __blocks.find(offset);
+    auto __REFERENCE    = __pending.find(offset);
+    const auto expected = __REFERENCE->second;
+    auto block          = std::move(__BLOCK->second);
+    __blocks.erase      (__BLOCK);
+    __pending.erase     (__REFERENCE);
+    __retained         -= block.bytes.size() + sizeof(decltype(__blocks)::value_type) + STREAM_NODE_LINKS;
+    __resolved.emplace  (offset, block.recovery);   // Charged as the pending reference it replaces
+    
+    if (block.recovery != expected) return fail
+        (STREAM_BLOCK_TYPE(expected) + " offset (" + std::to_string(offset) +
+         ") references a " + STREAM_BLOCK_TYPE(block.recovery) + " block. The RECOVERY tag failed validation.");
+    if (block.invalid.size()) return fail (block.invalid);
+    
+    // Padding allows the unaligned sub-64-bit loads of the final entry
+    block.bytes.resize(block.bytes.size() + TYPE_SIZE_UINT64);
+    const BYTE* __ptr   = block.bytes.data();
+    switch (block.recovery) {
+        case RECOVER_TILE_TABLE:
+            if (VALIDATE_ENCODING_TYPE((Encoding)LOAD_U8(__ptr + TILE_TABLE::ENCODING), __version) == false) return fail
+                ("undefined tile encoding value (" + to_hex_string((Encoding)LOAD_U8(__ptr + TILE_TABLE::ENCODING)) +
+                 ") decoded from tile table.");
+            if (VALIDATE_PIXEL_FORMAT((Format)LOAD_U8(__ptr + TILE_TABLE::FORMAT), __version) == false) return fail
+                ("undefined tile pixel format (" + to_hex_string((Format)LOAD_U8(__ptr + TILE_TABLE::FORMAT)) +
+                 ") decoded from tile table.");
+            __extents = LOAD_U64(__ptr + TILE_TABLE::LAYER_EXTENTS_OFFSET);
+            reference (LOAD_U64(__ptr + TILE_TABLE::TILE_OFFSETS_OFFSET), RECOVER_TILE_OFFSETS);
+            reference (__extents, RECOVER_LAYER_EXTENTS);
+            tiling    (__extents, LOAD_U64(__ptr + TILE_TABLE::TILE_OFFSETS_OFFSET));
+            if (__version > IRIS_EXTENSION_1_0)
+            {
+                reference (LOAD_U64(__ptr + TILE_TABLE::PLANES_OFFSET), RECOVER_TILE_PLANES, true);
+                reference (LOAD_U64(__ptr + TILE_TABLE::CIPHER_OFFSET), RECOVER_CIPHER, true);
+            }
+            break;
+        case RECOVER_LAYER_EXTENTS: {
+            const auto STEP     = LOAD_U16(__ptr + LAYER_EXTENTS::ENTRY_SIZE);
+            const auto ENTRIES  = LOAD_U32(__ptr + LAYER_EXTENTS::ENTRY_NUMBER);
+            if (ENTRIES && STEP < LAYER_EXTENT::V1_0_SIZE) return fail
+                ("LAYER_EXTENTS entry size (" + std::to_string(STEP) + ") is less than the layer extent entry size.");
+            const auto result   = VALIDATE_LAYER_EXTENT_ENTRIES(__ptr + block.prefix, STEP, ENTRIES, __version);
+            if (result & IRIS_FAILURE) return fail (result.message);
+            Size tiles          = 0;
+            const BYTE* __array = __ptr + block.prefix;
+            for (uint32_t LI = 0; LI < ENTRIES; ++LI, __array += STEP)
+                tiles += Size(LOAD_U32(__array + LAYER_EXTENT::X_TILES)) * LOAD_U32(__array + LAYER_EXTENT::Y_TILES);
+            count (offset, tiles);
+        } break;
+        case RECOVER_METADATA:
+            reference (LOAD_U64(__ptr + METADATA::ATTRIBUTES_OFFSET), RECOVER_ATTRIBUTES, true);
+            reference (LOAD_U64(__ptr + METADATA::IMAGES_OFFSET), RECOVER_ASSOCIATED_IMAGES, true);
+            reference (LOAD_U64(__ptr + METADATA::ICC_COLOR_OFFSET), RECOVER_ICC_PROFILE, true);
+            reference (LOAD_U64(__ptr + METADATA::ANNOTATIONS_OFFSET), RECOVER_ANNOTATIONS, true);
+            break;
+        case RECOVER_ATTRIBUTES:
+            reference (LOAD_U64(__ptr + ATTRIBUTES::LENGTHS_OFFSET), RECOVER_ATTRIBUTES_SIZES);
+            reference (LOAD_U64(__ptr + ATTRIBUTES::BYTE_ARRAY_OFFSET), RECOVER_ATTRIBUTES_BYTES);
+            if (__version > IRIS_EXTENSION_1_0) {
+                reference (LOAD_U64(__ptr + ATTRIBUTES::DICTIONARY_OFFSET), RECOVER_TEXT_DICTIONARY, true);
+                reference (LOAD_U64(__ptr + ATTRIBUTES::DIRECTORY_OFFSET), RECOVER_ATTRIBUTES_DIRECTORY, true);
+            }
+            break;
+        case RECOVER_TILE_OFFSETS: {
+            const auto STEP     = LOAD_U16(__ptr + TILE_OFFSETS::ENTRY_SIZE);
+            const auto ENTRIES  = LOAD_U32(__ptr + TILE_OFFSETS::ENTRY_NUMBER);
+            if (ENTRIES && STEP < TILE_OFFSET::SIZE) return fail
+                ("TILE_OFFSETS entry size (" + std::to_string(STEP) + ") is less than the tile entry size.");
+            Offset base         = Serialization::NULL_OFFSET;
+            if (__version > IRIS_EXTENSION_1_0) {
+                base            = LOAD_U64(__ptr + TILE_OFFSETS::BASE_OFFSETS_OFFSET);
+                if (base != Serialization::NULL_OFFSET && base >= offset) return fail
+                    ("delta TILE_OFFSETS base table (" + std::to_string(base) +
+                     ") does not precede the delta table (" + std::to_string(offset) + ").");
+                if (base != Serialization::NULL_OFFSET && ENTRIES && STEP < TILE_OFFSET_DELTA::SIZE) return fail
+                    ("delta TILE_OFFSETS entry size (" + std::to_string(STEP) + ") is less than the delta entry size.");
+                reference (base, RECOVER_TILE_OFFSETS, true);
+                if (__state != STREAM_PENDING) return;
+            }
+            const BYTE* __array = __ptr + block.prefix;
+            for (uint32_t TI = 0; TI < ENTRIES; ++TI, __array += STEP)
+                if (LOAD_U40(__array + TILE_OFFSET::OFFSET) != NULL_TILE &&
+                    LOAD_U40(__array + TILE_OFFSET::OFFSET) +
+                    LOAD_U24(__array + TILE_OFFSET::TILE_SIZE) > __size) return fail
+                    ("global tile entry (" + std::to_string(TI) +
+                     ") extends beyond the end of the file (" + std::to_string(__size) + " bytes).");
+            if (base == Serialization::NULL_OFFSET) count (offset, ENTRIES);
+            else for (size_t TI = 0, tilings = __tilings.size(); TI < tilings; ++TI)
+                // A delta table lists only the replaced tiles; its base carries the tile count
+                if (__tilings[TI].second == offset) tiling (__tilings[TI].first, base);
+        } break;
+        case RECOVER_TILE_PLANES: {
+            const auto STEP     = LOAD_U16(__ptr + TILE_PLANES::ENTRY_SIZE);
+            const auto ENTRIES  = LOAD_U32(__ptr + TILE_PLANES::ENTRY_NUMBER);
+            if (ENTRIES && STEP < TILE_PLANE::SIZE) return fail
+                ("TILE_PLANES entry size (" + std::to_string(STEP) + ") is less than the plane entry size.");
+            const BYTE* __array = __ptr + block.prefix + STEP;
+            for (uint32_t PI = 1; PI < ENTRIES && __state == STREAM_PENDING; ++PI, __array += STEP) {
+                // Every plane shares the tile table layer extents
+                reference (LOAD_U64(__array + TILE_PLANE::TILE_OFFSETS_OFFSET), RECOVER_TILE_OFFSETS);
+                tiling    (__extents, LOAD_U64(__array + TILE_PLANE::TILE_OFFSETS_OFFSET));
+            }
+        } break;
+        case RECOVER_ASSOCIATED_IMAGES: {
+            const auto STEP     = LOAD_U16(__ptr + IMAGE_ARRAY::ENTRY_SIZE);
+            const auto ENTRIES  = LOAD_U32(__ptr + IMAGE_ARRAY::ENTRY_NUMBER);
+            if (ENTRIES && STEP < IMAGE_ENTRY::V1_0_SIZE) return fail
+                ("IMAGE_ARRAY entry size (" + std::to_string(STEP) + ") is less than the image entry size.");
+            const bool pyramids = __version > IRIS_EXTENSION_1_0 && STEP >= IMAGE_ENTRY::V2_0_SIZE;
+            const BYTE* __array = __ptr + block.prefix;
+            for (uint32_t II = 0; II < ENTRIES && __state == STREAM_PENDING; ++II, __array += STEP) {
+                reference (LOAD_U64(__array + IMAGE_ENTRY::BYTES_OFFSET), RECOVER_ASSOCIATED_IMAGE_BYTES);
+                if (!pyramids) continue;
+                const auto extents  = LOAD_U64(__array + IMAGE_ENTRY::LAYER_EXTENTS_OFFSET);
+                const auto offsets  = LOAD_U64(__array + IMAGE_ENTRY::TILE_OFFSETS_OFFSET);
+                if ((extents == Serialization::NULL_OFFSET) != (offsets == Serialization::NULL_OFFSET)) return fail
+                    ("associated image entry (" + std::to_string(II) +
+                     ") references only one of a layer extents array and a tile offsets array.");
+                if (extents == Serialization::NULL_OFFSET) continue;
+                reference (extents, RECOVER_LAYER_EXTENTS);
+                reference (offsets, RECOVER_TILE_OFFSETS);
+                tiling    (extents, offsets);
+            }
+        } break;
+        case RECOVER_ANNOTATIONS: {
+            const auto STEP     = LOAD_U16(__ptr + ANNOTATIONS::ENTRY_SIZE);
+            const auto ENTRIES  = LOAD_U32(__ptr + ANNOTATIONS::ENTRY_NUMBER);
+            if (ENTRIES && STEP < ANNOTATION_ENTRY::SIZE) return fail
+                ("ANNOTATIONS entry size (" + std::to_string(STEP) + ") is less than the annotation entry size.");
+            reference (LOAD_U64(__ptr + ANNOTATIONS::GROUP_SIZES_OFFSET), RECOVER_ANNOTATION_GROUP_SIZES, true);
+            reference (LOAD_U64(__ptr + ANNOTATIONS::GROUP_BYTES_OFFSET), RECOVER_ANNOTATION_GROUP_BYTES, true);
+            if (__version > IRIS_EXTENSION_1_0) {
+                // The index buckets shall cover every annotation entry
+                const auto index = LOAD_U64(__ptr + ANNOTATIONS::SPATIAL_INDEX_OFFSET);
+                if (index != Serialization::NULL_OFFSET && __annotations.emplace(index, ENTRIES).second &&
+                    !retain(sizeof(decltype(__annotations)::value_type) + STREAM_NODE_LINKS)) return;
+                reference (index, RECOVER_ANNOTATION_INDEX, true);
+                reference (LOAD_U64(__ptr + ANNOTATIONS::DICTIONARY_OFFSET), RECOVER_TEXT_DICTIONARY, true);
+            }
+            const BYTE* __array = __ptr + block.prefix;
+            for (uint32_t AI = 0; AI < ENTRIES && __state == STREAM_PENDING; ++AI, __array += STEP)
+                reference (LOAD_U64(__array + ANNOTATION_ENTRY::BYTES_OFFSET), RECOVER_ANNOTATION_BYTES);
+        } break;
+        case RECOVER_ANNOTATION_INDEX: {
+            const auto expected = __annotations.find(offset);
+            const auto result   = VALIDATE_INDEX_BUCKETS
+            (__ptr, expected != __annotations.end() ? expected->second : 0);
+            if (result & IRIS_FAILURE) return fail (result.message);
+        } break;
+        default: break;
+    }
+}
+void StreamValidator::count (Offset offset, Size entries)
+{
+    if (__state != STREAM_PENDING) return;
+    __counts.emplace(offset, entries);
+    if (!retain(sizeof(decltype(__counts)::value_type) + STREAM_NODE_LINKS)) return;
+    for (size_t TI = 0; TI < __tilings.size() && __state == STREAM_PENDING; ++TI)
+        if (__tilings[TI].first == offset || __tilings[TI].second == offset)
+            match (__tilings[TI].first, __tilings[TI].second);
+}
+void StreamValidator::tiling (Offset extents, Offset offsets)
+{
+    if (__state != STREAM_PENDING) return;
+    __tilings.emplace_back(extents, offsets);
+    if (!retain(sizeof(decltype(__tilings)::value_type))) return;
+    match (extents, offsets);
+}
+void StreamValidator::match (Offset extents, Offset offsets)
+{
+    // Compared once both arrays have resolved, in whichever order they arrive
+    const auto tiles    = __counts.find(extents);
+    const auto entries  = __counts.find(offsets);
+    if (tiles == __counts.end() || entries == __counts.end()) return;
+    if (tiles->second != entries->second) fail
+        ("TILE_OFFSETS array (" + std::to_string(offsets) + ") contains " +
+         std::to_string(entries->second) + " tile entries but the LAYER_EXTENTS array (" +
+         std::to_string(extents) + ") it locates contains " +
+         std::to_string(tiles->second) + " tiles.");
+}
 } // END IRIS CODEC
@@ -47,6 +47,12 @@
 
 #ifndef IrisCodecExtension_hpp
 #define IrisCodecExtension_hpp
+#include <mutex>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <functional>
 
 // Should we export the IFE API for low-level calls to the IFE bytestream.
 // If being compiled as a part of another project and you do not want to
@@ -78,7 +84,12 @@ using namespace Iris;
 constexpr Offset   NULL_OFFSET          = UINT64_MAX;
 
 // IRIS EXTENSION VERSION FOR WHICH THIS HEADER CORRESPONDS
-constexpr uint16_t IRIS_EXTENSION_MAJOR = 1;
+// The encoder writes this version whether or not a version 2 block is used.
+// Version 2 blocks are laid out with their version 2 headers (the TILE_OFFSETS
+// entries, for example, follow the BASE_OFFSETS field), such that files written
+// by this encoder cannot be read by version 1.0 decoders. Version 1.0 files
+// continue to be read. See MIGRATION.md (Encoder output: Iris Extension 2.0).
+constexpr uint16_t IRIS_EXTENSION_MAJOR = 2;
 constexpr uint16_t IRIS_EXTENSION_MINOR = 0;
 
 // Iris' Magic Number is ASCII for 'Iris' 49 72 69 73
@@ -108,14 +119,236 @@ struct ANNOTATION_BYTES;
 struct ANNOTATION_GROUP_SIZES;
 struct ANNOTATION_GROUP_BYTES;
 // Version 1.0 ends here.
+struct ANNOTATION_INDEX;
+struct TILE_PLANES;
+struct CIPHER;
+struct TEXT_DICTIONARY;
+struct ATTRIBUTES_DIRECTORY;
+// Version 2.0 ends here.
 
 }
 // These are the light-weight RAM representaitons of the on-disk file:
 namespace Abstraction {
 struct File;
+struct TileTable;
+struct TileEntry;
+struct LazyFile;
+struct DeferredFile;
 struct FileMap;
+struct AnnotationLOD;
 }
 
+// MARK: - EXECUTORS
+enum IFE_EXPORT ExecutorPriority : uint8_t {
+    PRIORITY_LOW                = 0,    // Background work (ex: deferred validation)
+    PRIORITY_NORMAL             = 1,
+    PRIORITY_HIGH               = 2,
+};
+/**
+ * @brief Executor of the parallel library paths (file validation and
+ * abstraction, batched tile decryption and background validation).
+ *
+ * Entry methods taking an executor schedule all of their parallel work upon
+ * it and never create threads of their own. Applications with their own
+ * scheduler implement this interface such that slide processing shares the
+ * application's cores; otherwise use the process-wide work-stealing pool
+ * (see default_executor) or the inline executor (see inline_executor),
+ * which runs every task on the calling thread. Entry methods given a NULL
+ * executor use the default executor.
+ */
+class IFE_EXPORT Executor {
+public:
+    using Task                  = std::function<void()>;
+    using Function              = std::function<void(size_t)>;
+    virtual ~Executor           () = default;
+    /// Schedule a task. Tasks shall not throw; exceptions may be discarded.
+    virtual void    submit      (Task&&, ExecutorPriority = PRIORITY_NORMAL) = 0;
+    /// Number of threads upon which tasks run (1 if inline)
+    virtual uint32_t concurrency() const noexcept = 0;
+    /**
+     * @brief Invoke function(index) for every index in [0, count) and return once
+     * all have completed. The calling thread participates such that bulk may be
+     * called from within a task of the same executor. The first exception thrown
+     * is rethrown once every index has completed.
+     *
+     * The default implementation submits up to concurrency() - 1 helper tasks
+     * that draw indices from a shared counter with the calling thread.
+     */
+    virtual void    bulk        (size_t count, const Function&,
+                                 ExecutorPriority = PRIORITY_NORMAL);
+};
+using SharedExecutor = std::shared_ptr<Executor>;
+/**
+ * @brief Create a work-stealing thread pool of the given number of threads (0
+ * uses the hardware concurrency). Each worker owns a task queue per priority;
+ * tasks submitted from a worker are queued locally and idle workers steal
+ * from the others. Destroying the pool runs the queued tasks to completion.
+ */
+SharedExecutor IFE_EXPORT create_thread_pool (uint32_t threads = 0);
+/// Executor running every task on the calling thread at submission.
+SharedExecutor IFE_EXPORT inline_executor ();
+/**
+ * @brief The process-wide executor used when an entry method is given a NULL
+ * executor. Unless replaced (see set_default_executor), it is a thread pool
+ * of the hardware concurrency created on first use (the inline executor on
+ * WebAssembly builds without thread support).
+ */
+SharedExecutor IFE_EXPORT default_executor ();
+/// Replace the process-wide default executor (NULL restores the thread pool).
+void IFE_EXPORT set_default_executor (SharedExecutor);
+
+// MARK: - I/O QUALITY OF SERVICE
+enum IFE_EXPORT IOClass : uint8_t {
+    IO_CLASS_INTERACTIVE        = 0,    // Latency sensitive reads (ex: viewers)
+    IO_CLASS_BATCH              = 1,    // Throughput reads (ex: inference over full layers)
+    IO_CLASS_BACKGROUND         = 2,    // Reads served from leftover capacity (ex: archive scrubbing)
+};
+constexpr size_t IO_CLASSES     = IO_CLASS_BACKGROUND + 1;
+/**
+ * @brief Tenant and class of an I/O request. Requests without a tag are
+ * interactive requests of the unnamed tenant.
+ */
+struct IFE_EXPORT IOTag {
+    std::string     tenant;
+    IOClass         ioClass     = IO_CLASS_INTERACTIVE;
+};
+struct IFE_EXPORT IOClassPolicy {
+    uint32_t        weight      = 1;    // Share of the I/O slots while classes compete
+    uint32_t        max_queued  = 0;    // Tagged requests queued before submissions are rejected (0: unbounded)
+};
+struct IFE_EXPORT IOSchedulerCreateInfo {
+    SharedExecutor  executor    = nullptr;  // Executor running the requests (NULL: default executor)
+    uint32_t        slots       = 0;        // Requests in flight at once (0: executor concurrency)
+    uint32_t        reserved    = 1;        // Slots only interactive requests may take
+    std::array<IOClassPolicy, IO_CLASSES> classes = {
+        IOClassPolicy {16,  0},
+        IOClassPolicy {4,   1024},
+        IOClassPolicy {1,   1024},
+    };
+};
+struct IFE_EXPORT IOClassMetrics {
+    uint64_t        submitted   = 0;
+    uint64_t        completed   = 0;
+    uint64_t        rejected    = 0;    // Submissions refused at the queue depth limit
+    uint32_t        queued      = 0;
+    uint32_t        inflight    = 0;
+    uint64_t        bytes       = 0;    // Bytes of the completed requests
+    double          wait_p50    = 0;    // Seconds queued before dispatch (histogram bucket bound)
+    double          wait_p99    = 0;
+};
+/**
+ * @brief Executor scheduling tenant and class tagged I/O requests onto another
+ * executor with weighted fair queuing.
+ *
+ * At most the given number of requests run at once; the remaining requests
+ * wait within the scheduler rather than in the executor's queues, such that a
+ * batch job submitting whole layers cannot stand ahead of an interactive read.
+ * As a slot frees, the request dispatched next is chosen by start-time fair
+ * queuing over the (class, tenant) flows, weighted by the class weight and the
+ * tenant weight and charged by request bytes: every flow with queued requests
+ * progresses at its share and a flow's unused share goes to the others. Some
+ * slots are reserved for interactive requests.
+ *
+ * Tagged submissions beyond a class's queue depth limit throw. Untagged
+ * submissions (the Executor interface) are queued by priority (high:
+ * interactive, normal: batch, low: background) and are never rejected.
+ * Pass the scheduler wherever an executor is taken (ex: TileReader) to apply
+ * it to the library's reads.
+ */
+class IFE_EXPORT IOScheduler : public Executor {
+public:
+    /// Slot held by the owner of a grant until the grant is destroyed.
+    using Grant                 = std::shared_ptr<void>;
+    /// Schedule a task reading about the given bytes. Throws if the class queue is full.
+    virtual void    submit      (const IOTag&, Size bytes, Task&&) = 0;
+    /// Block until a slot is granted to the calling thread. Throws if the class queue is full.
+    virtual Grant   acquire     (const IOTag&, Size bytes) = 0;
+    /// Weight of a tenant within each class (default 1; 0 restores the default).
+    virtual void    set_tenant_weight   (const std::string& tenant, uint32_t weight) = 0;
+    virtual IOClassMetrics metrics      (IOClass) const = 0;
+    using Executor::submit;
+};
+using SharedIOScheduler = std::shared_ptr<IOScheduler>;
+SharedIOScheduler IFE_EXPORT create_io_scheduler (const IOSchedulerCreateInfo& = IOSchedulerCreateInfo());
+
+// MARK: - MEMORY PRESSURE
+enum IFE_EXPORT ReclaimPriority : uint8_t {
+    RECLAIM_FIRST               = 0,    // Cheap to rebuild (ex: tile caches)
+    RECLAIM_NORMAL              = 1,
+    RECLAIM_LAST                = 2,    // Costly to rebuild (ex: parsed slide abstractions)
+};
+/**
+ * @brief Cache that sheds bytes when the process is under memory pressure.
+ *
+ * Shrink releases about the requested bytes (least valuable entries first) and
+ * returns the bytes released. It is called from the reclaiming thread (the
+ * memory pressure monitor or a caller of reclaim_memory) and shall not release
+ * its own registration.
+ */
+struct IFE_EXPORT ReclaimableCache {
+    ReclaimPriority             priority    = RECLAIM_NORMAL;
+    std::function<Size()>       cached_bytes;   // Bytes the cache could release (required)
+    std::function<Size(Size)>   shrink;         // (required)
+};
+/// The cache is registered until the registration is destroyed (which waits upon a shrink in progress).
+using CacheRegistration = std::shared_ptr<void>;
+/// Register a cache with the process-wide reclaim protocol.
+CacheRegistration IFE_EXPORT register_cache (ReclaimableCache&&);
+/**
+ * @brief Ask the registered caches to release the given bytes. Caches are asked
+ * in priority order (RECLAIM_FIRST first; the largest first within a priority)
+ * until the bytes are released. @return The bytes released.
+ */
+Size IFE_EXPORT reclaim_memory (Size bytes);
+/// Bytes the registered caches could release.
+Size IFE_EXPORT reclaimable_memory ();
+#ifndef __EMSCRIPTEN__
+enum IFE_EXPORT MemoryPressureSource : uint8_t {
+    PRESSURE_SOURCE_NONE        = 0,    // No source available; reclaim_memory only
+    PRESSURE_SOURCE_PSI         = 1,    // Pressure stall information trigger (and cgroup events)
+    PRESSURE_SOURCE_EVENTS      = 2,    // cgroup v2 memory.events notifications
+    PRESSURE_SOURCE_POLLING     = 3,    // Periodic reads of the memory usage and limits
+};
+struct IFE_EXPORT MemoryPressureCreateInfo {
+    std::string     cgroup;                 // cgroup v2 directory (empty: the cgroup of the process)
+    uint32_t        stall_us        = 150000;   // PSI memory stall within a window that signals pressure
+    uint32_t        window_us       = 2000000;  // PSI window (unprivileged triggers require 2 s multiples)
+    uint32_t        poll_ms         = 1000;     // Usage checks (only without PSI or events)
+    float           target_usage    = 0.9f;     // Share of the memory limit to shrink the usage to
+    float           reclaim_share   = 0.25f;    // Share of the reclaimable bytes released per event otherwise
+};
+struct IFE_EXPORT MemoryPressureStats {
+    MemoryPressureSource source     = PRESSURE_SOURCE_NONE;
+    uint64_t        events          = 0;    // Pressure events that triggered a reclaim
+    Size            reclaimed       = 0;    // Bytes released by the caches
+};
+/**
+ * @brief Memory pressure monitor shrinking the registered caches before the
+ * process is killed for exceeding its memory limit (Linux).
+ *
+ * A background thread waits upon the most precise source available: a pressure
+ * stall information (PSI) trigger of the cgroup's memory.pressure (or the
+ * system's /proc/pressure/memory), together with notifications of the cgroup's
+ * memory.events (memory.high and memory.max breaches). Upon pressure the caches
+ * are asked to shrink the cgroup usage to the target share of memory.high
+ * (memory.max if unset), or by the reclaim share of the reclaimable bytes when
+ * the usage is below the target or the cgroup has no limit. Only on systems
+ * with neither source is the usage polled every poll interval instead, against
+ * the cgroup limit or else the system's available memory. A reclaim is followed
+ * by one PSI window during which further pressure is not acted upon.
+ */
+class IFE_EXPORT MemoryPressureMonitor {
+public:
+    explicit MemoryPressureMonitor  (const MemoryPressureCreateInfo& = MemoryPressureCreateInfo());
+    ~MemoryPressureMonitor          ();
+    MemoryPressureMonitor           (const MemoryPressureMonitor&) = delete;
+    MemoryPressureMonitor& operator=(const MemoryPressureMonitor&) = delete;
+    MemoryPressureStats stats       () const;
+private:
+    std::shared_ptr<struct __MemoryPressureMonitor> __monitor;
+};
+#endif
+
 // MARK: - ENTRY METHODS
 #ifndef __EMSCRIPTEN__
 /// Perform quick check to see if this file header matches an Iris format. This does NOT validate.
@@ -129,6 +362,13 @@ bool IFE_EXPORT is_Iris_Codec_file    (BYTE* const __mapped_file_ptr,
  */
 Result IFE_EXPORT validate_file_structure (BYTE* const __mapped_file_ptr,
                                            size_t file_size) noexcept;
+/**
+ * @brief Performs deep file validation checks, validating the tile table and metadata trees
+ * in parallel upon the executor (NULL uses the default executor).
+ */
+Result IFE_EXPORT validate_file_structure (BYTE* const __mapped_file_ptr,
+                                           size_t file_size,
+                                           const SharedExecutor& executor) noexcept;
 /**
  * @brief Abstract the Iris file structure into memory for quick data access. This does NOT validate.
  *
@@ -142,6 +382,55 @@ Result IFE_EXPORT validate_file_structure (BYTE* const __mapped_file_ptr,
 // START HERE: THIS IS THE MAIN ENTRY FUNCTION TO THE FILE
 Abstraction::File IFE_EXPORT abstract_file_structure (BYTE* const __mapped_file_ptr,
                                                       size_t file_size);
+/**
+ * @brief Abstract the Iris file structure into memory, reading the tile table, attributes,
+ * associated images, ICC profile and annotations in parallel upon the executor (NULL uses
+ * the default executor). This does NOT validate.
+ */
+Abstraction::File IFE_EXPORT abstract_file_structure (BYTE* const __mapped_file_ptr,
+                                                      size_t file_size,
+                                                      const SharedExecutor& executor);
+/**
+ * @brief Abstract the Iris file structure into memory, deferring the metadata sub-blocks. This does NOT validate.
+ *
+ * Only the file header, tile table and metadata header values are read on open. The attributes,
+ * associated images, ICC profile and annotations are each read on first access of their
+ * \ref Abstraction::LazyBlock handle (once, thread-safe); tile-only services never touch them.
+ * The mapped file must outlive the returned abstraction and all copies of its handles.
+ */
+Abstraction::LazyFile IFE_EXPORT abstract_file_structure_lazy (BYTE* const __mapped_file_ptr,
+                                                               size_t file_size);
+/**
+ * @brief Abstract the tile table of a single plane of a multi-plane slide. This does NOT validate.
+ *
+ * Only the layer extents and the tile offsets array of the requested plane are read; the tile
+ * offsets of other focal planes or channels remain untouched. Plane 0 is the primary plane
+ * returned by \ref abstract_file_structure.
+ */
+Abstraction::TileTable IFE_EXPORT abstract_tile_plane (BYTE* const __mapped_file_ptr,
+                                                       size_t file_size,
+                                                       uint32_t plane);
+/**
+ * @brief Open the Iris file for immediate access and validate the file structure in the background.
+ *
+ * The file header and the recovery tags of the tile table and metadata blocks are validated
+ * synchronously (throwing on failure) and the file is abstracted as per \ref abstract_file_structure_lazy.
+ * The full \ref validate_file_structure pass then runs as a low priority task upon the executor (NULL
+ * uses the default executor); the optional callback is invoked from that task with the result upon
+ * completion. Until validation passes, tile reads are bounds checked inline with
+ * \ref Abstraction::Validation::check_tile; the library's tile reads (TileReader and read_patches
+ * given the DeferredFile) perform the check. A file that fails validation is quarantined: all
+ * subsequent tile checks fail. Destroying the last reference to the validation does not wait for
+ * the background pass: a pass not yet started is cancelled and a pass in progress runs to completion.
+ * The callback is invoked in either case (with a failure result if cancelled); the mapped file must
+ * remain mapped until then.
+ */
+Abstraction::DeferredFile IFE_EXPORT abstract_file_structure_deferred (BYTE* const __mapped_file_ptr,
+                                                                       size_t file_size,
+                                                                       std::function<void(const Result&)>
+                                                                       callback = nullptr,
+                                                                       const SharedExecutor&
+                                                                       executor = nullptr);
 /**
  * @brief Generate a file map showing the offset locations of header and array blocks with their respective
  * types and sizes detailed. This is not a cheap method and does not need to be routinely done; only when
@@ -159,6 +448,8 @@ Abstraction::FileMap IFE_EXPORT generate_file_map (BYTE* const __mapped_file_ptr
 
 #elif /* EMSCRIPTEN WEB ASSEMBLY */ defined __EMSCRIPTEN__
 using Response = std::shared_ptr<struct __Response>;
+/// Remote data block fetched once and shared (read only) by every copy of a DATA_BLOCK
+using RemoteBlock = std::shared_ptr<struct __RemoteBlock>;
 /// Perform quick check to see if this file header matches an Iris format. This does NOT validate.
 bool IFE_EXPORT is_Iris_Codec_file    (const std::string url,
                                        size_t file_size);
@@ -183,6 +474,59 @@ Result IFE_EXPORT validate_file_structure (const std::string url,
 // START HERE: THIS IS THE MAIN ENTRY FUNCTION TO THE FILE
 Abstraction::File IFE_EXPORT abstract_file_structure (const std::string url,
                                                       size_t file_size);
+/**
+ * @brief Abstract the Iris file structure into memory, deferring the metadata sub-blocks. This does NOT validate.
+ *
+ * Only the file header, tile table and metadata header values are fetched on open. The attributes,
+ * associated images, ICC profile and annotations are each fetched on first access of their
+ * \ref Abstraction::LazyBlock handle (once, thread-safe).
+ */
+Abstraction::LazyFile IFE_EXPORT abstract_file_structure_lazy (const std::string url,
+                                                               size_t file_size);
+/**
+ * @brief Abstract the tile table of a single plane of a multi-plane slide. This does NOT validate.
+ *
+ * Only the layer extents and the tile offsets array of the requested plane are fetched.
+ */
+Abstraction::TileTable IFE_EXPORT abstract_tile_plane (const std::string url,
+                                                       size_t file_size,
+                                                       uint32_t plane);
+/**
+ * @brief Fetch the packed mip tail (coarsest layers) of a tile table in a single request.
+ *
+ * A tile of a tail layer begins at (tile.offset - mipTail.offset) within the returned bytes.
+ * The returned array is empty if the slide has no mip tail.
+ */
+std::vector<BYTE> IFE_EXPORT fetch_mip_tail (const std::string url,
+                                             const Abstraction::TileTable& tile_table);
+/**
+ * @brief Fetch a single tile of a tiled (v2) associated image.
+ *
+ * The tile entries are returned by \ref Abstraction::AssociatedImage::thumbnail and
+ * \ref Abstraction::AssociatedImage::region. The returned array is empty for a sparse tile.
+ */
+std::vector<BYTE> IFE_EXPORT fetch_associated_tile (const std::string url,
+                                                    const Abstraction::TileEntry& tile);
+/**
+ * @brief Fetch the stored bytes of a single slide tile. The returned array is empty for a sparse tile.
+ */
+std::vector<BYTE> IFE_EXPORT fetch_tile (const std::string url,
+                                         const Abstraction::TileEntry& tile);
+/**
+ * @brief Fetch the stored bytes of many slide tiles (ex: those of a viewport) in as few requests as possible.
+ *
+ * Tiles adjacent within the file (or separated by gaps cheaper to read than a round trip to the endpoint)
+ * are read as one byte range and the ranges are requested together in multi-range (multipart/byteranges)
+ * requests. If the server does not answer with the requested ranges, they are requested in parallel single
+ * range requests. Cross-origin servers shall expose the Content-Range header. The returned arrays follow the
+ * order of the given tiles and are empty for sparse tiles. Throws if a tile cannot be fetched.
+ *
+ * Given an I/O scheduler, each request waits for a slot granted to the tag (see IOScheduler::acquire).
+ */
+std::vector<std::vector<BYTE>> IFE_EXPORT fetch_tiles (const std::string url,
+                                                      const std::vector<Abstraction::TileEntry>& tiles,
+                                                      const SharedIOScheduler& = nullptr,
+                                                      const IOTag& = IOTag());
 #endif
 // MARK: - FILE ABSTRACTIONS
 // The file abstractions pull light-weight
@@ -197,19 +541,86 @@ namespace Abstraction {
  * used to validate the file such as the magic number;
  * this was used internally already to produce the footer
  */
+/**
+ * @brief 128-bit sampled content fingerprint of the slide image data
+ *
+ * Identifies a slide by its tile table, layer extents, tile offsets array
+ * and a deterministic sample of tile payloads (see generate_fingerprint),
+ * making it suitable as a cache or deduplication key. Metadata edits do not
+ * alter the fingerprint; tile changes do. A zero value is the NULL fingerprint
+ * (not computed, or not stored within the file).
+ */
+struct IFE_EXPORT Fingerprint {
+    static constexpr
+    uint32_t        SAMPLES     = 64;   // Default sampled tiles per layer
+    uint64_t        low         = 0;
+    uint64_t        high        = 0;
+    explicit operator bool      () const {return low || high;}
+    bool operator ==            (const Fingerprint&) const = default;
+    /// 32 character hexadecimal representation (high then low)
+    std::string     to_string   () const;
+};
 struct IFE_EXPORT Header {
     Size            fileSize    = 0;
     uint32_t        extVersion  = 0;
     uint32_t        revision    = 0;
+    Fingerprint     fingerprint;        // Stored fingerprint (v2; NULL if absent)
 };
 /**
- * @brief RESERVED FOR FUTURE IRIS CODEC IMPLEMENTATION
+ * @brief Authenticated encryption algorithm of encrypted (v2) tile data.
+ */
+enum IFE_EXPORT CipherAlgorithm : uint8_t {
+    CIPHER_UNDEFINED            = 0,
+    CIPHER_AES_128_GCM          = 1,
+    CIPHER_AES_256_GCM          = 2,
+};
+/**
+ * @brief Per-tile encryption parameters of an encrypted slide (v2).
+ *
+ * Each tile is encrypted independently such that tiles remain randomly
+ * accessible. An encrypted tile is stored as NONCE || CIPHERTEXT || TAG
+ * and its TileEntry::size includes the OVERHEAD bytes. The tile plane,
+ * layer and index are authenticated with the tile (GCM additional data);
+ * a tile moved to a different location fails authentication.
  *
- * This is related to ongoing research related to image
- * compression and is reserved for future use.
+ * The check nonce and tag authenticate an empty message under the slide
+ * key so that a key may be verified (see verify_cipher_key) before
+ * any tile is read. A NULL offset indicates the tiles are not encrypted.
  */
 struct IFE_EXPORT Cipher {
+    static constexpr
+    uint32_t        NONCE_SIZE  = 12;
+    static constexpr
+    uint32_t        TAG_SIZE    = 16;
+    static constexpr
+    uint32_t        OVERHEAD    = NONCE_SIZE + TAG_SIZE;
     Offset          offset      = NULL_OFFSET;
+    CipherAlgorithm algorithm   = CIPHER_UNDEFINED;
+    std::array<BYTE, NONCE_SIZE> checkNonce {};
+    std::array<BYTE, TAG_SIZE>   checkTag   {};
+    explicit operator bool      () const {return offset != NULL_OFFSET;}
+};
+/**
+ * @brief Expanded (AES-NI accelerated where supported) tile cipher key.
+ * Immutable once created and may be shared between decoding threads.
+ */
+using CipherKey = std::shared_ptr<const struct __CipherKey>;
+/**
+ * @brief A single tile encryption / decryption operation.
+ *
+ * The plane, layer and tile index identify the tile location that is
+ * authenticated with the tile. The source is size bytes; the destination
+ * shall hold size + Cipher::OVERHEAD bytes when encrypting and
+ * size - Cipher::OVERHEAD bytes when decrypting. The destination may
+ * not overlap the source.
+ */
+struct IFE_EXPORT CipherTile {
+    uint32_t        plane       = 0;
+    uint32_t        layer       = 0;
+    uint32_t        tile        = 0;
+    const BYTE*     source      = nullptr;
+    Size            size        = 0;
+    BYTE*           destination = nullptr;
 };
 /**
  * @brief Compressed tile data byte offset and size within
@@ -225,6 +636,32 @@ struct IFE_EXPORT TileEntry {
     Offset          offset      = NULL_OFFSET;
     uint32_t        size        = 0;
 };
+/**
+ * @brief Pixel dimensions of the tiles within a layer.
+ *
+ * Version 1 files use standard 256x256 pixel Iris tiles. Version 2
+ * files may encode larger tiles (ex: 512 or 1024) per layer such
+ * that fewer tile requests are needed to fill a view.
+ */
+struct IFE_EXPORT TileExtent {
+    static constexpr
+    uint16_t        STANDARD    = 256;
+    uint16_t        width       = STANDARD;
+    uint16_t        height      = STANDARD;
+};
+using TileExtents = IFE_EXPORT std::vector<TileExtent>;
+/**
+ * @brief Image planes of a multi-plane (v2) tile table.
+ *
+ * Focal planes (z-stacks) carry the focal offset in micrometers
+ * and channel planes (ex: multiplexed immunofluorescence) carry
+ * the channel emission wavelength in nanometers as the plane value.
+ */
+enum IFE_EXPORT PlaneType : uint8_t {
+    PLANE_UNDEFINED             = 0,
+    PLANE_FOCAL                 = 1,
+    PLANE_CHANNEL               = 2,
+};
 /**
  * @brief Light-weight in-memory representation of the WSI
  * file mapped tile data.
@@ -232,25 +669,44 @@ struct IFE_EXPORT TileEntry {
  * This will give all information necessary to decode the
  * WSI tiles into a renderable format.
  *
- * Cipher is reserved for future use.
+ * The cipher (TileTable::Cipher), when present, describes the
+ * per-tile encryption of the tile data (see decrypt_tiles).
  *
  * The extent (TileTable::Extent) is the Iris::Extent detailing the
  * pixel width / height of the level (0) / most zoomed out image
- * view as well as the layer extents in standard Iris tiles
- * (256x256 pixel tiles).
+ * view as well as the layer extents in tiles. The tile extents
+ * (TileTable::TileExtents) give the tile pixel dimensions of each
+ * layer; version 1 files always use standard 256x256 pixel tiles.
  *
  * The layers (TileTable::Layers) is an
  * array of layer arrays giving the byte-offset locations
  * of each tile of each layer relative to the beginning
  * of the whole file (ie byte 0 of the mapped file).
+ *
+ * The mip tail (TileTable::MipTail), when present, is a
+ * single byte range containing every tile of the coarsest
+ * layers such that the overview pyramid can be read at
+ * once (ex: one remote request at open).
  */
 struct IFE_EXPORT TileTable {
     using Layer     = std::vector<TileEntry>;
     using Layers    = std::vector<Layer>;
+    using Planes    = std::vector<float>;
+    struct MipTail {
+        Offset      offset      = NULL_OFFSET;      // Contiguous tile data of the coarsest layers
+        Size        size        = 0;
+        uint32_t    layers      = 0;                // Layers [0, layers) of the primary plane
+    };
     Encoding        encoding    = TILE_ENCODING_UNDEFINED;
     Format          format      = FORMAT_UNDEFINED;
     Layers          layers;
     Extent          extent;
+    TileExtents     tileExtents;                    // Tile pixel dimensions per layer
+    MipTail         mipTail;                        // Packed coarse layers (v2)
+    Cipher          cipher;                         // Tile encryption (v2); NULL if plaintext
+    PlaneType       planeType   = PLANE_UNDEFINED;  // Multi-plane slides (v2)
+    Planes          planes;                         // Value of each plane; empty if single plane
+    uint32_t        plane       = 0;                // Plane described by the layers
 };
 /**
  * @brief Abstraction of non-tile and named associated
@@ -260,21 +716,113 @@ struct IFE_EXPORT TileTable {
  * the images to a rendering system without actually
  * reading the image data from disk and decompressing it.
  *
+ * Large (v2) associated images such as macro / overview images
+ * may instead be stored as a small tiled pyramid
+ * (AssociatedImage::Pyramid) located by its own layer extents
+ * and tile offsets arrays. Each tile is a separately encoded
+ * image (AssociatedImageInfo::encoding). Tiled images carry no
+ * monolithic byte stream (byteSize 0); AssociatedImage::thumbnail
+ * and AssociatedImage::region return the few tiles a reader
+ * requires (ex: a single tile for a macro preview).
  */
 struct IFE_EXPORT AssociatedImage {
     using Info                  = AssociatedImageInfo;
+    struct Pyramid {
+        TileTable::Layers layers;               // Tile byte ranges (0 is the lowest resolution)
+        Extent          extent;                 // Layer 0 pixel extent and the layer extents
+        TileExtents     tileExtents;            // Tile pixel dimensions per layer
+    };
+    struct Tile {
+        uint32_t        layer   = 0;
+        uint32_t        index   = 0;            // Tile index within the layer (row-major)
+        uint32_t        x       = 0;            // Tile column
+        uint32_t        y       = 0;            // Tile row
+        TileEntry       entry;                  // Tile byte range; NULL_OFFSET if sparse
+    };
+    using Tiles                 = std::vector<Tile>;
     Offset          offset      = NULL_OFFSET;
     Size            byteSize    = 0;
     Info            info;
+    Pyramid         pyramid;                    // Tiled (v2) images only
+
+    bool            tiled       () const noexcept {return pyramid.layers.size();}
+    /// Pixel extent of a pyramid layer; the last layer is info.width x info.height
+    uint32_t        layer_width (uint32_t layer) const;
+    uint32_t        layer_height(uint32_t layer) const;
+    /**
+     * @brief Tiles of the lowest resolution layer of at least width x height
+     * pixels (else the highest resolution layer) from which a thumbnail of
+     * that size is downsampled. Empty if the image is not tiled.
+     */
+    Tiles           thumbnail   (uint32_t width, uint32_t height) const;
+    /**
+     * @brief Tiles of a layer intersecting the pixel region (in that layer's
+     * pixel coordinates). Empty if the image is not tiled.
+     */
+    Tiles           region      (uint32_t layer, uint32_t x, uint32_t y,
+                                 uint32_t width, uint32_t height) const;
 };
 /**
  * @brief Label-image dictionary for associated images
  */
 using AssociatedImages = IFE_EXPORT std::unordered_map<std::string, AssociatedImage>;
+/**
+ * @brief Compression of the (v2) attribute and text / SVG annotation byte blocks.
+ */
+enum IFE_EXPORT TextCompression : uint8_t {
+    TEXT_UNCOMPRESSED           = 0,
+    TEXT_LZ_DICTIONARY          = 1,
+};
+/**
+ * @brief Shared text compression dictionary.
+ *
+ * Dictionaries are trained from representative text such as the DICOM
+ * attributes of many slides from a scanner (see train_text_dictionary).
+ * A file either embeds its dictionary or references it by identifier; a
+ * referenced dictionary shall be registered (see register_text_dictionary)
+ * before the compressed blocks are read. Identifier 0 denotes an
+ * unregistered dictionary and requires the dictionary be embedded.
+ */
+struct IFE_EXPORT TextDictionary {
+    static constexpr
+    size_t          DEFAULT_SIZE    = 16384;
+    static constexpr
+    size_t          MAX_SIZE        = 65535;    // Bytes addressable by the codec window
+    uint32_t        identifier      = 0;
+    std::string     bytes;
+};
+/**
+ * @brief Key directory of an uncompressed (v2) attributes byte array
+ *
+ * Directory entries are sorted by the 64-bit hash of the attribute key and
+ * locate the key and value bytes within the attributes byte array. A reader
+ * binary searches the directory and reads (or range fetches) only the values
+ * of the keys it requires. Keys are confirmed against the key bytes as
+ * differing keys may share a hash. See ATTRIBUTES::read_attributes.
+ */
+struct IFE_EXPORT AttributeDirectory {
+    struct Entry {
+        uint64_t    hash        = 0;    // XXH64 of the key bytes
+        uint32_t    keyOffset   = 0;    // Key offset within the attributes byte array
+        uint16_t    keySize     = 0;
+        uint32_t    valueOffset = 0;    // Value offset within the attributes byte array
+        uint32_t    valueSize   = 0;
+    };
+    using Entries               = std::vector<Entry>;
+    Offset          bytes       = NULL_OFFSET; // File offset of the attributes byte array (first byte)
+    Entries         entries;
+    /// Directory hash of an attribute key
+    static uint64_t hash        (const std::string_view& key) noexcept;
+    /// Entries whose key hash matches that of the key (sorted directories only)
+    std::pair<Entries::const_iterator, Entries::const_iterator>
+                    find        (const std::string_view& key) const;
+};
 /**
  * @brief Annotation abstraction containing on-slide annotations by annotation
  * identifier (24-bit value) and annotation groups by group name (string)
  *
+ * Compressed (v2) text and SVG annotation bytes are decoded with
+ * decompress_text using the array dictionary (Annotations::dictionary).
  */
 struct IFE_EXPORT Annotation {
     using       Identifier  = Iris::Annotation::Identifier;
@@ -292,6 +840,7 @@ struct IFE_EXPORT Annotation {
     uint32_t    width       = 0;
     uint32_t    height      = 0;
     uint32_t    parent      = 0;
+    TextCompression compression = TEXT_UNCOMPRESSED;
 };
 struct IFE_EXPORT AnnotationGroup {
     Offset      offset      = NULL_OFFSET;
@@ -302,12 +851,149 @@ struct IFE_EXPORT Annotations :
 public std::unordered_map<Annotation::Identifier, Annotation> {
     using       Groups = std::unordered_map<std::string, AnnotationGroup>;
     Groups      groups;
+    std::shared_ptr<const TextDictionary> dictionary;   // Compressed annotations (v2)
+};
+/**
+ * @brief Spatial bucket index of a spatially ordered annotation array (v2)
+ *
+ * When an annotation array is written with a spatial index, the annotation
+ * entries are stored along a Z-order (Morton) curve of coarse cells laid over
+ * the annotation location space (origin 0,0; locations beyond the grid are
+ * clamped into the edge cells). Each bucket maps one occupied cell to the
+ * contiguous run of entries whose location falls within that cell.
+ *
+ * AnnotationIndex::query returns the entry ranges that may intersect a
+ * viewport along with their byte ranges within the file. Remote readers
+ * can fetch only those ranges (and the referenced annotation bytes) rather
+ * than the full annotations array. See ANNOTATIONS::read_annotations.
+ */
+struct IFE_EXPORT AnnotationIndex {
+    struct Bucket {
+        uint32_t    cell        = 0;    // Morton (Z-order) code of the cell
+        uint32_t    first       = 0;    // Index of the first entry in the cell
+        uint32_t    number      = 0;    // Number of entries in the cell
+    };
+    struct EntryRange {
+        uint32_t    first       = 0;    // Index of the first entry in the range
+        uint32_t    number      = 0;    // Number of entries in the range
+        Offset      offset      = NULL_OFFSET; // File offset of the first entry
+        Size        byteSize    = 0;    // Bytes spanned by the entry range
+    };
+    using Buckets               = std::vector<Bucket>;
+    using EntryRanges           = std::vector<EntryRange>;
+    float           cellWidth   = 0.f;
+    float           cellHeight  = 0.f;
+    uint16_t        xCells      = 0;
+    uint16_t        yCells      = 0;
+    float           maxXSize    = 0.f;  // Largest annotation x-size in the array
+    float           maxYSize    = 0.f;  // Largest annotation y-size in the array
+    Offset          entries     = NULL_OFFSET; // File offset of entry zero
+    uint16_t        entrySize   = 0;
+    Buckets         buckets;
+    /**
+     * @brief Find the annotation entry ranges that may intersect the
+     * viewport. Ranges are sorted and adjacent ranges are merged. A negative
+     * width or height spans the viewport to the left of or above x or y.
+     */
+    EntryRanges     query       (float x, float y, float width, float height) const;
+};
+/**
+ * @brief Level-of-detail annotation aggregates for zoomed-out rendering
+ *
+ * Annotations are bucketed by the highest resolution layer tile containing
+ * their location (annotation locations are in highest resolution layer pixels).
+ * Each pyramid layer groups those tiles into layer cells (power-of-two blocks
+ * of tiles matching the layer downsample). Layer cells containing more than
+ * AnnotationLOD::clusterSize annotations are summarized by a cluster with the
+ * annotation count, bounding box and most frequent type and group.
+ *
+ * AnnotationLOD::query returns clusters for dense cells and individual
+ * annotation identifiers for sparse cells, bounding the number of overlay
+ * objects drawn per visible cell at every zoom level. Generate once on open
+ * (see generate_annotation_lod) and cache it with the file abstraction.
+ */
+struct IFE_EXPORT AnnotationLOD {
+    static constexpr
+    uint32_t        CLUSTER_SIZE= 32;
+    using Identifier            = Annotation::Identifier;
+    struct Cluster {
+        uint32_t    number      = 0;    // Number of clustered annotations
+        float       xLocation   = 0.f;  // Bounding box of the clustered annotations
+        float       yLocation   = 0.f;
+        float       xSize       = 0.f;
+        float       ySize       = 0.f;
+        Annotation::Type type   = ANNOTATION_UNDEFINED; // Most frequent type
+        std::string group;              // Most frequent group (empty if ungrouped)
+    };
+    struct Layer {
+        uint32_t    shift       = 0;    // Log2 of tiles per layer cell edge
+        std::vector<uint32_t>   cells;  // Morton codes of clustered layer cells (sorted)
+        std::vector<Cluster>    clusters; // Cluster of each clustered layer cell
+    };
+    struct View {
+        std::vector<Cluster>    clusters;
+        std::vector<Identifier> annotations;
+    };
+    using Entry                 = std::pair<uint32_t, Identifier>;
+    using Entries               = std::vector<Entry>;
+    using Layers                = std::vector<Layer>;
+    float           cellLength  = 256.f;// Highest resolution tile edge (annotation units)
+    uint16_t        xCells      = 0;
+    uint16_t        yCells      = 0;
+    float           maxXSize    = 0.f;  // Largest annotation x-size
+    float           maxYSize    = 0.f;  // Largest annotation y-size
+    uint32_t        clusterSize = CLUSTER_SIZE;
+    Entries         entries;            // Annotations sorted by Morton code of their tile
+    Layers          layers;             // One per pyramid layer (0 is the lowest resolution)
+    /**
+     * @brief Retrieve the clusters and individual annotations that may intersect
+     * the viewport (in annotation units) when rendering the given layer. A
+     * negative width or height spans the viewport to the left of or above x or y.
+     */
+    View            query       (uint32_t layer, float x, float y, float width, float height) const;
+};
+/**
+ * @brief Bytes of memory held by a file abstraction, by component
+ *
+ * Component sizes are the bytes requested from the allocator by the
+ * component containers (vector capacities, string buffers beyond the small
+ * string buffer, hash and tree nodes and hash bucket arrays) and exclude the
+ * allocator's own bookkeeping. Node sizes are modeled on the libstdc++ /
+ * libc++ container layouts; with other standard libraries the figures are an
+ * estimate. The estimate is checked against instrumented allocations to
+ * within 2% (tests/ife_footprint_tests). The object size is that of the abstraction object
+ * itself (ex: sizeof(File)), which is held on the heap if the caller
+ * allocates it there. Shared (registered) text dictionaries are not
+ * attributed to the file.
+ *
+ * Lazy abstractions (LazyFile) include the shared state of each lazy block
+ * handle within the object size; the captures of blocks yet to be read are
+ * not included. Remote (WebAssembly) lazy abstractions retain the fetched
+ * file header and metadata block responses until every metadata sub-block
+ * has been read; those bytes are reported as remote.
+ */
+struct IFE_EXPORT MemoryFootprint {
+    Size            object      = 0;    // The abstraction object itself
+    Size            tileTable   = 0;    // Tile entries, layer and tile extents, planes
+    Size            images      = 0;    // Associated image map, titles and pyramids
+    Size            attributes  = 0;    // Attribute keys and values
+    Size            ICC_profile = 0;
+    Size            annotations = 0;    // Annotation map, groups and dictionary
+    Size            annotationLOD = 0;
+    Size            metadata    = 0;    // Metadata image label and annotation identifier sets
+    Size            remote      = 0;    // Retained remote responses (WebAssembly)
+    Size            total       () const noexcept
+    {return object + tileTable + images + attributes + ICC_profile +
+            annotations + annotationLOD + metadata + remote;}
 };
 /**
  * @brief In-memory abstraction of the Iris file structure
  *
  * This is a low-overhead file abstraction that allows for
  * fast access to the underlying slide data.
+ *
+ * The footprint is accumulated component by component as the file
+ * is abstracted; call memory_footprint after modifying the abstraction.
  */
 struct IFE_EXPORT File {
     Header              header;
@@ -315,12 +1001,454 @@ struct IFE_EXPORT File {
     AssociatedImages    images;
     Annotations         annotations;
     Metadata            metadata;
+    MemoryFootprint     footprint;
+};
+/**
+ * @brief Thread-safe handle to a lazily read file abstraction component
+ *
+ * The component is read from the file on first access, exactly once regardless
+ * of the number of accessing threads, and cached thereafter. Copies of a handle
+ * share the cached value. Should the read throw, the exception propagates to
+ * the accessing caller and the next access retries the read. A default
+ * constructed handle refers to an absent component and returns an empty value.
+ */
+template <typename T>
+class LazyBlock {
+public:
+    using Loader                = std::function<T()>;
+    LazyBlock                   () = default;
+    explicit LazyBlock          (Loader&& loader) :
+    __state                     (std::make_shared<State>(std::move(loader))) {}
+    const T&    get             () const;
+    const T&    operator *      () const {return get();}
+    const T*    operator ->     () const {return &get();}
+    /// Has the component been read (without reading it)
+    bool        loaded          () const noexcept
+    {return __state && __state->loaded.load(std::memory_order_acquire);}
+    /// Bytes of the shared handle state (make_shared control block and state)
+    size_t      state_size      () const noexcept
+    {return __state ? sizeof(State) + 2 * sizeof(void*) : 0;}
+private:
+    struct State {
+        explicit State          (Loader&& __l) : loader(std::move(__l)) {}
+        Loader                  loader;
+        std::once_flag          once;
+        std::atomic<bool>       loaded  = false;
+        T                       value;
+    };
+    std::shared_ptr<State>      __state;
+};
+template <typename T>
+inline const T& LazyBlock<T>::get () const
+{
+    static const T empty {};
+    if (!__state) return empty;
+    auto& state = *__state;
+    std::call_once(state.once, [&state] {
+        state.value     = state.loader();
+        state.loader    = nullptr; // Release the captured file references
+        state.loaded.store(true, std::memory_order_release);
+    });
+    return state.value;
+}
+/**
+ * @brief In-memory abstraction of the Iris file structure with
+ * lazily read metadata sub-blocks
+ *
+ * The header, tile table and metadata header values (codec version,
+ * microns per pixel, magnification) are read on open. The metadata
+ * attributes, ICC profile, associated image and annotation sets are
+ * not populated within LazyFile::metadata; access them through their
+ * respective handles instead. The annotation level of detail is
+ * generated from the annotations on first access.
+ */
+struct IFE_EXPORT LazyFile {
+    Header                      header;
+    TileTable                   tileTable;
+    Metadata                    metadata;
+    LazyBlock<Attributes>       attributes;
+    LazyBlock<AssociatedImages> images;
+    LazyBlock<std::string>      ICC_profile;
+    LazyBlock<Annotations>      annotations;
+    LazyBlock<AnnotationLOD>    annotationLOD;
+    MemoryFootprint             footprint;      // Components read on open; see memory_footprint
+};
+#ifndef __EMSCRIPTEN__
+enum ValidationState : uint8_t {
+    VALIDATION_PENDING          = 0,
+    VALIDATION_PASSED           = 1,
+    VALIDATION_FAILED           = 2,    // The file is quarantined
+};
+/**
+ * @brief Background structural validation of a file opened with
+ * abstract_file_structure_deferred
+ *
+ * The validation state is an atomic flag and may be polled from any thread.
+ * Validation::check_tile is the inline tile read guard: it is a single atomic
+ * load once the file has passed, a bounds check of the tile byte range against
+ * the file size while validation is pending, and a failure once quarantined.
+ *
+ * The background pass shares its state with the validation rather than
+ * referencing it, such that the validation may be released from any thread,
+ * including from the completion callback or a task of the executor, without
+ * waiting. The state is published before the callback is invoked. Should the
+ * executor discard the pass (ex: on shutdown), the state remains pending and
+ * wait returns a failure.
+ */
+class IFE_EXPORT Validation {
+public:
+    using Callback              = std::function<void(const Result&)>;
+    explicit Validation         (const BYTE* const __mapped_file_ptr, Size file_size, Callback&&,
+                                 const SharedExecutor& = nullptr);
+    ~Validation                 ();
+    Validation                  (const Validation&) = delete;
+    Validation& operator =      (const Validation&) = delete;
+    ValidationState state       () const noexcept;
+    bool        quarantined     () const noexcept {return state() == VALIDATION_FAILED;}
+    /// Block until the background validation completes and return its result.
+    Result      wait            () const;
+    /// Check that a tile may be read from the file given the current validation state.
+    /// Sparse tiles (no bytes) pass unless the file is quarantined.
+    Result      check_tile      (const TileEntry&) const noexcept;
+private:
+    const Size                  __size;
+    std::shared_ptr<struct __ValidationPass> __pass;
+};
+/**
+ * @brief Lazily abstracted file with its background structural validation
+ */
+struct IFE_EXPORT DeferredFile : public LazyFile {
+    std::shared_ptr<const Validation> validation;
+};
+#endif
+/**
+ * @brief Region of a tile in pixels of that tile
+ */
+struct IFE_EXPORT TileRegion {
+    float           x           = 0.f;
+    float           y           = 0.f;
+    float           width       = 0.f;
+    float           height      = 0.f;
+};
+/**
+ * @brief Tile served by a deadline-aware tile read (see TileReader::read_tile).
+ *
+ * An exact read serves the requested tile and the region and target are the
+ * whole tile. A fallback read serves an ancestor tile of a coarser layer; the
+ * region is the area of the ancestor tile covering the requested tile, clamped
+ * to the ancestor tile, and shall be scaled up onto the target, the area of the
+ * requested tile it covers. Where the requested tile spans several ancestor
+ * tiles (ex: fine layers of larger tiles than the coarse layers), the target is
+ * the part of the requested tile within the ancestor tile containing its
+ * center and the remainder is left uncovered. The bytes are the stored (encoded, and if
+ * the tile table has a cipher, encrypted) tile bytes; they are empty for a
+ * sparse tile and NULL if no tile could be served in time.
+ */
+struct IFE_EXPORT TileRead {
+    using Bytes                 = std::shared_ptr<const std::vector<BYTE>>;
+    Bytes           bytes;
+    uint32_t        layer       = 0;    // Layer and index of the served tile
+    uint32_t        tile        = 0;
+    TileRegion      region;             // Area of the served tile, in pixels of the served tile
+    TileRegion      target;             // Area of the requested tile covered, in its pixels
+    bool            exact       = false;
+    explicit operator bool      () const {return bytes != nullptr;}
+};
+/**
+ * @brief Deadline-aware tile reads with coarser-layer fallback.
+ *
+ * Tiles are read on the executor and retained within a least recently used
+ * cache of the given byte budget. A read that cannot be served from the cache
+ * or completed by its deadline returns the finest cached ancestor tile (see
+ * ancestor_tile) and the exact read continues; the optional refinement callback
+ * receives the exact tile once it is read (on the executor thread, and not if
+ * the read fails). Concurrent reads of one tile share a single read.
+ *
+ * The cache is registered with the reclaim protocol (see register_cache) at
+ * RECLAIM_FIRST; under memory pressure the least recently used tiles are shed.
+ *
+ * If the executor is an IOScheduler, reads are scheduled with the tag of the
+ * read request and charged the tile bytes; a reader joining a read queued at a
+ * lower class submits it again at its own class (the first to run reads the
+ * tile). Reads rejected at the class queue depth limit throw.
+ *
+ * Given a DeferredFile (see abstract_file_structure_deferred), every read is
+ * first checked with its validation (see Validation::check_tile): reads of a
+ * quarantined file, and while validation is pending reads of tile byte
+ * ranges beyond the file, throw.
+ *
+ * The tile table and the mapped file shall outlive the reader. The destructor
+ * waits only upon reads copying tile bytes; queued reads are abandoned and no
+ * refinement is delivered once it has begun, so a reader may be destroyed from
+ * a refinement callback or a task of its executor. With the inline executor
+ * every read completes before its deadline is considered.
+ */
+class IFE_EXPORT TileReader {
+public:
+    using Clock                 = std::chrono::steady_clock;
+    using Deadline              = Clock::time_point;
+    using Callback              = std::function<void(const TileRead&)>;
+    static constexpr
+    Size            CACHE_BYTES = 64ULL << 20;
+#ifndef __EMSCRIPTEN__
+    explicit TileReader         (const BYTE* const __mapped_file_ptr, Size file_size, const TileTable&,
+                                 const SharedExecutor& = nullptr, Size cache_bytes = CACHE_BYTES);
+    explicit TileReader         (const BYTE* const __mapped_file_ptr, Size file_size, const DeferredFile&,
+                                 const SharedExecutor& = nullptr, Size cache_bytes = CACHE_BYTES);
+#else
+    explicit TileReader         (const std::string url, const TileTable&,
+                                 const SharedExecutor& = nullptr, Size cache_bytes = CACHE_BYTES);
+#endif
+    ~TileReader                 ();
+    TileReader                  (const TileReader&) = delete;
+    TileReader& operator =      (const TileReader&) = delete;
+    /// Read a tile, falling back to the finest cached ancestor if it cannot be read by the deadline.
+    TileRead    read_tile       (uint32_t layer, uint32_t tile, Deadline,
+                                 Callback refined = nullptr, const IOTag& = IOTag());
+    /// Read a tile exactly, blocking until it is read. Throws if the read fails.
+    TileRead    read_tile       (uint32_t layer, uint32_t tile, const IOTag& = IOTag());
+    /// Bytes currently retained within the cache
+    Size        cached_bytes    () const;
+private:
+    std::shared_ptr<struct __TileReader> __reader;
+    CacheRegistration           __registration;
+};
+/**
+ * @brief Center point of a multi-scale patch in pixels of the highest resolution layer.
+ */
+struct IFE_EXPORT PatchCenter {
+    float           x           = 0.f;
+    float           y           = 0.f;
+};
+/**
+ * @brief Patch size read about every center point at one layer.
+ */
+struct IFE_EXPORT PatchScale {
+    uint32_t        layer       = 0;
+    uint32_t        width       = TileExtent::STANDARD;     // Patch pixels in the layer
+    uint32_t        height      = TileExtent::STANDARD;
+};
+/**
+ * @brief Patch of one center point at one scale, located within the grid of
+ * tiles covering it.
+ *
+ * Decoding the grid's tiles into a columns x rows tile canvas, the patch is
+ * the width x height region at (xOffset, yOffset). Grid cells beyond the layer
+ * refer to no tile (NULL_TILE) and are padding, as are sparse tiles.
+ */
+struct IFE_EXPORT ScalePatch {
+    static constexpr
+    uint32_t        NULL_TILE   = UINT32_MAX;
+    uint32_t        layer       = 0;
+    int64_t         x           = 0;    // Patch origin in layer pixels (negative at the layer edge)
+    int64_t         y           = 0;
+    uint32_t        width       = 0;
+    uint32_t        height      = 0;
+    int64_t         column      = 0;    // First tile column and row of the grid (may be negative)
+    int64_t         row         = 0;
+    uint32_t        columns     = 0;
+    uint32_t        rows        = 0;
+    uint32_t        xOffset     = 0;    // Patch origin within the grid's first tile
+    uint32_t        yOffset     = 0;
+    std::vector<uint32_t> tiles;        // Row-major grid cells: indices within PatchBatch::tiles
+};
+/**
+ * @brief Multi-scale patches of a batch of center points and the tiles they share.
+ *
+ * Each tile is listed (and read) once however many patches and scales cover
+ * it. The tile bytes are the stored (encoded, and if the tile table has a
+ * cipher, encrypted) tile bytes; they are empty for sparse tiles and NULL
+ * until read.
+ */
+struct IFE_EXPORT PatchBatch {
+    struct Tile {
+        uint32_t        layer   = 0;
+        uint32_t        index   = 0;
+        TileEntry       entry;
+        TileRead::Bytes bytes;
+    };
+    using Patches               = std::vector<ScalePatch>;
+    std::vector<Tile>           tiles;
+    std::vector<Patches>        patches;                // [center][scale]
+    Size                        tileBytes   = 0;        // Stored bytes of the batch's tiles
+    Size                        patchBytes  = 0;        // Stored bytes were each patch read alone
 };
 struct IFE_EXPORT FileMap :
 public std::map<Offset, struct FileMapEntry> {
     Size                file_size   = 0;
 };
 }
+/**
+ * @brief Generate the level-of-detail annotation aggregates of an abstracted file.
+ *
+ * This is a linear pass over the annotations per layer and is intended to be
+ * performed once on open (or on first zoomed-out overlay) and cached. Provide the
+ * mapped file pointer to resolve the most frequent annotation group of each cluster;
+ * without it, clusters only report the most frequent annotation type.
+ */
+Abstraction::AnnotationLOD IFE_EXPORT generate_annotation_lod
+(const Abstraction::File&, const BYTE* const __mapped_file_ptr = nullptr,
+ uint32_t cluster_size = Abstraction::AnnotationLOD::CLUSTER_SIZE);
+/**
+ * @brief Locate the tile of a coarser (ancestor) layer that covers a tile.
+ *
+ * The tile pixel extent is scaled between the layers by the layer extents'
+ * downsample factors (the scale factors if the downsample is not encoded). The
+ * returned read carries the ancestor layer, the ancestor tile (in the ancestor
+ * layer's own tile extent) containing the center of the tile, the region of the
+ * ancestor tile covering the tile (clamped to the ancestor tile) and the target
+ * area of the tile that region covers; its bytes are NULL. Throws if either
+ * layer or the tile is out of range.
+ */
+Abstraction::TileRead IFE_EXPORT ancestor_tile
+(const Abstraction::TileTable&, uint32_t layer, uint32_t tile, uint32_t ancestor_layer);
+/**
+ * @brief Locate the multi-scale patches of a batch of center points.
+ *
+ * Centers are pixel coordinates of the highest resolution layer. They are
+ * scaled to each patch layer by the layer extents' downsample factors (the
+ * scale factors if the downsample is not encoded) such that every scale of a
+ * center is centered on the same point. No tile is read (see read_patches).
+ * Throws if a scale's layer is not within the tile table.
+ */
+Abstraction::PatchBatch IFE_EXPORT locate_patches
+(const Abstraction::TileTable&, const std::vector<Abstraction::PatchCenter>& centers,
+ const std::vector<Abstraction::PatchScale>& scales);
+#ifndef __EMSCRIPTEN__
+/**
+ * @brief Read the multi-scale patches of a batch of center points (see locate_patches).
+ *
+ * The batch's tiles are read once each. Their byte ranges are coalesced across
+ * layers and the merged ranges are advised to the system as needed (such that a
+ * mapped file is read ahead in large requests) before the tiles are copied upon
+ * the executor. Throws if a tile byte range exceeds the file size.
+ */
+Abstraction::PatchBatch IFE_EXPORT read_patches
+(const BYTE* const __mapped_file_ptr, Size file_size, const Abstraction::TileTable&,
+ const std::vector<Abstraction::PatchCenter>& centers, const std::vector<Abstraction::PatchScale>& scales,
+ const SharedExecutor& = nullptr);
+/**
+ * @brief Read the multi-scale patches of a file opened with abstract_file_structure_deferred.
+ *
+ * As per read_patches upon the file's tile table; every tile of the batch is first checked with
+ * the file's validation (see Validation::check_tile). Throws if the file is quarantined or, while
+ * validation is pending, if a tile byte range exceeds the file size.
+ */
+Abstraction::PatchBatch IFE_EXPORT read_patches
+(const BYTE* const __mapped_file_ptr, Size file_size, const Abstraction::DeferredFile&,
+ const std::vector<Abstraction::PatchCenter>& centers, const std::vector<Abstraction::PatchScale>& scales,
+ const SharedExecutor& = nullptr);
+#else
+/**
+ * @brief Fetch the multi-scale patches of a batch of center points (see locate_patches).
+ *
+ * The batch's tiles are fetched once each with fetch_tiles, which coalesces them into as few
+ * requests as possible.
+ */
+Abstraction::PatchBatch IFE_EXPORT fetch_patches
+(const std::string url, const Abstraction::TileTable&,
+ const std::vector<Abstraction::PatchCenter>& centers, const std::vector<Abstraction::PatchScale>& scales,
+ const SharedIOScheduler& = nullptr, const IOTag& = IOTag());
+#endif
+/**
+ * @brief Measure the memory held by a file abstraction (see MemoryFootprint).
+ *
+ * This walks the abstraction containers; the cost is linear in the number of
+ * layers, attributes, associated images and annotation groups and independent
+ * of the number of tiles and annotations.
+ */
+Abstraction::MemoryFootprint IFE_EXPORT memory_footprint
+(const Abstraction::File&) noexcept;
+/**
+ * @brief Measure the memory held by a lazy file abstraction. Lazily read
+ * components are included once they have been read; unread components are not.
+ */
+Abstraction::MemoryFootprint IFE_EXPORT memory_footprint
+(const Abstraction::LazyFile&) noexcept;
+#ifndef __EMSCRIPTEN__
+/**
+ * @brief Generate the sampled content fingerprint of a mapped Iris file.
+ *
+ * Hashes (XXH64, two seeds) the tile table encoding, format and extent, the layer
+ * extents and tile offsets arrays, and the full payloads of up to samples_per_layer
+ * evenly spaced tiles of each layer (always including the first and last tiles).
+ * The cost is independent of the slide size beyond the tile offsets array.
+ * Writers may store the fingerprint within the file header (see HeaderCreateInfo)
+ * so readers obtain it from Header::fingerprint at no cost.
+ */
+Abstraction::Fingerprint IFE_EXPORT generate_fingerprint
+(const BYTE* const __mapped_file_ptr, size_t file_size,
+ uint32_t samples_per_layer = Abstraction::Fingerprint::SAMPLES);
+#endif
+/**
+ * @brief Create a tile cipher key from the raw key bytes (16 bytes for
+ * CIPHER_AES_128_GCM or 32 bytes for CIPHER_AES_256_GCM).
+ *
+ * The key schedule is expanded once. AES-NI / PCLMULQDQ are used when the
+ * processor supports them; other targets (ex: ARM, WebAssembly) use the
+ * portable software implementation. Throws on an invalid algorithm or key size.
+ */
+Abstraction::CipherKey IFE_EXPORT create_cipher_key
+(Abstraction::CipherAlgorithm, const BYTE* const key, size_t key_bytes);
+/**
+ * @brief Verify that the key is the slide cipher key using the cipher check tag.
+ */
+Result IFE_EXPORT verify_cipher_key
+(const Abstraction::Cipher&, const Abstraction::CipherKey&) noexcept;
+/**
+ * @brief Encrypt a single tile (writers). A random nonce is drawn per tile such
+ * that a re-encoded tile (ex: a tile amendment) never reuses a nonce.
+ */
+void IFE_EXPORT encrypt_tile
+(const Abstraction::CipherKey&, const Abstraction::CipherTile&);
+/**
+ * @brief Authenticate and decrypt a single tile. On failure the destination is zeroed.
+ */
+Result IFE_EXPORT decrypt_tile
+(const Abstraction::CipherKey&, const Abstraction::CipherTile&) noexcept;
+/**
+ * @brief Authenticate and decrypt a batch of tiles upon the executor (NULL uses the default executor).
+ *
+ * Intended for batched tile reads (ex: a view or a mip tail). The batch
+ * fails if any tile fails authentication; the failing tiles' destinations
+ * are zeroed and the remaining tiles are still decrypted.
+ */
+Result IFE_EXPORT decrypt_tiles
+(const Abstraction::CipherKey&, const std::vector<Abstraction::CipherTile>&, const SharedExecutor& = nullptr) noexcept;
+/**
+ * @brief Train a text compression dictionary from sample text blocks.
+ *
+ * Samples should be representative of the blocks to be compressed (ex: the
+ * serialized attributes or SVG annotations of many slides). Content recurring
+ * across samples is retained; content unique to a single sample is not.
+ */
+Abstraction::TextDictionary IFE_EXPORT train_text_dictionary
+(const std::vector<std::string>& samples, uint32_t identifier = 0,
+ size_t max_bytes = Abstraction::TextDictionary::DEFAULT_SIZE);
+/**
+ * @brief Train a text compression dictionary from the attributes of sample slides.
+ */
+Abstraction::TextDictionary IFE_EXPORT train_text_dictionary
+(const std::vector<Attributes>& samples, uint32_t identifier = 0,
+ size_t max_bytes = Abstraction::TextDictionary::DEFAULT_SIZE);
+/**
+ * @brief Register a dictionary by identifier such that files referencing
+ * (rather than embedding) the dictionary may be read. Registration is
+ * process-wide and thread-safe; re-registering an identifier replaces it.
+ */
+void IFE_EXPORT register_text_dictionary
+(const Abstraction::TextDictionary&);
+/**
+ * @brief Compress a text block (see TEXT_LZ_DICTIONARY), optionally with a dictionary.
+ */
+std::vector<BYTE> IFE_EXPORT compress_text
+(const BYTE* const text, size_t bytes, const Abstraction::TextDictionary* = nullptr);
+/**
+ * @brief Decompress a compressed text block with the dictionary used to compress it.
+ * Throws if the block is malformed or was compressed with a different dictionary.
+ */
+std::string IFE_EXPORT decompress_text
+(const BYTE* const compressed, size_t bytes, const Abstraction::TextDictionary* = nullptr);
 // MARK: - IRIS CODEC EXTENSION SERIALIZATION TYPES
 namespace Serialization {
 using namespace Abstraction;
@@ -363,6 +1491,11 @@ enum IFE_EXPORT RECOVERY : uint_least16_t {
     RECOVER_ANNOTATION_BYTES        = 0x550E,
     RECOVER_ANNOTATION_GROUP_SIZES  = 0x550F,
     RECOVER_ANNOTATION_GROUP_BYTES  = 0x5510,
+    // Version 1.0 ends here.
+    RECOVER_ANNOTATION_INDEX        = 0x5511,
+    RECOVER_TILE_PLANES             = 0x5512,
+    RECOVER_TEXT_DICTIONARY         = 0x5513,
+    RECOVER_ATTRIBUTES_DIRECTORY    = 0x5514,
 };
 enum IFE_EXPORT TYPE_SIZES {
     TYPE_SIZE_UINT8                 = 1,
@@ -394,7 +1527,7 @@ struct IFE_EXPORT DATA_BLOCK {
     };
 #ifdef /* WEB ASSEMBLY */ __EMSCRIPTEN__
     Offset      __remote            = NULL_OFFSET;
-    Response    __response          = NULL;
+    RemoteBlock __response          = NULL;
 #endif
     Offset      __offset            = NULL_OFFSET;
     Size        __size              = 0;
@@ -416,6 +1549,7 @@ struct IFE_EXPORT DATA_BLOCK {
  *                                                                             |--------------------------->
  *  Tile table offset location (ptr) is REQUIRED (ie NOT NULL_OFFSET)
  *  Metadata offset location   (ptr) is REQUIRED even if no metadata is encoded within the table.
+ *  Version 2 appends the 128-bit content fingerprint (zero if not stored).
  *
  */
 struct IFE_EXPORT FILE_HEADER : DATA_BLOCK {
@@ -432,6 +1566,8 @@ struct IFE_EXPORT FILE_HEADER : DATA_BLOCK {
         FILE_REVISION_S             = TYPE_SIZE_UINT32,
         TILE_TABLE_OFFSET_S         = TYPE_SIZE_UINT64,
         METADATA_OFFSET_S           = TYPE_SIZE_UINT64,
+        FINGERPRINT_LOW_S           = TYPE_SIZE_UINT64,
+        FINGERPRINT_HIGH_S          = TYPE_SIZE_UINT64,
     };
     enum vtable_offsets {
         MAGIC_BYTES_OFFSET          = 0,
@@ -446,7 +1582,13 @@ struct IFE_EXPORT FILE_HEADER : DATA_BLOCK {
         // Version 1.0 ends here.
         // -----------------------------------------------------------------------
         
-        HEADER_SIZE                 = HEADER_V1_0_SIZE
+        FINGERPRINT_LOW             = HEADER_V1_0_SIZE,
+        FINGERPRINT_HIGH            = FINGERPRINT_LOW + FINGERPRINT_LOW_S,
+        HEADER_V2_0_SIZE            = FINGERPRINT_HIGH + FINGERPRINT_HIGH_S,
+        // Version 2.0 ends here.
+        // -----------------------------------------------------------------------
+        
+        HEADER_SIZE                 = HEADER_V2_0_SIZE
     };
     Size        size                (const BYTE* const __base) const;
     Result      validate_header     (const BYTE* const __base) const;
@@ -457,7 +1599,7 @@ struct IFE_EXPORT FILE_HEADER : DATA_BLOCK {
     
     explicit FILE_HEADER            (Size file_size) noexcept;
     #ifdef __EMSCRIPTEN__
-    void check_and_fetch_remote     (const BYTE* const& __base);
+    const BYTE* check_and_fetch_remote (const BYTE* __base) const;
     #endif
 };
 #ifndef __EMSCRIPTEN__
@@ -466,6 +1608,7 @@ struct IFE_EXPORT HeaderCreateInfo {
     uint32_t    revision            = 0;
     Offset      tileTableOffset     = NULL_OFFSET;
     Offset      metadataOffset      = NULL_OFFSET;
+    bool        fingerprint         = false;    // Generate and store the content fingerprint
 };
 void STORE_FILE_HEADER              (BYTE* const __base, const HeaderCreateInfo&);
 #endif
@@ -486,6 +1629,10 @@ struct IFE_EXPORT TILE_TABLE : DATA_BLOCK {
         LAYER_EXTENTS_OFFSET_S      = TYPE_SIZE_UINT64,
         X_EXTENT_S                  = TYPE_SIZE_UINT32,
         Y_EXTENT_S                  = TYPE_SIZE_UINT32,
+        PLANES_OFFSET_S             = TYPE_SIZE_UINT64,
+        MIP_TAIL_OFFSET_S           = TYPE_SIZE_UINT64,
+        MIP_TAIL_SIZE_S             = TYPE_SIZE_UINT64,
+        MIP_TAIL_LAYERS_S           = TYPE_SIZE_UINT32,
     };
     enum vtable_offsets {
         VALIDATION                  = 0,
@@ -501,34 +1648,111 @@ struct IFE_EXPORT TILE_TABLE : DATA_BLOCK {
         // Version 1.0 ends here.
         // -----------------------------------------------------------------------
         
-        HEADER_SIZE                 = HEADER_V1_0_SIZE,
+        PLANES_OFFSET               = HEADER_V1_0_SIZE,
+        MIP_TAIL_OFFSET             = PLANES_OFFSET + PLANES_OFFSET_S,
+        MIP_TAIL_SIZE               = MIP_TAIL_OFFSET + MIP_TAIL_OFFSET_S,
+        MIP_TAIL_LAYERS             = MIP_TAIL_SIZE + MIP_TAIL_SIZE_S,
+        HEADER_V2_0_SIZE            = MIP_TAIL_LAYERS + MIP_TAIL_LAYERS_S,
+        // Version 2.0 ends here.
+        // -----------------------------------------------------------------------
+        
+        HEADER_SIZE                 = HEADER_V2_0_SIZE,
+    };
+    Size        size                () const;
+    Result      validate_offset     (const BYTE* const __base) const noexcept;
+    Result      validate_full       (const BYTE* const __base) const noexcept;
+    TileTable   read_tile_table     (const BYTE* const __base) const;
+    TileTable   read_tile_plane     (const BYTE* const __base, uint32_t plane) const;
+    LAYER_EXTENTS get_layer_extents (const BYTE* const __base) const;
+    TILE_OFFSETS  get_tile_offsets  (const BYTE* const __base) const;
+    bool        tile_planes         (const BYTE* const __base) const;
+    TILE_PLANES get_tile_planes     (const BYTE* const __base) const;
+    TILE_OFFSETS  get_plane_offsets (const BYTE* const __base, uint32_t plane) const;
+    bool        cipher              (const BYTE* const __base) const;
+    CIPHER      get_cipher          (const BYTE* const __base) const;
+    
+protected:
+    explicit    TILE_TABLE          (Offset tile_table_offset, Size file_size, uint32_t version) noexcept;
+private:
+    #ifdef __EMSCRIPTEN__
+    const BYTE* check_and_fetch_remote (const BYTE* __base) const;
+    #endif
+};
+struct IFE_EXPORT TileTableCreateInfo {
+    Offset      tileTableOffset     = NULL_OFFSET;
+    Encoding    encoding            = TILE_ENCODING_UNDEFINED;
+    Format      format              = FORMAT_UNDEFINED;
+    Offset      cipherOffset        = NULL_OFFSET;  // Optional (v2) CIPHER offset; tiles are encrypted
+    Offset      tilesOffset         = NULL_OFFSET;
+    Offset      layerExtentsOffset  = NULL_OFFSET;
+    uint32_t    layers              = 0;
+    uint32_t    widthPixels         = 0;
+    uint32_t    heightPixels        = 0;
+    Offset      planesOffset        = NULL_OFFSET;  // Optional (v2) TILE_PLANES offset
+    Offset      mipTailOffset       = NULL_OFFSET;  // Optional (v2) packed coarse layer tiles
+    Size        mipTailSize         = 0;
+    uint32_t    mipTailLayers       = 0;
+};
+void STORE_TILE_TABLE               (BYTE* const __base, const TileTableCreateInfo&);
+
+// MARK: Cipher (per-tile encryption parameters)
+/*
+ *  BREAKDOWN:
+ *  | VALIDATION | RECOVERY | ALGORITHM | CHECK NONCE | CHECK TAG |
+ *  Each encrypted tile is stored as NONCE (12) || CIPHERTEXT || TAG (16).
+ *  The additional authenticated data of a tile is its plane, layer and tile
+ *  index (3 x little endian uint32). The check tag authenticates an empty
+ *  message under the check nonce with the algorithm byte as additional data.
+ */
+struct IFE_EXPORT CIPHER : DATA_BLOCK {
+    friend TILE_TABLE;
+    static constexpr
+    char type []                    = "CIPHER";
+    static constexpr enum
+    RECOVERY    recovery            = RECOVER_CIPHER;
+    enum vtable_sizes {
+        VALIDATION_S                = TYPE_SIZE_UINT64,
+        RECOVERY_S                  = TYPE_SIZE_UINT16,
+        ALGORITHM_S                 = TYPE_SIZE_UINT8,
+        CHECK_NONCE_S               = Cipher::NONCE_SIZE,
+        CHECK_TAG_S                 = Cipher::TAG_SIZE,
+    };
+    enum vtable_offsets {
+        VALIDATION                  = 0,
+        RECOVERY                    = VALIDATION + VALIDATION_S,
+        ALGORITHM                   = RECOVERY + RECOVERY_S,
+        CHECK_NONCE                 = ALGORITHM + ALGORITHM_S,
+        CHECK_TAG                   = CHECK_NONCE + CHECK_NONCE_S,
+        HEADER_V2_0_SIZE            = CHECK_TAG + CHECK_TAG_S,
+        // Version 2.0 ends here.
+        // -----------------------------------------------------------------------
+        
+        HEADER_SIZE                 = HEADER_V2_0_SIZE,
     };
     Size        size                () const;
     Result      validate_offset     (const BYTE* const __base) const noexcept;
     Result      validate_full       (const BYTE* const __base) const noexcept;
-    TileTable   read_tile_table     (const BYTE* const __base) const;
-    LAYER_EXTENTS get_layer_extents (const BYTE* const __base) const;
-    TILE_OFFSETS  get_tile_offsets  (const BYTE* const __base) const;
+    Cipher      read_cipher         (const BYTE* const __base) const;
     
 protected:
-    explicit    TILE_TABLE          (Offset tile_table_offset, Size file_size, uint32_t version) noexcept;
+    explicit CIPHER                 () = delete;
+    explicit CIPHER                 (Offset offset, Size file_size, uint32_t version) noexcept;
 private:
     #ifdef __EMSCRIPTEN__
-    void check_and_fetch_remote     (const BYTE* const& __base);
+    const BYTE* check_and_fetch_remote (const BYTE* __base) const;
     #endif
 };
-struct IFE_EXPORT TileTableCreateInfo {
-    Offset      tileTableOffset     = NULL_OFFSET;
-    Encoding    encoding            = TILE_ENCODING_UNDEFINED;
-    Format      format              = FORMAT_UNDEFINED;
-    Offset      cipherOffset        = NULL_OFFSET;
-    Offset      tilesOffset         = NULL_OFFSET;
-    Offset      layerExtentsOffset  = NULL_OFFSET;
-    uint32_t    layers              = 0;
-    uint32_t    widthPixels         = 0;
-    uint32_t    heightPixels        = 0;
+/**
+ * @brief Per-tile encryption parameters. The check tag is generated
+ * from the key; the key itself is never stored. Encrypt the tiles with
+ * the same key (see encrypt_tile) and record their stored (encrypted) sizes.
+ */
+struct IFE_EXPORT CipherCreateInfo {
+    Offset          cipherOffset    = NULL_OFFSET;
+    CipherKey       key;
 };
-void STORE_TILE_TABLE               (BYTE* const __base, const TileTableCreateInfo&);
+Size IFE_EXPORT SIZE_CIPHER         ();
+void IFE_EXPORT STORE_CIPHER        (BYTE* const __base, const CipherCreateInfo&);
 
 // MARK: Metadata Header
 struct IFE_EXPORT METADATA : DATA_BLOCK {
@@ -588,7 +1812,7 @@ protected:
     explicit    METADATA            (Offset __metadata, Size file_size, uint32_t version) noexcept;
 private:
     #ifdef __EMSCRIPTEN__
-    void check_and_fetch_remote     (const BYTE* const& __base);
+    const BYTE* check_and_fetch_remote (const BYTE* __base) const;
     #endif
 };
 struct IFE_EXPORT MetadataCreateInfo {
@@ -617,6 +1841,9 @@ struct IFE_EXPORT ATTRIBUTES : DATA_BLOCK {
         VERSION_S                   = TYPE_SIZE_UINT16,
         LENGTHS_OFFSET_S            = TYPE_SIZE_UINT64,
         BYTE_ARRAY_OFFSET_S         = TYPE_SIZE_UINT64,
+        COMPRESSION_S               = TYPE_SIZE_UINT8,
+        DICTIONARY_OFFSET_S         = TYPE_SIZE_UINT64,
+        DIRECTORY_OFFSET_S          = TYPE_SIZE_UINT64,
     };
     enum vtable_offsets {
         VALIDATION                  = 0,
@@ -629,21 +1856,38 @@ struct IFE_EXPORT ATTRIBUTES : DATA_BLOCK {
         // Version 1.0 ends here.
         // -----------------------------------------------------------------------
         
-        HEADER_SIZE                 = HEADER_V1_0_SIZE,
+        COMPRESSION                 = HEADER_V1_0_SIZE,
+        DICTIONARY_OFFSET           = COMPRESSION + COMPRESSION_S,
+        DIRECTORY_OFFSET            = DICTIONARY_OFFSET + DICTIONARY_OFFSET_S,
+        HEADER_V2_0_SIZE            = DIRECTORY_OFFSET + DIRECTORY_OFFSET_S,
+        // Version 2.0 ends here.
+        // -----------------------------------------------------------------------
+        
+        HEADER_SIZE                 = HEADER_V2_0_SIZE,
     };
     Size        size                () const;
     Result      validate_offset     (const BYTE* const __base) const noexcept;
     Result      validate_full       (const BYTE* const __base) const noexcept;
     Attributes  read_attributes     (const BYTE* const __base) const;
+    /// Read only the requested keys using the attributes directory (v2). Only the
+    /// directory and the requested key / value bytes are read (or fetched remotely).
+    /// Keys absent from the attributes are absent from the returned attributes.
+    Attributes  read_attributes     (const BYTE* const __base, const std::vector<std::string>& keys) const;
     ATTRIBUTES_SIZES get_sizes      (const BYTE* const __base) const;
     ATTRIBUTES_BYTES get_bytes      (const BYTE* const __base) const;
+    TextCompression compression     (const BYTE* const __base) const;
+    bool        dictionary          (const BYTE* const __base) const;
+    TEXT_DICTIONARY get_dictionary  (const BYTE* const __base) const;
+    bool        directory           (const BYTE* const __base) const;
+    ATTRIBUTES_DIRECTORY get_directory (const BYTE* const __base) const;
+    AttributeDirectory read_directory (const BYTE* const __base) const;
 
 protected:
     explicit    ATTRIBUTES          () = delete;
     explicit    ATTRIBUTES          (Offset offset, Size file_size, uint32_t version) noexcept;
 private:
     #ifdef __EMSCRIPTEN__
-    void check_and_fetch_remote     (const BYTE* const& __base);
+    const BYTE* check_and_fetch_remote (const BYTE* __base) const;
     #endif
 };
 struct IFE_EXPORT AttributesCreateInfo {
@@ -652,9 +1896,67 @@ struct IFE_EXPORT AttributesCreateInfo {
     uint32_t    version             = 0;
     Offset      sizes               = NULL_OFFSET;
     Offset      bytes               = NULL_OFFSET;
+    TextCompression compression     = TEXT_UNCOMPRESSED;    // (v2) Compression of the bytes array
+    Offset      dictionary          = NULL_OFFSET;          // (v2) Optional TEXT_DICTIONARY offset
+    Offset      directory           = NULL_OFFSET;          // (v2) Optional ATTRIBUTES_DIRECTORY offset (uncompressed only)
 };
 void STORE_ATTRIBUTES               (BYTE* const __base, const AttributesCreateInfo&);
 
+// MARK: Text Dictionary
+/*
+ *  BREAKDOWN:
+ *  | VALIDATION | RECOVERY | N | IDENTIFIER | CHECKSUM | BYTE 0 | ... | BYTE N-1 |
+ *  The dictionary bytes are embedded (N > 0) or the dictionary is referenced
+ *  by its registered identifier alone (N = 0). The checksum (XXH64 of the
+ *  dictionary bytes) ensures a registered dictionary is the one used to write
+ *  the file. Compressed text blocks are LZ77 sequences primed with the
+ *  dictionary, preceded by their decoded size.
+ */
+struct IFE_EXPORT TEXT_DICTIONARY : DATA_BLOCK {
+    friend ATTRIBUTES;
+    friend ANNOTATIONS;
+    static constexpr
+    char type []                    = "TEXT_DICTIONARY";
+    static constexpr enum
+    RECOVERY    recovery            = RECOVER_TEXT_DICTIONARY;
+    enum vtable_sizes {
+        VALIDATION_S                = TYPE_SIZE_UINT64,
+        RECOVERY_S                  = TYPE_SIZE_UINT16,
+        ENTRY_NUMBER_S              = TYPE_SIZE_UINT32,
+        IDENTIFIER_S                = TYPE_SIZE_UINT32,
+        CHECKSUM_S                  = TYPE_SIZE_UINT64,
+    };
+    enum vtable_offsets {
+        VALIDATION                  = 0,
+        RECOVERY                    = VALIDATION + VALIDATION_S,
+        ENTRY_NUMBER                = RECOVERY + RECOVERY_S,
+        IDENTIFIER                  = ENTRY_NUMBER + ENTRY_NUMBER_S,
+        CHECKSUM                    = IDENTIFIER + IDENTIFIER_S,
+        HEADER_V2_0_SIZE            = CHECKSUM + CHECKSUM_S,
+        // Version 2.0 ends here.
+        // -----------------------------------------------------------------------
+        
+        HEADER_SIZE                 = HEADER_V2_0_SIZE,
+    };
+    using Dictionary                = std::shared_ptr<const TextDictionary>;
+    Size        size                (const BYTE* const __base) const;
+    Result      validate_offset     (const BYTE* const __base) const noexcept;
+    Result      validate_full       (const BYTE* const __base) const noexcept;
+    /// Embedded dictionary, else the registered dictionary of the identifier
+    Dictionary  read_dictionary     (const BYTE* const __base) const;
+    
+protected:
+    explicit TEXT_DICTIONARY        () = delete;
+    explicit TEXT_DICTIONARY        (Offset offset, Size file_size, uint32_t version) noexcept;
+private:
+    #ifdef __EMSCRIPTEN__
+    const BYTE* check_and_fetch_remote (const BYTE* __base) const;
+    #endif
+};
+/// Reference only dictionaries (embed = false) shall have a non-zero identifier
+Size IFE_EXPORT SIZE_TEXT_DICTIONARY    (const TextDictionary&, bool embed = true);
+void IFE_EXPORT STORE_TEXT_DICTIONARY   (BYTE* const __base, Offset, const TextDictionary&, bool embed = true);
+
 // MARK: - ARRAY DATA TYPES
 // MARK: LAYER EXTENTS (Slide dimensions)
 struct IFE_EXPORT LAYER_EXTENT {
@@ -663,19 +1965,28 @@ struct IFE_EXPORT LAYER_EXTENT {
         X_TILES_S                   = TYPE_SIZE_UINT32,
         Y_TILES_S                   = TYPE_SIZE_UINT32,
         SCALE_S                     = TYPE_SIZE_FLOAT32,
+        TILE_WIDTH_S                = TYPE_SIZE_UINT16,
+        TILE_HEIGHT_S               = TYPE_SIZE_UINT16,
     };
     enum vtable_offsets {
         X_TILES                     = 0,
         Y_TILES                     = X_TILES + X_TILES_S,
         SCALE                       = Y_TILES + Y_TILES_S,
+        V1_0_SIZE                   = SCALE + SCALE_S,
         // Version 1.0 ends here.
         // -----------------------------------------------------------------------
+        TILE_WIDTH                  = V1_0_SIZE,
+        TILE_HEIGHT                 = TILE_WIDTH + TILE_WIDTH_S,
+        V2_0_SIZE                   = TILE_HEIGHT + TILE_HEIGHT_S,
+        // Version 2.0 ends here.
+        // -----------------------------------------------------------------------
         
-        SIZE                        = SCALE + SCALE_S
+        SIZE                        = V2_0_SIZE
     };
 };
 struct IFE_EXPORT LAYER_EXTENTS : DATA_BLOCK {
     friend TILE_TABLE;
+    friend IMAGE_ARRAY;
     static constexpr
     char type []                    = "LAYER_EXTENTS";
     static constexpr enum
@@ -701,16 +2012,18 @@ struct IFE_EXPORT LAYER_EXTENTS : DATA_BLOCK {
     Result      validate_offset     (const BYTE* const __base) const noexcept;
     Result      validate_full       (const BYTE* const __base) const noexcept;
     LayerExtents read_layer_extents (const BYTE* const __base) const;
+    TileExtents read_tile_extents   (const BYTE* const __base) const;
     
 protected:
     explicit LAYER_EXTENTS          (Offset offset, Size file_size, uint32_t version) noexcept;
 private:
     #ifdef __EMSCRIPTEN__
-    void check_and_fetch_remote     (const BYTE* const& __base);
+    const BYTE* check_and_fetch_remote (const BYTE* __base) const;
     #endif
 };
 Size IFE_EXPORT SIZE_EXTENTS        (const LayerExtents&);
-void IFE_EXPORT STORE_EXTENTS       (BYTE* const __base, Offset offset, const LayerExtents&);
+void IFE_EXPORT STORE_EXTENTS       (BYTE* const __base, Offset offset, const LayerExtents&,
+                                     const TileExtents& = TileExtents());
 
 // MARK: Tile Offsets (tile lookup table)
 struct IFE_EXPORT TILE_OFFSET {
@@ -728,8 +2041,36 @@ struct IFE_EXPORT TILE_OFFSET {
         SIZE                        = TILE_SIZE + TILE_SIZE_S,
     };
 };
+/*
+ *  Version 2 delta tile offsets entry: a tile offset entry followed by the
+ *  global index (layer-major) of the base table entry that it replaces.
+ */
+struct IFE_EXPORT TILE_OFFSET_DELTA {
+    friend TILE_OFFSETS;
+    enum vtable_sizes {
+        OFFSET_S                    = TYPE_SIZE_UINT40,
+        TILE_SIZE_S                 = TYPE_SIZE_UINT24,
+        TILE_INDEX_S                = TYPE_SIZE_UINT32,
+    };
+    enum vtable_offsets {
+        OFFSET                      = 0,
+        TILE_SIZE                   = OFFSET + OFFSET_S,
+        TILE_INDEX                  = TILE_SIZE + TILE_SIZE_S,
+        SIZE                        = TILE_INDEX + TILE_INDEX_S,
+    };
+};
+/*
+ *  BREAKDOWN:
+ *  | ---------------- HEADER -------------------| ----------- ENTRIES ----------|
+ *  | VALIDATION | RECOVERY | STEP | N | BASE PTR | TILE 0 | TILE 1 | ... | N-1 |
+ *  Version 2 tables with a BASE PTR are delta tables: each entry is a
+ *  TILE_OFFSET_DELTA overriding one entry of the complete base table,
+ *  which shall precede the delta table and shall not itself be a delta.
+ */
 struct IFE_EXPORT TILE_OFFSETS : DATA_BLOCK {
     friend TILE_TABLE;
+    friend TILE_PLANES;
+    friend IMAGE_ARRAY;
     static constexpr
     char type []                    = "TILE_OFFSETS";
     static constexpr
@@ -739,6 +2080,7 @@ struct IFE_EXPORT TILE_OFFSETS : DATA_BLOCK {
         RECOVERY_S                  = TYPE_SIZE_UINT16,
         ENTRY_SIZE_S                = TYPE_SIZE_INT16,
         ENTRY_NUMBER_S              = TYPE_SIZE_INT32,
+        BASE_OFFSETS_OFFSET_S       = TYPE_SIZE_UINT64,
     };
     enum vtable_offsets {
         VALIDATION                  = 0,
@@ -749,23 +2091,182 @@ struct IFE_EXPORT TILE_OFFSETS : DATA_BLOCK {
         // Version 1.0 ends here.
         // -----------------------------------------------------------------------
         
-        HEADER_SIZE                 = HEADER_V1_0_SIZE
+        BASE_OFFSETS_OFFSET         = HEADER_V1_0_SIZE,
+        HEADER_V2_0_SIZE            = BASE_OFFSETS_OFFSET + BASE_OFFSETS_OFFSET_S,
+        // Version 2.0 ends here.
+        // -----------------------------------------------------------------------
+        
+        HEADER_SIZE                 = HEADER_V2_0_SIZE
     };
     Size        size                (const BYTE* const __base) const;
     Result      validate_offset     (const BYTE* const __base) const noexcept;
     Result      validate_full       (const BYTE* const __base) const noexcept;
     void        read_tile_offsets   (const BYTE* const __base, TileTable&) const;
+    // Base table of a delta table; a NULL block if the table is complete.
+    TILE_OFFSETS get_base_offsets   (const BYTE* const __base) const;
     
 protected:
     explicit TILE_OFFSETS           () = delete;
     explicit TILE_OFFSETS           (Offset offset, Size file_size, uint32_t version) noexcept;
 private:
     #ifdef __EMSCRIPTEN__
-    void check_and_fetch_remote     (const BYTE* const& __base);
+    const BYTE* check_and_fetch_remote (const BYTE* __base) const;
     #endif
 };
 Size IFE_EXPORT SIZE_TILE_OFFSETS   (const TileTable::Layers&);
 void IFE_EXPORT STORE_TILE_OFFSETS  (BYTE* const, Offset, const TileTable::Layers&);
+/**
+ * @brief Replacement tile payloads amended onto an existing slide file.
+ *
+ * The amendment appends the replacement payloads and a new tile offsets
+ * table to the end of the file, leaving every existing byte in place.
+ * With delta encoding (version 2+ files), the new table only lists the
+ * replaced tiles and references the complete table as its base; amending
+ * a delta table merges the deltas so chains never exceed a single base.
+ * A complete table is written whenever it is no larger than the delta.
+ */
+struct IFE_EXPORT TileAmendmentCreateInfo {
+    struct Tile {
+        uint32_t    layer           = 0;
+        uint32_t    tile            = 0;
+        const BYTE* data            = nullptr;
+        Size        size            = 0;
+    };
+    std::vector<Tile> tiles;
+    uint32_t        plane           = 0;            // Amended plane of a multi-plane table
+    bool            deltaEncode     = true;
+    // Invoked after the appended blocks are written and before the tile
+    // table is repointed (ex: msync) so that the repoint commits the amendment.
+    std::function<void()> barrier   = nullptr;
+};
+/**
+ * @brief Bytes appended to a file of file_size by the amendment.
+ *
+ * The caller extends the file and its mapping by this amount prior to
+ * calling STORE_TILE_AMENDMENT.
+ */
+Size IFE_EXPORT SIZE_TILE_AMENDMENT (const BYTE* const __base, Size file_size, const TileAmendmentCreateInfo&);
+/**
+ * @brief Write the tile amendment into a file mapping extended per
+ * SIZE_TILE_AMENDMENT and return the amended file size.
+ *
+ * The stored file size is updated first, then the appended blocks are
+ * written; the tile table's TILE_OFFSETS_OFFSET is then repointed with a
+ * single 8-byte store, followed by the stored fingerprint (if any) and the
+ * incremented FILE_REVISION. An interruption before the repoint leaves the
+ * prior table in effect.
+ *
+ * Replacing a tile of a mip tail layer (primary plane) repacks the tail:
+ * all tail tiles are appended contiguously ahead of the other payloads,
+ * the tail is cleared before the repoint and restored after it.
+ */
+Size IFE_EXPORT STORE_TILE_AMENDMENT(BYTE* const __base, Size file_size, const TileAmendmentCreateInfo&);
+/**
+ * @brief Number of leading (coarsest) layers of at most max_layer_tiles
+ * tiles each; these layers form the mip tail of a slide.
+ *
+ * Writers shall store the tiles of these layers contiguously and record
+ * the range in TileTableCreateInfo::mipTailOffset / mipTailSize.
+ */
+uint32_t IFE_EXPORT MIP_TAIL_LAYERS (const LayerExtents&, uint32_t max_layer_tiles);
+/**
+ * @brief Repack the coarsest layers of an existing (v2) slide file into a
+ * contiguous mip tail.
+ *
+ * The tail tiles are copied to the end of the file as a tile amendment
+ * of the primary plane (see \ref STORE_TILE_AMENDMENT) and the range is
+ * recorded in the tile table.
+ */
+struct IFE_EXPORT MipTailCreateInfo {
+    uint32_t        maxLayerTiles   = 16;           // Layers of at most this many tiles
+    bool            deltaEncode     = true;
+    std::function<void()> barrier   = nullptr;
+};
+Size IFE_EXPORT SIZE_MIP_TAIL       (const BYTE* const __base, Size file_size, const MipTailCreateInfo&);
+Size IFE_EXPORT STORE_MIP_TAIL      (BYTE* const __base, Size file_size, const MipTailCreateInfo&);
+
+// MARK: Tile Planes (multi-plane tile lookup)
+struct IFE_EXPORT TILE_PLANE {
+    friend TILE_PLANES;
+    enum vtable_sizes {
+        TILE_OFFSETS_OFFSET_S       = TYPE_SIZE_UINT64,
+        VALUE_S                     = TYPE_SIZE_FLOAT32,
+    };
+    enum vtable_offsets {
+        TILE_OFFSETS_OFFSET         = 0,
+        VALUE                       = TILE_OFFSETS_OFFSET + TILE_OFFSETS_OFFSET_S,
+        // Version 2.0 ends here.
+        // -----------------------------------------------------------------------
+        
+        SIZE                        = VALUE + VALUE_S,
+    };
+};
+/*
+ *  BREAKDOWN:
+ *  | ------------------ HEADER ------------------| ---------------- ENTRIES ----------------|
+ *  | VALIDATION | RECOVERY | STEP | N | PLANE TYPE | PLANE 0 | PLANE 1 | ... | PLANE N-1 |
+ *  Each plane references the TILE_OFFSETS array of one focal plane or channel.
+ *  All planes share the tile table's LAYER_EXTENTS. Plane 0 is the tile table's
+ *  own TILE_OFFSETS and the plane 0 entry tile offsets offset shall be NULL_OFFSET.
+ */
+struct IFE_EXPORT TILE_PLANES : DATA_BLOCK {
+    friend TILE_TABLE;
+    static constexpr
+    char type []                    = "TILE_PLANES";
+    static constexpr enum
+    RECOVERY    recovery            = RECOVER_TILE_PLANES;
+    enum vtable_sizes {
+        VALIDATION_S                = TYPE_SIZE_UINT64,
+        RECOVERY_S                  = TYPE_SIZE_UINT16,
+        ENTRY_SIZE_S                = TYPE_SIZE_UINT16,
+        ENTRY_NUMBER_S              = TYPE_SIZE_UINT32,
+        PLANE_TYPE_S                = TYPE_SIZE_UINT8,
+    };
+    enum vtable_offsets {
+        VALIDATION                  = 0,
+        RECOVERY                    = VALIDATION + VALIDATION_S,
+        ENTRY_SIZE                  = RECOVERY + RECOVERY_S,
+        ENTRY_NUMBER                = ENTRY_SIZE + ENTRY_SIZE_S,
+        PLANE_TYPE                  = ENTRY_NUMBER + ENTRY_NUMBER_S,
+        HEADER_V2_0_SIZE            = PLANE_TYPE + PLANE_TYPE_S,
+        // Version 2.0 ends here.
+        // -----------------------------------------------------------------------
+        
+        HEADER_SIZE                 = HEADER_V2_0_SIZE,
+    };
+    Size        size                (const BYTE* const __base) const;
+    Result      validate_offset     (const BYTE* const __base) const noexcept;
+    Result      validate_full       (const BYTE* const __base) const noexcept;
+    void        read_planes         (const BYTE* const __base, TileTable&) const;
+    TILE_OFFSETS get_plane_offsets  (const BYTE* const __base, uint32_t plane) const;
+    
+protected:
+    explicit TILE_PLANES            () = delete;
+    explicit TILE_PLANES            (Offset offset, Size file_size, uint32_t version) noexcept;
+private:
+    #ifdef __EMSCRIPTEN__
+    const BYTE* check_and_fetch_remote (const BYTE* __base) const;
+    #endif
+};
+/**
+ * @brief Planes of a multi-plane tile table.
+ *
+ * Plane 0 is described by the tile table's tilesOffset and its
+ * tileOffsets value is not stored. Each plane's TILE_OFFSETS shall
+ * follow the tile table's LAYER_EXTENTS; writers should store the tile
+ * data of each plane contiguously so that a single plane reads as one span.
+ */
+struct IFE_EXPORT TilePlanesCreateInfo {
+    struct Plane {
+        Offset      tileOffsets     = NULL_OFFSET;
+        float       value           = 0.f;
+    };
+    Offset          planesOffset    = NULL_OFFSET;
+    PlaneType       type            = PLANE_UNDEFINED;
+    std::vector<Plane> planes;
+};
+Size IFE_EXPORT SIZE_TILE_PLANES    (const TilePlanesCreateInfo&);
+void IFE_EXPORT STORE_TILE_PLANES   (BYTE* const __base, const TilePlanesCreateInfo&);
 
 // MARK: ATTRIBUTES SIZES
 struct IFE_EXPORT ATTRIBUTE_SIZE {
@@ -816,7 +2317,7 @@ protected:
     explicit ATTRIBUTES_SIZES       (Offset offset, Size file_size, uint32_t version) noexcept;
 private:
     #ifdef __EMSCRIPTEN__
-    void check_and_fetch_remote     (const BYTE* const& __base);
+    const BYTE* check_and_fetch_remote (const BYTE* __base) const;
     #endif
 };
 Size IFE_EXPORT SIZE_ATTRIBUTES_SIZES   (const Attributes&);
@@ -847,19 +2348,95 @@ struct IFE_EXPORT ATTRIBUTES_BYTES : DATA_BLOCK {
     };
     Size        size                (const BYTE* const __base) const;
     Result      validate_offset     (const BYTE* const __base) const noexcept;
-    Result      validate_full       (const BYTE* const __base, Size expected_bytes) const noexcept;
-    void        read_bytes          (const BYTE* const __base, const SizeArray&, Attributes&) const;
+    Result      validate_full       (const BYTE* const __base, Size expected_bytes,
+                                     TextCompression = TEXT_UNCOMPRESSED) const noexcept;
+    void        read_bytes          (const BYTE* const __base, const SizeArray&, Attributes&,
+                                     TextCompression = TEXT_UNCOMPRESSED,
+                                     const TextDictionary* = nullptr) const;
     
 protected:
     explicit ATTRIBUTES_BYTES       () = delete;
     explicit ATTRIBUTES_BYTES       (Offset offset, Size file_size, uint32_t version) noexcept;
 private:
     #ifdef __EMSCRIPTEN__
-    void check_and_fetch_remote     (const BYTE* const& __base);
+    const BYTE* check_and_fetch_remote (const BYTE* __base) const;
+    #endif
+};
+Size IFE_EXPORT SIZE_ATTRIBUTES_BYTES   (const Attributes&, TextCompression = TEXT_UNCOMPRESSED,
+                                         const TextDictionary* = nullptr);
+void IFE_EXPORT STORE_ATTRIBUTES_BYTES  (BYTE* const __base, Offset, const Attributes&,
+                                         TextCompression = TEXT_UNCOMPRESSED,
+                                         const TextDictionary* = nullptr);
+
+// MARK: ATTRIBUTES DIRECTORY
+/*
+ *  BREAKDOWN:
+ *  | VALIDATION | RECOVERY | ENTRY SIZE | N | ENTRY 0 | ... | ENTRY N-1 |
+ *  ENTRY: | KEY HASH | KEY OFFSET | KEY SIZE | VALUE OFFSET | VALUE SIZE |
+ *  Entries are sorted by key hash. Offsets are relative to the first byte
+ *  of the (uncompressed) attributes byte array following its header. The
+ *  attribute sizes and bytes arrays are written in key order.
+ */
+struct IFE_EXPORT ATTRIBUTE_DIRECTORY_ENTRY {
+    enum vtable_sizes {
+        KEY_HASH_S                  = TYPE_SIZE_UINT64,
+        KEY_OFFSET_S                = TYPE_SIZE_UINT32,
+        KEY_SIZE_S                  = TYPE_SIZE_UINT16,
+        VALUE_OFFSET_S              = TYPE_SIZE_UINT32,
+        VALUE_SIZE_S                = TYPE_SIZE_UINT32,
+    };
+    enum vtable_offsets {
+        KEY_HASH                    = 0,
+        KEY_OFFSET                  = KEY_HASH + KEY_HASH_S,
+        KEY_SIZE                    = KEY_OFFSET + KEY_OFFSET_S,
+        VALUE_OFFSET                = KEY_SIZE + KEY_SIZE_S,
+        VALUE_SIZE                  = VALUE_OFFSET + VALUE_OFFSET_S,
+        // Version 2.0 ends here.
+        // -----------------------------------------------------------------------
+        
+        SIZE                        = VALUE_SIZE + VALUE_SIZE_S,
+    };
+};
+struct IFE_EXPORT ATTRIBUTES_DIRECTORY : DATA_BLOCK {
+    friend ATTRIBUTES;
+    static constexpr
+    char type []                    = "ATTRIBUTES_DIRECTORY";
+    static constexpr enum
+    RECOVERY    recovery            = RECOVER_ATTRIBUTES_DIRECTORY;
+    enum vtable_sizes {
+        VALIDATION_S                = TYPE_SIZE_UINT64,
+        RECOVERY_S                  = TYPE_SIZE_UINT16,
+        ENTRY_SIZE_S                = TYPE_SIZE_UINT16,
+        ENTRY_NUMBER_S              = TYPE_SIZE_UINT32,
+    };
+    enum vtable_offsets {
+        VALIDATION                  = 0,
+        RECOVERY                    = VALIDATION + VALIDATION_S,
+        ENTRY_SIZE                  = RECOVERY + RECOVERY_S,
+        ENTRY_NUMBER                = ENTRY_SIZE + ENTRY_SIZE_S,
+        HEADER_V2_0_SIZE            = ENTRY_NUMBER + ENTRY_NUMBER_S,
+        // Version 2.0 ends here.
+        // -----------------------------------------------------------------------
+        
+        HEADER_SIZE                 = HEADER_V2_0_SIZE
+    };
+    using SizeArray                 = ATTRIBUTES_SIZES::SizeArray;
+    Size        size                (const BYTE* const __base) const;
+    Result      validate_offset     (const BYTE* const __base) const noexcept;
+    /// Validates the directory against the (uncompressed) attributes byte array at the bytes offset
+    Result      validate_full       (const BYTE* const __base, const SizeArray&, Offset bytes) const noexcept;
+    AttributeDirectory read_directory (const BYTE* const __base, Offset bytes) const;
+    
+protected:
+    explicit ATTRIBUTES_DIRECTORY   () = delete;
+    explicit ATTRIBUTES_DIRECTORY   (Offset offset, Size file_size, uint32_t version) noexcept;
+private:
+    #ifdef __EMSCRIPTEN__
+    const BYTE* check_and_fetch_remote (const BYTE* __base) const;
     #endif
 };
-Size IFE_EXPORT SIZE_ATTRIBUTES_BYTES   (const Attributes&);
-void IFE_EXPORT STORE_ATTRIBUTES_BYTES  (BYTE* const __base, Offset, const Attributes&);
+Size IFE_EXPORT SIZE_ATTRIBUTES_DIRECTORY   (const Attributes&);
+void IFE_EXPORT STORE_ATTRIBUTES_DIRECTORY  (BYTE* const __base, Offset, const Attributes&);
 
 // MARK: - ASSOCIATED IMAGES
 // MARK: IMAGES ARRAY
@@ -871,6 +2448,8 @@ struct IFE_EXPORT IMAGE_ENTRY {
         ENCODING_S                  = TYPE_SIZE_UINT8,
         FORMAT_S                    = TYPE_SIZE_UINT8,
         ORIENTATION_S               = TYPE_SIZE_UINT16,
+        LAYER_EXTENTS_OFFSET_S      = TYPE_SIZE_UINT64,
+        TILE_OFFSETS_OFFSET_S       = TYPE_SIZE_UINT64,
     };
     enum vtable_offsets {
         BYTES_OFFSET                = 0,
@@ -879,12 +2458,24 @@ struct IFE_EXPORT IMAGE_ENTRY {
         ENCODING                    = HEIGHT + HEIGHT_S,
         FORMAT                      = ENCODING + ENCODING_S,
         ORIENTATION                 = FORMAT + FORMAT_S,
+        V1_0_SIZE                   = ORIENTATION + ORIENTATION_S,
         // Version 1.0 ends here.
         // -----------------------------------------------------------------------
+        LAYER_EXTENTS_OFFSET        = V1_0_SIZE,
+        TILE_OFFSETS_OFFSET         = LAYER_EXTENTS_OFFSET + LAYER_EXTENTS_OFFSET_S,
+        V2_0_SIZE                   = TILE_OFFSETS_OFFSET + TILE_OFFSETS_OFFSET_S,
+        // Version 2.0 ends here.
+        // -----------------------------------------------------------------------
         
-        SIZE                        = ORIENTATION + ORIENTATION_S,
+        SIZE                        = V2_0_SIZE,
     };
 };
+/*
+ *  Version 2 image entries may reference a tiled pyramid: a LAYER_EXTENTS
+ *  array (coarsest layer first) and a complete or delta TILE_OFFSETS array
+ *  locating the separately encoded tiles. The IMAGE_BYTES block of a tiled
+ *  image holds the title only (image size 0).
+ */
 struct IFE_EXPORT IMAGE_ARRAY : DATA_BLOCK {
     friend METADATA;
     using Images                    = Abstraction::AssociatedImages;
@@ -915,19 +2506,25 @@ struct IFE_EXPORT IMAGE_ARRAY : DATA_BLOCK {
     Result      validate_offset     (const BYTE* const __base) const noexcept;
     Result      validate_full       (const BYTE* const __base) const noexcept;
     Images      read_assoc_images   (const BYTE* const __base, BYTES_ARRAY* = nullptr) const;
+    // Tiled (v2) pyramid of the image entry at the given index
+    bool        image_pyramid       (const BYTE* const __base, uint32_t entry) const;
+    LAYER_EXTENTS get_image_extents (const BYTE* const __base, uint32_t entry) const;
+    TILE_OFFSETS  get_image_offsets (const BYTE* const __base, uint32_t entry) const;
     
 protected:
     explicit    IMAGE_ARRAY         () = delete;
     explicit    IMAGE_ARRAY         (Offset offset, Size file_size, uint32_t version) noexcept;
 private:
     #ifdef __EMSCRIPTEN__
-    void check_and_fetch_remote     (const BYTE* const& __base);
+    const BYTE* check_and_fetch_remote (const BYTE* __base) const;
     #endif
 };
 struct IFE_EXPORT AssociatedImageCreateInfo {
     struct IFE_EXPORT Entry {
         Offset              offset  = NULL_OFFSET;
         AssociatedImageInfo info;
+        Offset      layerExtentsOffset  = NULL_OFFSET; // Optional (v2) tiled pyramid LAYER_EXTENTS
+        Offset      tileOffsetsOffset   = NULL_OFFSET; // Optional (v2) tiled pyramid TILE_OFFSETS
     }; using Entries                = std::vector<Entry>;
     
     Offset      offset              = NULL_OFFSET;
@@ -970,7 +2567,7 @@ protected:
     explicit    IMAGE_BYTES         (Offset offset, Size file_size, uint32_t version) noexcept;
 private:
     #ifdef __EMSCRIPTEN__
-    void check_and_fetch_remote     (const BYTE* const& __base);
+    const BYTE* check_and_fetch_remote (const BYTE* __base) const;
     #endif
 };
 struct IFE_EXPORT ImageBytesCreateInfo {
@@ -978,9 +2575,23 @@ struct IFE_EXPORT ImageBytesCreateInfo {
     std::string title;
     BYTE* const data                = nullptr;
     size_t      dataBytes           = 0;
+    bool        tiled               = false;        // Title only (v2); the image is a tiled pyramid
 };
 Size IFE_EXPORT SIZE_IMAGES_BYTES   (const ImageBytesCreateInfo&);
 void IFE_EXPORT STORE_IMAGES_BYTES  (BYTE* const __base, const ImageBytesCreateInfo&);
+/**
+ * @brief Layer extents of a tiled (v2) associated image pyramid.
+ *
+ * Each layer halves the resolution of the next; layer 0 (the lowest
+ * resolution) is the first layer that fits within a single tile. To
+ * store a tiled image, encode the tiles of each layer (row-major,
+ * clipped to the layer pixel extent; see AssociatedImage::layer_width),
+ * store them, then store the extents (STORE_EXTENTS), the tile offsets
+ * (STORE_TILE_OFFSETS), a title only image bytes block (tiled = true)
+ * and reference the arrays from the image entry.
+ */
+LayerExtents IFE_EXPORT ASSOCIATED_IMAGE_EXTENTS (uint32_t width, uint32_t height,
+                                                  const TileExtent& = TileExtent());
 
 // MARK: - ICC Color Profile
 
@@ -1014,7 +2625,7 @@ protected:
     explicit ICC_PROFILE      (Offset offset, Size file_size, uint32_t version) noexcept;
 private:
     #ifdef __EMSCRIPTEN__
-    void check_and_fetch_remote     (const BYTE* const& __base);
+    const BYTE* check_and_fetch_remote (const BYTE* __base) const;
     #endif
 };
 Size SIZE_ICC_COLOR_PROFILE         (const std::string& color_profile);
@@ -1069,6 +2680,9 @@ struct IFE_EXPORT ANNOTATIONS : DATA_BLOCK {
         ENTRY_NUMBER_S              = TYPE_SIZE_UINT32,
         GROUP_SIZES_OFFSET_S        = TYPE_SIZE_UINT64,
         GROUP_BYTES_OFFSET_S        = TYPE_SIZE_UINT64,
+        SPATIAL_INDEX_OFFSET_S      = TYPE_SIZE_UINT64,
+        COMPRESSION_S               = TYPE_SIZE_UINT8,
+        DICTIONARY_OFFSET_S         = TYPE_SIZE_UINT64,
     };
     enum vtable_offsets {
         VALIDATION                  = 0,
@@ -1080,26 +2694,49 @@ struct IFE_EXPORT ANNOTATIONS : DATA_BLOCK {
         HEADER_V1_0_SIZE            = GROUP_BYTES_OFFSET + GROUP_BYTES_OFFSET_S,
         // Version 1.0 ends here.
         // -----------------------------------------------------------------------
+        SPATIAL_INDEX_OFFSET        = HEADER_V1_0_SIZE,
+        COMPRESSION                 = SPATIAL_INDEX_OFFSET + SPATIAL_INDEX_OFFSET_S,
+        DICTIONARY_OFFSET           = COMPRESSION + COMPRESSION_S,
+        HEADER_V2_0_SIZE            = DICTIONARY_OFFSET + DICTIONARY_OFFSET_S,
+        // Version 2.0 ends here.
+        // -----------------------------------------------------------------------
         
-        HEADER_SIZE                 = HEADER_V1_0_SIZE,
+        HEADER_SIZE                 = HEADER_V2_0_SIZE,
     };
+    using SPATIAL_INDEX             = ANNOTATION_INDEX;
+    using EntryRanges               = Abstraction::AnnotationIndex::EntryRanges;
     Size        size                (const BYTE* const __base) const;
     Result      validate_offset     (const BYTE* const __base) const noexcept;
     Result      validate_full       (const BYTE* const __base) const noexcept;
     Annotations read_annotations    (const BYTE* const __base, BYTES_ARRAY* = nullptr) const;
+    /// Read only the annotation entries within the given ranges (see AnnotationIndex::query)
+    Annotations read_annotations    (const BYTE* const __base, const EntryRanges&,
+                                     BYTES_ARRAY* = nullptr) const;
     
     
     bool        groups              (const BYTE* const __base) const;
     GROUP_SIZES get_group_sizes     (const BYTE* const __base) const;
     GROUP_BYTES get_group_bytes     (const BYTE* const __base) const;
+    
+    bool        spatial_index       (const BYTE* const __base) const;
+    SPATIAL_INDEX get_spatial_index (const BYTE* const __base) const;
+    AnnotationIndex read_spatial_index (const BYTE* const __base) const;
+    
+    TextCompression compression     (const BYTE* const __base) const;
+    bool        dictionary          (const BYTE* const __base) const;
+    TEXT_DICTIONARY get_dictionary  (const BYTE* const __base) const;
 
     
 protected:
     explicit ANNOTATIONS            () = delete;
     explicit ANNOTATIONS            (Offset offset, Size file_size, uint32_t version) noexcept;
 private:
+    Offset      entries_offset      () const;
+    void        read_entry          (const BYTE* const __base, const BYTE* const __entry,
+                                     Annotations&, BYTES_ARRAY*) const;
     #ifdef __EMSCRIPTEN__
-    void check_and_fetch_remote     (const BYTE* const& __base);
+    const BYTE* check_and_fetch_remote (const BYTE* __base) const;
+    const BYTE* fetch_remote_entries (const BYTE* __base) const;
     #endif
 };
 struct IFE_EXPORT AnnotationArrayCreateInfo {
@@ -1116,14 +2753,28 @@ struct IFE_EXPORT AnnotationArrayCreateInfo {
         uint32_t    width           = 0;
         uint32_t    height          = 0;
         uint32_t    parent          = Annotation::NULL_ID;
+        bool operator < (const AnnotationInfo& other) const
+        {return identifier < other.identifier;}
     }; using AnnotationInfos        = std::set<AnnotationInfo>;
     
     Offset          offset          = NULL_OFFSET;
     AnnotationInfos annotations;
+    /// Optional (v2) ANNOTATION_INDEX offset. If provided, entries are stored in spatial
+    /// order and the index must be stored with STORE_ANNOTATION_INDEX using this create info.
+    Offset          spatialIndex    = NULL_OFFSET;
+    /// Spatial index cell edge length in annotation location units (0 selects automatically)
+    float           spatialCellSize = 0.f;
+    /// (v2) Compression of the text and SVG annotation bytes. The bytes shall be stored
+    /// with STORE_ANNOTATION_BYTES using the same compression and dictionary.
+    TextCompression compression     = TEXT_UNCOMPRESSED;
+    /// (v2) Optional TEXT_DICTIONARY offset
+    Offset          dictionary      = NULL_OFFSET;
 };
 Size IFE_EXPORT SIZE_ANNOTATION_ARRAY   (const AnnotationArrayCreateInfo&);
+Size IFE_EXPORT SIZE_ANNOTATION_INDEX   (const AnnotationArrayCreateInfo&);
 #ifndef __EMSCRIPTEN__
 void IFE_EXPORT STORE_ANNOTATION_ARRAY  (BYTE* const __base, const AnnotationArrayCreateInfo&);
+void IFE_EXPORT STORE_ANNOTATION_INDEX  (BYTE* const __base, const AnnotationArrayCreateInfo&);
 #endif
 
 // MARK: ANNOTATION BYTES
@@ -1158,12 +2809,17 @@ protected:
     explicit ANNOTATION_BYTES       (Offset offset, Size file_size, uint32_t version) noexcept;
 private:
     #ifdef __EMSCRIPTEN__
-    void check_and_fetch_remote     (const BYTE* const& __base);
+    const BYTE* check_and_fetch_remote (const BYTE* __base) const;
     #endif
 };
-Size IFE_EXPORT SIZE_ANNOTATION_BYTES   (const IrisCodec::Annotation&);
+/// Text and SVG annotations are compressed if requested; image annotations are stored as is.
+Size IFE_EXPORT SIZE_ANNOTATION_BYTES   (const IrisCodec::Annotation&,
+                                         TextCompression = TEXT_UNCOMPRESSED,
+                                         const TextDictionary* = nullptr);
 #ifndef __EMSCRIPTEN__
-void IFE_EXPORT STORE_ANNOTATION_BYTES  (BYTE* const __base, Offset, const IrisCodec::Annotation&);
+void IFE_EXPORT STORE_ANNOTATION_BYTES  (BYTE* const __base, Offset, const IrisCodec::Annotation&,
+                                         TextCompression = TEXT_UNCOMPRESSED,
+                                         const TextDictionary* = nullptr);
 #endif
 
 // MARK: ANNOTATION GROUPS
@@ -1217,7 +2873,7 @@ protected:
     explicit ANNOTATION_GROUP_SIZES (Offset offset, Size file_size, uint32_t version) noexcept;
 private:
     #ifdef __EMSCRIPTEN__
-    void check_and_fetch_remote     (const BYTE* const& __base);
+    const BYTE* check_and_fetch_remote (const BYTE* __base) const;
     #endif
 };
 struct IFE_EXPORT ANNOTATION_GROUP_BYTES : DATA_BLOCK {
@@ -1253,7 +2909,74 @@ protected:
     explicit ANNOTATION_GROUP_BYTES (Offset offset, Size file_size, uint32_t version) noexcept;
 private:
     #ifdef __EMSCRIPTEN__
-    void check_and_fetch_remote     (const BYTE* const& __base);
+    const BYTE* check_and_fetch_remote (const BYTE* __base) const;
+    #endif
+};
+
+// MARK: ANNOTATION SPATIAL INDEX
+struct IFE_EXPORT ANNOTATION_BUCKET {
+    enum vtable_sizes {
+        CELL_S                      = TYPE_SIZE_UINT32,
+        FIRST_ENTRY_S               = TYPE_SIZE_UINT32,
+        ENTRY_NUMBER_S              = TYPE_SIZE_UINT32,
+    };
+    enum vtable_offsets {
+        CELL                        = 0,
+        FIRST_ENTRY                 = CELL + CELL_S,
+        ENTRY_NUMBER                = FIRST_ENTRY + FIRST_ENTRY_S,
+        // Version 2.0 ends here.
+        // -----------------------------------------------------------------------
+        
+        SIZE                        = ENTRY_NUMBER + ENTRY_NUMBER_S,
+    };
+};
+struct IFE_EXPORT ANNOTATION_INDEX : DATA_BLOCK {
+    friend ANNOTATIONS;
+    using AnnotationIndex           = Abstraction::AnnotationIndex;
+    static constexpr
+    char type []                    = "ANNOTATION_INDEX";
+    static constexpr enum
+    RECOVERY    recovery            = RECOVER_ANNOTATION_INDEX;
+    enum vtable_sizes {
+        VALIDATION_S                = TYPE_SIZE_UINT64,
+        RECOVERY_S                  = TYPE_SIZE_UINT16,
+        ENTRY_SIZE_S                = TYPE_SIZE_UINT16,
+        ENTRY_NUMBER_S              = TYPE_SIZE_UINT32,
+        CELL_WIDTH_S                = TYPE_SIZE_FLOAT32,
+        CELL_HEIGHT_S               = TYPE_SIZE_FLOAT32,
+        X_CELLS_S                   = TYPE_SIZE_UINT16,
+        Y_CELLS_S                   = TYPE_SIZE_UINT16,
+        MAX_X_SIZE_S                = TYPE_SIZE_FLOAT32,
+        MAX_Y_SIZE_S                = TYPE_SIZE_FLOAT32,
+    };
+    enum vtable_offsets {
+        VALIDATION                  = 0,
+        RECOVERY                    = VALIDATION + VALIDATION_S,
+        ENTRY_SIZE                  = RECOVERY + RECOVERY_S,
+        ENTRY_NUMBER                = ENTRY_SIZE + ENTRY_SIZE_S,
+        CELL_WIDTH                  = ENTRY_NUMBER + ENTRY_NUMBER_S,
+        CELL_HEIGHT                 = CELL_WIDTH + CELL_WIDTH_S,
+        X_CELLS                     = CELL_HEIGHT + CELL_HEIGHT_S,
+        Y_CELLS                     = X_CELLS + X_CELLS_S,
+        MAX_X_SIZE                  = Y_CELLS + Y_CELLS_S,
+        MAX_Y_SIZE                  = MAX_X_SIZE + MAX_X_SIZE_S,
+        HEADER_V2_0_SIZE            = MAX_Y_SIZE + MAX_Y_SIZE_S,
+        // Version 2.0 ends here.
+        // -----------------------------------------------------------------------
+        
+        HEADER_SIZE                 = HEADER_V2_0_SIZE,
+    };
+    Size        size                (const BYTE* const __base) const;
+    Result      validate_offset     (const BYTE* const __base) const noexcept;
+    Result      validate_full       (const BYTE* const __base, uint32_t annotations) const noexcept;
+    AnnotationIndex read_index      (const BYTE* const __base) const;
+    
+protected:
+    explicit ANNOTATION_INDEX       () = delete;
+    explicit ANNOTATION_INDEX       (Offset offset, Size file_size, uint32_t version) noexcept;
+private:
+    #ifdef __EMSCRIPTEN__
+    const BYTE* check_and_fetch_remote (const BYTE* __base) const;
     #endif
 };
 } // END FILE STRUCTURE
@@ -1279,6 +3002,11 @@ enum IFE_EXPORT MapEntryType {
     MAP_ENTRY_ANNOTATION_BYTES,
     MAP_ENTRY_ANNOTATION_GROUP_SIZES,
     MAP_ENTRY_ANNOTATION_GROUP_BYTES,
+    MAP_ENTRY_ANNOTATION_INDEX,
+    MAP_ENTRY_TILE_PLANES,
+    MAP_ENTRY_TEXT_DICTIONARY,
+    MAP_ENTRY_ATTRIBUTES_DIRECTORY,
+    MAP_ENTRY_ASSOCIATED_IMAGE_TILE,
 };
 /**
  * @brief FileMap entry representing a datablock within the IFE file structure system.
@@ -1289,6 +3017,188 @@ struct IFE_EXPORT FileMapEntry {
     Datablock           datablock;
     Size                size        = 0;
 };
+/**
+ * @brief Per-block content manifest of an Iris file.
+ *
+ * Lists every mapped datablock (including each tile payload) with its
+ * size and XXH64 content hash. A manifest is the compact description of
+ * a replica exchanged between sites to compute a block-level Patch.
+ */
+struct IFE_EXPORT BlockManifest {
+    struct Entry {
+        Offset          offset      = NULL_OFFSET;
+        Size            size        = 0;
+        uint64_t        hash        = 0;
+        MapEntryType    type        = MAP_ENTRY_UNDEFINED;
+    };
+    using Entries                   = std::vector<Entry>;
+    Size                fileSize    = 0;
+    uint32_t            revision    = 0;
+    Entries             entries;    // Sorted by offset
+    /// XXH64 of the file size, revision and every entry; identifies the file content
+    uint64_t            fingerprint () const;
+};
+/**
+ * @brief Block-level patch reconstructing a target file revision from
+ * a source revision.
+ *
+ * Operations are contiguous and in target order, covering the target file
+ * from byte 0 to Patch::fileSize. PATCH_KEEP copies a byte range present in
+ * the source file (usually in place, costing nothing); PATCH_LITERAL carries
+ * the bytes of changed or new blocks.
+ */
+struct IFE_EXPORT Patch {
+    enum Operation : uint8_t {
+        PATCH_UNDEFINED             = 0,
+        PATCH_KEEP                  = 1,
+        PATCH_LITERAL               = 2,
+    };
+    struct Op {
+        Operation       operation   = PATCH_UNDEFINED;
+        Offset          source      = NULL_OFFSET;  // PATCH_KEEP source offset
+        Size            size        = 0;
+        std::vector<BYTE> bytes;                    // PATCH_LITERAL bytes
+    };
+    using Operations                = std::vector<Op>;
+    Size                fileSize    = 0;            // Target file size
+    uint32_t            revision    = 0;            // Target file revision
+    Size                sourceSize  = 0;            // Source the patch applies to
+    uint32_t            sourceRevision = 0;
+    uint64_t            sourceFingerprint = 0;      // BlockManifest::fingerprint of the source
+    uint64_t            fingerprint = 0;            // BlockManifest::fingerprint of the target
+    Operations          operations;
+    /// Number of bytes carried by the patch (literal bytes)
+    Size                literal_bytes () const;
+};
 }
+#ifndef __EMSCRIPTEN__
+// MARK: - BLOCK REPLICATION
+/**
+ * @brief Hash every mapped datablock of the file into a block manifest. This reads the entire file.
+ */
+Abstraction::BlockManifest IFE_EXPORT generate_block_manifest (BYTE* const __mapped_file_ptr,
+                                                               size_t file_size);
+/**
+ * @brief Compute the block-level patch that reconstructs the target file from a source file
+ * described by its (possibly remote) block manifest.
+ *
+ * Target blocks whose size and hash match a source block are kept; all other blocks and
+ * the bytes between blocks are carried as literals. Contiguous kept and literal ranges are
+ * coalesced, so unchanged tile data costs one operation per run.
+ */
+Abstraction::Patch IFE_EXPORT generate_patch (const Abstraction::BlockManifest& source,
+                                              BYTE* const __target_file_ptr,
+                                              size_t target_file_size);
+/**
+ * @brief Apply a patch in place to the mapped source file, reconstructing the target revision.
+ *
+ * The mapping must be at least max(Patch::sourceSize, Patch::fileSize) bytes; truncate the
+ * file to Patch::fileSize afterwards. The source file size, revision and block manifest
+ * fingerprint are checked against the patch before any byte is written, and the reconstructed
+ * file is checked against the target fingerprint afterwards; both checks read the entire file.
+ * A failed target check leaves the file corrupt; restore it from a replica. Kept blocks that
+ * move are staged in memory, so patches of metadata-only revisions (where tiles stay in place)
+ * apply with negligible memory.
+ */
+void IFE_EXPORT apply_patch (BYTE* const __mapped_file_ptr, size_t mapped_size,
+                             const Abstraction::Patch&);
+/// Serialize a block manifest for exchange between sites ("IFEM" stream).
+std::vector<BYTE> IFE_EXPORT serialize_block_manifest (const Abstraction::BlockManifest&);
+Abstraction::BlockManifest IFE_EXPORT deserialize_block_manifest (const BYTE* const, size_t);
+/// Serialize a patch into a compact stream ("IFEP" stream).
+std::vector<BYTE> IFE_EXPORT serialize_patch (const Abstraction::Patch&);
+Abstraction::Patch IFE_EXPORT deserialize_patch (const BYTE* const, size_t);
+#endif
+// MARK: - STREAMING VALIDATION
+/**
+ * @brief Forward-only structural validator for Iris files received as a byte
+ * stream (such as an upload in flight), without spooling the file.
+ *
+ * Bytes are consumed in file order. Each data block is identified as its bytes
+ * arrive by its VALIDATION self-offset and RECOVERY tag (the same signature used
+ * for file recovery). Block references are recorded as blocks are parsed and are
+ * resolved against blocks that have already arrived (backward references) or
+ * that arrive later (forward references). A reference whose target bytes pass
+ * without a matching block, a mismatched recovery tag, or a block or tile
+ * extending beyond the encoded file size fails the stream immediately.
+ *
+ * The verdict is reached as soon as the last referenced block arrives: state()
+ * becomes STREAM_VALID, typically well before the trailing bytes of the stream,
+ * and the remaining bytes are only counted. finish() confirms the stream length
+ * equals the encoded file size. Only the metadata blocks are retained, and only
+ * until they are resolved. Their bytes, along with the bookkeeping of every
+ * detected block and recorded reference, are charged against the provided
+ * limit; retention beyond the limit fails the stream, such that a stream of
+ * many small blocks is bounded as well as one of few large blocks.
+ *
+ * Block rules that depend only on retained metadata are shared with
+ * validate_file_structure: tile table encodings, layer extents, the tile entry
+ * count of each tile offsets array against the layer extents it locates (the
+ * tile table, its planes and tiled associated images), and the annotation
+ * index buckets against the annotations array. Rules over payload bytes that
+ * are not retained (compressed attribute and text streams, cipher parameters,
+ * mip tail placement, associated image dimensions) are not applied; a valid
+ * stream is structurally sound, and the received file is still validated with
+ * validate_file_structure when it is opened.
+ */
+class IFE_EXPORT StreamValidator {
+public:
+    enum State : uint8_t {
+        STREAM_PENDING              = 0,
+        STREAM_VALID                = 1,
+        STREAM_INVALID              = 2,
+    };
+    static constexpr
+    Size        DEFAULT_RETENTION   = 256ULL << 20;
+    explicit    StreamValidator     (Size retention_limit = DEFAULT_RETENTION);
+    /// Consume the next bytes of the stream. Returns the failure once the stream is invalid.
+    Result      push                (const BYTE* const data, size_t bytes);
+    /// Signal the end of the stream and return the final verdict.
+    Result      finish              ();
+    State       state               () const noexcept {return __state;}
+    const Result& result            () const noexcept {return __result;}
+    Size        received            () const noexcept {return __position;}
+    Size        retained            () const noexcept {return __retained;}
+    
+private:
+    struct Block {
+        uint16_t                recovery    = 0;
+        Size                    prefix      = 0;    // Bytes required to size the block
+        Size                    length      = 0;    // Full block length (once sized)
+        Size                    capture     = 0;    // Bytes retained to resolve references
+        std::vector<BYTE>       bytes;
+        std::string             invalid;            // Reason a sized block is invalid
+        bool        complete    () const noexcept {return capture && bytes.size() == capture;}
+    };
+    const Size                  __limit;
+    Size                        __position  = 0;
+    Size                        __size      = 0;    // Encoded file size (once header arrives)
+    uint32_t                    __version   = 0;
+    Size                        __retained  = 0;
+    State                       __state     = STREAM_PENDING;
+    Result                      __result;
+    std::vector<BYTE>           __header;
+    BYTE                        __tail [9]  = {};
+    std::map<Offset, Block>     __blocks;           // Detected blocks, not yet resolved
+    std::vector<Offset>         __capturing;        // Detected blocks still receiving bytes
+    std::map<Offset, uint16_t>  __pending;          // Unresolved references (expected tag)
+    std::unordered_map<Offset, uint16_t> __resolved;
+    std::unordered_map<Offset, Size> __counts;      // Tiles of LAYER_EXTENTS / entries of TILE_OFFSETS
+    std::vector<std::pair<Offset, Offset>> __tilings; // LAYER_EXTENTS and the TILE_OFFSETS locating them
+    std::unordered_map<Offset, uint32_t> __annotations; // Entries covered by each ANNOTATION_INDEX
+    Offset                      __extents   = NULL_OFFSET;  // Tile table LAYER_EXTENTS
+    
+    void        fail                (const std::string&);
+    bool        retain              (Size bytes);
+    void        read_header         ();
+    void        detect_blocks       (const BYTE* const data, size_t bytes);
+    void        capture_blocks      (const BYTE* const data, size_t bytes);
+    bool        size_block          (Offset, Block&);
+    void        reference           (Offset, uint16_t recovery, bool optional = false);
+    void        resolve             (Offset);
+    void        count               (Offset, Size entries);
+    void        tiling              (Offset extents, Offset offsets);
+    void        match               (Offset extents, Offset offsets);
+};
 } // END IRIS CODEC
 #endif /* IrisCodecExtension_hpp */
@@ -0,0 +1,230 @@
+/**
+ * @file IrisFileExtension.h
+ * @brief Stable C interface to the Iris File Extension for foreign function
+ *        (FFI) consumers such as Python (ctypes / cffi) and Go (cgo).
+ *
+ * Design:
+ *   - `IFE_File` is an opaque handle over a caller mapped slide file. The
+ *     file structure is abstracted once on open and flattened into plain C
+ *     arrays owned by the handle: the tile index (all layers, layer-major),
+ *     the layer extents, the attributes, the associated images and the
+ *     annotations (one array per column).
+ *   - Every array and byte span is returned as a pointer / length pair that
+ *     points into the handle or directly into the mapped file; nothing is
+ *     copied across the boundary. Pointers remain valid until the handle is
+ *     closed. The mapping shall outlive the handle.
+ *   - Structures are plain C with fixed width fields and explicit padding.
+ *     Fields are only ever appended; `IFE_C_ABI_VERSION` increments when
+ *     they are.
+ *   - Functions never throw. They return an `IFE_Status` and the message of
+ *     the last failure on the calling thread is returned by ife_last_error.
+ *   - Handles are immutable after open and may be read from many threads.
+ *
+ * Tile and image spans are the stored (encoded, and if the tile table
+ * has a cipher, encrypted) bytes; decoding is left to the consumer.
+ *
+ * @copyright Copyright (c) 2026 Ryan Landvater. MIT licensed.
+ */
+#ifndef IrisFileExtension_h
+#define IrisFileExtension_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef IFE_EXPORT_API
+#define IFE_EXPORT_API      false
+#endif
+#ifndef IFE_C_EXPORT
+    #if IFE_EXPORT_API
+        #if defined(_MSC_VER)
+        #define IFE_C_EXPORT    __declspec(dllexport)
+        #else
+        #define IFE_C_EXPORT    __attribute__ ((visibility ("default")))
+        #endif
+    #else
+        #if defined(_MSC_VER)
+        #define IFE_C_EXPORT    __declspec(dllimport)
+        #else
+        #define IFE_C_EXPORT
+        #endif
+    #endif
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Version of the C interface structures and functions.
+#define IFE_C_ABI_VERSION   1
+
+/// Offset of a sparse (absent) tile or an absent byte block.
+#define IFE_NULL_OFFSET     UINT64_MAX
+
+typedef struct IFE_File_T* IFE_File;
+
+typedef enum IFE_Status {
+    IFE_STATUS_SUCCESS          = 0,
+    IFE_STATUS_FAILURE          = 1,    // The file failed to abstract or validate
+    IFE_STATUS_INVALID_ARGUMENT = 2,    // A NULL handle or output pointer
+    IFE_STATUS_OUT_OF_RANGE     = 3,    // An index beyond the array
+    IFE_STATUS_NOT_FOUND        = 4,    // An absent attribute or block
+} IFE_Status;
+
+/// Byte span within the mapped file or the handle.
+typedef struct IFE_Bytes {
+    const uint8_t*  data;
+    uint64_t        size;
+} IFE_Bytes;
+
+/// UTF-8 string; `data` is also NUL terminated unless the string is viewed
+/// within the mapped file (uncompressed attributes).
+typedef struct IFE_String {
+    const char*     data;
+    uint64_t        size;
+} IFE_String;
+
+typedef struct IFE_Header {
+    uint64_t        file_size;
+    uint32_t        extension_version;  // Major (high 16 bits) and minor version
+    uint32_t        revision;
+    uint64_t        fingerprint_low;    // Stored content fingerprint (0 if absent)
+    uint64_t        fingerprint_high;
+} IFE_Header;
+
+typedef struct IFE_TileTable {
+    uint8_t         encoding;           // IrisCodec::Encoding
+    uint8_t         format;             // Iris::Format
+    uint8_t         plane_type;         // IrisCodec::Abstraction::PlaneType
+    uint8_t         encrypted;          // Non-zero if the tiles carry a cipher
+    uint32_t        layers;
+    uint32_t        width;              // Layer 0 pixel extent
+    uint32_t        height;
+    uint64_t        tiles;              // Entries in the tile index
+    uint64_t        mip_tail_offset;    // Packed coarse layers (IFE_NULL_OFFSET if absent)
+    uint64_t        mip_tail_size;
+    uint32_t        mip_tail_layers;
+    uint32_t        planes;             // Focal planes / channels (0 if single plane)
+} IFE_TileTable;
+
+typedef struct IFE_Layer {
+    uint32_t        x_tiles;
+    uint32_t        y_tiles;
+    float           scale;
+    float           downsample;
+    uint16_t        tile_width;
+    uint16_t        tile_height;
+    uint32_t        reserved;
+    uint64_t        first_tile;         // Index of the layer's first tile in the tile index
+} IFE_Layer;
+
+typedef struct IFE_Tile {
+    uint64_t        offset;             // IFE_NULL_OFFSET if sparse
+    uint32_t        size;
+    uint32_t        reserved;
+} IFE_Tile;
+
+typedef struct IFE_Metadata {
+    uint32_t        codec_major;
+    uint32_t        codec_minor;
+    uint32_t        codec_build;
+    uint8_t         attributes_type;    // IrisCodec::MetadataType
+    uint8_t         reserved;
+    uint16_t        attributes_version;
+    float           microns_per_pixel;
+    float           magnification;
+    IFE_Bytes       icc_profile;        // Empty if absent
+} IFE_Metadata;
+
+/// Attribute key / value view; the attributes are sorted by key. Uncompressed
+/// attributes are viewed within the mapped file and compressed attributes
+/// within their decoded copy owned by the handle.
+typedef struct IFE_Attribute {
+    IFE_String      key;
+    IFE_String      value;
+} IFE_Attribute;
+
+/// Associated image; the images are sorted by title.
+typedef struct IFE_AssociatedImage {
+    IFE_String      title;
+    IFE_Bytes       bytes;              // Encoded image (empty if tiled)
+    uint32_t        width;
+    uint32_t        height;
+    uint8_t         encoding;           // IrisCodec::ImageEncoding
+    uint8_t         format;             // Iris::Format
+    uint16_t        orientation;
+    uint32_t        layers;             // Tiled (v2) pyramid layers (0 if not tiled)
+} IFE_AssociatedImage;
+
+/**
+ * @brief Annotation columns; row i of every column describes one annotation.
+ *
+ * Rows are sorted by identifier. Annotation bytes are the stored bytes
+ * (compressed text / SVG if compression is non-zero; see ife_file_annotation_bytes).
+ */
+typedef struct IFE_Annotations {
+    uint64_t        count;
+    const uint32_t* identifier;
+    const uint8_t*  type;               // Iris::AnnotationTypes
+    const uint8_t*  compression;        // IrisCodec::Abstraction::TextCompression
+    const float*    x_location;
+    const float*    y_location;
+    const float*    x_size;
+    const float*    y_size;
+    const uint32_t* width;
+    const uint32_t* height;
+    const uint32_t* parent;
+    const uint64_t* offset;
+    const uint64_t* byte_size;
+} IFE_Annotations;
+
+/// Annotation group; members are 24-bit identifiers (`number` x 3 bytes).
+typedef struct IFE_AnnotationGroup {
+    IFE_String      name;
+    IFE_Bytes       members;
+    uint32_t        number;
+    uint32_t        reserved;
+} IFE_AnnotationGroup;
+
+/// Message of the last failure on the calling thread (empty if none).
+IFE_C_EXPORT const char* ife_last_error             (void);
+/// Version of the C interface the library was built with (IFE_C_ABI_VERSION).
+IFE_C_EXPORT uint32_t   ife_abi_version             (void);
+
+/// Full structural validation of a mapped file.
+IFE_C_EXPORT IFE_Status ife_validate                (uint8_t* mapped_file, uint64_t file_size);
+/// Abstract a mapped file. The mapping shall outlive the handle.
+IFE_C_EXPORT IFE_Status ife_file_open               (uint8_t* mapped_file, uint64_t file_size, IFE_File* file);
+/// Release the handle and every array returned from it.
+IFE_C_EXPORT void       ife_file_close              (IFE_File file);
+
+IFE_C_EXPORT IFE_Status ife_file_header             (IFE_File file, IFE_Header* header);
+IFE_C_EXPORT IFE_Status ife_file_tile_table         (IFE_File file, IFE_TileTable* table);
+IFE_C_EXPORT IFE_Status ife_file_layers             (IFE_File file, const IFE_Layer** layers, uint64_t* count);
+/// Flat tile index of the primary plane (layer-major, row-major within a layer).
+IFE_C_EXPORT IFE_Status ife_file_tiles              (IFE_File file, const IFE_Tile** tiles, uint64_t* count);
+/// Stored bytes of a tile; IFE_STATUS_NOT_FOUND for a sparse tile.
+IFE_C_EXPORT IFE_Status ife_file_tile_bytes         (IFE_File file, uint32_t layer, uint32_t tile, IFE_Bytes* bytes);
+/// Focal plane / channel values (empty if single plane).
+IFE_C_EXPORT IFE_Status ife_file_planes             (IFE_File file, const float** values, uint64_t* count);
+
+IFE_C_EXPORT IFE_Status ife_file_metadata           (IFE_File file, IFE_Metadata* metadata);
+IFE_C_EXPORT IFE_Status ife_file_attributes         (IFE_File file, const IFE_Attribute** attributes, uint64_t* count);
+/// Binary search of the sorted attributes; IFE_STATUS_NOT_FOUND if absent.
+IFE_C_EXPORT IFE_Status ife_file_attribute          (IFE_File file, const char* key, uint64_t key_size, IFE_String* value);
+
+IFE_C_EXPORT IFE_Status ife_file_associated_images  (IFE_File file, const IFE_AssociatedImage** images, uint64_t* count);
+/// Layers and flat tile index of a tiled (v2) associated image.
+IFE_C_EXPORT IFE_Status ife_file_associated_tiles   (IFE_File file, uint64_t image,
+                                                     const IFE_Layer** layers, uint64_t* layer_count,
+                                                     const IFE_Tile** tiles, uint64_t* tile_count);
+
+IFE_C_EXPORT IFE_Status ife_file_annotations        (IFE_File file, IFE_Annotations* annotations);
+/// Stored bytes of the annotation at the given row.
+IFE_C_EXPORT IFE_Status ife_file_annotation_bytes   (IFE_File file, uint64_t row, IFE_Bytes* bytes);
+IFE_C_EXPORT IFE_Status ife_file_annotation_groups  (IFE_File file, const IFE_AnnotationGroup** groups, uint64_t* count);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /* IrisFileExtension_h */
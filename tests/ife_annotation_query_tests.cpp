@@ -0,0 +1,162 @@
+/**
+ * @file ife_annotation_query_tests.cpp
+ * @brief Unit tests for the viewport queries of the annotation spatial index
+ *        and level-of-detail aggregates.
+ *
+ * Annotation sizes are signed: an annotation anchored beyond the viewport
+ * with a negative size may still reach into it. Queries shall return the
+ * cells of such annotations on every side of the viewport, and viewports
+ * given with negative extents shall be queried as their normalized region.
+ *
+ * Self-contained (no external test framework) so CI doesn't need extra deps.
+ * Run with `ctest` or directly; non-zero exit on failure.
+ */
+#include "IrisTypes.hpp"
+#include "IrisCodecTypes.hpp"
+#include "IrisCodecExtension.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+
+using namespace IrisCodec;
+using IrisCodec::NULL_OFFSET;
+
+int g_failures = 0;
+
+#define IFE_CHECK(cond) do { \
+    if (!(cond)) { \
+        std::fprintf(stderr, "FAIL: %s (%s:%d)\n", #cond, __FILE__, __LINE__); \
+        ++g_failures; \
+    } \
+} while (0)
+
+uint32_t morton(uint16_t x, uint16_t y) {
+    uint32_t code = 0;
+    for (uint32_t bit = 0; bit < 16; ++bit)
+        code |= (uint32_t(x >> bit & 1) << (2 * bit)) | (uint32_t(y >> bit & 1) << (2 * bit + 1));
+    return code;
+}
+
+// A 10 x 10 grid of 100 unit cells; one annotation per occupied cell
+Abstraction::AnnotationIndex make_index(std::initializer_list<std::pair<uint16_t, uint16_t>> cells) {
+    Abstraction::AnnotationIndex index;
+    index.cellWidth     = 100.f;
+    index.cellHeight    = 100.f;
+    index.xCells        = 10;
+    index.yCells        = 10;
+    index.maxXSize      = 50.f;
+    index.maxYSize      = 50.f;
+    index.entrySize     = 32;
+    index.entries       = 1000;
+    for (auto&& cell : cells)
+        index.buckets.push_back({.cell = morton(cell.first, cell.second)});
+    std::sort(index.buckets.begin(), index.buckets.end(),
+              [](const auto& a, const auto& b) {return a.cell < b.cell;});
+    for (uint32_t BI = 0; BI < index.buckets.size(); ++BI) {
+        index.buckets[BI].first  = BI;
+        index.buckets[BI].number = 1;
+    }
+    return index;
+}
+
+// Index of the entry of the bucket of a cell within the query ranges
+bool queried(const Abstraction::AnnotationIndex& index,
+             const Abstraction::AnnotationIndex::EntryRanges& ranges, uint16_t x, uint16_t y) {
+    const auto cell = morton(x, y);
+    for (auto&& bucket : index.buckets) if (bucket.cell == cell)
+        for (auto&& range : ranges)
+            if (bucket.first >= range.first && bucket.first < range.first + range.number)
+                return true;
+    return false;
+}
+
+// An annotation anchored right of or below the viewport with a negative size
+// (ex: anchored at x = 520 with x-size -50) reaches back into the viewport
+void test_index_signed_sizes() {
+    const auto index = make_index({{5, 2}, {2, 5}, {5, 5}, {0, 2}, {8, 8}});
+    const auto ranges = index.query(380.f, 380.f, 100.f, 100.f);
+    IFE_CHECK(queried(index, ranges, 5, 2) == false); // Above the expanded rows
+    IFE_CHECK(queried(index, ranges, 5, 5));          // Right of and below the viewport
+    IFE_CHECK(queried(index, ranges, 8, 8) == false);
+    IFE_CHECK(queried(index, ranges, 0, 2) == false);
+
+    const auto row = index.query(380.f, 180.f, 100.f, 100.f);
+    IFE_CHECK(queried(index, row, 5, 2));             // Right of the viewport
+    const auto column = index.query(180.f, 380.f, 100.f, 100.f);
+    IFE_CHECK(queried(index, column, 2, 5));          // Below the viewport
+
+    // Cells beyond the largest annotation size are not queried
+    const auto clear = index.query(300.f, 300.f, 60.f, 60.f);
+    IFE_CHECK(queried(index, clear, 5, 5) == false);
+}
+
+// Negative extents span the viewport to the left of or above the location
+void test_index_negative_extents() {
+    const auto index = make_index({{5, 5}, {1, 1}});
+    const auto positive = index.query(380.f, 380.f, 100.f, 100.f);
+    const auto negative = index.query(480.f, 480.f, -100.f, -100.f);
+    IFE_CHECK(positive.size() == negative.size());
+    IFE_CHECK(queried(index, negative, 5, 5));
+    IFE_CHECK(queried(index, negative, 1, 1) == false);
+    for (size_t RI = 0; RI < std::min(positive.size(), negative.size()); ++RI) {
+        IFE_CHECK(positive[RI].first == negative[RI].first);
+        IFE_CHECK(positive[RI].number == negative[RI].number);
+        IFE_CHECK(negative[RI].offset == index.entries + Offset(negative[RI].first) * index.entrySize);
+    }
+}
+
+// A 16 x 16 tile slide; annotations listed by their tile at the highest resolution layer
+Abstraction::AnnotationLOD make_lod(std::initializer_list<std::pair<uint16_t, uint16_t>> tiles) {
+    Abstraction::AnnotationLOD lod;
+    lod.cellLength      = 256.f;
+    lod.xCells          = 16;
+    lod.yCells          = 16;
+    lod.maxXSize        = 60.f;
+    lod.maxYSize        = 60.f;
+    lod.layers.resize(1);
+    uint32_t identifier = 0;
+    for (auto&& tile : tiles)
+        lod.entries.emplace_back(morton(tile.first, tile.second), ++identifier);
+    std::sort(lod.entries.begin(), lod.entries.end());
+    return lod;
+}
+bool contains(const Abstraction::AnnotationLOD::View& view, uint32_t identifier) {
+    return std::find(view.annotations.begin(), view.annotations.end(), identifier) != view.annotations.end();
+}
+
+// As per the index, on every side of the viewport and for negative extents
+void test_lod_signed_sizes() {
+    // Identifiers 1: right of, 2: below, 3: far right of the viewport
+    const auto lod = make_lod({{5, 2}, {2, 5}, {9, 2}});
+    const auto view = lod.query(0, 1000.f, 1000.f - 2.f * 256.f, 250.f, 560.f);
+    IFE_CHECK(contains(view, 1));
+    IFE_CHECK(contains(view, 2) == false);
+    IFE_CHECK(contains(view, 3) == false);
+
+    const auto below = lod.query(0, 500.f, 1000.f, 200.f, 250.f);
+    IFE_CHECK(contains(below, 2));
+    IFE_CHECK(contains(below, 1) == false);
+
+    const auto negative = lod.query(0, 1250.f, 1048.f, -250.f, -560.f);
+    IFE_CHECK(contains(negative, 1));
+    IFE_CHECK(contains(negative, 3) == false);
+}
+
+} // namespace
+
+int main() {
+    test_index_signed_sizes();
+    test_index_negative_extents();
+    test_lod_signed_sizes();
+
+    if (g_failures == 0) {
+        std::printf("ife_annotation_query_tests: ALL PASS\n");
+        return 0;
+    }
+    std::fprintf(stderr, "ife_annotation_query_tests: %d FAILURE(S)\n", g_failures);
+    return 1;
+}
@@ -0,0 +1,340 @@
+/**
+ * @file ife_associated_tiles_tests.cpp
+ * @brief Round-trip tests for tiled (v2) associated image pyramids.
+ *
+ * Writes an in-memory slide holding a tiled macro image beside a monolithic
+ * label image and checks that full validation and the streaming validator
+ * accept it; that the read pyramid matches ASSOCIATED_IMAGE_EXTENTS and
+ * locates each stored tile; that thumbnail and region return the tiles a
+ * reader requires; and that pyramids not covering the image, half-referenced
+ * pyramids and title-only images without a pyramid are refused.
+ *
+ * Self-contained (no external test framework) so CI doesn't need extra deps.
+ * Run with `ctest` or directly; non-zero exit on failure.
+ */
+#include "IrisTypes.hpp"
+#include "IrisCodecTypes.hpp"
+#include "IrisCodecExtension.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace IrisCodec;
+using namespace IrisCodec::Serialization;
+using IrisCodec::NULL_OFFSET;
+
+int g_failures = 0;
+
+#define IFE_CHECK(cond) do { \
+    if (!(cond)) { \
+        std::fprintf(stderr, "FAIL: %s (%s:%d)\n", #cond, __FILE__, __LINE__); \
+        ++g_failures; \
+    } \
+} while (0)
+
+constexpr uint32_t MACRO_WIDTH  = 1000;
+constexpr uint32_t MACRO_HEIGHT = 600;
+constexpr uint32_t TILE_BYTES   = 40;
+constexpr uint32_t LABEL_BYTES  = 100;
+
+struct ImageFile {
+    std::vector<BYTE>   file;
+    Offset              images      = NULL_OFFSET;
+    Offset              tileOffsets = NULL_OFFSET;  // Macro pyramid TILE_OFFSETS
+    Abstraction::TileTable::Layers tiles;   // Macro pyramid tiles
+};
+
+BYTE tile_byte (uint32_t layer, uint32_t tile) {
+    return BYTE(layer * 40 + tile + 1);
+}
+
+// A single tile slide with a tiled 1000 x 600 macro image (3 layers of
+// 1x1, 2x2 and 4x3 tiles) and a monolithic label image
+ImageFile make_file () {
+    ImageFile slide;
+    auto& file              = slide.file;
+    file.resize(FILE_HEADER::HEADER_SIZE);
+    auto append = [&file](Size bytes) {
+        const Offset offset = file.size();
+        file.resize(offset + bytes);
+        return offset;
+    };
+
+    LayerExtents extents (1);
+    extents[0].xTiles       = 1;
+    extents[0].yTiles       = 1;
+    extents[0].scale        = 1.f;
+    extents[0].downsample   = 1.f;
+    Abstraction::TileTable::Layers layers (1);
+    layers[0].push_back({append(TILE_BYTES), TILE_BYTES});
+    const Offset extents_at = append(SIZE_EXTENTS(extents));
+    STORE_EXTENTS           (file.data(), extents_at, extents);
+    const Offset offsets_at = append(SIZE_TILE_OFFSETS(layers));
+    STORE_TILE_OFFSETS      (file.data(), offsets_at, layers);
+
+    TileTableCreateInfo table;
+    table.tileTableOffset   = append(TILE_TABLE::HEADER_SIZE);
+    table.encoding          = TILE_ENCODING_JPEG;
+    table.format            = FORMAT_R8G8B8;
+    table.tilesOffset       = offsets_at;
+    table.layerExtentsOffset= extents_at;
+    table.layers            = 1;
+    table.widthPixels       = 256;
+    table.heightPixels      = 256;
+    STORE_TILE_TABLE        (file.data(), table);
+
+    // Macro pyramid: tiles, extents, tile offsets and a title only bytes block
+    const auto pyramid      = ASSOCIATED_IMAGE_EXTENTS(MACRO_WIDTH, MACRO_HEIGHT);
+    slide.tiles.resize(pyramid.size());
+    for (uint32_t LI = 0; LI < pyramid.size(); ++LI)
+        for (uint32_t TI = 0; TI < pyramid[LI].xTiles * pyramid[LI].yTiles; ++TI) {
+            const Offset offset = append(TILE_BYTES + TI);
+            std::fill(file.begin() + offset, file.begin() + offset + TILE_BYTES + TI, tile_byte(LI, TI));
+            slide.tiles[LI].push_back({offset, TILE_BYTES + TI});
+        }
+    AssociatedImageCreateInfo::Entry macro;
+    macro.layerExtentsOffset= append(SIZE_EXTENTS(pyramid));
+    STORE_EXTENTS           (file.data(), macro.layerExtentsOffset, pyramid);
+    macro.tileOffsetsOffset = append(SIZE_TILE_OFFSETS(slide.tiles));
+    STORE_TILE_OFFSETS      (file.data(), macro.tileOffsetsOffset, slide.tiles);
+    slide.tileOffsets       = macro.tileOffsetsOffset;
+    ImageBytesCreateInfo macro_bytes {.title = "macro", .tiled = true};
+    macro_bytes.offset      = append(SIZE_IMAGES_BYTES(macro_bytes));
+    STORE_IMAGES_BYTES      (file.data(), macro_bytes);
+    macro.offset            = macro_bytes.offset;
+    macro.info.title        = "macro";
+    macro.info.width        = MACRO_WIDTH;
+    macro.info.height       = MACRO_HEIGHT;
+    macro.info.encoding     = IMAGE_ENCODING_JPEG;
+    macro.info.sourceFormat = FORMAT_R8G8B8;
+
+    std::vector<BYTE> label_data (LABEL_BYTES, 0x7E);
+    ImageBytesCreateInfo label_bytes {.title = "label", .data = label_data.data(), .dataBytes = LABEL_BYTES};
+    label_bytes.offset      = append(SIZE_IMAGES_BYTES(label_bytes));
+    STORE_IMAGES_BYTES      (file.data(), label_bytes);
+    AssociatedImageCreateInfo::Entry label;
+    label.offset            = label_bytes.offset;
+    label.info.title        = "label";
+    label.info.width        = 300;
+    label.info.height       = 200;
+    label.info.encoding     = IMAGE_ENCODING_PNG;
+    label.info.sourceFormat = FORMAT_R8G8B8;
+
+    AssociatedImageCreateInfo images;
+    images.images           = {macro, label};
+    images.offset           = append(SIZE_IMAGES_ARRAY(images));
+    STORE_IMAGES_ARRAY      (file.data(), images);
+    slide.images            = images.offset;
+
+    MetadataCreateInfo metadata;
+    metadata.metadataOffset = append(METADATA::HEADER_SIZE);
+    metadata.codecVersion   = {1, 0, 0};
+    metadata.images         = images.offset;
+    metadata.micronsPerPixel= 0.25f;
+    metadata.magnification  = 40.f;
+    STORE_METADATA          (file.data(), metadata);
+
+    HeaderCreateInfo header;
+    header.fileSize         = file.size();
+    header.revision         = 1;
+    header.tileTableOffset  = table.tileTableOffset;
+    header.metadataOffset   = metadata.metadataOffset;
+    STORE_FILE_HEADER       (file.data(), header);
+    return slide;
+}
+
+Result stream_validate (const std::vector<BYTE>& file) {
+    StreamValidator validator;
+    for (size_t offset = 0; offset < file.size(); offset += 41)
+        validator.push(file.data() + offset, std::min<size_t>(41, file.size() - offset));
+    return validator.finish();
+}
+
+Offset macro_entry (const ImageFile& slide) {
+    return slide.images + IMAGE_ARRAY::HEADER_SIZE;
+}
+
+bool holds (const std::vector<BYTE>& file, const Abstraction::TileEntry& tile, BYTE value) {
+    return std::all_of(file.begin() + tile.offset, file.begin() + tile.offset + tile.size,
+                       [value](BYTE byte) {return byte == value;});
+}
+
+void test_image_extents() {
+    const auto extents = ASSOCIATED_IMAGE_EXTENTS(MACRO_WIDTH, MACRO_HEIGHT);
+    IFE_CHECK(extents.size() == 3);
+    if (extents.size() == 3) {
+        IFE_CHECK(extents[0].xTiles == 1 && extents[0].yTiles == 1);
+        IFE_CHECK(extents[1].xTiles == 2 && extents[1].yTiles == 2);
+        IFE_CHECK(extents[2].xTiles == 4 && extents[2].yTiles == 3);
+        IFE_CHECK(extents[0].downsample == 4.f && extents[2].downsample == 1.f);
+    }
+    // An image within a single tile is a single layer
+    IFE_CHECK(ASSOCIATED_IMAGE_EXTENTS(200, 100).size() == 1);
+    IFE_CHECK(ASSOCIATED_IMAGE_EXTENTS(1000, 600, {512, 512}).size() == 2);
+    bool threw = false;
+    try {ASSOCIATED_IMAGE_EXTENTS(0, 600);}
+    catch (const std::exception&) {threw = true;}
+    IFE_CHECK(threw);
+}
+
+void test_store_and_read() {
+    auto slide = make_file();
+    IFE_CHECK(validate_file_structure(slide.file.data(), slide.file.size()) == IRIS_SUCCESS);
+    IFE_CHECK(stream_validate(slide.file) == IRIS_SUCCESS);
+
+    const auto abstraction = abstract_file_structure(slide.file.data(), slide.file.size());
+    IFE_CHECK(abstraction.images.size() == 2);
+    IFE_CHECK(abstraction.images.count("macro") && abstraction.images.count("label"));
+    if (!abstraction.images.count("macro") || !abstraction.images.count("label")) return;
+
+    const auto& macro = abstraction.images.at("macro");
+    IFE_CHECK(macro.tiled());
+    IFE_CHECK(macro.byteSize == 0);
+    IFE_CHECK(macro.info.width == MACRO_WIDTH && macro.info.height == MACRO_HEIGHT);
+    IFE_CHECK(macro.pyramid.layers.size() == slide.tiles.size());
+    for (uint32_t LI = 0; LI < std::min(macro.pyramid.layers.size(), slide.tiles.size()); ++LI) {
+        IFE_CHECK(macro.pyramid.layers[LI].size() == slide.tiles[LI].size());
+        for (uint32_t TI = 0; TI < std::min(macro.pyramid.layers[LI].size(), slide.tiles[LI].size()); ++TI) {
+            const auto& tile = macro.pyramid.layers[LI][TI];
+            IFE_CHECK(tile.offset == slide.tiles[LI][TI].offset && tile.size == slide.tiles[LI][TI].size);
+            IFE_CHECK(holds(slide.file, tile, tile_byte(LI, TI)));
+        }
+    }
+    IFE_CHECK(macro.layer_width(0) == 250 && macro.layer_height(0) == 150);
+    IFE_CHECK(macro.layer_width(1) == 500 && macro.layer_height(1) == 300);
+    IFE_CHECK(macro.layer_width(2) == MACRO_WIDTH && macro.layer_height(2) == MACRO_HEIGHT);
+
+    // The monolithic image keeps its byte stream and has no pyramid
+    const auto& label = abstraction.images.at("label");
+    IFE_CHECK(!label.tiled());
+    IFE_CHECK(label.byteSize == LABEL_BYTES);
+    IFE_CHECK(holds(slide.file, {label.offset, uint32_t(label.byteSize)}, 0x7E));
+    IFE_CHECK(label.thumbnail(64, 64).empty());
+    IFE_CHECK(label.region(0, 0, 0, 10, 10).empty());
+}
+
+void test_tile_lookup() {
+    auto slide = make_file();
+    const auto abstraction = abstract_file_structure(slide.file.data(), slide.file.size());
+    if (!abstraction.images.count("macro")) {IFE_CHECK(false); return;}
+    const auto& macro = abstraction.images.at("macro");
+
+    // A macro preview needs a single tile
+    auto tiles = macro.thumbnail(200, 100);
+    IFE_CHECK(tiles.size() == 1 && tiles[0].layer == 0);
+    IFE_CHECK(tiles.size() && tiles[0].entry.offset == slide.tiles[0][0].offset);
+    tiles = macro.thumbnail(400, 250);
+    IFE_CHECK(tiles.size() == 4 && tiles[0].layer == 1);
+    // Larger than the image: the full resolution layer
+    tiles = macro.thumbnail(4000, 4000);
+    IFE_CHECK(tiles.size() == 12 && tiles[0].layer == 2);
+
+    // A region within a single tile
+    tiles = macro.region(2, 300, 260, 10, 10);
+    IFE_CHECK(tiles.size() == 1);
+    if (tiles.size() == 1) {
+        IFE_CHECK(tiles[0].x == 1 && tiles[0].y == 1 && tiles[0].index == 5);
+        IFE_CHECK(tiles[0].entry.offset == slide.tiles[2][5].offset);
+    }
+    // A region overhanging the image is clipped to the layer's tiles
+    tiles = macro.region(2, 700, 500, 1000, 1000);
+    IFE_CHECK(tiles.size() == 4);
+    if (tiles.size() == 4) {
+        IFE_CHECK(tiles.front().x == 2 && tiles.front().y == 1);
+        IFE_CHECK(tiles.back().x == 3 && tiles.back().y == 2 && tiles.back().index == 11);
+    }
+    IFE_CHECK(macro.region(2, MACRO_WIDTH, 0, 10, 10).empty());
+    IFE_CHECK(macro.region(2, 0, 0, 0, 10).empty());
+    bool threw = false;
+    try {macro.region(3, 0, 0, 10, 10);}
+    catch (const std::exception&) {threw = true;}
+    IFE_CHECK(threw);
+}
+
+void test_invalid_images() {
+    auto set_u64 = [](std::vector<BYTE>& file, Offset offset, uint64_t value) {
+        std::memcpy(file.data() + offset, &value, sizeof(value));
+    };
+    auto set_u32 = [](std::vector<BYTE>& file, Offset offset, uint32_t value) {
+        std::memcpy(file.data() + offset, &value, sizeof(value));
+    };
+    {   // The full resolution tiles do not cover the image width
+        auto slide = make_file();
+        set_u32(slide.file, macro_entry(slide) + IMAGE_ENTRY::WIDTH, 1100);
+        IFE_CHECK(validate_file_structure(slide.file.data(), slide.file.size()) & IRIS_FAILURE);
+    }
+    {   // ...or exceed it by a whole tile column
+        auto slide = make_file();
+        set_u32(slide.file, macro_entry(slide) + IMAGE_ENTRY::WIDTH, 700);
+        IFE_CHECK(validate_file_structure(slide.file.data(), slide.file.size()) & IRIS_FAILURE);
+    }
+    {   // Extents without tile offsets
+        auto slide = make_file();
+        set_u64(slide.file, macro_entry(slide) + IMAGE_ENTRY::TILE_OFFSETS_OFFSET, NULL_OFFSET);
+        IFE_CHECK(validate_file_structure(slide.file.data(), slide.file.size()) & IRIS_FAILURE);
+    }
+    {   // A title only image without a pyramid
+        auto slide = make_file();
+        set_u64(slide.file, macro_entry(slide) + IMAGE_ENTRY::LAYER_EXTENTS_OFFSET, NULL_OFFSET);
+        set_u64(slide.file, macro_entry(slide) + IMAGE_ENTRY::TILE_OFFSETS_OFFSET, NULL_OFFSET);
+        IFE_CHECK(validate_file_structure(slide.file.data(), slide.file.size()) & IRIS_FAILURE);
+    }
+    {   // A pyramid tile beyond the end of the file
+        auto slide = make_file();
+        const uint64_t offset = slide.file.size();
+        std::memcpy(slide.file.data() + slide.tileOffsets + TILE_OFFSETS::HEADER_SIZE + TILE_OFFSET::OFFSET,
+                    &offset, 5);
+        IFE_CHECK(validate_file_structure(slide.file.data(), slide.file.size()) & IRIS_FAILURE);
+    }
+
+    // Refused on store
+    std::vector<BYTE> buffer (1024);
+    std::vector<BYTE> data (8);
+    bool threw = false;
+    try {STORE_IMAGES_BYTES(buffer.data(), {.offset = 0, .title = "macro",
+                            .data = data.data(), .dataBytes = data.size(), .tiled = true});}
+    catch (const std::exception&) {threw = true;}
+    IFE_CHECK(threw);
+    AssociatedImageCreateInfo images;
+    images.offset           = 0;
+    images.images.resize(1);
+    auto& entry             = images.images[0];
+    entry.offset            = 64;
+    entry.info.width        = MACRO_WIDTH;
+    entry.info.height       = MACRO_HEIGHT;
+    entry.info.encoding     = IMAGE_ENCODING_JPEG;
+    entry.info.sourceFormat = FORMAT_R8G8B8;
+    entry.layerExtentsOffset= 128;
+    threw = false;
+    try {STORE_IMAGES_ARRAY(buffer.data(), images);}
+    catch (const std::exception&) {threw = true;}
+    IFE_CHECK(threw);
+}
+
+} // namespace
+
+int main() {
+    try {
+        test_image_extents();
+        test_store_and_read();
+        test_tile_lookup();
+        test_invalid_images();
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "ife_associated_tiles_tests: %s\n", e.what());
+        return 1;
+    }
+
+    if (g_failures == 0) {
+        std::printf("ife_associated_tiles_tests: ALL PASS\n");
+        return 0;
+    }
+    std::fprintf(stderr, "ife_associated_tiles_tests: %d FAILURE(S)\n", g_failures);
+    return 1;
+}
@@ -0,0 +1,284 @@
+/**
+ * @file ife_attributes_directory_tests.cpp
+ * @brief Round-trip tests for the hash-sorted (v2) attributes directory.
+ *
+ * Writes an in-memory slide whose attributes reference a directory and
+ * checks that full validation and the streaming validator accept it, that
+ * the directory is sorted by key hash and locates each key and value, that
+ * a keyed read returns exactly the requested attributes present and agrees
+ * with the full read, and that unsorted, mismatched or miscounted entries
+ * and a directory accompanying compressed attributes are refused.
+ *
+ * Self-contained (no external test framework) so CI doesn't need extra deps.
+ * Run with `ctest` or directly; non-zero exit on failure.
+ */
+#include "IrisTypes.hpp"
+#include "IrisCodecTypes.hpp"
+#include "IrisCodecExtension.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace IrisCodec;
+using namespace IrisCodec::Serialization;
+using IrisCodec::NULL_OFFSET;
+
+int g_failures = 0;
+
+#define IFE_CHECK(cond) do { \
+    if (!(cond)) { \
+        std::fprintf(stderr, "FAIL: %s (%s:%d)\n", #cond, __FILE__, __LINE__); \
+        ++g_failures; \
+    } \
+} while (0)
+
+constexpr uint32_t TILE_BYTES   = 32;
+
+struct DirectoryFile {
+    std::vector<BYTE>   file;
+    Attributes          attributes;
+    Offset              attributesOffset = NULL_OFFSET;
+    Offset              directory   = NULL_OFFSET;
+};
+
+Attributes make_attributes () {
+    Attributes attributes;
+    attributes.type         = METADATA_I2S;
+    attributes.version      = 1;
+    attributes["scanner"]   = u8"test";
+    attributes["stain"]     = u8"H&E";
+    attributes["objective"] = u8"40x";
+    attributes["barcode"]   = u8"S-0001-A";
+    attributes["empty"]     = u8"";
+    for (int index = 0; index < 12; ++index)
+        attributes["tag." + std::to_string(index)] = std::u8string(size_t(index) * 3, char8_t('a' + index));
+    return attributes;
+}
+
+// A single layer (1x1 tile) slide with the given attributes and a directory
+DirectoryFile make_file (bool directory = true) {
+    DirectoryFile slide;
+    slide.attributes        = make_attributes();
+    auto& file              = slide.file;
+    file.resize(FILE_HEADER::HEADER_SIZE);
+    auto append = [&file](Size bytes) {
+        const Offset offset = file.size();
+        file.resize(offset + bytes);
+        return offset;
+    };
+
+    LayerExtents extents (1);
+    extents[0].xTiles       = 1;
+    extents[0].yTiles       = 1;
+    extents[0].scale        = 1.f;
+    extents[0].downsample   = 1.f;
+    Abstraction::TileTable::Layers layers (1);
+    layers[0].push_back({append(TILE_BYTES), TILE_BYTES});
+    const Offset extents_at = append(SIZE_EXTENTS(extents));
+    STORE_EXTENTS           (file.data(), extents_at, extents);
+    const Offset offsets_at = append(SIZE_TILE_OFFSETS(layers));
+    STORE_TILE_OFFSETS      (file.data(), offsets_at, layers);
+
+    TileTableCreateInfo table;
+    table.tileTableOffset   = append(TILE_TABLE::HEADER_SIZE);
+    table.encoding          = TILE_ENCODING_JPEG;
+    table.format            = FORMAT_R8G8B8;
+    table.tilesOffset       = offsets_at;
+    table.layerExtentsOffset= extents_at;
+    table.layers            = 1;
+    table.widthPixels       = 256;
+    table.heightPixels      = 256;
+    STORE_TILE_TABLE        (file.data(), table);
+
+    const auto& attributes  = slide.attributes;
+    AttributesCreateInfo attribute_info;
+    attribute_info.attributesOffset = append(ATTRIBUTES::HEADER_SIZE);
+    attribute_info.type     = attributes.type;
+    attribute_info.version  = attributes.version;
+    attribute_info.sizes    = append(SIZE_ATTRIBUTES_SIZES(attributes));
+    attribute_info.bytes    = append(SIZE_ATTRIBUTES_BYTES(attributes));
+    STORE_ATTRIBUTES_SIZES  (file.data(), attribute_info.sizes, attributes);
+    STORE_ATTRIBUTES_BYTES  (file.data(), attribute_info.bytes, attributes);
+    if (directory) {
+        attribute_info.directory = append(SIZE_ATTRIBUTES_DIRECTORY(attributes));
+        STORE_ATTRIBUTES_DIRECTORY (file.data(), attribute_info.directory, attributes);
+    }
+    STORE_ATTRIBUTES        (file.data(), attribute_info);
+    slide.attributesOffset  = attribute_info.attributesOffset;
+    slide.directory         = attribute_info.directory;
+
+    MetadataCreateInfo metadata;
+    metadata.metadataOffset = append(METADATA::HEADER_SIZE);
+    metadata.codecVersion   = {1, 0, 0};
+    metadata.attributes     = attribute_info.attributesOffset;
+    metadata.micronsPerPixel= 0.25f;
+    metadata.magnification  = 40.f;
+    STORE_METADATA          (file.data(), metadata);
+
+    HeaderCreateInfo header;
+    header.fileSize         = file.size();
+    header.revision         = 1;
+    header.tileTableOffset  = table.tileTableOffset;
+    header.metadataOffset   = metadata.metadataOffset;
+    STORE_FILE_HEADER       (file.data(), header);
+    return slide;
+}
+
+Result stream_validate (const std::vector<BYTE>& file) {
+    StreamValidator validator;
+    for (size_t offset = 0; offset < file.size(); offset += 29)
+        validator.push(file.data() + offset, std::min<size_t>(29, file.size() - offset));
+    return validator.finish();
+}
+
+ATTRIBUTES get_attributes (const std::vector<BYTE>& file) {
+    const auto __HEADER = FILE_HEADER(file.size());
+    return __HEADER.get_metadata(file.data()).get_attributes(file.data());
+}
+
+Offset entry_offset (const DirectoryFile& slide, uint32_t entry) {
+    return slide.directory + ATTRIBUTES_DIRECTORY::HEADER_SIZE + Offset(entry) * ATTRIBUTE_DIRECTORY_ENTRY::SIZE;
+}
+
+void test_store_and_validate() {
+    auto slide = make_file();
+    IFE_CHECK(validate_file_structure(slide.file.data(), slide.file.size()) == IRIS_SUCCESS);
+    IFE_CHECK(stream_validate(slide.file) == IRIS_SUCCESS);
+
+    // The full read is unchanged by the directory
+    const auto abstraction = abstract_file_structure(slide.file.data(), slide.file.size());
+    IFE_CHECK(abstraction.metadata.attributes.size() == slide.attributes.size());
+    for (auto&& attribute : slide.attributes) {
+        const auto read = abstraction.metadata.attributes.find(attribute.first);
+        IFE_CHECK(read != abstraction.metadata.attributes.end() && read->second == attribute.second);
+    }
+}
+
+void test_directory_entries() {
+    auto slide = make_file();
+    const auto __ATTRIBUTES = get_attributes(slide.file);
+    IFE_CHECK(__ATTRIBUTES.directory(slide.file.data()));
+    const auto directory = __ATTRIBUTES.read_directory(slide.file.data());
+    IFE_CHECK(directory.entries.size() == slide.attributes.size());
+    IFE_CHECK(std::is_sorted(directory.entries.begin(), directory.entries.end(),
+              [](const auto& a, const auto& b) {return a.hash < b.hash;}));
+
+    // Every entry locates its own key and value
+    for (auto&& entry : directory.entries) {
+        const std::string key ((const char*)slide.file.data() + directory.bytes + entry.keyOffset, entry.keySize);
+        IFE_CHECK(entry.hash == AttributeDirectory::hash(key));
+        const auto attribute = slide.attributes.find(key);
+        IFE_CHECK(attribute != slide.attributes.end());
+        if (attribute == slide.attributes.end()) continue;
+        IFE_CHECK(entry.valueSize == attribute->second.size());
+        IFE_CHECK(std::memcmp(slide.file.data() + directory.bytes + entry.valueOffset,
+                              attribute->second.data(), entry.valueSize) == 0);
+        const auto [first, last] = directory.find(key);
+        IFE_CHECK(std::distance(first, last) == 1 && first->keyOffset == entry.keyOffset);
+    }
+    const auto [first, last] = directory.find("absent");
+    IFE_CHECK(first == last);
+}
+
+void test_keyed_read() {
+    auto slide = make_file();
+    const auto __ATTRIBUTES = get_attributes(slide.file);
+    const auto read = __ATTRIBUTES.read_attributes(slide.file.data(), {"stain", "tag.7", "empty", "absent"});
+    IFE_CHECK(read.type == slide.attributes.type);
+    IFE_CHECK(read.version == slide.attributes.version);
+    IFE_CHECK(read.size() == 3);
+    IFE_CHECK(read.count("stain") && read.at("stain") == slide.attributes.at("stain"));
+    IFE_CHECK(read.count("tag.7") && read.at("tag.7") == slide.attributes.at("tag.7"));
+    IFE_CHECK(read.count("empty") && read.at("empty").empty());
+    IFE_CHECK(read.count("absent") == 0);
+
+    // Every key read alone agrees with the full read
+    std::vector<std::string> keys;
+    for (auto&& attribute : slide.attributes) keys.push_back(attribute.first);
+    const auto all = __ATTRIBUTES.read_attributes(slide.file.data(), keys);
+    IFE_CHECK(all.size() == slide.attributes.size());
+    for (auto&& attribute : slide.attributes)
+        IFE_CHECK(all.count(attribute.first) && all.at(attribute.first) == attribute.second);
+
+    // Without a directory the keyed read is refused
+    auto plain = make_file(false);
+    IFE_CHECK(validate_file_structure(plain.file.data(), plain.file.size()) == IRIS_SUCCESS);
+    bool threw = false;
+    try {get_attributes(plain.file).read_attributes(plain.file.data(), {"stain"});}
+    catch (const std::exception&) {threw = true;}
+    IFE_CHECK(threw);
+}
+
+void test_invalid_directory() {
+    {   // Entries out of hash order
+        auto slide = make_file();
+        std::vector<BYTE> first (ATTRIBUTE_DIRECTORY_ENTRY::SIZE);
+        BYTE* a = slide.file.data() + entry_offset(slide, 0);
+        BYTE* b = slide.file.data() + entry_offset(slide, 1);
+        std::memcpy(first.data(), a, first.size());
+        std::memcpy(a, b, first.size());
+        std::memcpy(b, first.data(), first.size());
+        IFE_CHECK(validate_file_structure(slide.file.data(), slide.file.size()) & IRIS_FAILURE);
+    }
+    {   // An entry locating another key than the one hashed
+        auto slide = make_file();
+        const Offset key_offset = entry_offset(slide, 2) + ATTRIBUTE_DIRECTORY_ENTRY::KEY_OFFSET;
+        uint32_t key = 0;
+        std::memcpy(&key, slide.file.data() + key_offset, sizeof(key));
+        key += 1;
+        std::memcpy(slide.file.data() + key_offset, &key, sizeof(key));
+        IFE_CHECK(validate_file_structure(slide.file.data(), slide.file.size()) & IRIS_FAILURE);
+    }
+    {   // A value beyond the attributes byte array
+        auto slide = make_file();
+        const uint32_t size = UINT32_MAX / 2;
+        std::memcpy(slide.file.data() + entry_offset(slide, 0) + ATTRIBUTE_DIRECTORY_ENTRY::VALUE_SIZE,
+                    &size, sizeof(size));
+        IFE_CHECK(validate_file_structure(slide.file.data(), slide.file.size()) & IRIS_FAILURE);
+    }
+    {   // Fewer entries than attributes
+        auto slide = make_file();
+        const uint32_t entries = uint32_t(slide.attributes.size() - 1);
+        std::memcpy(slide.file.data() + slide.directory + ATTRIBUTES_DIRECTORY::ENTRY_NUMBER,
+                    &entries, sizeof(entries));
+        IFE_CHECK(validate_file_structure(slide.file.data(), slide.file.size()) & IRIS_FAILURE);
+    }
+    {   // A directory accompanying compressed attributes
+        auto slide = make_file();
+        IFE_CHECK(validate_file_structure(slide.file.data(), slide.file.size()) == IRIS_SUCCESS);
+        slide.file[slide.attributesOffset + ATTRIBUTES::COMPRESSION] = TEXT_LZ_DICTIONARY;
+        IFE_CHECK(validate_file_structure(slide.file.data(), slide.file.size()) & IRIS_FAILURE);
+        bool threw = false;
+        try {get_attributes(slide.file).read_directory(slide.file.data());}
+        catch (const std::exception&) {threw = true;}
+        IFE_CHECK(threw);
+    }
+}
+
+} // namespace
+
+int main() {
+    try {
+        test_store_and_validate();
+        test_directory_entries();
+        test_keyed_read();
+        test_invalid_directory();
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "ife_attributes_directory_tests: %s\n", e.what());
+        return 1;
+    }
+
+    if (g_failures == 0) {
+        std::printf("ife_attributes_directory_tests: ALL PASS\n");
+        return 0;
+    }
+    std::fprintf(stderr, "ife_attributes_directory_tests: %d FAILURE(S)\n", g_failures);
+    return 1;
+}
@@ -0,0 +1,115 @@
+/**
+ * @file ife_c_abi_fixture.cpp
+ * @brief In-memory slide written for the C interface tests (ife_c_abi_tests.c).
+ *
+ * The C tests cannot reach the C++ serialization entry methods, so the slide
+ * is written here and handed across as a plain byte buffer: two layers (1x1
+ * and 2x2 tiles; the final tile sparse) and a few attributes, optionally
+ * compressed.
+ */
+#include "IrisTypes.hpp"
+#include "IrisCodecTypes.hpp"
+#include "IrisCodecExtension.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <vector>
+
+using namespace IrisCodec;
+using namespace IrisCodec::Serialization;
+
+extern "C" uint8_t* ife_test_make_slide (int compressed, uint64_t* size);
+extern "C" void     ife_test_free_slide (uint8_t* slide);
+
+uint8_t* ife_test_make_slide (int compressed, uint64_t* size)
+{
+    constexpr uint32_t TILE_BYTES = 40;
+    try {
+        std::vector<BYTE> file (FILE_HEADER::HEADER_SIZE);
+        auto append = [&file](Size bytes) {
+            const Offset offset = file.size();
+            file.resize(offset + bytes);
+            return offset;
+        };
+
+        LayerExtents extents (2);
+        Abstraction::TileTable::Layers layers (2);
+        for (uint32_t LI = 0; LI < 2; ++LI) {
+            extents[LI].xTiles      = 1u << LI;
+            extents[LI].yTiles      = 1u << LI;
+            extents[LI].scale       = float(1u << LI);
+            extents[LI].downsample  = float(2u >> LI);
+            const uint32_t tiles    = extents[LI].xTiles * extents[LI].yTiles;
+            for (uint32_t TI = 0; TI < tiles; ++TI) {
+                if (LI == 1 && TI == tiles - 1) {
+                    layers[LI].push_back({IrisCodec::NULL_OFFSET, 0});
+                    continue;
+                }
+                const Offset offset = append(TILE_BYTES);
+                std::memset(file.data() + offset, int(LI * 16 + TI + 1), TILE_BYTES);
+                layers[LI].push_back({offset, TILE_BYTES});
+            }
+        }
+        const Offset extents_at = append(SIZE_EXTENTS(extents));
+        STORE_EXTENTS           (file.data(), extents_at, extents);
+        const Offset offsets_at = append(SIZE_TILE_OFFSETS(layers));
+        STORE_TILE_OFFSETS      (file.data(), offsets_at, layers);
+
+        TileTableCreateInfo table;
+        table.tileTableOffset   = append(TILE_TABLE::HEADER_SIZE);
+        table.encoding          = TILE_ENCODING_JPEG;
+        table.format            = FORMAT_R8G8B8;
+        table.tilesOffset       = offsets_at;
+        table.layerExtentsOffset= extents_at;
+        table.layers            = 2;
+        table.widthPixels       = 512;
+        table.heightPixels      = 512;
+        STORE_TILE_TABLE        (file.data(), table);
+
+        Attributes attributes;
+        attributes.type         = METADATA_I2S;
+        attributes.version      = 1;
+        attributes["scanner"]   = u8"test";
+        attributes["stain"]     = u8"H&E";
+        attributes["barcode"]   = u8"S-0001-A";
+        const auto compression  = compressed ? TEXT_LZ_DICTIONARY : TEXT_UNCOMPRESSED;
+        AttributesCreateInfo attribute_info;
+        attribute_info.attributesOffset = append(ATTRIBUTES::HEADER_SIZE);
+        attribute_info.type     = attributes.type;
+        attribute_info.version  = attributes.version;
+        attribute_info.compression = compression;
+        attribute_info.sizes    = append(SIZE_ATTRIBUTES_SIZES(attributes));
+        attribute_info.bytes    = append(SIZE_ATTRIBUTES_BYTES(attributes, compression));
+        STORE_ATTRIBUTES_SIZES  (file.data(), attribute_info.sizes, attributes);
+        STORE_ATTRIBUTES_BYTES  (file.data(), attribute_info.bytes, attributes, compression);
+        STORE_ATTRIBUTES        (file.data(), attribute_info);
+
+        MetadataCreateInfo metadata;
+        metadata.metadataOffset = append(METADATA::HEADER_SIZE);
+        metadata.codecVersion   = {1, 0, 0};
+        metadata.attributes     = attribute_info.attributesOffset;
+        metadata.micronsPerPixel= 0.25f;
+        metadata.magnification  = 40.f;
+        STORE_METADATA          (file.data(), metadata);
+
+        HeaderCreateInfo header;
+        header.fileSize         = file.size();
+        header.revision         = 1;
+        header.tileTableOffset  = table.tileTableOffset;
+        header.metadataOffset   = metadata.metadataOffset;
+        STORE_FILE_HEADER       (file.data(), header);
+
+        auto slide = static_cast<uint8_t*>(std::malloc(file.size()));
+        if (slide) std::memcpy(slide, file.data(), file.size());
+        *size = file.size();
+        return slide;
+    } catch (const std::exception&) {
+        return nullptr;
+    }
+}
+void ife_test_free_slide (uint8_t* slide)
+{
+    std::free(slide);
+}
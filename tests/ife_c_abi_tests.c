@@ -0,0 +1,242 @@
+/**
+ * @file ife_c_abi_tests.c
+ * @brief Tests of the C interface (IrisFileExtension.h), compiled as C.
+ *
+ * Opens an in-memory slide (written by ife_c_abi_fixture.cpp) with
+ * ife_file_open and checks that tile index entries, tile byte spans and
+ * uncompressed attribute views point into the mapped file; that compressed
+ * attributes are viewed within the handle; that sparse tiles and absent
+ * attributes return IFE_STATUS_NOT_FOUND; and that bad arguments and files
+ * return their status and set ife_last_error.
+ *
+ * Self-contained (no external test framework) so CI doesn't need extra deps.
+ * Run with `ctest` or directly; non-zero exit on failure.
+ */
+#include "IrisFileExtension.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+uint8_t* ife_test_make_slide (int compressed, uint64_t* size);
+void     ife_test_free_slide (uint8_t* slide);
+
+static int g_failures = 0;
+
+#define IFE_CHECK(cond) do { \
+    if (!(cond)) { \
+        fprintf(stderr, "FAIL: %s (%s:%d)\n", #cond, __FILE__, __LINE__); \
+        ++g_failures; \
+    } \
+} while (0)
+
+/* True if the span lies within the mapped file */
+static int within (const uint8_t* base, uint64_t size, const void* data, uint64_t bytes)
+{
+    const uint8_t* ptr = (const uint8_t*)data;
+    return ptr >= base && ptr <= base + size && bytes <= (uint64_t)(base + size - ptr);
+}
+
+static int has_error (void)
+{
+    const char* message = ife_last_error();
+    return message != NULL && message[0] != '\0';
+}
+
+static void test_tiles (void)
+{
+    uint64_t size = 0;
+    uint8_t* slide = ife_test_make_slide(0, &size);
+    IFE_File file = NULL;
+    IFE_TileTable table;
+    const IFE_Layer* layers = NULL;
+    const IFE_Tile* tiles = NULL;
+    uint64_t layer_count = 0, tile_count = 0, index = 0;
+    IFE_Bytes bytes;
+    uint32_t layer = 0, tile = 0;
+
+    IFE_CHECK(slide != NULL);
+    if (slide == NULL) return;
+    IFE_CHECK(ife_abi_version() == IFE_C_ABI_VERSION);
+    IFE_CHECK(ife_validate(slide, size) == IFE_STATUS_SUCCESS);
+    IFE_CHECK(ife_file_open(slide, size, &file) == IFE_STATUS_SUCCESS);
+    IFE_CHECK(file != NULL);
+    if (file == NULL) {ife_test_free_slide(slide); return;}
+
+    IFE_CHECK(ife_file_tile_table(file, &table) == IFE_STATUS_SUCCESS);
+    IFE_CHECK(table.layers == 2 && table.tiles == 5 && table.encrypted == 0);
+    IFE_CHECK(table.mip_tail_offset == IFE_NULL_OFFSET);
+    IFE_CHECK(ife_file_layers(file, &layers, &layer_count) == IFE_STATUS_SUCCESS);
+    IFE_CHECK(layer_count == 2);
+    IFE_CHECK(layers[0].x_tiles == 1 && layers[0].first_tile == 0);
+    IFE_CHECK(layers[1].x_tiles == 2 && layers[1].y_tiles == 2 && layers[1].first_tile == 1);
+    IFE_CHECK(layers[1].tile_width == 256 && layers[1].tile_height == 256);
+
+    /* The tile index is flat (layer-major) and locates the tiles within the mapping */
+    IFE_CHECK(ife_file_tiles(file, &tiles, &tile_count) == IFE_STATUS_SUCCESS);
+    IFE_CHECK(tile_count == table.tiles);
+    for (index = 0; index + 1 < tile_count; ++index) {
+        IFE_CHECK(tiles[index].offset != IFE_NULL_OFFSET);
+        IFE_CHECK(tiles[index].offset + tiles[index].size <= size);
+    }
+    IFE_CHECK(tiles[tile_count - 1].offset == IFE_NULL_OFFSET);
+
+    /* Tile spans are the stored bytes within the mapping, not copies */
+    for (layer = 0; layer < layer_count; ++layer)
+        for (tile = 0; tile < layers[layer].x_tiles * layers[layer].y_tiles; ++tile) {
+            const IFE_Tile* entry = &tiles[layers[layer].first_tile + tile];
+            const IFE_Status status = ife_file_tile_bytes(file, layer, tile, &bytes);
+            if (entry->offset == IFE_NULL_OFFSET) {
+                IFE_CHECK(status == IFE_STATUS_NOT_FOUND);
+                IFE_CHECK(bytes.data == NULL && bytes.size == 0);
+                continue;
+            }
+            IFE_CHECK(status == IFE_STATUS_SUCCESS);
+            IFE_CHECK(bytes.data == slide + entry->offset);
+            IFE_CHECK(bytes.size == entry->size);
+            IFE_CHECK(within(slide, size, bytes.data, bytes.size));
+            IFE_CHECK(bytes.data[0] == (uint8_t)(layer * 16 + tile + 1));
+        }
+
+    /* Indices beyond the arrays */
+    IFE_CHECK(ife_file_tile_bytes(file, 2, 0, &bytes) == IFE_STATUS_OUT_OF_RANGE);
+    IFE_CHECK(has_error() && strstr(ife_last_error(), "layer") != NULL);
+    IFE_CHECK(ife_file_tile_bytes(file, 1, 4, &bytes) == IFE_STATUS_OUT_OF_RANGE);
+    IFE_CHECK(has_error() && strstr(ife_last_error(), "tile") != NULL);
+
+    ife_file_close(file);
+    ife_test_free_slide(slide);
+}
+
+static void test_attributes (void)
+{
+    int compressed = 0;
+    for (compressed = 0; compressed < 2; ++compressed) {
+        uint64_t size = 0;
+        uint8_t* slide = ife_test_make_slide(compressed, &size);
+        IFE_File file = NULL;
+        const IFE_Attribute* attributes = NULL;
+        uint64_t count = 0, index = 0;
+        IFE_String value;
+
+        IFE_CHECK(slide != NULL);
+        if (slide == NULL) return;
+        IFE_CHECK(ife_file_open(slide, size, &file) == IFE_STATUS_SUCCESS);
+        if (file == NULL) {ife_test_free_slide(slide); return;}
+
+        /* Sorted by key */
+        IFE_CHECK(ife_file_attributes(file, &attributes, &count) == IFE_STATUS_SUCCESS);
+        IFE_CHECK(count == 3);
+        for (index = 0; index + 1 < count; ++index) {
+            const IFE_String* a = &attributes[index].key;
+            const IFE_String* b = &attributes[index + 1].key;
+            const int order = memcmp(a->data, b->data, a->size < b->size ? a->size : b->size);
+            IFE_CHECK(order < 0 || (order == 0 && a->size < b->size));
+        }
+
+        IFE_CHECK(ife_file_attribute(file, "stain", 5, &value) == IFE_STATUS_SUCCESS);
+        IFE_CHECK(value.size == 3 && memcmp(value.data, "H&E", 3) == 0);
+        IFE_CHECK(ife_file_attribute(file, "barcode", 7, &value) == IFE_STATUS_SUCCESS);
+        IFE_CHECK(value.size == 8 && memcmp(value.data, "S-0001-A", 8) == 0);
+        if (compressed) {
+            /* Decoded copies are owned by the handle and NUL terminated */
+            IFE_CHECK(!within(slide, size, value.data, value.size));
+            IFE_CHECK(value.data[value.size] == '\0');
+        } else {
+            /* Uncompressed views point at the key / value runs within the mapping */
+            IFE_CHECK(within(slide, size, value.data, value.size));
+            for (index = 0; index < count; ++index) {
+                IFE_CHECK(within(slide, size, attributes[index].key.data, attributes[index].key.size));
+                IFE_CHECK(within(slide, size, attributes[index].value.data, attributes[index].value.size));
+                IFE_CHECK(attributes[index].value.data ==
+                          attributes[index].key.data + attributes[index].key.size);
+            }
+        }
+
+        /* Absent keys, including a prefix of a present key */
+        IFE_CHECK(ife_file_attribute(file, "objective", 9, &value) == IFE_STATUS_NOT_FOUND);
+        IFE_CHECK(value.data == NULL && value.size == 0);
+        IFE_CHECK(ife_file_attribute(file, "stai", 4, &value) == IFE_STATUS_NOT_FOUND);
+        IFE_CHECK(ife_file_attribute(file, NULL, 0, &value) == IFE_STATUS_NOT_FOUND);
+
+        ife_file_close(file);
+        ife_test_free_slide(slide);
+    }
+}
+
+static void test_bad_arguments (void)
+{
+    uint64_t size = 0;
+    uint8_t* slide = ife_test_make_slide(0, &size);
+    IFE_File file = NULL;
+    IFE_Header header;
+    IFE_Bytes bytes;
+    IFE_String value;
+    const IFE_Tile* tiles = NULL;
+    uint64_t count = 0;
+    uint8_t junk[64];
+
+    IFE_CHECK(slide != NULL);
+    if (slide == NULL) return;
+
+    IFE_CHECK(ife_file_open(NULL, size, &file) == IFE_STATUS_INVALID_ARGUMENT);
+    IFE_CHECK(has_error() && strstr(ife_last_error(), "ife_file_open") != NULL);
+    IFE_CHECK(ife_file_open(slide, size, NULL) == IFE_STATUS_INVALID_ARGUMENT);
+    IFE_CHECK(ife_validate(NULL, size) == IFE_STATUS_INVALID_ARGUMENT);
+    IFE_CHECK(has_error() && strstr(ife_last_error(), "ife_validate") != NULL);
+
+    /* Not a slide file: the handle is cleared and the reason recorded */
+    memset(junk, 0x5A, sizeof(junk));
+    file = (IFE_File)junk;
+    IFE_CHECK(ife_file_open(junk, sizeof(junk), &file) == IFE_STATUS_FAILURE);
+    IFE_CHECK(file == NULL);
+    IFE_CHECK(has_error());
+
+    /* A truncated file fails to abstract */
+    IFE_CHECK(ife_file_open(slide, size / 2, &file) == IFE_STATUS_FAILURE);
+    IFE_CHECK(file == NULL);
+    IFE_CHECK(has_error());
+    IFE_CHECK(ife_validate(slide, size / 2) == IFE_STATUS_FAILURE);
+
+    /* NULL handles and outputs */
+    IFE_CHECK(ife_file_header(NULL, &header) == IFE_STATUS_INVALID_ARGUMENT);
+    IFE_CHECK(has_error() && strstr(ife_last_error(), "ife_file_header") != NULL);
+    IFE_CHECK(ife_file_tiles(NULL, &tiles, &count) == IFE_STATUS_INVALID_ARGUMENT);
+    IFE_CHECK(has_error() && strstr(ife_last_error(), "ife_file_tiles") != NULL);
+    IFE_CHECK(ife_file_tile_bytes(NULL, 0, 0, &bytes) == IFE_STATUS_INVALID_ARGUMENT);
+    IFE_CHECK(has_error() && strstr(ife_last_error(), "ife_file_tile_bytes") != NULL);
+    IFE_CHECK(ife_file_attribute(NULL, "stain", 5, &value) == IFE_STATUS_INVALID_ARGUMENT);
+    IFE_CHECK(has_error() && strstr(ife_last_error(), "ife_file_attribute") != NULL);
+
+    IFE_CHECK(ife_file_open(slide, size, &file) == IFE_STATUS_SUCCESS);
+    if (file != NULL) {
+        IFE_CHECK(ife_file_header(file, &header) == IFE_STATUS_SUCCESS);
+        IFE_CHECK(header.file_size == size);
+        IFE_CHECK(ife_file_tiles(file, NULL, &count) == IFE_STATUS_INVALID_ARGUMENT);
+        IFE_CHECK(ife_file_tiles(file, &tiles, NULL) == IFE_STATUS_INVALID_ARGUMENT);
+        IFE_CHECK(ife_file_tile_bytes(file, 0, 0, NULL) == IFE_STATUS_INVALID_ARGUMENT);
+        IFE_CHECK(ife_file_attribute(file, NULL, 5, &value) == IFE_STATUS_INVALID_ARGUMENT);
+        IFE_CHECK(ife_file_attribute(file, "stain", 5, NULL) == IFE_STATUS_INVALID_ARGUMENT);
+        IFE_CHECK(ife_file_annotation_bytes(file, 0, &bytes) == IFE_STATUS_OUT_OF_RANGE);
+        IFE_CHECK(has_error() && strstr(ife_last_error(), "row") != NULL);
+        ife_file_close(file);
+    }
+    /* Closing a NULL handle is a no-op */
+    ife_file_close(NULL);
+    ife_test_free_slide(slide);
+}
+
+int main (void)
+{
+    test_tiles();
+    test_attributes();
+    test_bad_arguments();
+
+    if (g_failures == 0) {
+        printf("ife_c_abi_tests: ALL PASS\n");
+        return 0;
+    }
+    fprintf(stderr, "ife_c_abi_tests: %d FAILURE(S)\n", g_failures);
+    return 1;
+}
@@ -0,0 +1,314 @@
+/**
+ * @file ife_cipher_tests.cpp
+ * @brief Known answer and round-trip tests for the AES-GCM tile cipher.
+ *
+ * Checks the FIPS-197 AES block and NIST SP 800-38D (GCM specification test
+ * cases 1-4 and 13-16) AES-128 / AES-256 GCM vectors on the portable T-table
+ * and 4-bit GHASH path and, where the processor supports it, on the AES-NI /
+ * PCLMULQDQ path; that both paths agree for every message and additional data
+ * length about the four block stride; and that a tile encrypted with
+ * encrypt_tile fails decrypt_tile once its tag, nonce or ciphertext is altered
+ * or once it is read at another plane, layer or tile index.
+ *
+ * Self-contained (no external test framework) so CI doesn't need extra deps.
+ * Run with `ctest` or directly; non-zero exit on failure.
+ */
+#include "IFE_Cipher.hpp"
+#include "IrisTypes.hpp"
+#include "IrisCodecTypes.hpp"
+#include "IrisCodecExtension.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace IrisCodec;
+using IrisCodec::Abstraction::Cipher;
+using IrisCodec::Abstraction::CipherTile;
+
+int g_failures = 0;
+
+#define IFE_CHECK(cond) do { \
+    if (!(cond)) { \
+        std::fprintf(stderr, "FAIL: %s (%s:%d)\n", #cond, __FILE__, __LINE__); \
+        ++g_failures; \
+    } \
+} while (0)
+
+using Bytes = std::vector<std::uint8_t>;
+
+Bytes hex (const char* text) {
+    Bytes bytes;
+    for (size_t index = 0; text[index] && text[index + 1]; index += 2)
+        bytes.push_back(std::uint8_t(std::stoul(std::string(text + index, 2), nullptr, 16)));
+    return bytes;
+}
+
+struct GcmVector {
+    const char* name;
+    const char* key;
+    const char* nonce;
+    const char* plaintext;
+    const char* aad;
+    const char* ciphertext;
+    const char* tag;
+};
+
+#define GCM_K1 "feffe9928665731c6d6a8f9467308308"
+#define GCM_IV "cafebabefacedbaddecaf888"
+#define GCM_P  "d9313225f88406e5a55909c5aff5269a86a7a9531534f7da2e4c303d8a318a72" \
+               "1c3c0c95956809532fcf0e2449a6b525b16aedf5aa0de657ba637b391aafd255"
+#define GCM_P60 "d9313225f88406e5a55909c5aff5269a86a7a9531534f7da2e4c303d8a318a72" \
+               "1c3c0c95956809532fcf0e2449a6b525b16aedf5aa0de657ba637b39"
+#define GCM_A  "feedfacedeadbeeffeedfacedeadbeefabaddad2"
+
+// The GCM specification test cases adopted by NIST SP 800-38D validation
+const GcmVector GCM_VECTORS[] = {
+    {"AES-128 case 1", "00000000000000000000000000000000", "000000000000000000000000", "", "",
+     "", "58e2fccefa7e3061367f1d57a4e7455a"},
+    {"AES-128 case 2", "00000000000000000000000000000000", "000000000000000000000000",
+     "00000000000000000000000000000000", "",
+     "0388dace60b6a392f328c2b971b2fe78", "ab6e47d42cec13bdf53a67b21257bddf"},
+    {"AES-128 case 3", GCM_K1, GCM_IV, GCM_P, "",
+     "42831ec2217774244b7221b784d0d49ce3aa212f2c02a4e035c17e2329aca12e"
+     "21d514b25466931c7d8f6a5aac84aa051ba30b396a0aac973d58e091473f5985",
+     "4d5c2af327cd64a62cf35abd2ba6fab4"},
+    {"AES-128 case 4", GCM_K1, GCM_IV, GCM_P60, GCM_A,
+     "42831ec2217774244b7221b784d0d49ce3aa212f2c02a4e035c17e2329aca12e"
+     "21d514b25466931c7d8f6a5aac84aa051ba30b396a0aac973d58e091",
+     "5bc94fbc3221a5db94fae95ae7121a47"},
+    {"AES-256 case 13", "0000000000000000000000000000000000000000000000000000000000000000",
+     "000000000000000000000000", "", "",
+     "", "530f8afbc74536b9a963b4f1c4cb738b"},
+    {"AES-256 case 14", "0000000000000000000000000000000000000000000000000000000000000000",
+     "000000000000000000000000", "00000000000000000000000000000000", "",
+     "cea7403d4d606b6e074ec5d3baf39d18", "d0d1c8a799996bf0265b98b5d48ab919"},
+    {"AES-256 case 15", GCM_K1 GCM_K1, GCM_IV, GCM_P, "",
+     "522dc1f099567d07f47f37a32a84427d643a8cdcbfe5c0c97598a2bd2555d1aa"
+     "8cb08e48590dbb3da7b08b1056828838c5f61e6393ba7a0abcc9f662898015ad",
+     "b094dac5d93471bdec1a502270e3cc6c"},
+    {"AES-256 case 16", GCM_K1 GCM_K1, GCM_IV, GCM_P60, GCM_A,
+     "522dc1f099567d07f47f37a32a84427d643a8cdcbfe5c0c97598a2bd2555d1aa"
+     "8cb08e48590dbb3da7b08b1056828838c5f61e6393ba7a0abcc9f662",
+     "76fc6ece0f4e1768cddf8853bb2d551b"},
+};
+
+// The portable path always; the AES-NI / PCLMULQDQ path where supported
+std::vector<bool> cipher_paths () {
+    if (IFE::AES_GCM::hardware_supported()) return {false, true};
+    std::printf("ife_cipher_tests: AES-NI / PCLMULQDQ unsupported; portable path only\n");
+    return {false};
+}
+
+void test_aes_block() {
+    // FIPS-197 Appendix C.1 and C.3
+    const auto plaintext = hex("00112233445566778899aabbccddeeff");
+    const auto key128    = hex("000102030405060708090a0b0c0d0e0f");
+    const auto key256    = hex("000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f");
+    for (bool hardware : cipher_paths()) {
+        const IFE::AES_GCM aes128 (key128.data(), key128.size(), hardware);
+        const IFE::AES_GCM aes256 (key256.data(), key256.size(), hardware);
+        IFE_CHECK(aes128.hardware_accelerated() == hardware);
+        IFE_CHECK(aes128.rounds() == 10 && aes256.rounds() == 14);
+        std::uint8_t block [IFE::AES_BLOCK_BYTES];
+        aes128.encrypt_block(plaintext.data(), block);
+        IFE_CHECK(Bytes(block, block + 16) == hex("69c4e0d86a7b0430d8cdb78070b4c55a"));
+        aes256.encrypt_block(plaintext.data(), block);
+        IFE_CHECK(Bytes(block, block + 16) == hex("8ea2b7ca516745bfeafc49904b496089"));
+    }
+    bool threw = false;
+    try {IFE::AES_GCM(key128.data(), 24);}
+    catch (const std::exception&) {threw = true;}
+    IFE_CHECK(threw);
+}
+
+void test_gcm_vectors() {
+    for (bool hardware : cipher_paths())
+        for (auto&& vector : GCM_VECTORS) {
+            const auto key      = hex(vector.key);
+            const auto nonce    = hex(vector.nonce);
+            const auto plain    = hex(vector.plaintext);
+            const auto aad      = hex(vector.aad);
+            const auto expected = hex(vector.ciphertext);
+            const auto tag      = hex(vector.tag);
+            const IFE::AES_GCM gcm (key.data(), key.size(), hardware);
+
+            Bytes cipher (plain.size());
+            std::uint8_t out_tag [IFE::GCM_TAG_BYTES];
+            gcm.encrypt(nonce.data(), aad.data(), aad.size(), plain.data(), plain.size(), cipher.data(), out_tag);
+            if (cipher != expected || Bytes(out_tag, out_tag + 16) != tag)
+                std::fprintf(stderr, "FAIL: %s (%s path)\n", vector.name, hardware ? "AES-NI" : "portable");
+            IFE_CHECK(cipher == expected);
+            IFE_CHECK(Bytes(out_tag, out_tag + 16) == tag);
+
+            Bytes decrypted (plain.size());
+            IFE_CHECK(gcm.decrypt(nonce.data(), aad.data(), aad.size(), expected.data(), expected.size(),
+                                  decrypted.data(), tag.data()));
+            IFE_CHECK(decrypted == plain);
+
+            // In place
+            Bytes buffer = plain;
+            gcm.encrypt(nonce.data(), aad.data(), aad.size(), buffer.data(), buffer.size(), buffer.data(), out_tag);
+            IFE_CHECK(buffer == expected);
+
+            // An altered tag releases no plaintext
+            auto altered = tag;
+            altered[15] ^= 0x01;
+            decrypted.assign(plain.size(), 0xAA);
+            IFE_CHECK(!gcm.decrypt(nonce.data(), aad.data(), aad.size(), expected.data(), expected.size(),
+                                   decrypted.data(), altered.data()));
+            IFE_CHECK(decrypted == Bytes(plain.size(), 0));
+        }
+}
+
+// Lengths about the four block (64 byte) hardware stride and partial blocks
+void test_paths_agree() {
+    if (!IFE::AES_GCM::hardware_supported()) return;
+    const auto key   = hex(GCM_K1 GCM_K1);
+    const auto nonce = hex(GCM_IV);
+    const IFE::AES_GCM portable (key.data(), key.size(), false);
+    const IFE::AES_GCM hardware (key.data(), key.size(), true);
+    Bytes message (300), aad (80);
+    for (size_t index = 0; index < message.size(); ++index) message[index] = std::uint8_t(index * 7 + 3);
+    for (size_t index = 0; index < aad.size(); ++index) aad[index] = std::uint8_t(index * 13 + 1);
+    for (size_t bytes = 0; bytes <= message.size(); bytes += (bytes < 140 ? 1 : 37))
+        for (size_t aad_bytes : {size_t(0), size_t(1), size_t(16), size_t(17), size_t(64), size_t(80)}) {
+            Bytes a (bytes), b (bytes);
+            std::uint8_t tag_a [16], tag_b [16];
+            portable.encrypt(nonce.data(), aad.data(), aad_bytes, message.data(), bytes, a.data(), tag_a);
+            hardware.encrypt(nonce.data(), aad.data(), aad_bytes, message.data(), bytes, b.data(), tag_b);
+            IFE_CHECK(a == b);
+            IFE_CHECK(std::memcmp(tag_a, tag_b, 16) == 0);
+            Bytes plain (bytes);
+            IFE_CHECK(portable.decrypt(nonce.data(), aad.data(), aad_bytes, b.data(), bytes, plain.data(), tag_b));
+            IFE_CHECK(std::memcmp(plain.data(), message.data(), bytes) == 0);
+        }
+}
+
+void test_tile_round_trip() {
+    for (auto algorithm : {Abstraction::CIPHER_AES_128_GCM, Abstraction::CIPHER_AES_256_GCM}) {
+        const auto raw  = hex(GCM_K1 GCM_K1);
+        const auto key  = create_cipher_key(algorithm, raw.data(),
+                                            algorithm == Abstraction::CIPHER_AES_128_GCM ? 16 : 32);
+        Bytes tile (1000);
+        for (size_t index = 0; index < tile.size(); ++index) tile[index] = std::uint8_t(index * 31);
+        Bytes stored (tile.size() + Cipher::OVERHEAD);
+        encrypt_tile(key, {.plane = 1, .layer = 2, .tile = 3, .source = tile.data(),
+                           .size = tile.size(), .destination = stored.data()});
+        IFE_CHECK(std::memcmp(stored.data() + Cipher::NONCE_SIZE, tile.data(), tile.size()) != 0);
+
+        auto decrypt = [&](const Bytes& source, uint32_t plane, uint32_t layer, uint32_t index, Bytes& out) {
+            out.assign(tile.size(), 0xAA);
+            return decrypt_tile(key, {.plane = plane, .layer = layer, .tile = index, .source = source.data(),
+                                      .size = source.size(), .destination = out.data()});
+        };
+        Bytes out;
+        IFE_CHECK(decrypt(stored, 1, 2, 3, out) == IRIS_SUCCESS);
+        IFE_CHECK(out == tile);
+
+        // The tile location is authenticated: a swapped tile fails
+        IFE_CHECK(decrypt(stored, 1, 2, 4, out) & IRIS_FAILURE);
+        IFE_CHECK(out == Bytes(tile.size(), 0));
+        IFE_CHECK(decrypt(stored, 1, 3, 3, out) & IRIS_FAILURE);
+        IFE_CHECK(decrypt(stored, 0, 2, 3, out) & IRIS_FAILURE);
+
+        // Altered tag, nonce or ciphertext
+        for (size_t position : {stored.size() - 1, size_t(0), size_t(Cipher::NONCE_SIZE + 500)}) {
+            auto altered = stored;
+            altered[position] ^= 0x80;
+            IFE_CHECK(decrypt(altered, 1, 2, 3, out) & IRIS_FAILURE);
+            IFE_CHECK(out == Bytes(tile.size(), 0));
+        }
+
+        // Another key
+        auto other_raw = raw;
+        other_raw[0] ^= 0x01;
+        const auto other = create_cipher_key(algorithm, other_raw.data(),
+                                             algorithm == Abstraction::CIPHER_AES_128_GCM ? 16 : 32);
+        out.assign(tile.size(), 0);
+        IFE_CHECK(decrypt_tile(other, {.plane = 1, .layer = 2, .tile = 3, .source = stored.data(),
+                                       .size = stored.size(), .destination = out.data()}) & IRIS_FAILURE);
+
+        // Nonces are drawn per tile
+        Bytes again (stored.size());
+        encrypt_tile(key, {.plane = 1, .layer = 2, .tile = 3, .source = tile.data(),
+                           .size = tile.size(), .destination = again.data()});
+        IFE_CHECK(std::memcmp(again.data(), stored.data(), Cipher::NONCE_SIZE) != 0);
+
+        // A stored tile shorter than the cipher overhead
+        IFE_CHECK(decrypt_tile(key, {.source = stored.data(), .size = Cipher::OVERHEAD - 1,
+                                     .destination = out.data()}) & IRIS_FAILURE);
+    }
+    bool threw = false;
+    try {create_cipher_key(Abstraction::CIPHER_AES_256_GCM, hex(GCM_K1).data(), 16);}
+    catch (const std::exception&) {threw = true;}
+    IFE_CHECK(threw);
+}
+
+void test_batch_decrypt() {
+    const auto raw  = hex(GCM_K1);
+    const auto key  = create_cipher_key(Abstraction::CIPHER_AES_128_GCM, raw.data(), 16);
+    constexpr size_t TILES = 64, TILE_BYTES = 300;
+    std::vector<Bytes> tiles (TILES), stored (TILES), out (TILES);
+    for (size_t TI = 0; TI < TILES; ++TI) {
+        tiles[TI].resize(TILE_BYTES);
+        for (size_t index = 0; index < TILE_BYTES; ++index) tiles[TI][index] = std::uint8_t(index + TI);
+        stored[TI].resize(TILE_BYTES + Cipher::OVERHEAD);
+        encrypt_tile(key, {.layer = 1, .tile = uint32_t(TI), .source = tiles[TI].data(),
+                           .size = TILE_BYTES, .destination = stored[TI].data()});
+    }
+    auto batch = [&]() {
+        std::vector<Abstraction::CipherTile> batch;
+        for (size_t TI = 0; TI < TILES; ++TI) {
+            out[TI].assign(TILE_BYTES, 0xAA);
+            batch.push_back({.layer = 1, .tile = uint32_t(TI), .source = stored[TI].data(),
+                             .size = stored[TI].size(), .destination = out[TI].data()});
+        }
+        return batch;
+    };
+
+    // The default, an inline and a pool executor decrypt every tile
+    for (const auto& executor : {SharedExecutor(), inline_executor(), create_thread_pool(4)}) {
+        IFE_CHECK(decrypt_tiles(key, batch(), executor) == IRIS_SUCCESS);
+        IFE_CHECK(out == tiles);
+    }
+
+    // Failing tiles are zeroed, the others decrypted, and the lowest failing index reported
+    stored[41].back() ^= 0x01;
+    stored[7].back()  ^= 0x01;
+    const auto result = decrypt_tiles(key, batch(), create_thread_pool(4));
+    IFE_CHECK(result & IRIS_FAILURE);
+    IFE_CHECK(result.message.find("2 of 64") != std::string::npos);
+    IFE_CHECK(result.message.find("tile 7)") != std::string::npos);
+    for (size_t TI = 0; TI < TILES; ++TI)
+        IFE_CHECK(out[TI] == (TI == 7 || TI == 41 ? Bytes(TILE_BYTES, 0) : tiles[TI]));
+
+    IFE_CHECK(decrypt_tiles(Abstraction::CipherKey(), batch()) & IRIS_FAILURE);
+}
+
+} // namespace
+
+int main() {
+    try {
+        test_aes_block();
+        test_gcm_vectors();
+        test_paths_agree();
+        test_tile_round_trip();
+        test_batch_decrypt();
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "ife_cipher_tests: %s\n", e.what());
+        return 1;
+    }
+
+    if (g_failures == 0) {
+        std::printf("ife_cipher_tests: ALL PASS\n");
+        return 0;
+    }
+    std::fprintf(stderr, "ife_cipher_tests: %d FAILURE(S)\n", g_failures);
+    return 1;
+}
@@ -0,0 +1,232 @@
+/**
+ * @file ife_footprint_tests.cpp
+ * @brief Checks memory_footprint against the bytes actually allocated.
+ *
+ * Global operator new / delete are instrumented to count the live bytes
+ * requested from the allocator. A slide with attributes (hash nodes, heap and
+ * small strings), associated images (tree nodes) and a tile table (vectors) is
+ * abstracted on the heap and the live bytes it holds are compared with the
+ * reported footprint. The node sizes within memory_footprint model the
+ * libstdc++ / libc++ layouts; the estimate shall fall within
+ * FOOTPRINT_TOLERANCE of the measured bytes.
+ *
+ * Self-contained (no external test framework) so CI doesn't need extra deps.
+ * Run with `ctest` or directly; non-zero exit on failure.
+ */
+#include "IrisTypes.hpp"
+#include "IrisCodecTypes.hpp"
+#include "IrisCodecExtension.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::atomic<long long>  g_live      {0};
+std::atomic<bool>       g_tracking  {false};
+// Allocation header; preserves the fundamental alignment of the returned pointer
+constexpr size_t        STASH       = alignof(std::max_align_t);
+
+} // namespace
+
+void* operator new (size_t bytes)
+{
+    auto block = static_cast<char*>(std::malloc(bytes + STASH));
+    if (!block) throw std::bad_alloc();
+    *reinterpret_cast<size_t*>(block) = bytes;
+    if (g_tracking.load(std::memory_order_relaxed))
+        g_live.fetch_add(static_cast<long long>(bytes), std::memory_order_relaxed);
+    return block + STASH;
+}
+void operator delete (void* ptr) noexcept
+{
+    if (!ptr) return;
+    auto block = static_cast<char*>(ptr) - STASH;
+    if (g_tracking.load(std::memory_order_relaxed))
+        g_live.fetch_sub(static_cast<long long>(*reinterpret_cast<size_t*>(block)), std::memory_order_relaxed);
+    std::free(block);
+}
+void operator delete (void* ptr, size_t) noexcept
+{
+    operator delete (ptr);
+}
+
+namespace {
+
+using namespace IrisCodec;
+using namespace IrisCodec::Serialization;
+using IrisCodec::NULL_OFFSET;
+
+int g_failures = 0;
+
+#define IFE_CHECK(cond) do { \
+    if (!(cond)) { \
+        std::fprintf(stderr, "FAIL: %s (%s:%d)\n", #cond, __FILE__, __LINE__); \
+        ++g_failures; \
+    } \
+} while (0)
+
+// Permitted deviation of the estimate from the measured bytes (fraction of the measured bytes)
+constexpr double FOOTPRINT_TOLERANCE    = 0.02;
+constexpr uint32_t LAYERS               = 4;
+constexpr uint32_t TILE_BYTES           = 48;
+
+Offset append (std::vector<BYTE>& file, Size bytes) {
+    const Offset offset = file.size();
+    file.resize(offset + bytes);
+    return offset;
+}
+
+std::vector<BYTE> make_file () {
+    std::vector<BYTE> file (FILE_HEADER::HEADER_SIZE);
+
+    LayerExtents extents;
+    Abstraction::TileTable::Layers layers (LAYERS);
+    for (uint32_t LI = 0; LI < LAYERS; ++LI) {
+        LayerExtent extent;
+        extent.xTiles       = 1u << LI;
+        extent.yTiles       = 1u << LI;
+        extent.scale        = float(1u << LI);
+        extent.downsample   = float(1u << (LAYERS - 1 - LI));
+        extents.push_back(extent);
+        for (uint32_t TI = 0; TI < extent.xTiles * extent.yTiles; ++TI)
+            layers[LI].push_back({append(file, TILE_BYTES), TILE_BYTES});
+    }
+    const Offset extents_at = append(file, SIZE_EXTENTS(extents));
+    STORE_EXTENTS           (file.data(), extents_at, extents);
+    const Offset offsets_at = append(file, SIZE_TILE_OFFSETS(layers));
+    STORE_TILE_OFFSETS      (file.data(), offsets_at, layers);
+
+    TileTableCreateInfo table;
+    table.tileTableOffset   = append(file, TILE_TABLE::HEADER_SIZE);
+    table.encoding          = TILE_ENCODING_JPEG;
+    table.format            = FORMAT_R8G8B8;
+    table.tilesOffset       = offsets_at;
+    table.layerExtentsOffset= extents_at;
+    table.layers            = LAYERS;
+    table.widthPixels       = 256u << (LAYERS - 1);
+    table.heightPixels      = 256u << (LAYERS - 1);
+    STORE_TILE_TABLE        (file.data(), table);
+
+    // Titles beyond the small string buffer are held on the heap
+    AssociatedImageCreateInfo images;
+    std::vector<BYTE> image (300, 0x5A);
+    for (auto&& title : {std::string("label"), std::string("macro_image_of_the_whole_slide_glass")}) {
+        ImageBytesCreateInfo bytes {.offset = file.size(), .title = title, .data = image.data(), .dataBytes = image.size()};
+        append              (file, SIZE_IMAGES_BYTES(bytes));
+        STORE_IMAGES_BYTES  (file.data(), bytes);
+        AssociatedImageInfo info;
+        info.title          = title;
+        info.width          = 20;
+        info.height         = 15;
+        info.encoding       = IMAGE_ENCODING_PNG;
+        info.sourceFormat   = FORMAT_R8G8B8;
+        images.images.push_back({.offset = bytes.offset, .info = info});
+    }
+    images.offset           = file.size();
+    append                  (file, SIZE_IMAGES_ARRAY(images));
+    STORE_IMAGES_ARRAY      (file.data(), images);
+
+    // Short and long keys and values
+    Attributes attributes;
+    attributes.type         = METADATA_I2S;
+    attributes.version      = 1;
+    for (int AI = 0; AI < 40; ++AI)
+        attributes["attribute_key_" + std::to_string(AI)] = std::u8string(size_t(AI) * 3, u8'v');
+    attributes["id"]        = u8"short";
+    AttributesCreateInfo attribute_info;
+    attribute_info.attributesOffset = append(file, ATTRIBUTES::HEADER_SIZE);
+    attribute_info.type     = attributes.type;
+    attribute_info.version  = attributes.version;
+    attribute_info.sizes    = append(file, SIZE_ATTRIBUTES_SIZES(attributes));
+    attribute_info.bytes    = append(file, SIZE_ATTRIBUTES_BYTES(attributes));
+    STORE_ATTRIBUTES_SIZES  (file.data(), attribute_info.sizes, attributes);
+    STORE_ATTRIBUTES_BYTES  (file.data(), attribute_info.bytes, attributes);
+    STORE_ATTRIBUTES        (file.data(), attribute_info);
+
+    MetadataCreateInfo metadata;
+    metadata.metadataOffset = append(file, METADATA::HEADER_SIZE);
+    metadata.codecVersion   = {1, 0, 0};
+    metadata.attributes     = attribute_info.attributesOffset;
+    metadata.images         = images.offset;
+    metadata.micronsPerPixel= 0.25f;
+    metadata.magnification  = 40.f;
+    STORE_METADATA          (file.data(), metadata);
+
+    HeaderCreateInfo header;
+    header.fileSize         = file.size();
+    header.revision         = 1;
+    header.tileTableOffset  = table.tileTableOffset;
+    header.metadataOffset   = metadata.metadataOffset;
+    STORE_FILE_HEADER       (file.data(), header);
+    return file;
+}
+
+bool within_tolerance (long long measured, Size estimated) {
+    const double deviation = double(estimated) - double(measured);
+    return measured > 0 && (deviation < 0 ? -deviation : deviation) <= FOOTPRINT_TOLERANCE * double(measured);
+}
+
+void test_file_footprint (std::vector<BYTE>& file) {
+    const auto executor = inline_executor();
+    (void)abstract_file_structure(file.data(), file.size(), executor);
+
+    g_live = 0;
+    g_tracking = true;
+    auto abstraction = new Abstraction::File(abstract_file_structure(file.data(), file.size(), executor));
+    g_tracking = false;
+    const long long measured = g_live;
+
+    const auto footprint = memory_footprint(*abstraction);
+    std::printf("File: measured %lld bytes, footprint %zu bytes\n", measured, size_t(footprint.total()));
+    IFE_CHECK(within_tolerance(measured, footprint.total()));
+    IFE_CHECK(footprint.total() == abstraction->footprint.total());
+    IFE_CHECK(footprint.images && footprint.attributes && footprint.tileTable && footprint.metadata);
+    delete abstraction;
+}
+
+void test_lazy_footprint (std::vector<BYTE>& file) {
+    (void)abstract_file_structure_lazy(file.data(), file.size());
+
+    g_live = 0;
+    g_tracking = true;
+    auto lazy = new Abstraction::LazyFile(abstract_file_structure_lazy(file.data(), file.size()));
+    (void)*lazy->attributes;
+    (void)*lazy->images;
+    (void)*lazy->ICC_profile;
+    (void)*lazy->annotations;
+    (void)*lazy->annotationLOD;
+    g_tracking = false;
+    const long long measured = g_live;
+
+    const auto footprint = memory_footprint(*lazy);
+    std::printf("LazyFile: measured %lld bytes, footprint %zu bytes\n", measured, size_t(footprint.total()));
+    IFE_CHECK(within_tolerance(measured, footprint.total()));
+    delete lazy;
+}
+
+} // namespace
+
+int main() {
+    try {
+        auto file = make_file();
+        test_file_footprint(file);
+        test_lazy_footprint(file);
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "ife_footprint_tests: %s\n", e.what());
+        return 1;
+    }
+
+    if (g_failures == 0) {
+        std::printf("ife_footprint_tests: ALL PASS\n");
+        return 0;
+    }
+    std::fprintf(stderr, "ife_footprint_tests: %d FAILURE(S)\n", g_failures);
+    return 1;
+}
@@ -0,0 +1,333 @@
+/**
+ * @file ife_mip_tail_tests.cpp
+ * @brief Round-trip tests for the packed mip tail (coarsest layers) of a tile table.
+ *
+ * Writes in-memory slides with and without a mip tail and checks that full
+ * validation, the streaming validator and the tile table read agree on the
+ * tail range; that STORE_MIP_TAIL repacks the coarsest layers of an existing
+ * slide; that replacing a tail tile repacks the whole tail at the end of the
+ * file while replacing any other tile leaves it in place; and that tails not
+ * enclosing their layers' tiles are refused.
+ *
+ * Self-contained (no external test framework) so CI doesn't need extra deps.
+ * Run with `ctest` or directly; non-zero exit on failure.
+ */
+#include "IrisTypes.hpp"
+#include "IrisCodecTypes.hpp"
+#include "IrisCodecExtension.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <vector>
+
+namespace {
+
+using namespace IrisCodec;
+using namespace IrisCodec::Serialization;
+using IrisCodec::NULL_OFFSET;
+
+int g_failures = 0;
+
+#define IFE_CHECK(cond) do { \
+    if (!(cond)) { \
+        std::fprintf(stderr, "FAIL: %s (%s:%d)\n", #cond, __FILE__, __LINE__); \
+        ++g_failures; \
+    } \
+} while (0)
+
+constexpr uint32_t LAYERS       = 3;
+constexpr uint32_t TAIL_LAYERS  = 2;        // 1x1 and 2x2 tiles: at most 4 tiles each
+constexpr uint32_t TAIL_TILES   = 1 + 4;
+constexpr uint32_t TILE_BYTES   = 48;
+
+struct TailFile {
+    std::vector<BYTE>   file;
+    Offset              table       = NULL_OFFSET;
+    Abstraction::TileTable::Layers layers;
+};
+
+BYTE tile_byte (uint32_t layer, uint32_t tile) {
+    return BYTE(layer * 32 + tile + 1);
+}
+
+// Three layers (1x1, 2x2, 4x4 tiles). With a tail, the tiles of the two
+// coarsest layers are stored contiguously and the range is recorded.
+TailFile make_file (bool tail, uint32_t tail_layers = TAIL_LAYERS) {
+    TailFile slide;
+    auto& file              = slide.file;
+    file.resize(FILE_HEADER::HEADER_SIZE);
+    auto append = [&file](Size bytes) {
+        const Offset offset = file.size();
+        file.resize(offset + bytes);
+        return offset;
+    };
+
+    LayerExtents extents;
+    slide.layers.resize(LAYERS);
+    for (uint32_t LI = 0; LI < LAYERS; ++LI) {
+        LayerExtent extent;
+        extent.xTiles       = 1u << LI;
+        extent.yTiles       = 1u << LI;
+        extent.scale        = float(1u << LI);
+        extent.downsample   = float(1u << (LAYERS - 1 - LI));
+        extents.push_back(extent);
+    }
+    // Interleave a fine layer tile ahead of the coarse layers without a tail
+    if (!tail) slide.layers[LAYERS - 1].push_back({append(TILE_BYTES), TILE_BYTES});
+    const Offset tail_at    = file.size();
+    for (uint32_t LI = 0; LI < LAYERS; ++LI)
+        for (uint32_t TI = uint32_t(slide.layers[LI].size()); TI < extents[LI].xTiles * extents[LI].yTiles; ++TI) {
+            const Offset offset = append(TILE_BYTES);
+            slide.layers[LI].push_back({offset, TILE_BYTES});
+        }
+    for (uint32_t LI = 0; LI < LAYERS; ++LI)
+        for (uint32_t TI = 0; TI < slide.layers[LI].size(); ++TI) {
+            const auto& tile = slide.layers[LI][TI];
+            std::fill(file.begin() + tile.offset, file.begin() + tile.offset + tile.size, tile_byte(LI, TI));
+        }
+    const Offset extents_at = append(SIZE_EXTENTS(extents));
+    STORE_EXTENTS           (file.data(), extents_at, extents);
+    const Offset offsets_at = append(SIZE_TILE_OFFSETS(slide.layers));
+    STORE_TILE_OFFSETS      (file.data(), offsets_at, slide.layers);
+
+    TileTableCreateInfo table;
+    table.tileTableOffset   = append(TILE_TABLE::HEADER_SIZE);
+    table.encoding          = TILE_ENCODING_JPEG;
+    table.format            = FORMAT_R8G8B8;
+    table.tilesOffset       = offsets_at;
+    table.layerExtentsOffset= extents_at;
+    table.layers            = LAYERS;
+    table.widthPixels       = 256u << (LAYERS - 1);
+    table.heightPixels      = 256u << (LAYERS - 1);
+    if (tail) {
+        table.mipTailOffset = tail_at;
+        table.mipTailSize   = TAIL_TILES * TILE_BYTES;
+        table.mipTailLayers = tail_layers;
+    }
+    STORE_TILE_TABLE        (file.data(), table);
+    slide.table             = table.tileTableOffset;
+
+    MetadataCreateInfo metadata;
+    metadata.metadataOffset = append(METADATA::HEADER_SIZE);
+    metadata.codecVersion   = {1, 0, 0};
+    metadata.micronsPerPixel= 0.25f;
+    metadata.magnification  = 40.f;
+    STORE_METADATA          (file.data(), metadata);
+
+    HeaderCreateInfo header;
+    header.fileSize         = file.size();
+    header.revision         = 1;
+    header.tileTableOffset  = table.tileTableOffset;
+    header.metadataOffset   = metadata.metadataOffset;
+    STORE_FILE_HEADER       (file.data(), header);
+    return slide;
+}
+
+Result stream_validate (const std::vector<BYTE>& file) {
+    StreamValidator validator;
+    for (size_t offset = 0; offset < file.size(); offset += 37)
+        validator.push(file.data() + offset, std::min<size_t>(37, file.size() - offset));
+    return validator.finish();
+}
+
+uint32_t file_revision (const std::vector<BYTE>& file) {
+    uint32_t revision = 0;
+    std::memcpy(&revision, file.data() + FILE_HEADER::FILE_REVISION, sizeof(revision));
+    return revision;
+}
+
+// Every tile of the tail layers lies within the tail
+bool tail_encloses (const Abstraction::TileTable& table) {
+    const auto& tail = table.mipTail;
+    if (tail.offset == NULL_OFFSET || tail.layers > table.layers.size()) return false;
+    for (uint32_t LI = 0; LI < tail.layers; ++LI)
+        for (auto&& tile : table.layers[LI])
+            if (tile.offset < tail.offset || tile.offset + tile.size > tail.offset + tail.size) return false;
+    return true;
+}
+
+bool holds (const std::vector<BYTE>& file, const Abstraction::TileEntry& tile, BYTE value) {
+    return std::all_of(file.begin() + tile.offset, file.begin() + tile.offset + tile.size,
+                       [value](BYTE byte) {return byte == value;});
+}
+
+void test_store_and_read() {
+    auto slide = make_file(true);
+    IFE_CHECK(validate_file_structure(slide.file.data(), slide.file.size()) == IRIS_SUCCESS);
+    IFE_CHECK(stream_validate(slide.file) == IRIS_SUCCESS);
+
+    const auto abstraction = abstract_file_structure(slide.file.data(), slide.file.size());
+    const auto& tail = abstraction.tileTable.mipTail;
+    IFE_CHECK(tail.offset == FILE_HEADER::HEADER_SIZE);
+    IFE_CHECK(tail.size == TAIL_TILES * TILE_BYTES);
+    IFE_CHECK(tail.layers == TAIL_LAYERS);
+    IFE_CHECK(tail_encloses(abstraction.tileTable));
+
+    // A slide without a tail reads an empty one
+    auto plain = make_file(false);
+    IFE_CHECK(validate_file_structure(plain.file.data(), plain.file.size()) == IRIS_SUCCESS);
+    const auto read = abstract_file_structure(plain.file.data(), plain.file.size());
+    IFE_CHECK(read.tileTable.mipTail.offset == NULL_OFFSET);
+    IFE_CHECK(read.tileTable.mipTail.layers == 0);
+}
+
+void test_store_mip_tail() {
+    LayerExtents extents (LAYERS);
+    for (uint32_t LI = 0; LI < LAYERS; ++LI)
+        extents[LI].xTiles = extents[LI].yTiles = 1u << LI;
+    IFE_CHECK(MIP_TAIL_LAYERS(extents, 0) == 0);
+    IFE_CHECK(MIP_TAIL_LAYERS(extents, 1) == 1);
+    IFE_CHECK(MIP_TAIL_LAYERS(extents, 4) == TAIL_LAYERS);
+    IFE_CHECK(MIP_TAIL_LAYERS(extents, 16) == LAYERS);
+
+    auto slide = make_file(false);
+    auto& file = slide.file;
+    const Size size = file.size();
+    MipTailCreateInfo info;
+    info.maxLayerTiles = 4;
+    file.resize(size + SIZE_MIP_TAIL(file.data(), size, info));
+    IFE_CHECK(STORE_MIP_TAIL(file.data(), size, info) == file.size());
+    IFE_CHECK(validate_file_structure(file.data(), file.size()) == IRIS_SUCCESS);
+    IFE_CHECK(stream_validate(file) == IRIS_SUCCESS);
+    IFE_CHECK(file_revision(file) == 2);
+
+    const auto table = abstract_file_structure(file.data(), file.size()).tileTable;
+    IFE_CHECK(table.mipTail.offset == size);
+    IFE_CHECK(table.mipTail.size == TAIL_TILES * TILE_BYTES);
+    IFE_CHECK(table.mipTail.layers == TAIL_LAYERS);
+    IFE_CHECK(tail_encloses(table));
+    for (uint32_t LI = 0; LI < LAYERS; ++LI)
+        for (uint32_t TI = 0; TI < table.layers[LI].size(); ++TI) {
+            IFE_CHECK(holds(file, table.layers[LI][TI], tile_byte(LI, TI)));
+            // Layers outside of the tail keep their tiles in place
+            if (LI >= TAIL_LAYERS) IFE_CHECK(table.layers[LI][TI].offset == slide.layers[LI][TI].offset);
+        }
+
+    // No layer qualifies
+    info.maxLayerTiles = 0;
+    bool threw = false;
+    try {SIZE_MIP_TAIL(file.data(), file.size(), info);}
+    catch (const std::exception&) {threw = true;}
+    IFE_CHECK(threw);
+}
+
+// Replacing a tail tile appends the whole tail, replacement included
+void test_amend_tail_tile() {
+    auto slide = make_file(true);
+    auto& file = slide.file;
+    const std::vector<BYTE> payload (TILE_BYTES * 2, 0xC3);
+    TileAmendmentCreateInfo amendment;
+    amendment.tiles.push_back({1, 2, payload.data(), payload.size()});
+    const Size size = file.size();
+    file.resize(size + SIZE_TILE_AMENDMENT(file.data(), size, amendment));
+    IFE_CHECK(STORE_TILE_AMENDMENT(file.data(), size, amendment) == file.size());
+    IFE_CHECK(validate_file_structure(file.data(), file.size()) == IRIS_SUCCESS);
+    IFE_CHECK(stream_validate(file) == IRIS_SUCCESS);
+    IFE_CHECK(file_revision(file) == 2);
+
+    const auto table = abstract_file_structure(file.data(), file.size()).tileTable;
+    IFE_CHECK(table.mipTail.offset == size);
+    IFE_CHECK(table.mipTail.size == (TAIL_TILES - 1) * TILE_BYTES + payload.size());
+    IFE_CHECK(table.mipTail.layers == TAIL_LAYERS);
+    IFE_CHECK(tail_encloses(table));
+    const auto& tile = table.layers[1][2];
+    IFE_CHECK(tile.size == payload.size());
+    IFE_CHECK(holds(file, tile, 0xC3));
+    IFE_CHECK(holds(file, table.layers[0][0], tile_byte(0, 0)));
+    IFE_CHECK(holds(file, table.layers[1][3], tile_byte(1, 3)));
+    IFE_CHECK(table.layers[2][5].offset == slide.layers[2][5].offset);
+
+    // The tail describes the primary plane only
+    TileAmendmentCreateInfo plane;
+    plane.plane = 1;
+    plane.tiles.push_back({0, 0, payload.data(), payload.size()});
+    bool threw = false;
+    try {SIZE_TILE_AMENDMENT(file.data(), file.size(), plane);}
+    catch (const std::exception&) {threw = true;}
+    IFE_CHECK(threw);
+}
+
+// Replacing a tile outside of the tail leaves the tail in place
+void test_amend_other_tile() {
+    auto slide = make_file(true);
+    auto& file = slide.file;
+    const std::vector<BYTE> payload (TILE_BYTES, 0x5A);
+    TileAmendmentCreateInfo amendment;
+    amendment.tiles.push_back({2, 7, payload.data(), payload.size()});
+    const Size size = file.size();
+    file.resize(size + SIZE_TILE_AMENDMENT(file.data(), size, amendment));
+    IFE_CHECK(STORE_TILE_AMENDMENT(file.data(), size, amendment) == file.size());
+    IFE_CHECK(validate_file_structure(file.data(), file.size()) == IRIS_SUCCESS);
+
+    const auto table = abstract_file_structure(file.data(), file.size()).tileTable;
+    IFE_CHECK(table.mipTail.offset == FILE_HEADER::HEADER_SIZE);
+    IFE_CHECK(table.mipTail.size == TAIL_TILES * TILE_BYTES);
+    IFE_CHECK(table.mipTail.layers == TAIL_LAYERS);
+    IFE_CHECK(table.layers[2][7].offset == size);
+    IFE_CHECK(holds(file, table.layers[2][7], 0x5A));
+    IFE_CHECK(table.layers[1][2].offset == slide.layers[1][2].offset);
+}
+
+void test_invalid_tail() {
+    auto set_u64 = [](std::vector<BYTE>& file, Offset offset, uint64_t value) {
+        std::memcpy(file.data() + offset, &value, sizeof(value));
+    };
+    auto set_u32 = [](std::vector<BYTE>& file, Offset offset, uint32_t value) {
+        std::memcpy(file.data() + offset, &value, sizeof(value));
+    };
+    {   // A tail tile lies outside of the range
+        auto slide = make_file(true);
+        set_u64(slide.file, slide.table + TILE_TABLE::MIP_TAIL_SIZE, (TAIL_TILES - 1) * TILE_BYTES);
+        IFE_CHECK(validate_file_structure(slide.file.data(), slide.file.size()) & IRIS_FAILURE);
+    }
+    {   // The tail begins after the first tail tile
+        auto slide = make_file(true);
+        set_u64(slide.file, slide.table + TILE_TABLE::MIP_TAIL_OFFSET, FILE_HEADER::HEADER_SIZE + TILE_BYTES);
+        set_u64(slide.file, slide.table + TILE_TABLE::MIP_TAIL_SIZE, (TAIL_TILES - 1) * TILE_BYTES);
+        IFE_CHECK(validate_file_structure(slide.file.data(), slide.file.size()) & IRIS_FAILURE);
+    }
+    {   // More tail layers than slide layers, or none
+        auto slide = make_file(true);
+        set_u32(slide.file, slide.table + TILE_TABLE::MIP_TAIL_LAYERS, LAYERS + 1);
+        IFE_CHECK(validate_file_structure(slide.file.data(), slide.file.size()) & IRIS_FAILURE);
+        set_u32(slide.file, slide.table + TILE_TABLE::MIP_TAIL_LAYERS, 0);
+        IFE_CHECK(validate_file_structure(slide.file.data(), slide.file.size()) & IRIS_FAILURE);
+    }
+    {   // The tail extends beyond the end of the file
+        auto slide = make_file(true);
+        set_u64(slide.file, slide.table + TILE_TABLE::MIP_TAIL_SIZE, slide.file.size());
+        IFE_CHECK(validate_file_structure(slide.file.data(), slide.file.size()) & IRIS_FAILURE);
+    }
+    // Refused on store
+    for (uint32_t layers : {0u, LAYERS + 1}) {
+        bool threw = false;
+        try {make_file(true, layers);}
+        catch (const std::exception&) {threw = true;}
+        IFE_CHECK(threw);
+    }
+}
+
+} // namespace
+
+int main() {
+    try {
+        test_store_and_read();
+        test_store_mip_tail();
+        test_amend_tail_tile();
+        test_amend_other_tile();
+        test_invalid_tail();
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "ife_mip_tail_tests: %s\n", e.what());
+        return 1;
+    }
+
+    if (g_failures == 0) {
+        std::printf("ife_mip_tail_tests: ALL PASS\n");
+        return 0;
+    }
+    std::fprintf(stderr, "ife_mip_tail_tests: %d FAILURE(S)\n", g_failures);
+    return 1;
+}
@@ -0,0 +1,226 @@
+/**
+ * @file ife_multipart_tests.cpp
+ * @brief Unit tests for the multi-range response parsing of IFE_Multipart.
+ *
+ * Canned multipart/byteranges bodies (and single part responses) are parsed
+ * into the destinations of the requested ranges: boundary parameters, part
+ * reordering and merging, chunked delivery, the single part fallback and
+ * missing or short parts.
+ *
+ * Self-contained (no external test framework) so CI doesn't need extra deps.
+ * Run with `ctest` or directly; non-zero exit on failure.
+ */
+#include "IFE_Multipart.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace {
+
+int g_failures = 0;
+
+#define IFE_CHECK(cond) do { \
+    if (!(cond)) { \
+        std::fprintf(stderr, "FAIL: %s (%s:%d)\n", #cond, __FILE__, __LINE__); \
+        ++g_failures; \
+    } \
+} while (0)
+
+constexpr std::uint64_t FILE_BYTES = 4096;
+
+// Byte of the remote file at an offset
+std::uint8_t file_byte(std::uint64_t offset) {
+    return static_cast<std::uint8_t>(offset * 13 + 7);
+}
+std::string file_bytes(std::uint64_t offset, std::uint64_t size) {
+    std::string bytes;
+    for (std::uint64_t index = 0; index < size; ++index) bytes += char(file_byte(offset + index));
+    return bytes;
+}
+std::string part(const std::string& boundary, std::uint64_t offset, std::uint64_t size) {
+    return "--" + boundary + "\r\n"
+           "Content-Type: application/octet-stream\r\n"
+           "Content-Range: bytes " + std::to_string(offset) + "-" + std::to_string(offset + size - 1) +
+           "/" + std::to_string(FILE_BYTES) + "\r\n"
+           "\r\n" + file_bytes(offset, size) + "\r\n";
+}
+
+// Destinations of the requested ranges
+struct Request {
+    std::vector<IFE::ByteRange>             ranges;
+    std::vector<std::vector<std::uint8_t>>  buffers;
+    IFE::RangeScatter                       scatter;
+    explicit Request(std::vector<IFE::ByteRange> requested) :
+    ranges(std::move(requested)), buffers(allocate(ranges)), scatter(targets(ranges, buffers)) {}
+    bool matches() const {
+        for (std::size_t RI = 0; RI < ranges.size(); ++RI)
+            for (std::uint64_t BI = 0; BI < ranges[RI].size; ++BI)
+                if (buffers[RI][BI] != file_byte(ranges[RI].offset + BI)) return false;
+        return true;
+    }
+private:
+    static std::vector<std::vector<std::uint8_t>> allocate(const std::vector<IFE::ByteRange>& ranges) {
+        std::vector<std::vector<std::uint8_t>> buffers;
+        for (auto&& range : ranges) buffers.emplace_back(range.size, 0);
+        return buffers;
+    }
+    static std::vector<IFE::ScatterTarget> targets(const std::vector<IFE::ByteRange>& ranges,
+                                                   std::vector<std::vector<std::uint8_t>>& buffers) {
+        std::vector<IFE::ScatterTarget> targets;
+        for (std::size_t RI = 0; RI < ranges.size(); ++RI)
+            targets.push_back({ranges[RI].offset, ranges[RI].size, buffers[RI].data()});
+        return targets;
+    }
+};
+
+bool feed(IFE::MultipartParser& parser, const std::string& body, std::size_t chunk) {
+    bool valid = true;
+    for (std::size_t offset = 0; offset < body.size() && valid; offset += chunk)
+        valid = parser.feed(reinterpret_cast<const std::uint8_t*>(body.data()) + offset,
+                            std::min(chunk, body.size() - offset));
+    return valid;
+}
+
+void test_boundary_parameters() {
+    IFE_CHECK(IFE::multipart_boundary("multipart/byteranges; boundary=3d6b6a416f9b5") == "3d6b6a416f9b5");
+    IFE_CHECK(IFE::multipart_boundary("multipart/byteranges; boundary=\"quoted boundary\"") == "quoted boundary");
+    IFE_CHECK(IFE::multipart_boundary("Multipart/ByteRanges;charset=utf-8; BOUNDARY=abc ") == "abc");
+    IFE_CHECK(IFE::multipart_boundary("  multipart/byteranges ; q=1 ; boundary = xyz ; other=2") == "xyz");
+    IFE_CHECK(IFE::multipart_boundary("multipart/byteranges").empty());
+    IFE_CHECK(IFE::multipart_boundary("multipart/byteranges; boundary=").empty());
+    IFE_CHECK(IFE::multipart_boundary("multipart/mixed; boundary=abc").empty());
+    IFE_CHECK(IFE::multipart_boundary("application/octet-stream").empty());
+    IFE_CHECK(IFE::multipart_boundary("multipart/byteranges; boundary=" + std::string(71, 'b')).empty());
+    IFE_CHECK(IFE::multipart_boundary("multipart/byteranges; boundary=" + std::string(70, 'b')).size() == 70);
+}
+
+void test_content_range() {
+    IFE::ByteRange range;
+    IFE_CHECK(IFE::parse_content_range("bytes 100-199/4096", range));
+    IFE_CHECK(range.offset == 100 && range.size == 100);
+    IFE_CHECK(IFE::parse_content_range(" Bytes 0-0/*", range));
+    IFE_CHECK(range.offset == 0 && range.size == 1);
+    IFE_CHECK(!IFE::parse_content_range("bytes 200-100/4096", range));
+    IFE_CHECK(!IFE::parse_content_range("bytes 0-4096/4096", range));
+    IFE_CHECK(!IFE::parse_content_range("bytes */4096", range));
+    IFE_CHECK(!IFE::parse_content_range("items 0-9/10", range));
+    IFE_CHECK(!IFE::parse_content_range("bytes 0-9", range));
+}
+
+// Parts are scattered whatever their order and however they are chunked
+void test_multipart_body() {
+    const std::string boundary = "3d6b6a416f9b5";
+    // A preamble, parts in an order other than requested and an epilogue
+    const std::string body = "preamble to be ignored\r\n" +
+                             part(boundary, 2048, 300) + part(boundary, 10, 50) + part(boundary, 700, 64) +
+                             "--" + boundary + "--\r\nepilogue";
+    for (std::size_t chunk : {body.size(), std::size_t(1), std::size_t(7), std::size_t(64)}) {
+        Request request ({{10, 50}, {700, 64}, {2048, 300}});
+        IFE::MultipartParser parser (boundary, request.scatter);
+        IFE_CHECK(feed(parser, body, chunk));
+        IFE_CHECK(parser.finished());
+        IFE_CHECK(request.scatter.complete());
+        IFE_CHECK(request.matches());
+    }
+}
+
+// A server may merge neighboring ranges into a single part
+void test_merged_parts() {
+    const std::string boundary = "merge";
+    const std::string body = part(boundary, 100, 300) + "--" + boundary + "--\r\n";
+    Request request ({{100, 20}, {150, 50}, {380, 20}});
+    IFE::MultipartParser parser (boundary, request.scatter);
+    IFE_CHECK(feed(parser, body, 13));
+    IFE_CHECK(parser.finished());
+    IFE_CHECK(request.scatter.complete());
+    IFE_CHECK(request.matches());
+}
+
+// A server may answer a multi-range request with a single 206 part
+void test_single_part_fallback() {
+    Request request ({{100, 20}, {300, 40}});
+    IFE::ByteRange range;
+    IFE_CHECK(IFE::multipart_boundary("application/octet-stream").empty());
+    IFE_CHECK(IFE::parse_content_range("bytes 100-339/4096", range));
+    const auto body = file_bytes(range.offset, range.size);
+    request.scatter.write(range.offset, reinterpret_cast<const std::uint8_t*>(body.data()), body.size());
+    IFE_CHECK(request.scatter.complete());
+    IFE_CHECK(request.matches());
+
+    // A single part missing a requested range leaves the request incomplete
+    Request partial ({{100, 20}, {300, 40}});
+    IFE_CHECK(IFE::parse_content_range("bytes 100-199/4096", range));
+    const auto head = file_bytes(range.offset, range.size);
+    partial.scatter.write(range.offset, reinterpret_cast<const std::uint8_t*>(head.data()), head.size());
+    IFE_CHECK(!partial.scatter.complete());
+}
+
+void test_missing_part() {
+    const std::string boundary = "missing";
+    const std::string body = part(boundary, 10, 50) + "--" + boundary + "--\r\n";
+    Request request ({{10, 50}, {700, 64}});
+    IFE::MultipartParser parser (boundary, request.scatter);
+    IFE_CHECK(feed(parser, body, body.size()));
+    IFE_CHECK(parser.finished());
+    IFE_CHECK(!request.scatter.complete());
+}
+
+void test_short_part() {
+    const std::string boundary = "short";
+    // The body ends within the second part
+    std::string body = part(boundary, 10, 50) + part(boundary, 700, 64);
+    body.resize(body.size() - 30);
+    Request request ({{10, 50}, {700, 64}});
+    IFE::MultipartParser parser (boundary, request.scatter);
+    IFE_CHECK(feed(parser, body, 5));
+    IFE_CHECK(!parser.finished());
+    IFE_CHECK(!request.scatter.complete());
+
+    // A body missing its closing delimiter is not finished
+    const std::string unclosed = part(boundary, 10, 50);
+    Request whole ({{10, 50}});
+    IFE::MultipartParser open (boundary, whole.scatter);
+    IFE_CHECK(feed(open, unclosed, unclosed.size()));
+    IFE_CHECK(whole.scatter.complete());
+    IFE_CHECK(!open.finished());
+}
+
+void test_malformed_parts() {
+    const std::string boundary = "bad";
+    Request request ({{10, 50}});
+    // A part without a Content-Range cannot be placed
+    const std::string unranged = "--bad\r\nContent-Type: application/octet-stream\r\n\r\n" +
+                                 file_bytes(10, 50) + "\r\n--bad--\r\n";
+    IFE::MultipartParser parser (boundary, request.scatter);
+    IFE_CHECK(!feed(parser, unranged, unranged.size()));
+    IFE_CHECK(!parser.finished());
+
+    // Header lines are bounded
+    const std::string flooded = "--bad\r\nX-Padding: " + std::string(IFE::MULTIPART_LINE_BYTES, 'x') + "\r\n";
+    IFE::MultipartParser bounded (boundary, request.scatter);
+    IFE_CHECK(!feed(bounded, flooded, 100));
+}
+
+} // namespace
+
+int main() {
+    test_boundary_parameters();
+    test_content_range();
+    test_multipart_body();
+    test_merged_parts();
+    test_single_part_fallback();
+    test_missing_part();
+    test_short_part();
+    test_malformed_parts();
+
+    if (g_failures == 0) {
+        std::printf("ife_multipart_tests: ALL PASS\n");
+        return 0;
+    }
+    std::fprintf(stderr, "ife_multipart_tests: %d FAILURE(S)\n", g_failures);
+    return 1;
+}
@@ -0,0 +1,292 @@
+/**
+ * @file ife_patches_tests.cpp
+ * @brief Tests for multi-scale patch location and batched patch reads.
+ *
+ * Writes an in-memory slide of three layers (1x1, 2x2 and 4x4 standard tiles,
+ * one sparse) and checks that patches overhanging the layer edge keep their
+ * alignment with padding cells and the origin within the first grid tile;
+ * that a tile covered by several centers and scales is listed once, such that
+ * the batch reads fewer bytes than its patches would alone; that a sparse tile
+ * is listed but neither counted nor read; that the batch read copies each
+ * tile from the file; and that a layer beyond the tile table is refused.
+ *
+ * Self-contained (no external test framework) so CI doesn't need extra deps.
+ * Run with `ctest` or directly; non-zero exit on failure.
+ */
+#include "IrisTypes.hpp"
+#include "IrisCodecTypes.hpp"
+#include "IrisCodecExtension.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using namespace IrisCodec;
+using namespace IrisCodec::Serialization;
+using IrisCodec::NULL_OFFSET;
+
+int g_failures = 0;
+
+#define IFE_CHECK(cond) do { \
+    if (!(cond)) { \
+        std::fprintf(stderr, "FAIL: %s (%s:%d)\n", #cond, __FILE__, __LINE__); \
+        ++g_failures; \
+    } \
+} while (0)
+
+constexpr uint32_t LAYERS       = 3;
+constexpr uint32_t TILE_BYTES   = 32;
+constexpr uint32_t TILE_PIXELS  = 256;
+constexpr uint32_t SPARSE_TILE  = 12;   // Column 0, row 3 of the highest resolution layer
+constexpr uint32_t NULL_TILE    = ScalePatch::NULL_TILE;
+
+// The fill byte of a tile, distinct per layer and index
+BYTE tile_byte (uint32_t layer, uint32_t index) {
+    return BYTE(layer * 16 + index + 1);
+}
+
+// Three layers (1x1, 2x2, 4x4 tiles) of standard 256 pixel tiles; the top
+// layer is 1024 pixels square and its tile SPARSE_TILE is not stored
+std::vector<BYTE> make_slide () {
+    std::vector<BYTE> file (FILE_HEADER::HEADER_SIZE);
+    auto append = [&file](Size bytes) {
+        const Offset offset = file.size();
+        file.resize(offset + bytes);
+        return offset;
+    };
+
+    LayerExtents extents;
+    Abstraction::TileTable::Layers layers (LAYERS);
+    for (uint32_t LI = 0; LI < LAYERS; ++LI) {
+        LayerExtent extent;
+        extent.xTiles       = 1u << LI;
+        extent.yTiles       = 1u << LI;
+        extent.scale        = float(1u << LI);
+        extent.downsample   = float(1u << (LAYERS - 1 - LI));
+        extents.push_back(extent);
+        for (uint32_t TI = 0; TI < extent.xTiles * extent.yTiles; ++TI) {
+            if (LI == LAYERS - 1 && TI == SPARSE_TILE) {
+                layers[LI].push_back({NULL_OFFSET, 0});
+                continue;
+            }
+            const Offset offset = append(TILE_BYTES);
+            std::memset(file.data() + offset, tile_byte(LI, TI), TILE_BYTES);
+            layers[LI].push_back({offset, TILE_BYTES});
+        }
+    }
+    const Offset extents_at = append(SIZE_EXTENTS(extents));
+    STORE_EXTENTS           (file.data(), extents_at, extents);
+    const Offset offsets_at = append(SIZE_TILE_OFFSETS(layers));
+    STORE_TILE_OFFSETS      (file.data(), offsets_at, layers);
+
+    TileTableCreateInfo table;
+    table.tileTableOffset   = append(TILE_TABLE::HEADER_SIZE);
+    table.encoding          = TILE_ENCODING_JPEG;
+    table.format            = FORMAT_R8G8B8;
+    table.tilesOffset       = offsets_at;
+    table.layerExtentsOffset= extents_at;
+    table.layers            = LAYERS;
+    table.widthPixels       = TILE_PIXELS << (LAYERS - 1);
+    table.heightPixels      = TILE_PIXELS << (LAYERS - 1);
+    STORE_TILE_TABLE        (file.data(), table);
+
+    MetadataCreateInfo metadata;
+    metadata.metadataOffset = append(METADATA::HEADER_SIZE);
+    metadata.codecVersion   = {1, 0, 0};
+    metadata.micronsPerPixel= 0.25f;
+    metadata.magnification  = 40.f;
+    STORE_METADATA          (file.data(), metadata);
+
+    HeaderCreateInfo header;
+    header.fileSize         = file.size();
+    header.revision         = 1;
+    header.tileTableOffset  = table.tileTableOffset;
+    header.metadataOffset   = metadata.metadataOffset;
+    STORE_FILE_HEADER       (file.data(), header);
+    return file;
+}
+
+// The batch tile at a grid cell: its layer and index, or NULL_TILE padding
+std::pair<uint32_t, uint32_t> cell (const PatchBatch& batch, const ScalePatch& patch, size_t CI) {
+    const auto slot = patch.tiles[CI];
+    if (slot == NULL_TILE) return {NULL_TILE, NULL_TILE};
+    if (slot >= batch.tiles.size()) return {NULL_TILE - 1, NULL_TILE - 1};
+    return {batch.tiles[slot].layer, batch.tiles[slot].index};
+}
+
+void test_edge_padding() {
+    auto file = make_slide();
+    const auto table = abstract_file_structure(file.data(), file.size()).tileTable;
+    const std::vector<PatchScale> scales = {{.layer = 2}, {.layer = 0}};
+
+    // A center at the origin: each patch overhangs the top left by half a patch
+    auto batch = locate_patches(table, {{0.f, 0.f}}, scales);
+    IFE_CHECK(batch.patches.size() == 1 && batch.patches[0].size() == 2);
+    for (auto&& patch : batch.patches[0]) {
+        IFE_CHECK(patch.x == -128 && patch.y == -128);
+        IFE_CHECK(patch.column == -1 && patch.row == -1);
+        IFE_CHECK(patch.columns == 2 && patch.rows == 2);
+        IFE_CHECK(patch.xOffset == 128 && patch.yOffset == 128);
+        IFE_CHECK(patch.tiles.size() == 4);
+        if (patch.tiles.size() != 4) continue;
+        IFE_CHECK(patch.tiles[0] == NULL_TILE);
+        IFE_CHECK(patch.tiles[1] == NULL_TILE);
+        IFE_CHECK(patch.tiles[2] == NULL_TILE);
+        IFE_CHECK(cell(batch, patch, 3) == std::make_pair(patch.layer, 0u));
+    }
+    IFE_CHECK(batch.tiles.size() == 2);
+    IFE_CHECK(batch.tileBytes == 2 * TILE_BYTES && batch.patchBytes == 2 * TILE_BYTES);
+
+    // A center near the bottom right: the patch overhangs the far edges
+    batch = locate_patches(table, {{1000.f, 1000.f}}, {{.layer = 2}});
+    IFE_CHECK(batch.patches.size() == 1 && batch.patches[0].size() == 1);
+    const auto& far = batch.patches[0][0];
+    IFE_CHECK(far.x == 872 && far.y == 872);
+    IFE_CHECK(far.column == 3 && far.row == 3);
+    IFE_CHECK(far.columns == 2 && far.rows == 2);
+    IFE_CHECK(far.xOffset == 104 && far.yOffset == 104);
+    IFE_CHECK(far.tiles.size() == 4);
+    if (far.tiles.size() == 4) {
+        IFE_CHECK(cell(batch, far, 0) == std::make_pair(2u, 15u));
+        IFE_CHECK(far.tiles[1] == NULL_TILE);
+        IFE_CHECK(far.tiles[2] == NULL_TILE);
+        IFE_CHECK(far.tiles[3] == NULL_TILE);
+    }
+    IFE_CHECK(batch.tiles.size() == 1);
+
+    // A center off the right edge of a half-scale layer pads that side only
+    batch = locate_patches(table, {{1000.f, 500.f}}, {{.layer = 1, .width = 128, .height = 128}});
+    const auto& side = batch.patches[0][0];
+    IFE_CHECK(side.x == 436 && side.y == 186);
+    IFE_CHECK(side.column == 1 && side.row == 0);
+    IFE_CHECK(side.columns == 2 && side.rows == 2);
+    IFE_CHECK(side.xOffset == 180 && side.yOffset == 186);
+    if (side.tiles.size() == 4) {
+        IFE_CHECK(cell(batch, side, 0) == std::make_pair(1u, 1u));
+        IFE_CHECK(side.tiles[1] == NULL_TILE);
+        IFE_CHECK(cell(batch, side, 2) == std::make_pair(1u, 3u));
+        IFE_CHECK(side.tiles[3] == NULL_TILE);
+    } else IFE_CHECK(side.tiles.size() == 4);
+}
+
+void test_shared_tiles() {
+    auto file = make_slide();
+    const auto table = abstract_file_structure(file.data(), file.size()).tileTable;
+
+    // Two nearby centers at two scales: each patch covers a 2x2 grid and the
+    // centers cover the same grids, so each tile is listed once
+    const std::vector<PatchCenter> centers = {{512.f, 512.f}, {520.f, 512.f}};
+    const std::vector<PatchScale> scales = {{.layer = 2}, {.layer = 1}};
+    const auto batch = locate_patches(table, centers, scales);
+    IFE_CHECK(batch.patches.size() == 2);
+
+    std::set<std::pair<uint32_t, uint32_t>> listed;
+    for (auto&& tile : batch.tiles) {
+        IFE_CHECK(listed.emplace(tile.layer, tile.index).second);
+        IFE_CHECK(tile.bytes == nullptr);
+    }
+    IFE_CHECK(batch.tiles.size() == 8);
+    IFE_CHECK(listed == (std::set<std::pair<uint32_t, uint32_t>>
+        {{2, 5}, {2, 6}, {2, 9}, {2, 10}, {1, 0}, {1, 1}, {1, 2}, {1, 3}}));
+    IFE_CHECK(batch.tileBytes == 8 * TILE_BYTES);
+    IFE_CHECK(batch.patchBytes == 16 * TILE_BYTES);
+    IFE_CHECK(batch.tileBytes < batch.patchBytes);
+
+    // Both centers reference the same slots of the batch
+    for (size_t SI = 0; SI < scales.size() && batch.patches.size() == 2; ++SI) {
+        const auto& first  = batch.patches[0][SI];
+        const auto& second = batch.patches[1][SI];
+        IFE_CHECK(first.tiles == second.tiles);
+        IFE_CHECK(second.xOffset == first.xOffset + (SI ? 4u : 8u));
+    }
+
+    // A sparse tile is listed for its grid cell but counts no bytes
+    const auto sparse = locate_patches(table, {{128.f, 896.f}}, {{.layer = 2}});
+    IFE_CHECK(sparse.tiles.size() == 1);
+    if (sparse.tiles.size() == 1) {
+        IFE_CHECK(sparse.tiles[0].index == SPARSE_TILE);
+        IFE_CHECK(sparse.tiles[0].entry.offset == NULL_OFFSET);
+    }
+    IFE_CHECK(sparse.patches[0][0].tiles == std::vector<uint32_t>{0});
+    IFE_CHECK(sparse.tileBytes == 0 && sparse.patchBytes == 0);
+}
+
+void test_read_patches() {
+    auto file = make_slide();
+    const auto table = abstract_file_structure(file.data(), file.size()).tileTable;
+
+    // Edge padding, shared tiles and a sparse tile in one batch
+    const std::vector<PatchCenter> centers = {{0.f, 0.f}, {512.f, 512.f}, {520.f, 512.f}, {128.f, 896.f}};
+    const std::vector<PatchScale> scales = {{.layer = 2}, {.layer = 1}};
+    const auto located = locate_patches(table, centers, scales);
+    const auto batch = read_patches(file.data(), file.size(), table, centers, scales);
+    IFE_CHECK(batch.tiles.size() == located.tiles.size());
+    IFE_CHECK(batch.tileBytes == located.tileBytes && batch.patchBytes == located.patchBytes);
+    IFE_CHECK(batch.tileBytes < batch.patchBytes);
+    for (auto&& tile : batch.tiles) {
+        IFE_CHECK(tile.bytes != nullptr);
+        if (!tile.bytes) continue;
+        if (tile.entry.offset == NULL_OFFSET) {
+            IFE_CHECK(tile.layer == 2 && tile.index == SPARSE_TILE);
+            IFE_CHECK(tile.bytes->empty());
+            continue;
+        }
+        IFE_CHECK(tile.bytes->size() == TILE_BYTES);
+        IFE_CHECK(tile.bytes->size() == TILE_BYTES &&
+                  std::memcmp(tile.bytes->data(), file.data() + tile.entry.offset, TILE_BYTES) == 0);
+        IFE_CHECK(!tile.bytes->empty() && tile.bytes->front() == tile_byte(tile.layer, tile.index));
+    }
+
+    // Each patch matches its location without a read
+    for (size_t CI = 0; CI < centers.size(); ++CI)
+        for (size_t SI = 0; SI < scales.size(); ++SI) {
+            const auto& read = batch.patches[CI][SI];
+            const auto& plan = located.patches[CI][SI];
+            IFE_CHECK(read.tiles == plan.tiles);
+            IFE_CHECK(read.xOffset == plan.xOffset && read.yOffset == plan.yOffset);
+        }
+}
+
+void test_invalid_layer() {
+    auto file = make_slide();
+    const auto table = abstract_file_structure(file.data(), file.size()).tileTable;
+    bool threw = false;
+    try {locate_patches(table, {{512.f, 512.f}}, {{.layer = LAYERS}});}
+    catch (const std::exception&) {threw = true;}
+    IFE_CHECK(threw);
+    threw = false;
+    try {read_patches(file.data(), file.size(), table, {{512.f, 512.f}}, {{.layer = 1}, {.layer = LAYERS}});}
+    catch (const std::exception&) {threw = true;}
+    IFE_CHECK(threw);
+
+    // No centers locate no patches
+    const auto empty = locate_patches(table, {}, {{.layer = 1}});
+    IFE_CHECK(empty.patches.empty() && empty.tiles.empty() && empty.patchBytes == 0);
+}
+
+} // namespace
+
+int main() {
+    try {
+        test_edge_padding();
+        test_shared_tiles();
+        test_read_patches();
+        test_invalid_layer();
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "ife_patches_tests: %s\n", e.what());
+        return 1;
+    }
+
+    if (g_failures == 0) {
+        std::printf("ife_patches_tests: ALL PASS\n");
+        return 0;
+    }
+    std::fprintf(stderr, "ife_patches_tests: %d FAILURE(S)\n", g_failures);
+    return 1;
+}
@@ -0,0 +1,152 @@
+/**
+ * @file ife_publish_once_tests.cpp
+ * @brief Stress tests for the IFE_PublishOnce slots of the remote data blocks.
+ *
+ * Concurrent readers race a single publisher (and one another) on fresh
+ * slots each round; a reader that observes a published response shall see
+ * its complete bytes. Build with IFE_TESTS_TSAN=ON to run under
+ * ThreadSanitizer, which reports any unsynchronized access to the value.
+ *
+ * Self-contained (no external test framework) so CI doesn't need extra deps.
+ * Run with `ctest` or directly; non-zero exit on failure.
+ */
+#include "IFE_PublishOnce.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+
+int g_failures = 0;
+
+#define IFE_CHECK(cond) do { \
+    if (!(cond)) { \
+        std::fprintf(stderr, "FAIL: %s (%s:%d)\n", #cond, __FILE__, __LINE__); \
+        ++g_failures; \
+    } \
+} while (0)
+
+// Stand in for a remote data block response
+struct Response {
+    std::vector<unsigned char>  data;
+};
+using Slot = IFE::PublishOnce<std::shared_ptr<const Response>>;
+
+constexpr unsigned  ROUNDS          = 200;
+constexpr size_t    RESPONSE_BYTES  = 4096;
+
+unsigned reader_count() {
+    const unsigned hw = std::thread::hardware_concurrency();
+    return hw > 2 ? (hw < 8 ? hw : 8) : 2;
+}
+
+std::shared_ptr<const Response> make_response(unsigned round) {
+    auto response = std::make_shared<Response>();
+    response->data.resize(RESPONSE_BYTES);
+    for (size_t BI = 0; BI < RESPONSE_BYTES; ++BI)
+        response->data[BI] = static_cast<unsigned char>(BI * 7 + round);
+    return response;
+}
+
+bool complete(const Response& response, unsigned round) {
+    if (response.data.size() != RESPONSE_BYTES) return false;
+    for (size_t BI = 0; BI < RESPONSE_BYTES; ++BI)
+        if (response.data[BI] != static_cast<unsigned char>(BI * 7 + round)) return false;
+    return true;
+}
+
+// Readers poll published() while a single thread publishes
+void test_readers_race_publisher() {
+    const unsigned readers = reader_count();
+    std::atomic<unsigned> torn {0}, observed {0};
+    for (unsigned round = 0; round < ROUNDS; ++round) {
+        Slot slot;
+        std::atomic<bool> go {false};
+        std::vector<std::thread> threads;
+        for (unsigned RI = 0; RI < readers; ++RI)
+            threads.emplace_back([&] {
+                while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+                for (;;) {
+                    const auto response = slot.published();
+                    if (!response) {
+                        std::this_thread::yield();
+                        continue;
+                    }
+                    if (!complete(*response, round)) ++torn;
+                    ++observed;
+                    return;
+                }
+            });
+        threads.emplace_back([&] {
+            go.store(true, std::memory_order_release);
+            slot.publish(make_response(round));
+        });
+        for (auto& t : threads) t.join();
+        IFE_CHECK(slot.ready());
+    }
+    IFE_CHECK(torn == 0);
+    IFE_CHECK(observed == ROUNDS * readers);
+}
+
+// Readers race one another to fetch; the response is produced exactly once
+void test_fetch_once() {
+    const unsigned readers = reader_count();
+    for (unsigned round = 0; round < ROUNDS; ++round) {
+        Slot slot;
+        std::atomic<unsigned> produced {0}, torn {0};
+        std::atomic<bool> go {false};
+        std::vector<std::thread> threads;
+        for (unsigned RI = 0; RI < readers; ++RI)
+            threads.emplace_back([&] {
+                while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+                const auto& response = slot.get([&] {
+                    ++produced;
+                    return make_response(round);
+                });
+                if (!response || !complete(*response, round)) ++torn;
+            });
+        go.store(true, std::memory_order_release);
+        for (auto& t : threads) t.join();
+        IFE_CHECK(produced == 1);
+        IFE_CHECK(torn == 0);
+    }
+}
+
+// A failed fetch publishes nothing and a later fetch retries
+void test_failed_fetch_retries() {
+    Slot slot;
+    bool threw = false;
+    try {
+        slot.get([]() -> std::shared_ptr<const Response> {
+            throw std::runtime_error("Failed to fetch the remote data block");
+        });
+    } catch (const std::runtime_error&) { threw = true; }
+    IFE_CHECK(threw);
+    IFE_CHECK(!slot.ready());
+    IFE_CHECK(slot.published() == nullptr);
+    const auto& response = slot.get([] { return make_response(3); });
+    IFE_CHECK(response && complete(*response, 3));
+    // A published slot is never written again
+    slot.publish(make_response(4));
+    IFE_CHECK(complete(*slot.published(), 3));
+}
+
+} // namespace
+
+int main() {
+    test_readers_race_publisher();
+    test_fetch_once();
+    test_failed_fetch_retries();
+
+    if (g_failures == 0) {
+        std::printf("ife_publish_once_tests: ALL PASS\n");
+        return 0;
+    }
+    std::fprintf(stderr, "ife_publish_once_tests: %d FAILURE(S)\n", g_failures);
+    return 1;
+}
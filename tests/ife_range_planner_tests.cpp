@@ -0,0 +1,166 @@
+/**
+ * @file ife_range_planner_tests.cpp
+ * @brief Unit tests for the link estimates and range policy of IFE_RangePlanner.
+ *
+ * Synthetic request samples (seconds = RTT + bytes / throughput) of known
+ * links are recorded one per request; the fitted RTT and throughput and the
+ * planned concurrency, merge gap and request size are checked against the
+ * values the bandwidth-delay product of each link dictates.
+ *
+ * Self-contained (no external test framework) so CI doesn't need extra deps.
+ * Run with `ctest` or directly; non-zero exit on failure.
+ */
+#include "IFE_RangePlanner.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <initializer_list>
+
+namespace {
+
+int g_failures = 0;
+
+#define IFE_CHECK(cond) do { \
+    if (!(cond)) { \
+        std::fprintf(stderr, "FAIL: %s (%s:%d)\n", #cond, __FILE__, __LINE__); \
+        ++g_failures; \
+    } \
+} while (0)
+
+constexpr std::uint64_t KiB = 1ULL << 10;
+
+bool near(double value, double expected, double tolerance = 1e-6) {
+    return std::fabs(value - expected) <= tolerance * std::fabs(expected);
+}
+
+// Record rounds of requests of the given sizes over a link of the given RTT and throughput
+void record(IFE::LinkEstimator& link, double rtt, double throughput,
+            std::initializer_list<std::uint64_t> sizes, int rounds = 20) {
+    for (int round = 0; round < rounds; ++round)
+        for (auto bytes : sizes)
+            link.record(bytes, rtt + double(bytes) / throughput);
+}
+
+void test_unmeasured() {
+    IFE::LinkEstimator link;
+    const auto estimate = link.estimate();
+    IFE_CHECK(estimate.samples == 0);
+    IFE_CHECK(estimate.rtt == IFE::DEFAULT_RTT);
+    IFE_CHECK(estimate.throughput == IFE::DEFAULT_THROUGHPUT);
+    // Without a measured request size, as many requests as permitted are kept in flight
+    const auto policy = link.policy();
+    IFE_CHECK(policy.concurrency == IFE::MAX_CONCURRENCY);
+    IFE_CHECK(policy.multirange);
+    IFE_CHECK(policy.merge_gap == IFE::MULTIPART_PART_BYTES);
+    IFE_CHECK(policy.max_request == std::uint64_t(16 * IFE::DEFAULT_RTT * IFE::DEFAULT_THROUGHPUT));
+}
+
+// WAN: 80 ms, 5 MB/s; BDP 400 KB
+void test_wan() {
+    IFE::LinkEstimator link;
+    record(link, 0.08, 5e6, {64 * KiB, 256 * KiB});
+    const auto estimate = link.estimate();
+    IFE_CHECK(estimate.samples == 40);
+    IFE_CHECK(near(estimate.rtt, 0.08));
+    IFE_CHECK(near(estimate.throughput, 5e6));
+    // The mean is of single requests, not of the batches they were issued in
+    IFE_CHECK(estimate.request > 64 * KiB && estimate.request < 256 * KiB);
+
+    const auto policy = link.policy();
+    IFE_CHECK(policy.concurrency == 3);
+    IFE_CHECK(policy.merge_gap == IFE::MULTIPART_PART_BYTES);
+    IFE_CHECK(near(double(policy.max_request), 6.4e6));
+
+    link.record_multirange(false);
+    const auto single = link.policy();
+    IFE_CHECK(!single.multirange);
+    IFE_CHECK(single.concurrency == 3);
+    IFE_CHECK(near(double(single.merge_gap), 4e5 / 3, 1e-5));
+}
+
+// LAN: 0.5 ms, 1 GB/s; BDP 500 KB filled only by many small requests in flight
+void test_lan() {
+    IFE::LinkEstimator link;
+    record(link, 0.0005, 1e9, {16 * KiB, 48 * KiB});
+    const auto estimate = link.estimate();
+    IFE_CHECK(near(estimate.rtt, 0.0005));
+    IFE_CHECK(near(estimate.throughput, 1e9));
+
+    link.record_multirange(false);
+    const auto policy = link.policy();
+    IFE_CHECK(policy.concurrency == IFE::MAX_CONCURRENCY);
+    IFE_CHECK(near(double(policy.merge_gap), 5e5 / IFE::MAX_CONCURRENCY, 1e-5));
+    IFE_CHECK(near(double(policy.max_request), 8e6));
+}
+
+// Datacenter: 0.1 ms, 100 MB/s; BDP 10 KB is below a single request
+void test_datacenter() {
+    IFE::LinkEstimator link;
+    record(link, 0.0001, 1e8, {64 * KiB, 160 * KiB});
+    link.record_multirange(false);
+    const auto policy = link.policy();
+    IFE_CHECK(policy.concurrency == 1);
+    IFE_CHECK(near(double(policy.merge_gap), 1e4));
+    IFE_CHECK(policy.max_request == IFE::MIN_REQUEST_BYTES);
+}
+
+// Older samples decay such that the estimates follow a link that changes
+void test_link_change() {
+    IFE::LinkEstimator link;
+    record(link, 0.0005, 1e9, {16 * KiB, 48 * KiB});
+    record(link, 0.08, 5e6, {64 * KiB, 256 * KiB}, 200);
+    const auto estimate = link.estimate();
+    IFE_CHECK(near(estimate.rtt, 0.08, 1e-3));
+    IFE_CHECK(near(estimate.throughput, 5e6, 1e-3));
+    IFE_CHECK(link.policy().concurrency == 3);
+}
+
+// Requests of one size cannot separate the RTT from the transfer time
+void test_single_size() {
+    IFE::LinkEstimator link;
+    record(link, 0.03, 5e6, {128 * KiB});
+    const auto estimate = link.estimate();
+    const double seconds = 0.03 + double(128 * KiB) / 5e6;
+    IFE_CHECK(near(estimate.request, double(128 * KiB)));
+    IFE_CHECK(near(estimate.rtt, seconds - double(128 * KiB) / IFE::DEFAULT_THROUGHPUT));
+    IFE_CHECK(near(estimate.rtt + estimate.request / estimate.throughput, seconds));
+}
+
+void test_invalid_samples() {
+    IFE::LinkEstimator link;
+    link.record(64 * KiB, 0);
+    link.record(64 * KiB, -1);
+    link.record(64 * KiB, std::nan(""));
+    link.record(64 * KiB, INFINITY);
+    IFE_CHECK(link.estimate().samples == 0);
+}
+
+void test_endpoints() {
+    IFE_CHECK(IFE::url_origin("https://slides.example.org:8443/a/b.iris?x=1") == "https://slides.example.org:8443");
+    IFE_CHECK(IFE::url_origin("http://host") == "http://host");
+    IFE_CHECK(IFE::url_origin("relative/path.iris") == "relative/path.iris");
+    IFE_CHECK(IFE::link_estimator("https://host/a.iris") == IFE::link_estimator("https://host/b.iris"));
+    IFE_CHECK(IFE::link_estimator("https://host/a.iris") != IFE::link_estimator("https://other/a.iris"));
+}
+
+} // namespace
+
+int main() {
+    test_unmeasured();
+    test_wan();
+    test_lan();
+    test_datacenter();
+    test_link_change();
+    test_single_size();
+    test_invalid_samples();
+    test_endpoints();
+
+    if (g_failures == 0) {
+        std::printf("ife_range_planner_tests: ALL PASS\n");
+        return 0;
+    }
+    std::fprintf(stderr, "ife_range_planner_tests: %d FAILURE(S)\n", g_failures);
+    return 1;
+}
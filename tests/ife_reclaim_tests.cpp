@@ -0,0 +1,224 @@
+/**
+ * @file ife_reclaim_tests.cpp
+ * @brief Tests of the process-wide cache reclaim protocol (register_cache, reclaim_memory).
+ *
+ * Registers caches of every priority and checks that reclaim_memory asks them
+ * in priority order (the largest first within a priority) until the requested
+ * bytes are released; that reclaimable_memory and the candidates follow each
+ * cache's cached_bytes (caches reporting none, or throwing, are not asked);
+ * and that releasing a registration during a shrink waits upon that shrink and
+ * is never followed by another call, while releasing another cache's
+ * registration from within a shrink withdraws that cache from the reclaim.
+ *
+ * Self-contained (no external test framework) so CI doesn't need extra deps.
+ * Run with `ctest` or directly; non-zero exit on failure.
+ */
+#include "IrisTypes.hpp"
+#include "IrisCodecTypes.hpp"
+#include "IrisCodecExtension.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <future>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace IrisCodec;
+
+int g_failures = 0;
+
+#define IFE_CHECK(cond) do { \
+    if (!(cond)) { \
+        std::fprintf(stderr, "FAIL: %s (%s:%d)\n", #cond, __FILE__, __LINE__); \
+        ++g_failures; \
+    } \
+} while (0)
+
+// A deadlock is reported rather than waited upon forever
+constexpr auto HANG_TIMEOUT = std::chrono::seconds(10);
+
+// Cache of a byte count releasing up to the requested bytes; shrinks are logged by name
+struct TestCache {
+    std::string             name;
+    std::atomic<Size>       bytes;
+    std::atomic<int>        shrinks     = 0;
+    std::vector<std::string>* log       = nullptr;
+    TestCache (std::string __name, Size __bytes, std::vector<std::string>* __log = nullptr) :
+    name (std::move(__name)), bytes (__bytes), log (__log) {}
+    CacheRegistration register_at (ReclaimPriority priority) {
+        ReclaimableCache cache;
+        cache.priority      = priority;
+        cache.cached_bytes  = [this]() {return bytes.load();};
+        cache.shrink        = [this](Size requested) {
+            ++shrinks;
+            if (log) log->push_back(name);
+            const Size released = std::min<Size>(requested, bytes);
+            bytes -= released;
+            return released;
+        };
+        return register_cache(std::move(cache));
+    }
+};
+
+void test_priority_order() {
+    std::vector<std::string> log;
+    TestCache last ("last", 1000, &log), small ("small", 100, &log),
+              large ("large", 300, &log), normal ("normal", 500, &log);
+    auto registrations = {
+        last.register_at(RECLAIM_LAST),
+        small.register_at(RECLAIM_FIRST),
+        normal.register_at(RECLAIM_NORMAL),
+        large.register_at(RECLAIM_FIRST),
+    };
+    IFE_CHECK(reclaimable_memory() == 1900);
+    IFE_CHECK(reclaim_memory(0) == 0);
+    IFE_CHECK(log.empty());
+
+    // The largest of the first priority, then the next, until the bytes are released
+    IFE_CHECK(reclaim_memory(350) == 350);
+    IFE_CHECK((log == std::vector<std::string>{"large", "small"}));
+    IFE_CHECK(large.bytes == 0 && small.bytes == 50);
+    IFE_CHECK(normal.shrinks == 0 && last.shrinks == 0);
+    IFE_CHECK(reclaimable_memory() == 1550);
+
+    // The emptied cache is not asked again; the costly caches are asked last
+    log.clear();
+    IFE_CHECK(reclaim_memory(100000) == 1550);
+    IFE_CHECK((log == std::vector<std::string>{"small", "normal", "last"}));
+    IFE_CHECK(reclaimable_memory() == 0);
+    log.clear();
+    IFE_CHECK(reclaim_memory(100) == 0);
+    IFE_CHECK(log.empty());
+}
+
+void test_cached_bytes() {
+    TestCache counted ("counted", 400);
+    auto registration = counted.register_at(RECLAIM_NORMAL);
+
+    // A cache reporting no bytes is not asked, even if it holds some
+    int asked = 0;
+    ReclaimableCache empty;
+    empty.priority      = RECLAIM_FIRST;
+    empty.cached_bytes  = []() {return Size(0);};
+    empty.shrink        = [&asked](Size) {++asked; return Size(64);};
+    auto empty_registration = register_cache(std::move(empty));
+
+    // A cache whose measure throws counts as empty
+    ReclaimableCache failing;
+    failing.priority    = RECLAIM_FIRST;
+    failing.cached_bytes= []() -> Size {throw std::runtime_error("unavailable");};
+    failing.shrink      = [&asked](Size) {++asked; return Size(64);};
+    auto failing_registration = register_cache(std::move(failing));
+
+    // A shrink that throws releases nothing and the next cache is asked
+    ReclaimableCache broken;
+    broken.priority     = RECLAIM_FIRST;
+    broken.cached_bytes = []() {return Size(1000);};
+    broken.shrink       = [](Size) -> Size {throw std::runtime_error("shrink failed");};
+    auto broken_registration = register_cache(std::move(broken));
+
+    IFE_CHECK(reclaimable_memory() == 1400);
+    IFE_CHECK(reclaim_memory(100) == 100);
+    IFE_CHECK(asked == 0);
+    IFE_CHECK(counted.bytes == 300 && counted.shrinks == 1);
+
+    // The bytes released are those each shrink reports
+    ReclaimableCache generous;
+    generous.priority   = RECLAIM_FIRST;
+    generous.cached_bytes = []() {return Size(10);};
+    generous.shrink     = [](Size) {return Size(5000);};
+    auto generous_registration = register_cache(std::move(generous));
+    IFE_CHECK(reclaim_memory(200) == 5000);
+    IFE_CHECK(counted.shrinks == 1);
+
+    // Caches without a shrink or a measure are refused
+    for (int missing = 0; missing < 2; ++missing) {
+        ReclaimableCache incomplete;
+        if (missing) incomplete.cached_bytes = []() {return Size(1);};
+        else incomplete.shrink = [](Size) {return Size(0);};
+        bool threw = false;
+        try {register_cache(std::move(incomplete));}
+        catch (const std::exception&) {threw = true;}
+        IFE_CHECK(threw);
+    }
+}
+
+void test_release_during_shrink() {
+    // Released from another thread while its shrink runs: the release waits for it
+    {
+        std::promise<void> entered, proceed;
+        auto resume         = proceed.get_future().share();
+        std::atomic<int> shrinks = 0;
+        ReclaimableCache cache;
+        cache.cached_bytes  = []() {return Size(100);};
+        cache.shrink        = [&](Size bytes) {
+            if (shrinks++ == 0) {
+                entered.set_value();
+                resume.wait();
+            }
+            return bytes;
+        };
+        auto registration   = register_cache(std::move(cache));
+        auto reclaim        = std::async(std::launch::async, []() {return reclaim_memory(40);});
+        entered.get_future().wait();
+
+        auto release        = std::async(std::launch::async, [&registration]() {registration.reset();});
+        IFE_CHECK(release.wait_for(std::chrono::milliseconds(100)) == std::future_status::timeout);
+        proceed.set_value();
+        IFE_CHECK(release.wait_for(HANG_TIMEOUT) == std::future_status::ready);
+        IFE_CHECK(reclaim.wait_for(HANG_TIMEOUT) == std::future_status::ready);
+        if (reclaim.valid()) IFE_CHECK(reclaim.get() == 40);
+
+        // Never called again once released
+        IFE_CHECK(reclaimable_memory() == 0);
+        IFE_CHECK(reclaim_memory(40) == 0);
+        IFE_CHECK(shrinks == 1);
+    }
+
+    // Another cache's registration released from within a shrink withdraws that cache
+    {
+        TestCache withdrawn ("withdrawn", 500), remaining ("remaining", 500);
+        CacheRegistration withdrawn_registration = withdrawn.register_at(RECLAIM_LAST);
+        auto remaining_registration = remaining.register_at(RECLAIM_NORMAL);
+        ReclaimableCache releasing;
+        releasing.priority      = RECLAIM_FIRST;
+        releasing.cached_bytes  = []() {return Size(100);};
+        releasing.shrink        = [&withdrawn_registration](Size) {
+            withdrawn_registration.reset();
+            return Size(100);
+        };
+        auto registration = register_cache(std::move(releasing));
+        IFE_CHECK(reclaimable_memory() == 1100);
+        IFE_CHECK(reclaim_memory(2000) == 600);
+        IFE_CHECK(withdrawn.shrinks == 0 && withdrawn.bytes == 500);
+        IFE_CHECK(remaining.shrinks == 1 && remaining.bytes == 0);
+    }
+    IFE_CHECK(reclaimable_memory() == 0);
+}
+
+} // namespace
+
+int main() {
+    try {
+        test_priority_order();
+        test_cached_bytes();
+        test_release_during_shrink();
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "ife_reclaim_tests: %s\n", e.what());
+        return 1;
+    }
+
+    if (g_failures == 0) {
+        std::printf("ife_reclaim_tests: ALL PASS\n");
+        return 0;
+    }
+    std::fprintf(stderr, "ife_reclaim_tests: %d FAILURE(S)\n", g_failures);
+    return 1;
+}
@@ -0,0 +1,246 @@
+/**
+ * @file ife_replication_tests.cpp
+ * @brief Round-trip tests for block manifests and block-level patches.
+ *
+ * A source revision is described by its block manifest, which is serialized
+ * and read back as a remote site would. A patch generated against it is
+ * serialized, read back and applied in place; the reconstructed file shall
+ * equal the target revision byte for byte. Revisions changing only metadata
+ * shall carry no tile bytes, and tiles moved within the file shall be kept
+ * from their source offsets. A source of the same size and revision but other
+ * content shall be refused before any byte is written.
+ *
+ * Self-contained (no external test framework) so CI doesn't need extra deps.
+ * Run with `ctest` or directly; non-zero exit on failure.
+ */
+#include "IrisTypes.hpp"
+#include "IrisCodecTypes.hpp"
+#include "IrisCodecExtension.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace IrisCodec;
+using namespace IrisCodec::Serialization;
+using IrisCodec::NULL_OFFSET;
+
+int g_failures = 0;
+
+#define IFE_CHECK(cond) do { \
+    if (!(cond)) { \
+        std::fprintf(stderr, "FAIL: %s (%s:%d)\n", #cond, __FILE__, __LINE__); \
+        ++g_failures; \
+    } \
+} while (0)
+
+constexpr uint32_t LAYERS       = 2;
+constexpr uint32_t TILE_BYTES   = 256;
+constexpr uint32_t TILES        = 1 + 4;
+
+struct Revision {
+    uint32_t    revision        = 1;
+    float       magnification   = 40.f;
+    bool        reverse         = false;    // Store the tiles in reverse order
+};
+
+// Two layers (1x1, 2x2 tiles); the bytes of each tile depend only on its index
+std::vector<BYTE> make_slide (const Revision& revision) {
+    std::vector<BYTE> file (FILE_HEADER::HEADER_SIZE);
+    auto append = [&file](Size bytes) {
+        const Offset offset = file.size();
+        file.resize(offset + bytes);
+        return offset;
+    };
+
+    LayerExtents extents;
+    Abstraction::TileTable::Layers layers (LAYERS);
+    for (uint32_t LI = 0; LI < LAYERS; ++LI) {
+        LayerExtent extent;
+        extent.xTiles       = 1u << LI;
+        extent.yTiles       = 1u << LI;
+        extent.scale        = float(1u << LI);
+        extent.downsample   = float(1u << (LAYERS - 1 - LI));
+        extents.push_back(extent);
+        layers[LI].resize(extent.xTiles * extent.yTiles);
+    }
+    for (uint32_t index = 0; index < TILES; ++index) {
+        const auto TI       = revision.reverse ? TILES - 1 - index : index;
+        auto& tile          = TI ? layers[1][TI - 1] : layers[0][0];
+        tile.offset         = append(TILE_BYTES);
+        tile.size           = TILE_BYTES;
+        for (Offset BI = 0; BI < TILE_BYTES; ++BI)
+            file[tile.offset + BI] = BYTE(TI * 31 + BI * 7);
+    }
+    const Offset extents_at = append(SIZE_EXTENTS(extents));
+    STORE_EXTENTS           (file.data(), extents_at, extents);
+    const Offset offsets_at = append(SIZE_TILE_OFFSETS(layers));
+    STORE_TILE_OFFSETS      (file.data(), offsets_at, layers);
+
+    TileTableCreateInfo table;
+    table.tileTableOffset   = append(TILE_TABLE::HEADER_SIZE);
+    table.encoding          = TILE_ENCODING_JPEG;
+    table.format            = FORMAT_R8G8B8;
+    table.tilesOffset       = offsets_at;
+    table.layerExtentsOffset= extents_at;
+    table.layers            = LAYERS;
+    table.widthPixels       = 256u << (LAYERS - 1);
+    table.heightPixels      = 256u << (LAYERS - 1);
+    STORE_TILE_TABLE        (file.data(), table);
+
+    MetadataCreateInfo metadata;
+    metadata.metadataOffset = append(METADATA::HEADER_SIZE);
+    metadata.codecVersion   = {1, 0, 0};
+    metadata.micronsPerPixel= 0.25f;
+    metadata.magnification  = revision.magnification;
+    STORE_METADATA          (file.data(), metadata);
+
+    HeaderCreateInfo header;
+    header.fileSize         = file.size();
+    header.revision         = revision.revision;
+    header.tileTableOffset  = table.tileTableOffset;
+    header.metadataOffset   = metadata.metadataOffset;
+    STORE_FILE_HEADER       (file.data(), header);
+    return file;
+}
+
+// Describe the source through its serialized manifest, as a remote site would
+Abstraction::Patch make_patch (std::vector<BYTE>& source, std::vector<BYTE>& target) {
+    const auto manifest = generate_block_manifest(source.data(), source.size());
+    const auto stream   = serialize_block_manifest(manifest);
+    const auto remote   = deserialize_block_manifest(stream.data(), stream.size());
+    const auto patch    = generate_patch(remote, target.data(), target.size());
+    const auto bytes    = serialize_patch(patch);
+    return deserialize_patch(bytes.data(), bytes.size());
+}
+
+// Apply the patch to a copy of the source and truncate it to the target size
+std::vector<BYTE> patched (std::vector<BYTE> file, const Abstraction::Patch& patch) {
+    file.resize(std::max<Size>(file.size(), patch.fileSize));
+    apply_patch(file.data(), file.size(), patch);
+    file.resize(patch.fileSize);
+    return file;
+}
+
+bool throws (const std::function<void()>& function, const char* text) {
+    try {function();}
+    catch (std::exception& error) {return std::string(error.what()).find(text) != std::string::npos;}
+    return false;
+}
+
+void test_manifest_round_trip() {
+    auto file           = make_slide({});
+    const auto manifest = generate_block_manifest(file.data(), file.size());
+    IFE_CHECK(manifest.fileSize == file.size());
+    IFE_CHECK(manifest.revision == 1);
+    IFE_CHECK(manifest.entries.size() >= TILES + 4);
+    IFE_CHECK(std::is_sorted(manifest.entries.begin(), manifest.entries.end(),
+              [](const auto& a, const auto& b) {return a.offset < b.offset;}));
+
+    const auto stream   = serialize_block_manifest(manifest);
+    const auto read     = deserialize_block_manifest(stream.data(), stream.size());
+    IFE_CHECK(read.fileSize == manifest.fileSize);
+    IFE_CHECK(read.revision == manifest.revision);
+    IFE_CHECK(read.entries.size() == manifest.entries.size());
+    for (size_t EI = 0; EI < std::min(read.entries.size(), manifest.entries.size()); ++EI) {
+        IFE_CHECK(read.entries[EI].offset == manifest.entries[EI].offset);
+        IFE_CHECK(read.entries[EI].size == manifest.entries[EI].size);
+        IFE_CHECK(read.entries[EI].hash == manifest.entries[EI].hash);
+        IFE_CHECK(read.entries[EI].type == manifest.entries[EI].type);
+    }
+    IFE_CHECK(read.fingerprint() == manifest.fingerprint());
+
+    // Any changed byte changes the fingerprint
+    file[FILE_HEADER::HEADER_SIZE + 3] ^= 0x01;
+    IFE_CHECK(generate_block_manifest(file.data(), file.size()).fingerprint() != manifest.fingerprint());
+
+    IFE_CHECK(throws([&] {deserialize_block_manifest(stream.data(), stream.size() - 1);}, "truncated"));
+    IFE_CHECK(throws([&] {deserialize_block_manifest(stream.data() + 1, stream.size() - 1);}, "invalid"));
+}
+
+// Revision 2 changes only the metadata block: every tile is kept in place
+void test_metadata_only() {
+    auto source         = make_slide({});
+    auto target         = make_slide({.revision = 2, .magnification = 20.f});
+    IFE_CHECK(source.size() == target.size());
+    const auto patch    = make_patch(source, target);
+    IFE_CHECK(patch.revision == 2);
+    IFE_CHECK(patch.sourceRevision == 1);
+    IFE_CHECK(patch.sourceSize == source.size());
+    IFE_CHECK(patch.fingerprint == generate_block_manifest(target.data(), target.size()).fingerprint());
+    IFE_CHECK(patch.literal_bytes() < TILE_BYTES);
+    for (auto&& op : patch.operations)
+        if (op.operation == Abstraction::Patch::PATCH_KEEP) IFE_CHECK(op.source != NULL_OFFSET);
+
+    const auto result   = patched(source, patch);
+    IFE_CHECK(result == target);
+    IFE_CHECK(validate_file_structure(const_cast<BYTE*>(result.data()), result.size()) == IRIS_SUCCESS);
+}
+
+// Revision 2 stores the tiles in reverse order: tiles move and are staged
+void test_moved_blocks() {
+    auto source         = make_slide({});
+    auto target         = make_slide({.revision = 2, .reverse = true});
+    const auto patch    = make_patch(source, target);
+    IFE_CHECK(patch.literal_bytes() < TILE_BYTES);
+    Offset position     = 0;
+    uint32_t moved      = 0;
+    for (auto&& op : patch.operations) {
+        if (op.operation == Abstraction::Patch::PATCH_KEEP && op.source != position) ++moved;
+        position       += op.size;
+    }
+    IFE_CHECK(moved >= TILES - 1);
+    IFE_CHECK(patched(source, patch) == target);
+}
+
+void test_wrong_source() {
+    auto source         = make_slide({});
+    auto target         = make_slide({.revision = 2, .reverse = true});
+    const auto patch    = make_patch(source, target);
+
+    // Same size and revision, other tile content
+    auto other          = source;
+    other[FILE_HEADER::HEADER_SIZE + 5] ^= 0xFF;
+    const auto before   = other;
+    IFE_CHECK(throws([&] {patched(other, patch);}, "source fingerprint"));
+    IFE_CHECK(throws([&] {apply_patch(other.data(), other.size(), patch);}, "source fingerprint"));
+    IFE_CHECK(other == before);
+
+    // Another revision
+    auto revised        = make_slide({.revision = 3});
+    IFE_CHECK(throws([&] {patched(revised, patch);}, "revision"));
+
+    // A literal altered in transit reconstructs another file
+    auto altered        = patch;
+    for (auto&& op : altered.operations)
+        if (op.operation == Abstraction::Patch::PATCH_LITERAL && op.size) {
+            op.bytes.back() ^= 0xFF;
+            break;
+        }
+    IFE_CHECK(throws([&] {patched(source, altered);}, "target fingerprint"));
+
+    const auto stream   = serialize_patch(patch);
+    IFE_CHECK(throws([&] {deserialize_patch(stream.data(), stream.size() - 1);}, "truncated"));
+}
+
+} // namespace
+
+int main() {
+    test_manifest_round_trip();
+    test_metadata_only();
+    test_moved_blocks();
+    test_wrong_source();
+
+    if (g_failures == 0) {
+        std::printf("ife_replication_tests: ALL PASS\n");
+        return 0;
+    }
+    std::fprintf(stderr, "ife_replication_tests: %d FAILURE(S)\n", g_failures);
+    return 1;
+}
@@ -0,0 +1,355 @@
+/**
+ * @file ife_stream_validator_tests.cpp
+ * @brief Unit tests for the forward-only StreamValidator.
+ *
+ * An in-memory slide is streamed in chunks of several sizes. A valid stream
+ * shall reach STREAM_VALID and finish; a truncated stream, a corrupted or
+ * mismatched RECOVERY tag, and a dangling forward reference shall fail. Block
+ * rules shared with validate_file_structure (layer extents and the tile entry
+ * count they dictate) shall fail the stream as they fail the file. Decoy block
+ * signatures within tile data are charged their bookkeeping against the
+ * retention limit.
+ *
+ * Self-contained (no external test framework) so CI doesn't need extra deps.
+ * Run with `ctest` or directly; non-zero exit on failure.
+ */
+#include "IrisTypes.hpp"
+#include "IrisCodecTypes.hpp"
+#include "IrisCodecExtension.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace IrisCodec;
+using namespace IrisCodec::Serialization;
+using IrisCodec::NULL_OFFSET;
+
+int g_failures = 0;
+
+#define IFE_CHECK(cond) do { \
+    if (!(cond)) { \
+        std::fprintf(stderr, "FAIL: %s (%s:%d)\n", #cond, __FILE__, __LINE__); \
+        ++g_failures; \
+    } \
+} while (0)
+
+constexpr uint32_t LAYERS       = 2;
+constexpr uint32_t TILE_BYTES   = 64;
+// Decoy blocks within tile data: a signature and an empty byte array
+constexpr Size     DECOY_STRIDE = ANNOTATION_BYTES::HEADER_SIZE + 2;
+
+struct Slide {
+    std::vector<BYTE>   file;
+    Offset              extents     = NULL_OFFSET;
+    Offset              firstTile   = NULL_OFFSET;
+};
+
+void store_u16 (std::vector<BYTE>& file, Offset offset, uint16_t value) {
+    std::memcpy(file.data() + offset, &value, sizeof(value));
+}
+void store_u32 (std::vector<BYTE>& file, Offset offset, uint32_t value) {
+    std::memcpy(file.data() + offset, &value, sizeof(value));
+}
+void store_u64 (std::vector<BYTE>& file, Offset offset, uint64_t value) {
+    std::memcpy(file.data() + offset, &value, sizeof(value));
+}
+
+// Two layers (1x1, 2x2 tiles; the final tile sparse) and a few attributes.
+// Tile data precedes the metadata blocks, which precede the tile table and metadata
+// referenced by the header. The first tile optionally holds decoy block signatures.
+Slide make_slide (uint32_t decoys = 0) {
+    Slide slide;
+    auto& file              = slide.file;
+    file.resize(FILE_HEADER::HEADER_SIZE);
+    auto append = [&file](Size bytes) {
+        const Offset offset = file.size();
+        file.resize(offset + bytes);
+        return offset;
+    };
+
+    LayerExtents extents;
+    Abstraction::TileTable::Layers layers (LAYERS);
+    for (uint32_t LI = 0; LI < LAYERS; ++LI) {
+        LayerExtent extent;
+        extent.xTiles       = 1u << LI;
+        extent.yTiles       = 1u << LI;
+        extent.scale        = float(1u << LI);
+        extent.downsample   = float(1u << (LAYERS - 1 - LI));
+        extents.push_back(extent);
+        for (uint32_t TI = 0; TI < extent.xTiles * extent.yTiles; ++TI) {
+            if (LI == LAYERS - 1 && TI == extent.xTiles * extent.yTiles - 1) {
+                layers[LI].push_back({NULL_OFFSET, 0});
+                continue;
+            }
+            const Size bytes    = LI == 0 && decoys ? decoys * DECOY_STRIDE : TILE_BYTES;
+            const Offset offset = append(bytes);
+            for (Offset BI = 0; BI < bytes; ++BI) file[offset + BI] = BYTE(BI * 7 % 0x50);
+            if (LI == 0 && decoys) for (uint32_t DI = 0; DI < decoys; ++DI) {
+                const Offset decoy = offset + DI * DECOY_STRIDE;
+                std::fill(file.begin() + decoy, file.begin() + decoy + DECOY_STRIDE, BYTE(0));
+                store_u64(file, decoy + DATA_BLOCK::VALIDATION, decoy);
+                store_u16(file, decoy + DATA_BLOCK::RECOVERY, RECOVER_ANNOTATION_BYTES);
+            }
+            layers[LI].push_back({offset, uint32_t(bytes)});
+        }
+    }
+    slide.firstTile         = layers[0][0].offset;
+    const Offset extents_at = append(SIZE_EXTENTS(extents));
+    STORE_EXTENTS           (file.data(), extents_at, extents);
+    slide.extents           = extents_at;
+    const Offset offsets_at = append(SIZE_TILE_OFFSETS(layers));
+    STORE_TILE_OFFSETS      (file.data(), offsets_at, layers);
+
+    Attributes attributes;
+    attributes.type         = METADATA_I2S;
+    attributes.version      = 1;
+    attributes["scanner"]   = u8"test";
+    attributes["stain"]     = u8"H&E";
+    AttributesCreateInfo attribute_info;
+    attribute_info.attributesOffset = append(ATTRIBUTES::HEADER_SIZE);
+    attribute_info.type     = attributes.type;
+    attribute_info.version  = attributes.version;
+    attribute_info.sizes    = append(SIZE_ATTRIBUTES_SIZES(attributes));
+    attribute_info.bytes    = append(SIZE_ATTRIBUTES_BYTES(attributes));
+    STORE_ATTRIBUTES_SIZES  (file.data(), attribute_info.sizes, attributes);
+    STORE_ATTRIBUTES_BYTES  (file.data(), attribute_info.bytes, attributes);
+    STORE_ATTRIBUTES        (file.data(), attribute_info);
+
+    TileTableCreateInfo table;
+    table.tileTableOffset   = append(TILE_TABLE::HEADER_SIZE);
+    table.encoding          = TILE_ENCODING_JPEG;
+    table.format            = FORMAT_R8G8B8;
+    table.tilesOffset       = offsets_at;
+    table.layerExtentsOffset= extents_at;
+    table.layers            = LAYERS;
+    table.widthPixels       = 256u << (LAYERS - 1);
+    table.heightPixels      = 256u << (LAYERS - 1);
+    STORE_TILE_TABLE        (file.data(), table);
+
+    MetadataCreateInfo metadata;
+    metadata.metadataOffset = append(METADATA::HEADER_SIZE);
+    metadata.codecVersion   = {1, 0, 0};
+    metadata.attributes     = attribute_info.attributesOffset;
+    metadata.micronsPerPixel= 0.25f;
+    metadata.magnification  = 40.f;
+    STORE_METADATA          (file.data(), metadata);
+
+    HeaderCreateInfo header;
+    header.fileSize         = file.size();
+    header.revision         = 1;
+    header.tileTableOffset  = table.tileTableOffset;
+    header.metadataOffset   = metadata.metadataOffset;
+    STORE_FILE_HEADER       (file.data(), header);
+    return slide;
+}
+
+struct Streamed {
+    Result  pushed;                 // Result of the final push
+    Size    failedAt    = 0;        // Bytes received when the stream failed
+    Size    peak        = 0;        // Peak retained bytes
+};
+
+// Push the first `length` bytes of the file in chunks of the given size
+Streamed stream (StreamValidator& validator, const std::vector<BYTE>& file,
+                 size_t chunk, Size length = ~Size(0)) {
+    Streamed streamed;
+    length = std::min<Size>(length, file.size());
+    for (Size position = 0; position < length; position += chunk) {
+        streamed.pushed = validator.push(file.data() + position, std::min<Size>(chunk, length - position));
+        streamed.peak   = std::max(streamed.peak, validator.retained());
+        if (validator.state() == StreamValidator::STREAM_INVALID) {
+            streamed.failedAt = validator.received();
+            break;
+        }
+    }
+    return streamed;
+}
+
+bool mentions (const Result& result, const char* text) {
+    return result.message.find(text) != std::string::npos;
+}
+
+void test_valid_stream() {
+    auto slide = make_slide();
+    IFE_CHECK(validate_file_structure(slide.file.data(), slide.file.size()) == IRIS_SUCCESS);
+    for (size_t chunk : {size_t(1), size_t(7), size_t(64), slide.file.size()}) {
+        StreamValidator validator;
+        const auto streamed = stream(validator, slide.file, chunk);
+        IFE_CHECK(validator.state() == StreamValidator::STREAM_VALID);
+        IFE_CHECK(streamed.peak > 0 || chunk == slide.file.size());
+        IFE_CHECK(validator.retained() == 0);
+        IFE_CHECK(validator.finish() == IRIS_SUCCESS);
+        IFE_CHECK(validator.received() == slide.file.size());
+    }
+}
+
+void test_truncated_stream() {
+    auto slide = make_slide();
+    {
+        StreamValidator validator;
+        stream(validator, slide.file, 16, FILE_HEADER::HEADER_SIZE / 2);
+        IFE_CHECK(validator.state() == StreamValidator::STREAM_PENDING);
+        const auto result = validator.finish();
+        IFE_CHECK(result & IRIS_FAILURE);
+        IFE_CHECK(mentions(result, "before the end of the file header"));
+        IFE_CHECK(validator.state() == StreamValidator::STREAM_INVALID);
+    }
+    {
+        // The final (metadata) block is cut short
+        StreamValidator validator;
+        stream(validator, slide.file, 7, slide.file.size() - 1);
+        IFE_CHECK(validator.state() == StreamValidator::STREAM_PENDING);
+        const auto result = validator.finish();
+        IFE_CHECK(result & IRIS_FAILURE);
+        IFE_CHECK(mentions(result, "differs from the encoded file size"));
+    }
+    {
+        // Bytes beyond the encoded file size
+        auto longer = slide.file;
+        longer.push_back(0);
+        StreamValidator validator;
+        const auto streamed = stream(validator, longer, longer.size());
+        IFE_CHECK(streamed.pushed & IRIS_FAILURE);
+        IFE_CHECK(mentions(streamed.pushed, "extends beyond the encoded file size"));
+    }
+}
+
+void test_bad_tag() {
+    {
+        // A RECOVERY tag of another block type at a referenced offset
+        auto slide = make_slide();
+        store_u16(slide.file, slide.extents + DATA_BLOCK::RECOVERY, RECOVER_ATTRIBUTES_BYTES);
+        StreamValidator validator;
+        const auto streamed = stream(validator, slide.file, 13);
+        IFE_CHECK(validator.state() == StreamValidator::STREAM_INVALID);
+        IFE_CHECK(mentions(streamed.pushed, "RECOVERY tag failed validation"));
+        IFE_CHECK(streamed.failedAt < slide.file.size());
+        IFE_CHECK(validator.finish() & IRIS_FAILURE);
+    }
+    {
+        // An undefined RECOVERY tag leaves the referenced block undetected
+        auto slide = make_slide();
+        store_u16(slide.file, slide.extents + DATA_BLOCK::RECOVERY, 0x55FE);
+        StreamValidator validator;
+        const auto streamed = stream(validator, slide.file, 13);
+        IFE_CHECK(validator.state() == StreamValidator::STREAM_INVALID);
+        IFE_CHECK(mentions(streamed.pushed, "no valid LAYER_EXTENTS block"));
+    }
+    {
+        // A corrupted header RECOVERY tag fails as soon as the header arrives
+        auto slide = make_slide();
+        store_u16(slide.file, FILE_HEADER::RECOVERY, RECOVER_METADATA);
+        StreamValidator validator;
+        const auto streamed = stream(validator, slide.file, 8);
+        IFE_CHECK(mentions(streamed.pushed, "RECOVER_HEADER"));
+        IFE_CHECK(streamed.failedAt <= FILE_HEADER::HEADER_SIZE + 8);
+    }
+}
+
+// The header references the metadata ahead of it; the referenced bytes are tile data
+void test_dangling_forward_reference() {
+    auto slide = make_slide();
+    store_u64(slide.file, FILE_HEADER::METADATA_OFFSET, slide.firstTile);
+    StreamValidator validator;
+    const auto streamed = stream(validator, slide.file, 5);
+    IFE_CHECK(validator.state() == StreamValidator::STREAM_INVALID);
+    IFE_CHECK(mentions(streamed.pushed, "no valid METADATA block at referenced offset"));
+    // The failure is reported once the referenced signature has passed
+    IFE_CHECK(streamed.failedAt >= slide.firstTile + DATA_BLOCK::HEADER_SIZE);
+    IFE_CHECK(streamed.failedAt < slide.firstTile + TILE_BYTES);
+    IFE_CHECK(validator.retained() == 0);
+}
+
+// Rules shared with validate_file_structure fail the stream as they fail the file
+void test_block_rules() {
+    const auto STEP = [](const Slide& slide) {
+        uint16_t step;
+        std::memcpy(&step, slide.file.data() + slide.extents + LAYER_EXTENTS::ENTRY_SIZE, sizeof(step));
+        return Offset(step);
+    };
+    {
+        // Layer scales shall increase
+        auto slide = make_slide();
+        const Offset entry = slide.extents + LAYER_EXTENTS::HEADER_SIZE;
+        const float scale  = 0.f;
+        std::memcpy(slide.file.data() + entry + LAYER_EXTENT::SCALE, &scale, sizeof(scale));
+        IFE_CHECK(validate_file_structure(slide.file.data(), slide.file.size()) & IRIS_FAILURE);
+        StreamValidator validator;
+        const auto streamed = stream(validator, slide.file, 64);
+        IFE_CHECK(validator.state() == StreamValidator::STREAM_INVALID);
+        IFE_CHECK(mentions(streamed.pushed, "LAYER_EXTENTS [0] failed validation"));
+    }
+    {
+        // Layer extents of 1 + 6 tiles located by an array of 1 + 4 tile entries
+        auto slide = make_slide();
+        const Offset entry = slide.extents + LAYER_EXTENTS::HEADER_SIZE + STEP(slide);
+        store_u32(slide.file, entry + LAYER_EXTENT::X_TILES, 3);
+        StreamValidator validator;
+        const auto streamed = stream(validator, slide.file, 64);
+        IFE_CHECK(validator.state() == StreamValidator::STREAM_INVALID);
+        IFE_CHECK(mentions(streamed.pushed, "contains 5 tile entries"));
+        IFE_CHECK(mentions(streamed.pushed, "contains 7 tiles"));
+    }
+}
+
+// Each detected block is charged its bookkeeping as well as its bytes, such that
+// many small (decoy) blocks exhaust the limit their bytes alone would not.
+void test_retention_limit() {
+    auto plain = make_slide();
+    StreamValidator baseline;
+    const auto plain_stream = stream(baseline, plain.file, 32);
+    IFE_CHECK(baseline.state() == StreamValidator::STREAM_VALID);
+
+    constexpr uint32_t DECOYS = 256;
+    auto decoyed = make_slide(DECOYS);
+    IFE_CHECK(validate_file_structure(decoyed.file.data(), decoyed.file.size()) == IRIS_SUCCESS);
+    {
+        // Decoys are not referenced: within the limit the stream remains valid
+        StreamValidator validator;
+        const auto streamed = stream(validator, decoyed.file, 32);
+        IFE_CHECK(validator.state() == StreamValidator::STREAM_VALID);
+        IFE_CHECK(validator.finish() == IRIS_SUCCESS);
+        IFE_CHECK(streamed.peak > plain_stream.peak + DECOYS * DECOY_STRIDE);
+    }
+    {
+        const Size limit = plain_stream.peak + 2 * DECOYS * DECOY_STRIDE;
+        StreamValidator validator (limit);
+        const auto streamed = stream(validator, decoyed.file, 32);
+        IFE_CHECK(validator.state() == StreamValidator::STREAM_INVALID);
+        IFE_CHECK(mentions(streamed.pushed, "exceeds the streaming retention limit"));
+        IFE_CHECK(streamed.failedAt < decoyed.firstTile + DECOYS * DECOY_STRIDE);
+        IFE_CHECK(validator.retained() == 0);
+        IFE_CHECK(validator.finish() & IRIS_FAILURE);
+    }
+    {
+        // A limit below the bookkeeping of the header references
+        StreamValidator validator (32);
+        stream(validator, plain.file, plain.file.size());
+        IFE_CHECK(validator.state() == StreamValidator::STREAM_INVALID);
+        IFE_CHECK(mentions(validator.result(), "exceeds the streaming retention limit"));
+    }
+}
+
+} // namespace
+
+int main() {
+    test_valid_stream();
+    test_truncated_stream();
+    test_bad_tag();
+    test_dangling_forward_reference();
+    test_block_rules();
+    test_retention_limit();
+
+    if (g_failures == 0) {
+        std::printf("ife_stream_validator_tests: ALL PASS\n");
+        return 0;
+    }
+    std::fprintf(stderr, "ife_stream_validator_tests: %d FAILURE(S)\n", g_failures);
+    return 1;
+}
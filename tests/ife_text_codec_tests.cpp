@@ -0,0 +1,281 @@
+/**
+ * @file ife_text_codec_tests.cpp
+ * @brief Round-trip and malformed stream tests for the dictionary LZ77 text codec.
+ *
+ * Compresses repetitive, incompressible and empty blocks with and without a
+ * dictionary and checks that they decode exactly; that matches reach back
+ * into the dictionary (and decode wrongly or fail with another one); that
+ * truncated, corrupted and mis-sized streams are refused rather than decoded;
+ * and that decompress_text rejects declared sizes a block cannot expand to.
+ *
+ * Self-contained (no external test framework) so CI doesn't need extra deps.
+ * Run with `ctest` or directly; non-zero exit on failure.
+ */
+#include "IrisTypes.hpp"
+#include "IrisCodecTypes.hpp"
+#include "IrisCodecExtension.hpp"
+#include "IFE_TextCodec.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace IrisCodec;
+
+int g_failures = 0;
+
+#define IFE_CHECK(cond) do { \
+    if (!(cond)) { \
+        std::fprintf(stderr, "FAIL: %s (%s:%d)\n", #cond, __FILE__, __LINE__); \
+        ++g_failures; \
+    } \
+} while (0)
+
+using Bytes = std::vector<uint8_t>;
+
+Bytes as_bytes (const std::string& text) {
+    return Bytes(text.begin(), text.end());
+}
+
+// Deterministic noise; no match of LZ_MIN_MATCH bytes is likely
+Bytes noise (size_t bytes, uint32_t seed) {
+    Bytes data (bytes);
+    for (auto& byte : data) {
+        seed = seed * 1664525u + 1013904223u;
+        byte = uint8_t(seed >> 24);
+    }
+    return data;
+}
+
+Bytes compress (const Bytes& dict, const Bytes& src) {
+    Bytes dst (IFE::lz_compress_bound(src.size()));
+    const size_t stored = IFE::lz_compress(dict.empty() ? nullptr : dict.data(), dict.size(),
+                                           src.data(), src.size(), dst.data());
+    dst.resize(stored);
+    return dst;
+}
+
+bool decompress (const Bytes& dict, const Bytes& src, Bytes& dst) {
+    return IFE::lz_decompress(dict.empty() ? nullptr : dict.data(), dict.size(),
+                              src.data(), src.size(), dst.data(), dst.size());
+}
+
+bool round_trips (const Bytes& dict, const Bytes& src) {
+    const Bytes compressed = compress(dict, src);
+    if (compressed.size() > IFE::lz_compress_bound(src.size())) return false;
+    Bytes decoded (src.size(), 0xCD);
+    return decompress(dict, compressed, decoded) && decoded == src;
+}
+
+std::string attribute_text (int index) {
+    return "PatientName^DOE^JANE|StudyDescription^Surgical pathology|"
+           "SpecimenDescription^Left breast core biopsy " + std::to_string(index) +
+           "|StainName^Hematoxylin and eosin|ScannerManufacturer^Example Imaging";
+}
+
+void test_round_trip() {
+    const Bytes none;
+    IFE_CHECK(IFE::lz_compress(nullptr, 0, nullptr, 0, nullptr) == 0);
+    IFE_CHECK(round_trips(none, as_bytes("a")));
+    IFE_CHECK(round_trips(none, as_bytes("abc")));
+    IFE_CHECK(round_trips(none, as_bytes("abcdabcdabcdabcdabcd")));
+    IFE_CHECK(round_trips(none, noise(5000, 7)));
+
+    // Long runs exercise the literal and match length extension bytes
+    const Bytes run (100000, 'x');
+    IFE_CHECK(round_trips(none, run));
+    IFE_CHECK(compress(none, run).size() < 1000);
+    Bytes mixed = noise(300, 11);
+    mixed.insert(mixed.end(), 700, 'y');
+    const Bytes tail = noise(600, 13);
+    mixed.insert(mixed.end(), tail.begin(), tail.end());
+    IFE_CHECK(round_trips(none, mixed));
+
+    // Incompressible input stays within the bound
+    const Bytes random = noise(70000, 17);
+    IFE_CHECK(compress(none, random).size() <= IFE::lz_compress_bound(random.size()));
+    IFE_CHECK(round_trips(none, random));
+
+    // The same inputs with a dictionary, including one beyond the window
+    const Bytes dict = as_bytes(attribute_text(0) + attribute_text(1));
+    IFE_CHECK(round_trips(dict, as_bytes("a")));
+    IFE_CHECK(round_trips(dict, as_bytes(attribute_text(2))));
+    IFE_CHECK(round_trips(dict, run));
+    IFE_CHECK(round_trips(dict, random));
+    Bytes large = noise(IFE::LZ_WINDOW + 4096, 19);
+    const Bytes text = as_bytes(attribute_text(3));
+    large.insert(large.end(), text.begin(), text.end());
+    IFE_CHECK(round_trips(large, as_bytes(attribute_text(4))));
+    IFE_CHECK(round_trips(large, random));
+}
+
+void test_dictionary_matches() {
+    const Bytes dict = as_bytes(attribute_text(0) + attribute_text(1));
+    const Bytes src  = as_bytes(attribute_text(2));
+    const Bytes plain  = compress({}, src);
+    const Bytes primed = compress(dict, src);
+    // The block shares nearly everything with the dictionary; only the
+    // matches into it can account for the difference
+    IFE_CHECK(primed.size() * 4 < plain.size());
+
+    // A block whose every match lies in the dictionary
+    Bytes decoded (src.size());
+    IFE_CHECK(decompress(dict, primed, decoded) && decoded == src);
+
+    // Without the dictionary the distances reach before the block
+    IFE_CHECK(decompress({}, primed, decoded) == false);
+
+    // A dictionary of the same size with other content decodes other bytes
+    Bytes other = dict;
+    for (auto& byte : other) byte = uint8_t(byte ^ 0x20);
+    const bool decoded_other = decompress(other, primed, decoded);
+    IFE_CHECK(decoded_other == false || decoded != src);
+
+    // Matches reach only the last LZ_WINDOW bytes of a large dictionary
+    Bytes large = as_bytes(attribute_text(5));
+    const Bytes filler = noise(IFE::LZ_WINDOW, 23);
+    large.insert(large.end(), filler.begin(), filler.end());
+    const Bytes src_far = as_bytes(attribute_text(5));
+    IFE_CHECK(compress(large, src_far).size() >= compress({}, src_far).size());
+    IFE_CHECK(round_trips(large, src_far));
+}
+
+void test_malformed_streams() {
+    const Bytes dict = as_bytes(attribute_text(0));
+    const Bytes src  = as_bytes(attribute_text(1) + attribute_text(2));
+    for (const Bytes* dictionary : {static_cast<const Bytes*>(nullptr), &dict}) {
+        const Bytes used = dictionary ? *dictionary : Bytes();
+        const Bytes compressed = compress(used, src);
+        Bytes decoded (src.size());
+        IFE_CHECK(decompress(used, compressed, decoded) && decoded == src);
+
+        // Every truncation is refused
+        int accepted = 0;
+        for (size_t bytes = 0; bytes < compressed.size(); ++bytes) {
+            const Bytes truncated (compressed.begin(), compressed.begin() + bytes);
+            if (decompress(used, truncated, decoded)) ++accepted;
+        }
+        IFE_CHECK(accepted == 0);
+
+        // Trailing bytes and mis-sized destinations are refused
+        Bytes trailing = compressed;
+        trailing.push_back(0);
+        IFE_CHECK(decompress(used, trailing, decoded) == false);
+        Bytes shorter (src.size() - 1), longer (src.size() + 1);
+        IFE_CHECK(decompress(used, compressed, shorter) == false);
+        IFE_CHECK(decompress(used, compressed, longer) == false);
+    }
+
+    Bytes decoded (8);
+    // One literal then a match of 4 at distance 0
+    IFE_CHECK(decompress({}, Bytes{0x10, 'a', 0x00, 0x00}, decoded) == false);
+    // One literal then a match of 4 at distance 2 with no dictionary
+    IFE_CHECK(decompress({}, Bytes{0x10, 'a', 0x02, 0x00}, decoded) == false);
+    // The same distance is legal once a dictionary byte precedes the block
+    const Bytes prefix = as_bytes("z");
+    Bytes five (5);
+    IFE_CHECK(decompress(prefix, Bytes{0x10, 'a', 0x02, 0x00}, five) &&
+              std::memcmp(five.data(), "azaza", 5) == 0);
+    // A distance beyond the prefix by one is refused
+    IFE_CHECK(decompress(prefix, Bytes{0x10, 'a', 0x03, 0x00}, five) == false);
+    // More literals than the stream carries
+    IFE_CHECK(decompress({}, Bytes{0x80, 'a', 'b'}, decoded) == false);
+    // A literal length extension cut short
+    IFE_CHECK(decompress({}, Bytes{0xF0, 0xFF}, decoded) == false);
+    // A match longer than the destination
+    Bytes eight (8);
+    IFE_CHECK(decompress({}, Bytes{0x1F, 'a', 0x01, 0x00, 0x10}, eight) == false);
+    // A well formed stream: one literal and a match of 7 with no final token
+    IFE_CHECK(decompress({}, Bytes{0x13, 'a', 0x01, 0x00}, eight) && eight == Bytes(8, 'a'));
+    // An empty final token after the block is complete is trailing
+    IFE_CHECK(decompress({}, Bytes{0x13, 'a', 0x01, 0x00, 0x00}, eight) == false);
+    // Nothing decodes into a non-empty destination
+    IFE_CHECK(decompress({}, Bytes{}, decoded) == false);
+}
+
+void test_text_blocks() {
+    const std::string text = attribute_text(6) + attribute_text(7);
+    const auto* bytes = reinterpret_cast<const BYTE*>(text.data());
+
+    const auto plain = compress_text(bytes, text.size());
+    IFE_CHECK(decompress_text(plain.data(), plain.size()) == text);
+
+    const auto dictionary = train_text_dictionary({attribute_text(0), attribute_text(1),
+                                                   attribute_text(2), attribute_text(3)}, 42);
+    IFE_CHECK(dictionary.bytes.size() > 0);
+    const auto primed = compress_text(bytes, text.size(), &dictionary);
+    IFE_CHECK(primed.size() < plain.size());
+    IFE_CHECK(decompress_text(primed.data(), primed.size(), &dictionary) == text);
+
+    const auto empty = compress_text(nullptr, 0);
+    IFE_CHECK(decompress_text(empty.data(), empty.size()).empty());
+
+    // A block compressed against a dictionary does not decode without it
+    bool threw = false;
+    try {decompress_text(primed.data(), primed.size());}
+    catch (const std::exception&) {threw = true;}
+    IFE_CHECK(threw);
+
+    // A frame shorter than its header
+    threw = false;
+    try {decompress_text(plain.data(), 3);}
+    catch (const std::exception&) {threw = true;}
+    IFE_CHECK(threw);
+
+    // A truncated frame
+    threw = false;
+    try {decompress_text(plain.data(), plain.size() - 1);}
+    catch (const std::exception&) {threw = true;}
+    IFE_CHECK(threw);
+
+    // A declared size no block of this length could expand to is rejected
+    // before the text is allocated
+    std::vector<BYTE> implausible = plain;
+    const uint32_t declared = UINT32_MAX;
+    std::memcpy(implausible.data(), &declared, sizeof(declared));
+    threw = false;
+    try {decompress_text(implausible.data(), implausible.size());}
+    catch (const std::exception&) {threw = true;}
+    IFE_CHECK(threw);
+    const uint32_t edge = uint32_t(implausible.size() * 255 + 1);
+    std::memcpy(implausible.data(), &edge, sizeof(edge));
+    threw = false;
+    try {decompress_text(implausible.data(), implausible.size());}
+    catch (const std::exception&) {threw = true;}
+    IFE_CHECK(threw);
+
+    // A plausible but wrong declared size fails the exact-size decode
+    const uint32_t wrong = uint32_t(text.size() + 1);
+    std::memcpy(implausible.data(), &wrong, sizeof(wrong));
+    threw = false;
+    try {decompress_text(implausible.data(), implausible.size());}
+    catch (const std::exception&) {threw = true;}
+    IFE_CHECK(threw);
+}
+
+} // namespace
+
+int main() {
+    try {
+        test_round_trip();
+        test_dictionary_matches();
+        test_malformed_streams();
+        test_text_blocks();
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "ife_text_codec_tests: %s\n", e.what());
+        return 1;
+    }
+
+    if (g_failures == 0) {
+        std::printf("ife_text_codec_tests: ALL PASS\n");
+        return 0;
+    }
+    std::fprintf(stderr, "ife_text_codec_tests: %d FAILURE(S)\n", g_failures);
+    return 1;
+}
@@ -0,0 +1,213 @@
+/**
+ * @file ife_tile_extents_tests.cpp
+ * @brief Round-trip tests for per-layer tile dimensions within the layer extents.
+ *
+ * Writes in-memory slides whose layers use standard and larger tiles and checks
+ * that full validation, the streaming validator and the tile table read agree
+ * on the stored dimensions; that entries written without tile dimensions read
+ * as standard 256 pixel tiles; and that zero dimensions are refused on store,
+ * on validation and on streaming.
+ *
+ * Self-contained (no external test framework) so CI doesn't need extra deps.
+ * Run with `ctest` or directly; non-zero exit on failure.
+ */
+#include "IrisTypes.hpp"
+#include "IrisCodecTypes.hpp"
+#include "IrisCodecExtension.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <vector>
+
+namespace {
+
+using namespace IrisCodec;
+using namespace IrisCodec::Serialization;
+using IrisCodec::NULL_OFFSET;
+
+int g_failures = 0;
+
+#define IFE_CHECK(cond) do { \
+    if (!(cond)) { \
+        std::fprintf(stderr, "FAIL: %s (%s:%d)\n", #cond, __FILE__, __LINE__); \
+        ++g_failures; \
+    } \
+} while (0)
+
+constexpr uint32_t LAYERS       = 3;
+constexpr uint32_t TILE_BYTES   = 32;
+
+struct ExtentsFile {
+    std::vector<BYTE>   file;
+    Offset              extents     = NULL_OFFSET;
+};
+
+// Layer extents entries of the version 1 size: no tile dimensions
+void store_compact_extents (BYTE* const base, Offset offset, const LayerExtents& extents) {
+    const uint64_t validation   = offset;
+    const uint16_t recovery     = RECOVER_LAYER_EXTENTS;
+    const uint16_t step         = LAYER_EXTENT::V1_0_SIZE;
+    const uint32_t entries      = uint32_t(extents.size());
+    std::memcpy(base + offset + LAYER_EXTENTS::VALIDATION,   &validation, sizeof(validation));
+    std::memcpy(base + offset + LAYER_EXTENTS::RECOVERY,     &recovery, sizeof(recovery));
+    std::memcpy(base + offset + LAYER_EXTENTS::ENTRY_SIZE,   &step, sizeof(step));
+    std::memcpy(base + offset + LAYER_EXTENTS::ENTRY_NUMBER, &entries, sizeof(entries));
+    BYTE* entry = base + offset + LAYER_EXTENTS::HEADER_SIZE;
+    for (auto&& extent : extents) {
+        std::memcpy(entry + LAYER_EXTENT::X_TILES, &extent.xTiles, sizeof(uint32_t));
+        std::memcpy(entry + LAYER_EXTENT::Y_TILES, &extent.yTiles, sizeof(uint32_t));
+        std::memcpy(entry + LAYER_EXTENT::SCALE,   &extent.scale,  sizeof(float));
+        entry += step;
+    }
+}
+
+// Three layers (1x1, 2x2, 4x4 tiles) with the given tile dimensions; compact
+// entries omit the tile dimensions as written prior to the tile extents
+ExtentsFile make_file (const TileExtents& tiles, bool compact = false) {
+    ExtentsFile slide;
+    auto& file              = slide.file;
+    file.resize(FILE_HEADER::HEADER_SIZE);
+    auto append = [&file](Size bytes) {
+        const Offset offset = file.size();
+        file.resize(offset + bytes);
+        return offset;
+    };
+
+    LayerExtents extents;
+    Abstraction::TileTable::Layers layers (LAYERS);
+    for (uint32_t LI = 0; LI < LAYERS; ++LI) {
+        LayerExtent extent;
+        extent.xTiles       = 1u << LI;
+        extent.yTiles       = 1u << LI;
+        extent.scale        = float(1u << LI);
+        extent.downsample   = float(1u << (LAYERS - 1 - LI));
+        extents.push_back(extent);
+        for (uint32_t TI = 0; TI < extent.xTiles * extent.yTiles; ++TI)
+            layers[LI].push_back({append(TILE_BYTES), TILE_BYTES});
+    }
+    slide.extents           = append(compact ?
+                                     LAYER_EXTENTS::HEADER_SIZE + LAYERS * LAYER_EXTENT::V1_0_SIZE :
+                                     SIZE_EXTENTS(extents));
+    if (compact) store_compact_extents(file.data(), slide.extents, extents);
+    else STORE_EXTENTS      (file.data(), slide.extents, extents, tiles);
+    const Offset offsets_at = append(SIZE_TILE_OFFSETS(layers));
+    STORE_TILE_OFFSETS      (file.data(), offsets_at, layers);
+
+    const TileExtent last   = tiles.size() ? tiles.back() : TileExtent();
+    TileTableCreateInfo table;
+    table.tileTableOffset   = append(TILE_TABLE::HEADER_SIZE);
+    table.encoding          = TILE_ENCODING_JPEG;
+    table.format            = FORMAT_R8G8B8;
+    table.tilesOffset       = offsets_at;
+    table.layerExtentsOffset= slide.extents;
+    table.layers            = LAYERS;
+    table.widthPixels       = uint32_t(last.width) << (LAYERS - 1);
+    table.heightPixels      = uint32_t(last.height) << (LAYERS - 1);
+    STORE_TILE_TABLE        (file.data(), table);
+
+    MetadataCreateInfo metadata;
+    metadata.metadataOffset = append(METADATA::HEADER_SIZE);
+    metadata.codecVersion   = {1, 0, 0};
+    metadata.micronsPerPixel= 0.25f;
+    metadata.magnification  = 40.f;
+    STORE_METADATA          (file.data(), metadata);
+
+    HeaderCreateInfo header;
+    header.fileSize         = file.size();
+    header.revision         = 1;
+    header.tileTableOffset  = table.tileTableOffset;
+    header.metadataOffset   = metadata.metadataOffset;
+    STORE_FILE_HEADER       (file.data(), header);
+    return slide;
+}
+
+Result stream_validate (const std::vector<BYTE>& file) {
+    StreamValidator validator;
+    for (size_t offset = 0; offset < file.size(); offset += 23)
+        validator.push(file.data() + offset, std::min<size_t>(23, file.size() - offset));
+    return validator.finish();
+}
+
+void test_store_and_read() {
+    const TileExtents tiles = {{256, 256}, {512, 512}, {1024, 512}};
+    auto slide = make_file(tiles);
+    IFE_CHECK(validate_file_structure(slide.file.data(), slide.file.size()) == IRIS_SUCCESS);
+    IFE_CHECK(stream_validate(slide.file) == IRIS_SUCCESS);
+
+    const auto abstraction = abstract_file_structure(slide.file.data(), slide.file.size());
+    const auto& table = abstraction.tileTable;
+    IFE_CHECK(table.tileExtents.size() == LAYERS);
+    for (uint32_t LI = 0; LI < std::min<size_t>(LAYERS, table.tileExtents.size()); ++LI) {
+        IFE_CHECK(table.tileExtents[LI].width == tiles[LI].width);
+        IFE_CHECK(table.tileExtents[LI].height == tiles[LI].height);
+    }
+    IFE_CHECK(table.extent.width == 1024u << (LAYERS - 1));
+    IFE_CHECK(table.extent.layers.size() == LAYERS);
+
+    // The tile dimensions of a single plane read match the primary read
+    const auto plane = abstract_tile_plane(slide.file.data(), slide.file.size(), 0);
+    IFE_CHECK(plane.tileExtents.size() == LAYERS && plane.tileExtents.back().width == 1024);
+}
+
+void test_standard_tiles() {
+    for (bool compact : {false, true}) {
+        auto slide = make_file({}, compact);
+        IFE_CHECK(validate_file_structure(slide.file.data(), slide.file.size()) == IRIS_SUCCESS);
+        IFE_CHECK(stream_validate(slide.file) == IRIS_SUCCESS);
+        const auto abstraction = abstract_file_structure(slide.file.data(), slide.file.size());
+        IFE_CHECK(abstraction.tileTable.tileExtents.size() == LAYERS);
+        for (auto&& tile : abstraction.tileTable.tileExtents) {
+            IFE_CHECK(tile.width == TileExtent::STANDARD);
+            IFE_CHECK(tile.height == TileExtent::STANDARD);
+        }
+        IFE_CHECK(abstraction.tileTable.layers.size() == LAYERS);
+    }
+}
+
+void test_zero_dimensions() {
+    // Refused on store
+    std::vector<BYTE> buffer (1024);
+    LayerExtents extents (LAYERS);
+    bool threw = false;
+    try {STORE_EXTENTS(buffer.data(), 0, extents, {{256, 256}, {0, 256}, {256, 256}});}
+    catch (const std::exception&) {threw = true;}
+    IFE_CHECK(threw);
+    threw = false;
+    try {STORE_EXTENTS(buffer.data(), 0, extents, {{256, 256}});}
+    catch (const std::exception&) {threw = true;}
+    IFE_CHECK(threw);
+
+    // Refused on validation, streaming and read
+    auto slide = make_file({{256, 256}, {512, 512}, {512, 512}});
+    const Offset entry = slide.extents + LAYER_EXTENTS::HEADER_SIZE + LAYER_EXTENT::SIZE;
+    std::memset(slide.file.data() + entry + LAYER_EXTENT::TILE_HEIGHT, 0, sizeof(uint16_t));
+    IFE_CHECK(validate_file_structure(slide.file.data(), slide.file.size()) & IRIS_FAILURE);
+    IFE_CHECK(stream_validate(slide.file) & IRIS_FAILURE);
+    threw = false;
+    try {abstract_file_structure(slide.file.data(), slide.file.size());}
+    catch (const std::exception&) {threw = true;}
+    IFE_CHECK(threw);
+}
+
+} // namespace
+
+int main() {
+    try {
+        test_store_and_read();
+        test_standard_tiles();
+        test_zero_dimensions();
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "ife_tile_extents_tests: %s\n", e.what());
+        return 1;
+    }
+
+    if (g_failures == 0) {
+        std::printf("ife_tile_extents_tests: ALL PASS\n");
+        return 0;
+    }
+    std::fprintf(stderr, "ife_tile_extents_tests: %d FAILURE(S)\n", g_failures);
+    return 1;
+}
@@ -0,0 +1,182 @@
+/**
+ * @file ife_tile_offsets_tests.cpp
+ * @brief Round-trip tests for sparse tiles within the tile offsets tables.
+ *
+ * Writes an in-memory slide file whose tile offsets contain sparse (NULL_TILE)
+ * entries and checks that the header store, full validation, the streaming
+ * validator, the tile table read and a delta amendment all accept them.
+ *
+ * Self-contained (no external test framework) so CI doesn't need extra deps.
+ * Run with `ctest` or directly; non-zero exit on failure.
+ */
+#include "IrisTypes.hpp"
+#include "IrisCodecTypes.hpp"
+#include "IrisCodecExtension.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <vector>
+
+namespace {
+
+using namespace IrisCodec;
+using namespace IrisCodec::Serialization;
+using IrisCodec::NULL_OFFSET;
+
+int g_failures = 0;
+
+#define IFE_CHECK(cond) do { \
+    if (!(cond)) { \
+        std::fprintf(stderr, "FAIL: %s (%s:%d)\n", #cond, __FILE__, __LINE__); \
+        ++g_failures; \
+    } \
+} while (0)
+
+constexpr uint32_t LAYERS       = 3;
+constexpr uint32_t TILE_BYTES   = 64;
+
+bool is_sparse (uint32_t layer, uint32_t tile) {
+    // The final tile of every layer and one interior tile of the highest layer
+    return tile == (1u << layer) * (1u << layer) - 1 || (layer == LAYERS - 1 && tile == 5);
+}
+
+// Build a slide of LAYERS layers (1x1, 2x2, 4x4 tiles) with sparse tiles
+std::vector<BYTE> make_sparse_file (Offset& tile_table) {
+    LayerExtents extents;
+    for (uint32_t LI = 0; LI < LAYERS; ++LI) {
+        LayerExtent extent;
+        extent.xTiles       = 1u << LI;
+        extent.yTiles       = 1u << LI;
+        extent.scale        = float(1u << LI);
+        extent.downsample   = float(1u << (LAYERS - 1 - LI));
+        extents.push_back(extent);
+    }
+    Offset offset           = FILE_HEADER::HEADER_SIZE;
+    Abstraction::TileTable::Layers layers (LAYERS);
+    for (uint32_t LI = 0; LI < LAYERS; ++LI)
+        for (uint32_t TI = 0; TI < extents[LI].xTiles * extents[LI].yTiles; ++TI) {
+            if (is_sparse(LI, TI)) {
+                layers[LI].push_back({NULL_OFFSET, 0});
+                continue;
+            }
+            layers[LI].push_back({offset, TILE_BYTES});
+            offset         += TILE_BYTES;
+        }
+    const Offset tiles_end  = offset;
+    const Offset extents_at = offset;   offset += SIZE_EXTENTS(extents);
+    const Offset offsets_at = offset;   offset += SIZE_TILE_OFFSETS(layers);
+    tile_table              = offset;   offset += TILE_TABLE::HEADER_SIZE;
+    const Offset metadata   = offset;   offset += METADATA::HEADER_SIZE;
+
+    std::vector<BYTE> file (offset);
+    BYTE* const base        = file.data();
+    for (Offset BI = FILE_HEADER::HEADER_SIZE; BI < tiles_end; ++BI) base[BI] = BYTE(BI * 31);
+    STORE_EXTENTS           (base, extents_at, extents);
+    STORE_TILE_OFFSETS      (base, offsets_at, layers);
+
+    TileTableCreateInfo table;
+    table.tileTableOffset   = tile_table;
+    table.encoding          = TILE_ENCODING_JPEG;
+    table.format            = FORMAT_R8G8B8;
+    table.tilesOffset       = offsets_at;
+    table.layerExtentsOffset= extents_at;
+    table.layers            = LAYERS;
+    table.widthPixels       = 256u << (LAYERS - 1);
+    table.heightPixels      = 256u << (LAYERS - 1);
+    STORE_TILE_TABLE        (base, table);
+
+    MetadataCreateInfo info;
+    info.metadataOffset     = metadata;
+    info.codecVersion       = {1, 0, 0};
+    info.micronsPerPixel    = 0.25f;
+    info.magnification      = 40.f;
+    STORE_METADATA          (base, info);
+
+    HeaderCreateInfo header;
+    header.fileSize         = file.size();
+    header.revision         = 1;
+    header.tileTableOffset  = tile_table;
+    header.metadataOffset   = metadata;
+    STORE_FILE_HEADER       (base, header);
+    return file;
+}
+
+void check_sparse_tiles (const Abstraction::TileTable& table) {
+    IFE_CHECK(table.layers.size() == LAYERS);
+    for (uint32_t LI = 0; LI < table.layers.size(); ++LI)
+        for (uint32_t TI = 0; TI < table.layers[LI].size(); ++TI) {
+            const auto& tile = table.layers[LI][TI];
+            if (is_sparse(LI, TI)) {
+                IFE_CHECK(tile.offset == NULL_OFFSET);
+                IFE_CHECK(tile.size == 0);
+            } else IFE_CHECK(tile.offset != NULL_OFFSET && tile.size == TILE_BYTES);
+        }
+}
+
+void test_store_and_validate() {
+    Offset tile_table = NULL_OFFSET;
+    std::vector<BYTE> file;
+    try { file = make_sparse_file(tile_table); }
+    catch (const std::exception& e) { std::fprintf(stderr, "%s\n", e.what()); }
+    IFE_CHECK(!file.empty());
+    if (file.empty()) return;
+
+    IFE_CHECK(validate_file_structure(file.data(), file.size()) == IRIS_SUCCESS);
+    const auto slide = abstract_file_structure(file.data(), file.size());
+    check_sparse_tiles(slide.tileTable);
+}
+
+void test_stream_validate() {
+    Offset tile_table = NULL_OFFSET;
+    auto file = make_sparse_file(tile_table);
+    StreamValidator validator;
+    for (size_t offset = 0; offset < file.size(); offset += 97)
+        validator.push(file.data() + offset, std::min<size_t>(97, file.size() - offset));
+    IFE_CHECK(validator.finish() == IRIS_SUCCESS);
+    IFE_CHECK(validator.state() == StreamValidator::STREAM_VALID);
+}
+
+void test_amend_sparse_file() {
+    Offset tile_table = NULL_OFFSET;
+    auto file = make_sparse_file(tile_table);
+
+    // A delta table over the sparse base table, then a complete table that retains the sparse tiles
+    const std::vector<BYTE> payload (TILE_BYTES / 2, 0xA5);
+    for (bool delta : {true, false}) {
+        TileAmendmentCreateInfo amendment;
+        amendment.tiles.push_back({LAYERS - 1, 0, payload.data(), payload.size()});
+        amendment.deltaEncode = delta;
+        const Size size = file.size();
+        file.resize(size + SIZE_TILE_AMENDMENT(file.data(), size, amendment));
+        IFE_CHECK(STORE_TILE_AMENDMENT(file.data(), size, amendment) == file.size());
+        IFE_CHECK(validate_file_structure(file.data(), file.size()) == IRIS_SUCCESS);
+
+        const auto slide = abstract_file_structure(file.data(), file.size());
+        IFE_CHECK(slide.tileTable.layers[LAYERS - 1][0].size == payload.size());
+        for (uint32_t LI = 0; LI < LAYERS; ++LI)
+            for (uint32_t TI = 0; TI < slide.tileTable.layers[LI].size(); ++TI)
+                if (is_sparse(LI, TI)) IFE_CHECK(slide.tileTable.layers[LI][TI].offset == NULL_OFFSET);
+    }
+}
+
+} // namespace
+
+int main() {
+    try {
+        test_store_and_validate();
+        test_stream_validate();
+        test_amend_sparse_file();
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "ife_tile_offsets_tests: %s\n", e.what());
+        return 1;
+    }
+
+    if (g_failures == 0) {
+        std::printf("ife_tile_offsets_tests: ALL PASS\n");
+        return 0;
+    }
+    std::fprintf(stderr, "ife_tile_offsets_tests: %d FAILURE(S)\n", g_failures);
+    return 1;
+}
@@ -0,0 +1,230 @@
+/**
+ * @file ife_tile_planes_tests.cpp
+ * @brief Round-trip tests for multi-plane (TILE_PLANES) tile tables.
+ *
+ * Writes an in-memory slide of three focal planes sharing one set of layer
+ * extents and checks that full validation, the streaming validator and the
+ * tile table read accept it, that each plane reads its own tile offsets, and
+ * that an amendment of one plane leaves the other planes untouched.
+ *
+ * Self-contained (no external test framework) so CI doesn't need extra deps.
+ * Run with `ctest` or directly; non-zero exit on failure.
+ */
+#include "IrisTypes.hpp"
+#include "IrisCodecTypes.hpp"
+#include "IrisCodecExtension.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <vector>
+
+namespace {
+
+using namespace IrisCodec;
+using namespace IrisCodec::Serialization;
+using IrisCodec::NULL_OFFSET;
+
+int g_failures = 0;
+
+#define IFE_CHECK(cond) do { \
+    if (!(cond)) { \
+        std::fprintf(stderr, "FAIL: %s (%s:%d)\n", #cond, __FILE__, __LINE__); \
+        ++g_failures; \
+    } \
+} while (0)
+
+constexpr uint32_t LAYERS       = 2;
+constexpr uint32_t PLANES       = 3;
+constexpr uint32_t TILE_BYTES   = 64;
+constexpr float    FOCAL [PLANES] = {0.f, -1.5f, 2.25f};
+
+struct PlaneFile {
+    std::vector<BYTE>   file;
+    Offset              planes      = NULL_OFFSET;
+    std::vector<Abstraction::TileTable::Layers> layers;     // Per plane
+};
+
+// Two layers (1x1, 2x2 tiles) of three focal planes; the tiles of each plane are contiguous
+PlaneFile make_plane_file () {
+    PlaneFile slide;
+    auto& file              = slide.file;
+    file.resize(FILE_HEADER::HEADER_SIZE);
+    auto append = [&file](Size bytes) {
+        const Offset offset = file.size();
+        file.resize(offset + bytes);
+        return offset;
+    };
+
+    LayerExtents extents;
+    for (uint32_t LI = 0; LI < LAYERS; ++LI) {
+        LayerExtent extent;
+        extent.xTiles       = 1u << LI;
+        extent.yTiles       = 1u << LI;
+        extent.scale        = float(1u << LI);
+        extent.downsample   = float(1u << (LAYERS - 1 - LI));
+        extents.push_back(extent);
+    }
+    slide.layers.resize(PLANES, Abstraction::TileTable::Layers(LAYERS));
+    for (uint32_t PI = 0; PI < PLANES; ++PI)
+        for (uint32_t LI = 0; LI < LAYERS; ++LI)
+            for (uint32_t TI = 0; TI < extents[LI].xTiles * extents[LI].yTiles; ++TI) {
+                const Offset offset = append(TILE_BYTES);
+                std::fill(file.begin() + offset, file.begin() + offset + TILE_BYTES, BYTE(PI * 16 + LI * 4 + TI));
+                slide.layers[PI][LI].push_back({offset, TILE_BYTES});
+            }
+    const Offset extents_at = append(SIZE_EXTENTS(extents));
+    STORE_EXTENTS           (file.data(), extents_at, extents);
+
+    TilePlanesCreateInfo planes;
+    planes.type             = PLANE_FOCAL;
+    std::vector<Offset> offsets_at (PLANES);
+    for (uint32_t PI = 0; PI < PLANES; ++PI) {
+        offsets_at[PI]      = append(SIZE_TILE_OFFSETS(slide.layers[PI]));
+        STORE_TILE_OFFSETS  (file.data(), offsets_at[PI], slide.layers[PI]);
+        planes.planes.push_back({offsets_at[PI], FOCAL[PI]});
+    }
+    planes.planesOffset     = append(SIZE_TILE_PLANES(planes));
+    STORE_TILE_PLANES       (file.data(), planes);
+    slide.planes            = planes.planesOffset;
+
+    TileTableCreateInfo table;
+    table.tileTableOffset   = append(TILE_TABLE::HEADER_SIZE);
+    table.encoding          = TILE_ENCODING_JPEG;
+    table.format            = FORMAT_R8G8B8;
+    table.tilesOffset       = offsets_at[0];
+    table.layerExtentsOffset= extents_at;
+    table.layers            = LAYERS;
+    table.widthPixels       = 256u << (LAYERS - 1);
+    table.heightPixels      = 256u << (LAYERS - 1);
+    table.planesOffset      = planes.planesOffset;
+    STORE_TILE_TABLE        (file.data(), table);
+
+    MetadataCreateInfo metadata;
+    metadata.metadataOffset = append(METADATA::HEADER_SIZE);
+    metadata.codecVersion   = {1, 0, 0};
+    metadata.micronsPerPixel= 0.25f;
+    metadata.magnification  = 40.f;
+    STORE_METADATA          (file.data(), metadata);
+
+    HeaderCreateInfo header;
+    header.fileSize         = file.size();
+    header.revision         = 1;
+    header.tileTableOffset  = table.tileTableOffset;
+    header.metadataOffset   = metadata.metadataOffset;
+    STORE_FILE_HEADER       (file.data(), header);
+    return slide;
+}
+
+bool same_layers (const Abstraction::TileTable::Layers& a, const Abstraction::TileTable::Layers& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t LI = 0; LI < a.size(); ++LI) {
+        if (a[LI].size() != b[LI].size()) return false;
+        for (size_t TI = 0; TI < a[LI].size(); ++TI)
+            if (a[LI][TI].offset != b[LI][TI].offset || a[LI][TI].size != b[LI][TI].size) return false;
+    }
+    return true;
+}
+
+void test_store_and_validate() {
+    auto slide = make_plane_file();
+    IFE_CHECK(validate_file_structure(slide.file.data(), slide.file.size()) == IRIS_SUCCESS);
+
+    const auto abstraction = abstract_file_structure(slide.file.data(), slide.file.size());
+    const auto& table = abstraction.tileTable;
+    IFE_CHECK(table.planeType == PLANE_FOCAL);
+    IFE_CHECK(table.planes.size() == PLANES);
+    for (uint32_t PI = 0; PI < std::min<size_t>(PLANES, table.planes.size()); ++PI)
+        IFE_CHECK(table.planes[PI] == FOCAL[PI]);
+    IFE_CHECK(table.plane == 0);
+    IFE_CHECK(same_layers(table.layers, slide.layers[0]));
+}
+
+void test_read_planes() {
+    auto slide = make_plane_file();
+    for (uint32_t PI = 0; PI < PLANES; ++PI) {
+        const auto table = abstract_tile_plane(slide.file.data(), slide.file.size(), PI);
+        IFE_CHECK(table.plane == PI);
+        IFE_CHECK(table.planes.size() == PLANES);
+        IFE_CHECK(same_layers(table.layers, slide.layers[PI]));
+        // The tiles of each plane hold their own bytes
+        const auto& tile = table.layers[LAYERS - 1][2];
+        IFE_CHECK(slide.file[tile.offset] == BYTE(PI * 16 + (LAYERS - 1) * 4 + 2));
+    }
+    bool threw = false;
+    try {abstract_tile_plane(slide.file.data(), slide.file.size(), PLANES);}
+    catch (const std::exception&) {threw = true;}
+    IFE_CHECK(threw);
+}
+
+void test_stream_validate() {
+    auto slide = make_plane_file();
+    StreamValidator validator;
+    for (size_t offset = 0; offset < slide.file.size(); offset += 61)
+        validator.push(slide.file.data() + offset, std::min<size_t>(61, slide.file.size() - offset));
+    IFE_CHECK(validator.finish() == IRIS_SUCCESS);
+}
+
+// Plane 0 is the tile table's own array and its entry shall be NULL_OFFSET
+void test_invalid_planes() {
+    {
+        auto slide = make_plane_file();
+        const uint64_t offset = slide.layers[0][0][0].offset;
+        std::memcpy(slide.file.data() + slide.planes + TILE_PLANES::HEADER_SIZE + TILE_PLANE::TILE_OFFSETS_OFFSET,
+                    &offset, sizeof(offset));
+        IFE_CHECK(validate_file_structure(slide.file.data(), slide.file.size()) & IRIS_FAILURE);
+    }
+    {
+        auto slide = make_plane_file();
+        slide.file[slide.planes + TILE_PLANES::PLANE_TYPE] = PLANE_UNDEFINED;
+        IFE_CHECK(validate_file_structure(slide.file.data(), slide.file.size()) & IRIS_FAILURE);
+    }
+}
+
+// Amending plane 1 repoints its tile offsets only
+void test_amend_plane() {
+    auto slide = make_plane_file();
+    auto& file = slide.file;
+    const std::vector<BYTE> payload (TILE_BYTES / 2, 0xA5);
+    TileAmendmentCreateInfo amendment;
+    amendment.plane = 1;
+    amendment.tiles.push_back({LAYERS - 1, 3, payload.data(), payload.size()});
+    const Size size = file.size();
+    file.resize(size + SIZE_TILE_AMENDMENT(file.data(), size, amendment));
+    IFE_CHECK(STORE_TILE_AMENDMENT(file.data(), size, amendment) == file.size());
+    IFE_CHECK(validate_file_structure(file.data(), file.size()) == IRIS_SUCCESS);
+
+    const auto plane0 = abstract_tile_plane(file.data(), file.size(), 0);
+    const auto plane1 = abstract_tile_plane(file.data(), file.size(), 1);
+    const auto plane2 = abstract_tile_plane(file.data(), file.size(), 2);
+    IFE_CHECK(same_layers(plane0.layers, slide.layers[0]));
+    IFE_CHECK(same_layers(plane2.layers, slide.layers[2]));
+    const auto& tile = plane1.layers[LAYERS - 1][3];
+    IFE_CHECK(tile.size == payload.size());
+    IFE_CHECK(tile.offset >= size && std::equal(payload.begin(), payload.end(), file.begin() + tile.offset));
+    IFE_CHECK(plane1.layers[LAYERS - 1][2].offset == slide.layers[1][LAYERS - 1][2].offset);
+}
+
+} // namespace
+
+int main() {
+    try {
+        test_store_and_validate();
+        test_read_planes();
+        test_stream_validate();
+        test_invalid_planes();
+        test_amend_plane();
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "ife_tile_planes_tests: %s\n", e.what());
+        return 1;
+    }
+
+    if (g_failures == 0) {
+        std::printf("ife_tile_planes_tests: ALL PASS\n");
+        return 0;
+    }
+    std::fprintf(stderr, "ife_tile_planes_tests: %d FAILURE(S)\n", g_failures);
+    return 1;
+}
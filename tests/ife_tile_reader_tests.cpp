@@ -0,0 +1,400 @@
+/**
+ * @file ife_tile_reader_tests.cpp
+ * @brief Tests of the deadline-aware TileReader upon thread pools.
+ *
+ * Reads run upon a thread pool whose tasks wait at a gate, standing in for
+ * a slow source. Checks that a read missing its deadline serves the finest
+ * cached ancestor tile and delivers the exact tile to its refinement callback;
+ * that concurrent reads of a tile share one read; that the cache sheds its
+ * least recently used tiles at its budget and under reclaim_memory; that a
+ * read queued at a lower I/O class is promoted to the class of a joining
+ * reader; and that a reader destroyed with reads queued, from a refinement
+ * callback, or from the only worker of its executor returns without waiting.
+ *
+ * Self-contained (no external test framework) so CI doesn't need extra deps.
+ * Run with `ctest` or directly; non-zero exit on failure.
+ */
+#include "IrisTypes.hpp"
+#include "IrisCodecTypes.hpp"
+#include "IrisCodecExtension.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+using namespace IrisCodec;
+using namespace IrisCodec::Serialization;
+using IrisCodec::NULL_OFFSET;
+using Abstraction::TileReader;
+
+int g_failures = 0;
+
+#define IFE_CHECK(cond) do { \
+    if (!(cond)) { \
+        std::fprintf(stderr, "FAIL: %s (%s:%d)\n", #cond, __FILE__, __LINE__); \
+        ++g_failures; \
+    } \
+} while (0)
+
+constexpr uint32_t LAYERS       = 3;
+constexpr uint32_t TILE_BYTES   = 64;
+// A deadlock is reported rather than waited upon forever
+constexpr auto     HANG_TIMEOUT = std::chrono::seconds(10);
+
+// Executor whose tasks wait at a gate before running upon a thread pool
+class GatedExecutor : public Executor {
+    struct Gate {
+        std::mutex              mutex;
+        std::condition_variable changed;
+        bool                    opened      = true;
+        size_t                  submitted   = 0;
+        size_t                  finished    = 0;
+    };
+    const std::shared_ptr<Gate> __gate      = std::make_shared<Gate>();
+    SharedExecutor              __pool;
+public:
+    explicit GatedExecutor (uint32_t threads) : __pool(create_thread_pool(threads)) {}
+    ~GatedExecutor () override {open(); __pool.reset();}
+    void submit (Task&& task, ExecutorPriority priority) override {
+        auto gate = __gate;
+        {
+            std::lock_guard<std::mutex> lock (gate->mutex);
+            ++gate->submitted;
+        }
+        __pool->submit([gate, task = std::move(task)]() {
+            {
+                std::unique_lock<std::mutex> lock (gate->mutex);
+                gate->changed.wait(lock, [&gate]() {return gate->opened;});
+            }
+            task();
+            {
+                std::lock_guard<std::mutex> lock (gate->mutex);
+                ++gate->finished;
+            }
+            gate->changed.notify_all();
+        }, priority);
+    }
+    uint32_t concurrency () const noexcept override {return __pool->concurrency();}
+    void open () {
+        {
+            std::lock_guard<std::mutex> lock (__gate->mutex);
+            __gate->opened = true;
+        }
+        __gate->changed.notify_all();
+    }
+    void close () {
+        std::lock_guard<std::mutex> lock (__gate->mutex);
+        __gate->opened = false;
+    }
+    size_t submitted () {
+        std::lock_guard<std::mutex> lock (__gate->mutex);
+        return __gate->submitted;
+    }
+    // Wait until every submitted task has run
+    bool idle () {
+        std::unique_lock<std::mutex> lock (__gate->mutex);
+        return __gate->changed.wait_for(lock, HANG_TIMEOUT, [this]() {
+            return __gate->finished == __gate->submitted;
+        });
+    }
+};
+
+struct Slide {
+    std::vector<BYTE>   file;
+    Abstraction::File   abstraction;
+    BYTE tile_byte (uint32_t layer, uint32_t tile) const {
+        return file[abstraction.tileTable.layers[layer][tile].offset];
+    }
+};
+
+// Three layers (1x1, 2x2, 4x4 tiles) of TILE_BYTES tiles
+Slide make_slide () {
+    Slide slide;
+    auto& file              = slide.file;
+    file.resize(FILE_HEADER::HEADER_SIZE);
+    auto append = [&file](Size bytes) {
+        const Offset offset = file.size();
+        file.resize(offset + bytes);
+        return offset;
+    };
+
+    LayerExtents extents;
+    Abstraction::TileTable::Layers layers (LAYERS);
+    for (uint32_t LI = 0; LI < LAYERS; ++LI) {
+        LayerExtent extent;
+        extent.xTiles       = 1u << LI;
+        extent.yTiles       = 1u << LI;
+        extent.scale        = float(1u << LI);
+        extent.downsample   = float(1u << (LAYERS - 1 - LI));
+        extents.push_back(extent);
+        for (uint32_t TI = 0; TI < extent.xTiles * extent.yTiles; ++TI) {
+            const Offset offset = append(TILE_BYTES);
+            for (Offset BI = 0; BI < TILE_BYTES; ++BI) file[offset + BI] = BYTE(LI * 32 + TI);
+            layers[LI].push_back({offset, TILE_BYTES});
+        }
+    }
+    const Offset extents_at = append(SIZE_EXTENTS(extents));
+    STORE_EXTENTS           (file.data(), extents_at, extents);
+    const Offset offsets_at = append(SIZE_TILE_OFFSETS(layers));
+    STORE_TILE_OFFSETS      (file.data(), offsets_at, layers);
+
+    TileTableCreateInfo table;
+    table.tileTableOffset   = append(TILE_TABLE::HEADER_SIZE);
+    table.encoding          = TILE_ENCODING_JPEG;
+    table.format            = FORMAT_R8G8B8;
+    table.tilesOffset       = offsets_at;
+    table.layerExtentsOffset= extents_at;
+    table.layers            = LAYERS;
+    table.widthPixels       = 256u << (LAYERS - 1);
+    table.heightPixels      = 256u << (LAYERS - 1);
+    STORE_TILE_TABLE        (file.data(), table);
+
+    MetadataCreateInfo metadata;
+    metadata.metadataOffset = append(METADATA::HEADER_SIZE);
+    metadata.codecVersion   = {1, 0, 0};
+    metadata.micronsPerPixel= 0.25f;
+    metadata.magnification  = 40.f;
+    STORE_METADATA          (file.data(), metadata);
+
+    HeaderCreateInfo header;
+    header.fileSize         = file.size();
+    header.revision         = 1;
+    header.tileTableOffset  = table.tileTableOffset;
+    header.metadataOffset   = metadata.metadataOffset;
+    STORE_FILE_HEADER       (file.data(), header);
+
+    slide.abstraction       = abstract_file_structure(file.data(), file.size());
+    return slide;
+}
+
+bool same_region (const Abstraction::TileRegion& region, float x, float y, float width, float height) {
+    return region.x == x && region.y == y && region.width == width && region.height == height;
+}
+
+void test_deadline_fallback() {
+    const auto slide    = make_slide();
+    const auto& table   = slide.abstraction.tileTable;
+    auto executor       = std::make_shared<GatedExecutor>(2);
+    TileReader reader (slide.file.data(), slide.file.size(), table, executor);
+
+    // Nothing cached and the source stalled: nothing is served in time
+    executor->close();
+    auto read = reader.read_tile(0, 0, TileReader::Clock::now());
+    IFE_CHECK(!read && !read.exact);
+    executor->open();
+    read = reader.read_tile(0, 0);
+    IFE_CHECK(read.exact && read.bytes->size() == TILE_BYTES);
+    IFE_CHECK(read.bytes->front() == slide.tile_byte(0, 0));
+
+    // Served from the coarsest layer; the exact tile refines the read
+    executor->close();
+    std::promise<Abstraction::TileRead> refined;
+    auto refinement     = refined.get_future();
+    read = reader.read_tile(2, 5, TileReader::Clock::now() + std::chrono::milliseconds(20),
+                            [&refined](const Abstraction::TileRead& exact) {refined.set_value(exact);});
+    IFE_CHECK(read && !read.exact);
+    IFE_CHECK(read.layer == 0 && read.tile == 0);
+    IFE_CHECK(read.bytes->front() == slide.tile_byte(0, 0));
+    // Tile (1, 1) of the 4x4 layer covers the 64 pixel square at (64, 64) of the 1x1 layer
+    IFE_CHECK(same_region(read.region, 64.f, 64.f, 64.f, 64.f));
+    IFE_CHECK(same_region(read.target, 0.f, 0.f, 256.f, 256.f));
+    IFE_CHECK(refinement.wait_for(std::chrono::milliseconds(50)) == std::future_status::timeout);
+
+    // A second reader of the stalled tile joins the read in flight
+    const auto submitted = executor->submitted();
+    IFE_CHECK(!reader.read_tile(2, 5, TileReader::Clock::now()).exact);
+    IFE_CHECK(executor->submitted() == submitted);
+    IFE_CHECK(!reader.read_tile(1, 0, TileReader::Clock::now()).exact);
+
+    executor->open();
+    IFE_CHECK(refinement.wait_for(HANG_TIMEOUT) == std::future_status::ready);
+    if (refinement.valid()) {
+        const auto exact = refinement.get();
+        IFE_CHECK(exact.exact && exact.layer == 2 && exact.tile == 5);
+        IFE_CHECK(exact.bytes && exact.bytes->front() == slide.tile_byte(2, 5));
+    }
+    IFE_CHECK(executor->idle());
+
+    // Cached tiles are served exactly at once; the finest cached ancestor is preferred
+    executor->close();
+    read = reader.read_tile(2, 5, TileReader::Clock::now());
+    IFE_CHECK(read.exact && read.layer == 2 && read.tile == 5);
+    read = reader.read_tile(2, 0, TileReader::Clock::now());
+    IFE_CHECK(!read.exact && read.layer == 1 && read.tile == 0);
+    IFE_CHECK(same_region(read.region, 0.f, 0.f, 128.f, 128.f));
+    IFE_CHECK(read.bytes->front() == slide.tile_byte(1, 0));
+    executor->open();
+    IFE_CHECK(executor->idle());
+    IFE_CHECK(reader.cached_bytes() == 4 * TILE_BYTES);
+}
+
+void test_eviction() {
+    const auto slide    = make_slide();
+    const auto& table   = slide.abstraction.tileTable;
+    auto executor       = std::make_shared<GatedExecutor>(2);
+    TileReader reader (slide.file.data(), slide.file.size(), table, executor, 3 * TILE_BYTES);
+    auto cached = [&](uint32_t tile) {
+        return reader.read_tile(2, tile, TileReader::Clock::now()).exact;
+    };
+
+    for (uint32_t TI = 0; TI < 5; ++TI)
+        IFE_CHECK(reader.read_tile(2, TI).exact);
+    IFE_CHECK(reader.cached_bytes() == 3 * TILE_BYTES);
+
+    // Least recently used first: tile 2 is touched, so tile 3 is evicted next
+    IFE_CHECK(cached(2));
+    IFE_CHECK(reader.read_tile(2, 6).exact);
+    executor->close();
+    IFE_CHECK(cached(2) && cached(4) && cached(6));
+    IFE_CHECK(!cached(3) && !cached(0));
+    executor->open();
+    IFE_CHECK(executor->idle());
+    IFE_CHECK(reader.cached_bytes() == 3 * TILE_BYTES);
+
+    // Memory pressure sheds the least recently used tiles (the cache is the only one registered)
+    IFE_CHECK(reclaim_memory(2 * TILE_BYTES) >= 2 * TILE_BYTES);
+    IFE_CHECK(reader.cached_bytes() <= TILE_BYTES);
+
+    // A tile beyond the budget is still served and retained alone
+    TileReader small (slide.file.data(), slide.file.size(), table, executor, TILE_BYTES / 2);
+    IFE_CHECK(small.read_tile(1, 1).exact);
+    IFE_CHECK(small.cached_bytes() == TILE_BYTES);
+    IFE_CHECK(small.read_tile(1, 2).exact);
+    IFE_CHECK(small.cached_bytes() == TILE_BYTES);
+}
+
+void test_scheduler_promotion() {
+    const auto slide    = make_slide();
+    const auto& table   = slide.abstraction.tileTable;
+    auto executor       = std::make_shared<GatedExecutor>(1);
+    IOSchedulerCreateInfo info;
+    info.executor       = executor;
+    info.slots          = 1;
+    info.reserved       = 0;
+    auto scheduler      = create_io_scheduler(info);
+    TileReader reader (slide.file.data(), slide.file.size(), table, scheduler);
+
+    const IOTag batch {.tenant = "inference", .ioClass = IO_CLASS_BATCH};
+    const IOTag viewer {.tenant = "viewer", .ioClass = IO_CLASS_INTERACTIVE};
+    std::atomic<int> refinements = 0;
+    auto refined = [&refinements](const Abstraction::TileRead& read) {
+        if (read.exact && read.layer == 2 && read.tile == 9) ++refinements;
+    };
+
+    executor->close();
+    IFE_CHECK(!reader.read_tile(2, 9, TileReader::Clock::now(), refined, batch));
+    IFE_CHECK(scheduler->metrics(IO_CLASS_BATCH).submitted == 1);
+    IFE_CHECK(scheduler->metrics(IO_CLASS_INTERACTIVE).submitted == 0);
+
+    // An interactive reader joining the queued batch read submits it again
+    IFE_CHECK(!reader.read_tile(2, 9, TileReader::Clock::now(), refined, viewer));
+    IFE_CHECK(scheduler->metrics(IO_CLASS_INTERACTIVE).submitted == 1);
+    // Joining at the same or a lower class does not
+    IFE_CHECK(!reader.read_tile(2, 9, TileReader::Clock::now(), refined, viewer));
+    IFE_CHECK(!reader.read_tile(2, 9, TileReader::Clock::now(), refined, batch));
+    IFE_CHECK(scheduler->metrics(IO_CLASS_INTERACTIVE).submitted == 1);
+    IFE_CHECK(scheduler->metrics(IO_CLASS_BATCH).submitted == 1);
+
+    // Both submissions run; the first claims the read and every reader is refined once
+    executor->open();
+    const auto read = reader.read_tile(2, 9, viewer);
+    IFE_CHECK(read.exact && read.bytes->front() == slide.tile_byte(2, 9));
+    const auto until = std::chrono::steady_clock::now() + HANG_TIMEOUT;
+    while ((scheduler->metrics(IO_CLASS_INTERACTIVE).completed < 1 ||
+            scheduler->metrics(IO_CLASS_BATCH).completed < 1) &&
+           std::chrono::steady_clock::now() < until)
+        std::this_thread::yield();
+    IFE_CHECK(executor->idle());
+    IFE_CHECK(refinements == 4);
+    IFE_CHECK(reader.cached_bytes() == TILE_BYTES);
+}
+
+void test_destruction() {
+    const auto slide    = make_slide();
+    const auto& table   = slide.abstraction.tileTable;
+
+    // Queued reads are abandoned and their refinements never delivered
+    {
+        auto executor   = std::make_shared<GatedExecutor>(2);
+        std::atomic<int> refinements = 0;
+        auto done       = std::async(std::launch::async, [&]() {
+            TileReader reader (slide.file.data(), slide.file.size(), table, executor);
+            executor->close();
+            for (uint32_t TI = 0; TI < 4; ++TI)
+                reader.read_tile(2, TI, TileReader::Clock::now(),
+                                 [&refinements](const Abstraction::TileRead&) {++refinements;});
+        });
+        IFE_CHECK(done.wait_for(HANG_TIMEOUT) == std::future_status::ready);
+        executor->open();
+        IFE_CHECK(executor->idle());
+        IFE_CHECK(refinements == 0);
+    }
+
+    // Destroyed from its own refinement callback
+    {
+        auto executor   = std::make_shared<GatedExecutor>(2);
+        auto reader     = std::make_unique<TileReader>(slide.file.data(), slide.file.size(), table, executor);
+        std::promise<void> destroyed;
+        auto done       = destroyed.get_future();
+        executor->close();
+        reader->read_tile(2, 4, TileReader::Clock::now(), [&](const Abstraction::TileRead&) {
+            reader.reset();
+            destroyed.set_value();
+        });
+        executor->open();
+        IFE_CHECK(done.wait_for(HANG_TIMEOUT) == std::future_status::ready);
+        IFE_CHECK(executor->idle());
+    }
+
+    // Destroyed from the only worker of its executor while a read is queued behind it
+    {
+        auto pool       = create_thread_pool(1);
+        auto reader     = std::make_unique<TileReader>(slide.file.data(), slide.file.size(), table, pool);
+        std::promise<void> started, release, destroyed;
+        auto blocked    = release.get_future().share();
+        auto done       = destroyed.get_future();
+        pool->submit([&started, blocked]() {
+            started.set_value();
+            blocked.wait();
+        }, PRIORITY_HIGH);
+        started.get_future().wait();
+        IFE_CHECK(!reader->read_tile(2, 7, TileReader::Clock::now()));
+        // Submitted last from outside the pool, it runs before the queued read
+        pool->submit([&]() {
+            reader.reset();
+            destroyed.set_value();
+        }, PRIORITY_HIGH);
+        release.set_value();
+        IFE_CHECK(done.wait_for(HANG_TIMEOUT) == std::future_status::ready);
+    }
+}
+
+} // namespace
+
+int main() {
+    try {
+        test_deadline_fallback();
+        test_eviction();
+        test_scheduler_promotion();
+        test_destruction();
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "ife_tile_reader_tests: %s\n", e.what());
+        return 1;
+    }
+
+    if (g_failures == 0) {
+        std::printf("ife_tile_reader_tests: ALL PASS\n");
+        return 0;
+    }
+    std::fprintf(stderr, "ife_tile_reader_tests: %d FAILURE(S)\n", g_failures);
+    return 1;
+}
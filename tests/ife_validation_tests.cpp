@@ -0,0 +1,335 @@
+/**
+ * @file ife_validation_tests.cpp
+ * @brief Tests for the background validation of files opened with
+ *        abstract_file_structure_deferred.
+ *
+ * Releasing a validation shall never wait for its background pass: neither
+ * from the completion callback, nor from a task of a single thread pool
+ * upon which the pass is queued, nor when the executor discards the pass.
+ * The library's tile reads (TileReader and read_patches given the deferred
+ * file) check every tile with the validation: a quarantined file serves no
+ * tile, and while validation is pending tile byte ranges beyond the file
+ * are refused.
+ *
+ * Self-contained (no external test framework) so CI doesn't need extra deps.
+ * Run with `ctest` or directly; non-zero exit on failure.
+ */
+#include "IrisTypes.hpp"
+#include "IrisCodecTypes.hpp"
+#include "IrisCodecExtension.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using namespace IrisCodec;
+using namespace IrisCodec::Serialization;
+using IrisCodec::NULL_OFFSET;
+
+int g_failures = 0;
+
+#define IFE_CHECK(cond) do { \
+    if (!(cond)) { \
+        std::fprintf(stderr, "FAIL: %s (%s:%d)\n", #cond, __FILE__, __LINE__); \
+        ++g_failures; \
+    } \
+} while (0)
+
+constexpr uint32_t LAYERS       = 2;
+constexpr uint32_t TILE_BYTES   = 64;
+// A deadlock is reported rather than waited upon forever
+constexpr auto     HANG_TIMEOUT = std::chrono::seconds(10);
+
+struct Slide {
+    std::vector<BYTE>   file;
+    Offset              attributes  = NULL_OFFSET;
+};
+
+// Two layers (1x1, 2x2 tiles; the final tile sparse) and a few attributes
+Slide make_slide () {
+    Slide slide;
+    auto& file              = slide.file;
+    file.resize(FILE_HEADER::HEADER_SIZE);
+    auto append = [&file](Size bytes) {
+        const Offset offset = file.size();
+        file.resize(offset + bytes);
+        return offset;
+    };
+
+    LayerExtents extents;
+    Abstraction::TileTable::Layers layers (LAYERS);
+    for (uint32_t LI = 0; LI < LAYERS; ++LI) {
+        LayerExtent extent;
+        extent.xTiles       = 1u << LI;
+        extent.yTiles       = 1u << LI;
+        extent.scale        = float(1u << LI);
+        extent.downsample   = float(1u << (LAYERS - 1 - LI));
+        extents.push_back(extent);
+        for (uint32_t TI = 0; TI < extent.xTiles * extent.yTiles; ++TI) {
+            if (LI == LAYERS - 1 && TI == extent.xTiles * extent.yTiles - 1) {
+                layers[LI].push_back({NULL_OFFSET, 0});
+                continue;
+            }
+            const Offset offset = append(TILE_BYTES);
+            for (Offset BI = 0; BI < TILE_BYTES; ++BI) file[offset + BI] = BYTE(offset + BI);
+            layers[LI].push_back({offset, TILE_BYTES});
+        }
+    }
+    const Offset extents_at = append(SIZE_EXTENTS(extents));
+    STORE_EXTENTS           (file.data(), extents_at, extents);
+    const Offset offsets_at = append(SIZE_TILE_OFFSETS(layers));
+    STORE_TILE_OFFSETS      (file.data(), offsets_at, layers);
+
+    TileTableCreateInfo table;
+    table.tileTableOffset   = append(TILE_TABLE::HEADER_SIZE);
+    table.encoding          = TILE_ENCODING_JPEG;
+    table.format            = FORMAT_R8G8B8;
+    table.tilesOffset       = offsets_at;
+    table.layerExtentsOffset= extents_at;
+    table.layers            = LAYERS;
+    table.widthPixels       = 256u << (LAYERS - 1);
+    table.heightPixels      = 256u << (LAYERS - 1);
+    STORE_TILE_TABLE        (file.data(), table);
+
+    Attributes attributes;
+    attributes.type         = METADATA_I2S;
+    attributes.version      = 1;
+    attributes["scanner"]   = u8"test";
+    attributes["stain"]     = u8"H&E";
+    AttributesCreateInfo attribute_info;
+    attribute_info.attributesOffset = append(ATTRIBUTES::HEADER_SIZE);
+    attribute_info.type     = attributes.type;
+    attribute_info.version  = attributes.version;
+    attribute_info.sizes    = append(SIZE_ATTRIBUTES_SIZES(attributes));
+    attribute_info.bytes    = append(SIZE_ATTRIBUTES_BYTES(attributes));
+    STORE_ATTRIBUTES_SIZES  (file.data(), attribute_info.sizes, attributes);
+    STORE_ATTRIBUTES_BYTES  (file.data(), attribute_info.bytes, attributes);
+    STORE_ATTRIBUTES        (file.data(), attribute_info);
+    slide.attributes        = attribute_info.attributesOffset;
+
+    MetadataCreateInfo metadata;
+    metadata.metadataOffset = append(METADATA::HEADER_SIZE);
+    metadata.codecVersion   = {1, 0, 0};
+    metadata.attributes     = attribute_info.attributesOffset;
+    metadata.micronsPerPixel= 0.25f;
+    metadata.magnification  = 40.f;
+    STORE_METADATA          (file.data(), metadata);
+
+    HeaderCreateInfo header;
+    header.fileSize         = file.size();
+    header.revision         = 1;
+    header.tileTableOffset  = table.tileTableOffset;
+    header.metadataOffset   = metadata.metadataOffset;
+    STORE_FILE_HEADER       (file.data(), header);
+    return slide;
+}
+
+// Corrupt the attributes block such that the background pass fails while the
+// synchronous checks of the deferred open (header, tile table, metadata) pass
+void quarantine (Slide& slide) {
+    slide.file[slide.attributes] ^= 0xFF;
+}
+
+// Executor discarding every task (ex: an executor shutting down)
+class DiscardingExecutor : public Executor {
+public:
+    void        submit      (Task&&, ExecutorPriority) override {}
+    uint32_t    concurrency () const noexcept override {return 1;}
+};
+
+void wait_or_abort (const std::atomic<bool>& flag, const char* what) {
+    const auto deadline = std::chrono::steady_clock::now() + HANG_TIMEOUT;
+    while (!flag.load()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            std::fprintf(stderr, "FAIL: %s deadlocked\nife_validation_tests: FAILURE\n", what);
+            std::_Exit(1);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+// Block the single worker of a pool until released
+struct WorkerGate {
+    std::mutex              mutex;
+    std::condition_variable released;
+    bool                    open    = false;
+    void hold (const SharedExecutor& pool) {
+        pool->submit([this]() {
+            std::unique_lock<std::mutex> lock (mutex);
+            released.wait(lock, [this]() {return open;});
+        });
+    }
+    void release () {
+        {
+            std::lock_guard<std::mutex> lock (mutex);
+            open = true;
+        }
+        released.notify_all();
+    }
+};
+
+void test_passed () {
+    auto slide = make_slide();
+    auto file  = abstract_file_structure_deferred(slide.file.data(), slide.file.size(), nullptr, inline_executor());
+    IFE_CHECK(file.validation->state() == Abstraction::VALIDATION_PASSED);
+    IFE_CHECK(file.validation->wait() == IRIS_SUCCESS);
+
+    Abstraction::TileReader reader (slide.file.data(), slide.file.size(), file, inline_executor());
+    const auto read = reader.read_tile(1, 0);
+    IFE_CHECK(read.bytes && read.bytes->size() == TILE_BYTES);
+    IFE_CHECK(read.bytes && read.bytes->front() == slide.file[file.tileTable.layers[1][0].offset]);
+    const auto sparse = reader.read_tile(1, 3);
+    IFE_CHECK(sparse.bytes && sparse.bytes->empty());
+
+    const auto batch = read_patches(slide.file.data(), slide.file.size(), file,
+                                    {{256.f, 256.f}}, {{.layer = 1, .width = 128, .height = 128}},
+                                    inline_executor());
+    IFE_CHECK(batch.tiles.size() == 4);
+    for (auto&& tile : batch.tiles) IFE_CHECK(tile.bytes != nullptr);
+}
+
+void test_quarantined () {
+    auto slide = make_slide();
+    quarantine(slide);
+    Result reported;
+    auto file  = abstract_file_structure_deferred(slide.file.data(), slide.file.size(),
+                                                  [&reported](const Result& result) {reported = result;},
+                                                  inline_executor());
+    IFE_CHECK(file.validation->quarantined());
+    IFE_CHECK(reported & IRIS_FAILURE);
+    IFE_CHECK(file.validation->check_tile(file.tileTable.layers[1][0]) & IRIS_FAILURE);
+
+    Abstraction::TileReader reader (slide.file.data(), slide.file.size(), file, inline_executor());
+    bool threw = false;
+    try { reader.read_tile(1, 0); } catch (const std::runtime_error&) { threw = true; }
+    IFE_CHECK(threw);
+    threw = false;
+    try { reader.read_tile(1, 3); } catch (const std::runtime_error&) { threw = true; }
+    IFE_CHECK(threw);
+    threw = false;
+    try {
+        read_patches(slide.file.data(), slide.file.size(), file,
+                     {{256.f, 256.f}}, {{.layer = 1, .width = 128, .height = 128}}, inline_executor());
+    } catch (const std::runtime_error&) { threw = true; }
+    IFE_CHECK(threw);
+    IFE_CHECK(reader.cached_bytes() == 0);
+}
+
+// The pass never runs: reads are bounds checked inline
+void test_pending () {
+    auto slide = make_slide();
+    auto file  = abstract_file_structure_deferred(slide.file.data(), slide.file.size(), nullptr,
+                                                  std::make_shared<DiscardingExecutor>());
+    IFE_CHECK(file.validation->state() == Abstraction::VALIDATION_PENDING);
+    IFE_CHECK(file.validation->wait() & IRIS_FAILURE);
+    IFE_CHECK(file.validation->state() == Abstraction::VALIDATION_PENDING);
+
+    // A tile entry reaching beyond the end of the file
+    auto& beyond        = file.tileTable.layers[1][2];
+    beyond.offset       = slide.file.size() - TILE_BYTES / 2;
+    Abstraction::TileReader reader (slide.file.data(), slide.file.size(), file, inline_executor());
+    IFE_CHECK(reader.read_tile(1, 0).bytes->size() == TILE_BYTES);
+    IFE_CHECK(reader.read_tile(1, 3).bytes->empty());
+    bool threw = false;
+    try { reader.read_tile(1, 2); } catch (const std::runtime_error&) { threw = true; }
+    IFE_CHECK(threw);
+    threw = false;
+    try {
+        read_patches(slide.file.data(), slide.file.size(), file,
+                     {{256.f, 256.f}}, {{.layer = 1, .width = 128, .height = 128}}, inline_executor());
+    } catch (const std::runtime_error&) { threw = true; }
+    IFE_CHECK(threw);
+}
+
+// The completion callback drops the last reference to the deferred file
+void test_release_from_callback () {
+    auto slide = make_slide();
+    auto pool  = create_thread_pool(1);
+    WorkerGate gate;
+    gate.hold(pool);
+
+    std::shared_ptr<const Abstraction::Validation> kept;
+    std::atomic<bool> released {false};
+    bool passed = false;
+    {
+        auto file = abstract_file_structure_deferred
+        (slide.file.data(), slide.file.size(), [&](const Result& result) {
+            passed = result == IRIS_SUCCESS;
+            kept.reset();
+            released = true;
+        }, pool);
+        kept = file.validation;
+    }
+    gate.release();
+    wait_or_abort(released, "releasing the validation from its callback");
+    IFE_CHECK(passed);
+}
+
+// The deferred file is opened and destroyed on the only worker of a pool
+void test_release_on_worker () {
+    auto slide = make_slide();
+    auto pool  = create_thread_pool(1);
+    std::atomic<bool> destroyed {false}, called {false};
+    Result reported;
+    pool->submit([&]() {
+        {
+            auto file = abstract_file_structure_deferred
+            (slide.file.data(), slide.file.size(), [&](const Result& result) {
+                reported = result;
+                called = true;
+            }, pool);
+        }
+        destroyed = true;
+    });
+    wait_or_abort(destroyed, "releasing the validation on the pool's only worker");
+    wait_or_abort(called, "cancelling the queued validation pass");
+    // The pass was queued behind the task that released it
+    IFE_CHECK(reported & IRIS_FAILURE);
+}
+
+// The executor discards the pass
+void test_release_discarded () {
+    auto slide = make_slide();
+    std::atomic<bool> destroyed {false};
+    std::thread owner ([&]() {
+        {
+            auto file = abstract_file_structure_deferred(slide.file.data(), slide.file.size(), nullptr,
+                                                         std::make_shared<DiscardingExecutor>());
+        }
+        destroyed = true;
+    });
+    wait_or_abort(destroyed, "releasing a validation the executor discarded");
+    owner.join();
+}
+
+} // namespace
+
+int main() {
+    try {
+        test_passed();
+        test_quarantined();
+        test_pending();
+        test_release_from_callback();
+        test_release_on_worker();
+        test_release_discarded();
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "ife_validation_tests: %s\n", e.what());
+        return 1;
+    }
+
+    if (g_failures == 0) {
+        std::printf("ife_validation_tests: ALL PASS\n");
+        return 0;
+    }
+    std::fprintf(stderr, "ife_validation_tests: %d FAILURE(S)\n", g_failures);
+    return 1;
+}